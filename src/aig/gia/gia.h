@@ -53,6 +53,7 @@ typedef struct Gia_MmFixed_t_        Gia_MmFixed_t;
 typedef struct Gia_MmFlex_t_         Gia_MmFlex_t;     
 typedef struct Gia_MmStep_t_         Gia_MmStep_t;     
 typedef struct Gia_Dat_t_            Gia_Dat_t;
+typedef struct Gia_IsoCache_t_       Gia_IsoCache_t;
 
 typedef struct Gia_Rpr_t_ Gia_Rpr_t;
 struct Gia_Rpr_t_
@@ -305,6 +306,20 @@ struct Gia_ParSim_t_
     int            iOutFail;      // index of the failed output
 };
 
+// quantification parameters
+typedef struct Gia_ParQua_t_ Gia_ParQua_t;
+struct Gia_ParQua_t_
+{
+    int            nProcs;        // the number of threads
+    int            nNodeMax;      // the largest number of AIG nodes in one cone
+    int            TimeLimit;     // time limit in seconds
+    int            nBTLimit;      // conflict limit used by sweeping
+    int            nSimWords;     // the number of simulation words used by sweeping
+    int            fUniv;         // universal quantification
+    int            fSweep;        // sweeping of intermediate results
+    int            fVerbose;      // enables verbose output
+};
+
 typedef struct Gia_ManSim_t_ Gia_ManSim_t;
 struct Gia_ManSim_t_
 {
@@ -467,6 +482,7 @@ static inline int          Gia_ManCandNum( Gia_Man_t * p )     { return Gia_ManC
 static inline int          Gia_ManConstrNum( Gia_Man_t * p )   { return p->nConstrs;                                                       }
 static inline void         Gia_ManFlipVerbose( Gia_Man_t * p ) { p->fVerbose ^= 1;                                                         } 
 static inline int          Gia_ManHasChoices( Gia_Man_t * p )  { return p->pSibls != NULL;                                                 } 
+static inline int          Gia_ManHasSwitching( Gia_Man_t * p ){ return p->vSwitching != NULL && Vec_IntSize(p->vSwitching) == p->nObjs;  } 
 static inline int          Gia_ManChoiceNum( Gia_Man_t * p )   { int c = 0; if (p->pSibls) { int i; for (i = 0; i < p->nObjs; i++) c += (int)(p->pSibls[i] > 0); } return c; } 
 
 static inline Gia_Obj_t *  Gia_ManConst0( Gia_Man_t * p )      { return p->pObjs;                                                          }
@@ -1287,6 +1303,10 @@ extern int                 Cbs_ManSolve2( Cbs_Man_t * p, Gia_Obj_t * pObj, Gia_O
 extern Vec_Int_t *         Cbs_ManSolveMiterNc( Gia_Man_t * pGia, int nConfs, Vec_Str_t ** pvStatus, int f0Proved, int fVerbose );
 extern void                Cbs_ManSetConflictNum( Cbs_Man_t * p, int Num );
 extern Vec_Int_t *         Cbs_ReadModel( Cbs_Man_t * p );
+/*=== giaCSat3.c ============================================================*/
+extern Vec_Int_t *         Cbs3_ManSolveMiterNc( Gia_Man_t * pAig, int nConfs, int nRestarts, Vec_Str_t ** pvStatus, int fVerbose );
+extern Vec_Int_t *         Cbs3_ManSolveMiterPar( Gia_Man_t * pAig, int nConfs, int nRestarts, int nProcs, Vec_Str_t ** pvStatus, int fVerbose );
+extern Vec_Int_t *         Cbs3_ManSolveBatch( Gia_Man_t * pAig, Vec_Int_t * vPairs, int nConfs, int nRestarts, int nProcs, Vec_Str_t ** pvStatus, int fVerbose );
 /*=== giaCTas.c ============================================================*/
 extern Vec_Int_t *         Tas_ManSolveMiterNc( Gia_Man_t * pGia, int nConfs, Vec_Str_t ** pvStatus, int fVerbose );
 /*=== giaCof.c =============================================================*/
@@ -1440,6 +1460,8 @@ extern void                Gia_ManQuantSetSuppZero( Gia_Man_t * p );
 extern void                Gia_ManQuantSetSuppCi( Gia_Man_t * p, Gia_Obj_t * pObj );
 extern void                Gia_ManQuantUpdateCiSupp( Gia_Man_t * p, int iObj );
 extern int                 Gia_ManQuantExist( Gia_Man_t * p, int iLit, int(*pFuncCiToKeep)(void *, int), void * pData );
+extern void                Gia_ManQuantSetDefaultParams( Gia_ParQua_t * p );
+extern Gia_Man_t *         Gia_ManQuantPar( Gia_Man_t * p, Vec_Int_t * vVars, Gia_ParQua_t * pPars );
 /*=== giaFanout.c =========================================================*/
 extern void                Gia_ObjAddFanout( Gia_Man_t * p, Gia_Obj_t * pObj, Gia_Obj_t * pFanout );
 extern void                Gia_ObjRemoveFanout( Gia_Man_t * p, Gia_Obj_t * pObj, Gia_Obj_t * pFanout );
@@ -1511,6 +1533,12 @@ extern Gia_Man_t *         Jf_ManDeriveCnf( Gia_Man_t * p, int fCnfObjIds );
 /*=== giaIso.c ===========================================================*/
 extern Gia_Man_t *         Gia_ManIsoCanonicize( Gia_Man_t * p, int fVerbose );
 extern Gia_Man_t *         Gia_ManIsoReduce( Gia_Man_t * p, Vec_Ptr_t ** pvPosEquivs, Vec_Ptr_t ** pvPiPerms, int fEstimate, int fDualOut, int fVerbose, int fVeryVerbose );
+extern Gia_Man_t *         Gia_ManIsoReducePar( Gia_Man_t * p, Vec_Ptr_t ** pvPosEquivs, Vec_Ptr_t ** pvPiPerms, int fEstimate, int fDualOut, int nProcs, Gia_IsoCache_t * pCache, int fVerbose, int fVeryVerbose );
+extern Gia_IsoCache_t *    Gia_IsoCacheStart();
+extern void                Gia_IsoCacheStop( Gia_IsoCache_t * p );
+extern int                 Gia_IsoCacheSize( Gia_IsoCache_t * p );
+extern int                 Gia_IsoCacheRead( Gia_IsoCache_t * p, char * pFileName );
+extern int                 Gia_IsoCacheWrite( Gia_IsoCache_t * p, char * pFileName );
 extern Gia_Man_t *         Gia_ManIsoReduce2( Gia_Man_t * p, Vec_Ptr_t ** pvPosEquivs, Vec_Ptr_t ** pvPiPerms, int fEstimate, int fBetterQual, int fDualOut, int fVerbose, int fVeryVerbose );
 /*=== giaLf.c ===========================================================*/
 extern void                Lf_ManSetDefaultPars( Jf_Par_t * pPars );
@@ -1630,8 +1658,17 @@ extern Gia_Man_t *         Gia_ManSpeedup( Gia_Man_t * p, int Percentage, int De
 extern void                Gia_ManComputeOneWinStart( Gia_Man_t * p, int nAnds, int fReverse );
 extern int                 Gia_ManComputeOneWin( Gia_Man_t * p, int iPivot, Vec_Int_t ** pvRoots, Vec_Int_t ** pvNodes, Vec_Int_t ** pvLeaves, Vec_Int_t ** pvAnds );
 /*=== giaStg.c ============================================================*/
+typedef struct Gia_Stg_t_ Gia_Stg_t;
 extern void                Gia_ManStgPrint( FILE * pFile, Vec_Int_t * vLines, int nIns, int nOuts, int nStates );
 extern Gia_Man_t *         Gia_ManStgRead( char * pFileName, int kHot, int fVerbose );
+extern void                Gia_StgFree( Gia_Stg_t * p );
+extern int                 Gia_StgStateNum( Gia_Stg_t * p );
+extern int                 Gia_StgTransNum( Gia_Stg_t * p );
+extern Gia_Stg_t *         Gia_StgRead( char * pFileName );
+extern void                Gia_StgWriteKiss( Gia_Stg_t * p, char * pFileName );
+extern Gia_Stg_t *         Gia_ManStgExtract( Gia_Man_t * p, int nStatesMax, int nProcs, int fVerbose );
+extern Gia_Stg_t *         Gia_StgMinimize( Gia_Stg_t * p, int nProcs, int fVerbose );
+extern Gia_Man_t *         Gia_StgDeriveGia( Gia_Stg_t * p, int kHot, int fVerbose );
 /*=== giaSupp.c ============================================================*/
 typedef struct Gia_ManMin_t_ Gia_ManMin_t;
 extern Gia_ManMin_t *      Gia_ManSuppStart( Gia_Man_t * pGia );
@@ -1663,6 +1700,8 @@ extern void                Gia_SweeperCondPush( Gia_Man_t * p, int ProbeId );
 extern Vec_Int_t *         Gia_SweeperCondVector( Gia_Man_t * p );
 extern int                 Gia_SweeperCondCheckUnsat( Gia_Man_t * p );
 extern int                 Gia_SweeperCheckEquiv( Gia_Man_t * p, int ProbeId1, int ProbeId2 );
+extern Vec_Int_t *         Gia_SweeperCheckEquivBatch( Gia_Man_t * p, Vec_Int_t * vProbePairs, int nProcs );
+extern int                 Gia_SweeperCheckDualMiter( Gia_Man_t * p, int nConfs, int nProcs, int fVerbose );
 extern Gia_Man_t *         Gia_SweeperExtractUserLogic( Gia_Man_t * p, Vec_Int_t * vProbeIds, Vec_Ptr_t * vInNames, Vec_Ptr_t * vOutNames );
 extern void                Gia_SweeperLogicDump( Gia_Man_t * p, Vec_Int_t * vProbeIds, int fDumpConds, char * pFileName );
 extern Gia_Man_t *         Gia_SweeperCleanup( Gia_Man_t * p, char * pCommLime );
@@ -1673,6 +1712,8 @@ extern int                 Gia_SweeperRun( Gia_Man_t * p, Vec_Int_t * vProbeIds,
 extern float               Gia_ManEvaluateSwitching( Gia_Man_t * p );
 extern float               Gia_ManComputeSwitching( Gia_Man_t * p, int nFrames, int nPref, int fProbOne );
 extern Vec_Int_t *         Gia_ManComputeSwitchProbs( Gia_Man_t * pGia, int nFrames, int nPref, int fProbOne );
+extern Vec_Int_t *         Gia_ManComputeSwitchProbs2( Gia_Man_t * pGia, int nFrames, int nPref, int fProbOne, int nWords, int nProcs, int TimeLimit, Vec_Flt_t * vPiProbs, Vec_Wrd_t * vTrace, int fVerbose );
+extern Vec_Flt_t *         Gia_ManReadPiProbs( char * pFileName, int nPis );
 extern Vec_Flt_t *         Gia_ManPrintOutputProb( Gia_Man_t * p );
 /*=== giaTim.c ===========================================================*/
 extern int                 Gia_ManBoxNum( Gia_Man_t * p );
@@ -1707,6 +1748,25 @@ extern void                Gia_ObjComputeTruthTableStart( Gia_Man_t * p, int nVa
 extern void                Gia_ObjComputeTruthTableStop( Gia_Man_t * p );
 extern word *              Gia_ObjComputeTruthTableCut( Gia_Man_t * p, Gia_Obj_t * pObj, Vec_Int_t * vLeaves );
 /*=== giaTsim.c ============================================================*/
+typedef struct Gia_Tsi_t_ Gia_Tsi_t;
+extern Gia_Tsi_t *         Gia_TsiAlloc( int nWords );
+extern Gia_Tsi_t *         Gia_TsiStart( Gia_Man_t * pGia, int nWords );
+extern void                Gia_TsiClear( Gia_Tsi_t * p );
+extern void                Gia_TsiFree( Gia_Tsi_t * p );
+extern int                 Gia_TsiAddCi( Gia_Tsi_t * p );
+extern int                 Gia_TsiAddAnd( Gia_Tsi_t * p, int iLit0, int iLit1 );
+extern int                 Gia_TsiAddCo( Gia_Tsi_t * p, int iLit0 );
+extern int                 Gia_TsiCiNum( Gia_Tsi_t * p );
+extern int                 Gia_TsiCoNum( Gia_Tsi_t * p );
+extern int                 Gia_TsiEvalNum( Gia_Tsi_t * p );
+extern void                Gia_TsiSetCi( Gia_Tsi_t * p, int iCi, int iPat, int Value );
+extern void                Gia_TsiSetCiAll( Gia_Tsi_t * p, int iCi, int Value );
+extern void                Gia_TsiSetCiWord( Gia_Tsi_t * p, int iCi, int iWord, word Zero, word One );
+extern int                 Gia_TsiObjValue( Gia_Tsi_t * p, int iObj, int iPat );
+extern int                 Gia_TsiCoValue( Gia_Tsi_t * p, int iCo, int iPat );
+extern word                Gia_TsiCoDiffer( Gia_Tsi_t * p, int iCo, int Value, int iWord );
+extern void                Gia_TsiSimulate( Gia_Tsi_t * p );
+extern void                Gia_TsiSimulateInc( Gia_Tsi_t * p );
 extern Gia_Man_t *         Gia_ManReduceConst( Gia_Man_t * pAig, int fVerbose );
 /*=== giaUtil.c ===========================================================*/
 extern unsigned            Gia_ManRandom( int fReset );
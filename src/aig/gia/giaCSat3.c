@@ -20,6 +20,18 @@
 
 #include "gia.h"
 
+#ifdef ABC_USE_PTHREADS
+
+#ifdef _WIN32
+#include "../lib/pthread.h"
+#else
+#include <pthread.h>
+#include <sched.h>
+#include <unistd.h>
+#endif
+
+#endif
+
 ABC_NAMESPACE_IMPL_START
 
 
@@ -27,6 +39,8 @@ ABC_NAMESPACE_IMPL_START
 ///                        DECLARATIONS                              ///
 ////////////////////////////////////////////////////////////////////////
 
+#define CBS3_PROC_MAX   64      // the max number of threads
+
 typedef struct Cbs3_Par_t_ Cbs3_Par_t;
 struct Cbs3_Par_t_
 {
@@ -77,6 +91,9 @@ struct Cbs3_Man_t_
     Vec_Int_t     vActs;
     Vec_Int_t     vWatches;
     Vec_Int_t     vWatchUpds;
+    // incremental loading
+    Vec_Int_t     vObj2Lit;     // solver literals of the loaded AIG objects
+    int           nVarsMax;     // the number of variables to recycle the solver
     // SAT calls statistics
     int           nSatUnsat;    // the number of proofs
     int           nSatSat;      // the number of failure
@@ -208,6 +225,7 @@ Cbs3_Man_t * Cbs3_ManAlloc( Gia_Man_t * pGia )
     Vec_IntFill( &p->vActs,        p->nVarsAlloc, 0 );
     Vec_IntFill( &p->vWatches,   2*p->nVarsAlloc, 0 );
     Vec_IntGrow( &p->vWatchUpds, 1000 );
+    p->nVarsMax = 500;
     return p;
 }
 static inline void Cbs3_ManReset( Cbs3_Man_t * p )
@@ -257,6 +275,7 @@ void Cbs3_ManStop( Cbs3_Man_t * p )
     Vec_IntErase( &p->vActs );
     Vec_IntErase( &p->vWatches );
     Vec_IntErase( &p->vWatchUpds );
+    Vec_IntErase( &p->vObj2Lit );
     Vec_IntFree( p->vModel );
     Vec_IntFree( p->vTemp );
     ABC_FREE( p->pClauses.pData );
@@ -276,6 +295,7 @@ int Cbs3_ManMemory( Cbs3_Man_t * p )
     nMem += (int)Vec_IntMemory( &p->vActs );
     nMem += (int)Vec_IntMemory( &p->vWatches );
     nMem += (int)Vec_IntMemory( &p->vWatchUpds );
+    nMem += (int)Vec_IntMemory( &p->vObj2Lit );
     nMem += (int)Vec_IntMemory( p->vModel );
     nMem += (int)Vec_IntMemory( p->vTemp );
     nMem += 4*p->pClauses.nSize;
@@ -1355,6 +1375,338 @@ Vec_Int_t * Cbs3_ManSolveMiterNc( Gia_Man_t * pAig, int nConfs, int nRestarts, V
     return vCexStore;
 }
 
+/**Function*************************************************************
+
+  Synopsis    [Incremental loading of the cones.]
+
+  Description [The cones loaded for the previous queries are kept, so that
+  a query whose cone overlaps with them only adds the missing nodes. The
+  loaded nodes are recycled when the number of variables exceeds the limit.
+  Unlike Cbs3_ManToSolver2(), the AIG is not modified (no traversal IDs or 
+  values are used), so several solvers can load the same AIG concurrently.]
+               
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+static inline void Cbs3_ManRecycle( Cbs3_Man_t * p )
+{
+    int i, iObj;
+    Vec_IntForEachEntryStart( &p->vMap, iObj, i, 1 )
+        if ( iObj < Vec_IntSize(&p->vObj2Lit) )
+            Vec_IntWriteEntry( &p->vObj2Lit, iObj, -1 );
+    Cbs3_ManReset( p );
+}
+static inline int Cbs3_ManLoadStart( Cbs3_Man_t * p )
+{
+    if ( Vec_IntSize(&p->vObj2Lit) == 0 )
+        Vec_IntFill( &p->vObj2Lit, Gia_ManObjNum(p->pAig), -1 );
+    if ( p->nVars > p->nVarsMax )
+        Cbs3_ManRecycle( p );
+    return p->nVars;
+}
+static inline int Cbs3_ManLoad_rec( Cbs3_Man_t * p, int iObj )
+{
+    Gia_Obj_t * pObj; int Lit0 = 0, Lit1 = 0;
+    if ( Vec_IntEntry(&p->vObj2Lit, iObj) >= 0 )
+        return Vec_IntEntry(&p->vObj2Lit, iObj);
+    pObj = Gia_ManObj( p->pAig, iObj );
+    if ( !Gia_ObjIsCi(pObj) )
+    {
+        assert( Gia_ObjIsAnd(pObj) );
+        Lit0 = Cbs3_ManLoad_rec( p, Gia_ObjFaninId0(pObj, iObj) ) ^ Gia_ObjFaninC0(pObj);
+        Lit1 = Cbs3_ManLoad_rec( p, Gia_ObjFaninId1(pObj, iObj) ) ^ Gia_ObjFaninC1(pObj);
+    }
+    Vec_IntWriteEntry( &p->vObj2Lit, iObj, Cbs3_ManAddNode(p, iObj, Lit0, Lit1) );
+    return Vec_IntEntry(&p->vObj2Lit, iObj);
+}
+static inline int Cbs3_ManLoadAnd( Cbs3_Man_t * p, int iLit0, int iLit1 )
+{
+    // the node not present in the AIG is decided first and has one fanout
+    assert( Vec_IntSize(&p->vMap) == p->nVars );
+    Vec_IntPush( &p->vMap, Gia_ManObjNum(p->pAig) );
+    Vec_IntPush( &p->vRef, 1 );
+    Vec_IntPushTwo( &p->vFans, iLit0, iLit1 );
+    return Abc_Var2Lit( p->nVars++, 0 );
+}
+static inline void Cbs3_ManLoadStop( Cbs3_Man_t * p, int nVarsOld )
+{
+    int x, x0, x1;
+    Cbs3_ManGrow( p );
+    Vec_WecInit( &p->vImps, Abc_Var2Lit(p->nVars, 0) );
+    for ( x = Abc_Var2Lit(nVarsOld, 0); x < Abc_Var2Lit(p->nVars, 0); x += 2 )
+    {
+        x0 = Vec_IntEntry( &p->vFans, x );
+        x1 = Vec_IntEntry( &p->vFans, x+1 );
+        if ( x0 ) Cbs3_ManAddConstr( p, x, x0, x1 );
+    }
+}
+
+/**Function*************************************************************
+
+  Synopsis    [Checks if the two AIG literals can have different values.]
+
+  Description [Returns 1 if the literals are equivalent (UNSAT), 0 if they
+  are not (SAT), and -1 if undecided. In the case of SAT, the pattern is
+  returned in p->vModel as literals of the CIs.]
+               
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+int Cbs3_ManSolvePair( Cbs3_Man_t * p, int iLit0, int iLit1 )
+{
+    int i, Lit, nVarsOld, iSatLit, RetValue;
+    Vec_IntClear( p->vModel );
+    if ( Abc_Lit2Var(iLit0) == Abc_Lit2Var(iLit1) )
+        return (int)(iLit0 == iLit1);
+    if ( Abc_Lit2Var(iLit0) == 0 )
+        ABC_SWAP( int, iLit0, iLit1 );
+    nVarsOld = Cbs3_ManLoadStart( p );
+    if ( Abc_Lit2Var(iLit1) == 0 ) // comparing with a constant
+        iSatLit = Abc_LitNotCond( Cbs3_ManLoad_rec(p, Abc_Lit2Var(iLit0)), Abc_LitIsCompl(iLit0) ^ iLit1 );
+    else // the XOR of the two literals
+    {
+        int Lit0 = Abc_LitNotCond( Cbs3_ManLoad_rec(p, Abc_Lit2Var(iLit0)), Abc_LitIsCompl(iLit0) );
+        int Lit1 = Abc_LitNotCond( Cbs3_ManLoad_rec(p, Abc_Lit2Var(iLit1)), Abc_LitIsCompl(iLit1) );
+        int And0 = Cbs3_ManLoadAnd( p, Lit0, Abc_LitNot(Lit1) );
+        int And1 = Cbs3_ManLoadAnd( p, Abc_LitNot(Lit0), Lit1 );
+        iSatLit  = Abc_LitNot( Cbs3_ManLoadAnd(p, Abc_LitNot(And0), Abc_LitNot(And1)) );
+    }
+    Cbs3_ManLoadStop( p, nVarsOld );
+    Cbs3_ActReset( p );
+    RetValue = Cbs3_ManSolve( p, iSatLit, p->Pars.nRestLimit );
+    if ( RetValue == 0 ) // translate the pattern into CI literals
+        Vec_IntForEachEntry( p->vModel, Lit, i )
+            Vec_IntWriteEntry( p->vModel, i, Abc_Var2Lit(Gia_ObjCioId(Gia_ManObj(p->pAig, Abc_Lit2Var(Lit)+1)), Abc_LitIsCompl(Lit)) );
+    return RetValue;
+}
+
+/**Function*************************************************************
+
+  Synopsis    [Solves a range of queries.]
+
+  Description []
+               
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+void Cbs3_ManSolveRange( Cbs3_Man_t * p, Vec_Int_t * vPairs, int iStart, int iStop, Vec_Str_t * vStatus, Vec_Wec_t * vCexes )
+{
+    int i, status;
+    abctime clk;
+    // every range starts with an empty solver, so the results do not depend on the schedule
+    Cbs3_ManRecycle( p );
+    for ( i = iStart; i < iStop; i++ )
+    {
+        clk = Abc_Clock();
+        status = Cbs3_ManSolvePair( p, Vec_IntEntry(vPairs, 2*i), Vec_IntEntry(vPairs, 2*i+1) );
+        Vec_StrWriteEntry( vStatus, i, (char)status );
+        p->nSatTotal++;
+        if ( status == -1 )
+        {
+            p->nSatUndec++;
+            p->nConfUndec += p->Pars.nBTThis;
+            p->timeSatUndec += Abc_Clock() - clk;
+        }
+        else if ( status == 1 )
+        {
+            p->nSatUnsat++;
+            p->nConfUnsat += p->Pars.nBTThis;
+            p->timeSatUnsat += Abc_Clock() - clk;
+        }
+        else
+        {
+            p->nSatSat++;
+            p->nConfSat += p->Pars.nBTThis;
+            Vec_IntAppend( Vec_WecEntry(vCexes, i), p->vModel );
+            p->timeSatSat += Abc_Clock() - clk;
+        }
+    }
+}
+
+/**Function*************************************************************
+
+  Synopsis    [Solves a batch of equivalence queries.]
+
+  Description [The queries are given as pairs of AIG literals. The batch 
+  is split into ranges of consecutive queries, which are solved by nProcs 
+  threads, each having its own solver. Because the neighboring queries
+  tend to share the logic, each solver keeps the loaded cones between the 
+  queries of one range. Returns the statuses of the queries (1 = UNSAT, 
+  0 = SAT, -1 = undecided) and the store of counter-examples in the format 
+  of Cec_ManSatAddToStore() in the order of the queries.]
+               
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+#ifdef ABC_USE_PTHREADS
+
+typedef struct Cbs3_ThData_t_ Cbs3_ThData_t;
+struct Cbs3_ThData_t_
+{
+    Cbs3_Man_t *  pMan;         // the solver of this thread
+    Vec_Int_t *   vPairs;       // the queries
+    Vec_Str_t *   vStatus;      // the statuses of the queries
+    Vec_Wec_t *   vCexes;       // the patterns of the queries
+    int           iStart;       // the first query of the range
+    int           iStop;        // the last query of the range
+    int           fStop;        // the thread should stop
+    volatile int  fWorking;     // the thread is working
+};
+void * Cbs3_ManWorkerThread( void * pArg )
+{
+    Cbs3_ThData_t * pThData = (Cbs3_ThData_t *)pArg;
+    volatile int * pPlace = &pThData->fWorking;
+    while ( 1 )
+    {
+        while ( *pPlace == 0 )
+            sched_yield();
+        assert( pThData->fWorking );
+        if ( pThData->fStop )
+        {
+            pthread_exit( NULL );
+            assert( 0 );
+            return NULL;
+        }
+        Cbs3_ManSolveRange( pThData->pMan, pThData->vPairs, pThData->iStart, pThData->iStop, pThData->vStatus, pThData->vCexes );
+        pThData->fWorking = 0;
+    }
+    assert( 0 );
+    return NULL;
+}
+
+#endif // pthreads are used
+
+Vec_Int_t * Cbs3_ManSolveBatch( Gia_Man_t * pAig, Vec_Int_t * vPairs, int nConfs, int nRestarts, int nProcs, Vec_Str_t ** pvStatus, int fVerbose )
+{
+    extern void Cec_ManSatAddToStore( Vec_Int_t * vCexStore, Vec_Int_t * vCex, int Out );
+    Cbs3_Man_t * pMans[CBS3_PROC_MAX];
+    Vec_Int_t * vCexStore;
+    Vec_Str_t * vStatus;
+    Vec_Wec_t * vCexes;
+    int i, k, nPairs = Vec_IntSize(vPairs) / 2, nRange, status;
+    abctime clkTotal = Abc_Clock();
+#ifdef ABC_USE_PTHREADS
+    Cbs3_ThData_t ThData[CBS3_PROC_MAX];
+    pthread_t WorkerThread[CBS3_PROC_MAX];
+    int iNext;
+#endif
+    assert( Vec_IntSize(vPairs) % 2 == 0 );
+    nProcs = Abc_MaxInt( 1, Abc_MinInt(nProcs, CBS3_PROC_MAX) );
+    // consecutive queries go to the same solver in ranges of this size
+    // (the size does not depend on nProcs, so the results do not either)
+    nRange = Abc_MaxInt( 16, Abc_MinInt(1000, nPairs / 64) );
+    Gia_ManCreateRefs( pAig );
+    for ( k = 0; k < nProcs; k++ )
+    {
+        pMans[k] = Cbs3_ManAlloc( pAig );
+        pMans[k]->Pars.nBTLimit = nConfs;
+        pMans[k]->Pars.nRestLimit = nRestarts;
+    }
+    vStatus = Vec_StrStart( nPairs );
+    vCexes  = Vec_WecStart( nPairs );
+#ifdef ABC_USE_PTHREADS
+    if ( nProcs > 1 )
+    {
+        for ( k = 0; k < nProcs; k++ )
+        {
+            memset( ThData + k, 0, sizeof(Cbs3_ThData_t) );
+            ThData[k].pMan    = pMans[k];
+            ThData[k].vPairs  = vPairs;
+            ThData[k].vStatus = vStatus;
+            ThData[k].vCexes  = vCexes;
+            status = pthread_create( WorkerThread + k, NULL, Cbs3_ManWorkerThread, (void *)(ThData + k) );  assert( status == 0 );
+        }
+        for ( iNext = 0; iNext < nPairs; iNext += nRange )
+        {
+            // find an idle thread
+            for ( k = 0; ThData[k].fWorking; k = (k + 1) % nProcs )
+                if ( k == nProcs - 1 )
+                    sched_yield();
+            ThData[k].iStart   = iNext;
+            ThData[k].iStop    = Abc_MinInt( iNext + nRange, nPairs );
+            ThData[k].fWorking = 1;
+        }
+        for ( k = 0; k < nProcs; k++ )
+        {
+            while ( ThData[k].fWorking )
+                sched_yield();
+            ThData[k].fStop = 1;
+            ThData[k].fWorking = 1;
+        }
+        for ( k = 0; k < nProcs; k++ )
+            pthread_join( WorkerThread[k], NULL );
+    }
+    else
+#endif
+    for ( i = 0; i < nPairs; i += nRange )
+        Cbs3_ManSolveRange( pMans[0], vPairs, i, Abc_MinInt(i + nRange, nPairs), vStatus, vCexes );
+    // collect the results in the order of the queries
+    vCexStore = Vec_IntAlloc( 10000 );
+    for ( i = 0; i < nPairs; i++ )
+    {
+        status = (int)Vec_StrEntry( vStatus, i );
+        if ( status == -1 )
+            Cec_ManSatAddToStore( vCexStore, NULL, i );
+        else if ( status == 0 )
+            Cec_ManSatAddToStore( vCexStore, Vec_WecEntry(vCexes, i), i );
+    }
+    Vec_WecFree( vCexes );
+    // accumulate the statistics in the first solver
+    for ( k = 1; k < nProcs; k++ )
+    {
+        pMans[0]->nSatUnsat    += pMans[k]->nSatUnsat;
+        pMans[0]->nSatSat      += pMans[k]->nSatSat;
+        pMans[0]->nSatUndec    += pMans[k]->nSatUndec;
+        pMans[0]->nSatTotal    += pMans[k]->nSatTotal;
+        pMans[0]->nConfUnsat   += pMans[k]->nConfUnsat;
+        pMans[0]->nConfSat     += pMans[k]->nConfSat;
+        pMans[0]->nConfUndec   += pMans[k]->nConfUndec;
+        pMans[0]->timeSatUnsat += pMans[k]->timeSatUnsat;
+        pMans[0]->timeSatSat   += pMans[k]->timeSatSat;
+        pMans[0]->timeSatUndec += pMans[k]->timeSatUndec;
+    }
+    pMans[0]->timeTotal = Abc_Clock() - clkTotal;
+    if ( fVerbose )
+    {
+        printf( "Solved %d queries using %d thread%s with ranges of %d queries.\n", nPairs, nProcs, nProcs > 1 ? "s" : "", nRange );
+        Cbs3_ManSatPrintStats( pMans[0] );
+    }
+    for ( k = 0; k < nProcs; k++ )
+        Cbs3_ManStop( pMans[k] );
+    *pvStatus = vStatus;
+    return vCexStore;
+}
+
+/**Function*************************************************************
+
+  Synopsis    [Solves the outputs of the miter as a batch.]
+
+  Description [Has the same interface as Cbs3_ManSolveMiterNc().]
+               
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+Vec_Int_t * Cbs3_ManSolveMiterPar( Gia_Man_t * pAig, int nConfs, int nRestarts, int nProcs, Vec_Str_t ** pvStatus, int fVerbose )
+{
+    Vec_Int_t * vCexStore, * vPairs = Vec_IntAlloc( 2 * Gia_ManCoNum(pAig) );
+    Gia_Obj_t * pRoot; int i;
+    Gia_ManForEachCo( pAig, pRoot, i )
+        Vec_IntPushTwo( vPairs, Gia_ObjFaninLit0p(pAig, pRoot), 0 );
+    vCexStore = Cbs3_ManSolveBatch( pAig, vPairs, nConfs, nRestarts, nProcs, pvStatus, fVerbose );
+    Vec_IntFree( vPairs );
+    return vCexStore;
+}
+
 
 ////////////////////////////////////////////////////////////////////////
 ///                       END OF FILE                                ///
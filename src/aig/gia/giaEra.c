@@ -19,7 +19,18 @@
 ***********************************************************************/
 
 #include "gia.h"
-#include "misc/mem/mem.h"
+
+#ifdef ABC_USE_PTHREADS
+
+#ifdef _WIN32
+#include "../lib/pthread.h"
+#else
+#include <pthread.h>
+#include <sched.h>
+#include <unistd.h>
+#endif
+
+#endif
 
 ABC_NAMESPACE_IMPL_START
 
@@ -28,38 +39,54 @@ ABC_NAMESPACE_IMPL_START
 ///                        DECLARATIONS                              ///
 ////////////////////////////////////////////////////////////////////////
 
-// explicit state representation
-typedef struct Gia_ObjEra_t_ Gia_ObjEra_t;
-struct Gia_ObjEra_t_
+#define ERA_PROC_MAX   64      // the max number of threads
+#define ERA_BATCH_BITS 2048    // the number of patterns simulated together
+
+typedef struct Gia_ManEra_t_ Gia_ManEra_t;
+
+// simulation of a batch of states
+typedef struct Gia_EraSim_t_ Gia_EraSim_t;
+struct Gia_EraSim_t_
 {
-    int            Num;          // ID of this state
-    int            Cond;         // input condition
-    int            iPrev;        // previous state
-    int            iNext;        // next state in the hash table
-    unsigned       pData[0];     // state bits
+    Gia_ManEra_t * p;            // reachability manager
+    int            iStart;       // the first state of the batch
+    int            nStates;      // the number of states in the batch
+    int            nWordsSim;    // the number of simulation words
+    unsigned *     pDataSim;     // simulation data
+    unsigned *     pNext;        // next states of each pattern
+    unsigned *     pKeys;        // hash keys of the next states
+    unsigned *     pOuts;        // output values of each pattern (first 32 outputs)
+    unsigned *     pFail;        // patterns asserting at least one output
+    int            fWorking;     // the batch is being simulated
 };
 
 // explicit state reachability
-typedef struct Gia_ManEra_t_ Gia_ManEra_t;
 struct Gia_ManEra_t_
 {
     Gia_Man_t *    pAig;         // user's AIG manager
-    int            nWordsSim;       // 2^(PInum)
-    int            nWordsDat;   // Abc_BitWordNum
-    unsigned *     pDataSim;     // simulation data
-    Mem_Fixed_t *  pMemory;      // memory manager
-    Vec_Ptr_t *    vStates;      // reached states
-    Gia_ObjEra_t * pStateNew;    // temporary state
+    int            nPats;        // 2^(PInum)
+    int            nWordsTt;     // Abc_TruthWordNum
+    int            nWordsDat;    // Abc_BitWordNum
+    int            nBatch;       // the number of states in one batch
+    int            nProcs;       // the number of threads
+    int            fStgDump;     // collect the output values
+    Vec_Ptr_t *    vTruths;      // truth tables of the inputs
+    Vec_Int_t *    vStates;      // reached states (nWordsDat words each)
+    Vec_Int_t *    vCond;        // input condition leading to the state
+    Vec_Int_t *    vPrev;        // previous state
     int            iCurState;    // the current state
     Vec_Int_t *    vBugTrace;    // the sequence of transitions
     Vec_Int_t *    vStgDump;     // STG written into a file
-    // hash table for states
+    // hash table for states (pairs of hash key and state number)
     int            nBins;         
-    unsigned *     pBins;
+    int *          pBins;
+    // simulation of the batches
+    Gia_EraSim_t   Sims[ERA_PROC_MAX];
 };
 
-static inline unsigned *     Gia_ManEraData( Gia_ManEra_t * p, int i )    { return p->pDataSim + i * p->nWordsSim;  }
-static inline Gia_ObjEra_t * Gia_ManEraState( Gia_ManEra_t * p, int i )   { return (Gia_ObjEra_t *)Vec_PtrEntry(p->vStates, i);  }
+static inline int        Gia_ManEraStateNum( Gia_ManEra_t * p )          { return Vec_IntSize(p->vPrev) - 1;                                           }
+static inline unsigned * Gia_ManEraState( Gia_ManEra_t * p, int i )      { return (unsigned *)Vec_IntEntryP(p->vStates, i * p->nWordsDat);         }
+static inline unsigned * Gia_EraSimData( Gia_EraSim_t * s, int Id )      { return s->pDataSim + Id * s->nWordsSim;                                    }
 
 ////////////////////////////////////////////////////////////////////////
 ///                     FUNCTION DEFINITIONS                         ///
@@ -69,41 +96,51 @@ static inline Gia_ObjEra_t * Gia_ManEraState( Gia_ManEra_t * p, int i )   { retu
 
   Synopsis    [Creates reachability manager.]
 
-  Description []
+  Description [States are numbered starting from 1. Their bits are stored 
+  one after another in one array. Each batch of states is simulated for 
+  all input minterms at the same time: pattern k of state s in the batch 
+  is the bit number (s * 2^PInum + k).]
                
   SideEffects []
 
   SeeAlso     []
 
 ***********************************************************************/
-Gia_ManEra_t * Gia_ManEraCreate( Gia_Man_t * pAig )
+Gia_ManEra_t * Gia_ManEraCreate( Gia_Man_t * pAig, int nProcs )
 {
-    Vec_Ptr_t * vTruths;
     Gia_ManEra_t * p;
-    unsigned * pTruth, * pSimInfo;
-    int i;
+    int i, nPats;
     p = ABC_CALLOC( Gia_ManEra_t, 1 );
     p->pAig      = pAig;
-    p->nWordsSim = Abc_TruthWordNum( Gia_ManPiNum(pAig) );
+    p->nPats     = 1 << Gia_ManPiNum(pAig);
+    p->nWordsTt  = Abc_TruthWordNum( Gia_ManPiNum(pAig) );
     p->nWordsDat = Abc_BitWordNum( Gia_ManRegNum(pAig) );
-    p->pDataSim  = ABC_ALLOC( unsigned, p->nWordsSim*Gia_ManObjNum(pAig) );
-    p->pMemory   = Mem_FixedStart( sizeof(Gia_ObjEra_t) + sizeof(unsigned) * p->nWordsDat );
-    p->vStates   = Vec_PtrAlloc( 100000 );
-    p->nBins     = Abc_PrimeCudd( 100000 );
-    p->pBins     = ABC_CALLOC( unsigned, p->nBins );
-    Vec_PtrPush( p->vStates, NULL );
-    // assign primary input values
-    vTruths = Vec_PtrAllocTruthTables( Gia_ManPiNum(pAig) );
-    Vec_PtrForEachEntry( unsigned *, vTruths, pTruth, i )
+    p->nBatch    = Abc_MaxInt( 1, ERA_BATCH_BITS / p->nPats );
+    p->nProcs    = Abc_MinInt( Abc_MaxInt(nProcs, 1), ERA_PROC_MAX );
+    p->vTruths   = Vec_PtrAllocTruthTables( Gia_ManPiNum(pAig) );
+    p->vStates   = Vec_IntAlloc( 100000 * p->nWordsDat );
+    p->vCond     = Vec_IntAlloc( 100000 );
+    p->vPrev     = Vec_IntAlloc( 100000 );
+    p->nBins     = 1 << 17;
+    p->pBins     = ABC_CALLOC( int, 2 * p->nBins );
+    p->vStgDump  = Vec_IntAlloc( 1000 );
+    // state 0 is not used
+    Vec_IntFillExtra( p->vStates, p->nWordsDat, 0 );
+    Vec_IntPush( p->vCond, 0 );
+    Vec_IntPush( p->vPrev, 0 );
+    // allocate simulation data
+    nPats = p->nBatch * p->nPats;
+    for ( i = 0; i < p->nProcs; i++ )
     {
-        pSimInfo = Gia_ManEraData( p, Gia_ObjId(pAig, Gia_ManPi(pAig, i)) );
-        memcpy( pSimInfo, pTruth, sizeof(unsigned) * p->nWordsSim );
+        Gia_EraSim_t * s = p->Sims + i;
+        s->p         = p;
+        s->nWordsSim = Abc_BitWordNum( nPats );
+        s->pDataSim  = ABC_CALLOC( unsigned, s->nWordsSim * Gia_ManObjNum(pAig) );
+        s->pNext     = ABC_ALLOC( unsigned, nPats * p->nWordsDat );
+        s->pKeys     = ABC_ALLOC( unsigned, nPats );
+        s->pOuts     = ABC_ALLOC( unsigned, nPats );
+        s->pFail     = ABC_ALLOC( unsigned, s->nWordsSim );
     }
-    Vec_PtrFree( vTruths );
-    // assign constant zero node
-    pSimInfo = Gia_ManEraData( p, 0 );
-    memset( pSimInfo, 0, sizeof(unsigned) * p->nWordsSim );
-    p->vStgDump = Vec_IntAlloc( 1000 );
     return p;
 }
 
@@ -120,40 +157,28 @@ Gia_ManEra_t * Gia_ManEraCreate( Gia_Man_t * pAig )
 ***********************************************************************/
 void Gia_ManEraFree( Gia_ManEra_t * p )
 {
-    Mem_FixedStop( p->pMemory, 0 );
+    int i;
+    for ( i = 0; i < p->nProcs; i++ )
+    {
+        ABC_FREE( p->Sims[i].pDataSim );
+        ABC_FREE( p->Sims[i].pNext );
+        ABC_FREE( p->Sims[i].pKeys );
+        ABC_FREE( p->Sims[i].pOuts );
+        ABC_FREE( p->Sims[i].pFail );
+    }
+    Vec_PtrFree( p->vTruths );
+    Vec_IntFree( p->vStates );
+    Vec_IntFree( p->vCond );
+    Vec_IntFree( p->vPrev );
     Vec_IntFree( p->vStgDump );
-    Vec_PtrFree( p->vStates );
     if ( p->vBugTrace ) Vec_IntFree( p->vBugTrace );
-    ABC_FREE( p->pDataSim );
     ABC_FREE( p->pBins );
     ABC_FREE( p );
 }
 
 /**Function*************************************************************
 
-  Synopsis    [Creates new state.]
-
-  Description []
-               
-  SideEffects []
-
-  SeeAlso     []
-
-***********************************************************************/
-Gia_ObjEra_t * Gia_ManEraCreateState( Gia_ManEra_t * p )
-{
-    Gia_ObjEra_t * pNew;
-    pNew = (Gia_ObjEra_t *)Mem_FixedEntryFetch( p->pMemory );
-    pNew->Num = Vec_PtrSize( p->vStates );
-    pNew->iPrev = 0;
-    Vec_PtrPush( p->vStates, pNew );
-    return pNew;
-}
-
-
-/**Function*************************************************************
-
-  Synopsis    [Computes hash value of the node using its simulation info.]
+  Synopsis    [Computes hash key of the state.]
 
   Description []
                
@@ -162,57 +187,39 @@ Gia_ObjEra_t * Gia_ManEraCreateState( Gia_ManEra_t * p )
   SeeAlso     []
 
 ***********************************************************************/
-int Gia_ManEraStateHash( unsigned * pState, int nWordsSim, int nTableSize )
+static inline unsigned Gia_ManEraStateHash( unsigned * pState, int nWords )
 {
-    static int s_FPrimes[128] = { 
-        1009, 1049, 1093, 1151, 1201, 1249, 1297, 1361, 1427, 1459, 
-        1499, 1559, 1607, 1657, 1709, 1759, 1823, 1877, 1933, 1997, 
-        2039, 2089, 2141, 2213, 2269, 2311, 2371, 2411, 2467, 2543, 
-        2609, 2663, 2699, 2741, 2797, 2851, 2909, 2969, 3037, 3089, 
-        3169, 3221, 3299, 3331, 3389, 3461, 3517, 3557, 3613, 3671, 
-        3719, 3779, 3847, 3907, 3943, 4013, 4073, 4129, 4201, 4243, 
-        4289, 4363, 4441, 4493, 4549, 4621, 4663, 4729, 4793, 4871, 
-        4933, 4973, 5021, 5087, 5153, 5227, 5281, 5351, 5417, 5471, 
-        5519, 5573, 5651, 5693, 5749, 5821, 5861, 5923, 6011, 6073, 
-        6131, 6199, 6257, 6301, 6353, 6397, 6481, 6563, 6619, 6689, 
-        6737, 6803, 6863, 6917, 6977, 7027, 7109, 7187, 7237, 7309, 
-        7393, 7477, 7523, 7561, 7607, 7681, 7727, 7817, 7877, 7933, 
-        8011, 8039, 8059, 8081, 8093, 8111, 8123, 8147
-    };
-    unsigned uHash;
+    unsigned uHash = 0x9E3779B9;
     int i;
-    uHash = 0;
-    for ( i = 0; i < nWordsSim; i++ )
-        uHash ^= pState[i] * s_FPrimes[i & 0x7F];
-    return uHash % nTableSize;
+    for ( i = 0; i < nWords; i++ )
+        uHash = (uHash ^ pState[i]) * 0x85EBCA6B;
+    uHash ^= uHash >> 16;
+    uHash *= 0xC2B2AE35;
+    uHash ^= uHash >> 13;
+    return uHash;
 }
 
 /**Function*************************************************************
 
-  Synopsis    [Returns the place of this state in the table or NULL if it exists.]
+  Synopsis    [Finds the state in the table.]
 
-  Description []
+  Description [Returns the state number, or 0 if the state is not found. 
+  In the latter case, returns the empty bin for the state in *piBin.]
                
   SideEffects []
 
   SeeAlso     []
 
 ***********************************************************************/
-static inline unsigned * Gia_ManEraHashFind( Gia_ManEra_t * p, Gia_ObjEra_t * pState, int * pStateNum )
+static inline int Gia_ManEraHashFind( Gia_ManEra_t * p, unsigned * pState, unsigned Key, int * piBin )
 {
-    Gia_ObjEra_t * pThis;
-    unsigned * pPlace = p->pBins + Gia_ManEraStateHash( pState->pData, p->nWordsDat, p->nBins );
-    for ( pThis = (*pPlace)? Gia_ManEraState(p, *pPlace) : NULL; pThis; 
-          pPlace = (unsigned *)&pThis->iNext, pThis = (*pPlace)? Gia_ManEraState(p, *pPlace) : NULL )
-              if ( !memcmp( pState->pData, pThis->pData, sizeof(unsigned) * p->nWordsDat ) )
-              {
-                  if ( pStateNum )
-                      *pStateNum = pThis->Num;
-                  return NULL;
-              }
-    if ( pStateNum )
-      *pStateNum = -1;
-    return pPlace;
+    int i, Mask = p->nBins - 1;
+    for ( i = Key & Mask; p->pBins[2*i+1]; i = (i + 1) & Mask )
+        if ( (unsigned)p->pBins[2*i] == Key && 
+             !memcmp(pState, Gia_ManEraState(p, p->pBins[2*i+1]), sizeof(unsigned) * p->nWordsDat) )
+            return p->pBins[2*i+1];
+    *piBin = i;
+    return 0;
 }
 
 /**Function*************************************************************
@@ -228,37 +235,25 @@ static inline unsigned * Gia_ManEraHashFind( Gia_ManEra_t * p, Gia_ObjEra_t * pS
 ***********************************************************************/
 void Gia_ManEraHashResize( Gia_ManEra_t * p )
 {
-    Gia_ObjEra_t * pThis;
-    unsigned * pBinsOld, * piPlace;
-    int nBinsOld, iNext, Counter, i;
-    assert( p->pBins != NULL );
-    // replace the table
-    pBinsOld = p->pBins;
-    nBinsOld = p->nBins;
-    p->nBins = Abc_PrimeCudd( 3 * p->nBins ); 
-    p->pBins = ABC_CALLOC( unsigned, p->nBins );
-    // rehash the entries from the old table
-    Counter = 0;
+    int * pBinsOld = p->pBins;
+    int i, k, Mask, nBinsOld = p->nBins;
+    p->nBins *= 2;
+    p->pBins  = ABC_CALLOC( int, 2 * p->nBins );
+    Mask = p->nBins - 1;
     for ( i = 0; i < nBinsOld; i++ )
-    for ( pThis = (pBinsOld[i]? Gia_ManEraState(p, pBinsOld[i]) : NULL),
-          iNext = (pThis? pThis->iNext : 0);  
-          pThis;  pThis = (iNext? Gia_ManEraState(p, iNext) : NULL),   
-          iNext = (pThis? pThis->iNext : 0)  )
     {
-        assert( pThis->Num );
-        pThis->iNext = 0;
-        piPlace = Gia_ManEraHashFind( p, pThis, NULL );
-        assert( *piPlace == 0 ); // should not be there
-        *piPlace = pThis->Num;
-        Counter++;
+        if ( pBinsOld[2*i+1] == 0 )
+            continue;
+        for ( k = pBinsOld[2*i] & Mask; p->pBins[2*k+1]; k = (k + 1) & Mask );
+        p->pBins[2*k]   = pBinsOld[2*i];
+        p->pBins[2*k+1] = pBinsOld[2*i+1];
     }
-    assert( Counter == Vec_PtrSize( p->vStates ) - 1 );
     ABC_FREE( pBinsOld );
 }
 
 /**Function*************************************************************
 
-  Synopsis    [Initialize register output to the given state.]
+  Synopsis    [Adds new state.]
 
   Description []
                
@@ -267,24 +262,24 @@ void Gia_ManEraHashResize( Gia_ManEra_t * p )
   SeeAlso     []
 
 ***********************************************************************/
-void Gia_ManInsertState( Gia_ManEra_t * p, Gia_ObjEra_t * pState )
+static inline int Gia_ManEraAddState( Gia_ManEra_t * p, unsigned * pState, unsigned Key, int iBin, int Cond, int iPrev )
 {
-    Gia_Obj_t * pObj;
-    unsigned * pSimInfo;
-    int i;
-    Gia_ManForEachRo( p->pAig, pObj, i )
-    {
-        pSimInfo = Gia_ManEraData( p, Gia_ObjId(p->pAig, pObj) );
-        if ( Abc_InfoHasBit(pState->pData, i) )
-            memset( pSimInfo, 0xff, sizeof(unsigned) * p->nWordsSim );
-        else
-            memset( pSimInfo, 0, sizeof(unsigned) * p->nWordsSim );
-    }
+    int w, iState = Vec_IntSize( p->vPrev );
+    for ( w = 0; w < p->nWordsDat; w++ )
+        Vec_IntPush( p->vStates, (int)pState[w] );
+    Vec_IntPush( p->vCond, Cond );
+    Vec_IntPush( p->vPrev, iPrev );
+    p->pBins[2*iBin]   = (int)Key;
+    p->pBins[2*iBin+1] = iState;
+    // expand hash table if needed
+    if ( 2 * Gia_ManEraStateNum(p) > p->nBins )
+        Gia_ManEraHashResize( p );
+    return iState;
 }
 
 /**Function*************************************************************
 
-  Synopsis    [Returns -1 if outputs are not asserted.]
+  Synopsis    [Transposes 32x32 bit matrix.]
 
   Description []
                
@@ -293,106 +288,168 @@ void Gia_ManInsertState( Gia_ManEra_t * p, Gia_ObjEra_t * pState )
   SeeAlso     []
 
 ***********************************************************************/
-static inline int Gia_ManOutputAsserted( Gia_ManEra_t * p, Gia_Obj_t * pObj )
+static inline void Gia_ManEraTranspose32( unsigned a[32] )
 {
-    unsigned * pInfo  = Gia_ManEraData( p, Gia_ObjId(p->pAig, pObj) );
-    int w;
-    for ( w = 0; w < p->nWordsSim; w++ )
-        if ( pInfo[w] )
-            return 32*w + Gia_WordFindFirstBit( pInfo[w] );
-    return -1;
+    unsigned m = 0x0000FFFF, t;
+    int j, k;
+    for ( j = 16; j; j >>= 1, m ^= m << j )
+        for ( k = 0; k < 32; k = ((k | j) + 1) & ~j )
+        {
+            t = ((a[k] >> j) ^ a[k|j]) & m;
+            a[k|j] ^= t;
+            a[k] ^= t << j;
+        }
 }
-
-/**Function*************************************************************
-
-  Synopsis    []
-
-  Description []
-               
-  SideEffects []
-
-  SeeAlso     []
-
-***********************************************************************/
-static inline void Gia_ManSimulateCo( Gia_ManEra_t * p, Gia_Obj_t * pObj )
+static inline void Gia_ManEraSetRange( unsigned * pInfo, int iStart, int nBits )
 {
-    int Id = Gia_ObjId(p->pAig, pObj);
-    unsigned * pInfo  = Gia_ManEraData( p, Id );
-    unsigned * pInfo0 = Gia_ManEraData( p, Gia_ObjFaninId0(pObj, Id) );
-    int w;
-    if ( Gia_ObjFaninC0(pObj) )
-        for ( w = p->nWordsSim-1; w >= 0; w-- )
-            pInfo[w] = ~pInfo0[w];
-    else 
-        for ( w = p->nWordsSim-1; w >= 0; w-- )
-            pInfo[w] = pInfo0[w];
+    if ( nBits >= 32 )
+        memset( pInfo + (iStart >> 5), 0xff, sizeof(unsigned) * (nBits >> 5) );
+    else
+        pInfo[iStart >> 5] |= (~(unsigned)0 >> (32 - nBits)) << (iStart & 31);
 }
 
 /**Function*************************************************************
 
-  Synopsis    []
+  Synopsis    [Simulates a batch of states for all input minterms.]
 
-  Description []
+  Description [Derives the next states of each pattern, their hash keys, 
+  and the values of the outputs.]
                
   SideEffects []
 
   SeeAlso     []
 
 ***********************************************************************/
-static inline void Gia_ManSimulateNode( Gia_ManEra_t * p, Gia_Obj_t * pObj )
+void Gia_ManEraSimulateBatch( Gia_EraSim_t * s )
 {
-    int Id = Gia_ObjId(p->pAig, pObj);
-    unsigned * pInfo  = Gia_ManEraData( p, Id );
-    unsigned * pInfo0 = Gia_ManEraData( p, Gia_ObjFaninId0(pObj, Id) );
-    unsigned * pInfo1 = Gia_ManEraData( p, Gia_ObjFaninId1(pObj, Id) );
-    int w;
-    if ( Gia_ObjFaninC0(pObj) )
+    Gia_ManEra_t * p = s->p;
+    Gia_Man_t * pAig = p->pAig;
+    Gia_Obj_t * pObj;
+    unsigned * pInfo, * pInfo0, * pInfo1, * pTruth, Data[32];
+    int nPats = s->nStates * p->nPats;
+    int nWords = Abc_BitWordNum( nPats );
+    int i, k, k0, d, w, iPat;
+    // assign the inputs
+    Gia_ManForEachPi( pAig, pObj, i )
     {
-        if (  Gia_ObjFaninC1(pObj) )
-            for ( w = p->nWordsSim-1; w >= 0; w-- )
-                pInfo[w] = ~(pInfo0[w] | pInfo1[w]);
-        else 
-            for ( w = p->nWordsSim-1; w >= 0; w-- )
-                pInfo[w] = ~pInfo0[w] & pInfo1[w];
+        pInfo  = Gia_EraSimData( s, Gia_ObjId(pAig, pObj) );
+        pTruth = (unsigned *)Vec_PtrEntry( p->vTruths, i );
+        for ( w = 0; w < nWords; w++ )
+            pInfo[w] = pTruth[w % p->nWordsTt];
+    }
+    // assign the current states (32 states at a time)
+    Gia_ManForEachRo( pAig, pObj, i )
+        memset( Gia_EraSimData(s, Gia_ObjId(pAig, pObj)), 0, sizeof(unsigned) * nWords );
+    for ( k0 = 0; k0 < s->nStates; k0 += 32 )
+    for ( d = 0; d < p->nWordsDat; d++ )
+    {
+        for ( k = 0; k < 32; k++ )
+            Data[k] = k0 + k < s->nStates ? Gia_ManEraState(p, s->iStart + k0 + k)[d] : 0;
+        Gia_ManEraTranspose32( Data );
+        for ( i = 0; i < 32 && 32 * d + i < Gia_ManRegNum(pAig); i++ )
+        {
+            if ( Data[i] == 0 )
+                continue;
+            pInfo = Gia_EraSimData( s, Gia_ObjId(pAig, Gia_ManRo(pAig, 32 * d + i)) );
+            for ( k = 0; k < 32; k++ )
+                if ( (Data[i] >> k) & 1 )
+                    Gia_ManEraSetRange( pInfo, (k0 + k) * p->nPats, p->nPats );
+        }
     }
-    else 
+    // simulate the nodes
+    Gia_ManForEachObj1( pAig, pObj, i )
     {
-        if (  Gia_ObjFaninC1(pObj) )
-            for ( w = p->nWordsSim-1; w >= 0; w-- )
-                pInfo[w] = pInfo0[w] & ~pInfo1[w];
+        if ( Gia_ObjIsCi(pObj) )
+            continue;
+        pInfo  = Gia_EraSimData( s, i );
+        pInfo0 = Gia_EraSimData( s, Gia_ObjFaninId0(pObj, i) );
+        if ( Gia_ObjIsCo(pObj) )
+        {
+            if ( Gia_ObjFaninC0(pObj) )
+                for ( w = 0; w < nWords; w++ )
+                    pInfo[w] = ~pInfo0[w];
+            else 
+                for ( w = 0; w < nWords; w++ )
+                    pInfo[w] = pInfo0[w];
+            continue;
+        }
+        pInfo1 = Gia_EraSimData( s, Gia_ObjFaninId1(pObj, i) );
+        if ( Gia_ObjFaninC0(pObj) )
+        {
+            if ( Gia_ObjFaninC1(pObj) )
+                for ( w = 0; w < nWords; w++ )
+                    pInfo[w] = ~(pInfo0[w] | pInfo1[w]);
+            else 
+                for ( w = 0; w < nWords; w++ )
+                    pInfo[w] = ~pInfo0[w] & pInfo1[w];
+        }
         else 
-            for ( w = p->nWordsSim-1; w >= 0; w-- )
-                pInfo[w] = pInfo0[w] & pInfo1[w];
+        {
+            if ( Gia_ObjFaninC1(pObj) )
+                for ( w = 0; w < nWords; w++ )
+                    pInfo[w] = pInfo0[w] & ~pInfo1[w];
+            else 
+                for ( w = 0; w < nWords; w++ )
+                    pInfo[w] = pInfo0[w] & pInfo1[w];
+        }
+    }
+    // collect the next states (32 patterns at a time)
+    for ( d = 0; d < p->nWordsDat; d++ )
+    for ( w = 0; w < nWords; w++ )
+    {
+        for ( i = 0; i < 32; i++ )
+            Data[i] = 32 * d + i < Gia_ManRegNum(pAig) ? Gia_EraSimData(s, Gia_ObjId(pAig, Gia_ManRi(pAig, 32 * d + i)))[w] : 0;
+        Gia_ManEraTranspose32( Data );
+        for ( i = 0; i < 32 && 32 * w + i < nPats; i++ )
+            s->pNext[(32 * w + i) * p->nWordsDat + d] = Data[i];
+    }
+    for ( iPat = 0; iPat < nPats; iPat++ )
+        s->pKeys[iPat] = Gia_ManEraStateHash( s->pNext + iPat * p->nWordsDat, p->nWordsDat );
+    // collect the outputs
+    memset( s->pOuts, 0, sizeof(unsigned) * nPats );
+    memset( s->pFail, 0, sizeof(unsigned) * nWords );
+    Gia_ManForEachPo( pAig, pObj, i )
+    {
+        pInfo = Gia_EraSimData( s, Gia_ObjId(pAig, pObj) );
+        for ( w = 0; w < nWords; w++ )
+            s->pFail[w] |= pInfo[w];
+        if ( i >= 32 || !p->fStgDump )
+            continue;
+        for ( iPat = 0; iPat < nPats; iPat++ )
+            if ( Abc_InfoHasBit(pInfo, iPat) )
+                s->pOuts[iPat] |= (1u << i);
     }
 }
 
-/**Function*************************************************************
-
-  Synopsis    [Performs one iteration of reachability analysis.]
-
-  Description []
-               
-  SideEffects []
-
-  SeeAlso     []
+#ifdef ABC_USE_PTHREADS
 
-***********************************************************************/
-void Gia_ManPerformOneIter( Gia_ManEra_t * p )
+void * Gia_ManEraWorkerThread( void * pArg )
 {
-    Gia_Obj_t * pObj;
-    int i;
-    Gia_ManForEachObj1( p->pAig, pObj, i )
+    Gia_EraSim_t * s = (Gia_EraSim_t *)pArg;
+    volatile int * pPlace = &s->fWorking;
+    while ( 1 )
     {
-        if ( Gia_ObjIsAnd(pObj) )
-            Gia_ManSimulateNode( p, pObj );
-        else if ( Gia_ObjIsCo(pObj) )
-            Gia_ManSimulateCo( p, pObj );
+        while ( *pPlace == 0 )
+            sched_yield();
+        assert( s->fWorking );
+        if ( s->iStart == -1 )
+        {
+            pthread_exit( NULL );
+            assert( 0 );
+            return NULL;
+        }
+        Gia_ManEraSimulateBatch( s );
+        s->fWorking = 0;
     }
+    assert( 0 );
+    return NULL;
 }
 
+#endif // pthreads are used
+
 /**Function*************************************************************
 
-  Synopsis    [Performs one iteration of reachability analysis.]
+  Synopsis    [Collects the bug trace.]
 
   Description []
                
@@ -401,13 +458,13 @@ void Gia_ManPerformOneIter( Gia_ManEra_t * p )
   SeeAlso     []
 
 ***********************************************************************/
-Vec_Int_t * Gia_ManCollectBugTrace( Gia_ManEra_t * p, Gia_ObjEra_t * pState, int iCond )
+Vec_Int_t * Gia_ManCollectBugTrace( Gia_ManEra_t * p, int iState, int iCond )
 {
     Vec_Int_t * vTrace;
     vTrace = Vec_IntAlloc( 10 );
     Vec_IntPush( vTrace, iCond );
-    for ( ; pState; pState = pState->iPrev ? Gia_ManEraState(p, pState->iPrev) : NULL )
-        Vec_IntPush( vTrace, pState->Cond );
+    for ( ; iState; iState = Vec_IntEntry(p->vPrev, iState) )
+        Vec_IntPush( vTrace, Vec_IntEntry(p->vCond, iState) );
     Vec_IntReverseOrder( vTrace );
     return vTrace;
 }
@@ -425,12 +482,8 @@ Vec_Int_t * Gia_ManCollectBugTrace( Gia_ManEra_t * p, Gia_ObjEra_t * pState, int
 ***********************************************************************/
 int Gia_ManCountDepth( Gia_ManEra_t * p )
 {
-    Gia_ObjEra_t * pState;
-    int Counter = 0;
-    pState = (Gia_ObjEra_t *)Vec_PtrEntryLast( p->vStates );
-    if ( pState->iPrev == 0 && Vec_PtrSize(p->vStates) > 3 )
-        pState = (Gia_ObjEra_t *)Vec_PtrEntry( p->vStates, Vec_PtrSize(p->vStates) - 2 );
-    for ( ; pState; pState = pState->iPrev ? Gia_ManEraState(p, pState->iPrev) : NULL )
+    int iState, Counter = 0;
+    for ( iState = Gia_ManEraStateNum(p); iState; iState = Vec_IntEntry(p->vPrev, iState) )
         Counter++;
     return Counter;
 }
@@ -439,142 +492,154 @@ int Gia_ManCountDepth( Gia_ManEra_t * p )
 
   Synopsis    [Analized reached states.]
 
-  Description []
+  Description [Adds the next states of state iState, which is number k 
+  in the simulated batch. Returns 1 if the miter is asserted.]
                
   SideEffects []
 
   SeeAlso     []
 
 ***********************************************************************/
-int Gia_ManAnalyzeResult( Gia_ManEra_t * p, Gia_ObjEra_t * pState, int fMiter, int fStgDump )
+int Gia_ManAnalyzeResult( Gia_ManEra_t * p, Gia_EraSim_t * s, int k, int fMiter, int fStgDump )
 {
-    Gia_Obj_t * pObj;
-    unsigned * pSimInfo, * piPlace, uOutput = 0;
-    int i, k, iCond, nMints, iNextState;
+    unsigned * pState;
+    int i, iPat, iState = s->iStart + k, iNextState, iBin;
     // check if the miter is asserted
     if ( fMiter )
     {
-        Gia_ManForEachPo( p->pAig, pObj, i )
-        {
-            iCond = Gia_ManOutputAsserted( p, pObj );
-            if ( iCond >= 0 )
+        for ( i = 0; i < p->nPats; i++ )
+            if ( Abc_InfoHasBit(s->pFail, k * p->nPats + i) )
             {
-                p->vBugTrace = Gia_ManCollectBugTrace( p, pState, iCond );
+                p->vBugTrace = Gia_ManCollectBugTrace( p, iState, i );
                 return 1;
             }
-        }
     }
     // collect reached states 
-    nMints = (1 << Gia_ManPiNum(p->pAig));
-    for ( k = 0; k < nMints; k++ )
+    for ( i = 0; i < p->nPats; i++ )
     {
-        if ( p->pStateNew == NULL )
-            p->pStateNew = Gia_ManEraCreateState( p );
-        p->pStateNew->pData[p->nWordsDat-1] = 0;
-        Gia_ManForEachRi( p->pAig, pObj, i )
-        {
-            pSimInfo = Gia_ManEraData( p, Gia_ObjId(p->pAig, pObj) );
-            if ( Abc_InfoHasBit(p->pStateNew->pData, i) != Abc_InfoHasBit(pSimInfo, k) )
-                Abc_InfoXorBit( p->pStateNew->pData, i );
-        }
-        if ( fStgDump )
-        {
-            uOutput = 0;
-            Gia_ManForEachPo( p->pAig, pObj, i )
-            {
-                pSimInfo = Gia_ManEraData( p, Gia_ObjId(p->pAig, pObj) );
-                if ( Abc_InfoHasBit(pSimInfo, k) && i < 32 )
-                    Abc_InfoXorBit( &uOutput, i );
-            }
-        }
-        piPlace = Gia_ManEraHashFind( p, p->pStateNew, &iNextState );
-        if ( fStgDump ) Vec_IntPush( p->vStgDump, k );
-        if ( fStgDump ) Vec_IntPush( p->vStgDump, pState->Num );
-        if ( piPlace == NULL )
-        {
-            if ( fStgDump ) Vec_IntPush( p->vStgDump, iNextState );
-            if ( fStgDump ) Vec_IntPush( p->vStgDump, uOutput );
-            continue;
-        }
-        if ( fStgDump ) Vec_IntPush( p->vStgDump, p->pStateNew->Num );
-        if ( fStgDump ) Vec_IntPush( p->vStgDump, uOutput );
-//printf( "Inserting %d ", Vec_PtrSize(p->vStates) );
-//Extra_PrintBinary( stdout, p->pStateNew->pData, Gia_ManRegNum(p->pAig) );  printf( "\n" );
-        assert( *piPlace == 0 );
-        *piPlace = p->pStateNew->Num;
-        p->pStateNew->Cond = k;
-        p->pStateNew->iPrev = pState->Num;
-        p->pStateNew->iNext = 0;
-        p->pStateNew = NULL;
-        // expand hash table if needed
-        if ( Vec_PtrSize(p->vStates) > 2 * p->nBins )
-            Gia_ManEraHashResize( p );
+        iPat = k * p->nPats + i;
+        pState = s->pNext + iPat * p->nWordsDat;
+        iNextState = Gia_ManEraHashFind( p, pState, s->pKeys[iPat], &iBin );
+        if ( iNextState == 0 )
+            iNextState = Gia_ManEraAddState( p, pState, s->pKeys[iPat], iBin, i, iState );
+        if ( fStgDump ) Vec_IntPush( p->vStgDump, i );
+        if ( fStgDump ) Vec_IntPush( p->vStgDump, iState );
+        if ( fStgDump ) Vec_IntPush( p->vStgDump, iNextState );
+        if ( fStgDump ) Vec_IntPush( p->vStgDump, s->pOuts[iPat] );
     }
     return 0;
 }
 
 /**Function*************************************************************
 
-  Synopsis    [Resizes the hash table.]
+  Synopsis    [Performs explicit reachability analysis.]
 
-  Description []
+  Description [The states not yet explored are divided into batches, 
+  which are simulated by several threads. The next states are added to 
+  the table by the main thread in the order of the current states, so 
+  the numbering of the states does not depend on the number of threads.]
                
   SideEffects []
 
   SeeAlso     []
 
 ***********************************************************************/
-int Gia_ManCollectReachable( Gia_Man_t * pAig, int nStatesMax, int fMiter, int fDumpFile, int fVerbose )
+int Gia_ManCollectReachable( Gia_Man_t * pAig, int nStatesMax, int fMiter, int fDumpFile, int nProcs, int fVerbose )
 { 
     Gia_ManEra_t * p;
-    Gia_ObjEra_t * pState;
-    int Hash;
+    unsigned * pState;
+    int i, k, iBin = -1, nBatches, iNext;
     abctime clk = Abc_Clock();
     int RetValue = 1;
+#ifdef ABC_USE_PTHREADS
+    pthread_t WorkerThread[ERA_PROC_MAX];
+    int status;
+#endif
     assert( Gia_ManPiNum(pAig) <= 12 );
     assert( Gia_ManRegNum(pAig) > 0 );
-    p = Gia_ManEraCreate( pAig );
+    p = Gia_ManEraCreate( pAig, nProcs );
+    p->fStgDump = fDumpFile;
     // create init state
-    pState = Gia_ManEraCreateState( p );
-    pState->Cond  = 0; 
-    pState->iPrev = 0;
-    pState->iNext = 0; 
-    memset( pState->pData, 0, sizeof(unsigned) * p->nWordsDat );
-    Hash = Gia_ManEraStateHash(pState->pData, p->nWordsDat, p->nBins);
-    p->pBins[ Hash ] = pState->Num;
+    pState = ABC_CALLOC( unsigned, p->nWordsDat );
+    Gia_ManEraHashFind( p, pState, Gia_ManEraStateHash(pState, p->nWordsDat), &iBin );
+    Gia_ManEraAddState( p, pState, Gia_ManEraStateHash(pState, p->nWordsDat), iBin, 0, 0 );
+    ABC_FREE( pState );
+#ifdef ABC_USE_PTHREADS
+    if ( p->nProcs > 1 )
+    for ( i = 0; i < p->nProcs; i++ )
+    {
+        p->Sims[i].fWorking = 0;
+        status = pthread_create( WorkerThread + i, NULL, Gia_ManEraWorkerThread, (void *)(p->Sims + i) );  assert( status == 0 );
+    }
+#endif
     // process reachable states
-    while ( p->iCurState < Vec_PtrSize( p->vStates ) - 1 )
+    while ( p->iCurState < Gia_ManEraStateNum(p) && RetValue == 1 )
     {
-        if ( Vec_PtrSize(p->vStates) >= nStatesMax )
+        // divide the states not yet explored into batches
+        iNext = p->iCurState + 1;
+        for ( nBatches = 0; nBatches < p->nProcs && iNext <= Gia_ManEraStateNum(p); nBatches++ )
         {
-            printf( "Reached the limit on states traversed (%d).  ", nStatesMax );
-            RetValue = -1;
-            break;
+            p->Sims[nBatches].iStart  = iNext;
+            p->Sims[nBatches].nStates = Abc_MinInt( p->nBatch, Gia_ManEraStateNum(p) - iNext + 1 );
+            iNext += p->Sims[nBatches].nStates;
         }
-        pState = Gia_ManEraState( p, ++p->iCurState );
-        if ( p->iCurState > 1 && pState->iPrev == 0 )
-            continue;
-//printf( "Extracting %d  ", p->iCurState );
-//Extra_PrintBinary( stdout, p->pStateNew->pData, Gia_ManRegNum(p->pAig) );  printf( "\n" );
-        Gia_ManInsertState( p, pState );
-        Gia_ManPerformOneIter( p );
-        if ( Gia_ManAnalyzeResult( p, pState, fMiter, fDumpFile ) && fMiter )
+        // simulate the batches
+#ifdef ABC_USE_PTHREADS
+        if ( p->nProcs > 1 )
         {
-            RetValue = 0;
-            printf( "Miter failed in state %d after %d transitions.  ", 
-                p->iCurState, Vec_IntSize(p->vBugTrace)-1 );
-            break;
+            for ( i = 0; i < nBatches; i++ )
+                p->Sims[i].fWorking = 1;
+            for ( i = 0; i < nBatches; i++ )
+                while ( ((volatile int *)&p->Sims[i].fWorking)[0] )
+                    sched_yield();
         }
-        if ( fVerbose && p->iCurState % 5000 == 0 )
+        else
+#endif
+        for ( i = 0; i < nBatches; i++ )
+            Gia_ManEraSimulateBatch( p->Sims + i );
+        // add the next states in the order of the current states
+        for ( i = 0; i < nBatches && RetValue == 1; i++ )
+        for ( k = 0; k < p->Sims[i].nStates; k++ )
         {
-            printf( "States =%10d. Reached =%10d. R = %5.3f. Depth =%6d. Mem =%9.2f MB.  ", 
-                p->iCurState, Vec_PtrSize(p->vStates), 1.0*p->iCurState/Vec_PtrSize(p->vStates), Gia_ManCountDepth(p), 
-                (1.0/(1<<20))*(1.0*Vec_PtrSize(p->vStates)*(sizeof(Gia_ObjEra_t) + sizeof(unsigned) * p->nWordsDat) + 
-                   1.0*p->nBins*sizeof(unsigned) + 1.0*p->vStates->nCap * sizeof(void*)) );
-            ABC_PRT( "Time", Abc_Clock() - clk );
+            if ( Gia_ManEraStateNum(p) >= nStatesMax )
+            {
+                printf( "Reached the limit on states traversed (%d).  ", nStatesMax );
+                RetValue = -1;
+                break;
+            }
+            p->iCurState++;
+            assert( p->iCurState == p->Sims[i].iStart + k );
+            if ( Gia_ManAnalyzeResult( p, p->Sims + i, k, fMiter, fDumpFile ) && fMiter )
+            {
+                RetValue = 0;
+                printf( "Miter failed in state %d after %d transitions.  ", 
+                    p->iCurState, Vec_IntSize(p->vBugTrace)-1 );
+                break;
+            }
+            if ( fVerbose && p->iCurState % 5000 == 0 )
+            {
+                printf( "States =%10d. Reached =%10d. R = %5.3f. Depth =%6d. Mem =%9.2f MB.  ", 
+                    p->iCurState, Gia_ManEraStateNum(p), 1.0*p->iCurState/Gia_ManEraStateNum(p), Gia_ManCountDepth(p), 
+                    (1.0/(1<<20))*(4.0*(Vec_IntCap(p->vStates) + Vec_IntCap(p->vCond) + Vec_IntCap(p->vPrev)) + 
+                       2.0*p->nBins*sizeof(int)) );
+                ABC_PRT( "Time", Abc_Clock() - clk );
+            }
         }
     }
-    printf( "Reachability analysis traversed %d states with depth %d.  ", p->iCurState-1, Gia_ManCountDepth(p) );
+#ifdef ABC_USE_PTHREADS
+    // stop the threads
+    if ( p->nProcs > 1 )
+    for ( i = 0; i < p->nProcs; i++ )
+    {
+        assert( p->Sims[i].fWorking == 0 );
+        p->Sims[i].iStart = -1;
+        p->Sims[i].fWorking = 1;
+    }
+    if ( p->nProcs > 1 )
+    for ( i = 0; i < p->nProcs; i++ )
+        pthread_join( WorkerThread[i], NULL );
+#endif
+    printf( "Reachability analysis traversed %d states with depth %d.  ", p->iCurState, Gia_ManCountDepth(p) );
     ABC_PRT( "Time", Abc_Clock() - clk );
     if ( fDumpFile )
     {
@@ -584,7 +649,7 @@ int Gia_ManCollectReachable( Gia_Man_t * pAig, int nStatesMax, int fMiter, int f
             printf( "Cannot open file \"%s\" for writing.\n", pFileName );
         else
         {
-            Gia_ManStgPrint( pFile, p->vStgDump, Gia_ManPiNum(pAig), Gia_ManPoNum(pAig), p->iCurState-1 );
+            Gia_ManStgPrint( pFile, p->vStgDump, Gia_ManPiNum(pAig), Gia_ManPoNum(pAig), Gia_ManEraStateNum(p) );
             fclose( pFile );
             printf( "Extracted STG was written into file \"%s\".\n", pFileName );
         }
@@ -599,4 +664,3 @@ int Gia_ManCollectReachable( Gia_Man_t * pAig, int nStatesMax, int fMiter, int f
 
 
 ABC_NAMESPACE_IMPL_END
-
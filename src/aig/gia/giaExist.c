@@ -20,6 +20,18 @@
 
 #include "gia.h"
 #include "misc/util/utilTruth.h"
+#include "misc/vec/vecMem.h"
+
+#ifdef ABC_USE_PTHREADS
+
+#ifdef _WIN32
+#include "../lib/pthread.h"
+#else
+#include <pthread.h>
+#include <unistd.h>
+#endif
+
+#endif
 
 ABC_NAMESPACE_IMPL_START
 
@@ -27,6 +39,37 @@ ABC_NAMESPACE_IMPL_START
 ///                        DECLARATIONS                              ///
 ////////////////////////////////////////////////////////////////////////
 
+#define GIA_QUA_PROC_MAX  16
+
+// quantification of one output cone
+typedef struct Gia_QuaJob_t_ Gia_QuaJob_t;
+struct Gia_QuaJob_t_
+{
+    Gia_Man_t *   pCone;        // the cone of the output (replaced by the result)
+    Vec_Int_t *   vVars;        // the PIs to quantify
+    int           iOut;         // the output
+    int           Status;       // 1 if all variables are quantified
+    int           nVars;        // the number of quantified variables
+    int           nSweeps;      // the number of sweeps
+    int           nMerged;      // the number of nodes merged by sweeping
+    int           nAndsMax;     // the largest intermediate cone
+    word          Seed;         // the random seed of this cone
+};
+
+// the data of one worker thread
+typedef struct Gia_QuaThData_t_ Gia_QuaThData_t;
+struct Gia_QuaThData_t_
+{
+    Gia_QuaJob_t * pJobs;       // the jobs
+    int *         pOrder;       // the order of the jobs
+    int           nJobs;        // the number of jobs
+    int           iFirst;       // the first job of this thread
+    int           nStep;        // the distance between the jobs of this thread
+    Gia_ParQua_t * pPars;       // the parameters
+    abctime       TimeStop;     // the time limit
+    int *         pfFail;       // set when one of the jobs fails
+};
+
 ////////////////////////////////////////////////////////////////////////
 ///                     FUNCTION DEFINITIONS                         ///
 ////////////////////////////////////////////////////////////////////////
@@ -517,6 +560,447 @@ int Gia_ManQuantExist( Gia_Man_t * p0, int iLit, int(*pFuncCiToKeep)(void *, int
 }
 
 
+/**Function*************************************************************
+
+  Synopsis    [Sets the default parameters of the quantification engine.]
+
+  Description []
+               
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+void Gia_ManQuantSetDefaultParams( Gia_ParQua_t * p )
+{
+    memset( p, 0, sizeof(Gia_ParQua_t) );
+    p->nProcs    =      1;   // the number of threads
+    p->nNodeMax  = 100000;   // the largest number of AIG nodes in one cone
+    p->TimeLimit =      0;   // time limit in seconds
+    p->nBTLimit  =    100;   // conflict limit used by sweeping
+    p->nSimWords =      4;   // the number of simulation words used by sweeping
+    p->fUniv     =      0;   // universal quantification
+    p->fSweep    =      1;   // sweeping of intermediate results
+    p->fVerbose  =      0;   // enables verbose output
+}
+
+/**Function*************************************************************
+
+  Synopsis    [Collects the variables to quantify in the support of the cone.]
+
+  Description [The cone has one PO and the same PIs as the original AIG.]
+               
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+static void Gia_QuaConeSupp( Gia_Man_t * q, Vec_Int_t * vVars, Vec_Int_t * vSupp )
+{
+    Gia_Obj_t * pObj;
+    int i, iVar, * pUsed = ABC_CALLOC( int, Gia_ManObjNum(q) );
+    Gia_ManForEachAnd( q, pObj, i )
+    {
+        pUsed[Gia_ObjFaninId0(pObj, i)] = 1;
+        pUsed[Gia_ObjFaninId1(pObj, i)] = 1;
+    }
+    Gia_ManForEachPo( q, pObj, i )
+        pUsed[Gia_ObjFaninId0p(q, pObj)] = 1;
+    Vec_IntClear( vSupp );
+    Vec_IntForEachEntry( vVars, iVar, i )
+        if ( pUsed[Gia_ObjId(q, Gia_ManPi(q, iVar))] )
+            Vec_IntPush( vSupp, iVar );
+    ABC_FREE( pUsed );
+}
+
+/**Function*************************************************************
+
+  Synopsis    [Estimates the cost of quantifying a variable.]
+
+  Description [Returns the number of AND nodes in the TFO of the PI,
+  which are the nodes duplicated when the two cofactors are derived.]
+               
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+static int Gia_QuaVarCost( Gia_Man_t * q, int iVar, char * pMarks )
+{
+    Gia_Obj_t * pObj;
+    int i, Count = 0;
+    memset( pMarks, 0, sizeof(char) * Gia_ManObjNum(q) );
+    pMarks[Gia_ObjId(q, Gia_ManPi(q, iVar))] = 1;
+    Gia_ManForEachAnd( q, pObj, i )
+        if ( (pMarks[i] = pMarks[Gia_ObjFaninId0(pObj, i)] | pMarks[Gia_ObjFaninId1(pObj, i)]) )
+            Count++;
+    return Count;
+}
+
+/**Function*************************************************************
+
+  Synopsis    [Sweeps the cone by merging proved equivalent nodes.]
+
+  Description [Equivalence candidates are the nodes with the same random
+  simulation signature up to complementation. Each candidate is compared
+  with the first node of its class using the circuit-based SAT solver 
+  with a small conflict limit; disproved or undecided candidates are 
+  simply skipped. All state is local to the cone, so several cones can 
+  be swept concurrently.]
+               
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+static Gia_Man_t * Gia_QuaSweep( Gia_Man_t * q, int nWords, int nBTLimit, word * pSeed, abctime TimeStop, int * pnMerged )
+{
+    Gia_Man_t * pNew, * pTemp;
+    Gia_Obj_t * pObj, * pRepr;
+    Cbs_Man_t * pSat;
+    Vec_Mem_t * vSigs;
+    word * pSims = ABC_CALLOC( word, (size_t)nWords * Gia_ManObjNum(q) );
+    word * pTemp2 = ABC_ALLOC( word, nWords );
+    int * pFirst = ABC_FALLOC( int, Gia_ManObjNum(q) );
+    int * pRepLits = ABC_FALLOC( int, Gia_ManObjNum(q) );
+    int i, k, iClass, iRepr, fCompl, nMerged = 0;
+    // simulate random patterns
+    Gia_ManForEachCi( q, pObj, i )
+        for ( k = 0; k < nWords; k++ )
+        {
+            // xorshift generator private to the cone
+            *pSeed ^= *pSeed << 13; *pSeed ^= *pSeed >> 7; *pSeed ^= *pSeed << 17;
+            pSims[nWords * Gia_ObjId(q, pObj) + k] = *pSeed;
+        }
+    Gia_ManForEachAnd( q, pObj, i )
+        Abc_TtAndCompl( pSims + nWords * i, 
+            pSims + nWords * Gia_ObjFaninId0(pObj, i), Gia_ObjFaninC0(pObj), 
+            pSims + nWords * Gia_ObjFaninId1(pObj, i), Gia_ObjFaninC1(pObj), nWords );
+    // find the candidates and prove them
+    vSigs = Vec_MemAlloc( nWords, 12 );
+    Vec_MemHashAlloc( vSigs, 1 << 12 );
+    Gia_ManCreateRefs( q );
+    Gia_ManCleanMark01( q );
+    Gia_ManFillValue( q );
+    pSat = Cbs_ManAlloc( q );
+    Cbs_ManSetConflictNum( pSat, nBTLimit );
+    Gia_ManForEachObj( q, pObj, i )
+    {
+        if ( !Gia_ObjIsAnd(pObj) && !Gia_ObjIsCi(pObj) && i > 0 )
+            continue;
+        fCompl = (int)(pSims[nWords * i] & 1);
+        Abc_TtCopy( pTemp2, pSims + nWords * i, nWords, fCompl );
+        iClass = Vec_MemHashInsert( vSigs, pTemp2 );
+        if ( pFirst[iClass] == -1 )
+        {
+            pFirst[iClass] = i;
+            continue;
+        }
+        if ( !Gia_ObjIsAnd(pObj) || (TimeStop && Abc_Clock() > TimeStop) )
+            continue;
+        iRepr  = pFirst[iClass];
+        fCompl ^= (int)(pSims[nWords * iRepr] & 1);
+        pRepr  = Gia_ManObj( q, iRepr );
+        if ( iRepr == 0 )
+        {
+            // the node is a constant if it cannot differ from it
+            if ( Cbs_ManSolve( pSat, Gia_NotCond(pObj, fCompl) ) != 1 )
+                continue;
+        }
+        else
+        {
+            if ( Cbs_ManSolve2( pSat, pObj, Gia_NotCond(pRepr, !fCompl) ) != 1 )
+                continue;
+            if ( Cbs_ManSolve2( pSat, Gia_Not(pObj), Gia_NotCond(pRepr, fCompl) ) != 1 )
+                continue;
+        }
+        pRepLits[i] = Abc_Var2Lit( iRepr, fCompl );
+        nMerged++;
+    }
+    Cbs_ManStop( pSat );
+    Vec_MemHashFree( vSigs );
+    Vec_MemFree( vSigs );
+    ABC_FREE( pSims );
+    ABC_FREE( pTemp2 );
+    ABC_FREE( pFirst );
+    // derive the reduced cone
+    Gia_ManCleanMark01( q );
+    Gia_ManFillValue( q );
+    pNew = Gia_ManStart( Gia_ManObjNum(q) );
+    pNew->pName = Abc_UtilStrsav( q->pName );
+    Gia_ManHashAlloc( pNew );
+    Gia_ManConst0(q)->Value = 0;
+    Gia_ManForEachCi( q, pObj, i )
+        pObj->Value = Gia_ManAppendCi( pNew );
+    Gia_ManForEachAnd( q, pObj, i )
+        if ( pRepLits[i] >= 0 )
+            pObj->Value = Abc_LitNotCond( Gia_ManObj(q, Abc_Lit2Var(pRepLits[i]))->Value, Abc_LitIsCompl(pRepLits[i]) );
+        else
+            pObj->Value = Gia_ManHashAnd( pNew, Gia_ObjFanin0Copy(pObj), Gia_ObjFanin1Copy(pObj) );
+    Gia_ManForEachCo( q, pObj, i )
+        Gia_ManAppendCo( pNew, Gia_ObjFanin0Copy(pObj) );
+    Gia_ManHashStop( pNew );
+    ABC_FREE( pRepLits );
+    pNew = Gia_ManCleanup( pTemp = pNew );
+    Gia_ManStop( pTemp );
+    *pnMerged += nMerged;
+    return pNew;
+}
+
+/**Function*************************************************************
+
+  Synopsis    [Quantifies the variables of one cone.]
+
+  Description [The variables are scheduled greedily: at each step, the
+  variable with the smallest TFO is quantified. The cone is swept after
+  each step that increased its size. Returns 0 if the node or time budget 
+  was exceeded.]
+               
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+static int Gia_QuaConeQuantify( Gia_QuaJob_t * pJob, Gia_ParQua_t * pPars, abctime TimeStop )
+{
+    Gia_Man_t * q = pJob->pCone, * pTemp;
+    Vec_Int_t * vSupp = Vec_IntAlloc( Vec_IntSize(pJob->vVars) );
+    Vec_Int_t * vLeft = Vec_IntAlloc( Vec_IntSize(pJob->vVars) );
+    char * pMarks = NULL;
+    int i, iVar, Cost, iBest, CostBest, nAndsSwept = Gia_ManAndNum(q);
+    pJob->nAndsMax = Gia_ManAndNum(q);
+    Gia_QuaConeSupp( q, pJob->vVars, vSupp );
+    while ( Vec_IntSize(vSupp) > 0 )
+    {
+        if ( TimeStop && Abc_Clock() > TimeStop )
+            break;
+        // select the cheapest variable
+        pMarks = ABC_REALLOC( char, pMarks, Gia_ManObjNum(q) );
+        iBest = -1; CostBest = ABC_INFINITY;
+        Vec_IntForEachEntry( vSupp, iVar, i )
+            if ( (Cost = Gia_QuaVarCost(q, iVar, pMarks)) < CostBest )
+                CostBest = Cost, iBest = iVar;
+        // quantify it
+        if ( pPars->fUniv )
+            q = Gia_ManDupUniv( pTemp = q, iBest );
+        else
+            q = Gia_ManDupExist( pTemp = q, iBest );
+        Gia_ManStop( pTemp );
+        pJob->nVars++;
+        pJob->nAndsMax = Abc_MaxInt( pJob->nAndsMax, Gia_ManAndNum(q) );
+        if ( pPars->fSweep && Gia_ManAndNum(q) > nAndsSwept )
+        {
+            q = Gia_QuaSweep( pTemp = q, pPars->nSimWords, pPars->nBTLimit, &pJob->Seed, TimeStop, &pJob->nMerged );
+            Gia_ManStop( pTemp );
+            nAndsSwept = Gia_ManAndNum(q);
+            pJob->nSweeps++;
+        }
+        if ( Gia_ManAndNum(q) > pPars->nNodeMax )
+            break;
+        Vec_IntRemove( vSupp, iBest );
+        Gia_QuaConeSupp( q, vSupp, vLeft );
+        ABC_SWAP( Vec_Int_t *, vSupp, vLeft );
+    }
+    pJob->pCone = q;
+    pJob->Status = (Vec_IntSize(vSupp) == 0);
+    Vec_IntFree( vSupp );
+    Vec_IntFree( vLeft );
+    ABC_FREE( pMarks );
+    return pJob->Status;
+}
+
+/**Function*************************************************************
+
+  Synopsis    [Runs the cone jobs on several threads.]
+
+  Description []
+               
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+void * Gia_QuaWorkerThread( void * pArg )
+{
+    Gia_QuaThData_t * pThData = (Gia_QuaThData_t *)pArg;
+    int i;
+    for ( i = pThData->iFirst; i < pThData->nJobs; i += pThData->nStep )
+    {
+        Gia_QuaJob_t * pJob = pThData->pJobs + pThData->pOrder[i];
+        if ( *pThData->pfFail )
+            continue;
+        if ( !Gia_QuaConeQuantify(pJob, pThData->pPars, pThData->TimeStop) )
+            *pThData->pfFail = 1;
+    }
+    return NULL;
+}
+static void Gia_QuaRunJobs( Gia_QuaJob_t * pJobs, int * pOrder, int nJobs, Gia_ParQua_t * pPars, abctime TimeStop, int * pfFail )
+{
+    Gia_QuaThData_t ThData[GIA_QUA_PROC_MAX];
+    int i, nProcs = Abc_MaxInt( 1, Abc_MinInt(pPars->nProcs, Abc_MinInt(nJobs, GIA_QUA_PROC_MAX)) );
+    for ( i = 0; i < nProcs; i++ )
+    {
+        ThData[i].pJobs    = pJobs;
+        ThData[i].pOrder   = pOrder;
+        ThData[i].nJobs    = nJobs;
+        ThData[i].iFirst   = i;
+        ThData[i].nStep    = nProcs;
+        ThData[i].pPars    = pPars;
+        ThData[i].TimeStop = TimeStop;
+        ThData[i].pfFail   = pfFail;
+    }
+#ifdef ABC_USE_PTHREADS
+    if ( nProcs > 1 )
+    {
+        pthread_t WorkerThread[GIA_QUA_PROC_MAX];
+        int status;
+        for ( i = 1; i < nProcs; i++ )
+        {
+            status = pthread_create( WorkerThread + i, NULL, Gia_QuaWorkerThread, (void *)(ThData + i) );
+            assert( status == 0 );
+        }
+        Gia_QuaWorkerThread( (void *)ThData );
+        for ( i = 1; i < nProcs; i++ )
+            pthread_join( WorkerThread[i], NULL );
+        return;
+    }
+#endif
+    for ( i = 0; i < nProcs; i++ )
+        Gia_QuaWorkerThread( (void *)(ThData + i) );
+}
+
+/**Function*************************************************************
+
+  Synopsis    [Quantifies the given PIs from all outputs.]
+
+  Description [Each output whose cone depends on the variables becomes
+  an independent job: its cone is extracted into a private AIG, which is
+  quantified variable by variable with its own structural hashing and 
+  sweeping, so the jobs run in parallel without sharing any state. The
+  jobs are started from the largest cone. The results are merged back
+  into one structurally hashed AIG in the order of the outputs, so the 
+  result does not depend on the number of threads. The quantified PIs
+  remain in the result as dangling PIs. Returns NULL if a cone exceeds
+  the node budget or the time limit is reached.]
+               
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+Gia_Man_t * Gia_ManQuantPar( Gia_Man_t * p, Vec_Int_t * vVars, Gia_ParQua_t * pPars )
+{
+    Gia_Man_t * pNew, * pTemp;
+    Gia_Obj_t * pObj;
+    Gia_QuaJob_t * pJobs;
+    Vec_Int_t * vSupp = Vec_IntAlloc( Vec_IntSize(vVars) );
+    Vec_Int_t * vCosts;
+    int * pOrder, * pJobOfPo;
+    int i, k, nJobs = 0, fFail = 0, nVarsAll = 0, nSweeps = 0, nMerged = 0, nAndsMax = 0;
+    abctime clk = Abc_Clock();
+    abctime TimeStop = pPars->TimeLimit ? Abc_Clock() + pPars->TimeLimit * CLOCKS_PER_SEC : 0;
+    assert( Gia_ManRegNum(p) == 0 );
+    // extract the cones depending on the variables
+    pJobs    = ABC_CALLOC( Gia_QuaJob_t, Gia_ManPoNum(p) );
+    pJobOfPo = ABC_FALLOC( int, Gia_ManPoNum(p) );
+    vCosts   = Vec_IntAlloc( Gia_ManPoNum(p) );
+    for ( i = 0; i < Gia_ManPoNum(p); i++ )
+    {
+        Gia_Man_t * pCone = Gia_ManDupCones( p, &i, 1, 0 );
+        Gia_QuaConeSupp( pCone, vVars, vSupp );
+        if ( Vec_IntSize(vSupp) == 0 )
+        {
+            Gia_ManStop( pCone );
+            continue;
+        }
+        pJobs[nJobs].pCone = pCone;
+        pJobs[nJobs].vVars = Vec_IntDup( vSupp );
+        pJobs[nJobs].iOut  = i;
+        pJobs[nJobs].Seed  = ABC_CONST(0x9E3779B97F4A7C15) ^ (word)(i + 1);
+        Vec_IntPush( vCosts, Gia_ManAndNum(pCone) * Vec_IntSize(vSupp) );
+        pJobOfPo[i] = nJobs++;
+    }
+    Vec_IntFree( vSupp );
+    // run the jobs starting from the most expensive ones
+    pOrder = Abc_MergeSortCost( Vec_IntArray(vCosts), nJobs );
+    for ( i = 0; i < nJobs / 2; i++ )
+        ABC_SWAP( int, pOrder[i], pOrder[nJobs - 1 - i] );
+    Gia_QuaRunJobs( pJobs, pOrder, nJobs, pPars, TimeStop, &fFail );
+    ABC_FREE( pOrder );
+    Vec_IntFree( vCosts );
+    for ( k = 0; k < nJobs; k++ )
+    {
+        fFail |= !pJobs[k].Status;
+        nVarsAll += pJobs[k].nVars;
+        nSweeps  += pJobs[k].nSweeps;
+        nMerged  += pJobs[k].nMerged;
+        nAndsMax  = Abc_MaxInt( nAndsMax, pJobs[k].nAndsMax );
+    }
+    if ( pPars->fVerbose )
+    {
+        printf( "Outputs = %d. Cones = %d. Quantified vars = %d. Sweeps = %d. Merged = %d. Max cone = %d. Threads = %d.  ", 
+            Gia_ManPoNum(p), nJobs, nVarsAll, nSweeps, nMerged, nAndsMax, Abc_MaxInt(1, Abc_MinInt(pPars->nProcs, nJobs)) );
+        Abc_PrintTime( 1, "Time", Abc_Clock() - clk );
+    }
+    pNew = NULL;
+    if ( fFail )
+    {
+        if ( TimeStop && Abc_Clock() > TimeStop )
+            printf( "Quantification reached the time limit (%d sec).\n", pPars->TimeLimit );
+        else
+            printf( "Quantification exceeded the node limit (%d) in one of the cones.\n", pPars->nNodeMax );
+    }
+    else
+    {
+        // merge the results
+        pNew = Gia_ManStart( Gia_ManObjNum(p) );
+        pNew->pName = Abc_UtilStrsav( p->pName );
+        pNew->pSpec = Abc_UtilStrsav( p->pSpec );
+        Gia_ManHashAlloc( pNew );
+        Gia_ManFillValue( p );
+        Gia_ManConst0(p)->Value = 0;
+        Gia_ManForEachCi( p, pObj, i )
+            pObj->Value = Gia_ManAppendCi( pNew );
+        Gia_ManForEachAnd( p, pObj, i )
+            pObj->Value = Gia_ManHashAnd( pNew, Gia_ObjFanin0Copy(pObj), Gia_ObjFanin1Copy(pObj) );
+        Gia_ManForEachPo( p, pObj, i )
+        {
+            Gia_Man_t * q = pJobOfPo[i] >= 0 ? pJobs[pJobOfPo[i]].pCone : NULL;
+            Gia_Obj_t * pObjQ;
+            if ( q == NULL )
+            {
+                Gia_ManAppendCo( pNew, Gia_ObjFanin0Copy(pObj) );
+                continue;
+            }
+            assert( Gia_ManCiNum(q) == Gia_ManCiNum(p) );
+            Gia_ManConst0(q)->Value = 0;
+            Gia_ManForEachCi( q, pObjQ, k )
+                pObjQ->Value = Gia_ManCi(p, k)->Value;
+            Gia_ManForEachAnd( q, pObjQ, k )
+                pObjQ->Value = Gia_ManHashAnd( pNew, Gia_ObjFanin0Copy(pObjQ), Gia_ObjFanin1Copy(pObjQ) );
+            Gia_ManAppendCo( pNew, Gia_ObjFanin0Copy(Gia_ManPo(q, 0)) );
+        }
+        Gia_ManHashStop( pNew );
+        pNew = Gia_ManCleanup( pTemp = pNew );
+        Gia_ManStop( pTemp );
+        // restore the sharing between the cones swept separately
+        if ( pPars->fSweep && nJobs > 1 )
+        {
+            word Seed = ABC_CONST(0x9E3779B97F4A7C15);
+            pNew = Gia_QuaSweep( pTemp = pNew, pPars->nSimWords, pPars->nBTLimit, &Seed, TimeStop, &nMerged );
+            Gia_ManStop( pTemp );
+        }
+    }
+    for ( k = 0; k < nJobs; k++ )
+    {
+        Gia_ManStop( pJobs[k].pCone );
+        Vec_IntFree( pJobs[k].vVars );
+    }
+    ABC_FREE( pJobs );
+    ABC_FREE( pJobOfPo );
+    return pNew;
+}
+
 ////////////////////////////////////////////////////////////////////////
 ///                       END OF FILE                                ///
 ////////////////////////////////////////////////////////////////////////
@@ -20,6 +20,18 @@
 
 #include "gia.h"
 
+#ifdef ABC_USE_PTHREADS
+
+#ifdef _WIN32
+#include "../lib/pthread.h"
+#else
+#include <pthread.h>
+#include <sched.h>
+#include <unistd.h>
+#endif
+
+#endif
+
 ABC_NAMESPACE_IMPL_START
 
 
@@ -67,6 +79,24 @@ struct Gli_Man_t_
     int            nObjData;         // the size of array to store the logic network
     int *          pObjData;         // the internal nodes
     unsigned *     pSimInfoPrev;     // previous values of the CIs
+    int            fRandLocal;       // use the local random number generator
+    unsigned       RandZ;            // the state of the local generator
+    unsigned       RandW;            // the state of the local generator
+};
+
+#define GLI_PROC_MAX   32            // the max number of threads
+
+// one part of the patterns simulated by a thread
+typedef struct Gli_ThData_t_ Gli_ThData_t;
+struct Gli_ThData_t_
+{
+    Gli_Man_t *    p;                // the copy of the network
+    int            iPart;            // the part of the patterns
+    int            nParts;           // the number of parts
+    int            nPatterns;        // the total number of patterns
+    float          PiTransProb;      // input transition probability
+    abctime        clkStop;          // the time to stop simulating more patterns
+    int            nSimulated;       // the number of patterns simulated
 };
 
 
@@ -178,6 +208,59 @@ void Gli_ManStop( Gli_Man_t * p )
     ABC_FREE( p );
 }
 
+/**Function*************************************************************
+
+  Synopsis    [Duplicates logic network for simulation by another thread.]
+
+  Description [Fanins and fanouts are stored as relative offsets, so the 
+  object data can be copied as it is. Truth tables are shared.]
+               
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+Gli_Man_t * Gli_ManDup( Gli_Man_t * p )
+{
+    Gli_Man_t * pNew;
+    pNew = (Gli_Man_t *)ABC_ALLOC( int, (sizeof(Gli_Man_t) / 4) + p->nObjData );
+    memcpy( pNew, p, sizeof(int) * ((sizeof(Gli_Man_t) / 4) + p->nObjData) );
+    pNew->vCis = Vec_IntDup( p->vCis );
+    pNew->vCos = Vec_IntDup( p->vCos );
+    pNew->vCisChanged = Vec_IntAlloc( 1000 );
+    pNew->vAffected = Vec_IntAlloc( 1000 );
+    pNew->vFrontier = Vec_IntAlloc( 1000 );
+    pNew->pSimInfoPrev = NULL;
+    pNew->pObjData = (int *)(pNew + 1);
+    return pNew;
+}
+
+/**Function*************************************************************
+
+  Synopsis    [Generates random number.]
+
+  Description [Threads use their own generators.]
+               
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+static inline unsigned Gli_ManRandom( Gli_Man_t * p )
+{
+    if ( !p->fRandLocal )
+        return Gia_ManRandom( 0 );
+    p->RandZ = 36969 * (p->RandZ & 65535) + (p->RandZ >> 16);
+    p->RandW = 18000 * (p->RandW & 65535) + (p->RandW >> 16);
+    return (p->RandZ << 16) + p->RandW;
+}
+static inline void Gli_ManRandomStart( Gli_Man_t * p, int iPart )
+{
+    p->fRandLocal = 1;
+    p->RandZ = 3716960521u + 7919 * (unsigned)iPart;
+    p->RandW = 2174103536u + 104729 * (unsigned)iPart;
+}
+
 /**Function*************************************************************
 
   Synopsis    [Checks logic network.]
@@ -431,7 +514,7 @@ void Gli_ManSetPiRandom( Gli_Man_t * p, float PiTransProb )
     assert( 0.0 < PiTransProb && PiTransProb < 1.0 );
     Vec_IntClear( p->vCisChanged );
     Gli_ManForEachCi( p, pObj, i )
-        if ( Multi * (Gia_ManRandom(0) & 0xffff) < PiTransProb )
+        if ( Multi * (Gli_ManRandom(p) & 0xffff) < PiTransProb )
         {
             Vec_IntPush( p->vCisChanged, pObj->Handle );
             pObj->fPhase  ^= 1;
@@ -609,14 +692,14 @@ unsigned Gli_ManSimulateSeqNode( Gli_Man_t * p, Gli_Obj_t * pNode )
   SeeAlso     []
 
 ***********************************************************************/
-static inline unsigned Gli_ManUpdateRandomInput( unsigned uInfo, float PiTransProb )
+static inline unsigned Gli_ManUpdateRandomInput( Gli_Man_t * p, unsigned uInfo, float PiTransProb )
 {
     float Multi = 1.0 / (1 << 16);
     int i;
     if ( PiTransProb == 0.5 )
-        return Gia_ManRandom(0);
+        return Gli_ManRandom(p);
     for ( i = 0; i < 32; i++ )
-        if ( Multi * (Gia_ManRandom(0) & 0xffff) < PiTransProb )
+        if ( Multi * (Gli_ManRandom(p) & 0xffff) < PiTransProb )
             uInfo ^= (1 << i);
     return uInfo;
 }
@@ -638,7 +721,7 @@ void Gli_ManSimulateSeqPref( Gli_Man_t * p, int nPref )
     int i, f;
     // initialize simulation data
     Gli_ManForEachPi( p, pObj, i )
-        pObj->uSimInfo = Gli_ManUpdateRandomInput( pObj->uSimInfo, 0.5 );
+        pObj->uSimInfo = Gli_ManUpdateRandomInput( p, pObj->uSimInfo, 0.5 );
     Gli_ManForEachRo( p, pObj, i )
         pObj->uSimInfo = 0;
     for ( f = 0; f < nPref; f++ )
@@ -650,7 +733,7 @@ void Gli_ManSimulateSeqPref( Gli_Man_t * p, int nPref )
             pObj->uSimInfo = Gli_ObjFanin(pObj, 0)->uSimInfo;
         // initialize the next frame
         Gli_ManForEachPi( p, pObj, i )
-            pObj->uSimInfo = Gli_ManUpdateRandomInput( pObj->uSimInfo, 0.5 );
+            pObj->uSimInfo = Gli_ManUpdateRandomInput( p, pObj->uSimInfo, 0.5 );
         Gli_ManForEachRiRo( p, pObjRi, pObjRo, i )
             pObjRo->uSimInfo = pObjRi->uSimInfo;
     }
@@ -705,7 +788,7 @@ void Gli_ManSetPiRandomSeq( Gli_Man_t * p, float PiTransProb )
     // set changed PIs
     Vec_IntClear( p->vCisChanged );
     Gli_ManForEachPi( p, pObj, i )
-        if ( Multi * (Gia_ManRandom(0) & 0xffff) < PiTransProb )
+        if ( Multi * (Gli_ManRandom(p) & 0xffff) < PiTransProb )
         {
             Vec_IntPush( p->vCisChanged, pObj->Handle );
             pObj->fPhase  ^= 1;
@@ -728,54 +811,148 @@ void Gli_ManSetPiRandomSeq( Gli_Man_t * p, float PiTransProb )
 
 /**Function*************************************************************
 
-  Synopsis    [Computes glitching activity of each node.]
+  Synopsis    [Simulates one part of the patterns.]
 
-  Description []
+  Description [Combinational networks are simulated with nPatterns/nParts
+  random patterns. Sequential networks are simulated with every nParts-th 
+  of the 32 saved states. If the time to stop is given, the simulation 
+  continues with more patterns (or more rounds of states) until then.
+  Returns the number of patterns simulated.]
                
   SideEffects []
 
   SeeAlso     []
 
 ***********************************************************************/
-void Gli_ManSwitchesAndGlitches( Gli_Man_t * p, int nPatterns, float PiTransProb, int fVerbose )
+int Gli_ManSimulatePart( Gli_Man_t * p, int iPart, int nParts, int nPatterns, float PiTransProb, abctime clkStop )
 {
-    int i, k;
-    abctime clk = Abc_Clock();
-    Gia_ManRandom( 1 );
-    Gli_ManFinalize( p );
+    int i, k, r, nSimulated = 0;
     if ( p->nRegs == 0 )
     {
-        for ( i = 0; i < nPatterns; i++ )
+        int nPats = nPatterns / nParts + (int)(iPart < nPatterns % nParts);
+        for ( i = 0; i < nPats || (clkStop && ((i & 0xFF) || Abc_Clock() < clkStop)); i++ )
         {
             Gli_ManSetPiRandom( p, PiTransProb );
             Gli_ManSwitching( p );
             Gli_ManGlitching( p );
 //            Gli_ManVerify( p );
         }
+        nSimulated = i;
     }
     else 
     {
         int nIters = Abc_BitWordNum(nPatterns);
-        Gli_ManSimulateSeqPref( p, 16 );
-        for ( i = 0; i < 32; i++ )
+        for ( r = 0; r == 0 || (clkStop && Abc_Clock() < clkStop); r++ )
+        {
+            Gli_ManSimulateSeqPref( p, 16 );
+            for ( i = iPart; i < 32; i += nParts )
+            {
+                Gli_ManSetDataSaved( p, i );
+                for ( k = 0; k < nIters; k++ )
+                {
+                    Gli_ManSetPiRandomSeq( p, PiTransProb );
+                    Gli_ManSwitching( p );
+                    Gli_ManGlitching( p );
+//                    Gli_ManVerify( p );
+                }
+                nSimulated += nIters;
+            }
+        }
+    }
+    return nSimulated;
+}
+
+#ifdef ABC_USE_PTHREADS
+
+void * Gli_ManWorkerThread( void * pArg )
+{
+    Gli_ThData_t * pThData = (Gli_ThData_t *)pArg;
+    pThData->nSimulated = Gli_ManSimulatePart( pThData->p, pThData->iPart, pThData->nParts, pThData->nPatterns, pThData->PiTransProb, pThData->clkStop );
+    pthread_exit( NULL );
+    assert( 0 );
+    return NULL;
+}
+
+#endif // pthreads are used
+
+/**Function*************************************************************
+
+  Synopsis    [Computes glitching activity of each node.]
+
+  Description [With several threads, each thread simulates its own copy 
+  of the network using its own random number generator, and the counters 
+  of switches and glitches are summed up in the end.]
+               
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+void Gli_ManSwitchesAndGlitches2( Gli_Man_t * p, int nPatterns, float PiTransProb, int nProcs, int TimeLimit, int fVerbose )
+{
+    abctime clk = Abc_Clock();
+    abctime clkStop = TimeLimit ? (abctime)TimeLimit * CLOCKS_PER_SEC + Abc_Clock() : 0;
+    int nSimulated = 0;
+    Gia_ManRandom( 1 );
+    Gli_ManFinalize( p );
+#ifdef ABC_USE_PTHREADS
+    nProcs = Abc_MaxInt( 1, Abc_MinInt(nProcs, GLI_PROC_MAX) );
+    if ( p->nRegs == 0 )
+        nProcs = Abc_MinInt( nProcs, Abc_MaxInt(1, nPatterns) );
+#else
+    nProcs = 1;
+#endif
+    if ( nProcs == 1 )
+        nSimulated = Gli_ManSimulatePart( p, 0, 1, nPatterns, PiTransProb, clkStop );
+#ifdef ABC_USE_PTHREADS
+    else
+    {
+        pthread_t WorkerThread[GLI_PROC_MAX];
+        Gli_ThData_t ThData[GLI_PROC_MAX];
+        Gli_Man_t * pCopies[GLI_PROC_MAX];
+        Gli_Obj_t * pObj, * pObjCopy;
+        int i, k, status;
+        for ( k = 0; k < nProcs; k++ )
         {
-            Gli_ManSetDataSaved( p, i );
-            for ( k = 0; k < nIters; k++ )
+            pCopies[k] = k ? Gli_ManDup( p ) : p;
+            Gli_ManRandomStart( pCopies[k], k );
+            ThData[k].p           = pCopies[k];
+            ThData[k].iPart       = k;
+            ThData[k].nParts      = nProcs;
+            ThData[k].nPatterns   = nPatterns;
+            ThData[k].PiTransProb = PiTransProb;
+            ThData[k].clkStop     = clkStop;
+            status = pthread_create( WorkerThread + k, NULL, Gli_ManWorkerThread, (void *)(ThData + k) );  assert( status == 0 );
+        }
+        for ( k = 0; k < nProcs; k++ )
+            pthread_join( WorkerThread[k], NULL );
+        for ( k = 0; k < nProcs; k++ )
+            nSimulated += ThData[k].nSimulated;
+        // collect the counters
+        for ( k = 1; k < nProcs; k++ )
+        {
+            Gli_ManForEachObj( p, pObj, i )
             {
-                Gli_ManSetPiRandomSeq( p, PiTransProb );
-                Gli_ManSwitching( p );
-                Gli_ManGlitching( p );
-//                Gli_ManVerify( p );
+                pObjCopy = Gli_ManObj( pCopies[k], i );
+                pObj->nSwitches += pObjCopy->nSwitches;
+                pObj->nGlitches += pObjCopy->nGlitches;
             }
+            Gli_ManStop( pCopies[k] );
         }
+        p->fRandLocal = 0;
     }
+#endif
     if ( fVerbose )
     {
-        printf( "Simulated %d patterns.  Input transition probability %.2f.  ", nPatterns, PiTransProb );
-        ABC_PRMn( "Memory", 4*p->nObjData );
+        printf( "Simulated %d patterns using %d thread%s.  Input transition probability %.2f.  ", nSimulated, nProcs, nProcs > 1 ? "s" : "", PiTransProb );
+        ABC_PRMn( "Memory", 4*p->nObjData*nProcs );
         ABC_PRT( "Time", Abc_Clock() - clk );
     }
 }
+void Gli_ManSwitchesAndGlitches( Gli_Man_t * p, int nPatterns, float PiTransProb, int fVerbose )
+{
+    Gli_ManSwitchesAndGlitches2( p, nPatterns, PiTransProb, 1, 0, fVerbose );
+}
 
 ////////////////////////////////////////////////////////////////////////
 ///                       END OF FILE                                ///
@@ -2381,7 +2381,10 @@ Gia_Man_t * Gia_ManPerformMappingInt( Gia_Man_t * p, If_Par_t * pPars )
     // compute switching for the IF objects
     if ( pPars->fPower )
     {
-        if ( p->pManTime == NULL )
+        // reuse the switching computed by &power (the IF objects have the same IDs)
+        if ( p->pManTime == NULL && Gia_ManHasSwitching(p) && If_ManObjNum(pIfMan) == Gia_ManObjNum(p) )
+            pIfMan->vSwitching = Vec_IntDup( p->vSwitching );
+        else if ( p->pManTime == NULL )
             If_ManComputeSwitching( pIfMan );
         else
             Abc_Print( 0, "Switching activity computation for designs with boxes is disabled.\n" );
@@ -19,6 +19,19 @@
 ***********************************************************************/
 
 #include "gia.h"
+#include "misc/vec/vecHsh.h"
+
+#ifdef ABC_USE_PTHREADS
+
+#ifdef _WIN32
+#include "../lib/pthread.h"
+#else
+#include <pthread.h>
+#include <sched.h>
+#include <unistd.h>
+#endif
+
+#endif
 
 ABC_NAMESPACE_IMPL_START
  
@@ -64,6 +77,8 @@ static unsigned int s_256Primes[ISO_MASK+1] =
 ///                        DECLARATIONS                              ///
 ////////////////////////////////////////////////////////////////////////
 
+#define GIA_ISO_PROC_MAX  64        // the max number of threads
+
 typedef struct Gia_IsoMan_t_       Gia_IsoMan_t;
 struct Gia_IsoMan_t_ 
 {
@@ -986,24 +1001,21 @@ Gia_Man_t * Gia_ManIsoCanonicize( Gia_Man_t * p, int fVerbose )
 
 /**Function*************************************************************
 
-  Synopsis    []
+  Synopsis    [Computes the canonical AIGER string of the output cone.]
 
-  Description []
+  Description [The cone extracted by Gia_ManDupCones() is consumed. Only the
+  cone is touched, so the cones can be canonicized by concurrent threads.]
                
   SideEffects []
 
   SeeAlso     []
 
 ***********************************************************************/
-Vec_Str_t * Gia_ManIsoFindString( Gia_Man_t * p, int iPo, int fVerbose, Vec_Int_t ** pvPiPerm )
+Vec_Str_t * Gia_ManIsoFindStringPart( Gia_Man_t * pPart, int fVerbose, Vec_Int_t ** pvPiPerm )
 {
-    Gia_Man_t * pPart;
     Vec_Ptr_t * vEquiv;
     Vec_Int_t * vCis, * vAnds, * vCos;
     Vec_Str_t * vStr;
-    // duplicate
-    pPart = Gia_ManDupCones( p, &iPo, 1, 1 );
-//Gia_ManPrint( pPart );
     assert( Gia_ManPoNum(pPart) == 1 );
     if ( Gia_ManCiNum(pPart) == 0 ) // const AIG
     {
@@ -1034,7 +1046,307 @@ Vec_Str_t * Gia_ManIsoFindString( Gia_Man_t * p, int iPo, int fVerbose, Vec_Int_
     Gia_ManStop( pPart );
     return vStr;
 }
+Vec_Str_t * Gia_ManIsoFindString( Gia_Man_t * p, int iPo, int fVerbose, Vec_Int_t ** pvPiPerm )
+{
+    Gia_Man_t * pPart = Gia_ManDupCones( p, &iPo, 1, 1 );
+    return Gia_ManIsoFindStringPart( pPart, fVerbose, pvPiPerm );
+}
 
+/**Function*************************************************************
+
+  Synopsis    [Cache of canonical forms of the output cones.]
+
+  Description [Maps the AIGER string of the cone produced by Gia_ManDupCones()
+  into the canonical string of this cone. The cache is kept by the caller, so
+  the cones seen in the previous runs are not canonicized again.]
+               
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+struct Gia_IsoCache_t_
+{
+    Hsh_VecMan_t *   pHash;         // cone strings packed into integers
+    Vec_Ptr_t *      vCanons;       // canonical strings of the cones
+    Vec_Int_t *      vKey;          // temporary key
+    int              nLookups;      // the number of lookups
+    int              nHits;         // the number of hits
+};
+static inline void Gia_IsoStrToKey( Vec_Str_t * vStr, Vec_Int_t * vKey )
+{
+    int i, nInts = (Vec_StrSize(vStr) + 3) / 4;
+    Vec_IntFill( vKey, nInts + 1, 0 );
+    Vec_IntWriteEntry( vKey, 0, Vec_StrSize(vStr) );
+    for ( i = 0; i < Vec_StrSize(vStr); i++ )
+        Vec_IntArray(vKey)[1 + i/4] |= (int)((unsigned)(unsigned char)Vec_StrEntry(vStr, i) << (8 * (i & 3)));
+}
+Gia_IsoCache_t * Gia_IsoCacheStart()
+{
+    Gia_IsoCache_t * p = ABC_CALLOC( Gia_IsoCache_t, 1 );
+    p->pHash   = Hsh_VecManStart( 1000 );
+    p->vCanons = Vec_PtrAlloc( 1000 );
+    p->vKey    = Vec_IntAlloc( 1000 );
+    return p;
+}
+void Gia_IsoCacheStop( Gia_IsoCache_t * p )
+{
+    Vec_VecFree( (Vec_Vec_t *)p->vCanons );
+    Hsh_VecManStop( p->pHash );
+    Vec_IntFree( p->vKey );
+    ABC_FREE( p );
+}
+int Gia_IsoCacheSize( Gia_IsoCache_t * p )
+{
+    return Vec_PtrSize( p->vCanons );
+}
+void Gia_IsoCachePrint( Gia_IsoCache_t * p )
+{
+    printf( "Cone cache: Entries = %d. Lookups = %d. Hits = %d (%.2f %%).\n", 
+        Vec_PtrSize(p->vCanons), p->nLookups, p->nHits, 100.0 * p->nHits / Abc_MaxInt(1, p->nLookups) );
+}
+// returns the cache entry of the cone; a new entry has no canonical string yet
+int Gia_IsoCacheLookup( Gia_IsoCache_t * p, Gia_Man_t * pPart, int * pfNew )
+{
+    Vec_Str_t * vStr = Gia_AigerWriteIntoMemoryStr( pPart );
+    int Entry, nEntries = Vec_PtrSize(p->vCanons);
+    Gia_IsoStrToKey( vStr, p->vKey );
+    Vec_StrFree( vStr );
+    Entry = Hsh_VecManAdd( p->pHash, p->vKey );
+    *pfNew = (int)(Entry == nEntries);
+    if ( *pfNew )
+        Vec_PtrPush( p->vCanons, NULL );
+    else
+        p->nHits++;
+    p->nLookups++;
+    return Entry;
+}
+
+/**Function*************************************************************
+
+  Synopsis    [Reads/writes the cone cache.]
+
+  Description [The cache file contains the number of entries followed by
+  the entries. Each entry is the packed cone string and the canonical string,
+  both stored as the size followed by the data. Reading adds the entries
+  to the given cache.]
+               
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+int Gia_IsoCacheWrite( Gia_IsoCache_t * p, char * pFileName )
+{
+    Vec_Str_t * vCanon;
+    Vec_Int_t * vKey;
+    int i, nEntries = 0, nSize;
+    FILE * pFile = fopen( pFileName, "wb" );
+    if ( pFile == NULL )
+    {
+        printf( "Cannot open file \"%s\" for writing.\n", pFileName );
+        return 0;
+    }
+    Vec_PtrForEachEntry( Vec_Str_t *, p->vCanons, vCanon, i )
+        nEntries += (int)(vCanon != NULL);
+    fwrite( &nEntries, sizeof(int), 1, pFile );
+    Vec_PtrForEachEntry( Vec_Str_t *, p->vCanons, vCanon, i )
+    {
+        if ( vCanon == NULL )
+            continue;
+        vKey = Hsh_VecReadEntry( p->pHash, i );
+        nSize = Vec_IntSize(vKey);
+        fwrite( &nSize, sizeof(int), 1, pFile );
+        fwrite( Vec_IntArray(vKey), sizeof(int), (size_t)nSize, pFile );
+        nSize = Vec_StrSize(vCanon);
+        fwrite( &nSize, sizeof(int), 1, pFile );
+        fwrite( Vec_StrArray(vCanon), 1, (size_t)nSize, pFile );
+    }
+    fclose( pFile );
+    return 1;
+}
+int Gia_IsoCacheRead( Gia_IsoCache_t * p, char * pFileName )
+{
+    Vec_Str_t * vCanon;
+    int i, Entry, nEntries = 0, nSize, RetValue = 1;
+    FILE * pFile = fopen( pFileName, "rb" );
+    if ( pFile == NULL )
+        return 0;
+    if ( fread( &nEntries, sizeof(int), 1, pFile ) != 1 )
+        nEntries = 0;
+    for ( i = 0; i < nEntries; i++ )
+    {
+        if ( fread( &nSize, sizeof(int), 1, pFile ) != 1 || nSize < 1 )
+            break;
+        Vec_IntFill( p->vKey, nSize, 0 );
+        if ( fread( Vec_IntArray(p->vKey), sizeof(int), (size_t)nSize, pFile ) != (size_t)nSize )
+            break;
+        if ( fread( &nSize, sizeof(int), 1, pFile ) != 1 || nSize < 0 )
+            break;
+        vCanon = Vec_StrStart( nSize );
+        if ( fread( Vec_StrArray(vCanon), 1, (size_t)nSize, pFile ) != (size_t)nSize )
+        {
+            Vec_StrFree( vCanon );
+            break;
+        }
+        Entry = Hsh_VecManAdd( p->pHash, p->vKey );
+        if ( Entry == Vec_PtrSize(p->vCanons) )
+            Vec_PtrPush( p->vCanons, vCanon );
+        else if ( Vec_PtrEntry(p->vCanons, Entry) == NULL )
+            Vec_PtrWriteEntry( p->vCanons, Entry, vCanon );
+        else
+            Vec_StrFree( vCanon );
+    }
+    if ( i < nEntries )
+    {
+        printf( "The cone cache file \"%s\" is corrupted; read %d out of %d entries.\n", pFileName, i, nEntries );
+        RetValue = 0;
+    }
+    fclose( pFile );
+    return RetValue;
+}
+
+/**Function*************************************************************
+
+  Synopsis    [Computes canonical strings of several output cones.]
+
+  Description [The cones are extracted by the calling thread and canonicized
+  by the worker threads. When the cache is given, only the cones not seen
+  before are canonicized. The resulting strings are in the order of vPos.
+  If pPiPerms is given, it is the array indexed by POs used to return the
+  PI permutations; in this case the cache should not be used.]
+               
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+#ifdef ABC_USE_PTHREADS
+
+typedef struct Gia_IsoThData_t_ Gia_IsoThData_t;
+struct Gia_IsoThData_t_
+{
+    Gia_Man_t *      pPart;         // the cone to canonicize
+    Vec_Int_t **     pvPiPerm;      // the place for the PI permutation
+    Vec_Str_t *      vStr;          // the canonical string
+    int              iJob;          // the index of the cone
+    int              fStop;         // the thread should stop
+    volatile int     fWorking;      // the thread is working
+};
+void * Gia_ManIsoWorkerThread( void * pArg )
+{
+    Gia_IsoThData_t * pThData = (Gia_IsoThData_t *)pArg;
+    volatile int * pPlace = &pThData->fWorking;
+    while ( 1 )
+    {
+        while ( *pPlace == 0 )
+            sched_yield();
+        assert( pThData->fWorking );
+        if ( pThData->fStop )
+        {
+            pthread_exit( NULL );
+            assert( 0 );
+            return NULL;
+        }
+        pThData->vStr  = Gia_ManIsoFindStringPart( pThData->pPart, 0, pThData->pvPiPerm );
+        pThData->pPart = NULL;
+        pThData->fWorking = 0;
+    }
+    assert( 0 );
+    return NULL;
+}
+
+#endif // pthreads are used
+
+Vec_Ptr_t * Gia_ManIsoFindStrings( Gia_Man_t * p, Vec_Int_t * vPos, int nProcs, Gia_IsoCache_t * pCache, Vec_Int_t ** pPiPerms )
+{
+    Vec_Ptr_t * vStrs = Vec_PtrStart( Vec_IntSize(vPos) );
+    Vec_Int_t * vEntries = pCache ? Vec_IntStartFull( Vec_IntSize(vPos) ) : NULL;
+    Vec_Str_t * vStr;
+    Gia_Man_t * pPart;
+    int i, iPo, Entry, fNew;
+#ifdef ABC_USE_PTHREADS
+    Gia_IsoThData_t ThData[GIA_ISO_PROC_MAX];
+    pthread_t WorkerThread[GIA_ISO_PROC_MAX];
+    int k, status;
+#endif
+    assert( pCache == NULL || pPiPerms == NULL );
+    nProcs = Abc_MaxInt( 1, Abc_MinInt(nProcs, GIA_ISO_PROC_MAX) );
+#ifdef ABC_USE_PTHREADS
+    if ( nProcs > 1 )
+    for ( k = 0; k < nProcs; k++ )
+    {
+        memset( ThData + k, 0, sizeof(Gia_IsoThData_t) );
+        ThData[k].iJob = -1;
+        status = pthread_create( WorkerThread + k, NULL, Gia_ManIsoWorkerThread, (void *)(ThData + k) );  assert( status == 0 );
+    }
+#endif
+    Vec_IntForEachEntry( vPos, iPo, i )
+    {
+        pPart = Gia_ManDupCones( p, &iPo, 1, 1 );
+        if ( pCache )
+        {
+            Entry = Gia_IsoCacheLookup( pCache, pPart, &fNew );
+            Vec_IntWriteEntry( vEntries, i, Entry );
+            if ( !fNew ) // the canonical string is already known or is being computed
+            {
+                Gia_ManStop( pPart );
+                continue;
+            }
+        }
+#ifdef ABC_USE_PTHREADS
+        if ( nProcs > 1 )
+        {
+            // find an idle thread and collect its last result
+            for ( k = 0; ThData[k].fWorking; k = (k + 1) % nProcs )
+                if ( k == nProcs - 1 )
+                    sched_yield();
+            if ( ThData[k].iJob >= 0 )
+                Vec_PtrWriteEntry( vStrs, ThData[k].iJob, ThData[k].vStr );
+            ThData[k].pPart    = pPart;
+            ThData[k].pvPiPerm = pPiPerms ? pPiPerms + iPo : NULL;
+            ThData[k].vStr     = NULL;
+            ThData[k].iJob     = i;
+            ThData[k].fWorking = 1;
+            continue;
+        }
+#endif
+        vStr = Gia_ManIsoFindStringPart( pPart, 0, pPiPerms ? pPiPerms + iPo : NULL );
+        Vec_PtrWriteEntry( vStrs, i, vStr );
+    }
+#ifdef ABC_USE_PTHREADS
+    // collect the remaining results and stop the threads
+    if ( nProcs > 1 )
+    for ( k = 0; k < nProcs; k++ )
+    {
+        while ( ThData[k].fWorking )
+            sched_yield();
+        if ( ThData[k].iJob >= 0 )
+            Vec_PtrWriteEntry( vStrs, ThData[k].iJob, ThData[k].vStr );
+        ThData[k].fStop = 1;
+        ThData[k].fWorking = 1;
+    }
+    if ( nProcs > 1 )
+    for ( k = 0; k < nProcs; k++ )
+        pthread_join( WorkerThread[k], NULL );
+#endif
+    if ( pCache )
+    {
+        // record the new canonical strings and reuse the known ones
+        Vec_PtrForEachEntry( Vec_Str_t *, vStrs, vStr, i )
+            if ( vStr != NULL && Vec_PtrEntry(pCache->vCanons, Vec_IntEntry(vEntries, i)) == NULL )
+                Vec_PtrWriteEntry( pCache->vCanons, Vec_IntEntry(vEntries, i), Vec_StrDup(vStr) );
+        Vec_PtrForEachEntry( Vec_Str_t *, vStrs, vStr, i )
+            if ( vStr == NULL )
+            {
+                vStr = (Vec_Str_t *)Vec_PtrEntry( pCache->vCanons, Vec_IntEntry(vEntries, i) );
+                assert( vStr != NULL );
+                Vec_PtrWriteEntry( vStrs, i, Vec_StrDup(vStr) );
+            }
+        Vec_IntFree( vEntries );
+    }
+    return vStrs;
+}
 /**Function*************************************************************
 
   Synopsis    []
@@ -1063,24 +1375,28 @@ int Vec_IntCountNonTrivial( Vec_Ptr_t * vEquivs, int * pnUsed )
 
 /**Function*************************************************************
 
-  Synopsis    []
+  Synopsis    [Removes POs with isomorphic sequential COI.]
 
-  Description []
+  Description [The candidate classes are refined by comparing the canonical
+  forms of the output cones, which are computed by nProcs threads. If the
+  cone cache is given, the cones seen before are not canonicized again.]
                
   SideEffects []
 
   SeeAlso     []
 
 ***********************************************************************/
-Gia_Man_t * Gia_ManIsoReduce( Gia_Man_t * pInit, Vec_Ptr_t ** pvPosEquivs, Vec_Ptr_t ** pvPiPerms, int fEstimate, int fDualOut, int fVerbose, int fVeryVerbose )
+Gia_Man_t * Gia_ManIsoReducePar( Gia_Man_t * pInit, Vec_Ptr_t ** pvPosEquivs, Vec_Ptr_t ** pvPiPerms, int fEstimate, int fDualOut, int nProcs, Gia_IsoCache_t * pCache, int fVerbose, int fVeryVerbose )
 { 
     Gia_Man_t * p, * pPart;
     Vec_Ptr_t * vEquivs, * vEquivs2, * vStrings;
-    Vec_Int_t * vRemain, * vLevel, * vLevel2;
-    Vec_Str_t * vStr, * vStr2;
-    int i, k, s, sStart, iPo, Counter;
+    Vec_Int_t * vRemain, * vLevel, * vLevel2, * vJobs, * vKey;
+    Hsh_VecMan_t * pHash;
+    Vec_Str_t * vStr;
+    int i, k, s, sStart, iPo, iJob, Counter;
     int nClasses, nUsedPos;
     abctime clk = Abc_Clock();
+    assert( pCache == NULL || pvPiPerms == NULL );
     if ( pvPosEquivs )
         *pvPosEquivs = NULL;
     if ( pvPiPerms )
@@ -1120,8 +1436,24 @@ Gia_Man_t * Gia_ManIsoReduce( Gia_Man_t * pInit, Vec_Ptr_t ** pvPosEquivs, Vec_P
         return Gia_ManDup(pInit);
     }
 
+    // canonicize the cones of the outputs in the non-trivial classes
+    vJobs = Vec_IntAlloc( nUsedPos );
+    Vec_PtrForEachEntry( Vec_Int_t *, vEquivs, vLevel, i )
+        if ( Vec_IntSize(vLevel) > 1 )
+            Vec_IntAppend( vJobs, vLevel );
+    vStrings = Gia_ManIsoFindStrings( p, vJobs, nProcs, pCache, pvPiPerms ? (Vec_Int_t **)Vec_PtrArray(*pvPiPerms) : NULL );
+    Vec_IntFree( vJobs );
+    if ( fVerbose )
+    {
+        printf( "Computed canonical forms of %d cones using %d thread%s.  ", Vec_PtrSize(vStrings), nProcs, nProcs > 1 ? "s" : "" );
+        Abc_PrintTime( 1, "Time", Abc_Clock() - clk );
+        if ( pCache )
+            Gia_IsoCachePrint( pCache );
+    }
+
     // perform refinement of equivalence classes
-    Counter = 0;
+    Counter = iJob = 0;
+    vKey = Vec_IntAlloc( 1000 );
     vEquivs2 = Vec_PtrAlloc( 100 );
     Vec_PtrForEachEntry( Vec_Int_t *, vEquivs, vLevel, i )
     {
@@ -1143,38 +1475,35 @@ Gia_Man_t * Gia_ManIsoReduce( Gia_Man_t * pInit, Vec_Ptr_t ** pvPosEquivs, Vec_P
             Gia_ManStop( pPart );
         }
 
+        // group the outputs by hashing their canonical strings
         sStart = Vec_PtrSize( vEquivs2 ); 
-        vStrings = Vec_PtrAlloc( 100 );
+        pHash = Hsh_VecManStart( Vec_IntSize(vLevel) );
         Vec_IntForEachEntry( vLevel, iPo, k )
         {
             if ( ++Counter % 100 == 0 )
                 printf( "%6d finished...\r", Counter );
-            assert( pvPiPerms == NULL || Vec_PtrArray(*pvPiPerms)[iPo] == NULL );
-            vStr = Gia_ManIsoFindString( p, iPo, 0, pvPiPerms ? (Vec_Int_t **)Vec_PtrArray(*pvPiPerms) + iPo : NULL );
+            vStr = (Vec_Str_t *)Vec_PtrEntry( vStrings, iJob++ );
 
 //            printf( "Output %2d : ", iPo );
 //            Vec_IntPrint( Vec_PtrArray(*pvPiPerms)[iPo] );
 
             // check if this string already exists
-            Vec_PtrForEachEntry( Vec_Str_t *, vStrings, vStr2, s )
-                if ( Vec_StrCompareVec(vStr, vStr2) == 0 )
-                    break;
-            if ( s == Vec_PtrSize(vStrings) )
-            {
-                Vec_PtrPush( vStrings, vStr );
+            Gia_IsoStrToKey( vStr, vKey );
+            s = Hsh_VecManAdd( pHash, vKey );
+            if ( s == Vec_PtrSize(vEquivs2) - sStart )
                 Vec_PtrPush( vEquivs2, Vec_IntAlloc(8) );
-            }
-            else
-                Vec_StrFree( vStr );
             // add this entry to the corresponding level
             vLevel2 = (Vec_Int_t *)Vec_PtrEntry( vEquivs2, sStart + s );
             Vec_IntPush( vLevel2, iPo );
         }
 //        if ( Vec_PtrSize(vEquivs2) - sStart > 1 )
 //            printf( "Refined class %d into %d classes.\n", i, Vec_PtrSize(vEquivs2) - sStart );
-        Vec_VecFree( (Vec_Vec_t *)vStrings );
+        Hsh_VecManStop( pHash );
     }
     assert( Counter == Gia_ManPoNum(p) );
+    assert( iJob == Vec_PtrSize(vStrings) );
+    Vec_VecFree( (Vec_Vec_t *)vStrings );
+    Vec_IntFree( vKey );
     Vec_VecSortByFirstInt( (Vec_Vec_t *)vEquivs2, 0 );
     Vec_VecFree( (Vec_Vec_t *)vEquivs );
     vEquivs = vEquivs2;
@@ -1225,6 +1554,10 @@ Gia_Man_t * Gia_ManIsoReduce( Gia_Man_t * pInit, Vec_Ptr_t ** pvPosEquivs, Vec_P
 //    Gia_ManStopP( &pPart );
     return pPart;
 }
+Gia_Man_t * Gia_ManIsoReduce( Gia_Man_t * pInit, Vec_Ptr_t ** pvPosEquivs, Vec_Ptr_t ** pvPiPerms, int fEstimate, int fDualOut, int fVerbose, int fVeryVerbose )
+{
+    return Gia_ManIsoReducePar( pInit, pvPosEquivs, pvPiPerms, fEstimate, fDualOut, 1, NULL, fVerbose, fVeryVerbose );
+}
 
 
 /**Function*************************************************************
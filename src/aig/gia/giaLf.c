@@ -333,7 +333,7 @@ void Lf_ManAnalyzeCoDrivers( Gia_Man_t * p, int * pnDrivers, int * pnInverts )
 void Lf_ManComputeSwitching( Gia_Man_t * p, Vec_Flt_t * vSwitches )
 {
 //    abctime clk = Abc_Clock();
-    Vec_Flt_t * vSwitching = (Vec_Flt_t *)Gia_ManComputeSwitchProbs( p, 48, 16, 0 );
+    Vec_Flt_t * vSwitching = (Vec_Flt_t *)(Gia_ManHasSwitching(p) ? Vec_IntDup(p->vSwitching) : Gia_ManComputeSwitchProbs( p, 48, 16, 0 ));
     assert( Vec_FltCap(vSwitches) == 0 );
     *vSwitches = *vSwitching;
     ABC_FREE( vSwitching );
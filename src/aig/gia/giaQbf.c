@@ -25,6 +25,17 @@
 #include "sat/glucose/AbcGlucose.h"
 #include "misc/util/utilTruth.h"
 
+#ifdef ABC_USE_PTHREADS
+
+#ifdef _WIN32
+#include "../lib/pthread.h"
+#else
+#include <pthread.h>
+#include <unistd.h>
+#endif
+
+#endif
+
 ABC_NAMESPACE_IMPL_START
 
 
@@ -945,6 +956,283 @@ int Gia_QbfSolve( Gia_Man_t * pGia, int nPars, int nIterLimit, int nConfLimit, i
     return RetValue;
 }
 
+/**Function*************************************************************
+
+  Synopsis    [Performs QBF solving using a portfolio of threads.]
+
+  Description [Each thread runs the CEGAR loop of Gia_QbfSolve() with its
+  own copy of the miter and its own verification and synthesis solvers.
+  The threads differ in the initial candidate, the random seed of the 
+  synthesis solver, and the counter-example strategy: even threads use one
+  counter-example per candidate, odd threads additionally derive a second 
+  counter-example with the opposite decision polarity. Counter-examples 
+  are shared through a common pool, from which each thread imports the 
+  cofactors learned by the others. The first thread to prove or disprove 
+  the problem stops the remaining ones.]
+               
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+#ifdef ABC_USE_PTHREADS
+
+#define QBF_PROC_MAX 64
+
+typedef struct Qbf_Share_t_ Qbf_Share_t;
+struct Qbf_Share_t_
+{
+    int             nVars;          // functional variables
+    int             nIterLimit;     // iteration limit
+    int             nConfLimit;     // conflict limit
+    int             nTimeOut;       // timeout in seconds
+    int             fVerbose;       // verbose flag
+    abctime         clkStart;       // starting time
+    Vec_Int_t *     vPool;          // shared counter-examples (thread ID followed by values)
+    int             iWinner;        // the thread that solved the problem
+    int             RetValue;       // the result
+    int             nIters;         // the number of iterations of the winner
+    Vec_Int_t *     vResult;        // the parameters found
+};
+
+typedef struct Qbf_ThData_t_ Qbf_ThData_t;
+struct Qbf_ThData_t_
+{
+    Qbf_Man_t *     pMan;           // the solver of this thread
+    Qbf_Share_t *   pShare;         // the shared data
+    int             Id;             // thread ID
+    int             iPool;          // the next entry of the pool to import
+    int             nImported;      // the number of imported counter-examples
+    int             nIters;         // the number of iterations
+    int             RetValue;       // the result of this thread
+};
+
+static pthread_mutex_t s_QbfMutex = PTHREAD_MUTEX_INITIALIZER;
+static volatile int    s_QbfStop  = 0;
+static int Gia_QbfCallBackToStop( int RunId ) { return s_QbfStop; }
+
+static int Gia_QbfAddCofactorPar( Qbf_Man_t * p, Vec_Int_t * vValues )
+{
+    Gia_Man_t * pCof;
+    int status;
+    status = pthread_mutex_lock(&s_QbfMutex);  assert( status == 0 );
+    pCof   = Gia_QbfCofactor( p->pGia, p->nPars, vValues, p->vParMap );
+    status = Gia_QbfAddCofactor( p, pCof );
+    Gia_ManStop( pCof );
+    pthread_mutex_unlock(&s_QbfMutex);
+    return status;
+}
+static int Gia_QbfPublishAndImport( Qbf_ThData_t * pThData, Vec_Int_t * vCexes )
+{
+    Qbf_Share_t * pShare = pThData->pShare;
+    Qbf_Man_t * p = pThData->pMan;
+    Vec_Int_t * vImport = Vec_IntAlloc( 100 );
+    int i, k, status, nRecord = 1 + pShare->nVars;
+    // add the counter-examples to the pool and collect those of the other threads
+    status = pthread_mutex_lock(&s_QbfMutex);  assert( status == 0 );
+    for ( i = 0; i < Vec_IntSize(vCexes); i += pShare->nVars )
+    {
+        Vec_IntPush( pShare->vPool, pThData->Id );
+        for ( k = 0; k < pShare->nVars; k++ )
+            Vec_IntPush( pShare->vPool, Vec_IntEntry(vCexes, i+k) );
+    }
+    for ( ; pThData->iPool < Vec_IntSize(pShare->vPool); pThData->iPool += nRecord )
+        if ( Vec_IntEntry(pShare->vPool, pThData->iPool) != pThData->Id )
+            for ( k = 0; k < pShare->nVars; k++ )
+                Vec_IntPush( vImport, Vec_IntEntry(pShare->vPool, pThData->iPool+1+k) );
+    pthread_mutex_unlock(&s_QbfMutex);
+    // add the cofactors
+    Vec_IntAppend( vCexes, vImport );
+    pThData->nImported += Vec_IntSize(vImport) / Abc_MaxInt(1, pShare->nVars);
+    Vec_IntFree( vImport );
+    for ( i = 0; i < Vec_IntSize(vCexes); i += pShare->nVars )
+    {
+        Vec_IntClear( p->vValues );
+        for ( k = 0; k < pShare->nVars; k++ )
+            Vec_IntPush( p->vValues, Vec_IntEntry(vCexes, i+k) );
+        if ( !Gia_QbfAddCofactorPar( p, p->vValues ) )
+            return 0;
+    }
+    return 1;
+}
+void * Gia_QbfWorkerThread( void * pArg )
+{
+    Qbf_ThData_t * pThData = (Qbf_ThData_t *)pArg;
+    Qbf_Share_t * pShare = pThData->pShare;
+    Qbf_Man_t * p = pThData->pMan;
+    Vec_Int_t * vCand  = Vec_IntAlloc( p->nPars );
+    Vec_Int_t * vCexes = Vec_IntAlloc( 100 );
+    int i, k, status, RetValue = -1;
+    Vec_IntAppend( vCand, p->vValues );
+    for ( i = 0; !s_QbfStop; i++ )
+    {
+        // verify the candidate
+        Vec_IntClear( p->vValues );
+        Vec_IntAppend( p->vValues, vCand );
+        if ( !Gia_QbfVerify(p, p->vValues) )
+        {
+            if ( s_QbfStop )
+                break;
+            Vec_IntClear( p->vValues );
+            Vec_IntAppend( p->vValues, vCand );
+            RetValue = 0;
+            break;
+        }
+        Vec_IntClear( vCexes );
+        Vec_IntAppend( vCexes, p->vValues );
+        // derive another counter-example with the opposite polarity
+        if ( pThData->Id & 1 )
+        {
+            Vec_IntClear( p->vLits );
+            for ( k = 0; k < p->nVars; k++ )
+                Vec_IntPush( p->vLits, Abc_Var2Lit(p->iParVarBeg+p->nPars+k, Vec_IntEntry(vCexes, k)) );
+            sat_solver_set_literal_polarity( p->pSatVer, Vec_IntArray(p->vLits), Vec_IntSize(p->vLits) );
+            Vec_IntClear( p->vValues );
+            Vec_IntAppend( p->vValues, vCand );
+            if ( Gia_QbfVerify(p, p->vValues) && memcmp(Vec_IntArray(p->vValues), Vec_IntArray(vCexes), sizeof(int) * p->nVars) )
+                Vec_IntAppend( vCexes, p->vValues );
+        }
+        // share the counter-examples and add the cofactors
+        if ( !Gia_QbfPublishAndImport(pThData, vCexes) ) { RetValue = 1; break; }
+        // synthesize the next candidate
+        status = sat_solver_solve( p->pSatSyn, NULL, NULL, (ABC_INT64_T)pShare->nConfLimit, 0, 0, 0 );
+        if ( pThData->Id == 0 && pShare->fVerbose )
+        {
+            Vec_IntShrink( vCexes, p->nVars );
+            Gia_QbfPrint( p, vCexes, i );
+        }
+        if ( status == l_False ) { RetValue = 1; break; }
+        if ( status == l_Undef ) { RetValue = -1; break; }
+        Gia_QbfOnePattern( p, vCand );
+        if ( pShare->nIterLimit && i+1 == pShare->nIterLimit ) { RetValue = -1; break; }
+        if ( pShare->nTimeOut && (Abc_Clock() - pShare->clkStart)/CLOCKS_PER_SEC >= pShare->nTimeOut ) { RetValue = -1; break; }
+    }
+    pThData->nIters   = i;
+    pThData->RetValue = RetValue;
+    // report the result
+    if ( RetValue != -1 )
+    {
+        status = pthread_mutex_lock(&s_QbfMutex);  assert( status == 0 );
+        if ( pShare->iWinner == -1 )
+        {
+            pShare->iWinner  = pThData->Id;
+            pShare->RetValue = RetValue;
+            pShare->nIters   = i;
+            if ( RetValue == 0 )
+                Vec_IntAppend( pShare->vResult, p->vValues );
+        }
+        s_QbfStop = 1;
+        pthread_mutex_unlock(&s_QbfMutex);
+    }
+    Vec_IntFree( vCand );
+    Vec_IntFree( vCexes );
+    return NULL;
+}
+int Gia_QbfSolvePar( Gia_Man_t * pGia, int nPars, int nIterLimit, int nConfLimit, int nTimeOut, int nEncVars, int nProcs, int fVerbose )
+{
+    Qbf_ThData_t ThData[QBF_PROC_MAX];
+    pthread_t WorkerThread[QBF_PROC_MAX];
+    Qbf_Share_t Share, * pShare = &Share;
+    Gia_Man_t * pCopy;
+    int i, k, status, RetValue;
+    nProcs = Abc_MinInt( nProcs, QBF_PROC_MAX );
+    assert( Gia_ManRegNum(pGia) == 0 );
+    if ( fVerbose )
+        printf( "Solving QBF for \"%s\" with %d parameters, %d variables and %d AIG nodes using %d threads.\n", 
+            Gia_ManName(pGia), nPars, Gia_ManPiNum(pGia) - nPars, Gia_ManAndNum(pGia), nProcs );
+    memset( pShare, 0, sizeof(Qbf_Share_t) );
+    pShare->nVars      = Gia_ManPiNum(pGia) - nPars;
+    pShare->nIterLimit = nIterLimit;
+    pShare->nConfLimit = nConfLimit;
+    pShare->nTimeOut   = nTimeOut;
+    pShare->fVerbose   = fVerbose;
+    pShare->clkStart   = Abc_Clock();
+    pShare->vPool      = Vec_IntAlloc( 1000 );
+    pShare->vResult    = Vec_IntAlloc( nPars );
+    pShare->iWinner    = -1;
+    pShare->RetValue   = -1;
+    s_QbfStop = 0;
+    // create the solvers in this thread, because CNF generation is not reentrant
+    Gia_ManRandom( 1 );
+    for ( i = 0; i < nProcs; i++ )
+    {
+        pCopy = Gia_ManDup( pGia );
+        memset( ThData + i, 0, sizeof(Qbf_ThData_t) );
+        ThData[i].pMan   = Gia_QbfAlloc( pCopy, nPars, 0, fVerbose );
+        ThData[i].pShare = pShare;
+        ThData[i].Id     = i;
+        ThData[i].pMan->clkStart = pShare->clkStart;
+        // the first thread starts from the all-zero candidate, others from random ones
+        Vec_IntClear( ThData[i].pMan->vValues );
+        for ( k = 0; k < nPars; k++ )
+            Vec_IntPush( ThData[i].pMan->vValues, i ? Gia_ManRandom(0) & 1 : 0 );
+        ThData[i].pMan->pSatSyn->random_seed += 7919 * i;
+        sat_solver_set_runid( ThData[i].pMan->pSatSyn, i );
+        sat_solver_set_stop_func( ThData[i].pMan->pSatSyn, Gia_QbfCallBackToStop );
+        sat_solver_set_runid( ThData[i].pMan->pSatVer, i );
+        sat_solver_set_stop_func( ThData[i].pMan->pSatVer, Gia_QbfCallBackToStop );
+    }
+    for ( i = 1; i < nProcs; i++ )
+    {
+        status = pthread_create( WorkerThread + i, NULL, Gia_QbfWorkerThread, (void *)(ThData + i) );  
+        assert( status == 0 );
+    }
+    Gia_QbfWorkerThread( (void *)ThData );
+    for ( i = 1; i < nProcs; i++ )
+        pthread_join( WorkerThread[i], NULL );
+    RetValue = pShare->RetValue;
+    // report the results
+    if ( RetValue == 0 )
+    {
+        int nZeros = Vec_IntCountZero( pShare->vResult );
+        printf( "Parameters: " );
+        assert( Vec_IntSize(pShare->vResult) == nPars );
+        Vec_IntPrintBinary( pShare->vResult );
+        printf( "  Statistics: 0=%d 1=%d\n", nZeros, Vec_IntSize(pShare->vResult) - nZeros );
+        if ( nEncVars )
+        {
+            int nBits = Vec_IntSize(pShare->vResult)/(1 << nEncVars);
+            assert( Vec_IntSize(pShare->vResult) == (1 << nEncVars) * nBits );
+            Gia_Gen2CodePrint( nEncVars, nBits, pShare->vResult );
+        }
+    }
+    if ( fVerbose )
+    {
+        for ( i = 0; i < nProcs; i++ )
+            printf( "Thread %2d : Iters = %6d.  Imported = %6d.  Result = %2d.%s\n", i, ThData[i].nIters, 
+                ThData[i].nImported, ThData[i].RetValue, i == pShare->iWinner ? "  (winner)" : "" );
+    }
+    if ( RetValue == -1 && nTimeOut && (Abc_Clock() - pShare->clkStart)/CLOCKS_PER_SEC >= nTimeOut )
+        printf( "The problem timed out after %d sec.  ", nTimeOut );
+    else if ( RetValue == -1 && nConfLimit )
+        printf( "The problem aborted after %d conflicts.  ", nConfLimit );
+    else if ( RetValue == -1 && nIterLimit )
+        printf( "The problem aborted after %d iterations.  ", nIterLimit );
+    else if ( RetValue == 1 )
+        printf( "The problem is UNSAT after %d iterations.  ", pShare->nIters );
+    else 
+        printf( "The problem is SAT after %d iterations.  ", pShare->nIters );
+    Abc_PrintTime( 1, "Time", Abc_Clock() - pShare->clkStart );
+    for ( i = 0; i < nProcs; i++ )
+    {
+        pCopy = ThData[i].pMan->pGia;
+        Gia_QbfFree( ThData[i].pMan );
+        Gia_ManStop( pCopy );
+    }
+    Vec_IntFree( pShare->vPool );
+    Vec_IntFree( pShare->vResult );
+    return RetValue;
+}
+
+#else
+
+int Gia_QbfSolvePar( Gia_Man_t * pGia, int nPars, int nIterLimit, int nConfLimit, int nTimeOut, int nEncVars, int nProcs, int fVerbose )
+{
+    return Gia_QbfSolve( pGia, nPars, nIterLimit, nConfLimit, nTimeOut, nEncVars, 0, fVerbose );
+}
+
+#endif // pthreads are used
+
 ////////////////////////////////////////////////////////////////////////
 ///                       END OF FILE                                ///
 ////////////////////////////////////////////////////////////////////////
@@ -25,6 +25,17 @@
 #include "map/scl/sclCon.h"
 #include "misc/vec/vecHsh.h"
 
+#ifdef ABC_USE_PTHREADS
+
+#ifdef _WIN32
+#include "../lib/pthread.h"
+#else
+#include <pthread.h>
+#include <unistd.h>
+#endif
+
+#endif
+
 ABC_NAMESPACE_IMPL_START
 
 
@@ -49,6 +60,9 @@ struct Sbl_Man_t_
     int            nSmallWins;   // the number of small windows
     int            nLargeWins;   // the number of large windows
     int            nIterOuts;    // the number of iters exceeded
+    int            nConfWin;     // conflicts in the last window
+    int            nItersWin;    // iterations in the last window
+    abctime        timeLimit;    // runtime limit for the last window
     // parameters
     int            LutSize;      // LUT size
     int            nBTLimit;     // conflicts
@@ -957,12 +971,9 @@ int Sbl_ManWindow2( Sbl_Man_t * p, int iPivot )
     return Count;
 }
 
-int Sbl_ManTestSat( Sbl_Man_t * p, int iPivot )
+int Sbl_ManPrepare( Sbl_Man_t * p, int iPivot )
 {
-    int fKeepTrying = 1;
-    abctime clk = Abc_Clock(), clk2;
-    int i, status, Root, Count, StartSol, nConfTotal = 0, nIters = 0;
-    int nEntries = Hsh_VecSize( p->pHash );
+    int Count;
     p->nTried++;
 
     Sbl_ManClean( p );
@@ -976,14 +987,23 @@ int Sbl_ManTestSat( Sbl_Man_t * p, int iPivot )
         p->nSmallWins++;
         return 0;
     }
-    Hsh_VecManAdd( p->pHash, p->vAnds );
-    if ( nEntries == Hsh_VecSize(p->pHash) )
+    return 1;
+}
+int Sbl_ManWindowIsNew( Sbl_Man_t * p, Hsh_VecMan_t * pHash, int iPivot )
+{
+    int nEntries = Hsh_VecSize( pHash );
+    Hsh_VecManAdd( pHash, p->vAnds );
+    if ( nEntries == Hsh_VecSize(pHash) )
     {
         if ( p->fVeryVerbose )
         printf( "Obj %d: This window was already tried.\n", iPivot );
         p->nHashWins++;
         return 0;
     }
+    return 1;
+}
+int Sbl_ManWindowIsValid( Sbl_Man_t * p, int iPivot )
+{
     if ( p->fVeryVerbose )
     printf( "\nObj = %6d : Leaf = %2d.  AND = %2d.  Root = %2d.    LUT = %2d.\n", 
         iPivot, Vec_IntSize(p->vLeaves), Vec_IntSize(p->vAnds), Vec_IntSize(p->vRoots), Vec_IntSize(p->vNodes) ); 
@@ -1001,9 +1021,14 @@ int Sbl_ManTestSat( Sbl_Man_t * p, int iPivot )
         printf( "Skipping.\n" );
         return 0;
     }
+    return 1;
+}
+void Sbl_ManSolve( Sbl_Man_t * p, int iPivot )
+{
+    int fKeepTrying = 1;
+    abctime clk = Abc_Clock(), clk2;
+    int i, status, Root, StartSol, nConfTotal = 0, nIters = 0;
 
-    // derive cuts
-    Sbl_ManComputeCuts( p );
     // derive SAT instance
     Sbl_ManCreateCnf( p );
 
@@ -1038,6 +1063,8 @@ int Sbl_ManTestSat( Sbl_Man_t * p, int iPivot )
         // solve the problem
         clk2 = Abc_Clock();
         nConfBef = (int)p->pSat->stats.conflicts;
+        if ( p->timeLimit )
+            sat_solver_set_runtime_limit( p->pSat, p->timeLimit );
         status = sat_solver_solve( p->pSat, Vec_IntArray(p->vAssump), Vec_IntLimit(p->vAssump), p->nBTLimit, 0, 0, 0 );
         p->timeSat += Abc_Clock() - clk2;
         nConfAft = (int)p->pSat->stats.conflicts;
@@ -1139,13 +1166,20 @@ int Sbl_ManTestSat( Sbl_Man_t * p, int iPivot )
             break;
         }
     }
-
+    p->nConfWin  = nConfTotal;
+    p->nItersWin = nIters;
+}
+int Sbl_ManCommit( Sbl_Man_t * p, int iPivot )
+{
     // update solution
     if ( Vec_IntSize(p->vSolBest) > 0 && Vec_IntSize(p->vSolBest) < Vec_IntSize(p->vSolInit) )
     {
-        int nDelayCur, nEdgesCur = 0;
+        int nDelayCur = 0, nEdgesCur = 0;
         Sbl_ManUpdateMapping( p );
-        if ( p->pGia->vEdge1 )
+        // the timing is only needed for delay optimization and printout
+        if ( !p->fVerbose && !p->fDelay )
+            {}
+        else if ( p->pGia->vEdge1 )
         {
             nDelayCur = Gia_ManEvalEdgeDelay( p->pGia );
             nEdgesCur = Gia_ManEvalEdgeCount( p->pGia );
@@ -1154,22 +1188,40 @@ int Sbl_ManTestSat( Sbl_Man_t * p, int iPivot )
             nDelayCur = Sbl_ManCreateTiming( p, p->DelayMax );
         if ( p->fVerbose )
         printf( "Object %5d : Saved %2d nodes  (Conf =%8d)  Iter =%3d  Delay = %d  Edges = %4d\n", 
-            iPivot, Vec_IntSize(p->vSolInit)-Vec_IntSize(p->vSolBest), nConfTotal, nIters, nDelayCur, nEdgesCur );
+            iPivot, Vec_IntSize(p->vSolInit)-Vec_IntSize(p->vSolBest), p->nConfWin, p->nItersWin, nDelayCur, nEdgesCur );
         p->timeTotal += Abc_Clock() - p->timeStart;
         p->nImproved++;
         return 2;
     }
     else
     {
-//        printf( "Object %5d : Saved %2d nodes  (Conf =%8d)  Iter =%3d\n", iPivot, 0, nConfTotal, nIters );
+//        printf( "Object %5d : Saved %2d nodes  (Conf =%8d)  Iter =%3d\n", iPivot, 0, p->nConfWin, p->nItersWin );
     }
     p->timeTotal += Abc_Clock() - p->timeStart;
     return 1;
 }
+int Sbl_ManTestSat( Sbl_Man_t * p, int iPivot )
+{
+    if ( !Sbl_ManPrepare(p, iPivot) )
+        return 0;
+    if ( !Sbl_ManWindowIsNew(p, p->pHash, iPivot) )
+        return 0;
+    if ( !Sbl_ManWindowIsValid(p, iPivot) )
+        return 0;
+    // derive cuts
+    Sbl_ManComputeCuts( p );
+    // solve the problem
+    Sbl_ManSolve( p, iPivot );
+    // update solution
+    return Sbl_ManCommit( p, iPivot );
+}
+
 void Sbl_ManPrintRuntime( Sbl_Man_t * p )
 {
     printf( "Runtime breakdown:\n" );
     p->timeOther = p->timeTotal - p->timeWin - p->timeCut - p->timeSat - p->timeTime;
+    if ( p->timeOther < 0 ) // phases of several threads may add up to more than the total
+        p->timeOther = 0;
     ABC_PRTP( "Win   ", p->timeWin  ,   p->timeTotal );
     ABC_PRTP( "Cut   ", p->timeCut  ,   p->timeTotal );
     ABC_PRTP( "Sat   ", p->timeSat,     p->timeTotal );
@@ -1216,6 +1268,247 @@ void Gia_ManLutSat( Gia_Man_t * pGia, int LutSize, int nNumber, int nImproves, i
     Vec_IntFreeP( &pGia->vPacking );
 }
 
+/**Function*************************************************************
+
+  Synopsis    [Performs SAT-based remapping with several threads.]
+
+  Description [Windows are processed in batches. The windows of one batch
+  are selected in the order of their pivots, so that no window contains 
+  the AND-nodes or the leaves of another window of the same batch, which
+  keeps the windows independent while their mappings are updated. The 
+  windows rejected because of overlap are retried in the next batch. 
+  The SAT problems are solved by the threads, each window using its own 
+  solver, while the resulting mappings are committed by the main thread
+  in the order of the pivots, so the result does not depend on the number
+  of threads (unless the time budget is exceeded). The passes over the 
+  LUTs are repeated nRounds times, each limited to TimeRound seconds.]
+               
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+#ifdef ABC_USE_PTHREADS
+
+#define SBL_PROC_MAX  16
+#define SBL_SLOT_NUM  16
+
+typedef struct Sbl_ThData_t_ Sbl_ThData_t;
+struct Sbl_ThData_t_
+{
+    Sbl_Man_t **  pSlots;       // the window managers
+    int *         pPivots;      // the pivots of the windows
+    int           iFirst;       // the first slot of this thread
+    int           nSlots;       // the number of used slots
+    int           nStep;        // the distance between the slots of this thread
+    abctime       timeLimit;    // the end of the round
+};
+void * Sbl_ManWorkerThread( void * pArg )
+{
+    Sbl_ThData_t * pThData = (Sbl_ThData_t *)pArg;
+    int i;
+    for ( i = pThData->iFirst; i < pThData->nSlots; i += pThData->nStep )
+    {
+        Sbl_Man_t * p = pThData->pSlots[i];
+        Vec_IntClear( p->vSolBest );
+        if ( pThData->timeLimit && Abc_Clock() > pThData->timeLimit )
+            continue;
+        p->timeLimit = pThData->timeLimit;
+        Sbl_ManSolve( p, pThData->pPivots[i] );
+    }
+    return NULL;
+}
+// returns 1 if the window overlaps with the windows already selected
+static int Sbl_ManWindowOverlaps( Sbl_Man_t * p, Vec_Int_t * vMarks )
+{
+    int i, iObj;
+    Vec_IntForEachEntry( p->vAnds, iObj, i )
+        if ( Vec_IntEntry(vMarks, iObj) )
+            return 1;
+    Vec_IntForEachEntry( p->vLeaves, iObj, i )
+        if ( Vec_IntEntry(vMarks, iObj) == 2 )
+            return 1;
+    return 0;
+}
+static void Sbl_ManWindowMark( Sbl_Man_t * p, Vec_Int_t * vMarks, int fClean )
+{
+    int i, iObj;
+    Vec_IntForEachEntry( p->vLeaves, iObj, i )
+        Vec_IntWriteEntry( vMarks, iObj, fClean ? 0 : Abc_MaxInt(Vec_IntEntry(vMarks, iObj), 1) );
+    Vec_IntForEachEntry( p->vAnds, iObj, i )
+        Vec_IntWriteEntry( vMarks, iObj, fClean ? 0 : 2 );
+}
+void Gia_ManLutSatPar( Gia_Man_t * pGia, int LutSize, int nNumber, int nImproves, int nBTLimit, int nProcs, int nRounds, int TimeRound, int fReverse, int fVerbose )
+{
+    Sbl_ThData_t ThData[SBL_PROC_MAX];
+    pthread_t WorkerThread[SBL_PROC_MAX];
+    Sbl_Man_t * pSlots[SBL_SLOT_NUM], * q;
+    int pPivots[SBL_SLOT_NUM];
+    Sbl_Man_t * p = Sbl_ManAlloc( pGia, nNumber );
+    Vec_Int_t * vLuts    = Vec_IntAlloc( Gia_ManObjNum(pGia) );
+    Vec_Int_t * vPending = Vec_IntAlloc( 100 );
+    Vec_Int_t * vCands   = Vec_IntAlloc( 100 );
+    Vec_Int_t * vMarks   = Vec_IntStart( Gia_ManObjNum(pGia) );
+    int i, k, r, iLut, iNext, nUsed, status, nChunk, nSlots = SBL_SLOT_NUM, nBatches = 0, nOverlaps = 0, nImproveCount = 0, nImproveStart, fStop = 0;
+    abctime clkRound, timeLimit, clkTotal = Abc_Clock();
+    if ( nProcs > SBL_PROC_MAX )
+    {
+        printf( "Warning: The number of threads is reduced from %d to %d.\n", nProcs, SBL_PROC_MAX );
+        nProcs = SBL_PROC_MAX;
+    }
+    p->LutSize  = LutSize;
+    p->nBTLimit = nBTLimit;
+    p->fVerbose = fVerbose;
+    for ( i = 0; i < nSlots; i++ )
+    {
+        pSlots[i] = Sbl_ManAlloc( pGia, nNumber );
+        pSlots[i]->LutSize  = LutSize;
+        pSlots[i]->nBTLimit = nBTLimit;
+        pSlots[i]->fVerbose = fVerbose;
+        pSlots[i]->fReverse = fReverse;
+    }
+    if ( fVerbose )
+    printf( "Parameters: WinSize = %d AIG nodes.  Conf = %d.  Threads = %d.  Rounds = %d.  TimeRound = %d sec.\n", 
+        p->nVars, p->nBTLimit, nProcs, nRounds, TimeRound );
+    Gia_ManComputeOneWinStart( pGia, nNumber, fReverse );
+    for ( r = 0; r < nRounds && !fStop; r++ )
+    {
+        clkRound  = Abc_Clock();
+        timeLimit = TimeRound ? clkRound + (abctime)TimeRound * CLOCKS_PER_SEC : 0;
+        nImproveStart = nImproveCount;
+        // the mapping has changed, so the windows tried in the previous round may improve now
+        if ( r > 0 )
+        {
+            Hsh_VecManStop( p->pHash );
+            p->pHash = Hsh_VecManStart( 1000 );
+        }
+        // interleave the LUTs taken from nSlots parts of the network 
+        // to make the consecutive windows less likely to overlap
+        Vec_IntClear( vCands );
+        Gia_ManForEachLut2( pGia, iLut )
+            Vec_IntPush( vCands, iLut );
+        nChunk = (Vec_IntSize(vCands) + nSlots - 1) / nSlots;
+        Vec_IntClear( vLuts );
+        for ( k = 0; k < nChunk; k++ )
+            for ( i = k; i < Vec_IntSize(vCands); i += nChunk )
+                Vec_IntPush( vLuts, Vec_IntEntry(vCands, i) );
+        Vec_IntClear( vPending );
+        iNext = 0;
+        while ( iNext < Vec_IntSize(vLuts) || Vec_IntSize(vPending) > 0 )
+        {
+            if ( timeLimit && Abc_Clock() > timeLimit )
+                break;
+            // the windows overlapping in the last batch go first
+            Vec_IntClear( vCands );
+            Vec_IntAppend( vCands, vPending );
+            Vec_IntClear( vPending );
+            // select the windows while limiting the effort spent on overlaps
+            nUsed = 0;
+            for ( k = 0; nUsed < nSlots && k < 4 * nSlots && (k < Vec_IntSize(vCands) || iNext < Vec_IntSize(vLuts)); k++ )
+            {
+                iLut = k < Vec_IntSize(vCands) ? Vec_IntEntry(vCands, k) : Vec_IntEntry(vLuts, iNext++);
+                if ( !Gia_ObjIsLut2(pGia, iLut) )
+                    continue;
+                q = pSlots[nUsed];
+                if ( !Sbl_ManPrepare(q, iLut) )
+                    continue;
+                if ( Sbl_ManWindowOverlaps(q, vMarks) )
+                {
+                    Vec_IntPush( vPending, iLut );
+                    q->nTried--;
+                    nOverlaps++;
+                    continue;
+                }
+                if ( !Sbl_ManWindowIsNew(q, p->pHash, iLut) || !Sbl_ManWindowIsValid(q, iLut) )
+                    continue;
+                Sbl_ManComputeCuts( q );
+                Sbl_ManWindowMark( q, vMarks, 0 );
+                pPivots[nUsed++] = iLut;
+            }
+            // keep the candidates that were not considered
+            for ( ; k < Vec_IntSize(vCands); k++ )
+                Vec_IntPush( vPending, Vec_IntEntry(vCands, k) );
+            if ( nUsed == 0 )
+                continue;
+            nBatches++;
+            // solve the windows
+            for ( i = 0; i < nProcs; i++ )
+            {
+                ThData[i].pSlots    = pSlots;
+                ThData[i].pPivots   = pPivots;
+                ThData[i].iFirst    = i;
+                ThData[i].nSlots    = nUsed;
+                ThData[i].nStep     = nProcs;
+                ThData[i].timeLimit = timeLimit;
+            }
+            for ( i = 1; i < nProcs; i++ )
+            {
+                status = pthread_create( WorkerThread + i, NULL, Sbl_ManWorkerThread, (void *)(ThData + i) );  
+                assert( status == 0 );
+            }
+            Sbl_ManWorkerThread( (void *)ThData );
+            for ( i = 1; i < nProcs; i++ )
+                pthread_join( WorkerThread[i], NULL );
+            // commit the improvements in the order of the pivots
+            for ( i = 0; i < nUsed; i++ )
+            {
+                Sbl_ManWindowMark( pSlots[i], vMarks, 1 );
+                if ( fStop )
+                    continue;
+                if ( Sbl_ManCommit(pSlots[i], pPivots[i]) == 2 && ++nImproveCount == nImproves )
+                    fStop = 1;
+            }
+            if ( fStop )
+                break;
+        }
+        if ( fVerbose )
+        {
+            int nLuts = 0;
+            Gia_ManForEachLut2( pGia, iLut )
+                nLuts++;
+            printf( "Round %2d : LUTs = %8d.  Improved = %6d.  ", r, nLuts, nImproveCount - nImproveStart );
+            Abc_PrintTime( 1, "Time", Abc_Clock() - clkRound );
+        }
+    }
+    Gia_ManComputeOneWin( pGia, -1, NULL, NULL, NULL, NULL );
+    // collect the statistics
+    for ( i = 0; i < nSlots; i++ )
+    {
+        q = pSlots[i];
+        p->nTried     += q->nTried;      p->nImproved  += q->nImproved;
+        p->nHashWins  += q->nHashWins;   p->nSmallWins += q->nSmallWins;
+        p->nLargeWins += q->nLargeWins;  p->nIterOuts  += q->nIterOuts;
+        p->nRuns      += q->nRuns;
+        p->timeWin    += q->timeWin;     p->timeCut    += q->timeCut;
+        p->timeSat    += q->timeSat;     p->timeSatSat += q->timeSatSat;
+        p->timeSatUns += q->timeSatUns;  p->timeSatUnd += q->timeSatUnd;
+        p->timeTime   += q->timeTime;
+        Sbl_ManStop( q );
+    }
+    // the slots overlap in time, so the total is the wall time of the driver
+    p->timeTotal = Abc_Clock() - clkTotal;
+    if ( fVerbose )
+    printf( "Tried = %d. Used = %d. HashWin = %d. SmallWin = %d. LargeWin = %d. IterOut = %d.  SAT runs = %d.  Batches = %d.  Overlaps = %d.\n", 
+        p->nTried, p->nImproved, p->nHashWins, p->nSmallWins, p->nLargeWins, p->nIterOuts, p->nRuns, nBatches, nOverlaps );
+    if ( fVerbose )
+    Sbl_ManPrintRuntime( p );
+    Sbl_ManStop( p );
+    Vec_IntFree( vLuts );
+    Vec_IntFree( vPending );
+    Vec_IntFree( vCands );
+    Vec_IntFree( vMarks );
+    Vec_IntFreeP( &pGia->vPacking );
+}
+
+#else
+
+void Gia_ManLutSatPar( Gia_Man_t * pGia, int LutSize, int nNumber, int nImproves, int nBTLimit, int nProcs, int nRounds, int TimeRound, int fReverse, int fVerbose )
+{
+    Gia_ManLutSat( pGia, LutSize, nNumber, nImproves, nBTLimit, 0, 0, 0, fReverse, fVerbose, 0 );
+}
+
+#endif // pthreads are used
+
 ////////////////////////////////////////////////////////////////////////
 ///                       END OF FILE                                ///
 ////////////////////////////////////////////////////////////////////////
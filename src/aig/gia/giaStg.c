@@ -20,6 +20,20 @@
 
 #include "gia.h"
 #include "misc/extra/extra.h"
+#include "misc/vec/vecMem.h"
+#include "misc/vec/vecHsh.h"
+#include "misc/util/utilTruth.h"
+
+#ifdef ABC_USE_PTHREADS
+
+#ifdef _WIN32
+#include "../lib/pthread.h"
+#else
+#include <pthread.h>
+#include <unistd.h>
+#endif
+
+#endif
 
 ABC_NAMESPACE_IMPL_START
 
@@ -28,6 +42,64 @@ ABC_NAMESPACE_IMPL_START
 ///                        DECLARATIONS                              ///
 ////////////////////////////////////////////////////////////////////////
 
+#define GIA_STG_PROC_MAX  16     // the largest number of threads
+#define GIA_STG_PI_MAX    12     // the largest number of inputs for extraction
+#define GIA_STG_PO_MAX    30     // the largest number of outputs for extraction
+#define GIA_STG_CHUNK   1024     // the number of keys in one minimization job
+
+// state transition graph in the compressed-row form
+struct Gia_Stg_t_
+{
+    int           nIns;         // the number of inputs
+    int           nOuts;        // the number of outputs
+    int           nStates;      // the number of states (state 0 is initial)
+    Vec_Int_t *   vStart;       // the first transition of each state (nStates + 1 entries)
+    Vec_Int_t *   vMints;       // the input minterm of each transition
+    Vec_Int_t *   vNexts;       // the next state of each transition
+    Vec_Int_t *   vOuts;        // the output minterm of each transition
+};
+
+// explicit state extraction manager
+typedef struct Gia_StgExt_t_ Gia_StgExt_t;
+struct Gia_StgExt_t_
+{
+    Gia_Man_t *   pGia;         // the sequential AIG
+    int           nMints;       // the number of input minterms
+    int           nBatch;       // the number of states simulated together
+    int           nWords;       // the number of simulation words
+    int           nRegWords;    // the number of words in the state code
+    word *        pPis;         // the input patterns (PI minterms repeated for each state)
+    word *        pMasks;       // the patterns belonging to each state of the batch
+    Vec_Mem_t *   vStates;      // the state codes
+    int           iFirst;       // the first state of the current job
+    int           nJob;         // the number of states in the current job
+    word *        pNexts;       // the next state codes of the current job
+    int *         pOuts;        // the output minterms of the current job
+};
+
+// state minimization manager
+typedef struct Gia_StgMin_t_ Gia_StgMin_t;
+struct Gia_StgMin_t_
+{
+    Gia_Stg_t *   pStg;         // the state transition graph
+    int *         pClass;       // the class of each state
+    int           fFirst;       // the first round uses the outputs
+    Vec_Int_t *   vDirty;       // the states whose keys are recomputed
+    Vec_Int_t *   vOffs;        // the offsets of their keys
+    Vec_Int_t *   vKeys;        // the keys of these states
+};
+
+// the data of one worker thread
+typedef struct Gia_StgThData_t_ Gia_StgThData_t;
+struct Gia_StgThData_t_
+{
+    void *        pMan;         // the shared manager
+    int           iFirst;       // the first item of this thread
+    int           nItems;       // the number of items
+    int           nStep;        // the distance between the items of this thread
+    word *        pSims;        // the simulation info of this thread
+};
+
 ////////////////////////////////////////////////////////////////////////
 ///                     FUNCTION DEFINITIONS                         ///
 ////////////////////////////////////////////////////////////////////////
@@ -519,6 +591,661 @@ Gia_Man_t * Gia_ManStgRead( char * pFileName, int kHot, int fVerbose )
     return p;
 }
 
+/**Function*************************************************************
+
+  Synopsis    [Allocates and frees the state transition graph.]
+
+  Description []
+               
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+Gia_Stg_t * Gia_StgAlloc( int nIns, int nOuts )
+{
+    Gia_Stg_t * p = ABC_CALLOC( Gia_Stg_t, 1 );
+    p->nIns   = nIns;
+    p->nOuts  = nOuts;
+    p->vStart = Vec_IntAlloc( 1000 );
+    p->vMints = Vec_IntAlloc( 1000 );
+    p->vNexts = Vec_IntAlloc( 1000 );
+    p->vOuts  = Vec_IntAlloc( 1000 );
+    Vec_IntPush( p->vStart, 0 );
+    return p;
+}
+void Gia_StgFree( Gia_Stg_t * p )
+{
+    Vec_IntFree( p->vStart );
+    Vec_IntFree( p->vMints );
+    Vec_IntFree( p->vNexts );
+    Vec_IntFree( p->vOuts );
+    ABC_FREE( p );
+}
+int Gia_StgStateNum( Gia_Stg_t * p )
+{
+    return Vec_IntSize(p->vStart) - 1;
+}
+int Gia_StgTransNum( Gia_Stg_t * p )
+{
+    return Vec_IntSize(p->vMints);
+}
+
+/**Function*************************************************************
+
+  Synopsis    [Converts between the STG and the list of KISS lines.]
+
+  Description [Each line has four entries: input minterm, current state,
+  next state, output minterm. The transitions of the resulting STG are
+  sorted by the current state and then by the input minterm.]
+               
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+Gia_Stg_t * Gia_StgFromLines( Vec_Int_t * vLines, int nIns, int nOuts, int nStates )
+{
+    Gia_Stg_t * p = Gia_StgAlloc( nIns, nOuts );
+    int nLines = Vec_IntSize(vLines) / 4;
+    int * pCounts = ABC_CALLOC( int, Abc_MaxInt(1 << nIns, nStates) + 1 );
+    int * pOrder1 = ABC_ALLOC( int, nLines );
+    int * pOrder2 = ABC_ALLOC( int, nLines );
+    int i, k, iLine;
+    assert( Vec_IntSize(vLines) % 4 == 0 );
+    // stable counting sort by the input minterm
+    for ( i = 0; i < nLines; i++ )
+        pCounts[Vec_IntEntry(vLines, 4*i)+1]++;
+    for ( k = 0; k < (1 << nIns); k++ )
+        pCounts[k+1] += pCounts[k];
+    for ( i = 0; i < nLines; i++ )
+        pOrder1[pCounts[Vec_IntEntry(vLines, 4*i)]++] = i;
+    // stable counting sort by the current state
+    memset( pCounts, 0, sizeof(int) * (Abc_MaxInt(1 << nIns, nStates) + 1) );
+    for ( i = 0; i < nLines; i++ )
+        pCounts[Vec_IntEntry(vLines, 4*i+1)+1]++;
+    for ( k = 0; k < nStates; k++ )
+        pCounts[k+1] += pCounts[k];
+    for ( k = 0; k < nStates; k++ )
+        Vec_IntPush( p->vStart, pCounts[k+1] );
+    for ( i = 0; i < nLines; i++ )
+    {
+        iLine = pOrder1[i];
+        pOrder2[pCounts[Vec_IntEntry(vLines, 4*iLine+1)]++] = iLine;
+    }
+    for ( i = 0; i < nLines; i++ )
+    {
+        iLine = pOrder2[i];
+        Vec_IntPush( p->vMints, Vec_IntEntry(vLines, 4*iLine)   );
+        Vec_IntPush( p->vNexts, Vec_IntEntry(vLines, 4*iLine+2) );
+        Vec_IntPush( p->vOuts,  Vec_IntEntry(vLines, 4*iLine+3) );
+    }
+    ABC_FREE( pCounts );
+    ABC_FREE( pOrder1 );
+    ABC_FREE( pOrder2 );
+    p->nStates = nStates;
+    return p;
+}
+Vec_Int_t * Gia_StgToLines( Gia_Stg_t * p )
+{
+    Vec_Int_t * vLines = Vec_IntAlloc( 4 * Gia_StgTransNum(p) );
+    int s, t;
+    for ( s = 0; s < Gia_StgStateNum(p); s++ )
+        for ( t = Vec_IntEntry(p->vStart, s); t < Vec_IntEntry(p->vStart, s+1); t++ )
+        {
+            Vec_IntPush( vLines, Vec_IntEntry(p->vMints, t) );
+            Vec_IntPush( vLines, s );
+            Vec_IntPush( vLines, Vec_IntEntry(p->vNexts, t) );
+            Vec_IntPush( vLines, Vec_IntEntry(p->vOuts, t) );
+        }
+    return vLines;
+}
+
+/**Function*************************************************************
+
+  Synopsis    [Writes the STG into a file in the KISS format.]
+
+  Description []
+               
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+void Gia_StgWriteKiss( Gia_Stg_t * p, char * pFileName )
+{
+    FILE * pFile = fopen( pFileName, "wb" );
+    int s, t, Mint, Out;
+    if ( pFile == NULL )
+    {
+        printf( "Cannot open file \"%s\" for writing.\n", pFileName );
+        return;
+    }
+    fprintf( pFile, ".i %d\n", p->nIns );
+    fprintf( pFile, ".o %d\n", p->nOuts );
+    fprintf( pFile, ".p %d\n", Gia_StgTransNum(p) );
+    fprintf( pFile, ".s %d\n", Gia_StgStateNum(p) );
+    fprintf( pFile, ".r 0\n" );
+    for ( s = 0; s < Gia_StgStateNum(p); s++ )
+        for ( t = Vec_IntEntry(p->vStart, s); t < Vec_IntEntry(p->vStart, s+1); t++ )
+        {
+            Mint = Vec_IntEntry(p->vMints, t);
+            Out  = Vec_IntEntry(p->vOuts, t);
+            Extra_PrintBinary( pFile, (unsigned *)&Mint, p->nIns );
+            fprintf( pFile, " %d %d ", s, Vec_IntEntry(p->vNexts, t) );
+            Extra_PrintBinary( pFile, (unsigned *)&Out, p->nOuts );
+            fprintf( pFile, "\n" );
+        }
+    fprintf( pFile, ".e\n" );
+    fclose( pFile );
+}
+
+/**Function*************************************************************
+
+  Synopsis    [Runs the jobs on several threads.]
+
+  Description [Item i is processed by thread (i % nProcs). The calling
+  thread works as thread 0. Without pthreads, the jobs run in sequence.]
+               
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+static void Gia_StgRunJobs( void * (*pFunc)(void *), void * pMan, int nItems, int nProcs, word ** ppSims )
+{
+    Gia_StgThData_t ThData[GIA_STG_PROC_MAX];
+    int i;
+    nProcs = Abc_MaxInt( 1, Abc_MinInt(nProcs, nItems) );
+    for ( i = 0; i < nProcs; i++ )
+    {
+        ThData[i].pMan   = pMan;
+        ThData[i].iFirst = i;
+        ThData[i].nItems = nItems;
+        ThData[i].nStep  = nProcs;
+        ThData[i].pSims  = ppSims ? ppSims[i] : NULL;
+    }
+#ifdef ABC_USE_PTHREADS
+    if ( nProcs > 1 )
+    {
+        pthread_t WorkerThread[GIA_STG_PROC_MAX];
+        int status;
+        for ( i = 1; i < nProcs; i++ )
+        {
+            status = pthread_create( WorkerThread + i, NULL, pFunc, (void *)(ThData + i) );
+            assert( status == 0 );
+        }
+        pFunc( (void *)ThData );
+        for ( i = 1; i < nProcs; i++ )
+            pthread_join( WorkerThread[i], NULL );
+        return;
+    }
+#endif
+    for ( i = 0; i < nProcs; i++ )
+        pFunc( (void *)(ThData + i) );
+}
+
+/**Function*************************************************************
+
+  Synopsis    [Simulates one batch of states for all input minterms.]
+
+  Description [Pattern (s * nMints + m) applies input minterm m in
+  state (iFirst + iBatch * nBatch + s). Writes the next state codes and
+  the output minterms of these patterns into the job arrays.]
+               
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+static void Gia_StgExtSimulateBatch( Gia_StgExt_t * p, int iBatch, word * pSims )
+{
+    Gia_Man_t * pGia = p->pGia;
+    Gia_Obj_t * pObj;
+    int nWords = p->nWords;
+    int iStart = iBatch * p->nBatch;
+    int nStates = Abc_MinInt( p->nBatch, p->nJob - iStart );
+    int i, k, s, m, iPat, iTrans, Out;
+    word * pSim, * pNext;
+    memset( pSims, 0, sizeof(word) * nWords );
+    Gia_ManForEachPi( pGia, pObj, i )
+        memcpy( pSims + nWords * Gia_ObjId(pGia, pObj), p->pPis + nWords * i, sizeof(word) * nWords );
+    Gia_ManForEachRo( pGia, pObj, i )
+    {
+        pSim = pSims + nWords * Gia_ObjId(pGia, pObj);
+        memset( pSim, 0, sizeof(word) * nWords );
+        for ( s = 0; s < nStates; s++ )
+            if ( Abc_TtGetBit( Vec_MemReadEntry(p->vStates, p->iFirst + iStart + s), i ) )
+                for ( k = 0; k < nWords; k++ )
+                    pSim[k] |= p->pMasks[nWords * s + k];
+    }
+    Gia_ManForEachAnd( pGia, pObj, i )
+        Abc_TtAndCompl( pSims + nWords * i, 
+            pSims + nWords * Gia_ObjFaninId0(pObj, i), Gia_ObjFaninC0(pObj), 
+            pSims + nWords * Gia_ObjFaninId1(pObj, i), Gia_ObjFaninC1(pObj), nWords );
+    Gia_ManForEachCo( pGia, pObj, i )
+        Abc_TtCopy( pSims + nWords * Gia_ObjId(pGia, pObj), pSims + nWords * Gia_ObjFaninId0p(pGia, pObj), nWords, Gia_ObjFaninC0(pObj) );
+    // collect the transitions
+    for ( s = 0; s < nStates; s++ )
+    for ( m = 0; m < p->nMints; m++ )
+    {
+        iPat   = s * p->nMints + m;
+        iTrans = (iStart + s) * p->nMints + m;
+        pNext  = p->pNexts + (size_t)iTrans * p->nRegWords;
+        memset( pNext, 0, sizeof(word) * p->nRegWords );
+        Gia_ManForEachRi( pGia, pObj, i )
+            if ( Abc_TtGetBit( pSims + nWords * Gia_ObjId(pGia, pObj), iPat ) )
+                Abc_TtSetBit( pNext, i );
+        Out = 0;
+        Gia_ManForEachPo( pGia, pObj, i )
+            if ( Abc_TtGetBit( pSims + nWords * Gia_ObjId(pGia, pObj), iPat ) )
+                Out |= 1 << i;
+        p->pOuts[iTrans] = Out;
+    }
+}
+void * Gia_StgExtWorkerThread( void * pArg )
+{
+    Gia_StgThData_t * pThData = (Gia_StgThData_t *)pArg;
+    int i;
+    for ( i = pThData->iFirst; i < pThData->nItems; i += pThData->nStep )
+        Gia_StgExtSimulateBatch( (Gia_StgExt_t *)pThData->pMan, i, pThData->pSims );
+    return NULL;
+}
+
+/**Function*************************************************************
+
+  Synopsis    [Extracts the reachable STG of the sequential AIG.]
+
+  Description [Performs breadth-first traversal from the all-zero initial
+  state. Each step simulates a job of frontier states bit-parallel for all
+  input minterms, spreading the batches of states across nProcs threads.
+  The new states are numbered by the calling thread in the order of the
+  job, so the result does not depend on the number of threads. Returns
+  NULL if the AIG has too many inputs or outputs or if the number of 
+  reachable states exceeds nStatesMax.]
+               
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+Gia_Stg_t * Gia_ManStgExtract( Gia_Man_t * pGia, int nStatesMax, int nProcs, int fVerbose )
+{
+    Gia_StgExt_t Ext, * p = &Ext;
+    Gia_Stg_t * pStg;
+    word * pSimsTh[GIA_STG_PROC_MAX];
+    word * pZero;
+    int i, k, s, m, nJobMax, nSteps = 0, iNext = 0, fFail = 0;
+    abctime clk = Abc_Clock();
+    if ( Gia_ManRegNum(pGia) == 0 )
+    {
+        printf( "The AIG is combinational.\n" );
+        return NULL;
+    }
+    if ( Gia_ManPiNum(pGia) > GIA_STG_PI_MAX )
+    {
+        printf( "The number of primary inputs (%d) exceeds the limit (%d).\n", Gia_ManPiNum(pGia), GIA_STG_PI_MAX );
+        return NULL;
+    }
+    if ( Gia_ManPoNum(pGia) > GIA_STG_PO_MAX )
+    {
+        printf( "The number of primary outputs (%d) exceeds the limit (%d).\n", Gia_ManPoNum(pGia), GIA_STG_PO_MAX );
+        return NULL;
+    }
+    nProcs = Abc_MaxInt( 1, Abc_MinInt(nProcs, GIA_STG_PROC_MAX) );
+    memset( p, 0, sizeof(Gia_StgExt_t) );
+    p->pGia      = pGia;
+    p->nMints    = 1 << Gia_ManPiNum(pGia);
+    p->nBatch    = Abc_MaxInt( 1, 256 / p->nMints );
+    p->nWords    = Abc_Bit6WordNum( p->nBatch * p->nMints );
+    p->nRegWords = Abc_Bit6WordNum( Gia_ManRegNum(pGia) );
+    // input patterns and state masks
+    p->pPis   = ABC_CALLOC( word, p->nWords * Abc_MaxInt(1, Gia_ManPiNum(pGia)) );
+    p->pMasks = ABC_CALLOC( word, p->nWords * p->nBatch );
+    for ( k = 0; k < p->nBatch * p->nMints; k++ )
+    {
+        Abc_TtSetBit( p->pMasks + p->nWords * (k / p->nMints), k );
+        for ( i = 0; i < Gia_ManPiNum(pGia); i++ )
+            if ( ((k % p->nMints) >> i) & 1 )
+                Abc_TtSetBit( p->pPis + p->nWords * i, k );
+    }
+    // the initial state
+    p->vStates = Vec_MemAlloc( p->nRegWords, 12 );
+    Vec_MemHashAlloc( p->vStates, 1 << 12 );
+    pZero = ABC_CALLOC( word, p->nRegWords );
+    Vec_MemHashInsert( p->vStates, pZero );
+    ABC_FREE( pZero );
+    // the job arrays
+    nJobMax   = 4 * nProcs * p->nBatch;
+    p->pNexts = ABC_ALLOC( word, (size_t)nJobMax * p->nMints * p->nRegWords );
+    p->pOuts  = ABC_ALLOC( int, nJobMax * p->nMints );
+    for ( i = 0; i < nProcs; i++ )
+        pSimsTh[i] = ABC_ALLOC( word, (size_t)p->nWords * Gia_ManObjNum(pGia) );
+    // explore the states
+    pStg = Gia_StgAlloc( Gia_ManPiNum(pGia), Gia_ManPoNum(pGia) );
+    while ( iNext < Vec_MemEntryNum(p->vStates) )
+    {
+        p->iFirst = iNext;
+        p->nJob   = Abc_MinInt( nJobMax, Vec_MemEntryNum(p->vStates) - iNext );
+        Gia_StgRunJobs( Gia_StgExtWorkerThread, p, (p->nJob + p->nBatch - 1) / p->nBatch, nProcs, pSimsTh );
+        for ( s = 0; s < p->nJob; s++, iNext++ )
+        {
+            for ( m = 0; m < p->nMints; m++ )
+            {
+                k = s * p->nMints + m;
+                Vec_IntPush( pStg->vMints, m );
+                Vec_IntPush( pStg->vNexts, Vec_MemHashInsert(p->vStates, p->pNexts + (size_t)k * p->nRegWords) );
+                Vec_IntPush( pStg->vOuts,  p->pOuts[k] );
+            }
+            Vec_IntPush( pStg->vStart, Vec_IntSize(pStg->vMints) );
+        }
+        nSteps++;
+        if ( Vec_MemEntryNum(p->vStates) > nStatesMax )
+        {
+            fFail = 1;
+            break;
+        }
+    }
+    pStg->nStates = Gia_StgStateNum( pStg );
+    if ( fVerbose )
+    {
+        printf( "Extracted %d states and %d transitions in %d steps using %d thread%s.  ", 
+            Vec_MemEntryNum(p->vStates), Gia_StgTransNum(pStg), nSteps, nProcs, nProcs > 1 ? "s" : "" );
+        Abc_PrintTime( 1, "Time", Abc_Clock() - clk );
+    }
+    for ( i = 0; i < nProcs; i++ )
+        ABC_FREE( pSimsTh[i] );
+    ABC_FREE( p->pNexts );
+    ABC_FREE( p->pOuts );
+    ABC_FREE( p->pPis );
+    ABC_FREE( p->pMasks );
+    Vec_MemHashFree( p->vStates );
+    Vec_MemFree( p->vStates );
+    if ( fFail )
+    {
+        printf( "The number of reachable states exceeds the limit (%d).\n", nStatesMax );
+        Gia_StgFree( pStg );
+        return NULL;
+    }
+    return pStg;
+}
+
+/**Function*************************************************************
+
+  Synopsis    [Computes the refinement keys of the marked states.]
+
+  Description [The key of a state is its current class followed by the
+  pairs (input minterm, class of the next state) of its transitions.
+  In the first round, the output minterms are used instead of the classes
+  of the next states, which splits the states by their outputs.]
+               
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+static int Gia_StgMinStateKey( Gia_StgMin_t * p, int s, int * pKey )
+{
+    Gia_Stg_t * pStg = p->pStg;
+    int t, * pBeg = pKey;
+    *pKey++ = p->pClass[s];
+    for ( t = Vec_IntEntry(pStg->vStart, s); t < Vec_IntEntry(pStg->vStart, s+1); t++ )
+    {
+        *pKey++ = Vec_IntEntry(pStg->vMints, t);
+        *pKey++ = p->fFirst ? Vec_IntEntry(pStg->vOuts, t) : p->pClass[Vec_IntEntry(pStg->vNexts, t)];
+    }
+    return pKey - pBeg;
+}
+void * Gia_StgMinWorkerThread( void * pArg )
+{
+    Gia_StgThData_t * pThData = (Gia_StgThData_t *)pArg;
+    Gia_StgMin_t * p = (Gia_StgMin_t *)pThData->pMan;
+    int i, k, kStop;
+    for ( i = pThData->iFirst; i < pThData->nItems; i += pThData->nStep )
+    {
+        kStop = Abc_MinInt( (i + 1) * GIA_STG_CHUNK, Vec_IntSize(p->vDirty) );
+        for ( k = i * GIA_STG_CHUNK; k < kStop; k++ )
+            Gia_StgMinStateKey( p, Vec_IntEntry(p->vDirty, k), Vec_IntEntryP(p->vKeys, Vec_IntEntry(p->vOffs, k)) );
+    }
+    return NULL;
+}
+
+/**Function*************************************************************
+
+  Synopsis    [Minimizes the number of states of the STG.]
+
+  Description [Performs partition refinement in rounds. The first round
+  splits the states by their outputs. In the next rounds, only the keys
+  of the predecessors of the states that changed their class in the 
+  previous round are recomputed, in parallel, because the keys of other
+  states cannot change. The states of each class with a changed key 
+  are split by hashing their keys in the order of the states; the group 
+  whose key matches that of the unchanged members keeps the class while 
+  other groups get new classes. The refinement stops when no state 
+  changes its class. The classes are finally renumbered in the order of 
+  their first states, so the initial state remains state 0. Transitions 
+  that are not specified distinguish the states, so the result is exact 
+  for completely specified machines.]
+               
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+Gia_Stg_t * Gia_StgMinimize( Gia_Stg_t * p, int nProcs, int fVerbose )
+{
+    Gia_StgMin_t Min, * pMin = &Min;
+    Gia_Stg_t * pNew;
+    Hsh_VecMan_t * pHash;
+    Vec_Int_t * vNext, * vGroups, * vGroup2Class, * vTemp, vKey;
+    int nStates = Gia_StgStateNum(p), nTrans = Gia_StgTransNum(p);
+    int * pHead    = ABC_FALLOC( int, nStates + 1 );
+    int * pNextM   = ABC_FALLOC( int, nStates + 1 );
+    int * pPrevM   = ABC_FALLOC( int, nStates + 1 );
+    int * pIsDirty = ABC_FALLOC( int, nStates + 1 );
+    int * pInNext  = ABC_FALLOC( int, nStates + 1 );
+    int * pKept    = ABC_FALLOC( int, nStates + 1 );
+    int * pStamp   = ABC_FALLOC( int, nStates + 1 );
+    int * pPredBeg = ABC_CALLOC( int, nStates + 1 );
+    int * pPreds   = ABC_ALLOC( int, nTrans + 1 );
+    int * pMap, * pRepr;
+    int i, k, s, t, m, r, C, g, iNew, nClasses = 0, nKeys = 0;
+    abctime clk = Abc_Clock();
+    nProcs = Abc_MaxInt( 1, Abc_MinInt(nProcs, GIA_STG_PROC_MAX) );
+    // collect the predecessors
+    for ( t = 0; t < nTrans; t++ )
+        pPredBeg[Vec_IntEntry(p->vNexts, t)]++;
+    for ( s = 1; s <= nStates; s++ )
+        pPredBeg[s] += pPredBeg[s-1];
+    for ( s = nStates - 1; s >= 0; s-- )
+        for ( t = Vec_IntEntry(p->vStart, s+1) - 1; t >= Vec_IntEntry(p->vStart, s); t-- )
+            pPreds[--pPredBeg[Vec_IntEntry(p->vNexts, t)]] = s;
+    // start with all states in one class
+    pMin->pStg   = p;
+    pMin->pClass = ABC_CALLOC( int, nStates + 1 );
+    pMin->vDirty = Vec_IntStartNatural( nStates );
+    pMin->vOffs  = Vec_IntAlloc( nStates + 1 );
+    pMin->vKeys  = Vec_IntAlloc( nStates + 2 * nTrans );
+    for ( s = 0; s < nStates; s++ )
+        pNextM[s] = s + 1 < nStates ? s + 1 : -1, pPrevM[s] = s - 1;
+    if ( nStates > 0 )
+        pHead[0] = 0, nClasses = 1;
+    vNext        = Vec_IntAlloc( 1000 );
+    vGroups      = Vec_IntAlloc( 1000 );
+    vGroup2Class = Vec_IntAlloc( 1000 );
+    vTemp        = Vec_IntAlloc( 1000 );
+    for ( r = 0; Vec_IntSize(pMin->vDirty) > 0; r++ )
+    {
+        pMin->fFirst = (r == 0);
+        // compute the keys of the marked states
+        Vec_IntClear( pMin->vOffs );
+        Vec_IntPush( pMin->vOffs, 0 );
+        Vec_IntForEachEntry( pMin->vDirty, s, i )
+        {
+            Vec_IntPush( pMin->vOffs, Vec_IntEntryLast(pMin->vOffs) + 1 + 2 * (Vec_IntEntry(p->vStart, s+1) - Vec_IntEntry(p->vStart, s)) );
+            pIsDirty[s] = r;
+        }
+        Vec_IntFill( pMin->vKeys, Vec_IntEntryLast(pMin->vOffs), 0 );
+        Gia_StgRunJobs( Gia_StgMinWorkerThread, pMin, (Vec_IntSize(pMin->vDirty) + GIA_STG_CHUNK - 1) / GIA_STG_CHUNK, nProcs, NULL );
+        nKeys += Vec_IntSize(pMin->vDirty);
+        // group the keys
+        pHash = Hsh_VecManStart( Vec_IntSize(pMin->vDirty) );
+        Vec_IntClear( vGroups );
+        Vec_IntForEachEntry( pMin->vDirty, s, i )
+        {
+            vKey.nSize  = vKey.nCap = Vec_IntEntry(pMin->vOffs, i+1) - Vec_IntEntry(pMin->vOffs, i);
+            vKey.pArray = Vec_IntEntryP( pMin->vKeys, Vec_IntEntry(pMin->vOffs, i) );
+            Vec_IntPush( vGroups, Hsh_VecManAdd(pHash, &vKey) );
+        }
+        // split the classes
+        Vec_IntClear( vGroup2Class );
+        Vec_IntClear( vNext );
+        Vec_IntForEachEntry( pMin->vDirty, s, i )
+        {
+            C = pMin->pClass[s];
+            g = Vec_IntEntry( vGroups, i );
+            if ( pStamp[C] != r )
+            {
+                // the group of the members whose keys did not change keeps the class
+                pStamp[C] = r;
+                for ( m = pHead[C]; m != -1 && pIsDirty[m] == r; m = pNextM[m] );
+                if ( m == -1 )
+                    pKept[C] = g;
+                else
+                {
+                    Vec_IntFill( vTemp, 1 + 2 * (Vec_IntEntry(p->vStart, m+1) - Vec_IntEntry(p->vStart, m)), 0 );
+                    Gia_StgMinStateKey( pMin, m, Vec_IntArray(vTemp) );
+                    pKept[C] = Hsh_VecManAdd( pHash, vTemp );
+                }
+            }
+            if ( g == pKept[C] )
+                continue;
+            Vec_IntFillExtra( vGroup2Class, g + 1, -1 );
+            if ( Vec_IntEntry(vGroup2Class, g) == -1 )
+                Vec_IntWriteEntry( vGroup2Class, g, nClasses++ );
+            iNew = Vec_IntEntry( vGroup2Class, g );
+            // move the state into the new class
+            if ( pPrevM[s] == -1 )
+                pHead[C] = pNextM[s];
+            else
+                pNextM[pPrevM[s]] = pNextM[s];
+            if ( pNextM[s] != -1 )
+                pPrevM[pNextM[s]] = pPrevM[s];
+            pPrevM[s] = -1;
+            pNextM[s] = pHead[iNew];
+            if ( pHead[iNew] != -1 )
+                pPrevM[pHead[iNew]] = s;
+            pHead[iNew] = s;
+            pMin->pClass[s] = iNew;
+            // the predecessors are recomputed in the next round
+            for ( k = pPredBeg[s]; k < pPredBeg[s+1]; k++ )
+                if ( pInNext[pPreds[k]] != r )
+                {
+                    pInNext[pPreds[k]] = r;
+                    Vec_IntPush( vNext, pPreds[k] );
+                }
+        }
+        Hsh_VecManStop( pHash );
+        ABC_SWAP( Vec_Int_t *, pMin->vDirty, vNext );
+    }
+    Vec_IntFree( vNext );
+    Vec_IntFree( vGroups );
+    Vec_IntFree( vGroup2Class );
+    Vec_IntFree( vTemp );
+    // renumber the classes in the order of their first states
+    pMap  = ABC_FALLOC( int, nClasses + 1 );
+    pRepr = ABC_FALLOC( int, nClasses + 1 );
+    for ( k = s = 0; s < nStates; s++ )
+        if ( pMap[pMin->pClass[s]] == -1 )
+        {
+            pRepr[k] = s;
+            pMap[pMin->pClass[s]] = k++;
+        }
+    assert( k == nClasses );
+    // derive the quotient machine using the first state of each class
+    pNew = Gia_StgAlloc( p->nIns, p->nOuts );
+    for ( k = 0; k < nClasses; k++ )
+    {
+        s = pRepr[k];
+        for ( t = Vec_IntEntry(p->vStart, s); t < Vec_IntEntry(p->vStart, s+1); t++ )
+        {
+            Vec_IntPush( pNew->vMints, Vec_IntEntry(p->vMints, t) );
+            Vec_IntPush( pNew->vNexts, pMap[pMin->pClass[Vec_IntEntry(p->vNexts, t)]] );
+            Vec_IntPush( pNew->vOuts,  Vec_IntEntry(p->vOuts, t) );
+        }
+        Vec_IntPush( pNew->vStart, Vec_IntSize(pNew->vMints) );
+    }
+    pNew->nStates = nClasses;
+    if ( fVerbose )
+    {
+        printf( "Reduced %d states to %d states in %d rounds with %d keys using %d thread%s.  ", 
+            nStates, nClasses, r, nKeys, nProcs, nProcs > 1 ? "s" : "" );
+        Abc_PrintTime( 1, "Time", Abc_Clock() - clk );
+    }
+    ABC_FREE( pMap );
+    ABC_FREE( pRepr );
+    ABC_FREE( pHead );
+    ABC_FREE( pNextM );
+    ABC_FREE( pPrevM );
+    ABC_FREE( pIsDirty );
+    ABC_FREE( pInNext );
+    ABC_FREE( pKept );
+    ABC_FREE( pStamp );
+    ABC_FREE( pPredBeg );
+    ABC_FREE( pPreds );
+    ABC_FREE( pMin->pClass );
+    Vec_IntFree( pMin->vDirty );
+    Vec_IntFree( pMin->vOffs );
+    Vec_IntFree( pMin->vKeys );
+    return pNew;
+}
+
+/**Function*************************************************************
+
+  Synopsis    [Derives the k-hot-encoded AIG of the STG.]
+
+  Description []
+               
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+Gia_Man_t * Gia_StgDeriveGia( Gia_Stg_t * p, int kHot, int fVerbose )
+{
+    Gia_Man_t * pNew;
+    Vec_Int_t * vLines = Gia_StgToLines( p );
+    pNew = Gia_ManStgKHot( vLines, p->nIns, p->nOuts, Gia_StgStateNum(p), kHot, fVerbose );
+    Vec_IntFree( vLines );
+    return pNew;
+}
+
+/**Function*************************************************************
+
+  Synopsis    [Reads the STG from a file in the KISS format.]
+
+  Description []
+               
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+Gia_Stg_t * Gia_StgRead( char * pFileName )
+{
+    Gia_Stg_t * p;
+    Vec_Int_t * vLines;
+    int i, nIns, nOuts, nStates;
+    vLines = Gia_ManStgReadLines( pFileName, &nIns, &nOuts, &nStates );
+    if ( vLines == NULL )
+        return NULL;
+    for ( i = 2; i < Vec_IntSize(vLines); i += 4 )
+        nStates = Abc_MaxInt( nStates, Vec_IntEntry(vLines, i) + 1 );
+    p = Gia_StgFromLines( vLines, nIns, nOuts, nStates );
+    Vec_IntFree( vLines );
+    return p;
+}
+
 ////////////////////////////////////////////////////////////////////////
 ///                       END OF FILE                                ///
 ////////////////////////////////////////////////////////////////////////
@@ -23,6 +23,17 @@
 #include "sat/bsat/satSolver.h"
 #include "proof/ssc/ssc.h"
 
+#ifdef ABC_USE_PTHREADS
+
+#ifdef _WIN32
+#include "../lib/pthread.h"
+#else
+#include <pthread.h>
+#include <unistd.h>
+#endif
+
+#endif
+
 ABC_NAMESPACE_IMPL_START
 
 /*
@@ -46,6 +57,16 @@ SAT sweeping/equivalence checking requires the following steps:
       (resource limits, such as the number of conflicts, will be controllable by dedicated GIA APIs)
 - The resulting AIG to be returned to the user by calling Gia_SweeperExtractUserLogic()
       Gia_Man_t * Gia_SweeperExtractUserLogic( Gia_Man_t * p, Vec_Int_t * vProbeIds, Vec_Ptr_t * vOutNames )
+- Many equivalence queries can be answered at once by calling Gia_SweeperCheckEquivBatch()
+      Vec_Int_t * Gia_SweeperCheckEquivBatch( Gia_Man_t * p, Vec_Int_t * vProbePairs, int nProcs )
+  Comments:
+      - the CNF is loaded lazily and kept between the calls; conditions are passed 
+        as assumptions and the clauses learned under them are guarded by the condition
+        literals, so that popping a condition does not require rebuilding the CNF
+      - the pairs are first filtered by bit-parallel simulation with random patterns
+        and the counter-examples produced by the previous calls
+      - with nProcs > 1, the remaining pairs are distributed among persistent solver
+        shards, each pair going to the shard that already holds most of its cone
 
 */
 
@@ -53,6 +74,9 @@ SAT sweeping/equivalence checking requires the following steps:
 ///                        DECLARATIONS                              ///
 ////////////////////////////////////////////////////////////////////////
 
+#define GIA_SWP_SIM_WORDS    4   // the number of simulation words
+#define GIA_SWP_PROC_MAX    64   // the largest number of solver shards
+
 typedef struct Swp_Man_t_ Swp_Man_t;
 struct Swp_Man_t_
 {
@@ -69,13 +93,25 @@ struct Swp_Man_t_
     Vec_Int_t *    vFanins;     // temporary fanins
     Vec_Int_t *    vCexSwp;     // sweeper counter-example
     Vec_Int_t *    vCexUser;    // user-visible counter-example
+    Vec_Int_t *    vClause;     // temporary clause
+    Vec_Int_t *    vCondLits;   // literals of the current conditions
     int            nSatVars;    // counter of SAT variables
+    // simulation
+    Vec_Wrd_t *    vSims;       // simulation info of the objects
+    int            nSimObjs;    // the number of simulated objects
+    int            iSimPat;     // the next pattern to be overwritten by a counter-example
+    int            nSimCexes;   // the number of counter-examples not yet simulated
+    Vec_Int_t *    vSimCexes;   // counter-examples not yet simulated (size followed by values)
+    // solver shards
+    Vec_Ptr_t *    vShards;     // additional solvers used by the batch queries
+    Vec_Int_t *    vObj2Shard;  // temporary shard assignment
     // statistics
     int            nSatCalls;
     int            nSatCallsSat;
     int            nSatCallsUnsat;
     int            nSatCallsUndec;
     int            nSatProofs;
+    int            nSimFiltered;
     abctime        timeStart;
     abctime        timeTotal;
     abctime        timeCnf;
@@ -104,12 +140,11 @@ static inline void Swp_ManSetObj2Lit( Swp_Man_t * p, int Id, int Lit )  { assert
   SeeAlso     []
 
 ***********************************************************************/
-static inline Swp_Man_t * Swp_ManStart( Gia_Man_t * pGia )
+static inline Swp_Man_t * Swp_ManAlloc( Gia_Man_t * pGia )
 {
     Swp_Man_t * p;
     int Lit;
-    assert( Vec_IntSize(&pGia->vHTable) );
-    pGia->pData = p = ABC_CALLOC( Swp_Man_t, 1 );
+    p = ABC_CALLOC( Swp_Man_t, 1 );
     p->pGia         = pGia;
     p->nConfMax     = 1000;
     p->vProbes      = Vec_IntAlloc( 100 );
@@ -119,6 +154,9 @@ static inline Swp_Man_t * Swp_ManStart( Gia_Man_t * pGia )
     p->vFront       = Vec_IntAlloc( 100 );
     p->vFanins      = Vec_IntAlloc( 100 );
     p->vCexSwp      = Vec_IntAlloc( 100 );
+    p->vClause      = Vec_IntAlloc( 100 );
+    p->vCondLits    = Vec_IntAlloc( 100 );
+    p->vSimCexes    = Vec_IntAlloc( 100 );
     p->pSat         = sat_solver_new();
     p->nSatVars     = 1;
     sat_solver_setnvars( p->pSat, 1000 );
@@ -128,10 +166,22 @@ static inline Swp_Man_t * Swp_ManStart( Gia_Man_t * pGia )
     p->timeStart    = Abc_Clock();
     return p;
 }
-static inline void Swp_ManStop( Gia_Man_t * pGia )
+static inline void Swp_ManFree( Swp_Man_t * p )
 {
-    Swp_Man_t * p = (Swp_Man_t *)pGia->pData;
+    Swp_Man_t * pShard;
+    int i;
+    if ( p->vShards )
+    {
+        Vec_PtrForEachEntry( Swp_Man_t *, p->vShards, pShard, i )
+            Swp_ManFree( pShard );
+        Vec_PtrFree( p->vShards );
+    }
     sat_solver_delete( p->pSat );
+    Vec_WrdFreeP( &p->vSims );
+    Vec_IntFreeP( &p->vObj2Shard );
+    Vec_IntFree( p->vClause );
+    Vec_IntFree( p->vCondLits );
+    Vec_IntFree( p->vSimCexes );
     Vec_IntFree( p->vFanins );
     Vec_IntFree( p->vCexSwp );
     Vec_IntFree( p->vId2Lit );
@@ -140,6 +190,16 @@ static inline void Swp_ManStop( Gia_Man_t * pGia )
     Vec_IntFree( p->vCondProbes );
     Vec_IntFree( p->vCondAssump );
     ABC_FREE( p );
+}
+static inline Swp_Man_t * Swp_ManStart( Gia_Man_t * pGia )
+{
+    assert( Vec_IntSize(&pGia->vHTable) );
+    pGia->pData = Swp_ManAlloc( pGia );
+    return (Swp_Man_t *)pGia->pData;
+}
+static inline void Swp_ManStop( Gia_Man_t * pGia )
+{
+    Swp_ManFree( (Swp_Man_t *)pGia->pData );
     pGia->pData = NULL;
 }
 Gia_Man_t * Gia_SweeperStart( Gia_Man_t * pGia )
@@ -167,8 +227,9 @@ int Gia_SweeperIsRunning( Gia_Man_t * pGia )
 }
 double Gia_SweeperMemUsage( Gia_Man_t * pGia )
 {
-    Swp_Man_t * p = (Swp_Man_t *)pGia->pData;
+    Swp_Man_t * p = (Swp_Man_t *)pGia->pData, * pShard;
     double nMem = sizeof(Swp_Man_t);
+    int i;
     nMem += Vec_IntCap(p->vProbes);
     nMem += Vec_IntCap(p->vCondProbes);
     nMem += Vec_IntCap(p->vCondAssump);
@@ -176,6 +237,18 @@ double Gia_SweeperMemUsage( Gia_Man_t * pGia )
     nMem += Vec_IntCap(p->vFront);
     nMem += Vec_IntCap(p->vFanins);
     nMem += Vec_IntCap(p->vCexSwp);
+    nMem += Vec_IntCap(p->vClause);
+    nMem += Vec_IntCap(p->vCondLits);
+    nMem += Vec_IntCap(p->vSimCexes);
+    nMem += p->vObj2Shard ? Vec_IntCap(p->vObj2Shard) : 0;
+    nMem += p->vSims ? 2 * Vec_WrdCap(p->vSims) : 0;
+    if ( p->vShards )
+    Vec_PtrForEachEntry( Swp_Man_t *, p->vShards, pShard, i )
+    {
+        nMem += sizeof(Swp_Man_t) / 4;
+        nMem += Vec_IntCap(pShard->vId2Lit);
+        nMem += sat_solver_memory(pShard->pSat) / 4;
+    }
     return 4.0 * nMem;
 }
 void Gia_SweeperPrintStats( Gia_Man_t * pGia )
@@ -201,8 +274,8 @@ void Gia_SweeperPrintStats( Gia_Man_t * pGia )
     ABC_PRTP( "TOTAL RUNTIME   ", p->timeTotal,    p->timeTotal );
     printf( "GIA: " );
     Gia_ManPrintStats( pGia, NULL );
-    printf( "SAT calls = %d. Sat = %d. Unsat = %d. Undecided = %d.  Proofs = %d.\n", 
-        p->nSatCalls, p->nSatCallsSat, p->nSatCallsUnsat, p->nSatCallsUndec, p->nSatProofs );
+    printf( "SAT calls = %d. Sat = %d. Unsat = %d. Undecided = %d.  Proofs = %d.  Sim-filtered = %d.  Shards = %d.\n", 
+        p->nSatCalls, p->nSatCallsSat, p->nSatCallsUnsat, p->nSatCallsUndec, p->nSatProofs, p->nSimFiltered, p->vShards ? 1 + Vec_PtrSize(p->vShards) : 1 );
     Sat_SolverPrintStats( stdout, p->pSat );
 }
 
@@ -513,6 +586,17 @@ Gia_Man_t * Gia_SweeperCleanup( Gia_Man_t * p, char * pCommLime )
         pNew = Abc_FrameGetGia( Abc_FrameGetGlobalFrame() );
     }
     // restart the SAT solver
+    if ( pSwp->vShards )
+    {
+        Swp_Man_t * pShard;
+        Vec_PtrForEachEntry( Swp_Man_t *, pSwp->vShards, pShard, i )
+            Swp_ManFree( pShard );
+        Vec_PtrFreeP( &pSwp->vShards );
+    }
+    Vec_WrdFreeP( &pSwp->vSims );
+    pSwp->nSimObjs     = 0;
+    pSwp->nSimCexes    = 0;
+    Vec_IntClear( pSwp->vSimCexes );
     Vec_IntClear( pSwp->vId2Lit );
     sat_solver_delete( pSwp->pSat );
     pSwp->pSat         = sat_solver_new();
@@ -775,6 +859,128 @@ static Vec_Int_t * Gia_ManGetCex( Gia_Man_t * pGia, Vec_Int_t * vId2Lit, sat_sol
     return vCex;
 }
 
+/**Function*************************************************************
+
+  Synopsis    [Simulation used to filter the queries.]
+
+  Description [The simulation info of the primary inputs is random, except
+  for the bits overwritten by the counter-examples of the previous queries.
+  Only the objects added since the last call are simulated, unless new 
+  counter-examples have been recorded, in which case all nodes are updated.]
+               
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+static inline word * Swp_ManSimObj( Swp_Man_t * p, int Id )  { return Vec_WrdEntryP( p->vSims, GIA_SWP_SIM_WORDS * Id ); }
+
+static void Swp_ManSimAddCex( Swp_Man_t * p, Vec_Int_t * vCex )
+{
+    int i, Value;
+    Vec_IntForEachEntry( vCex, Value, i )
+        if ( Value != 2 )
+            break;
+    if ( i == Vec_IntSize(vCex) )
+        return;
+    Vec_IntPush( p->vSimCexes, Vec_IntSize(vCex) );
+    Vec_IntAppend( p->vSimCexes, vCex );
+    p->nSimCexes++;
+}
+static void Swp_ManSimApplyCexes( Swp_Man_t * p )
+{
+    Gia_Obj_t * pObj;
+    unsigned * pSim;
+    int i, k, nValues, Value;
+    for ( i = 0; i < Vec_IntSize(p->vSimCexes); i += nValues + 1 )
+    {
+        nValues = Vec_IntEntry( p->vSimCexes, i );
+        for ( k = 0; k < nValues && k < Gia_ManPiNum(p->pGia); k++ )
+        {
+            Value = Vec_IntEntry( p->vSimCexes, i + 1 + k );
+            pObj  = Gia_ManPi( p->pGia, k );
+            if ( Value == 2 || Gia_ObjId(p->pGia, pObj) >= p->nSimObjs )
+                continue;
+            pSim = (unsigned *)Swp_ManSimObj( p, Gia_ObjId(p->pGia, pObj) );
+            if ( Value != Abc_InfoHasBit(pSim, p->iSimPat) )
+                Abc_InfoXorBit( pSim, p->iSimPat );
+        }
+        p->iSimPat = (p->iSimPat + 1) % (64 * GIA_SWP_SIM_WORDS);
+    }
+    Vec_IntClear( p->vSimCexes );
+}
+static void Swp_ManSimulate( Swp_Man_t * p )
+{
+    Gia_Obj_t * pObj;
+    word * pSim, * pSim0, * pSim1, Mask0, Mask1;
+    int i, w, iStart = p->nSimObjs;
+    if ( p->vSims == NULL )
+        p->vSims = Vec_WrdAlloc( GIA_SWP_SIM_WORDS * Gia_ManObjNum(p->pGia) );
+    if ( p->nSimCexes )
+    {
+        Swp_ManSimApplyCexes( p );
+        p->nSimCexes = 0;
+        iStart = 1;
+    }
+    if ( iStart == Gia_ManObjNum(p->pGia) )
+        return;
+    Vec_WrdFillExtra( p->vSims, GIA_SWP_SIM_WORDS * Gia_ManObjNum(p->pGia), 0 );
+    for ( i = iStart; i < Gia_ManObjNum(p->pGia); i++ )
+    {
+        pObj = Gia_ManObj( p->pGia, i );
+        pSim = Swp_ManSimObj( p, i );
+        if ( Gia_ObjIsAnd(pObj) )
+        {
+            pSim0 = Swp_ManSimObj( p, Gia_ObjFaninId0(pObj, i) );
+            pSim1 = Swp_ManSimObj( p, Gia_ObjFaninId1(pObj, i) );
+            Mask0 = Gia_ObjFaninC0(pObj) ? ~(word)0 : 0;
+            Mask1 = Gia_ObjFaninC1(pObj) ? ~(word)0 : 0;
+            for ( w = 0; w < GIA_SWP_SIM_WORDS; w++ )
+                pSim[w] = (pSim0[w] ^ Mask0) & (pSim1[w] ^ Mask1);
+        }
+        else if ( Gia_ObjIsCo(pObj) )
+        {
+            pSim0 = Swp_ManSimObj( p, Gia_ObjFaninId0(pObj, i) );
+            Mask0 = Gia_ObjFaninC0(pObj) ? ~(word)0 : 0;
+            for ( w = 0; w < GIA_SWP_SIM_WORDS; w++ )
+                pSim[w] = pSim0[w] ^ Mask0;
+        }
+        else if ( Gia_ObjIsCi(pObj) && i >= p->nSimObjs )
+        {
+            for ( w = 0; w < GIA_SWP_SIM_WORDS; w++ )
+                pSim[w] = Gia_ManRandomW( 0 );
+        }
+    }
+    p->nSimObjs = Gia_ManObjNum(p->pGia);
+}
+// computes the patterns under which all conditions hold (condition literals are 0)
+static void Swp_ManSimCare( Swp_Man_t * p, Vec_Int_t * vCondLits, word * pCare )
+{
+    word * pSim, Mask;
+    int i, w, iLit;
+    for ( w = 0; w < GIA_SWP_SIM_WORDS; w++ )
+        pCare[w] = ~(word)0;
+    Vec_IntForEachEntry( vCondLits, iLit, i )
+    {
+        pSim = Swp_ManSimObj( p, Abc_Lit2Var(iLit) );
+        Mask = Abc_LitIsCompl(iLit) ? ~(word)0 : 0;
+        for ( w = 0; w < GIA_SWP_SIM_WORDS; w++ )
+            pCare[w] &= ~(pSim[w] ^ Mask);
+    }
+}
+// returns 1 if the literals differ under some care pattern
+static int Swp_ManSimDiffer( Swp_Man_t * p, word * pCare, int iLit0, int iLit1 )
+{
+    word * pSim0 = Swp_ManSimObj( p, Abc_Lit2Var(iLit0) );
+    word * pSim1 = Swp_ManSimObj( p, Abc_Lit2Var(iLit1) );
+    word Mask = (Abc_LitIsCompl(iLit0) ^ Abc_LitIsCompl(iLit1)) ? ~(word)0 : 0;
+    int w;
+    for ( w = 0; w < GIA_SWP_SIM_WORDS; w++ )
+        if ( (pSim0[w] ^ pSim1[w] ^ Mask) & pCare[w] )
+            return 1;
+    return 0;
+}
+
 /**Function*************************************************************
 
   Synopsis    [Runs equivalence test for probes.]
@@ -786,25 +992,34 @@ static Vec_Int_t * Gia_ManGetCex( Gia_Man_t * pGia, Vec_Int_t * vId2Lit, sat_sol
   SeeAlso     []
 
 ***********************************************************************/
-int Gia_SweeperCheckEquiv( Gia_Man_t * pGia, int Probe1, int Probe2 )
+static void Swp_ManAddGuardedClause( Swp_Man_t * p, int Lit0, int Lit1 )
 {
-    Swp_Man_t * p = (Swp_Man_t *)pGia->pData;
-    int iLitOld, iLitNew, iLitAig, pLitsSat[2], RetValue, RetValue1, ProbeId, i;
+    int k, Lit, RetValue;
+    // the clause holds only when the current conditions hold
+    Vec_IntClear( p->vClause );
+    Vec_IntPush( p->vClause, Lit0 );
+    Vec_IntPush( p->vClause, Lit1 );
+    Vec_IntForEachEntry( p->vCondAssump, Lit, k )
+        Vec_IntPush( p->vClause, Abc_LitNot(Lit) );
+    RetValue = sat_solver_addclause( p->pSat, Vec_IntArray(p->vClause), Vec_IntArray(p->vClause) + Vec_IntSize(p->vClause) );
+    assert( RetValue );
+    (void) RetValue;
+}
+static int Swp_ManCheckEquiv( Swp_Man_t * p, Vec_Int_t * vCondLits, int iLitOld, int iLitNew )
+{
+    int iLitAig, pLitsSat[2], RetValue1, i;
     abctime clk;
     p->nSatCalls++;
     assert( p->pSat != NULL );
     p->vCexUser = NULL;
 
-    // get the literals
-    iLitOld = Gia_SweeperProbeLit( pGia, Probe1 );
-    iLitNew = Gia_SweeperProbeLit( pGia, Probe2 );
     // if the literals are identical, the probes are equivalent
     if ( iLitOld == iLitNew )
         return 1;
     // if the literals are opposites, the probes are not equivalent
     if ( Abc_LitRegular(iLitOld) == Abc_LitRegular(iLitNew) )
     {
-        Vec_IntFill( p->vCexSwp, Gia_ManPiNum(pGia), 2 );
+        Vec_IntFill( p->vCexSwp, Gia_ManPiNum(p->pGia), 2 );
         p->vCexUser = p->vCexSwp;
         return 0;
     }
@@ -815,9 +1030,8 @@ int Gia_SweeperCheckEquiv( Gia_Man_t * pGia, int Probe1, int Probe2 )
 
     // create logic cones and the array of assumptions
     Vec_IntClear( p->vCondAssump );
-    Vec_IntForEachEntry( p->vCondProbes, ProbeId, i )
+    Vec_IntForEachEntry( vCondLits, iLitAig, i )
     {
-        iLitAig = Gia_SweeperProbeLit( pGia, ProbeId );
         Gia_ManCnfNodeAddToSolver( p, Abc_Lit2Var(iLitAig) );
         Vec_IntPush( p->vCondAssump, Abc_LitNot(Swp_ManLit2Lit(p, iLitAig)) );
     }
@@ -845,10 +1059,7 @@ clk = Abc_Clock();
 p->timeSat += Abc_Clock() - clk;
     if ( RetValue1 == l_False )
     {
-        pLitsSat[0] = Abc_LitNot( pLitsSat[0] );
-        RetValue = sat_solver_addclause( p->pSat, pLitsSat, pLitsSat + 2 );
-        assert( RetValue );
-        pLitsSat[0] = Abc_LitNot( pLitsSat[0] );
+        Swp_ManAddGuardedClause( p, Abc_LitNot(pLitsSat[0]), pLitsSat[1] );
 p->timeSatUnsat += Abc_Clock() - clk;
         p->nSatCallsUnsat++;
     }
@@ -885,10 +1096,7 @@ clk = Abc_Clock();
 p->timeSat += Abc_Clock() - clk;
     if ( RetValue1 == l_False )
     {
-        pLitsSat[1] = Abc_LitNot( pLitsSat[1] );
-        RetValue = sat_solver_addclause( p->pSat, pLitsSat, pLitsSat + 2 );
-        assert( RetValue );
-        pLitsSat[1] = Abc_LitNot( pLitsSat[1] );
+        Swp_ManAddGuardedClause( p, pLitsSat[0], Abc_LitNot(pLitsSat[1]) );
 p->timeSatUnsat += Abc_Clock() - clk;
         p->nSatCallsUnsat++;
     }
@@ -909,6 +1117,274 @@ p->timeSatUndec += Abc_Clock() - clk;
     p->nSatProofs++;
     return 1;
 }
+static void Swp_ManCollectCondLits( Swp_Man_t * p )
+{
+    int ProbeId, i;
+    Vec_IntClear( p->vCondLits );
+    Vec_IntForEachEntry( p->vCondProbes, ProbeId, i )
+        Vec_IntPush( p->vCondLits, Gia_SweeperProbeLit(p->pGia, ProbeId) );
+}
+int Gia_SweeperCheckEquiv( Gia_Man_t * pGia, int Probe1, int Probe2 )
+{
+    Swp_Man_t * p = (Swp_Man_t *)pGia->pData;
+    int RetValue;
+    Swp_ManCollectCondLits( p );
+    RetValue = Swp_ManCheckEquiv( p, p->vCondLits, Gia_SweeperProbeLit(pGia, Probe1), Gia_SweeperProbeLit(pGia, Probe2) );
+    if ( RetValue == 0 && p->vCexUser && p->vSims )
+        Swp_ManSimAddCex( p, p->vCexUser );
+    return RetValue;
+}
+
+/**Function*************************************************************
+
+  Synopsis    [Distributes the pairs among the solver shards.]
+
+  Description [A pair goes to the shard that already has the CNF of the
+  nodes or their fanins, or that received other pairs sharing these nodes 
+  in the same batch. If no shard qualifies, or if the best shard is much 
+  more loaded than the average, the least loaded shard is used.]
+               
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+static inline int Swp_ManShardHasObj( Swp_Man_t * pShard, int Id )
+{
+    return Id < Vec_IntSize(pShard->vId2Lit) && Vec_IntEntry(pShard->vId2Lit, Id) > 0;
+}
+static Vec_Int_t * Swp_ManAssignShards( Swp_Man_t * p, Swp_Man_t ** pShards, int nShards, Vec_Int_t * vLits, Vec_Int_t * vTodo )
+{
+    Vec_Int_t * vAssign = Vec_IntAlloc( Vec_IntSize(vTodo) );
+    int pLoads[GIA_SWP_PROC_MAX] = {0}, pVotes[GIA_SWP_PROC_MAX];
+    int pNodes[6], nNodes, i, k, s, iPair, iBest, iLeast, Id;
+    Gia_Obj_t * pObj;
+    if ( p->vObj2Shard == NULL )
+        p->vObj2Shard = Vec_IntAlloc( Gia_ManObjNum(p->pGia) );
+    Vec_IntFill( p->vObj2Shard, Gia_ManObjNum(p->pGia), -1 );
+    Vec_IntForEachEntry( vTodo, iPair, i )
+    {
+        // collect the nodes and their fanins
+        nNodes = 0;
+        for ( k = 0; k < 2; k++ )
+        {
+            Id = Abc_Lit2Var( Vec_IntEntry(vLits, 2*iPair+k) );
+            if ( Id == 0 )
+                continue;
+            pNodes[nNodes++] = Id;
+            pObj = Gia_ManObj( p->pGia, Id );
+            if ( !Gia_ObjIsAnd(pObj) )
+                continue;
+            pNodes[nNodes++] = Gia_ObjFaninId0( pObj, Id );
+            pNodes[nNodes++] = Gia_ObjFaninId1( pObj, Id );
+        }
+        // vote for the shards
+        for ( s = 0; s < nShards; s++ )
+            pVotes[s] = 0;
+        for ( k = 0; k < nNodes; k++ )
+        {
+            for ( s = 0; s < nShards; s++ )
+                pVotes[s] += 2 * Swp_ManShardHasObj( pShards[s], pNodes[k] );
+            if ( Vec_IntEntry(p->vObj2Shard, pNodes[k]) >= 0 )
+                pVotes[Vec_IntEntry(p->vObj2Shard, pNodes[k])]++;
+        }
+        iBest = iLeast = 0;
+        for ( s = 1; s < nShards; s++ )
+        {
+            if ( pVotes[iBest] < pVotes[s] )
+                iBest = s;
+            if ( pLoads[iLeast] > pLoads[s] )
+                iLeast = s;
+        }
+        if ( pVotes[iBest] == 0 || pLoads[iBest] > 2 * (i / nShards) + 16 )
+            iBest = iLeast;
+        pLoads[iBest]++;
+        Vec_IntPush( vAssign, iBest );
+        for ( k = 0; k < nNodes; k++ )
+            Vec_IntWriteEntry( p->vObj2Shard, pNodes[k], iBest );
+    }
+    return vAssign;
+}
+
+/**Function*************************************************************
+
+  Synopsis    [Solves the pairs using several shards.]
+
+  Description [Each shard is a separate solver with its own CNF, which is
+  kept between the batches. The first shard is the main solver.]
+               
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+#ifdef ABC_USE_PTHREADS
+
+typedef struct Swp_ThData_t_ Swp_ThData_t;
+struct Swp_ThData_t_
+{
+    Swp_Man_t *   pShard;       // the solver of this thread
+    Vec_Int_t *   vCondLits;    // the condition literals
+    Vec_Int_t *   vLits;        // the literals of all pairs
+    Vec_Int_t *   vPairs;       // the pairs solved by this thread
+    Vec_Int_t *   vStatus;      // the statuses of all pairs
+};
+static void * Swp_ManWorkerThread( void * pArg )
+{
+    Swp_ThData_t * pThData = (Swp_ThData_t *)pArg;
+    Swp_Man_t * p = pThData->pShard;
+    int i, iPair, RetValue;
+    Vec_IntForEachEntry( pThData->vPairs, iPair, i )
+    {
+        RetValue = Swp_ManCheckEquiv( p, pThData->vCondLits, Vec_IntEntry(pThData->vLits, 2*iPair), Vec_IntEntry(pThData->vLits, 2*iPair+1) );
+        Vec_IntWriteEntry( pThData->vStatus, iPair, RetValue );
+        if ( RetValue == 0 && p->vCexUser )
+            Swp_ManSimAddCex( p, p->vCexUser );
+    }
+    return NULL;
+}
+static void Swp_ManCheckEquivShards( Swp_Man_t * p, Vec_Int_t * vLits, Vec_Int_t * vTodo, Vec_Int_t * vStatus, int nShards )
+{
+    Swp_ThData_t ThData[GIA_SWP_PROC_MAX];
+    pthread_t WorkerThread[GIA_SWP_PROC_MAX];
+    Swp_Man_t * pShards[GIA_SWP_PROC_MAX], * pShard;
+    Vec_Int_t * vAssign;
+    int i, s, iPair, status;
+    // create the shards
+    if ( p->vShards == NULL )
+        p->vShards = Vec_PtrAlloc( nShards );
+    while ( Vec_PtrSize(p->vShards) < nShards - 1 )
+        Vec_PtrPush( p->vShards, Swp_ManAlloc(p->pGia) );
+    pShards[0] = p;
+    for ( s = 1; s < nShards; s++ )
+    {
+        pShards[s] = (Swp_Man_t *)Vec_PtrEntry( p->vShards, s-1 );
+        pShards[s]->nConfMax = p->nConfMax;
+        pShards[s]->nTimeOut = p->nTimeOut;
+    }
+    // distribute the pairs
+    vAssign = Swp_ManAssignShards( p, pShards, nShards, vLits, vTodo );
+    for ( s = 0; s < nShards; s++ )
+    {
+        ThData[s].pShard    = pShards[s];
+        ThData[s].vCondLits = p->vCondLits;
+        ThData[s].vLits     = vLits;
+        ThData[s].vPairs    = Vec_IntAlloc( 100 );
+        ThData[s].vStatus   = vStatus;
+    }
+    Vec_IntForEachEntry( vTodo, iPair, i )
+        Vec_IntPush( ThData[Vec_IntEntry(vAssign, i)].vPairs, iPair );
+    Vec_IntFree( vAssign );
+    // solve the pairs
+    for ( s = 1; s < nShards; s++ )
+    {
+        status = pthread_create( WorkerThread + s, NULL, Swp_ManWorkerThread, (void *)(ThData + s) );  
+        assert( status == 0 );
+    }
+    Swp_ManWorkerThread( (void *)ThData );
+    for ( s = 1; s < nShards; s++ )
+        pthread_join( WorkerThread[s], NULL );
+    // collect the results
+    for ( s = 0; s < nShards; s++ )
+        Vec_IntFree( ThData[s].vPairs );
+    for ( s = 1; s < nShards; s++ )
+    {
+        pShard = pShards[s];
+        Vec_IntAppend( p->vSimCexes, pShard->vSimCexes );
+        Vec_IntClear( pShard->vSimCexes );
+        p->nSimCexes      += pShard->nSimCexes;      pShard->nSimCexes      = 0;
+        p->nSatCalls      += pShard->nSatCalls;      pShard->nSatCalls      = 0;
+        p->nSatCallsSat   += pShard->nSatCallsSat;   pShard->nSatCallsSat   = 0;
+        p->nSatCallsUnsat += pShard->nSatCallsUnsat; pShard->nSatCallsUnsat = 0;
+        p->nSatCallsUndec += pShard->nSatCallsUndec; pShard->nSatCallsUndec = 0;
+        p->nSatProofs     += pShard->nSatProofs;     pShard->nSatProofs     = 0;
+        p->timeCnf        += pShard->timeCnf;        pShard->timeCnf        = 0;
+        p->timeSat        += pShard->timeSat;        pShard->timeSat        = 0;
+        p->timeSatSat     += pShard->timeSatSat;     pShard->timeSatSat     = 0;
+        p->timeSatUnsat   += pShard->timeSatUnsat;   pShard->timeSatUnsat   = 0;
+        p->timeSatUndec   += pShard->timeSatUndec;   pShard->timeSatUndec   = 0;
+    }
+    p->vCexUser = NULL;
+}
+
+#endif // pthreads are used
+
+/**Function*************************************************************
+
+  Synopsis    [Runs equivalence test for many pairs of probes.]
+
+  Description [The array contains pairs of probe IDs. Returns the array 
+  of statuses, one for each pair: 1 if the probes are equivalent under the
+  current conditions, 0 if they are not, -1 if undecided. Pairs disproved 
+  by simulation do not reach the solver. If nProcs > 1 and pthreads are 
+  available, the remaining pairs are solved by nProcs solver shards.]
+               
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+Vec_Int_t * Gia_SweeperCheckEquivBatch( Gia_Man_t * pGia, Vec_Int_t * vProbePairs, int nProcs )
+{
+    Swp_Man_t * p = (Swp_Man_t *)pGia->pData;
+    Vec_Int_t * vStatus = Vec_IntStartFull( Vec_IntSize(vProbePairs) / 2 );
+    Vec_Int_t * vLits   = Vec_IntAlloc( Vec_IntSize(vProbePairs) );
+    Vec_Int_t * vTodo   = Vec_IntAlloc( Vec_IntSize(vProbePairs) / 2 );
+    word pCare[GIA_SWP_SIM_WORDS];
+    int i, ProbeId, iLit0, iLit1, iPair, RetValue;
+    assert( Vec_IntSize(vProbePairs) % 2 == 0 );
+    Vec_IntForEachEntry( vProbePairs, ProbeId, i )
+        Vec_IntPush( vLits, Gia_SweeperProbeLit(pGia, ProbeId) );
+    // filter the pairs by simulation
+    Swp_ManCollectCondLits( p );
+    Swp_ManSimulate( p );
+    Swp_ManSimCare( p, p->vCondLits, pCare );
+    Vec_IntForEachEntryDouble( vLits, iLit0, iLit1, i )
+    {
+        if ( iLit0 != iLit1 && Swp_ManSimDiffer(p, pCare, iLit0, iLit1) )
+        {
+            Vec_IntWriteEntry( vStatus, i/2, 0 );
+            p->nSimFiltered++;
+        }
+        else
+            Vec_IntPush( vTodo, i/2 );
+    }
+    nProcs = Abc_MinInt( nProcs, GIA_SWP_PROC_MAX );
+#ifdef ABC_USE_PTHREADS
+    if ( nProcs > 1 && Vec_IntSize(vTodo) > 1 )
+    {
+        Swp_ManCheckEquivShards( p, vLits, vTodo, vStatus, nProcs );
+        Vec_IntFree( vTodo );
+        Vec_IntFree( vLits );
+        return vStatus;
+    }
+#endif
+    // solve the pairs, resimulating after several counter-examples are found
+    Vec_IntForEachEntry( vTodo, iPair, i )
+    {
+        iLit0 = Vec_IntEntry( vLits, 2*iPair );
+        iLit1 = Vec_IntEntry( vLits, 2*iPair+1 );
+        if ( p->nSimCexes >= 16 )
+        {
+            Swp_ManSimulate( p );
+            Swp_ManSimCare( p, p->vCondLits, pCare );
+            if ( iLit0 != iLit1 && Swp_ManSimDiffer(p, pCare, iLit0, iLit1) )
+            {
+                Vec_IntWriteEntry( vStatus, iPair, 0 );
+                p->nSimFiltered++;
+                continue;
+            }
+        }
+        RetValue = Swp_ManCheckEquiv( p, p->vCondLits, iLit0, iLit1 );
+        Vec_IntWriteEntry( vStatus, iPair, RetValue );
+        if ( RetValue == 0 && p->vCexUser )
+            Swp_ManSimAddCex( p, p->vCexUser );
+    }
+    p->vCexUser = NULL;
+    Vec_IntFree( vTodo );
+    Vec_IntFree( vLits );
+    return vStatus;
+}
 
 /**Function*************************************************************
 
@@ -1176,6 +1652,47 @@ Gia_Man_t * Gia_SweeperFraigTest( Gia_Man_t * pInit, int nWords, int nConfs, int
     return pGia;
 }
 
+/**Function*************************************************************
+
+  Synopsis    [Checks the output pairs of a dual-output miter.]
+
+  Description [Each pair of consecutive outputs is checked for equivalence
+  by the SAT sweeper using Gia_SweeperCheckEquivBatch(). Returns 1 if all
+  pairs are equivalent, 0 if some pair is not, -1 if undecided.]
+               
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+int Gia_SweeperCheckDualMiter( Gia_Man_t * pInit, int nConfs, int nProcs, int fVerbose )
+{
+    Gia_Man_t * p;
+    Gia_Obj_t * pObj;
+    Vec_Int_t * vPairs, * vStatus;
+    int i, Status, nCounts[3] = {0};
+    abctime clk = Abc_Clock();
+    assert( Gia_ManPoNum(pInit) % 2 == 0 );
+    p = Gia_ManDup( pInit );
+    Gia_SweeperStart( p );
+    Gia_SweeperSetConflictLimit( p, nConfs );
+    vPairs = Vec_IntAlloc( Gia_ManPoNum(p) );
+    Gia_ManForEachPo( p, pObj, i )
+        Vec_IntPush( vPairs, Gia_SweeperProbeCreate( p, Gia_ObjFaninLit0p(p, pObj) ) );
+    vStatus = Gia_SweeperCheckEquivBatch( p, vPairs, nProcs );
+    Vec_IntForEachEntry( vStatus, Status, i )
+        nCounts[Status + 1]++;
+    if ( fVerbose )
+        Gia_SweeperPrintStats( p );
+    printf( "Output pairs: Equivalent = %d.  Different = %d.  Undecided = %d.  ", nCounts[2], nCounts[1], nCounts[0] );
+    Abc_PrintTime( 1, "Time", Abc_Clock() - clk );
+    Vec_IntFree( vStatus );
+    Vec_IntFree( vPairs );
+    Gia_SweeperStop( p );
+    Gia_ManStop( p );
+    return nCounts[1] ? 0 : (nCounts[0] ? -1 : 1);
+}
+
 
 ////////////////////////////////////////////////////////////////////////
 ///                       END OF FILE                                ///
@@ -20,6 +20,19 @@
 
 #include "giaAig.h"
 #include "base/main/main.h"
+#include "misc/util/utilTruth.h"
+
+#ifdef ABC_USE_PTHREADS
+
+#ifdef _WIN32
+#include "../lib/pthread.h"
+#else
+#include <pthread.h>
+#include <sched.h>
+#include <unistd.h>
+#endif
+
+#endif
 
 ABC_NAMESPACE_IMPL_START
 
@@ -28,36 +41,64 @@ ABC_NAMESPACE_IMPL_START
 ///                        DECLARATIONS                              ///
 ////////////////////////////////////////////////////////////////////////
 
+#define SWI_PROC_MAX   64      // the max number of threads
+
+#define SWI_MASK_LO    ABC_CONST(0x0000FFFF0000FFFF)  // current values in the transition mode
+#define SWI_MASK_HI    ABC_CONST(0xFFFF0000FFFF0000)  // previous values in the transition mode
+
 // switching estimation parameters
 typedef struct Gia_ParSwi_t_ Gia_ParSwi_t;
 struct Gia_ParSwi_t_
 {
     // user-controlled parameters
-    int            nWords;       // the number of machine words
+    int            nWords;       // the number of 32-bit machine words
     int            nIters;       // the number of timeframes
     int            nPref;        // the number of first timeframes to skip
     int            nRandPiFactor;   // PI trans prob (-1=3/8; 0=1/2; 1=1/4; 2=1/8, etc)
     int            fProbOne;     // collect probability of one
     int            fProbTrans;   // collect probatility of Swiing
+    int            nProcs;       // the number of threads
+    int            TimeLimit;    // keep simulating until this many seconds are used
+    Vec_Flt_t *    vPiProbs;     // probability of 1 of each PI (negative means random transitions)
+    Vec_Wrd_t *    vTrace;       // input stimulus (bit i of each PI is its value in cycle i)
     int            fVerbose;     // enables verbose output
 };
 
 typedef struct Gia_ManSwi_t_ Gia_ManSwi_t;
+
+// range of simulation words processed by one thread
+typedef struct Gia_SwiRange_t_ Gia_SwiRange_t;
+struct Gia_SwiRange_t_
+{
+    Gia_ManSwi_t * p;            // switching manager
+    int            wStart;       // the first word of the range
+    int            wStop;        // the word following the last one
+    int            fCount;       // collect switching data in this round
+    int            fStop;        // the thread should terminate
+    int *          pData1;       // switching data of this range
+    int            fWorking;     // the range is being simulated
+};
+
 struct Gia_ManSwi_t_
 {
     Gia_Man_t *    pAig;
     Gia_ParSwi_t * pPars; 
-    int            nWords;
+    int            nWords;       // the number of 64-bit words
+    int            nProcs;       // the number of word ranges
+    int            nTraceWords;  // the number of stimulus words of each PI
+    int            nFrames;      // the number of timeframes with collected switching data
     // simulation information
-    unsigned *     pDataSim;     // simulation data
-    unsigned *     pDataSimCis;  // simulation data for CIs
-    unsigned *     pDataSimCos;  // simulation data for COs
+    word *         pDataSim;     // simulation data
+    word *         pDataSimCis;  // simulation data for CIs
+    word *         pDataSimCos;  // simulation data for COs
+    word *         pDataTemp;    // new values of one PI
     int *          pData1;       // switching data
+    Gia_SwiRange_t Ranges[SWI_PROC_MAX];
 };
 
-static inline unsigned * Gia_SwiData( Gia_ManSwi_t * p, int i )    { return p->pDataSim + i * p->nWords;    }
-static inline unsigned * Gia_SwiDataCi( Gia_ManSwi_t * p, int i )  { return p->pDataSimCis + i * p->nWords; }
-static inline unsigned * Gia_SwiDataCo( Gia_ManSwi_t * p, int i )  { return p->pDataSimCos + i * p->nWords; }
+static inline word * Gia_SwiData( Gia_ManSwi_t * p, int i )    { return p->pDataSim + i * p->nWords;    }
+static inline word * Gia_SwiDataCi( Gia_ManSwi_t * p, int i )  { return p->pDataSimCis + i * p->nWords; }
+static inline word * Gia_SwiDataCo( Gia_ManSwi_t * p, int i )  { return p->pDataSimCos + i * p->nWords; }
 
 ////////////////////////////////////////////////////////////////////////
 ///                     FUNCTION DEFINITIONS                         ///
@@ -83,6 +124,10 @@ void Gia_ManSetDefaultParamsSwi( Gia_ParSwi_t * p )
     p->nRandPiFactor =   0;  // primary input transition probability (-1=3/8; 0=1/2; 1=1/4; 2=1/8, etc)
     p->fProbOne      =   0;  // compute probability of signal being one (if 0, compute probability of switching)
     p->fProbTrans    =   1;  // compute signal transition probability (if 0, compute transition probability using probability of being one)
+    p->nProcs        =   1;  // the number of threads
+    p->TimeLimit     =   0;  // the runtime budget in seconds (0 = simulate the given number of timeframes)
+    p->vPiProbs      = NULL; // probability of 1 of each PI
+    p->vTrace        = NULL; // input stimulus
     p->fVerbose      =   0;  // enables verbose output
 }
 
@@ -90,7 +135,7 @@ void Gia_ManSetDefaultParamsSwi( Gia_ParSwi_t * p )
 
   Synopsis    [Creates fast simulation manager.]
 
-  Description []
+  Description [The simulation words are split into ranges, one per thread.]
                
   SideEffects []
 
@@ -100,15 +145,27 @@ void Gia_ManSetDefaultParamsSwi( Gia_ParSwi_t * p )
 Gia_ManSwi_t * Gia_ManSwiCreate( Gia_Man_t * pAig, Gia_ParSwi_t * pPars )
 {
     Gia_ManSwi_t * p;
+    int i;
     p = ABC_ALLOC( Gia_ManSwi_t, 1 );
     memset( p, 0, sizeof(Gia_ManSwi_t) );
     p->pAig   = Gia_ManFront( pAig );
     p->pPars  = pPars;
-    p->nWords = pPars->nWords;
-    p->pDataSim = ABC_ALLOC( unsigned, p->nWords * p->pAig->nFront );
-    p->pDataSimCis = ABC_ALLOC( unsigned, p->nWords * Gia_ManCiNum(p->pAig) );
-    p->pDataSimCos = ABC_ALLOC( unsigned, p->nWords * Gia_ManCoNum(p->pAig) );
+    p->nWords = (pPars->nWords + 1) / 2;
+    p->nProcs = Abc_MaxInt( 1, Abc_MinInt(Abc_MinInt(pPars->nProcs, SWI_PROC_MAX), p->nWords) );
+    if ( pPars->vTrace )
+        p->nTraceWords = Vec_WrdSize(pPars->vTrace) / Gia_ManPiNum(pAig);
+    p->pDataSim = ABC_ALLOC( word, p->nWords * p->pAig->nFront );
+    p->pDataSimCis = ABC_ALLOC( word, p->nWords * Gia_ManCiNum(p->pAig) );
+    p->pDataSimCos = ABC_ALLOC( word, p->nWords * Gia_ManCoNum(p->pAig) );
+    p->pDataTemp = ABC_ALLOC( word, p->nWords );
     p->pData1 = ABC_CALLOC( int, Gia_ManObjNum(pAig) );
+    for ( i = 0; i < p->nProcs; i++ )
+    {
+        p->Ranges[i].p      = p;
+        p->Ranges[i].wStart = i * p->nWords / p->nProcs;
+        p->Ranges[i].wStop  = (i + 1) * p->nWords / p->nProcs;
+        p->Ranges[i].pData1 = i ? ABC_CALLOC( int, Gia_ManObjNum(pAig) ) : p->pData1;
+    }
     return p;
 }
 
@@ -125,51 +182,80 @@ Gia_ManSwi_t * Gia_ManSwiCreate( Gia_Man_t * pAig, Gia_ParSwi_t * pPars )
 ***********************************************************************/
 void Gia_ManSwiDelete( Gia_ManSwi_t * p )
 {
+    int i;
+    for ( i = 1; i < p->nProcs; i++ )
+        ABC_FREE( p->Ranges[i].pData1 );
     Gia_ManStop( p->pAig );
     ABC_FREE( p->pData1 );
     ABC_FREE( p->pDataSim );
     ABC_FREE( p->pDataSimCis );
     ABC_FREE( p->pDataSimCos );
+    ABC_FREE( p->pDataTemp );
     ABC_FREE( p );
 }
 
 /**Function*************************************************************
 
-  Synopsis    []
+  Synopsis    [Random 64-bit word.]
 
-  Description []
+  Description [The upper half is generated first, so that the random 
+  values land in the same patterns as in the 32-bit simulator.]
                
   SideEffects []
 
   SeeAlso     []
 
 ***********************************************************************/
-static inline void Gia_ManSwiSimInfoRandom( Gia_ManSwi_t * p, unsigned * pInfo, int nProbNum )
+static inline word Gia_ManSwiRandomWord()
+{
+    word Hi = (word)Gia_ManRandom( 0 );
+    return (Hi << 32) | (word)Gia_ManRandom( 0 );
+}
+static inline word Gia_ManSwiRandomMask( int nProbNum )
 {
     unsigned Mask = 0;
-    int w, i;
+    int i;
     if ( nProbNum == -1 )
     { // 3/8 = 1/4 + 1/8
         Mask = (Gia_ManRandom( 0 ) & Gia_ManRandom( 0 )) | 
                (Gia_ManRandom( 0 ) & Gia_ManRandom( 0 ) & Gia_ManRandom( 0 ));
-        for ( w = p->nWords-1; w >= 0; w-- )
-            pInfo[w] ^= Mask;
     }
-    else if ( nProbNum > 0 )
+    else if ( nProbNum >= 0 )
     {
         Mask = Gia_ManRandom( 0 );
         for ( i = 0; i < nProbNum; i++ )
             Mask &= Gia_ManRandom( 0 );
-        for ( w = p->nWords-1; w >= 0; w-- )
-            pInfo[w] ^= Mask;
-    }
-    else if ( nProbNum == 0 )
-    {
-        for ( w = p->nWords-1; w >= 0; w-- )
-            pInfo[w] = Gia_ManRandom( 0 );
     }
     else
         assert( 0 );
+    return ((word)Mask << 32) | (word)Mask;
+}
+
+/**Function*************************************************************
+
+  Synopsis    [Random word with the given probability of 1 in each bit.]
+
+  Description [The probability is Thresh/256. Each step ORs (for bit 1 
+  of the threshold) or ANDs (for bit 0) the result with a random word, 
+  starting from the least significant bit of the threshold.]
+               
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+static inline word Gia_ManSwiRandomProb( int Thresh )
+{
+    word Res = 0;
+    int b;
+    if ( Thresh >= 256 )
+        return ~(word)0;
+    for ( b = 0; b < 8; b++ )
+        if ( (Thresh >> b) & 1 )
+            Res |= Gia_ManSwiRandomWord();
+        else
+            Res &= Gia_ManSwiRandomWord();
+    return Res;
 }
 
 /**Function*************************************************************
@@ -183,25 +269,19 @@ static inline void Gia_ManSwiSimInfoRandom( Gia_ManSwi_t * p, unsigned * pInfo,
   SeeAlso     []
 
 ***********************************************************************/
-static inline void Gia_ManSwiSimInfoRandomShift( Gia_ManSwi_t * p, unsigned * pInfo, int nProbNum )
+static inline void Gia_ManSwiSimInfoRandom( Gia_ManSwi_t * p, word * pInfo, int nProbNum )
 {
-    unsigned Mask = 0;
-    int w, i;
-    if ( nProbNum == -1 )
-    { // 3/8 = 1/4 + 1/8
-        Mask = (Gia_ManRandom( 0 ) & Gia_ManRandom( 0 )) | 
-               (Gia_ManRandom( 0 ) & Gia_ManRandom( 0 ) & Gia_ManRandom( 0 ));
-    }
-    else if ( nProbNum >= 0 )
+    word Mask;
+    int w;
+    if ( nProbNum == 0 )
     {
-        Mask = Gia_ManRandom( 0 );
-        for ( i = 0; i < nProbNum; i++ )
-            Mask &= Gia_ManRandom( 0 );
+        for ( w = p->nWords-1; w >= 0; w-- )
+            pInfo[w] = Gia_ManSwiRandomWord();
+        return;
     }
-    else
-        assert( 0 );
+    Mask = Gia_ManSwiRandomMask( nProbNum );
     for ( w = p->nWords-1; w >= 0; w-- )
-        pInfo[w] = (pInfo[w] << 16) | ((pInfo[w] ^ Mask) & 0xffff);
+        pInfo[w] ^= Mask;
 }
 
 /**Function*************************************************************
@@ -215,11 +295,12 @@ static inline void Gia_ManSwiSimInfoRandomShift( Gia_ManSwi_t * p, unsigned * pI
   SeeAlso     []
 
 ***********************************************************************/
-static inline void Gia_ManSwiSimInfoZero( Gia_ManSwi_t * p, unsigned * pInfo )
+static inline void Gia_ManSwiSimInfoRandomShift( Gia_ManSwi_t * p, word * pInfo, int nProbNum )
 {
+    word Mask = Gia_ManSwiRandomMask( nProbNum );
     int w;
     for ( w = p->nWords-1; w >= 0; w-- )
-        pInfo[w] = 0;
+        pInfo[w] = ((pInfo[w] << 16) & SWI_MASK_HI) | ((pInfo[w] ^ Mask) & SWI_MASK_LO);
 }
 
 /**Function*************************************************************
@@ -233,11 +314,11 @@ static inline void Gia_ManSwiSimInfoZero( Gia_ManSwi_t * p, unsigned * pInfo )
   SeeAlso     []
 
 ***********************************************************************/
-static inline void Gia_ManSwiSimInfoOne( Gia_ManSwi_t * p, unsigned * pInfo )
+static inline void Gia_ManSwiSimInfoZero( Gia_ManSwi_t * p, word * pInfo )
 {
     int w;
     for ( w = p->nWords-1; w >= 0; w-- )
-        pInfo[w] = ~0;
+        pInfo[w] = 0;
 }
 
 /**Function*************************************************************
@@ -251,7 +332,7 @@ static inline void Gia_ManSwiSimInfoOne( Gia_ManSwi_t * p, unsigned * pInfo )
   SeeAlso     []
 
 ***********************************************************************/
-static inline void Gia_ManSwiSimInfoCopy( Gia_ManSwi_t * p, unsigned * pInfo, unsigned * pInfo0 )
+static inline void Gia_ManSwiSimInfoCopy( Gia_ManSwi_t * p, word * pInfo, word * pInfo0 )
 {
     int w;
     for ( w = p->nWords-1; w >= 0; w-- )
@@ -269,11 +350,96 @@ static inline void Gia_ManSwiSimInfoCopy( Gia_ManSwi_t * p, unsigned * pInfo, un
   SeeAlso     []
 
 ***********************************************************************/
-static inline void Gia_ManSwiSimInfoCopyShift( Gia_ManSwi_t * p, unsigned * pInfo, unsigned * pInfo0 )
+static inline void Gia_ManSwiSimInfoCopyShift( Gia_ManSwi_t * p, word * pInfo, word * pInfo0 )
 {
     int w;
     for ( w = p->nWords-1; w >= 0; w-- )
-        pInfo[w] = (pInfo[w] << 16) | (pInfo0[w] & 0xffff);
+        pInfo[w] = ((pInfo[w] << 16) & SWI_MASK_HI) | (pInfo0[w] & SWI_MASK_LO);
+}
+
+/**Function*************************************************************
+
+  Synopsis    [Derives the values of the PI from the user's stimulus.]
+
+  Description [Each simulation pattern (lane) follows its own segment of 
+  the stimulus: lane k in frame f takes the value in cycle k*nIters+f, so 
+  that consecutive frames of a lane see consecutive cycles. If the PI has 
+  probability of 1 given instead, its values are drawn independently in 
+  each frame. Returns 0 if the PI should be simulated randomly.]
+               
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+static inline int Gia_ManSwiSimInfoStimulus( Gia_ManSwi_t * p, int iPi, int iFrame, word * pInfo )
+{
+    Gia_ParSwi_t * pPars = p->pPars;
+    if ( pPars->vTrace && p->nTraceWords > 0 )
+    {
+        word * pTrace = Vec_WrdEntryP( pPars->vTrace, iPi * p->nTraceWords );
+        word nCycles = 64 * (word)p->nTraceWords;
+        int nLanes = pPars->fProbTrans ? 32 : 64;
+        int w, k, iLane;
+        for ( w = 0; w < p->nWords; w++ )
+        {
+            pInfo[w] = 0;
+            for ( k = 0; k < nLanes; k++ )
+            {
+                iLane = w * nLanes + k;
+                if ( Abc_TtGetBit( pTrace, (int)(((word)iLane * pPars->nIters + iFrame) % nCycles) ) )
+                    pInfo[w] |= (word)1 << (pPars->fProbTrans ? 2 * (k & 16) + (k & 15) : k);
+            }
+        }
+        return 1;
+    }
+    if ( pPars->vPiProbs && Vec_FltEntry(pPars->vPiProbs, iPi) >= 0 )
+    {
+        int w, Thresh = (int)(256 * Vec_FltEntry(pPars->vPiProbs, iPi) + 0.5);
+        for ( w = p->nWords-1; w >= 0; w-- )
+            pInfo[w] = Gia_ManSwiRandomProb( Thresh );
+        return 1;
+    }
+    return 0;
+}
+
+/**Function*************************************************************
+
+  Synopsis    [Sets the values of the PI in the given frame.]
+
+  Description []
+               
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+static inline void Gia_ManSwiSimInfoPi( Gia_ManSwi_t * p, int iPi, int iFrame, int nProbNum )
+{
+    word * pInfo = Gia_SwiDataCi( p, iPi );
+    word * pTemp = p->pDataTemp;
+    int w;
+    if ( !Gia_ManSwiSimInfoStimulus( p, iPi, iFrame, pTemp ) )
+    {
+        if ( iFrame == 0 )
+            Gia_ManSwiSimInfoRandom( p, pInfo, 0 );
+        else if ( p->pPars->fProbTrans )
+            Gia_ManSwiSimInfoRandomShift( p, pInfo, nProbNum );
+        else
+            Gia_ManSwiSimInfoRandom( p, pInfo, nProbNum );
+    }
+    else if ( iFrame == 0 && p->pPars->fProbTrans )
+    {
+        for ( w = 0; w < p->nWords; w++ )
+            pInfo[w] = (pTemp[w] & SWI_MASK_LO) | ((pTemp[w] & SWI_MASK_LO) << 16);
+    }
+    else if ( p->pPars->fProbTrans )
+    {
+        for ( w = 0; w < p->nWords; w++ )
+            pInfo[w] = ((pInfo[w] << 16) & SWI_MASK_HI) | (pTemp[w] & SWI_MASK_LO);
+    }
+    else
+        Gia_ManSwiSimInfoCopy( p, pInfo, pTemp );
 }
 
 /**Function*************************************************************
@@ -287,12 +453,12 @@ static inline void Gia_ManSwiSimInfoCopyShift( Gia_ManSwi_t * p, unsigned * pInf
   SeeAlso     []
 
 ***********************************************************************/
-static inline void Gia_ManSwiSimulateCi( Gia_ManSwi_t * p, Gia_Obj_t * pObj, int iCi )
+static inline void Gia_ManSwiSimulateCi( Gia_ManSwi_t * p, Gia_Obj_t * pObj, int iCi, int wStart, int wStop )
 {
-    unsigned * pInfo  = Gia_SwiData( p, Gia_ObjValue(pObj) );
-    unsigned * pInfo0 = Gia_SwiDataCi( p, iCi );
+    word * pInfo  = Gia_SwiData( p, Gia_ObjValue(pObj) );
+    word * pInfo0 = Gia_SwiDataCi( p, iCi );
     int w;
-    for ( w = p->nWords-1; w >= 0; w-- )
+    for ( w = wStart; w < wStop; w++ )
         pInfo[w] = pInfo0[w];
 }
 
@@ -307,16 +473,16 @@ static inline void Gia_ManSwiSimulateCi( Gia_ManSwi_t * p, Gia_Obj_t * pObj, int
   SeeAlso     []
 
 ***********************************************************************/
-static inline void Gia_ManSwiSimulateCo( Gia_ManSwi_t * p, int iCo, Gia_Obj_t * pObj )
+static inline void Gia_ManSwiSimulateCo( Gia_ManSwi_t * p, int iCo, Gia_Obj_t * pObj, int wStart, int wStop )
 {
-    unsigned * pInfo  = Gia_SwiDataCo( p, iCo );
-    unsigned * pInfo0 = Gia_SwiData( p, Gia_ObjDiff0(pObj) );
+    word * pInfo  = Gia_SwiDataCo( p, iCo );
+    word * pInfo0 = Gia_SwiData( p, Gia_ObjDiff0(pObj) );
     int w;
     if ( Gia_ObjFaninC0(pObj) )
-        for ( w = p->nWords-1; w >= 0; w-- )
+        for ( w = wStart; w < wStop; w++ )
             pInfo[w] = ~pInfo0[w];
     else 
-        for ( w = p->nWords-1; w >= 0; w-- )
+        for ( w = wStart; w < wStop; w++ )
             pInfo[w] = pInfo0[w];
 }
 
@@ -331,28 +497,28 @@ static inline void Gia_ManSwiSimulateCo( Gia_ManSwi_t * p, int iCo, Gia_Obj_t *
   SeeAlso     []
 
 ***********************************************************************/
-static inline void Gia_ManSwiSimulateNode( Gia_ManSwi_t * p, Gia_Obj_t * pObj )
+static inline void Gia_ManSwiSimulateNode( Gia_ManSwi_t * p, Gia_Obj_t * pObj, int wStart, int wStop )
 {
-    unsigned * pInfo  = Gia_SwiData( p, Gia_ObjValue(pObj) );
-    unsigned * pInfo0 = Gia_SwiData( p, Gia_ObjDiff0(pObj) );
-    unsigned * pInfo1 = Gia_SwiData( p, Gia_ObjDiff1(pObj) );
+    word * pInfo  = Gia_SwiData( p, Gia_ObjValue(pObj) );
+    word * pInfo0 = Gia_SwiData( p, Gia_ObjDiff0(pObj) );
+    word * pInfo1 = Gia_SwiData( p, Gia_ObjDiff1(pObj) );
     int w;
     if ( Gia_ObjFaninC0(pObj) )
     {
         if (  Gia_ObjFaninC1(pObj) )
-            for ( w = p->nWords-1; w >= 0; w-- )
+            for ( w = wStart; w < wStop; w++ )
                 pInfo[w] = ~(pInfo0[w] | pInfo1[w]);
         else 
-            for ( w = p->nWords-1; w >= 0; w-- )
+            for ( w = wStart; w < wStop; w++ )
                 pInfo[w] = ~pInfo0[w] & pInfo1[w];
     }
     else 
     {
         if (  Gia_ObjFaninC1(pObj) )
-            for ( w = p->nWords-1; w >= 0; w-- )
+            for ( w = wStart; w < wStop; w++ )
                 pInfo[w] = pInfo0[w] & ~pInfo1[w];
         else 
-            for ( w = p->nWords-1; w >= 0; w-- )
+            for ( w = wStart; w < wStop; w++ )
                 pInfo[w] = pInfo0[w] & pInfo1[w];
     }
 }
@@ -372,7 +538,7 @@ static inline void Gia_ManSwiSimInfoInit( Gia_ManSwi_t * p )
 {
     int i = 0;
     for ( ; i < Gia_ManPiNum(p->pAig); i++ )
-        Gia_ManSwiSimInfoRandom( p, Gia_SwiDataCi(p, i), 0 );
+        Gia_ManSwiSimInfoPi( p, i, 0, 0 );
     for ( ; i < Gia_ManCiNum(p->pAig); i++ )
         Gia_ManSwiSimInfoZero( p, Gia_SwiDataCi(p, i) );
 }
@@ -388,33 +554,16 @@ static inline void Gia_ManSwiSimInfoInit( Gia_ManSwi_t * p )
   SeeAlso     []
 
 ***********************************************************************/
-static inline void Gia_ManSwiSimInfoTransfer( Gia_ManSwi_t * p, int nProbNum )
+static inline void Gia_ManSwiSimInfoTransfer( Gia_ManSwi_t * p, int nProbNum, int iFrame )
 {
     int i = 0, nShift = Gia_ManPoNum(p->pAig)-Gia_ManPiNum(p->pAig);
     for ( ; i < Gia_ManPiNum(p->pAig); i++ )
-        Gia_ManSwiSimInfoRandom( p, Gia_SwiDataCi(p, i), nProbNum );
+        Gia_ManSwiSimInfoPi( p, i, iFrame, nProbNum );
     for ( ; i < Gia_ManCiNum(p->pAig); i++ )
-        Gia_ManSwiSimInfoCopy( p, Gia_SwiDataCi(p, i), Gia_SwiDataCo(p, nShift+i) );
-}
-
-/**Function*************************************************************
-
-  Synopsis    []
-
-  Description []
-               
-  SideEffects []
-
-  SeeAlso     []
-
-***********************************************************************/
-static inline void Gia_ManSwiSimInfoTransferShift( Gia_ManSwi_t * p, int nProbNum )
-{
-    int i = 0, nShift = Gia_ManPoNum(p->pAig)-Gia_ManPiNum(p->pAig);
-    for ( ; i < Gia_ManPiNum(p->pAig); i++ )
-        Gia_ManSwiSimInfoRandomShift( p, Gia_SwiDataCi(p, i), nProbNum );
-    for ( ; i < Gia_ManCiNum(p->pAig); i++ )
-        Gia_ManSwiSimInfoCopyShift( p, Gia_SwiDataCi(p, i), Gia_SwiDataCo(p, nShift+i) );
+        if ( p->pPars->fProbTrans )
+            Gia_ManSwiSimInfoCopyShift( p, Gia_SwiDataCi(p, i), Gia_SwiDataCo(p, nShift+i) );
+        else
+            Gia_ManSwiSimInfoCopy( p, Gia_SwiDataCi(p, i), Gia_SwiDataCo(p, nShift+i) );
 }
 
 /**Function*************************************************************
@@ -428,13 +577,13 @@ static inline void Gia_ManSwiSimInfoTransferShift( Gia_ManSwi_t * p, int nProbNu
   SeeAlso     []
 
 ***********************************************************************/
-static inline int Gia_ManSwiSimInfoCountOnes( Gia_ManSwi_t * p, int iPlace )
+static inline int Gia_ManSwiSimInfoCountOnes( Gia_ManSwi_t * p, int iPlace, int wStart, int wStop )
 {
-    unsigned * pInfo;
+    word * pInfo;
     int w, Counter = 0;
     pInfo = Gia_SwiData( p, iPlace );
-    for ( w = p->nWords-1; w >= 0; w-- )
-        Counter += Gia_WordCountOnes( pInfo[w] );
+    for ( w = wStart; w < wStop; w++ )
+        Counter += Abc_TtCountOnes( pInfo[w] );
     return Counter;
 }
 
@@ -449,19 +598,19 @@ static inline int Gia_ManSwiSimInfoCountOnes( Gia_ManSwi_t * p, int iPlace )
   SeeAlso     []
 
 ***********************************************************************/
-static inline int Gia_ManSwiSimInfoCountTrans( Gia_ManSwi_t * p, int iPlace )
+static inline int Gia_ManSwiSimInfoCountTrans( Gia_ManSwi_t * p, int iPlace, int wStart, int wStop )
 {
-    unsigned * pInfo;
+    word * pInfo;
     int w, Counter = 0;
     pInfo = Gia_SwiData( p, iPlace );
-    for ( w = p->nWords-1; w >= 0; w-- )
-        Counter += 2*Gia_WordCountOnes( (pInfo[w] ^ (pInfo[w] >> 16)) & 0xffff );
+    for ( w = wStart; w < wStop; w++ )
+        Counter += 2*Abc_TtCountOnes( (pInfo[w] ^ (pInfo[w] >> 16)) & SWI_MASK_LO );
     return Counter;
 }
 
 /**Function*************************************************************
 
-  Synopsis    []
+  Synopsis    [Simulates one timeframe for the range of words.]
 
   Description []
                
@@ -470,42 +619,97 @@ static inline int Gia_ManSwiSimInfoCountTrans( Gia_ManSwi_t * p, int iPlace )
   SeeAlso     []
 
 ***********************************************************************/
-static inline void Gia_ManSwiSimulateRound( Gia_ManSwi_t * p, int fCount )
+static void Gia_ManSwiSimulateRange( Gia_SwiRange_t * pRange )
 {
+    Gia_ManSwi_t * p = pRange->p;
     Gia_Obj_t * pObj;
-    int i;//, iCis = 0, iCos = 0;
+    int i, w, wStart = pRange->wStart, wStop = pRange->wStop;
     assert( p->pAig->nFront > 0 );
     assert( Gia_ManConst0(p->pAig)->Value == 0 );
-    Gia_ManSwiSimInfoZero( p, Gia_SwiData(p, 0) );
+    for ( w = wStart; w < wStop; w++ )
+        Gia_SwiData(p, 0)[w] = 0;
     Gia_ManForEachObj1( p->pAig, pObj, i )
     {
         if ( Gia_ObjIsAndOrConst0(pObj) )
         {
             assert( Gia_ObjValue(pObj) < p->pAig->nFront );
-            Gia_ManSwiSimulateNode( p, pObj );
+            Gia_ManSwiSimulateNode( p, pObj, wStart, wStop );
         }
         else if ( Gia_ObjIsCo(pObj) )
         {
             assert( Gia_ObjValue(pObj) == GIA_NONE );
-//            Gia_ManSwiSimulateCo( p, iCos++, pObj );
-            Gia_ManSwiSimulateCo( p, Gia_ObjCioId(pObj), pObj );
+            Gia_ManSwiSimulateCo( p, Gia_ObjCioId(pObj), pObj, wStart, wStop );
         }
         else // if ( Gia_ObjIsCi(pObj) )
         {
             assert( Gia_ObjValue(pObj) < p->pAig->nFront );
-//            Gia_ManSwiSimulateCi( p, pObj, iCis++ );
-            Gia_ManSwiSimulateCi( p, pObj, Gia_ObjCioId(pObj) );
+            Gia_ManSwiSimulateCi( p, pObj, Gia_ObjCioId(pObj), wStart, wStop );
         }
-        if ( fCount && !Gia_ObjIsCo(pObj) )
+        if ( pRange->fCount && !Gia_ObjIsCo(pObj) )
         {
             if ( p->pPars->fProbTrans )
-                p->pData1[i] += Gia_ManSwiSimInfoCountTrans( p, Gia_ObjValue(pObj) );
+                pRange->pData1[i] += Gia_ManSwiSimInfoCountTrans( p, Gia_ObjValue(pObj), wStart, wStop );
             else 
-                p->pData1[i] += Gia_ManSwiSimInfoCountOnes( p, Gia_ObjValue(pObj) );
+                pRange->pData1[i] += Gia_ManSwiSimInfoCountOnes( p, Gia_ObjValue(pObj), wStart, wStop );
+        }
+    }
+}
+
+#ifdef ABC_USE_PTHREADS
+
+void * Gia_ManSwiWorkerThread( void * pArg )
+{
+    Gia_SwiRange_t * pRange = (Gia_SwiRange_t *)pArg;
+    volatile int * pPlace = &pRange->fWorking;
+    while ( 1 )
+    {
+        while ( *pPlace == 0 )
+            sched_yield();
+        assert( pRange->fWorking );
+        if ( pRange->fStop )
+        {
+            pthread_exit( NULL );
+            assert( 0 );
+            return NULL;
         }
+        Gia_ManSwiSimulateRange( pRange );
+        pRange->fWorking = 0;
     }
-//    assert( Gia_ManCiNum(p->pAig) == iCis );
-//    assert( Gia_ManCoNum(p->pAig) == iCos );
+    assert( 0 );
+    return NULL;
+}
+
+#endif // pthreads are used
+
+/**Function*************************************************************
+
+  Synopsis    [Simulates one timeframe.]
+
+  Description [The ranges of words are simulated by the threads, if any.]
+               
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+static void Gia_ManSwiSimulateRound( Gia_ManSwi_t * p, int fCount )
+{
+    int i;
+    for ( i = 0; i < p->nProcs; i++ )
+        p->Ranges[i].fCount = fCount;
+#ifdef ABC_USE_PTHREADS
+    if ( p->nProcs > 1 )
+    {
+        for ( i = 0; i < p->nProcs; i++ )
+            p->Ranges[i].fWorking = 1;
+        for ( i = 0; i < p->nProcs; i++ )
+            while ( ((volatile int *)&p->Ranges[i].fWorking)[0] )
+                sched_yield();
+        return;
+    }
+#endif
+    for ( i = 0; i < p->nProcs; i++ )
+        Gia_ManSwiSimulateRange( p->Ranges + i );
 }
 
 /**Function*************************************************************
@@ -546,7 +750,8 @@ float Gia_ManSwiComputeProbOne( int nOnes, int nSimWords )
 
   Synopsis    []
 
-  Description []
+  Description [Simulates pPars->nIters timeframes, or more if the time 
+  budget is given and not yet used up.]
                
   SideEffects []
 
@@ -559,39 +764,70 @@ Vec_Int_t * Gia_ManSwiSimulate( Gia_Man_t * pAig, Gia_ParSwi_t * pPars )
     Gia_Obj_t * pObj;
     Vec_Int_t * vSwitching;
     float * pSwitching;
-    int i;
+    int i, k, nSimWords, nFramesMax;
     abctime clk, clkTotal = Abc_Clock();
+    abctime clkStop = pPars->TimeLimit ? (abctime)pPars->TimeLimit * CLOCKS_PER_SEC + Abc_Clock() : 0;
+#ifdef ABC_USE_PTHREADS
+    pthread_t WorkerThread[SWI_PROC_MAX];
+    int status;
+#endif
     if ( pPars->fProbOne && pPars->fProbTrans )
         printf( "Conflict of options: Can either compute probability of 1, or probability of switching by observing transitions.\n" );
     // create manager
     clk = Abc_Clock();
     p = Gia_ManSwiCreate( pAig, pPars );
+    // the number of frames that does not overflow the counters
+    nFramesMax = ABC_INFINITY / (64 * p->nWords);
     if ( pPars->fVerbose )
     {
         printf( "Obj = %8d (%8d). F = %6d. ", 
             pAig->nObjs, Gia_ManCiNum(pAig) + Gia_ManAndNum(pAig), p->pAig->nFront );
         printf( "AIG = %7.2f MB. F-mem = %7.2f MB. Other = %7.2f MB.  ", 
             12.0*Gia_ManObjNum(p->pAig)/(1<<20), 
-            4.0*p->nWords*p->pAig->nFront/(1<<20), 
-            4.0*p->nWords*(Gia_ManCiNum(p->pAig) + Gia_ManCoNum(p->pAig))/(1<<20) );
+            8.0*p->nWords*p->pAig->nFront/(1<<20), 
+            8.0*p->nWords*(Gia_ManCiNum(p->pAig) + Gia_ManCoNum(p->pAig))/(1<<20) );
         ABC_PRT( "Time", Abc_Clock() - clk );
     }
+#ifdef ABC_USE_PTHREADS
+    if ( p->nProcs > 1 )
+    for ( i = 0; i < p->nProcs; i++ )
+    {
+        p->Ranges[i].fWorking = 0;
+        status = pthread_create( WorkerThread + i, NULL, Gia_ManSwiWorkerThread, (void *)(p->Ranges + i) );  assert( status == 0 );
+    }
+#endif
     // perform simulation
     Gia_ManRandom( 1 );
     Gia_ManSwiSimInfoInit( p );
-    for ( i = 0; i < pPars->nIters; i++ )
+    for ( i = 0; ; i++ )
     {
         Gia_ManSwiSimulateRound( p, i >= pPars->nPref );
-        if ( i == pPars->nIters - 1 )
+        p->nFrames += (int)(i >= pPars->nPref);
+        if ( i >= pPars->nIters - 1 && (clkStop == 0 || Abc_Clock() > clkStop || p->nFrames >= nFramesMax) )
             break;
-        if ( pPars->fProbTrans )
-            Gia_ManSwiSimInfoTransferShift( p, pPars->nRandPiFactor );
-        else
-            Gia_ManSwiSimInfoTransfer( p, pPars->nRandPiFactor );
+        Gia_ManSwiSimInfoTransfer( p, pPars->nRandPiFactor, i + 1 );
+    }
+#ifdef ABC_USE_PTHREADS
+    // stop the threads
+    if ( p->nProcs > 1 )
+    for ( k = 0; k < p->nProcs; k++ )
+    {
+        assert( p->Ranges[k].fWorking == 0 );
+        p->Ranges[k].fStop = 1;
+        p->Ranges[k].fWorking = 1;
     }
+    if ( p->nProcs > 1 )
+    for ( k = 0; k < p->nProcs; k++ )
+        pthread_join( WorkerThread[k], NULL );
+#endif
+    // collect the data of all ranges
+    for ( k = 1; k < p->nProcs; k++ )
+        for ( i = 0; i < Gia_ManObjNum(pAig); i++ )
+            p->pData1[i] += p->Ranges[k].pData1[i];
+    nSimWords = 2 * p->nWords * p->nFrames;
     if ( pPars->fVerbose )
     {
-        printf( "Simulated %d frames with %d words. ", pPars->nIters, pPars->nWords );
+        printf( "Simulated %d frames with %d words using %d thread%s. ", p->nFrames + Abc_MinInt(pPars->nPref, pPars->nIters), 2 * p->nWords, p->nProcs, p->nProcs > 1 ? "s" : "" );
         ABC_PRT( "Simulation time", Abc_Clock() - clkTotal );
     }
     // derive the result
@@ -600,7 +836,7 @@ Vec_Int_t * Gia_ManSwiSimulate( Gia_Man_t * pAig, Gia_ParSwi_t * pPars )
     if ( pPars->fProbOne )
     {
         Gia_ManForEachObj( pAig, pObj, i )
-            pSwitching[i] = Gia_ManSwiComputeProbOne( p->pData1[i], pPars->nWords*(pPars->nIters-pPars->nPref) );
+            pSwitching[i] = Gia_ManSwiComputeProbOne( p->pData1[i], nSimWords );
         Gia_ManForEachCo( pAig, pObj, i )
         {
             if ( Gia_ObjFaninC0(pObj) )
@@ -612,12 +848,12 @@ Vec_Int_t * Gia_ManSwiSimulate( Gia_Man_t * pAig, Gia_ParSwi_t * pPars )
     else if ( pPars->fProbTrans )
     {
         Gia_ManForEachObj( pAig, pObj, i )
-            pSwitching[i] = Gia_ManSwiComputeProbOne( p->pData1[i], pPars->nWords*(pPars->nIters-pPars->nPref) );
+            pSwitching[i] = Gia_ManSwiComputeProbOne( p->pData1[i], nSimWords );
     }
     else
     {
         Gia_ManForEachObj( pAig, pObj, i )
-            pSwitching[i] = Gia_ManSwiComputeSwitching( p->pData1[i], pPars->nWords*(pPars->nIters-pPars->nPref) );
+            pSwitching[i] = Gia_ManSwiComputeSwitching( p->pData1[i], nSimWords );
     }
 /*
     printf( "PI: " );
@@ -655,7 +891,7 @@ Vec_Int_t * Gia_ManSwiSimulate( Gia_Man_t * pAig, Gia_ParSwi_t * pPars )
   SeeAlso     []
 
 ***********************************************************************/
-Vec_Int_t * Gia_ManComputeSwitchProbs( Gia_Man_t * pGia, int nFrames, int nPref, int fProbOne )
+Vec_Int_t * Gia_ManComputeSwitchProbs2( Gia_Man_t * pGia, int nFrames, int nPref, int fProbOne, int nWords, int nProcs, int TimeLimit, Vec_Flt_t * vPiProbs, Vec_Wrd_t * vTrace, int fVerbose )
 {
     Gia_ParSwi_t Pars, * pPars = &Pars;
     // set the default parameters
@@ -665,6 +901,14 @@ Vec_Int_t * Gia_ManComputeSwitchProbs( Gia_Man_t * pGia, int nFrames, int nPref,
     if ( Abc_FrameReadFlag("seqsimframes") )
         pPars->nIters = atoi( Abc_FrameReadFlag("seqsimframes") );
     pPars->nPref    = nPref;    // set number of first timeframes to skip  
+    pPars->nWords   = nWords;   // set the number of 32-bit simulation words
+    pPars->nProcs   = nProcs;   // set the number of threads
+    pPars->TimeLimit = TimeLimit; // set the runtime budget
+    pPars->vPiProbs = vPiProbs; // set probabilities of the PIs
+    pPars->vTrace   = vTrace;   // set the input stimulus
+    pPars->fVerbose = fVerbose;
+    assert( vPiProbs == NULL || Vec_FltSize(vPiProbs) == Gia_ManPiNum(pGia) );
+    assert( vTrace == NULL || Vec_WrdSize(vTrace) % Gia_ManPiNum(pGia) == 0 );
     // decide what should be computed
     if ( fProbOne )
     {
@@ -681,6 +925,10 @@ Vec_Int_t * Gia_ManComputeSwitchProbs( Gia_Man_t * pGia, int nFrames, int nPref,
     // perform the computation of switching activity
     return Gia_ManSwiSimulate( pGia, pPars );
 }
+Vec_Int_t * Gia_ManComputeSwitchProbs( Gia_Man_t * pGia, int nFrames, int nPref, int fProbOne )
+{
+    return Gia_ManComputeSwitchProbs2( pGia, nFrames, nPref, fProbOne, 10, 1, 0, NULL, NULL, 0 );
+}
 Vec_Int_t * Saig_ManComputeSwitchProbs( Aig_Man_t * pAig, int nFrames, int nPref, int fProbOne )
 {
     Vec_Int_t * vSwitching, * vResult;
@@ -705,6 +953,41 @@ Vec_Int_t * Saig_ManComputeSwitchProbs( Aig_Man_t * pAig, int nFrames, int nPref
     return vResult;
 }
 
+/**Function*************************************************************
+
+  Synopsis    [Reads the probabilities of 1 of the PIs.]
+
+  Description [The file lists one number per PI in the order of PIs. 
+  A negative number means that the PI is simulated with random transitions.]
+               
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+Vec_Flt_t * Gia_ManReadPiProbs( char * pFileName, int nPis )
+{
+    Vec_Flt_t * vProbs;
+    float Prob;
+    FILE * pFile = fopen( pFileName, "rb" );
+    if ( pFile == NULL )
+    {
+        printf( "Cannot open input file \"%s\".\n", pFileName );
+        return NULL;
+    }
+    vProbs = Vec_FltAlloc( nPis );
+    while ( fscanf( pFile, "%f", &Prob ) == 1 )
+        Vec_FltPush( vProbs, Prob > 1.0 ? (float)1.0 : Prob );
+    fclose( pFile );
+    if ( Vec_FltSize(vProbs) != nPis )
+    {
+        printf( "The number of probabilities in file \"%s\" (%d) does not match the number of PIs (%d).\n", pFileName, Vec_FltSize(vProbs), nPis );
+        Vec_FltFree( vProbs );
+        return NULL;
+    }
+    return vProbs;
+}
+
 /**Function*************************************************************
 
   Synopsis    [Computes probability of switching (or of being 1).]
@@ -780,7 +1063,7 @@ float Gia_ManComputeSwitching( Gia_Man_t * p, int nFrames, int nPref, int fProbO
 */
 float Gia_ManComputeSwitching( Gia_Man_t * p, int nFrames, int nPref, int fProbOne )
 {
-    Vec_Int_t * vSwitching = Gia_ManComputeSwitchProbs( p, nFrames, nPref, fProbOne );
+    Vec_Int_t * vSwitching = Gia_ManHasSwitching(p) && !fProbOne ? Vec_IntDup( p->vSwitching ) : Gia_ManComputeSwitchProbs( p, nFrames, nPref, fProbOne );
     float * pSwi = (float *)Vec_IntArray(vSwitching), SwiTotal = 0;
     Gia_Obj_t * pObj;
     int i, k, iFan;
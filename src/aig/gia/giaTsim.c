@@ -19,6 +19,7 @@
 ***********************************************************************/
 
 #include "gia.h"
+#include "misc/util/utilTruth.h"
 
 ABC_NAMESPACE_IMPL_START
 
@@ -41,6 +42,33 @@ static inline void Gia_ManTerSimInfoSet( unsigned * pInfo, int i, int Value )
 static inline unsigned * Gia_ManTerStateNext( unsigned * pState, int nWords )                      { return *((unsigned **)(pState + nWords));  }
 static inline void       Gia_ManTerStateSetNext( unsigned * pState, int nWords, unsigned * pNext ) { *((unsigned **)(pState + nWords)) = pNext; }
 
+// bit-sliced ternary simulation engine
+// (each object has two rails of nWords words: the bit in the first rail is set
+// if the value of the object in this pattern is 0, the bit in the second rail 
+// is set if the value is 1, and no bit is set if the value is undefined)
+struct Gia_Tsi_t_
+{
+    int            nWords;       // simulation words per rail
+    int            nObjs;        // the number of objects
+    Vec_Int_t *    vFans;        // fanin literals (two per object, -1 for CIs)
+    Vec_Int_t *    vCis;         // CI objects
+    Vec_Int_t *    vCos;         // CO objects
+    Vec_Wrd_t *    vSims;        // simulation info
+    // incremental simulation
+    int            nFanObjs;     // the number of objects when fanouts were derived
+    Vec_Int_t *    vFanStart;    // the first fanout of each object
+    Vec_Int_t *    vFanouts;     // fanouts
+    Vec_Str_t *    vDirty;       // objects to be re-evaluated
+    int            iDirtyMin;    // the smallest dirty object
+    int            iDirtyMax;    // the largest dirty object
+    int            fSimulated;   // the simulation info is up to date except for dirty objects
+    int            nEvals;       // the number of object evaluations
+};
+
+static inline word * Gia_TsiSim0( Gia_Tsi_t * p, int iObj )       { return Vec_WrdEntryP( p->vSims, 2 * p->nWords * iObj );            }
+static inline word * Gia_TsiSim1( Gia_Tsi_t * p, int iObj )       { return Vec_WrdEntryP( p->vSims, 2 * p->nWords * iObj + p->nWords ); }
+static inline int    Gia_TsiObjIsCi( Gia_Tsi_t * p, int iObj )    { return Vec_IntEntry( p->vFans, 2 * iObj ) == -1;                     }
+
 // ternary simulation manager
 typedef struct Gia_ManTer_t_ Gia_ManTer_t;
 struct Gia_ManTer_t_
@@ -58,9 +86,9 @@ struct Gia_ManTer_t_
     int            nBins;
     unsigned **    pBins;
     // simulation information
-    unsigned *     pDataSim;     // simulation data
     unsigned *     pDataSimCis;  // simulation data for CIs
     unsigned *     pDataSimCos;  // simulation data for COs
+    Gia_Tsi_t *    pTsi;         // simulation engine
 };
 
 ////////////////////////////////////////////////////////////////////////
@@ -69,88 +97,351 @@ struct Gia_ManTer_t_
 
 /**Function*************************************************************
 
-  Synopsis    [Creates fast simulation manager.]
+  Synopsis    [Starts and stops the bit-sliced ternary simulation engine.]
 
-  Description []
+  Description [The engine simulates 64*nWords ternary patterns at once.
+  The network is added object by object in a topological order, using 
+  literals similar to those of the GIA package (object 0 is constant 0).
+  Initially all CIs are undefined.]
                
   SideEffects []
 
   SeeAlso     []
 
 ***********************************************************************/
-Gia_ManTer_t * Gia_ManTerCreate( Gia_Man_t * pAig )
+Gia_Tsi_t * Gia_TsiAlloc( int nWords )
 {
-    Gia_ManTer_t * p;
-    p = ABC_CALLOC( Gia_ManTer_t, 1 );
-    p->pAig   = Gia_ManFront( pAig );
-    p->nIters = 300;
-    p->pDataSim    = ABC_ALLOC( unsigned, Abc_BitWordNum(2*p->pAig->nFront) );
-    p->pDataSimCis = ABC_ALLOC( unsigned, Abc_BitWordNum(2*Gia_ManCiNum(p->pAig)) );
-    p->pDataSimCos = ABC_ALLOC( unsigned, Abc_BitWordNum(2*Gia_ManCoNum(p->pAig)) );
-    // allocate storage for terminary states
-    p->nStateWords = Abc_BitWordNum( 2*Gia_ManRegNum(pAig) );
-    p->vStates  = Vec_PtrAlloc( 1000 );
-    p->pCount0  = ABC_CALLOC( int, Gia_ManRegNum(pAig) );
-    p->pCountX  = ABC_CALLOC( int, Gia_ManRegNum(pAig) );
-    p->nBins    = Abc_PrimeCudd( 500 );
-    p->pBins    = ABC_CALLOC( unsigned *, p->nBins );
-    p->vRetired = Vec_IntAlloc( 100 );
-    p->pRetired = ABC_CALLOC( char, Gia_ManRegNum(pAig) );
+    Gia_Tsi_t * p = ABC_CALLOC( Gia_Tsi_t, 1 );
+    p->nWords    = nWords;
+    p->vFans     = Vec_IntAlloc( 1000 );
+    p->vCis      = Vec_IntAlloc( 100 );
+    p->vCos      = Vec_IntAlloc( 100 );
+    p->vSims     = Vec_WrdAlloc( 1000 * 2 * nWords );
+    p->vFanStart = Vec_IntAlloc( 0 );
+    p->vFanouts  = Vec_IntAlloc( 0 );
+    p->vDirty    = Vec_StrAlloc( 1000 );
+    Gia_TsiClear( p );
     return p;
 }
+void Gia_TsiClear( Gia_Tsi_t * p )
+{
+    p->nObjs      = 0;
+    p->nFanObjs   = -1;
+    p->iDirtyMin  = ABC_INFINITY;
+    p->iDirtyMax  = -1;
+    p->fSimulated = 0;
+    Vec_IntClear( p->vFans );
+    Vec_IntClear( p->vCis );
+    Vec_IntClear( p->vCos );
+    Vec_WrdClear( p->vSims );
+    Vec_StrClear( p->vDirty );
+    // constant 0 node
+    Vec_IntPushTwo( p->vFans, -2, -2 );
+    Vec_WrdFill( p->vSims, p->nWords, ~(word)0 );
+    Vec_WrdFillExtra( p->vSims, 2 * p->nWords, 0 );
+    Vec_StrPush( p->vDirty, 0 );
+    p->nObjs++;
+}
+void Gia_TsiFree( Gia_Tsi_t * p )
+{
+    Vec_IntFree( p->vFans );
+    Vec_IntFree( p->vCis );
+    Vec_IntFree( p->vCos );
+    Vec_WrdFree( p->vSims );
+    Vec_IntFree( p->vFanStart );
+    Vec_IntFree( p->vFanouts );
+    Vec_StrFree( p->vDirty );
+    ABC_FREE( p );
+}
+int Gia_TsiEvalNum( Gia_Tsi_t * p )
+{
+    return p->nEvals;
+}
 
 /**Function*************************************************************
 
-  Synopsis    []
+  Synopsis    [Adds objects to the engine.]
 
-  Description []
+  Description [Returns the literal of the new object.]
                
   SideEffects []
 
   SeeAlso     []
 
 ***********************************************************************/
-void Gia_ManTerStatesFree( Vec_Ptr_t * vStates )
+static inline int Gia_TsiAddObj( Gia_Tsi_t * p, int iLit0, int iLit1 )
 {
-    unsigned * pTemp;
-    int i;
-    Vec_PtrForEachEntry( unsigned *, vStates, pTemp, i )
-        ABC_FREE( pTemp );
-    Vec_PtrFree( vStates );
+    Vec_IntPushTwo( p->vFans, iLit0, iLit1 );
+    Vec_WrdFillExtra( p->vSims, 2 * p->nWords * (p->nObjs + 1), 0 );
+    Vec_StrPush( p->vDirty, 0 );
+    p->fSimulated = 0;
+    return Abc_Var2Lit( p->nObjs++, 0 );
+}
+int Gia_TsiAddCi( Gia_Tsi_t * p )
+{
+    Vec_IntPush( p->vCis, p->nObjs );
+    return Gia_TsiAddObj( p, -1, -1 );
+}
+int Gia_TsiAddAnd( Gia_Tsi_t * p, int iLit0, int iLit1 )
+{
+    assert( Abc_Lit2Var(iLit0) < p->nObjs && Abc_Lit2Var(iLit1) < p->nObjs );
+    return Gia_TsiAddObj( p, iLit0, iLit1 );
+}
+int Gia_TsiAddCo( Gia_Tsi_t * p, int iLit0 )
+{
+    assert( Abc_Lit2Var(iLit0) < p->nObjs );
+    Vec_IntPush( p->vCos, p->nObjs );
+    return Gia_TsiAddObj( p, iLit0, iLit0 );
+}
+int Gia_TsiCiNum( Gia_Tsi_t * p )
+{
+    return Vec_IntSize(p->vCis);
+}
+int Gia_TsiCoNum( Gia_Tsi_t * p )
+{
+    return Vec_IntSize(p->vCos);
 }
 
 /**Function*************************************************************
 
-  Synopsis    []
+  Synopsis    [Loads the AIG into the engine.]
 
-  Description []
+  Description [The objects of the engine have the same IDs as the objects 
+  of the AIG. The CIs and COs are added in the same order.]
                
   SideEffects []
 
   SeeAlso     []
 
 ***********************************************************************/
-void Gia_ManTerDelete( Gia_ManTer_t * p )
+Gia_Tsi_t * Gia_TsiStart( Gia_Man_t * pGia, int nWords )
 {
-    if ( p->vStates ) 
-        Gia_ManTerStatesFree( p->vStates );
-    if ( p->vFlops ) 
-        Gia_ManTerStatesFree( p->vFlops );
-    Gia_ManStop( p->pAig );
-    Vec_IntFree( p->vRetired );
-    ABC_FREE( p->pRetired );
-    ABC_FREE( p->pCount0 );
-    ABC_FREE( p->pCountX );
-    ABC_FREE( p->pBins );
-    ABC_FREE( p->pDataSim );
-    ABC_FREE( p->pDataSimCis );
-    ABC_FREE( p->pDataSimCos );
-    ABC_FREE( p );
+    Gia_Tsi_t * p = Gia_TsiAlloc( nWords );
+    Gia_Obj_t * pObj;
+    int i, iLit;
+    Vec_IntGrow( p->vFans, 2 * Gia_ManObjNum(pGia) );
+    Vec_WrdGrow( p->vSims, 2 * nWords * Gia_ManObjNum(pGia) );
+    Gia_ManForEachObj1( pGia, pObj, i )
+    {
+        if ( Gia_ObjIsAnd(pObj) )
+            iLit = Gia_TsiAddAnd( p, Gia_ObjFaninLit0(pObj, i), Gia_ObjFaninLit1(pObj, i) );
+        else if ( Gia_ObjIsCi(pObj) )
+            iLit = Gia_TsiAddCi( p );
+        else 
+            iLit = Gia_TsiAddCo( p, Gia_ObjFaninLit0(pObj, i) );
+        assert( Abc_Lit2Var(iLit) == i );
+    }
+    return p;
 }
 
 /**Function*************************************************************
 
-  Synopsis    []
+  Synopsis    [Sets and gets the values.]
+
+  Description [The values are GIA_ZER, GIA_ONE, and GIA_UND.]
+               
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+static inline void Gia_TsiSetDirty( Gia_Tsi_t * p, int iObj )
+{
+    Vec_StrWriteEntry( p->vDirty, iObj, 1 );
+    p->iDirtyMin = Abc_MinInt( p->iDirtyMin, iObj );
+    p->iDirtyMax = Abc_MaxInt( p->iDirtyMax, iObj );
+}
+void Gia_TsiSetCi( Gia_Tsi_t * p, int iCi, int iPat, int Value )
+{
+    int iObj = Vec_IntEntry( p->vCis, iCi );
+    word * pSim0 = Gia_TsiSim0( p, iObj );
+    word * pSim1 = Gia_TsiSim1( p, iObj );
+    assert( Value >= GIA_ZER && Value <= GIA_UND );
+    assert( iPat >= 0 && iPat < 64 * p->nWords );
+    if ( Abc_TtGetBit(pSim0, iPat) == (Value == GIA_ZER) && Abc_TtGetBit(pSim1, iPat) == (Value == GIA_ONE) )
+        return;
+    pSim0[iPat >> 6] &= ~((word)1 << (iPat & 63));
+    pSim1[iPat >> 6] &= ~((word)1 << (iPat & 63));
+    if ( Value == GIA_ZER )
+        Abc_TtSetBit( pSim0, iPat );
+    if ( Value == GIA_ONE )
+        Abc_TtSetBit( pSim1, iPat );
+    Gia_TsiSetDirty( p, iObj );
+}
+void Gia_TsiSetCiAll( Gia_Tsi_t * p, int iCi, int Value )
+{
+    int w, iObj = Vec_IntEntry( p->vCis, iCi );
+    word * pSim0 = Gia_TsiSim0( p, iObj );
+    word * pSim1 = Gia_TsiSim1( p, iObj );
+    word Zero = Value == GIA_ZER ? ~(word)0 : 0;
+    word One  = Value == GIA_ONE ? ~(word)0 : 0;
+    int fChange = 0;
+    assert( Value >= GIA_ZER && Value <= GIA_UND );
+    for ( w = 0; w < p->nWords; w++ )
+    {
+        fChange |= (pSim0[w] != Zero) | (pSim1[w] != One);
+        pSim0[w] = Zero;
+        pSim1[w] = One;
+    }
+    if ( fChange )
+        Gia_TsiSetDirty( p, iObj );
+}
+// sets one word of patterns (Zero and One are the patterns where the CI is 0 and 1)
+void Gia_TsiSetCiWord( Gia_Tsi_t * p, int iCi, int iWord, word Zero, word One )
+{
+    int iObj = Vec_IntEntry( p->vCis, iCi );
+    word * pSim0 = Gia_TsiSim0( p, iObj );
+    word * pSim1 = Gia_TsiSim1( p, iObj );
+    assert( (Zero & One) == 0 );
+    assert( iWord >= 0 && iWord < p->nWords );
+    if ( pSim0[iWord] == Zero && pSim1[iWord] == One )
+        return;
+    pSim0[iWord] = Zero;
+    pSim1[iWord] = One;
+    Gia_TsiSetDirty( p, iObj );
+}
+int Gia_TsiObjValue( Gia_Tsi_t * p, int iObj, int iPat )
+{
+    if ( Abc_TtGetBit(Gia_TsiSim0(p, iObj), iPat) )
+        return GIA_ZER;
+    if ( Abc_TtGetBit(Gia_TsiSim1(p, iObj), iPat) )
+        return GIA_ONE;
+    return GIA_UND;
+}
+int Gia_TsiCoValue( Gia_Tsi_t * p, int iCo, int iPat )
+{
+    return Gia_TsiObjValue( p, Vec_IntEntry(p->vCos, iCo), iPat );
+}
+// returns the patterns of the given word, in which the CO is different from Value
+word Gia_TsiCoDiffer( Gia_Tsi_t * p, int iCo, int Value, int iWord )
+{
+    int iObj = Vec_IntEntry( p->vCos, iCo );
+    assert( Value >= GIA_ZER && Value <= GIA_UND );
+    if ( Value == GIA_ZER )
+        return ~Gia_TsiSim0(p, iObj)[iWord];
+    if ( Value == GIA_ONE )
+        return ~Gia_TsiSim1(p, iObj)[iWord];
+    return Gia_TsiSim0(p, iObj)[iWord] | Gia_TsiSim1(p, iObj)[iWord];
+}
+
+/**Function*************************************************************
+
+  Synopsis    [Performs simulation.]
+
+  Description [The incremental version re-evaluates only the transitive 
+  fanout of the CIs whose values have changed since the last simulation, 
+  and stops the propagation at the objects whose values did not change.]
+               
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+static inline int Gia_TsiEvalObj( Gia_Tsi_t * p, int iObj )
+{
+    int iLit0 = Vec_IntEntry( p->vFans, 2 * iObj );
+    int iLit1 = Vec_IntEntry( p->vFans, 2 * iObj + 1 );
+    word * pZero0 = Abc_LitIsCompl(iLit0) ? Gia_TsiSim1(p, Abc_Lit2Var(iLit0)) : Gia_TsiSim0(p, Abc_Lit2Var(iLit0));
+    word * pOne0  = Abc_LitIsCompl(iLit0) ? Gia_TsiSim0(p, Abc_Lit2Var(iLit0)) : Gia_TsiSim1(p, Abc_Lit2Var(iLit0));
+    word * pZero1 = Abc_LitIsCompl(iLit1) ? Gia_TsiSim1(p, Abc_Lit2Var(iLit1)) : Gia_TsiSim0(p, Abc_Lit2Var(iLit1));
+    word * pOne1  = Abc_LitIsCompl(iLit1) ? Gia_TsiSim0(p, Abc_Lit2Var(iLit1)) : Gia_TsiSim1(p, Abc_Lit2Var(iLit1));
+    word * pZero  = Gia_TsiSim0( p, iObj ), Zero;
+    word * pOne   = Gia_TsiSim1( p, iObj ), One;
+    word fChange  = 0;
+    int w;
+    p->nEvals++;
+    for ( w = 0; w < p->nWords; w++ )
+    {
+        Zero = pZero0[w] | pZero1[w];
+        One  = pOne0[w] & pOne1[w];
+        fChange |= (pZero[w] ^ Zero) | (pOne[w] ^ One);
+        pZero[w] = Zero;
+        pOne[w]  = One;
+    }
+    return fChange != 0;
+}
+void Gia_TsiSimulate( Gia_Tsi_t * p )
+{
+    int i;
+    for ( i = 1; i < p->nObjs; i++ )
+        if ( !Gia_TsiObjIsCi(p, i) )
+            Gia_TsiEvalObj( p, i );
+    if ( p->iDirtyMax >= 0 )
+        memset( Vec_StrArray(p->vDirty) + p->iDirtyMin, 0, (size_t)(p->iDirtyMax - p->iDirtyMin + 1) );
+    p->iDirtyMin  = ABC_INFINITY;
+    p->iDirtyMax  = -1;
+    p->fSimulated = 1;
+}
+static void Gia_TsiFanoutStart( Gia_Tsi_t * p )
+{
+    int i, k, iFan, * pStart;
+    Vec_IntFill( p->vFanStart, p->nObjs + 1, 0 );
+    pStart = Vec_IntArray( p->vFanStart );
+    for ( i = 1; i < p->nObjs; i++ )
+    {
+        if ( Gia_TsiObjIsCi(p, i) )
+            continue;
+        pStart[Abc_Lit2Var(Vec_IntEntry(p->vFans, 2*i))]++;
+        if ( Abc_Lit2Var(Vec_IntEntry(p->vFans, 2*i)) != Abc_Lit2Var(Vec_IntEntry(p->vFans, 2*i+1)) )
+            pStart[Abc_Lit2Var(Vec_IntEntry(p->vFans, 2*i+1))]++;
+    }
+    for ( i = 0, k = 0; i <= p->nObjs; i++ )
+        iFan = pStart[i], pStart[i] = k, k += iFan;
+    Vec_IntFill( p->vFanouts, k, 0 );
+    for ( i = 1; i < p->nObjs; i++ )
+    {
+        if ( Gia_TsiObjIsCi(p, i) )
+            continue;
+        iFan = Abc_Lit2Var( Vec_IntEntry(p->vFans, 2*i) );
+        Vec_IntWriteEntry( p->vFanouts, pStart[iFan]++, i );
+        if ( iFan != Abc_Lit2Var(Vec_IntEntry(p->vFans, 2*i+1)) )
+        {
+            iFan = Abc_Lit2Var( Vec_IntEntry(p->vFans, 2*i+1) );
+            Vec_IntWriteEntry( p->vFanouts, pStart[iFan]++, i );
+        }
+    }
+    // restore the starting points
+    for ( i = p->nObjs; i > 0; i-- )
+        pStart[i] = pStart[i-1];
+    pStart[0] = 0;
+    p->nFanObjs = p->nObjs;
+}
+void Gia_TsiSimulateInc( Gia_Tsi_t * p )
+{
+    char * pDirty = Vec_StrArray( p->vDirty );
+    int i, k, * pStart, * pFanouts;
+    if ( !p->fSimulated )
+    {
+        Gia_TsiSimulate( p );
+        return;
+    }
+    if ( p->iDirtyMax < 0 )
+        return;
+    if ( p->nFanObjs != p->nObjs )
+        Gia_TsiFanoutStart( p );
+    pStart   = Vec_IntArray( p->vFanStart );
+    pFanouts = Vec_IntArray( p->vFanouts );
+    // the fanouts have larger IDs, so the dirty objects are visited in one pass
+    for ( i = p->iDirtyMin; i <= p->iDirtyMax; i++ )
+    {
+        if ( !pDirty[i] )
+            continue;
+        pDirty[i] = 0;
+        if ( !Gia_TsiObjIsCi(p, i) && !Gia_TsiEvalObj(p, i) )
+            continue;
+        for ( k = pStart[i]; k < pStart[i+1]; k++ )
+        {
+            pDirty[pFanouts[k]] = 1;
+            p->iDirtyMax = Abc_MaxInt( p->iDirtyMax, pFanouts[k] );
+        }
+    }
+    p->iDirtyMin = ABC_INFINITY;
+    p->iDirtyMax = -1;
+}
+
+/**Function*************************************************************
+
+  Synopsis    [Creates fast simulation manager.]
 
   Description []
                
@@ -159,9 +450,25 @@ void Gia_ManTerDelete( Gia_ManTer_t * p )
   SeeAlso     []
 
 ***********************************************************************/
-static inline void Gia_ManTerSimulateCi( Gia_ManTer_t * p, Gia_Obj_t * pObj, int iCi )
+Gia_ManTer_t * Gia_ManTerCreate( Gia_Man_t * pAig )
 {
-    Gia_ManTerSimInfoSet( p->pDataSim, Gia_ObjValue(pObj), Gia_ManTerSimInfoGet(p->pDataSimCis, iCi) );
+    Gia_ManTer_t * p;
+    p = ABC_CALLOC( Gia_ManTer_t, 1 );
+    p->pAig   = pAig;
+    p->nIters = 300;
+    p->pTsi        = Gia_TsiStart( pAig, 1 );
+    p->pDataSimCis = ABC_ALLOC( unsigned, Abc_BitWordNum(2*Gia_ManCiNum(p->pAig)) );
+    p->pDataSimCos = ABC_ALLOC( unsigned, Abc_BitWordNum(2*Gia_ManCoNum(p->pAig)) );
+    // allocate storage for terminary states
+    p->nStateWords = Abc_BitWordNum( 2*Gia_ManRegNum(pAig) );
+    p->vStates  = Vec_PtrAlloc( 1000 );
+    p->pCount0  = ABC_CALLOC( int, Gia_ManRegNum(pAig) );
+    p->pCountX  = ABC_CALLOC( int, Gia_ManRegNum(pAig) );
+    p->nBins    = Abc_PrimeCudd( 500 );
+    p->pBins    = ABC_CALLOC( unsigned *, p->nBins );
+    p->vRetired = Vec_IntAlloc( 100 );
+    p->pRetired = ABC_CALLOC( char, Gia_ManRegNum(pAig) );
+    return p;
 }
 
 /**Function*************************************************************
@@ -175,10 +482,13 @@ static inline void Gia_ManTerSimulateCi( Gia_ManTer_t * p, Gia_Obj_t * pObj, int
   SeeAlso     []
 
 ***********************************************************************/
-static inline void Gia_ManTerSimulateCo( Gia_ManTer_t * p, int iCo, Gia_Obj_t * pObj )
+void Gia_ManTerStatesFree( Vec_Ptr_t * vStates )
 {
-    int Value = Gia_ManTerSimInfoGet( p->pDataSim, Gia_ObjDiff0(pObj) );
-    Gia_ManTerSimInfoSet( p->pDataSimCos, iCo, Gia_XsimNotCond( Value, Gia_ObjFaninC0(pObj) ) );
+    unsigned * pTemp;
+    int i;
+    Vec_PtrForEachEntry( unsigned *, vStates, pTemp, i )
+        ABC_FREE( pTemp );
+    Vec_PtrFree( vStates );
 }
 
 /**Function*************************************************************
@@ -192,11 +502,21 @@ static inline void Gia_ManTerSimulateCo( Gia_ManTer_t * p, int iCo, Gia_Obj_t *
   SeeAlso     []
 
 ***********************************************************************/
-static inline void Gia_ManTerSimulateNode( Gia_ManTer_t * p, Gia_Obj_t * pObj )
+void Gia_ManTerDelete( Gia_ManTer_t * p )
 {
-    int Value0 = Gia_ManTerSimInfoGet( p->pDataSim, Gia_ObjDiff0(pObj) );
-    int Value1 = Gia_ManTerSimInfoGet( p->pDataSim, Gia_ObjDiff1(pObj) );
-    Gia_ManTerSimInfoSet( p->pDataSim, Gia_ObjValue(pObj), Gia_XsimAndCond( Value0, Gia_ObjFaninC0(pObj), Value1, Gia_ObjFaninC1(pObj) ) );
+    if ( p->vStates ) 
+        Gia_ManTerStatesFree( p->vStates );
+    if ( p->vFlops ) 
+        Gia_ManTerStatesFree( p->vFlops );
+    Vec_IntFree( p->vRetired );
+    ABC_FREE( p->pRetired );
+    ABC_FREE( p->pCount0 );
+    ABC_FREE( p->pCountX );
+    ABC_FREE( p->pBins );
+    Gia_TsiFree( p->pTsi );
+    ABC_FREE( p->pDataSimCis );
+    ABC_FREE( p->pDataSimCos );
+    ABC_FREE( p );
 }
 
 /**Function*************************************************************
@@ -373,31 +693,13 @@ unsigned * Gia_ManTerStateCreate( Gia_ManTer_t * p )
 ***********************************************************************/
 static inline void Gia_ManTerSimulateRound( Gia_ManTer_t * p )
 {
-    Gia_Obj_t * pObj;
-    int i, iCis = 0, iCos = 0;
-    assert( p->pAig->nFront > 0 );
-    assert( Gia_ManConst0(p->pAig)->Value == 0 );
-    Gia_ManTerSimInfoSet( p->pDataSim, 0, GIA_ZER );
-    Gia_ManForEachObj1( p->pAig, pObj, i )
-    {
-        if ( Gia_ObjIsAndOrConst0(pObj) )
-        {
-            assert( Gia_ObjValue(pObj) < p->pAig->nFront );
-            Gia_ManTerSimulateNode( p, pObj );
-        }
-        else if ( Gia_ObjIsCi(pObj) )
-        {
-            assert( Gia_ObjValue(pObj) < p->pAig->nFront );
-            Gia_ManTerSimulateCi( p, pObj, iCis++ );
-        }
-        else // if ( Gia_ObjIsCo(pObj) )
-        {
-            assert( Gia_ObjValue(pObj) == GIA_NONE );
-            Gia_ManTerSimulateCo( p, iCos++, pObj );
-        }
-    }
-    assert( Gia_ManCiNum(p->pAig) == iCis );
-    assert( Gia_ManCoNum(p->pAig) == iCos );
+    int i;
+    // only the CIs whose values have changed are propagated
+    for ( i = 0; i < Gia_ManCiNum(p->pAig); i++ )
+        Gia_TsiSetCi( p->pTsi, i, 0, Gia_ManTerSimInfoGet(p->pDataSimCis, i) );
+    Gia_TsiSimulateInc( p->pTsi );
+    for ( i = 0; i < Gia_ManCoNum(p->pAig); i++ )
+        Gia_ManTerSimInfoSet( p->pDataSimCos, i, Gia_TsiCoValue(p->pTsi, i, 0) );
 }
 
 /**Function*************************************************************
@@ -677,11 +979,11 @@ Gia_ManTer_t * Gia_ManTerSimulate( Gia_Man_t * pAig, int fVerbose )
     p = Gia_ManTerCreate( pAig );
     if ( 0 )
     {
-        printf( "Obj = %8d (%8d). F = %6d. ", 
-            pAig->nObjs, Gia_ManCiNum(pAig) + Gia_ManAndNum(pAig), p->pAig->nFront );
-        printf( "AIG = %7.2f MB. F-mem = %7.2f MB. Other = %7.2f MB.  ", 
+        printf( "Obj = %8d (%8d).  ", 
+            pAig->nObjs, Gia_ManCiNum(pAig) + Gia_ManAndNum(pAig) );
+        printf( "AIG = %7.2f MB. Sim-mem = %7.2f MB. Other = %7.2f MB.  ", 
             12.0*Gia_ManObjNum(p->pAig)/(1<<20), 
-            4.0*Abc_BitWordNum(2 * p->pAig->nFront)/(1<<20), 
+            (8.0*2+4.0*2+1.0)*Gia_ManObjNum(p->pAig)/(1<<20), 
             4.0*Abc_BitWordNum(2 * (Gia_ManCiNum(pAig) + Gia_ManCoNum(pAig)))/(1<<20) );
         ABC_PRT( "Time", Abc_Clock() - clk );
     }
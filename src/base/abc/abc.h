@@ -191,6 +191,7 @@ struct Abc_Ntk_t_
     void *            pManFunc;      // functionality manager (AIG manager, BDD manager, or memory manager for SOPs)
     Abc_ManTime_t *   pManTime;      // the timing manager (for mapped networks) stores arrival/required times for all nodes
     void *            pManCut;       // the cut manager (for AIGs) stores information about the cuts computed for the nodes
+    void *            pManPlace;     // the placement manager (for AIGs) stores the locations of the nodes
     float             AndGateDelay;  // an average estimated delay of one AND gate
     int               LevelMax;      // maximum number of levels
     Vec_Int_t *       vLevelsR;      // level in the reverse topological order (for AIGs)
@@ -601,6 +602,7 @@ extern ABC_DLL int                Abc_NtkCheckUniqueCoNames( Abc_Ntk_t * pNtk );
 extern ABC_DLL int                Abc_NtkCheckUniqueCioNames( Abc_Ntk_t * pNtk );
 /*=== abcCollapse.c ==========================================================*/
 extern ABC_DLL Abc_Ntk_t *        Abc_NtkCollapse( Abc_Ntk_t * pNtk, int fBddSizeMax, int fDualRail, int fReorder, int fReverse, int fDumpOrder, int fVerbose );
+extern ABC_DLL Abc_Ntk_t *        Abc_NtkCollapsePar( Abc_Ntk_t * pNtk, int nBddSizeMax, int nTimeOut, int nProcs, int fReorder, int fVerbose );
 extern ABC_DLL Abc_Ntk_t *        Abc_NtkCollapseSat( Abc_Ntk_t * pNtk, int nCubeLim, int nBTLimit, int nCostMax, int fCanon, int fReverse, int fCnfShared, int fVerbose );
 extern ABC_DLL Gia_Man_t *        Abc_NtkClpGia( Abc_Ntk_t * pNtk );
 /*=== abcCut.c ==========================================================*/
@@ -830,9 +832,15 @@ extern ABC_DLL Odc_Man_t *        Abc_NtkDontCareAlloc( int nVarsMax, int nLevel
 extern ABC_DLL void               Abc_NtkDontCareClear( Odc_Man_t * p );
 extern ABC_DLL void               Abc_NtkDontCareFree( Odc_Man_t * p );
 extern ABC_DLL int                Abc_NtkDontCareCompute( Odc_Man_t * p, Abc_Obj_t * pNode, Vec_Ptr_t * vLeaves, unsigned * puTruth );
+/*=== abcPlace.c ==========================================================*/
+extern ABC_DLL Vec_Ptr_t *        Abc_PlaceBegin( Abc_Ntk_t * pNtk, Vec_Ptr_t ** pvUpdatedNets );
+extern ABC_DLL void               Abc_PlaceEnd( Abc_Ntk_t * pNtk, int fVerbose );
+extern ABC_DLL void               Abc_PlaceUpdate( Abc_Ntk_t * pNtk, Vec_Ptr_t * vAddedCells, Vec_Ptr_t * vUpdatedNets );
+extern ABC_DLL float              Abc_PlaceEvaluateCut( Abc_Obj_t * pRoot, Vec_Ptr_t * vFanins );
+extern ABC_DLL float              Abc_PlaceReadHpwl( Abc_Ntk_t * pNtk );
 /*=== abcPrint.c ==========================================================*/
 extern ABC_DLL float              Abc_NtkMfsTotalSwitching( Abc_Ntk_t * pNtk );
-extern ABC_DLL float              Abc_NtkMfsTotalGlitching( Abc_Ntk_t * pNtk, int nPats, int Prob, int fVerbose );
+extern ABC_DLL float              Abc_NtkMfsTotalGlitching( Abc_Ntk_t * pNtk, int nPats, int Prob, int nProcs, int TimeLimit, int fVerbose );
 extern ABC_DLL void               Abc_NtkPrintStats( Abc_Ntk_t * pNtk, int fFactored, int fSaveBest, int fDumpResult, int fUseLutLib, int fPrintMuxes, int fPower, int fGlitch, int fSkipBuf, int fSkipSmall, int fPrintMem );
 extern ABC_DLL void               Abc_NtkPrintIo( FILE * pFile, Abc_Ntk_t * pNtk, int fPrintFlops );
 extern ABC_DLL void               Abc_NtkPrintLatch( FILE * pFile, Abc_Ntk_t * pNtk );
@@ -124,6 +124,9 @@ Abc_Ntk_t * Abc_NtkStartFrom( Abc_Ntk_t * pNtk, Abc_NtkType_t Type, Abc_NtkFunc_
     // duplicate the name and the spec
     pNtkNew->pName = Extra_UtilStrsav(pNtk->pName);
     pNtkNew->pSpec = Extra_UtilStrsav(pNtk->pSpec);
+    // size the name table for the names to be copied
+    if ( fCopyNames )
+        Nm_ManReserve( pNtkNew->pManName, Nm_ManNumEntries(pNtk->pManName) );
     // clean the node copy fields
     Abc_NtkCleanCopy( pNtk );
     // map the constant nodes
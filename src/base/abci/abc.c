@@ -399,6 +399,7 @@ static int Abc_CommandAbc9Read               ( Abc_Frame_t * pAbc, int argc, cha
 static int Abc_CommandAbc9ReadBlif           ( Abc_Frame_t * pAbc, int argc, char ** argv );
 static int Abc_CommandAbc9ReadCBlif          ( Abc_Frame_t * pAbc, int argc, char ** argv );
 static int Abc_CommandAbc9ReadStg            ( Abc_Frame_t * pAbc, int argc, char ** argv );
+static int Abc_CommandAbc9Stg                ( Abc_Frame_t * pAbc, int argc, char ** argv );
 static int Abc_CommandAbc9ReadVer            ( Abc_Frame_t * pAbc, int argc, char ** argv );
 static int Abc_CommandAbc9WriteVer           ( Abc_Frame_t * pAbc, int argc, char ** argv );
 static int Abc_CommandAbc9Write              ( Abc_Frame_t * pAbc, int argc, char ** argv );
@@ -407,6 +408,7 @@ static int Abc_CommandAbc9Ps                 ( Abc_Frame_t * pAbc, int argc, cha
 static int Abc_CommandAbc9PFan               ( Abc_Frame_t * pAbc, int argc, char ** argv );
 static int Abc_CommandAbc9Pms                ( Abc_Frame_t * pAbc, int argc, char ** argv );
 static int Abc_CommandAbc9PSig               ( Abc_Frame_t * pAbc, int argc, char ** argv );
+static int Abc_CommandAbc9Power              ( Abc_Frame_t * pAbc, int argc, char ** argv );
 static int Abc_CommandAbc9Status             ( Abc_Frame_t * pAbc, int argc, char ** argv );
 static int Abc_CommandAbc9MuxProfile         ( Abc_Frame_t * pAbc, int argc, char ** argv );
 static int Abc_CommandAbc9MuxPos             ( Abc_Frame_t * pAbc, int argc, char ** argv );
@@ -555,6 +557,7 @@ static int Abc_CommandAbc9SatTest            ( Abc_Frame_t * pAbc, int argc, cha
 static int Abc_CommandAbc9FFTest             ( Abc_Frame_t * pAbc, int argc, char ** argv );
 static int Abc_CommandAbc9Qbf                ( Abc_Frame_t * pAbc, int argc, char ** argv );
 static int Abc_CommandAbc9QVar               ( Abc_Frame_t * pAbc, int argc, char ** argv );
+static int Abc_CommandAbc9Quant              ( Abc_Frame_t * pAbc, int argc, char ** argv );
 static int Abc_CommandAbc9GenQbf             ( Abc_Frame_t * pAbc, int argc, char ** argv );
 static int Abc_CommandAbc9HomoQbf            ( Abc_Frame_t * pAbc, int argc, char ** argv );
 static int Abc_CommandAbc9SatFx              ( Abc_Frame_t * pAbc, int argc, char ** argv );
@@ -1177,6 +1180,7 @@ void Abc_Init( Abc_Frame_t * pAbc )
     Cmd_CommandAdd( pAbc, "ABC9",         "&read_blif",    Abc_CommandAbc9ReadBlif,     0 );
     Cmd_CommandAdd( pAbc, "ABC9",         "&read_cblif",   Abc_CommandAbc9ReadCBlif,    0 );
     Cmd_CommandAdd( pAbc, "ABC9",         "&read_stg",     Abc_CommandAbc9ReadStg,      0 );
+    Cmd_CommandAdd( pAbc, "ABC9",         "&stg",          Abc_CommandAbc9Stg,          0 );
     Cmd_CommandAdd( pAbc, "ABC9",         "&read_ver",     Abc_CommandAbc9ReadVer,      0 );
     Cmd_CommandAdd( pAbc, "ABC9",         "&write_ver",    Abc_CommandAbc9WriteVer,     0 );
     Cmd_CommandAdd( pAbc, "ABC9",         "&w",            Abc_CommandAbc9Write,        0 );
@@ -1186,6 +1190,7 @@ void Abc_Init( Abc_Frame_t * pAbc )
     Cmd_CommandAdd( pAbc, "ABC9",         "&pfan",         Abc_CommandAbc9PFan,         0 );
     Cmd_CommandAdd( pAbc, "ABC9",         "&pms",          Abc_CommandAbc9Pms,          0 );
     Cmd_CommandAdd( pAbc, "ABC9",         "&psig",         Abc_CommandAbc9PSig,         0 );
+    Cmd_CommandAdd( pAbc, "ABC9",         "&power",        Abc_CommandAbc9Power,        0 );
     Cmd_CommandAdd( pAbc, "ABC9",         "&status",       Abc_CommandAbc9Status,       0 );
     Cmd_CommandAdd( pAbc, "ABC9",         "&profile",      Abc_CommandAbc9MuxProfile,   0 );
     Cmd_CommandAdd( pAbc, "ABC9",         "&muxpos",       Abc_CommandAbc9MuxPos,       0 );
@@ -1334,6 +1339,7 @@ void Abc_Init( Abc_Frame_t * pAbc )
     Cmd_CommandAdd( pAbc, "ABC9",         "&fftest",       Abc_CommandAbc9FFTest,       0 );
     Cmd_CommandAdd( pAbc, "ABC9",         "&qbf",          Abc_CommandAbc9Qbf,          0 );
     Cmd_CommandAdd( pAbc, "ABC9",         "&qvar",         Abc_CommandAbc9QVar,         0 );
+    Cmd_CommandAdd( pAbc, "ABC9",         "&quant",        Abc_CommandAbc9Quant,        0 );
     Cmd_CommandAdd( pAbc, "ABC9",         "&genqbf",       Abc_CommandAbc9GenQbf,       0 );
     Cmd_CommandAdd( pAbc, "ABC9",         "&homoqbf",      Abc_CommandAbc9HomoQbf,      0 );
     Cmd_CommandAdd( pAbc, "ABC9",         "&satfx",        Abc_CommandAbc9SatFx,        0 );
@@ -3489,6 +3495,8 @@ int Abc_CommandCollapse( Abc_Frame_t * pAbc, int argc, char ** argv )
     int fReorder;
     int fReverse;
     int fDumpOrder;
+    int nProcs;
+    int nTimeOut;
     int c;
     char * pLogFileName = NULL;
     pNtk = Abc_FrameReadNtk(pAbc);
@@ -3500,8 +3508,10 @@ int Abc_CommandCollapse( Abc_Frame_t * pAbc, int argc, char ** argv )
     fDualRail = 0;
     fDumpOrder = 0;
     fBddSizeMax = ABC_INFINITY;
+    nProcs = 1;
+    nTimeOut = 0;
     Extra_UtilGetoptReset();
-    while ( ( c = Extra_UtilGetopt( argc, argv, "BLrodxvh" ) ) != EOF )
+    while ( ( c = Extra_UtilGetopt( argc, argv, "BPTLrodxvh" ) ) != EOF )
     {
         switch ( c )
         {
@@ -3516,6 +3526,28 @@ int Abc_CommandCollapse( Abc_Frame_t * pAbc, int argc, char ** argv )
             if ( fBddSizeMax < 0 )
                 goto usage;
             break;
+        case 'P':
+            if ( globalUtilOptind >= argc )
+            {
+                Abc_Print( -1, "Command line switch \"-P\" should be followed by an integer.\n" );
+                goto usage;
+            }
+            nProcs = atoi(argv[globalUtilOptind]);
+            globalUtilOptind++;
+            if ( nProcs < 1 )
+                goto usage;
+            break;
+        case 'T':
+            if ( globalUtilOptind >= argc )
+            {
+                Abc_Print( -1, "Command line switch \"-T\" should be followed by an integer.\n" );
+                goto usage;
+            }
+            nTimeOut = atoi(argv[globalUtilOptind]);
+            globalUtilOptind++;
+            if ( nTimeOut < 0 )
+                goto usage;
+            break;
         case 'L':
             if ( globalUtilOptind >= argc )
             {
@@ -3560,7 +3592,13 @@ int Abc_CommandCollapse( Abc_Frame_t * pAbc, int argc, char ** argv )
     }
 
     // get the new network
-    if ( Abc_NtkIsStrash(pNtk) )
+    if ( nProcs > 1 || nTimeOut > 0 )
+    {
+        pNtk = Abc_NtkIsStrash(pNtk) ? Abc_NtkDup( pNtk ) : Abc_NtkStrash( pNtk, 0, 0, 0 );
+        pNtkRes = Abc_NtkCollapsePar( pNtk, fBddSizeMax, nTimeOut, nProcs, fReorder, fVerbose );
+        Abc_NtkDelete( pNtk );
+    }
+    else if ( Abc_NtkIsStrash(pNtk) )
         pNtkRes = Abc_NtkCollapse( pNtk, fBddSizeMax, fDualRail, fReorder, fReverse, fDumpOrder, fVerbose );
     else
     {
@@ -3588,9 +3626,13 @@ int Abc_CommandCollapse( Abc_Frame_t * pAbc, int argc, char ** argv )
     return 0;
 
 usage:
-    Abc_Print( -2, "usage: collapse [-B <num>] [-L file] [-rodxvh]\n" );
+    Abc_Print( -2, "usage: collapse [-BPT <num>] [-L file] [-rodxvh]\n" );
     Abc_Print( -2, "\t          collapses the network by constructing global BDDs\n" );
     Abc_Print( -2, "\t-B <num>: limit on live BDD nodes during collapsing [default = %d]\n", fBddSizeMax );
+    Abc_Print( -2, "\t          (with -P or -T, the limit on new BDD nodes for each output)\n" );
+    Abc_Print( -2, "\t-P <num>: the number of threads building output BDDs in groups [default = %d]\n", nProcs );
+    Abc_Print( -2, "\t-T <num>: timeout for each output in seconds (0 = no timeout) [default = %d]\n", nTimeOut );
+    Abc_Print( -2, "\t          (with -P or -T, the outputs exceeding the limits are not collapsed)\n" );
     Abc_Print( -2, "\t-L file : the log file name [default = %s]\n",  pLogFileName ? pLogFileName : "no logging" );
     Abc_Print( -2, "\t-r      : toggles dynamic variable reordering [default = %s]\n", fReorder? "yes": "no" );
     Abc_Print( -2, "\t-o      : toggles reverse variable ordering [default = %s]\n", fReverse? "yes": "no" );
@@ -6352,12 +6394,14 @@ int Abc_CommandGlitch( Abc_Frame_t * pAbc, int argc, char ** argv )
     Abc_Ntk_t * pNtk = Abc_FrameReadNtk(pAbc);
     int nPats    = 4000;
     int Prob     =    8;
+    int nProcs   =    1;
+    int TimeLimit =   0;
     int fVerbose =    1;
     int c;
 
     // set defaults
     Extra_UtilGetoptReset();
-    while ( ( c = Extra_UtilGetopt( argc, argv, "NPvh" ) ) != EOF )
+    while ( ( c = Extra_UtilGetopt( argc, argv, "NPJTvh" ) ) != EOF )
     {
         switch ( c )
         {
@@ -6383,6 +6427,28 @@ int Abc_CommandGlitch( Abc_Frame_t * pAbc, int argc, char ** argv )
             if ( Prob < 1 )
                 goto usage;
             break;
+        case 'J':
+            if ( globalUtilOptind >= argc )
+            {
+                Abc_Print( -1, "Command line switch \"-J\" should be followed by an integer.\n" );
+                goto usage;
+            }
+            nProcs = atoi(argv[globalUtilOptind]);
+            globalUtilOptind++;
+            if ( nProcs < 1 )
+                goto usage;
+            break;
+        case 'T':
+            if ( globalUtilOptind >= argc )
+            {
+                Abc_Print( -1, "Command line switch \"-T\" should be followed by an integer.\n" );
+                goto usage;
+            }
+            TimeLimit = atoi(argv[globalUtilOptind]);
+            globalUtilOptind++;
+            if ( TimeLimit < 0 )
+                goto usage;
+            break;
         case 'v':
             fVerbose ^= 1;
             break;
@@ -6403,16 +6469,18 @@ int Abc_CommandGlitch( Abc_Frame_t * pAbc, int argc, char ** argv )
         return 1;
     }
     if ( Abc_NtkIsMappedLogic(pNtk) || Abc_NtkGetFaninMax(pNtk) <= 6 )
-        Abc_Print( 1, "Glitching adds %7.2f %% of signal transitions, compared to switching.\n", Abc_NtkMfsTotalGlitching(pNtk, nPats, Prob, fVerbose) );
+        Abc_Print( 1, "Glitching adds %7.2f %% of signal transitions, compared to switching.\n", Abc_NtkMfsTotalGlitching(pNtk, nPats, Prob, nProcs, TimeLimit, fVerbose) );
     else
         printf( "Currently computes glitching only for K-LUT networks with K <= 6.\n" );
     return 0;
 
 usage:
-    Abc_Print( -2, "usage: glitch [-NP <num>] [-vh]\n" );
+    Abc_Print( -2, "usage: glitch [-NPJT <num>] [-vh]\n" );
     Abc_Print( -2, "\t           comparing glitching activity to switching activity\n" );
     Abc_Print( -2, "\t-N <num> : the number of random patterns to use (0 < num < 1000000) [default = %d]\n", nPats );
     Abc_Print( -2, "\t-P <num> : once in how many cycles an input changes its value [default = %d]\n", Prob );
+    Abc_Print( -2, "\t-J <num> : the number of threads simulating parts of the patterns [default = %d]\n", nProcs );
+    Abc_Print( -2, "\t-T <num> : keep simulating more patterns for this many seconds [default = %d]\n", TimeLimit );
     Abc_Print( -2, "\t-v       : toggle printing optimization summary [default = %s]\n", fVerbose? "yes": "no" );
     Abc_Print( -2, "\t-h       : print the command usage\n");
     return 1;
@@ -6966,16 +7034,17 @@ usage:
 ***********************************************************************/
 int Abc_CommandTestNpn( Abc_Frame_t * pAbc, int argc, char ** argv )
 {
-    extern int Abc_NpnTest( char * pFileName, int NpnType, int nVarNum, int fDumpRes, int fBinary, int fVerbose );
+    extern int Abc_NpnTest( char * pFileName, int NpnType, int nVarNum, int nProcs, int fDumpRes, int fBinary, int fVerbose );
     char * pFileName;
     int c;
     int fVerbose = 0;
     int NpnType = 0;
     int nVarNum = -1;
+    int nProcs = 1;
     int fDumpRes = 0;
     int fBinary = 0;
     Extra_UtilGetoptReset();
-    while ( ( c = Extra_UtilGetopt( argc, argv, "ANdbvh" ) ) != EOF )
+    while ( ( c = Extra_UtilGetopt( argc, argv, "ANPdbvh" ) ) != EOF )
     {
         switch ( c )
         {
@@ -7001,6 +7070,17 @@ int Abc_CommandTestNpn( Abc_Frame_t * pAbc, int argc, char ** argv )
             if ( nVarNum < 0 )
                 goto usage;
             break;
+        case 'P':
+            if ( globalUtilOptind >= argc )
+            {
+                Abc_Print( -1, "Command line switch \"-P\" should be followed by an integer.\n" );
+                goto usage;
+            }
+            nProcs = atoi(argv[globalUtilOptind]);
+            globalUtilOptind++;
+            if ( nProcs <= 0 )
+                goto usage;
+            break;
         case 'd':
             fDumpRes ^= 1;
             break;
@@ -7029,11 +7109,11 @@ int Abc_CommandTestNpn( Abc_Frame_t * pAbc, int argc, char ** argv )
     // get the output file name
     pFileName = argv[globalUtilOptind];
     // call the testbench
-    Abc_NpnTest( pFileName, NpnType, nVarNum, fDumpRes, fBinary, fVerbose );
+    Abc_NpnTest( pFileName, NpnType, nVarNum, nProcs, fDumpRes, fBinary, fVerbose );
     return 0;
 
 usage:
-    Abc_Print( -2, "usage: testnpn [-AN <num>] [-dbvh] <file>\n" );
+    Abc_Print( -2, "usage: testnpn [-ANP <num>] [-dbvh] <file>\n" );
     Abc_Print( -2, "\t           testbench for computing (semi-)canonical forms\n" );
     Abc_Print( -2, "\t           of completely-specified Boolean functions up to 16 variables\n" );
     Abc_Print( -2, "\t-A <num> : semi-caninical form computation algorithm [default = %d]\n", NpnType );
@@ -7051,6 +7131,7 @@ usage:
     Abc_Print( -2, "\t              11: new cost-aware exact algorithm   by XueGong Zhou at Fudan University, Shanghai\n" );
     Abc_Print( -2, "\t              12: new fast hybrid semi-canonical form (permutation only)\n" );
     Abc_Print( -2, "\t-N <num> : the number of support variables (binary files only) [default = unused]\n" );
+    Abc_Print( -2, "\t-P <num> : the number of threads used by algorithms 5 and 12 [default = %d]\n", nProcs );
     Abc_Print( -2, "\t-d       : toggle dumping resulting functions into a file [default = %s]\n", fDumpRes? "yes": "no" );
     Abc_Print( -2, "\t-b       : toggle dumping in binary format [default = %s]\n", fBinary? "yes": "no" );
     Abc_Print( -2, "\t-v       : toggle verbose printout [default = %s]\n", fVerbose? "yes": "no" );
@@ -7285,11 +7366,11 @@ usage:
 ***********************************************************************/
 int Abc_CommandRunEco( Abc_Frame_t * pAbc, int argc, char ** argv )
 {
-    extern void Acb_NtkRunEco( char * pFileNames[4], int nTimeout, int fCheck, int fRandom, int fInputs, int fUnitW, int fVerbose, int fVeryVerbose );
+    extern void Acb_NtkRunEco( char * pFileNames[4], int nTimeout, int nProcs, int fCheck, int fRandom, int fInputs, int fUnitW, int fVerbose, int fVeryVerbose );
     char * pFileNames[4] = {NULL};
-    int c, nTimeout = 0, fCheck = 0, fRandom = 0, fInputs = 0, fUnitW = 0, fVerbose = 0, fVeryVerbose = 0;
+    int c, nTimeout = 0, nProcs = 1, fCheck = 0, fRandom = 0, fInputs = 0, fUnitW = 0, fVerbose = 0, fVeryVerbose = 0;
     Extra_UtilGetoptReset();
-    while ( ( c = Extra_UtilGetopt( argc, argv, "Tcriuvwh" ) ) != EOF )
+    while ( ( c = Extra_UtilGetopt( argc, argv, "TPcriuvwh" ) ) != EOF )
     {
         switch ( c )
         {
@@ -7304,6 +7385,17 @@ int Abc_CommandRunEco( Abc_Frame_t * pAbc, int argc, char ** argv )
             if ( nTimeout < 0 )
                 goto usage;
             break;
+        case 'P':
+            if ( globalUtilOptind >= argc )
+            {
+                Abc_Print( -1, "Command line switch \"-P\" should be followed by an integer.\n" );
+                goto usage;
+            }
+            nProcs = atoi(argv[globalUtilOptind]);
+            globalUtilOptind++;
+            if ( nProcs <= 0 )
+                goto usage;
+            break;
         case 'c':
             fCheck ^= 1;
             break;
@@ -7347,11 +7439,11 @@ int Abc_CommandRunEco( Abc_Frame_t * pAbc, int argc, char ** argv )
             fclose( pFile );
         pFileNames[c] = argv[globalUtilOptind+c];
     }
-    Acb_NtkRunEco( pFileNames, nTimeout, fCheck, fRandom, fInputs, fUnitW, fVerbose, fVeryVerbose );
+    Acb_NtkRunEco( pFileNames, nTimeout, nProcs, fCheck, fRandom, fInputs, fUnitW, fVerbose, fVeryVerbose );
     return 0;
 
 usage:
-    Abc_Print( -2, "usage: runeco [-T num] [-criuvwh] <implementation> <specification> <weights>\n" );
+    Abc_Print( -2, "usage: runeco [-TP num] [-criuvwh] <implementation> <specification> <weights>\n" );
     Abc_Print( -2, "\t         performs computation of patch functions during ECO,\n" );
     Abc_Print( -2, "\t         as described in the following paper: A. Q. Dao et al\n" );
     Abc_Print( -2, "\t         \"Efficient computation of ECO patch functions\", Proc. DAC\'18\n" );
@@ -7360,6 +7452,7 @@ usage:
     Abc_Print( -2, "\t         http://cad-contest-2017.el.cycu.edu.tw/Problem_A/default.html as follows:\n" );
     Abc_Print( -2, "\t         \"runeco unit1/F.v unit1/G.v unit1/weight.txt; cec -n out.v unit1/G.v\")\n" );
     Abc_Print( -2, "\t-T num : the timeout in seconds [default = %d]\n", nTimeout );
+    Abc_Print( -2, "\t-P num : the number of threads solving independent groups of targets [default = %d]\n", nProcs );
     Abc_Print( -2, "\t-c     : toggle checking that the problem has a solution [default = %s]\n", fCheck? "yes": "no" );
     Abc_Print( -2, "\t-r     : toggle using random permutation of support variables [default = %s]\n", fRandom? "yes": "no" );
     Abc_Print( -2, "\t-i     : toggle using primary inputs as support variables [default = %s]\n", fInputs? "yes": "no" );
@@ -7856,7 +7949,7 @@ int Abc_CommandRewrite( Abc_Frame_t * pAbc, int argc, char ** argv )
     fVeryVerbose = 0;
     fPlaceEnable = 0;
     Extra_UtilGetoptReset();
-    while ( ( c = Extra_UtilGetopt( argc, argv, "lxzvwh" ) ) != EOF )
+    while ( ( c = Extra_UtilGetopt( argc, argv, "lxzvwph" ) ) != EOF )
     {
         switch ( c )
         {
@@ -7927,13 +8020,13 @@ int Abc_CommandRewrite( Abc_Frame_t * pAbc, int argc, char ** argv )
     return 0;
 
 usage:
-    Abc_Print( -2, "usage: rewrite [-lzvwh]\n" );
+    Abc_Print( -2, "usage: rewrite [-lzvwph]\n" );
     Abc_Print( -2, "\t         performs technology-independent rewriting of the AIG\n" );
     Abc_Print( -2, "\t-l     : toggle preserving the number of levels [default = %s]\n", fUpdateLevel? "yes": "no" );
     Abc_Print( -2, "\t-z     : toggle using zero-cost replacements [default = %s]\n", fUseZeros? "yes": "no" );
     Abc_Print( -2, "\t-v     : toggle verbose printout [default = %s]\n", fVerbose? "yes": "no" );
     Abc_Print( -2, "\t-w     : toggle printout subgraph statistics [default = %s]\n", fVeryVerbose? "yes": "no" );
-//    Abc_Print( -2, "\t-p     : toggle placement-aware rewriting [default = %s]\n", fPlaceEnable? "yes": "no" );
+    Abc_Print( -2, "\t-p     : toggle placement-aware rewriting [default = %s]\n", fPlaceEnable? "yes": "no" );
     Abc_Print( -2, "\t-h     : print the command usage\n");
     return 1;
 }
@@ -21494,6 +21587,7 @@ int Abc_CommandRetime( Abc_Frame_t * pAbc, int argc, char ** argv )
     int fBackward;
     int fOneStep;
     int fUseOldNames;
+    int fUsePush;
     int fVerbose;
     int Mode;
     int nDelayLim;
@@ -21506,10 +21600,11 @@ int Abc_CommandRetime( Abc_Frame_t * pAbc, int argc, char ** argv )
     fBackward =  0;
     fOneStep  =  0;
     fUseOldNames = 0;
+    fUsePush  =  0;
     fVerbose  =  0;
     nMaxIters = 15;
     Extra_UtilGetoptReset();
-    while ( ( c = Extra_UtilGetopt( argc, argv, "MDfbsovh" ) ) != EOF )
+    while ( ( c = Extra_UtilGetopt( argc, argv, "MDfbsopvh" ) ) != EOF )
     {
         switch ( c )
         {
@@ -21547,6 +21642,9 @@ int Abc_CommandRetime( Abc_Frame_t * pAbc, int argc, char ** argv )
         case 'o':
             fUseOldNames ^= 1;
             break;
+        case 'p':
+            fUsePush ^= 1;
+            break;
         case 'v':
             fVerbose ^= 1;
             break;
@@ -21591,7 +21689,7 @@ int Abc_CommandRetime( Abc_Frame_t * pAbc, int argc, char ** argv )
         // convert the network into an SOP network
         pNtkRes = Abc_NtkToLogic( pNtk );
         // perform the retiming
-        Abc_NtkRetime( pNtkRes, Mode, nDelayLim, fForward, fBackward, fOneStep, fUseOldNames, fVerbose );
+        Abc_NtkRetime( pNtkRes, Mode, nDelayLim, fForward, fBackward, fOneStep, fUseOldNames, fUsePush, fVerbose );
         // replace the current network
         Abc_FrameReplaceCurrentNetwork( pAbc, pNtkRes );
         return 0;
@@ -21611,11 +21709,11 @@ int Abc_CommandRetime( Abc_Frame_t * pAbc, int argc, char ** argv )
     }
 
     // perform the retiming
-    Abc_NtkRetime( pNtk, Mode, nDelayLim, fForward, fBackward, fOneStep, fUseOldNames, fVerbose );
+    Abc_NtkRetime( pNtk, Mode, nDelayLim, fForward, fBackward, fOneStep, fUseOldNames, fUsePush, fVerbose );
     return 0;
 
 usage:
-    Abc_Print( -2, "usage: retime [-MD num] [-fbsovh]\n" );
+    Abc_Print( -2, "usage: retime [-MD num] [-fbsopvh]\n" );
     Abc_Print( -2, "\t         retimes the current network using one of the algorithms:\n" );
     Abc_Print( -2, "\t             1: most forward retiming\n" );
     Abc_Print( -2, "\t             2: most backward retiming\n" );
@@ -21629,6 +21727,7 @@ usage:
     Abc_Print( -2, "\t-b     : enables backward-only retiming in modes 3,4,5 [default = %s]\n", fBackward? "yes": "no" );
     Abc_Print( -2, "\t-s     : enables retiming one step only in mode 4 [default = %s]\n", fOneStep? "yes": "no" );
     Abc_Print( -2, "\t-o     : enables usind old flop naming conventions [default = %s]\n", fUseOldNames? "yes": "no" );
+    Abc_Print( -2, "\t-p     : enables push-relabel max-flow in modes 3,5 [default = %s]\n", fUsePush? "yes": "no" );
     Abc_Print( -2, "\t-v     : enables verbose output [default = %s]\n", fVerbose? "yes": "no" );
     Abc_Print( -2, "\t-h     : print the command usage\n");
     return 1;
@@ -28011,7 +28110,7 @@ int Abc_CommandBmcInter( Abc_Frame_t * pAbc, int argc, char ** argv )
     // set defaults
     Inter_ManSetDefaultParams( pPars );
     Extra_UtilGetoptReset();
-    while ( ( c = Extra_UtilGetopt( argc, argv, "CFTKLIrtpomcgbqkdivh" ) ) != EOF )
+    while ( ( c = Extra_UtilGetopt( argc, argv, "CFTKPLIrtpomcgbqkdivh" ) ) != EOF )
     {
         switch ( c )
         {
@@ -28059,6 +28158,17 @@ int Abc_CommandBmcInter( Abc_Frame_t * pAbc, int argc, char ** argv )
             if ( pPars->nFramesK < 0 )
                 goto usage;
             break;
+        case 'P':
+            if ( globalUtilOptind >= argc )
+            {
+                Abc_Print( -1, "Command line switch \"-P\" should be followed by an integer.\n" );
+                goto usage;
+            }
+            pPars->nProcs = atoi(argv[globalUtilOptind]);
+            globalUtilOptind++;
+            if ( pPars->nProcs <= 0 )
+                goto usage;
+            break;
         case 'L':
             if ( globalUtilOptind >= argc )
             {
@@ -28199,13 +28309,14 @@ int Abc_CommandBmcInter( Abc_Frame_t * pAbc, int argc, char ** argv )
     return 0;
 
 usage:
-    Abc_Print( -2, "usage: int [-CFTK num] [-LI file] [-irtpomcgbqkdvh]\n" );
+    Abc_Print( -2, "usage: int [-CFTKP num] [-LI file] [-irtpomcgbqkdvh]\n" );
     Abc_Print( -2, "\t         uses interpolation to prove the property\n" );
     Abc_Print( -2, "\t-C num : the limit on conflicts for one SAT run [default = %d]\n", pPars->nBTLimit );
     Abc_Print( -2, "\t-F num : the limit on number of frames to unroll [default = %d]\n", pPars->nFramesMax );
     Abc_Print( -2, "\t-T num : the limit on runtime per output in seconds [default = %d]\n", pPars->nSecLimit );
     Abc_Print( -2, "\t-K num : the number of steps in inductive checking [default = %d]\n", pPars->nFramesK );
     Abc_Print( -2, "\t         (K = 1 works in all cases; K > 1 works without -t and -b)\n" );
+    Abc_Print( -2, "\t-P num : the number of engines with different settings run concurrently [default = %d]\n", pPars->nProcs );
     Abc_Print( -2, "\t-L file: the log file name [default = %s]\n", pLogFileName ? pLogFileName : "no logging" );
     Abc_Print( -2, "\t-I file: the file name for dumping interpolant [default = \"%s\"]\n", pPars->pFileName ? pPars->pFileName : "invar.aig" );
     Abc_Print( -2, "\t-i     : toggle dumping interpolant/invariant into a file [default = %s]\n", pPars->fDropInvar? "yes": "no" );
@@ -29421,13 +29532,16 @@ int Abc_CommandSaucy( Abc_Frame_t * pAbc, int argc, char ** argv )
     int fLookForSwaps = 0;
     int fQuiet = 0;
     int fPrintTree = 0;
+    int nProcs = 1;
     int c;
 
     extern void saucyGateWay( Abc_Ntk_t * pNtk, Abc_Obj_t * pNodePo, FILE * gFile, int fBooleanMatching,
                               int fLookForSwaps, int fFixOutputs, int fFixInputs, int fQuiet, int fPrintTree);
+    extern void saucyGateWayAll( Abc_Ntk_t * pNtk, FILE * gFile, int fLookForSwaps, int fFixOutputs, int fFixInputs,
+                                 int fQuiet, int fPrintTree, int nProcs );
 
     Extra_UtilGetoptReset();
-    while ( ( c = Extra_UtilGetopt( argc, argv, "OFiosqvh" ) ) != EOF )
+    while ( ( c = Extra_UtilGetopt( argc, argv, "OFPiosqvh" ) ) != EOF )
     {
         switch ( c )
         {
@@ -29455,6 +29569,17 @@ int Abc_CommandSaucy( Abc_Frame_t * pAbc, int argc, char ** argv )
             }
             globalUtilOptind++;
             break;
+        case 'P':
+            if ( globalUtilOptind >= argc )
+            {
+                Abc_Print( -1, "Command line switch \"-P\" should be followed by an integer.\n" );
+                goto usage;
+            }
+            nProcs = atoi(argv[globalUtilOptind]);
+            globalUtilOptind++;
+            if ( nProcs <= 0 )
+                goto usage;
+            break;
         case 'i':
             fFixOutputs ^= 1;
             break;
@@ -29495,15 +29620,9 @@ int Abc_CommandSaucy( Abc_Frame_t * pAbc, int argc, char ** argv )
     Abc_NtkOrderObjsByName( pNtk, 1 );
 
     if (fOutputsOneAtTime) {
-        int i;
-        Abc_Obj_t * pNodePo;
         FILE * hadi = fopen("hadi.txt", "w");
-        Abc_NtkForEachPo( pNtk, pNodePo, i ) {
-            printf("Output %s\n\n", Abc_ObjName(pNodePo));
-            saucyGateWay( pNtk, pNodePo, gFile, 0, fLookForSwaps, fFixOutputs, fFixInputs, fQuiet, fPrintTree );
-            printf("----------------------------------------\n");
-        }
         fclose(hadi);
+        saucyGateWayAll( pNtk, gFile, fLookForSwaps, fFixOutputs, fFixInputs, fQuiet, fPrintTree, nProcs );
     } else if (outputName != NULL) {
         int i;
         Abc_Obj_t * pNodePo;
@@ -29524,7 +29643,7 @@ int Abc_CommandSaucy( Abc_Frame_t * pAbc, int argc, char ** argv )
     return 0;
 
 usage:
-    Abc_Print( -2, "usage: saucy3 [-O <name>] [-F <file>] [-iosqvh]\n\n" );
+    Abc_Print( -2, "usage: saucy3 [-O <name>] [-F <file>] [-P num] [-iosqvh]\n\n" );
     Abc_Print( -2, "\t            computes functional symmetries of the network\n" );
     Abc_Print( -2, "\t            prints symmetry generators to the standard output\n" );
     Abc_Print( -2, "\t-O <name> : (optional) compute symmetries only for output given by name\n");
@@ -29533,6 +29652,7 @@ usage:
     Abc_Print( -2, "\t            output, but only one output at a time\n" );
     Abc_Print( -2, "\t            [default = compute symmetries by permuting all I/Os]\n" );
     Abc_Print( -2, "\t-F <file> : print symmetry generators to file [default = stdout]\n");
+    Abc_Print( -2, "\t-P num    : the number of threads processing outputs with \"-O all\" [default = %d]\n", nProcs );
     Abc_Print( -2, "\t-i        : permute just the inputs (fix the outputs) [default = no]\n");
     Abc_Print( -2, "\t-o        : permute just the outputs (fix the inputs) [default = no]\n");
     Abc_Print( -2, "\t-s        : only look for swaps of inputs [default = no]\n");
@@ -31150,17 +31270,21 @@ usage:
 int Abc_CommandAbc9ReadBlif( Abc_Frame_t * pAbc, int argc, char ** argv )
 {
     extern Gia_Man_t * Abc_NtkHieCecTest( char * pFileName, int fVerbose );
+    extern Gia_Man_t * Io_ReadBlifAsGia( char * pFileName, int fVerbose );
     Gia_Man_t * pAig;
     FILE * pFile;
     char ** pArgvNew;
     char * FileName, * pTemp;
     int nArgcNew;
-    int c, fVerbose = 0;
+    int c, fFlat = 0, fVerbose = 0;
     Extra_UtilGetoptReset();
-    while ( ( c = Extra_UtilGetopt( argc, argv, "vh" ) ) != EOF )
+    while ( ( c = Extra_UtilGetopt( argc, argv, "avh" ) ) != EOF )
     {
         switch ( c )
         {
+        case 'a':
+            fFlat ^= 1;
+            break;
         case 'v':
             fVerbose ^= 1;
             break;
@@ -31192,14 +31316,19 @@ int Abc_CommandAbc9ReadBlif( Abc_Frame_t * pAbc, int argc, char ** argv )
     }
     fclose( pFile );
 
-    pAig = Abc_NtkHieCecTest( FileName, fVerbose );
-    Abc_FrameUpdateGia( pAbc, pAig );
+    if ( fFlat )
+        pAig = Io_ReadBlifAsGia( FileName, fVerbose );
+    else
+        pAig = Abc_NtkHieCecTest( FileName, fVerbose );
+    if ( pAig )
+        Abc_FrameUpdateGia( pAbc, pAig );
     return 0;
 
 usage:
-    Abc_Print( -2, "usage: &read_blif [-vh] <file>\n" );
+    Abc_Print( -2, "usage: &read_blif [-avh] <file>\n" );
     Abc_Print( -2, "\t         a specialized reader for hierarchical BLIF files\n" );
     Abc_Print( -2, "\t         (for general-purpose BLIFs, please use \"read_blif\")\n" );
+    Abc_Print( -2, "\t-a     : toggles reading flat BLIF directly into AIG (skipping SOPs) [default = %s]\n", fFlat? "yes": "no" );
     Abc_Print( -2, "\t-v     : toggles additional verbose output [default = %s]\n", fVerbose? "yes": "no" );
     Abc_Print( -2, "\t-h     : print the command usage\n");
     Abc_Print( -2, "\t<file> : the file name\n");
@@ -31300,13 +31429,16 @@ usage:
 int Abc_CommandAbc9ReadStg( Abc_Frame_t * pAbc, int argc, char ** argv )
 {
     Gia_Man_t * pAig;
+    Gia_Stg_t * pStg, * pTemp;
     FILE * pFile;
     char * FileName, ** pArgvNew;
     int c, nArgcNew;
     int kHot = 1;
+    int nProcs = 1;
+    int fMinimize = 0;
     int fVerbose = 0;
     Extra_UtilGetoptReset();
-    while ( ( c = Extra_UtilGetopt( argc, argv, "Kvh" ) ) != EOF )
+    while ( ( c = Extra_UtilGetopt( argc, argv, "KPmvh" ) ) != EOF )
     {
         switch ( c )
         {
@@ -31321,6 +31453,20 @@ int Abc_CommandAbc9ReadStg( Abc_Frame_t * pAbc, int argc, char ** argv )
             if ( kHot < 1 || kHot > 5 )
                 goto usage;
             break;
+        case 'P':
+            if ( globalUtilOptind >= argc )
+            {
+                Abc_Print( -1, "Command line switch \"-P\" should be followed by an integer.\n" );
+                goto usage;
+            }
+            nProcs = atoi(argv[globalUtilOptind]);
+            globalUtilOptind++;
+            if ( nProcs < 1 || nProcs > 16 )
+                goto usage;
+            break;
+        case 'm':
+            fMinimize ^= 1;
+            break;
         case 'v':
             fVerbose ^= 1;
             break;
@@ -31345,20 +31491,142 @@ int Abc_CommandAbc9ReadStg( Abc_Frame_t * pAbc, int argc, char ** argv )
     }
     fclose( pFile );
 
-    pAig = Gia_ManStgRead( FileName, kHot, fVerbose );
+    if ( !fMinimize )
+        pAig = Gia_ManStgRead( FileName, kHot, fVerbose );
+    else
+    {
+        pStg = Gia_StgRead( FileName );
+        if ( pStg == NULL )
+            return 1;
+        pStg = Gia_StgMinimize( pTemp = pStg, nProcs, fVerbose );
+        Gia_StgFree( pTemp );
+        pAig = Gia_StgDeriveGia( pStg, kHot, fVerbose );
+        Gia_StgFree( pStg );
+    }
     Abc_FrameUpdateGia( pAbc, pAig );
     return 0;
 
 usage:
-    Abc_Print( -2, "usage: &read_stg [-K <num>] [-vh] <file>\n" );
+    Abc_Print( -2, "usage: &read_stg [-KP <num>] [-mvh] <file>\n" );
     Abc_Print( -2, "\t         reads STG file and generates K-hot-encoded AIG\n" );
     Abc_Print( -2, "\t-K num : the K parameter for hotness of the encoding (1 <= K <= 5) [default = %d]\n", kHot );
+    Abc_Print( -2, "\t-P num : the number of threads used for state minimization (1 <= P <= 16) [default = %d]\n", nProcs );
+    Abc_Print( -2, "\t-m     : toggles minimizing the number of states before encoding [default = %s]\n", fMinimize? "yes": "no" );
     Abc_Print( -2, "\t-v     : toggles printing state codes [default = %s]\n", fVerbose? "yes": "no" );
     Abc_Print( -2, "\t-h     : print the command usage\n");
     Abc_Print( -2, "\t<file> : the file name\n");
     return 1;
 }
 
+/**Function*************************************************************
+
+  Synopsis    []
+
+  Description []
+
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+int Abc_CommandAbc9Stg( Abc_Frame_t * pAbc, int argc, char ** argv )
+{
+    Gia_Man_t * pAig;
+    Gia_Stg_t * pStg, * pTemp;
+    char * pFileName = NULL;
+    int c;
+    int kHot = 1;
+    int nStatesMax = 10000;
+    int nProcs = 1;
+    int fMinimize = 1;
+    int fVerbose = 0;
+    Extra_UtilGetoptReset();
+    while ( ( c = Extra_UtilGetopt( argc, argv, "KSPmvh" ) ) != EOF )
+    {
+        switch ( c )
+        {
+        case 'K':
+            if ( globalUtilOptind >= argc )
+            {
+                Abc_Print( -1, "Command line switch \"-K\" should be followed by an integer.\n" );
+                goto usage;
+            }
+            kHot = atoi(argv[globalUtilOptind]);
+            globalUtilOptind++;
+            if ( kHot < 1 || kHot > 5 )
+                goto usage;
+            break;
+        case 'S':
+            if ( globalUtilOptind >= argc )
+            {
+                Abc_Print( -1, "Command line switch \"-S\" should be followed by an integer.\n" );
+                goto usage;
+            }
+            nStatesMax = atoi(argv[globalUtilOptind]);
+            globalUtilOptind++;
+            if ( nStatesMax < 1 )
+                goto usage;
+            break;
+        case 'P':
+            if ( globalUtilOptind >= argc )
+            {
+                Abc_Print( -1, "Command line switch \"-P\" should be followed by an integer.\n" );
+                goto usage;
+            }
+            nProcs = atoi(argv[globalUtilOptind]);
+            globalUtilOptind++;
+            if ( nProcs < 1 || nProcs > 16 )
+                goto usage;
+            break;
+        case 'm':
+            fMinimize ^= 1;
+            break;
+        case 'v':
+            fVerbose ^= 1;
+            break;
+        default:
+            goto usage;
+        }
+    }
+    if ( pAbc->pGia == NULL )
+    {
+        Abc_Print( -1, "Abc_CommandAbc9Stg(): There is no AIG.\n" );
+        return 1;
+    }
+    if ( argc == globalUtilOptind + 1 )
+        pFileName = argv[globalUtilOptind];
+    else if ( argc != globalUtilOptind )
+        goto usage;
+    pStg = Gia_ManStgExtract( pAbc->pGia, nStatesMax, nProcs, fVerbose );
+    if ( pStg == NULL )
+        return 1;
+    if ( fMinimize )
+    {
+        pStg = Gia_StgMinimize( pTemp = pStg, nProcs, fVerbose );
+        Gia_StgFree( pTemp );
+    }
+    if ( pFileName )
+        Gia_StgWriteKiss( pStg, pFileName );
+    pAig = Gia_StgDeriveGia( pStg, kHot, 0 );
+    Gia_StgFree( pStg );
+    if ( fVerbose )
+        Abc_Print( 1, "The re-encoded AIG has %d flops and %d AND nodes.\n", Gia_ManRegNum(pAig), Gia_ManAndNum(pAig) );
+    Abc_FrameUpdateGia( pAbc, pAig );
+    return 0;
+
+usage:
+    Abc_Print( -2, "usage: &stg [-KSP <num>] [-mvh] [<file>]\n" );
+    Abc_Print( -2, "\t         extracts the reachable STG of the current AIG and re-encodes it\n" );
+    Abc_Print( -2, "\t-K num : the K parameter for hotness of the encoding (1 <= K <= 5) [default = %d]\n", kHot );
+    Abc_Print( -2, "\t-S num : the largest number of reachable states [default = %d]\n", nStatesMax );
+    Abc_Print( -2, "\t-P num : the number of threads (1 <= P <= 16) [default = %d]\n", nProcs );
+    Abc_Print( -2, "\t-m     : toggles minimizing the number of states [default = %s]\n", fMinimize? "yes": "no" );
+    Abc_Print( -2, "\t-v     : toggles printing verbose information [default = %s]\n", fVerbose? "yes": "no" );
+    Abc_Print( -2, "\t-h     : print the command usage\n");
+    Abc_Print( -2, "\t<file> : optional file name for writing the STG in the KISS format\n");
+    return 1;
+}
+
 /**Function*************************************************************
 
   Synopsis    []
@@ -32627,6 +32895,214 @@ usage:
     return 1;
 }
 
+/**Function*************************************************************
+
+  Synopsis    []
+
+  Description []
+
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+int Abc_CommandAbc9Power( Abc_Frame_t * pAbc, int argc, char ** argv )
+{
+    Vec_Flt_t * vPiProbs = NULL;
+    Vec_Wrd_t * vTrace = NULL;
+    Vec_Int_t * vSwitching;
+    Gia_Obj_t * pObj;
+    float * pSwi, SwiTotal = 0;
+    char * pFileName = NULL;
+    char * pFileTrace = NULL;
+    int c, i, k, iFan;
+    int nFrames   = 48;
+    int nPref     = 16;
+    int nWords    = 10;
+    int nProcs    =  1;
+    int TimeLimit =  0;
+    int fTrace    =  0;
+    int fProbOne  =  0;
+    int fVerbose  =  0;
+    Extra_UtilGetoptReset();
+    while ( ( c = Extra_UtilGetopt( argc, argv, "FSWPTIDtovh" ) ) != EOF )
+    {
+        switch ( c )
+        {
+        case 'F':
+            if ( globalUtilOptind >= argc )
+            {
+                Abc_Print( -1, "Command line switch \"-F\" should be followed by an integer.\n" );
+                goto usage;
+            }
+            nFrames = atoi(argv[globalUtilOptind]);
+            globalUtilOptind++;
+            if ( nFrames < 1 )
+                goto usage;
+            break;
+        case 'S':
+            if ( globalUtilOptind >= argc )
+            {
+                Abc_Print( -1, "Command line switch \"-S\" should be followed by an integer.\n" );
+                goto usage;
+            }
+            nPref = atoi(argv[globalUtilOptind]);
+            globalUtilOptind++;
+            if ( nPref < 0 )
+                goto usage;
+            break;
+        case 'W':
+            if ( globalUtilOptind >= argc )
+            {
+                Abc_Print( -1, "Command line switch \"-W\" should be followed by an integer.\n" );
+                goto usage;
+            }
+            nWords = atoi(argv[globalUtilOptind]);
+            globalUtilOptind++;
+            if ( nWords < 1 )
+                goto usage;
+            break;
+        case 'P':
+            if ( globalUtilOptind >= argc )
+            {
+                Abc_Print( -1, "Command line switch \"-P\" should be followed by an integer.\n" );
+                goto usage;
+            }
+            nProcs = atoi(argv[globalUtilOptind]);
+            globalUtilOptind++;
+            if ( nProcs < 1 )
+                goto usage;
+            break;
+        case 'T':
+            if ( globalUtilOptind >= argc )
+            {
+                Abc_Print( -1, "Command line switch \"-T\" should be followed by an integer.\n" );
+                goto usage;
+            }
+            TimeLimit = atoi(argv[globalUtilOptind]);
+            globalUtilOptind++;
+            if ( TimeLimit < 0 )
+                goto usage;
+            break;
+        case 'I':
+            if ( globalUtilOptind >= argc )
+            {
+                Abc_Print( -1, "Command line switch \"-I\" should be followed by a file name.\n" );
+                goto usage;
+            }
+            pFileName = argv[globalUtilOptind];
+            globalUtilOptind++;
+            break;
+        case 'D':
+            if ( globalUtilOptind >= argc )
+            {
+                Abc_Print( -1, "Command line switch \"-D\" should be followed by a file name.\n" );
+                goto usage;
+            }
+            pFileTrace = argv[globalUtilOptind];
+            globalUtilOptind++;
+            break;
+        case 't':
+            fTrace ^= 1;
+            break;
+        case 'o':
+            fProbOne ^= 1;
+            break;
+        case 'v':
+            fVerbose ^= 1;
+            break;
+        case 'h':
+            goto usage;
+        default:
+            goto usage;
+        }
+    }
+    if ( pAbc->pGia == NULL )
+    {
+        Abc_Print( -1, "Abc_CommandAbc9Power(): There is no AIG.\n" );
+        return 1;
+    }
+    if ( nPref >= nFrames )
+    {
+        Abc_Print( -1, "Abc_CommandAbc9Power(): The number of skipped frames (%d) should be less than the number of frames (%d).\n", nPref, nFrames );
+        return 1;
+    }
+    if ( (fTrace || pFileTrace) && Gia_ManPiNum(pAbc->pGia) == 0 )
+    {
+        Abc_Print( -1, "Abc_CommandAbc9Power(): The input stimulus cannot be used for an AIG without primary inputs.\n" );
+        return 1;
+    }
+    if ( fTrace && pAbc->pGia->vSimsPi == NULL )
+    {
+        Abc_Print( -1, "Abc_CommandAbc9Power(): There is no input stimulus (run \"&sim_read\").\n" );
+        return 1;
+    }
+    if ( fTrace && Gia_ManRegNum(pAbc->pGia) > 0 )
+    {
+        Abc_Print( -1, "Abc_CommandAbc9Power(): The stimulus from \"&sim_read\" can only be used for combinational AIGs (use \"-D\").\n" );
+        return 1;
+    }
+    if ( pFileTrace )
+    {
+        vTrace = Vec_WrdReadHex( pFileTrace, NULL, 0 );
+        if ( vTrace == NULL )
+            return 1;
+        if ( Vec_WrdSize(vTrace) == 0 || Vec_WrdSize(vTrace) % Gia_ManPiNum(pAbc->pGia) != 0 )
+        {
+            Abc_Print( -1, "Abc_CommandAbc9Power(): The number of stimulus words (%d) is not divisible by the number of PIs (%d).\n", Vec_WrdSize(vTrace), Gia_ManPiNum(pAbc->pGia) );
+            Vec_WrdFree( vTrace );
+            return 1;
+        }
+    }
+    else if ( fTrace )
+        vTrace = Vec_WrdDup( pAbc->pGia->vSimsPi );
+    if ( pFileName && (vPiProbs = Gia_ManReadPiProbs( pFileName, Gia_ManPiNum(pAbc->pGia) )) == NULL )
+    {
+        Vec_WrdFreeP( &vTrace );
+        return 1;
+    }
+    vSwitching = Gia_ManComputeSwitchProbs2( pAbc->pGia, nFrames, nPref, fProbOne, nWords, nProcs, TimeLimit, vPiProbs, vTrace, fVerbose );
+    Vec_FltFreeP( &vPiProbs );
+    Vec_WrdFreeP( &vTrace );
+    pSwi = (float *)Vec_IntArray(vSwitching);
+    if ( Gia_ManHasMapping(pAbc->pGia) )
+    {
+        Gia_ManForEachLut( pAbc->pGia, i )
+            Gia_LutForEachFanin( pAbc->pGia, i, iFan, k )
+                SwiTotal += pSwi[iFan];
+    }
+    else
+    {
+        Gia_ManForEachAnd( pAbc->pGia, pObj, i )
+            SwiTotal += pSwi[Gia_ObjFaninId0(pObj, i)] + pSwi[Gia_ObjFaninId1(pObj, i)];
+    }
+    Abc_Print( 1, "Total %s of the fanins of %s = %.2f.\n", fProbOne ? "probability of 1" : "switching activity", 
+        Gia_ManHasMapping(pAbc->pGia) ? "LUTs" : "AND nodes", SwiTotal );
+    // keep switching activity for the mapper (&lf -p) and for printing power (&ps -p)
+    Vec_IntFreeP( &pAbc->pGia->vSwitching );
+    if ( !fProbOne )
+        pAbc->pGia->vSwitching = vSwitching;
+    else
+        Vec_IntFree( vSwitching );
+    return 0;
+
+usage:
+    Abc_Print( -2, "usage: &power [-FSWPT num] [-ID file] [-tovh]\n" );
+    Abc_Print( -2, "\t           estimates switching activity of the AIG using random simulation\n" );
+    Abc_Print( -2, "\t-F num   : the number of timeframes to simulate [default = %d]\n", nFrames );
+    Abc_Print( -2, "\t-S num   : the number of first timeframes to skip [default = %d]\n", nPref );
+    Abc_Print( -2, "\t-W num   : the number of 32-bit words of simulation patterns [default = %d]\n", nWords );
+    Abc_Print( -2, "\t-P num   : the number of threads simulating parts of the patterns [default = %d]\n", nProcs );
+    Abc_Print( -2, "\t-T num   : keep simulating more timeframes for this many seconds [default = %d]\n", TimeLimit );
+    Abc_Print( -2, "\t-I file  : the file with probability of 1 of each PI (negative = random toggling) [default = %s]\n", pFileName ? pFileName : "none" );
+    Abc_Print( -2, "\t-D file  : the file with input stimulus (one hex line per PI, bit i is the value in cycle i) [default = %s]\n", pFileTrace ? pFileTrace : "none" );
+    Abc_Print( -2, "\t-t       : toggle using the patterns from \"&sim_read\" as consecutive input cycles [default = %s]\n", fTrace? "yes": "no" );
+    Abc_Print( -2, "\t-o       : toggle computing probability of 1 instead of switching [default = %s]\n", fProbOne? "yes": "no" );
+    Abc_Print( -2, "\t-v       : toggle printing verbose information [default = %s]\n", fVerbose? "yes": "no" );
+    Abc_Print( -2, "\t-h       : print the command usage\n");
+    return 1;
+}
+
 /**Function*************************************************************
 
   Synopsis    []
@@ -38012,7 +38488,7 @@ int Abc_CommandAbc9Sat( Abc_Frame_t * pAbc, int argc, char ** argv )
     int fNewSolver = 0, fNewSolver2 = 0, fCSat = 0, f0Proved = 0, nRestarts = 1;
     Cec_ManSatSetDefaultParams( pPars );
     Extra_UtilGetoptReset();
-    while ( ( c = Extra_UtilGetopt( argc, argv, "JCRSNanmtcxyzvh" ) ) != EOF )
+    while ( ( c = Extra_UtilGetopt( argc, argv, "JCRSNPanmtcxyzvh" ) ) != EOF )
     {
         switch ( c )
         {
@@ -38071,6 +38547,17 @@ int Abc_CommandAbc9Sat( Abc_Frame_t * pAbc, int argc, char ** argv )
             if ( pPars->nCallsRecycle < 0 )
                 goto usage;
             break;
+        case 'P':
+            if ( globalUtilOptind >= argc )
+            {
+                Abc_Print( -1, "Command line switch \"-P\" should be followed by an integer.\n" );
+                goto usage;
+            }
+            pPars->nProcs = atoi(argv[globalUtilOptind]);
+            globalUtilOptind++;
+            if ( pPars->nProcs < 0 )
+                goto usage;
+            break;
         case 'a':
             pPars->fSaveCexes ^= 1;
             break;
@@ -38113,6 +38600,8 @@ int Abc_CommandAbc9Sat( Abc_Frame_t * pAbc, int argc, char ** argv )
         Vec_Str_t * vStatus;
         if ( fNewSolver )
             vCounters = Cbs2_ManSolveMiterNc( pAbc->pGia, pPars->nBTLimit, &vStatus, pPars->fVerbose );
+        else if ( fNewSolver2 && pPars->nProcs > 0 )
+            vCounters = Cbs3_ManSolveMiterPar( pAbc->pGia, pPars->nBTLimit, nRestarts, pPars->nProcs, &vStatus, pPars->fVerbose );
         else if ( fNewSolver2 )
             vCounters = Cbs3_ManSolveMiterNc( pAbc->pGia, pPars->nBTLimit, nRestarts, &vStatus, pPars->fVerbose );
         else if ( pPars->fLearnCls )
@@ -38138,13 +38627,14 @@ int Abc_CommandAbc9Sat( Abc_Frame_t * pAbc, int argc, char ** argv )
     return 0;
 
 usage:
-    Abc_Print( -2, "usage: &sat [-JCRSN <num>] [-anmctxzvh]\n" );
+    Abc_Print( -2, "usage: &sat [-JCRSNP <num>] [-anmctxyzvh]\n" );
     Abc_Print( -2, "\t         performs SAT solving for the combinational outputs\n" );
     Abc_Print( -2, "\t-J num : the SAT solver type [default = %d]\n", pPars->SolverType );
     Abc_Print( -2, "\t-C num : the max number of conflicts at a node [default = %d]\n", pPars->nBTLimit );
     Abc_Print( -2, "\t-R num : the max number of restarts at a node [default = %d]\n", nRestarts );
     Abc_Print( -2, "\t-S num : the min number of variables to recycle the solver [default = %d]\n", pPars->nSatVarMax );
     Abc_Print( -2, "\t-N num : the min number of calls to recycle the solver [default = %d]\n", pPars->nCallsRecycle );
+    Abc_Print( -2, "\t-P num : the number of threads of the batched solver used with -y (0 = not batched) [default = %d]\n", pPars->nProcs );
     Abc_Print( -2, "\t-a     : toggle solving all outputs and saving counter-examples [default = %s]\n", pPars->fSaveCexes? "yes": "no" );
     Abc_Print( -2, "\t-n     : toggle using non-chronological backtracking [default = %s]\n", pPars->fNonChrono? "yes": "no" );
     Abc_Print( -2, "\t-m     : toggle miter vs. any circuit [default = %s]\n", pPars->fCheckMiter? "miter": "circuit" );
@@ -38250,7 +38740,7 @@ int Abc_CommandAbc9Fraig( Abc_Frame_t * pAbc, int argc, char ** argv )
     int fCbs = 1, approxLim = 600, subBatchSz = 1, adaRecycle = 500, nMaxNodes = 0;
     Cec4_ManSetParams( pPars );
     Extra_UtilGetoptReset();
-    while ( ( c = Extra_UtilGetopt( argc, argv, "JWRILDCNPMrmdckngxysopwqvh" ) ) != EOF )
+    while ( ( c = Extra_UtilGetopt( argc, argv, "JWRILDCNPMKrmdckngxysopwqvh" ) ) != EOF )
     {
         switch ( c )
         {
@@ -38364,6 +38854,17 @@ int Abc_CommandAbc9Fraig( Abc_Frame_t * pAbc, int argc, char ** argv )
             if ( nMaxNodes < 0 )
                 goto usage;
             break;
+        case 'K':
+            if ( globalUtilOptind >= argc )
+            {
+                Abc_Print( -1, "Command line switch \"-K\" should be followed by an integer.\n" );
+                goto usage;
+            }
+            pPars->nProcs = atoi(argv[globalUtilOptind]);
+            globalUtilOptind++;
+            if ( pPars->nProcs < 0 )
+                goto usage;
+            break;
         case 'r':
             pPars->fRewriting ^= 1;
             break;
@@ -38445,7 +38946,7 @@ int Abc_CommandAbc9Fraig( Abc_Frame_t * pAbc, int argc, char ** argv )
     return 0;
 
 usage:
-    Abc_Print( -2, "usage: &fraig [-JWRILDCNPM <num>] [-rmdckngxysopwvh]\n" );
+    Abc_Print( -2, "usage: &fraig [-JWRILDCNPMK <num>] [-rmdckngxysopwvh]\n" );
     Abc_Print( -2, "\t         performs combinational SAT sweeping\n" );
     Abc_Print( -2, "\t-J num : the solver type [default = %d]\n", pPars->jType );
     Abc_Print( -2, "\t-W num : the number of simulation words [default = %d]\n", pPars->nWords );
@@ -38457,6 +38958,7 @@ usage:
     Abc_Print( -2, "\t-N num : the min number of calls to recycle the solver [default = %d]\n", pPars->nCallsRecycle );
     Abc_Print( -2, "\t-P num : the number of pattern generation iterations [default = %d]\n", pPars->nGenIters );
     Abc_Print( -2, "\t-M num : the node count limit to call the old sweeper [default = %d]\n", nMaxNodes );
+    Abc_Print( -2, "\t-K num : the number of threads of the batched circuit-based solver used with -c (0 = not batched) [default = %d]\n", pPars->nProcs );
     Abc_Print( -2, "\t-r     : toggle the use of AIG rewriting [default = %s]\n", pPars->fRewriting? "yes": "no" );
     Abc_Print( -2, "\t-m     : toggle miter vs. any circuit [default = %s]\n", pPars->fCheckMiter? "miter": "circuit" );
     Abc_Print( -2, "\t-d     : toggle using double output miters [default = %s]\n", pPars->fDualOut? "yes": "no" );
@@ -39047,10 +39549,10 @@ int Abc_CommandAbc9Cec( Abc_Frame_t * pAbc, int argc, char ** argv )
     FILE * pFile;
     Gia_Man_t * pGias[2] = {NULL, NULL}, * pMiter;
     char ** pArgvNew;
-    int c, nArgcNew, fUseSim = 0, fUseNewX = 0, fUseNewY = 0, fMiter = 0, fDualOutput = 0, fDumpMiter = 0;
+    int c, nArgcNew, fUseSim = 0, fUseNewX = 0, fUseNewY = 0, fMiter = 0, fDualOutput = 0, fDumpMiter = 0, nProcs = 0;
     Cec_ManCecSetDefaultParams( pPars );
     Extra_UtilGetoptReset();
-    while ( ( c = Extra_UtilGetopt( argc, argv, "CTnmdasxytvwh" ) ) != EOF )
+    while ( ( c = Extra_UtilGetopt( argc, argv, "CTPnmdasxytvwh" ) ) != EOF )
     {
         switch ( c )
         {
@@ -39076,6 +39578,17 @@ int Abc_CommandAbc9Cec( Abc_Frame_t * pAbc, int argc, char ** argv )
             if ( pPars->TimeLimit < 0 )
                 goto usage;
             break;
+        case 'P':
+            if ( globalUtilOptind >= argc )
+            {
+                Abc_Print( -1, "Command line switch \"-P\" should be followed by an integer.\n" );
+                goto usage;
+            }
+            nProcs = atoi(argv[globalUtilOptind]);
+            globalUtilOptind++;
+            if ( nProcs < 0 )
+                goto usage;
+            break;
         case 'n':
             pPars->fNaive ^= 1;
             break;
@@ -39130,7 +39643,10 @@ int Abc_CommandAbc9Cec( Abc_Frame_t * pAbc, int argc, char ** argv )
             }
             if ( !pPars->fSilent )
             Abc_Print( 1, "Assuming the current network is a double-output miter.\n" );
-            pAbc->Status = Cec_ManVerify( pAbc->pGia, pPars );
+            if ( nProcs > 0 )
+                pAbc->Status = Gia_SweeperCheckDualMiter( pAbc->pGia, pPars->nBTLimit, nProcs, pPars->fVerbose );
+            else
+                pAbc->Status = Cec_ManVerify( pAbc->pGia, pPars );
         }
         else
         {
@@ -39335,10 +39851,12 @@ int Abc_CommandAbc9Cec( Abc_Frame_t * pAbc, int argc, char ** argv )
     return 0;
 
 usage:
-    Abc_Print( -2, "usage: &cec [-CT num] [-nmdasxytvwh]\n" );
+    Abc_Print( -2, "usage: &cec [-CTP num] [-nmdasxytvwh]\n" );
     Abc_Print( -2, "\t         new combinational equivalence checker\n" );
     Abc_Print( -2, "\t-C num : the max number of conflicts at a node [default = %d]\n", pPars->nBTLimit );
     Abc_Print( -2, "\t-T num : approximate runtime limit in seconds [default = %d]\n", pPars->TimeLimit );
+    Abc_Print( -2, "\t-P num : the number of threads of the SAT sweeper checking the output pairs\n" );
+    Abc_Print( -2, "\t         of a dual-output miter (-m -d); 0 = use the default engine [default = %d]\n", nProcs );
     Abc_Print( -2, "\t-n     : toggle using naive SAT-based checking [default = %s]\n", pPars->fNaive? "yes":"no");
     Abc_Print( -2, "\t-m     : toggle miter vs. two circuits [default = %s]\n", fMiter? "miter":"two circuits");
     Abc_Print( -2, "\t-d     : toggle using dual output miter [default = %s]\n", fDualOutput? "yes":"no");
@@ -42853,10 +43371,12 @@ usage:
 int Abc_CommandAbc9SatLut( Abc_Frame_t * pAbc, int argc, char ** argv )
 {
     extern void Gia_ManLutSat( Gia_Man_t * p, int LutSize, int nNumber, int nImproves, int nBTLimit, int DelayMax, int nEdges, int fDelay, int fReverse, int fVerbose, int fVeryVerbose );
+    extern void Gia_ManLutSatPar( Gia_Man_t * p, int LutSize, int nNumber, int nImproves, int nBTLimit, int nProcs, int nRounds, int TimeRound, int fReverse, int fVerbose );
     int c, LutSize = 0, nNumber = 32, nImproves = 0, nBTLimit = 100, DelayMax = 0, nEdges = 0;
+    int nProcs = 1, nRounds = 1, TimeRound = 0;
     int fDelay = 0, fReverse = 0, fVeryVerbose = 0, fVerbose = 0;
     Extra_UtilGetoptReset();
-    while ( ( c = Extra_UtilGetopt( argc, argv, "NICDQdrwvh" ) ) != EOF )
+    while ( ( c = Extra_UtilGetopt( argc, argv, "NICDQPRTdrwvh" ) ) != EOF )
     {
         switch ( c )
         {
@@ -42910,6 +43430,39 @@ int Abc_CommandAbc9SatLut( Abc_Frame_t * pAbc, int argc, char ** argv )
             nEdges = atoi(argv[globalUtilOptind]);
             globalUtilOptind++;
             break;
+        case 'P':
+            if ( globalUtilOptind >= argc )
+            {
+                Abc_Print( -1, "Command line switch \"-P\" should be followed by a positive integer.\n" );
+                goto usage;
+            }
+            nProcs = atoi(argv[globalUtilOptind]);
+            globalUtilOptind++;
+            if ( nProcs <= 0 )
+                goto usage;
+            break;
+        case 'R':
+            if ( globalUtilOptind >= argc )
+            {
+                Abc_Print( -1, "Command line switch \"-R\" should be followed by a positive integer.\n" );
+                goto usage;
+            }
+            nRounds = atoi(argv[globalUtilOptind]);
+            globalUtilOptind++;
+            if ( nRounds <= 0 )
+                goto usage;
+            break;
+        case 'T':
+            if ( globalUtilOptind >= argc )
+            {
+                Abc_Print( -1, "Command line switch \"-T\" should be followed by a non-negative integer.\n" );
+                goto usage;
+            }
+            TimeRound = atoi(argv[globalUtilOptind]);
+            globalUtilOptind++;
+            if ( TimeRound < 0 )
+                goto usage;
+            break;
         case 'd':
             fDelay ^= 1;
             break;
@@ -42941,18 +43494,23 @@ int Abc_CommandAbc9SatLut( Abc_Frame_t * pAbc, int argc, char ** argv )
     LutSize = Gia_ManLutSizeMax(pAbc->pGia);
     if ( LutSize > 6 )
         Abc_Print( 0, "Current AIG is mapped into %d-LUTs (only 6-LUT mapping is currently supported).\n", Gia_ManLutSizeMax(pAbc->pGia) );
+    else if ( (nProcs > 1 || nRounds > 1 || TimeRound > 0) && !fDelay && !fVeryVerbose && pAbc->pGia->vEdge1 == NULL )
+        Gia_ManLutSatPar( pAbc->pGia, LutSize, nNumber, nImproves, nBTLimit, nProcs, nRounds, TimeRound, fReverse, fVerbose );
     else
         Gia_ManLutSat( pAbc->pGia, LutSize, nNumber, nImproves, nBTLimit, DelayMax, nEdges, fDelay, fReverse, fVerbose, fVeryVerbose );
     return 0;
 
 usage:
-    Abc_Print( -2, "usage: &satlut [-NICDQ num] [-drwvh]\n" );
+    Abc_Print( -2, "usage: &satlut [-NICDQPRT num] [-drwvh]\n" );
     Abc_Print( -2, "\t           performs SAT-based remapping of the LUT-mapped network\n" );
     Abc_Print( -2, "\t-N num   : the limit on AIG nodes in the window (num <= 128) [default = %d]\n", nNumber );
     Abc_Print( -2, "\t-I num   : the limit on the number of improved windows [default = %d]\n", nImproves );
     Abc_Print( -2, "\t-C num   : the limit on the number of conflicts [default = %d]\n", nBTLimit );
     Abc_Print( -2, "\t-D num   : the user-specified required times at the outputs [default = %d]\n", DelayMax );
     Abc_Print( -2, "\t-Q num   : the maximum number of edges [default = %d]\n", nEdges );
+    Abc_Print( -2, "\t-P num   : the number of concurrent threads, at most 16 (area mode only) [default = %d]\n", nProcs );
+    Abc_Print( -2, "\t-R num   : the number of passes over the LUTs [default = %d]\n", nRounds );
+    Abc_Print( -2, "\t-T num   : the runtime limit per pass in seconds (0 = no limit) [default = %d]\n", TimeRound );
     Abc_Print( -2, "\t-d       : toggles delay optimization [default = %s]\n", fDelay? "yes": "no" );
     Abc_Print( -2, "\t-r       : toggles using reverse search [default = %s]\n", fReverse? "yes": "no" );
     Abc_Print( -2, "\t-v       : toggles verbose output [default = %s]\n", fVerbose? "yes": "no" );
@@ -44032,11 +44590,12 @@ int Abc_CommandAbc9Era( Abc_Frame_t * pAbc, int argc, char ** argv )
     int fDumpFile = 0;
     int fMiter = 0;
     int nStatesMax = 1000000000;
-    extern int Gia_ManCollectReachable( Gia_Man_t * pAig, int nStatesMax, int fMiter, int fDumpFile, int fVerbose );
+    int nProcs = 1;
+    extern int Gia_ManCollectReachable( Gia_Man_t * pAig, int nStatesMax, int fMiter, int fDumpFile, int nProcs, int fVerbose );
     extern int Gia_ManArePerform( Gia_Man_t * pAig, int nStatesMax, int fMiter, int fVerbose );
 
     Extra_UtilGetoptReset();
-    while ( ( c = Extra_UtilGetopt( argc, argv, "Smcdvh" ) ) != EOF )
+    while ( ( c = Extra_UtilGetopt( argc, argv, "SPmcdvh" ) ) != EOF )
     {
         switch ( c )
         {
@@ -44051,6 +44610,17 @@ int Abc_CommandAbc9Era( Abc_Frame_t * pAbc, int argc, char ** argv )
             if ( nStatesMax < 0 )
                 goto usage;
             break;
+        case 'P':
+            if ( globalUtilOptind >= argc )
+            {
+                Abc_Print( -1, "Command line switch \"-P\" should be followed by a positive integer.\n" );
+                goto usage;
+            }
+            nProcs = atoi(argv[globalUtilOptind]);
+            globalUtilOptind++;
+            if ( nProcs <= 0 )
+                goto usage;
+            break;
         case 'm':
             fMiter ^= 1;
             break;
@@ -44087,14 +44657,15 @@ int Abc_CommandAbc9Era( Abc_Frame_t * pAbc, int argc, char ** argv )
     if ( fUseCubes && !fDumpFile )
         pAbc->Status = Gia_ManArePerform( pAbc->pGia, nStatesMax, fMiter, fVerbose );
     else
-        pAbc->Status = Gia_ManCollectReachable( pAbc->pGia, nStatesMax, fMiter, fDumpFile, fVerbose );
+        pAbc->Status = Gia_ManCollectReachable( pAbc->pGia, nStatesMax, fMiter, fDumpFile, nProcs, fVerbose );
     Abc_FrameReplaceCex( pAbc, &pAbc->pGia->pCexSeq );
     return 0;
 
 usage:
-    Abc_Print( -2, "usage: &era [-S num] [-mcdvh]\n" );
+    Abc_Print( -2, "usage: &era [-SP num] [-mcdvh]\n" );
     Abc_Print( -2, "\t          explicit reachability analysis for small sequential AIGs\n" );
     Abc_Print( -2, "\t-S num  : the max number of states (num > 0) [default = %d]\n", nStatesMax );
+    Abc_Print( -2, "\t-P num  : the number of threads used with state minterms (num > 0) [default = %d]\n", nProcs );
     Abc_Print( -2, "\t-m      : stop when the miter output is 1 [default = %s]\n", fMiter? "yes": "no" );
     Abc_Print( -2, "\t-c      : use state cubes instead of state minterms [default = %s]\n", fUseCubes? "yes": "no" );
     Abc_Print( -2, "\t-d      : toggle dumping STG into a file [default = %s]\n", fDumpFile? "yes": "no" );
@@ -44769,7 +45340,7 @@ int Abc_CommandAbc9ReachP( Abc_Frame_t * pAbc, int argc, char ** argv )
     // set defaults
     Llb_ManSetDefaultParams( pPars );
     Extra_UtilGetoptReset();
-    while ( ( c = Extra_UtilGetopt( argc, argv, "NBFTLrbyzdvwh" ) ) != EOF )
+    while ( ( c = Extra_UtilGetopt( argc, argv, "NBFTPLrbyzdvwh" ) ) != EOF )
     {
         switch ( c )
         {
@@ -44817,6 +45388,17 @@ int Abc_CommandAbc9ReachP( Abc_Frame_t * pAbc, int argc, char ** argv )
             if ( pPars->TimeLimit < 0 )
                 goto usage;
             break;
+        case 'P':
+            if ( globalUtilOptind >= argc )
+            {
+                Abc_Print( -1, "Command line switch \"-P\" should be followed by an integer.\n" );
+                goto usage;
+            }
+            pPars->nProcs = atoi(argv[globalUtilOptind]);
+            globalUtilOptind++;
+            if ( pPars->nProcs < 1 )
+                goto usage;
+            break;
         case 'L':
             if ( globalUtilOptind >= argc )
             {
@@ -44878,12 +45460,14 @@ int Abc_CommandAbc9ReachP( Abc_Frame_t * pAbc, int argc, char ** argv )
     return 0;
 
 usage:
-    Abc_Print( -2, "usage: &reachp [-NFT num] [-L file] [-rbyzdvwh]\n" );
+    Abc_Print( -2, "usage: &reachp [-NFTP num] [-L file] [-rbyzdvwh]\n" );
     Abc_Print( -2, "\t         model checking via BDD-based reachability (partitioning-based)\n" );
     Abc_Print( -2, "\t-N num : partitioning value (MinVol=nANDs/N/2; MaxVol=nANDs/N) [default = %d]\n", pPars->nPartValue );
 //    Abc_Print( -2, "\t-B num : the BDD node increase when hints kick in [default = %d]\n", pPars->nBddMax );
     Abc_Print( -2, "\t-F num : max number of reachability iterations [default = %d]\n", pPars->nIterMax );
     Abc_Print( -2, "\t-T num : approximate time limit in seconds (0=infinite) [default = %d]\n", pPars->TimeLimit );
+    Abc_Print( -2, "\t-P num : the number of threads for partitioned image computation [default = %d]\n", pPars->nProcs );
+    Abc_Print( -2, "\t         (only this engine is multi-threaded; &reachm, &reachn, &reachy are not)\n" );
     Abc_Print( -2, "\t-L file: the log file name [default = %s]\n", pLogFileName ? pLogFileName : "no logging" );
     Abc_Print( -2, "\t-r     : enable additional BDD var reordering before image [default = %s]\n", pPars->fReorder? "yes": "no" );
     Abc_Print( -2, "\t-b     : perform backward reachability analysis [default = %s]\n", pPars->fBackward? "yes": "no" );
@@ -45356,12 +45940,37 @@ int Abc_CommandAbc9Iso( Abc_Frame_t * pAbc, int argc, char ** argv )
     Gia_Man_t * pAig;
     Vec_Ptr_t * vPosEquivs;
 //    Vec_Ptr_t * vPiPerms;
-    int c, fNewAlgo = 1, fEstimate = 0, fBetterQual = 0, fDualOut = 0, fVerbose = 0, fVeryVerbose = 0;
+    Gia_IsoCache_t * pCache = NULL;
+    char * pFileName = NULL;
+    int c, nProcs = 1, fUseCache = 0, fNewAlgo = 1, fEstimate = 0, fBetterQual = 0, fDualOut = 0, fVerbose = 0, fVeryVerbose = 0;
     Extra_UtilGetoptReset();
-    while ( ( c = Extra_UtilGetopt( argc, argv, "neqdvwh" ) ) != EOF )
+    while ( ( c = Extra_UtilGetopt( argc, argv, "PFcneqdvwh" ) ) != EOF )
     {
         switch ( c )
         {
+        case 'P':
+            if ( globalUtilOptind >= argc )
+            {
+                Abc_Print( -1, "Command line switch \"-P\" should be followed by an integer.\n" );
+                goto usage;
+            }
+            nProcs = atoi(argv[globalUtilOptind]);
+            globalUtilOptind++;
+            if ( nProcs <= 0 )
+                goto usage;
+            break;
+        case 'F':
+            if ( globalUtilOptind >= argc )
+            {
+                Abc_Print( -1, "Command line switch \"-F\" should be followed by a file name.\n" );
+                goto usage;
+            }
+            pFileName = argv[globalUtilOptind];
+            globalUtilOptind++;
+            break;
+        case 'c':
+            fUseCache ^= 1;
+            break;
         case 'n':
             fNewAlgo ^= 1;
             break;
@@ -45396,10 +46005,21 @@ int Abc_CommandAbc9Iso( Abc_Frame_t * pAbc, int argc, char ** argv )
         Abc_Print( -1, "Abc_CommandAbc9Iso(): The AIG has only one PO. Isomorphism detection is not performed.\n" );
         return 1;
     }
-    if ( fNewAlgo )
+    if ( fUseCache || pFileName )
+    {
+        // the cone cache is kept in the frame and can be loaded from the file
+        if ( pAbc->pIsoCache == NULL )
+            pAbc->pIsoCache = Gia_IsoCacheStart();
+        pCache = (Gia_IsoCache_t *)pAbc->pIsoCache;
+        if ( pFileName && Gia_IsoCacheRead( pCache, pFileName ) && fVerbose )
+            Abc_Print( 1, "Read cone cache from file \"%s\" (%d entries in total).\n", pFileName, Gia_IsoCacheSize(pCache) );
+    }
+    if ( fNewAlgo && nProcs == 1 && pCache == NULL )
         pAig = Gia_ManIsoReduce2( pAbc->pGia, &vPosEquivs, NULL, fEstimate, fBetterQual, fDualOut, fVerbose, fVeryVerbose );
     else
-        pAig = Gia_ManIsoReduce( pAbc->pGia, &vPosEquivs, NULL, fEstimate, fDualOut, fVerbose, fVeryVerbose );
+        pAig = Gia_ManIsoReducePar( pAbc->pGia, &vPosEquivs, NULL, fEstimate, fDualOut, nProcs, pCache, fVerbose, fVeryVerbose );
+    if ( pCache && pFileName )
+        Gia_IsoCacheWrite( pCache, pFileName );
 //    pAig = Gia_ManIsoReduce( pAbc->pGia, &vPosEquivs, &vPiPerms, 0, fDualOut, fVerbose, fVeryVerbose );
 //    Vec_VecFree( (Vec_Vec_t *)vPiPerms );
     if ( pAig == NULL )
@@ -45414,8 +46034,12 @@ int Abc_CommandAbc9Iso( Abc_Frame_t * pAbc, int argc, char ** argv )
     return 0;
 
 usage:
-    Abc_Print( -2, "usage: &iso [-neqdvwh]\n" );
+    Abc_Print( -2, "usage: &iso [-P num] [-F file] [-cneqdvwh]\n" );
     Abc_Print( -2, "\t         removes POs with isomorphic sequential COI\n" );
+    Abc_Print( -2, "\t-P num : the number of threads canonicizing output cones [default = %d]\n", nProcs );
+    Abc_Print( -2, "\t-F file: the file to load and save the cone cache (implies -c) [default = %s]\n", pFileName ? pFileName : "none" );
+    Abc_Print( -2, "\t-c     : toggle reusing canonical forms of cones seen in this session [default = %s]\n", fUseCache? "yes": "no" );
+    Abc_Print( -2, "\t         (options -P, -F, -c use the canonical-form algorithm, as -n does)\n" );
     Abc_Print( -2, "\t-n     : toggle using new fast algorithm [default = %s]\n", fNewAlgo? "yes": "no" );
     Abc_Print( -2, "\t-e     : toggle computing lower bound on equivalence classes [default = %s]\n", fEstimate? "yes": "no" );
     Abc_Print( -2, "\t-q     : toggle improving quality at the expense of runtime [default = %s]\n", fBetterQual? "yes": "no" );
@@ -47838,17 +48462,19 @@ int Abc_CommandAbc9Qbf( Abc_Frame_t * pAbc, int argc, char ** argv )
     extern void Gia_QbfDumpFile( Gia_Man_t * pGia, int nPars );
     extern void Gia_QbfDumpFileInv( Gia_Man_t * pGia, int nPars );
     extern int Gia_QbfSolve( Gia_Man_t * pGia, int nPars, int nIterLimit, int nConfLimit, int nTimeOut, int nEncVars, int fGlucose, int fVerbose );
+    extern int Gia_QbfSolvePar( Gia_Man_t * pGia, int nPars, int nIterLimit, int nConfLimit, int nTimeOut, int nEncVars, int nProcs, int fVerbose );
     int c, nPars   = -1;
     int nIterLimit =  0;
     int nConfLimit =  0;
     int nTimeOut   =  0;
     int nEncVars   =  0;
+    int nProcs     =  1;
     int fDumpCnf   =  0;
     int fDumpCnf2  =  0;
     int fGlucose   =  0;
     int fVerbose   =  0;
     Extra_UtilGetoptReset();
-    while ( ( c = Extra_UtilGetopt( argc, argv, "PICTKdegvh" ) ) != EOF )
+    while ( ( c = Extra_UtilGetopt( argc, argv, "PICTKNdegvh" ) ) != EOF )
     {
         switch ( c )
         {
@@ -47907,6 +48533,17 @@ int Abc_CommandAbc9Qbf( Abc_Frame_t * pAbc, int argc, char ** argv )
             if ( nEncVars < 0 )
                 goto usage;
             break;
+        case 'N':
+            if ( globalUtilOptind >= argc )
+            {
+                Abc_Print( -1, "Command line switch \"-N\" should be followed by an integer.\n" );
+                goto usage;
+            }
+            nProcs = atoi(argv[globalUtilOptind]);
+            globalUtilOptind++;
+            if ( nProcs <= 0 )
+                goto usage;
+            break;
         case 'd':
             fDumpCnf ^= 1;
             break;
@@ -47949,18 +48586,21 @@ int Abc_CommandAbc9Qbf( Abc_Frame_t * pAbc, int argc, char ** argv )
         Gia_QbfDumpFile( pAbc->pGia, nPars );
     else if ( fDumpCnf2 )
         Gia_QbfDumpFileInv( pAbc->pGia, nPars );
+    else if ( nProcs > 1 && !fGlucose )
+        Gia_QbfSolvePar( pAbc->pGia, nPars, nIterLimit, nConfLimit, nTimeOut, nEncVars, nProcs, fVerbose );
     else
         Gia_QbfSolve( pAbc->pGia, nPars, nIterLimit, nConfLimit, nTimeOut, nEncVars, fGlucose, fVerbose );
     return 0;
 
 usage:
-    Abc_Print( -2, "usage: &qbf [-PICTK num] [-degvh]\n" );
+    Abc_Print( -2, "usage: &qbf [-PICTKN num] [-degvh]\n" );
     Abc_Print( -2, "\t         solves QBF problem EpVxM(p,x)\n" );
     Abc_Print( -2, "\t-P num : number of parameters p (should be the first PIs) [default = %d]\n", nPars );
     Abc_Print( -2, "\t-I num : quit after the given iteration even if unsolved [default = %d]\n", nIterLimit );
     Abc_Print( -2, "\t-C num : conflict limit per problem [default = %d]\n", nConfLimit );
     Abc_Print( -2, "\t-T num : global timeout [default = %d]\n", nTimeOut );
     Abc_Print( -2, "\t-K num : the number of input bits (for encoding miters only) [default = %d]\n", nEncVars );
+    Abc_Print( -2, "\t-N num : the number of threads in the solver portfolio [default = %d]\n", nProcs );
     Abc_Print( -2, "\t-d     : toggle dumping QDIMACS file instead of solving (complemented QBF) [default = %s]\n", fDumpCnf? "yes": "no" );
     Abc_Print( -2, "\t-e     : toggle dumping QDIMACS file instead of solving (original QBF) [default = %s]\n", fDumpCnf2? "yes": "no" );
     Abc_Print( -2, "\t-g     : toggle using Glucose 3.0 by Gilles Audemard and Laurent Simon [default = %s]\n", fGlucose? "yes": "no" );
@@ -48049,6 +48689,170 @@ usage:
     return 1;
 }
 
+/**Function*************************************************************
+
+  Synopsis    []
+
+  Description []
+
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+int Abc_CommandAbc9Quant( Abc_Frame_t * pAbc, int argc, char ** argv )
+{
+    Gia_ParQua_t Pars, * pPars = &Pars;
+    Gia_Man_t * pTemp;
+    Vec_Int_t * vVars;
+    int c, i, iVar, nKeep = -1;
+    Gia_ManQuantSetDefaultParams( pPars );
+    Extra_UtilGetoptReset();
+    while ( ( c = Extra_UtilGetopt( argc, argv, "KPNTCWusvh" ) ) != EOF )
+    {
+        switch ( c )
+        {
+        case 'K':
+            if ( globalUtilOptind >= argc )
+            {
+                Abc_Print( -1, "Command line switch \"-K\" should be followed by an integer.\n" );
+                goto usage;
+            }
+            nKeep = atoi(argv[globalUtilOptind]);
+            globalUtilOptind++;
+            if ( nKeep < 0 )
+                goto usage;
+            break;
+        case 'P':
+            if ( globalUtilOptind >= argc )
+            {
+                Abc_Print( -1, "Command line switch \"-P\" should be followed by an integer.\n" );
+                goto usage;
+            }
+            pPars->nProcs = atoi(argv[globalUtilOptind]);
+            globalUtilOptind++;
+            if ( pPars->nProcs < 1 || pPars->nProcs > 16 )
+                goto usage;
+            break;
+        case 'N':
+            if ( globalUtilOptind >= argc )
+            {
+                Abc_Print( -1, "Command line switch \"-N\" should be followed by an integer.\n" );
+                goto usage;
+            }
+            pPars->nNodeMax = atoi(argv[globalUtilOptind]);
+            globalUtilOptind++;
+            if ( pPars->nNodeMax < 1 )
+                goto usage;
+            break;
+        case 'T':
+            if ( globalUtilOptind >= argc )
+            {
+                Abc_Print( -1, "Command line switch \"-T\" should be followed by an integer.\n" );
+                goto usage;
+            }
+            pPars->TimeLimit = atoi(argv[globalUtilOptind]);
+            globalUtilOptind++;
+            if ( pPars->TimeLimit < 0 )
+                goto usage;
+            break;
+        case 'C':
+            if ( globalUtilOptind >= argc )
+            {
+                Abc_Print( -1, "Command line switch \"-C\" should be followed by an integer.\n" );
+                goto usage;
+            }
+            pPars->nBTLimit = atoi(argv[globalUtilOptind]);
+            globalUtilOptind++;
+            if ( pPars->nBTLimit < 0 )
+                goto usage;
+            break;
+        case 'W':
+            if ( globalUtilOptind >= argc )
+            {
+                Abc_Print( -1, "Command line switch \"-W\" should be followed by an integer.\n" );
+                goto usage;
+            }
+            pPars->nSimWords = atoi(argv[globalUtilOptind]);
+            globalUtilOptind++;
+            if ( pPars->nSimWords < 1 )
+                goto usage;
+            break;
+        case 'u':
+            pPars->fUniv ^= 1;
+            break;
+        case 's':
+            pPars->fSweep ^= 1;
+            break;
+        case 'v':
+            pPars->fVerbose ^= 1;
+            break;
+        case 'h':
+            goto usage;
+        default:
+            goto usage;
+        }
+    }
+    if ( pAbc->pGia == NULL )
+    {
+        Abc_Print( -1, "There is no current GIA.\n" );
+        return 1;
+    }
+    if ( Gia_ManRegNum(pAbc->pGia) )
+    {
+        Abc_Print( -1, "Works only for combinational networks.\n" );
+        return 1;
+    }
+    vVars = Vec_IntAlloc( 100 );
+    if ( globalUtilOptind < argc )
+    {
+        for ( i = globalUtilOptind; i < argc; i++ )
+        {
+            iVar = atoi( argv[i] );
+            if ( iVar < 0 || iVar >= Gia_ManPiNum(pAbc->pGia) )
+            {
+                Abc_Print( -1, "Variable %d is not a valid PI index.\n", iVar );
+                Vec_IntFree( vVars );
+                return 1;
+            }
+            Vec_IntPushUnique( vVars, iVar );
+        }
+    }
+    else if ( nKeep >= 0 && nKeep < Gia_ManPiNum(pAbc->pGia) )
+    {
+        for ( iVar = nKeep; iVar < Gia_ManPiNum(pAbc->pGia); iVar++ )
+            Vec_IntPush( vVars, iVar );
+    }
+    else
+    {
+        Abc_Print( -1, "The variables to quantify are not specified.\n" );
+        Vec_IntFree( vVars );
+        return 1;
+    }
+    pTemp = Gia_ManQuantPar( pAbc->pGia, vVars, pPars );
+    Vec_IntFree( vVars );
+    if ( pTemp == NULL )
+        return 1;
+    Abc_FrameUpdateGia( pAbc, pTemp );
+    return 0;
+
+usage:
+    Abc_Print( -2, "usage: &quant [-KPNTCW num] [-usvh] [<var> ...]\n" );
+    Abc_Print( -2, "\t         quantifies PIs from all outputs of the combinational AIG\n" );
+    Abc_Print( -2, "\t-K num : quantifies all PIs except the first <num> PIs [default = %d]\n", nKeep );
+    Abc_Print( -2, "\t-P num : the number of threads (1 <= P <= 16) [default = %d]\n", pPars->nProcs );
+    Abc_Print( -2, "\t-N num : the largest number of AIG nodes in one output cone [default = %d]\n", pPars->nNodeMax );
+    Abc_Print( -2, "\t-T num : the runtime limit in seconds [default = %d]\n", pPars->TimeLimit );
+    Abc_Print( -2, "\t-C num : the conflict limit used by sweeping [default = %d]\n", pPars->nBTLimit );
+    Abc_Print( -2, "\t-W num : the number of simulation words used by sweeping [default = %d]\n", pPars->nSimWords );
+    Abc_Print( -2, "\t-u     : toggle universal quantification [default = %s]\n", pPars->fUniv? "yes": "no" );
+    Abc_Print( -2, "\t-s     : toggle sweeping intermediate results [default = %s]\n", pPars->fSweep? "yes": "no" );
+    Abc_Print( -2, "\t-v     : toggle verbose output [default = %s]\n", pPars->fVerbose? "yes": "no" );
+    Abc_Print( -2, "\t-h     : print the command usage\n");
+    Abc_Print( -2, "\t<var>  : the indexes of the PIs to quantify\n");
+    return 1;
+}
+
 /**Function*************************************************************
 
   Synopsis    []
@@ -49060,9 +49864,9 @@ int Abc_CommandAbc9Polyn( Abc_Frame_t * pAbc, int argc, char ** argv )
 {
     extern void Gia_PolynBuild2Test( Gia_Man_t * pGia, char * pSign, int nExtra, int fSigned, int fVerbose, int fVeryVerbose );
     Vec_Int_t * vOrder = NULL; char * pSign = NULL;
-    int c, nExtra = 0, fOld = 0, fSimple = 1, fSigned = 0, fVerbose = 0, fVeryVerbose = 0;
+    int c, nExtra = 0, nProcs = 1, fOld = 0, fSimple = 1, fSigned = 0, fVerbose = 0, fVeryVerbose = 0;
     Extra_UtilGetoptReset();
-    while ( ( c = Extra_UtilGetopt( argc, argv, "NSoasvwh" ) ) != EOF )
+    while ( ( c = Extra_UtilGetopt( argc, argv, "NPSoasvwh" ) ) != EOF )
     {
         switch ( c )
         {
@@ -49077,6 +49881,17 @@ int Abc_CommandAbc9Polyn( Abc_Frame_t * pAbc, int argc, char ** argv )
             if ( nExtra < 0 )
                 goto usage;
             break;
+        case 'P':
+            if ( globalUtilOptind >= argc )
+            {
+                Abc_Print( -1, "Command line switch \"-P\" should be followed by an integer.\n" );
+                goto usage;
+            }
+            nProcs = atoi(argv[globalUtilOptind]);
+            globalUtilOptind++;
+            if ( nProcs <= 0 )
+                goto usage;
+            break;
         case 'S':
             if ( globalUtilOptind >= argc )
             {
@@ -49119,7 +49934,7 @@ int Abc_CommandAbc9Polyn( Abc_Frame_t * pAbc, int argc, char ** argv )
     }
     if ( fOld )
     {
-        vOrder = fSimple ? NULL : Gia_PolynReorder( pAbc->pGia, fVerbose, fVeryVerbose );
+        vOrder = fSimple ? NULL : Gia_PolynReorder( pAbc->pGia, nProcs, fVerbose, fVeryVerbose );
         Gia_PolynBuild( pAbc->pGia, vOrder, fSigned, fVerbose, fVeryVerbose );
         Vec_IntFreeP( &vOrder );
     }
@@ -49128,9 +49943,10 @@ int Abc_CommandAbc9Polyn( Abc_Frame_t * pAbc, int argc, char ** argv )
     return 0;
 
 usage:
-    Abc_Print( -2, "usage: &polyn [-N num] [-oasvwh] [-S str]\n" );
+    Abc_Print( -2, "usage: &polyn [-NP num] [-oasvwh] [-S str]\n" );
     Abc_Print( -2, "\t         derives algebraic polynomial from AIG\n" );
     Abc_Print( -2, "\t-N num : the number of additional primary outputs (-1 = unused) [default = %d]\n", nExtra );
+    Abc_Print( -2, "\t-P num : the number of threads detecting adders for the old computation [default = %d]\n", nProcs );
     Abc_Print( -2, "\t-o     : toggles old computation [default = %s]\n",  fOld? "yes": "no" );
     Abc_Print( -2, "\t-a     : toggles simple computation [default = %s]\n",  fSimple? "yes": "no" );
     Abc_Print( -2, "\t-s     : toggles signed computation [default = %s]\n",  fSigned? "yes": "no" );
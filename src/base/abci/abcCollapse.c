@@ -28,6 +28,17 @@
 #include "bdd/extrab/extraBdd.h"
 #endif
 
+#ifdef ABC_USE_PTHREADS
+
+#ifdef _WIN32
+#include "../lib/pthread.h"
+#else
+#include <pthread.h>
+#include <unistd.h>
+#endif
+
+#endif
+
 ABC_NAMESPACE_IMPL_START
 
 ////////////////////////////////////////////////////////////////////////
@@ -244,6 +255,526 @@ Abc_Ntk_t * Abc_NtkCollapse( Abc_Ntk_t * pNtk, int fBddSizeMax, int fDualRail, i
     return pNtkNew;
 }
 
+/**Function*************************************************************
+
+  Synopsis    [Data structures for partitioned collapsing.]
+
+  Description [The COs are divided into groups of consecutive outputs.
+  Each group is processed by one thread in its own CUDD manager, which is
+  created for the group and released after it (CUDD is not thread-safe,
+  so managers are never shared). The network is only read by the threads.
+  The result of each output is the SOP over its functional support, or
+  NULL if the output exceeded the node budget or the timeout.]
+               
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+typedef struct Abc_ClpMan_t_ Abc_ClpMan_t;
+struct Abc_ClpMan_t_
+{
+    Abc_Ntk_t *     pNtk;         // the AIG (read-only)
+    int             nBddSizeMax;  // node budget for one output
+    int             nTimeOut;     // timeout for one output (in seconds)
+    int             fReorder;     // dynamic variable reordering
+    int             nGroupSize;   // the number of COs in one group
+    Vec_Int_t *     vCiIds;       // the CI number of each CI object
+    char **         ppSops;       // the SOPs of the COs (or NULL)
+    Vec_Wec_t *     vSupps;       // the CI numbers of the SOP variables
+};
+
+typedef struct Abc_ClpWork_t_ Abc_ClpWork_t;
+struct Abc_ClpWork_t_
+{
+    Vec_Int_t *     vVisit;       // DFS marks
+    Vec_Int_t *     vVarOf;       // local variable of each CI in the group
+    Vec_Int_t *     vCached;      // cache marks
+    Vec_Ptr_t *     vBdds;        // cached BDDs of the nodes
+    Vec_Int_t *     vCacheIds;    // nodes with cached BDDs
+    Vec_Int_t *     vStack;       // DFS stack
+    Vec_Int_t *     vCone;        // AND nodes of the cone
+    Vec_Int_t *     vCis;         // CIs of the cone
+    Vec_Int_t *     vVar2Ci;      // CI of each local variable
+    Vec_Str_t *     vCube;        // cube used to derive the SOP
+    int             iVisit;       // current DFS mark
+    int             iCache;       // current cache mark
+};
+
+extern char * Abc_ConvertBddToSop( Mem_Flex_t * pMan, DdManager * dd, DdNode * bFuncOn, DdNode * bFuncOnDc, int nFanins, int fAllPrimes, Vec_Str_t * vCube, int fMode );
+
+/**Function*************************************************************
+
+  Synopsis    [Starts and stops the thread-local data.]
+
+  Description []
+               
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+Abc_ClpWork_t * Abc_NtkClpWorkStart( Abc_Ntk_t * pNtk )
+{
+    Abc_ClpWork_t * p = ABC_CALLOC( Abc_ClpWork_t, 1 );
+    p->vVisit    = Vec_IntStart( Abc_NtkObjNumMax(pNtk) );
+    p->vVarOf    = Vec_IntStart( Abc_NtkObjNumMax(pNtk) );
+    p->vCached   = Vec_IntStart( Abc_NtkObjNumMax(pNtk) );
+    p->vBdds     = Vec_PtrStart( Abc_NtkObjNumMax(pNtk) );
+    p->vCacheIds = Vec_IntAlloc( 1000 );
+    p->vStack    = Vec_IntAlloc( 1000 );
+    p->vCone     = Vec_IntAlloc( 1000 );
+    p->vCis      = Vec_IntAlloc( 1000 );
+    p->vVar2Ci   = Vec_IntAlloc( 1000 );
+    p->vCube     = Vec_StrAlloc( 100 );
+    return p;
+}
+void Abc_NtkClpWorkStop( Abc_ClpWork_t * p )
+{
+    Vec_IntFree( p->vVisit );
+    Vec_IntFree( p->vVarOf );
+    Vec_IntFree( p->vCached );
+    Vec_PtrFree( p->vBdds );
+    Vec_IntFree( p->vCacheIds );
+    Vec_IntFree( p->vStack );
+    Vec_IntFree( p->vCone );
+    Vec_IntFree( p->vCis );
+    Vec_IntFree( p->vVar2Ci );
+    Vec_StrFree( p->vCube );
+    ABC_FREE( p );
+}
+
+/**Function*************************************************************
+
+  Synopsis    [Collects the cone of the node without modifying the network.]
+
+  Description [Appends the AND nodes in a topological order to vCone and
+  the CIs to vCis. Uses the thread-local marks instead of traversal IDs.]
+               
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+void Abc_NtkClpCollectCone( Abc_ClpWork_t * p, Abc_Ntk_t * pNtk, Abc_Obj_t * pRoot )
+{
+    Abc_Obj_t * pObj;
+    int Id;
+    Vec_IntClear( p->vStack );
+    Vec_IntPush( p->vStack, Abc_ObjId(pRoot) );
+    while ( Vec_IntSize(p->vStack) > 0 )
+    {
+        Id = Vec_IntPop( p->vStack );
+        if ( Id < 0 ) // all fanins are visited
+        {
+            Vec_IntPush( p->vCone, ~Id );
+            continue;
+        }
+        if ( Vec_IntEntry(p->vVisit, Id) == p->iVisit )
+            continue;
+        Vec_IntWriteEntry( p->vVisit, Id, p->iVisit );
+        pObj = Abc_NtkObj( pNtk, Id );
+        if ( Abc_ObjIsCi(pObj) )
+            Vec_IntPush( p->vCis, Id );
+        else if ( Abc_AigNodeIsAnd(pObj) )
+        {
+            Vec_IntPush( p->vStack, ~Id );
+            Vec_IntPush( p->vStack, Abc_ObjFaninId1(pObj) );
+            Vec_IntPush( p->vStack, Abc_ObjFaninId0(pObj) );
+        }
+    }
+}
+
+/**Function*************************************************************
+
+  Synopsis    [Releases the cached BDDs of the group.]
+
+  Description []
+               
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+void Abc_NtkClpFlushCache( Abc_ClpWork_t * p, DdManager * dd )
+{
+    int i, Id;
+    Vec_IntForEachEntry( p->vCacheIds, Id, i )
+        Cudd_RecursiveDeref( dd, (DdNode *)Vec_PtrEntry(p->vBdds, Id) );
+    Vec_IntClear( p->vCacheIds );
+    p->iCache++;
+}
+
+/**Function*************************************************************
+
+  Synopsis    [Builds the BDD of one CO within the budget.]
+
+  Description [Returns the referenced BDD or NULL if the number of new
+  nodes exceeded the budget or the time is out.]
+               
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+DdNode * Abc_NtkClpBuildOne( Abc_ClpMan_t * pMan, Abc_ClpWork_t * p, DdManager * dd, Abc_Obj_t * pCo )
+{
+    Abc_Ntk_t * pNtk = pMan->pNtk;
+    Abc_Obj_t * pObj, * pDriver = Abc_ObjFanin0(pCo);
+    DdNode * bFunc, * bFunc0, * bFunc1;
+    int i, Id, nLimit, nLive = Cudd_ReadKeys(dd) - Cudd_ReadDead(dd);
+    // collect the cone
+    p->iVisit++;
+    Vec_IntClear( p->vCone );
+    Vec_IntClear( p->vCis );
+    Abc_NtkClpCollectCone( p, pNtk, pDriver );
+    // build the BDDs of the nodes, which are not in the cache
+    dd->TimeStop = pMan->nTimeOut ? Abc_Clock() + (abctime)pMan->nTimeOut * CLOCKS_PER_SEC : 0;
+    Vec_IntForEachEntry( p->vCone, Id, i )
+    {
+        if ( Vec_IntEntry(p->vCached, Id) == p->iCache )
+            continue;
+        pObj   = Abc_NtkObj( pNtk, Id );
+        bFunc0 = Abc_ObjIsCi(Abc_ObjFanin0(pObj)) ? Cudd_bddIthVar(dd, Vec_IntEntry(p->vVarOf, Abc_ObjFaninId0(pObj))) : 
+                 Abc_AigNodeIsConst(Abc_ObjFanin0(pObj)) ? Cudd_ReadOne(dd) : (DdNode *)Vec_PtrEntry(p->vBdds, Abc_ObjFaninId0(pObj));
+        bFunc1 = Abc_ObjIsCi(Abc_ObjFanin1(pObj)) ? Cudd_bddIthVar(dd, Vec_IntEntry(p->vVarOf, Abc_ObjFaninId1(pObj))) : 
+                 Abc_AigNodeIsConst(Abc_ObjFanin1(pObj)) ? Cudd_ReadOne(dd) : (DdNode *)Vec_PtrEntry(p->vBdds, Abc_ObjFaninId1(pObj));
+        nLimit = pMan->nBddSizeMax - (Cudd_ReadKeys(dd) - Cudd_ReadDead(dd) - nLive);
+        bFunc  = nLimit <= 0 ? NULL : Cudd_bddAndLimit( dd, Cudd_NotCond(bFunc0, Abc_ObjFaninC0(pObj)), Cudd_NotCond(bFunc1, Abc_ObjFaninC1(pObj)), (unsigned)nLimit );
+        if ( bFunc == NULL )
+        {
+            dd->TimeStop = 0;
+            return NULL;
+        }
+        Cudd_Ref( bFunc );
+        Vec_PtrWriteEntry( p->vBdds, Id, bFunc );
+        Vec_IntWriteEntry( p->vCached, Id, p->iCache );
+        Vec_IntPush( p->vCacheIds, Id );
+    }
+    dd->TimeStop = 0;
+    // get the function of the CO
+    if ( Abc_ObjIsCi(pDriver) )
+        bFunc = Cudd_bddIthVar( dd, Vec_IntEntry(p->vVarOf, Abc_ObjId(pDriver)) );
+    else if ( Abc_AigNodeIsConst(pDriver) )
+        bFunc = Cudd_ReadOne( dd );
+    else
+        bFunc = (DdNode *)Vec_PtrEntry( p->vBdds, Abc_ObjId(pDriver) );
+    bFunc = Cudd_NotCond( bFunc, Abc_ObjFaninC0(pCo) );  Cudd_Ref( bFunc );
+    return bFunc;
+}
+
+/**Function*************************************************************
+
+  Synopsis    [Derives the SOPs of one group of COs.]
+
+  Description []
+               
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+void Abc_NtkClpGroup( Abc_ClpMan_t * pMan, Abc_ClpWork_t * p, int iGroup )
+{
+    Abc_Ntk_t * pNtk = pMan->pNtk;
+    Abc_Obj_t * pCo;
+    DdManager * dd;
+    DdNode * bFunc, * bSupp, * bTemp, * bRes;
+    Vec_Int_t * vSupp;
+    int * pPermute;
+    int i, Id, nSupp, iStart = iGroup * pMan->nGroupSize;
+    int iStop = Abc_MinInt( iStart + pMan->nGroupSize, Abc_NtkCoNum(pNtk) );
+    // assign local variables to the CIs of the group
+    p->iVisit++;
+    Vec_IntClear( p->vCone );
+    Vec_IntClear( p->vCis );
+    for ( i = iStart; i < iStop; i++ )
+        Abc_NtkClpCollectCone( p, pNtk, Abc_ObjFanin0(Abc_NtkCo(pNtk, i)) );
+    Vec_IntClear( p->vVar2Ci );
+    Vec_IntForEachEntry( p->vCis, Id, i )
+    {
+        Vec_IntWriteEntry( p->vVarOf, Id, i );
+        Vec_IntPush( p->vVar2Ci, Vec_IntEntry(pMan->vCiIds, Id) );
+    }
+    // start the manager of this group
+    dd = Cudd_Init( Vec_IntSize(p->vCis), 0, CUDD_UNIQUE_SLOTS, CUDD_CACHE_SLOTS, 0 );
+    if ( Vec_IntSize(p->vCis) > 0 )
+        Cudd_zddVarsFromBddVars( dd, 2 );
+    if ( pMan->fReorder )
+        Cudd_AutodynEnable( dd, CUDD_REORDER_SYMM_SIFT );
+    pPermute = ABC_ALLOC( int, Abc_MaxInt(1, Vec_IntSize(p->vCis)) );
+    p->iCache++;
+    for ( i = iStart; i < iStop; i++ )
+    {
+        pCo = Abc_NtkCo( pNtk, i );
+        bFunc = Abc_NtkClpBuildOne( pMan, p, dd, pCo );
+        if ( bFunc == NULL )
+        {
+            // drop the cached BDDs, which may be large
+            Abc_NtkClpFlushCache( p, dd );
+            continue;
+        }
+        // move the support to the topmost variables in the current order
+        vSupp = Vec_WecEntry( pMan->vSupps, i );
+        bSupp = Cudd_Support( dd, bFunc );  Cudd_Ref( bSupp );
+        nSupp = 0;
+        for ( bTemp = bSupp; bTemp != Cudd_ReadOne(dd); bTemp = cuddT(bTemp) )
+        {
+            Vec_IntPush( vSupp, Vec_IntEntry(p->vVar2Ci, bTemp->index) );
+            pPermute[bTemp->index] = nSupp++;
+        }
+        Cudd_RecursiveDeref( dd, bSupp );
+        bRes = Cudd_bddPermute( dd, bFunc, pPermute );  Cudd_Ref( bRes );
+        Cudd_RecursiveDeref( dd, bFunc );
+        // derive the SOP
+        pMan->ppSops[i] = Abc_ConvertBddToSop( NULL, dd, bRes, bRes, nSupp, 0, p->vCube, -1 );
+        Cudd_RecursiveDeref( dd, bRes );
+        if ( pMan->ppSops[i] == NULL )
+            Vec_IntClear( vSupp );
+    }
+    Abc_NtkClpFlushCache( p, dd );
+    ABC_FREE( pPermute );
+    Extra_StopManager( dd );
+}
+
+/**Function*************************************************************
+
+  Synopsis    [Processes the groups of COs using several threads.]
+
+  Description []
+               
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+#ifndef ABC_USE_PTHREADS
+
+void Abc_NtkClpGroups( Abc_ClpMan_t * pMan, int nGroups, int nProcs )
+{
+    Abc_ClpWork_t * p = Abc_NtkClpWorkStart( pMan->pNtk );
+    int i;
+    for ( i = 0; i < nGroups; i++ )
+        Abc_NtkClpGroup( pMan, p, i );
+    Abc_NtkClpWorkStop( p );
+}
+
+#else // pthreads are used
+
+#define PAR_THR_MAX 100
+typedef struct Abc_ClpThData_t_
+{
+    Abc_ClpMan_t *  pMan;
+    Abc_ClpWork_t * pWork;
+    int             Index;
+    int             fWorking;
+} Abc_ClpThData_t;
+
+void * Abc_NtkClpWorkerThread( void * pArg )
+{
+    Abc_ClpThData_t * pThData = (Abc_ClpThData_t *)pArg;
+    volatile int * pPlace = &pThData->fWorking;
+    while ( 1 )
+    {
+        while ( *pPlace == 0 );
+        assert( pThData->fWorking );
+        if ( pThData->Index == -1 )
+        {
+            pthread_exit( NULL );
+            assert( 0 );
+            return NULL;
+        }
+        Abc_NtkClpGroup( pThData->pMan, pThData->pWork, pThData->Index );
+        pThData->fWorking = 0;
+    }
+    assert( 0 );
+    return NULL;
+}
+
+void Abc_NtkClpGroups( Abc_ClpMan_t * pMan, int nGroups, int nProcs )
+{
+    Abc_ClpThData_t ThData[PAR_THR_MAX];
+    pthread_t WorkerThread[PAR_THR_MAX];
+    int i, k, status;
+    if ( nProcs < 2 || nGroups < 2 )
+    {
+        Abc_ClpWork_t * p = Abc_NtkClpWorkStart( pMan->pNtk );
+        for ( k = 0; k < nGroups; k++ )
+            Abc_NtkClpGroup( pMan, p, k );
+        Abc_NtkClpWorkStop( p );
+        return;
+    }
+    // subtract manager thread
+    nProcs = Abc_MinInt( nProcs - 1, nGroups );
+    assert( nProcs >= 1 && nProcs <= PAR_THR_MAX );
+    // start threads
+    for ( i = 0; i < nProcs; i++ )
+    {
+        ThData[i].pMan     = pMan;
+        ThData[i].pWork    = Abc_NtkClpWorkStart( pMan->pNtk );
+        ThData[i].Index    = -1;
+        ThData[i].fWorking = 0;
+        status = pthread_create( WorkerThread + i, NULL, Abc_NtkClpWorkerThread, (void *)(ThData + i) );  assert( status == 0 );
+    }
+    // distribute the groups
+    for ( k = 0; k < nGroups; k++ )
+    {
+        for ( i = 0; i < nProcs; i++ )
+        {
+            if ( ThData[i].fWorking )
+                continue;
+            ThData[i].Index = k;
+            ThData[i].fWorking = 1;
+            break;
+        }
+        if ( i == nProcs )
+            k--;
+    }
+    // wait till threads finish
+    for ( i = 0; i < nProcs; i++ )
+        if ( ThData[i].fWorking )
+            i = -1;
+    // stop threads
+    for ( i = 0; i < nProcs; i++ )
+    {
+        assert( !ThData[i].fWorking );
+        ThData[i].Index = -1;
+        ThData[i].fWorking = 1;
+    }
+    for ( i = 0; i < nProcs; i++ )
+    {
+        pthread_join( WorkerThread[i], NULL );
+        Abc_NtkClpWorkStop( ThData[i].pWork );
+    }
+}
+
+#endif // pthreads are used
+
+/**Function*************************************************************
+
+  Synopsis    [Copies the cone of the CO driver as AND gates.]
+
+  Description [Used for the COs whose BDDs exceeded the limits. The nodes
+  are shared among such COs through the pCopy fields.]
+               
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+Abc_Obj_t * Abc_NtkClpCopyCone( Abc_Ntk_t * pNtkNew, Abc_Ntk_t * pNtk, Abc_Obj_t * pCo )
+{
+    Vec_Ptr_t * vNodes;
+    Abc_Obj_t * pObj, * pDriver = Abc_ObjFanin0(pCo);
+    int i, pfCompl[2];
+    if ( Abc_AigNodeIsConst(pDriver) )
+        return Abc_ObjFaninC0(pCo) ? Abc_NtkCreateNodeConst0(pNtkNew) : Abc_NtkCreateNodeConst1(pNtkNew);
+    vNodes = Abc_NtkDfsNodes( pNtk, &pDriver, 1 );
+    Vec_PtrForEachEntry( Abc_Obj_t *, vNodes, pObj, i )
+    {
+        if ( pObj->pCopy )
+            continue;
+        pObj->pCopy = Abc_NtkCreateNode( pNtkNew );
+        Abc_ObjAddFanin( pObj->pCopy, Abc_ObjFanin0(pObj)->pCopy );
+        Abc_ObjAddFanin( pObj->pCopy, Abc_ObjFanin1(pObj)->pCopy );
+        pfCompl[0] = Abc_ObjFaninC0(pObj);
+        pfCompl[1] = Abc_ObjFaninC1(pObj);
+        pObj->pCopy->pData = Abc_SopCreateAnd( (Mem_Flex_t *)pNtkNew->pManFunc, 2, pfCompl );
+    }
+    Vec_PtrFree( vNodes );
+    if ( Abc_ObjFaninC0(pCo) )
+        return Abc_NtkCreateNodeInv( pNtkNew, pDriver->pCopy );
+    return pDriver->pCopy;
+}
+
+/**Function*************************************************************
+
+  Synopsis    [Collapses the network using partitioned global BDDs.]
+
+  Description [The global BDDs of the COs are built in groups, each group
+  in its own CUDD manager, using several threads. Each CO is limited by
+  nBddSizeMax new BDD nodes and nTimeOut seconds. The COs that exceed the
+  limits keep their multi-level AIG structure. The result is the SOP
+  logic network, so the BDDs are never transferred into a common manager.]
+               
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+Abc_Ntk_t * Abc_NtkCollapsePar( Abc_Ntk_t * pNtk, int nBddSizeMax, int nTimeOut, int nProcs, int fReorder, int fVerbose )
+{
+    Abc_ClpMan_t Man, * pMan = &Man;
+    Abc_Ntk_t * pNtkNew;
+    Abc_Obj_t * pObj, * pDriver, * pNodeNew;
+    int i, k, iCi, nGroups, nFailed = 0;
+    abctime clk = Abc_Clock();
+    assert( Abc_NtkIsStrash(pNtk) );
+    if ( pNtk->pExdc )
+    {
+        printf( "Abc_NtkCollapsePar(): The EXDC network is not supported.\n" );
+        return NULL;
+    }
+    Abc_AigCleanup( (Abc_Aig_t *)pNtk->pManFunc );
+    // derive the SOPs
+    memset( pMan, 0, sizeof(Abc_ClpMan_t) );
+    pMan->pNtk        = pNtk;
+    pMan->nBddSizeMax = nBddSizeMax;
+    pMan->nTimeOut    = nTimeOut;
+    pMan->fReorder    = fReorder;
+    pMan->nGroupSize  = Abc_MaxInt( 1, Abc_NtkCoNum(pNtk) / (4 * Abc_MaxInt(1, nProcs)) );
+    pMan->ppSops      = ABC_CALLOC( char *, Abc_NtkCoNum(pNtk) );
+    pMan->vSupps      = Vec_WecStart( Abc_NtkCoNum(pNtk) );
+    pMan->vCiIds      = Vec_IntStartFull( Abc_NtkObjNumMax(pNtk) );
+    Abc_NtkForEachCi( pNtk, pObj, i )
+        Vec_IntWriteEntry( pMan->vCiIds, Abc_ObjId(pObj), i );
+    nGroups = (Abc_NtkCoNum(pNtk) + pMan->nGroupSize - 1) / pMan->nGroupSize;
+    Abc_NtkClpGroups( pMan, nGroups, nProcs );
+    if ( fVerbose )
+    {
+        printf( "Built BDDs for %d outputs in %d groups using %d threads.  ", Abc_NtkCoNum(pNtk), nGroups, nProcs );
+        ABC_PRT( "Time", Abc_Clock() - clk );
+    }
+    // create the new network
+    pNtkNew = Abc_NtkStartFrom( pNtk, ABC_NTK_LOGIC, ABC_FUNC_SOP );
+    Abc_NtkForEachCo( pNtk, pObj, i )
+    {
+        pDriver = Abc_ObjFanin0(pObj);
+        if ( Abc_ObjIsCi(pDriver) && !strcmp(Abc_ObjName(pObj), Abc_ObjName(pDriver)) )
+            pNodeNew = pDriver->pCopy;
+        else if ( pMan->ppSops[i] )
+        {
+            pNodeNew = Abc_NtkCreateNode( pNtkNew );
+            Vec_IntForEachEntry( Vec_WecEntry(pMan->vSupps, i), iCi, k )
+                Abc_ObjAddFanin( pNodeNew, Abc_NtkCi(pNtkNew, iCi) );
+            pNodeNew->pData = Abc_SopRegister( (Mem_Flex_t *)pNtkNew->pManFunc, pMan->ppSops[i] );
+        }
+        else
+        {
+            pNodeNew = Abc_NtkClpCopyCone( pNtkNew, pNtk, pObj );
+            nFailed++;
+        }
+        Abc_ObjAddFanin( pObj->pCopy, pNodeNew );
+        ABC_FREE( pMan->ppSops[i] );
+    }
+    ABC_FREE( pMan->ppSops );
+    Vec_WecFree( pMan->vSupps );
+    Vec_IntFree( pMan->vCiIds );
+    if ( fVerbose )
+    {
+        printf( "Collapsed %d outputs. Kept the structure of %d outputs, which exceeded the limits.  ", Abc_NtkCoNum(pNtk) - nFailed, nFailed );
+        ABC_PRT( "Total time", Abc_Clock() - clk );
+    }
+    // make sure that everything is okay
+    if ( !Abc_NtkCheck( pNtkNew ) )
+    {
+        printf( "Abc_NtkCollapsePar: The network check has failed.\n" );
+        Abc_NtkDelete( pNtkNew );
+        return NULL;
+    }
+    return pNtkNew;
+}
+
 
 #else
 
@@ -251,6 +782,10 @@ Abc_Ntk_t * Abc_NtkCollapse( Abc_Ntk_t * pNtk, int fBddSizeMax, int fDualRail, i
 {
     return NULL;
 }
+Abc_Ntk_t * Abc_NtkCollapsePar( Abc_Ntk_t * pNtk, int nBddSizeMax, int nTimeOut, int nProcs, int fReorder, int fVerbose )
+{
+    return NULL;
+}
 
 #endif
 
@@ -2577,7 +2577,7 @@ int Abc_NtkDarBmcInter_int( Aig_Man_t * pMan, Inter_ManParams_t * pPars, Aig_Man
 //                pNtk->pModel = pTemp->pData, pTemp->pData = NULL;
             }
             else
-                RetValue = Inter_ManPerformInterpolation( pTemp, pPars, &iFrame );
+                RetValue = Inter_ManPerformPortfolio( pTemp, pPars, &iFrame );
             if ( pTemp->pSeqModel )
             {
                 if ( pPars->fDropSatOuts )
@@ -2628,7 +2628,7 @@ int Abc_NtkDarBmcInter_int( Aig_Man_t * pMan, Inter_ManParams_t * pPars, Aig_Man
     }
     else
     {    
-        RetValue = Inter_ManPerformInterpolation( pMan, pPars, &iFrame );
+        RetValue = Inter_ManPerformPortfolio( pMan, pPars, &iFrame );
     }
     if ( nTotalProvedSat )
         Abc_Print( 1, "The total of %d outputs proved SAT and replaced by const 0 in this run.\n", nTotalProvedSat );
@@ -174,7 +174,7 @@ void Abc_TruthNpnPrint( char * pCanonPermInit, unsigned uCanonPhase, int nVars )
   SeeAlso     []
 
 ***********************************************************************/
-void Abc_TruthNpnPerform( Abc_TtStore_t * p, int NpnType, int fVerbose )
+void Abc_TruthNpnPerform( Abc_TtStore_t * p, int NpnType, int nProcs, int fVerbose )
 {
     unsigned pAux[2048];
     word pAuxWord[1024], pAuxWord1[1024];
@@ -279,16 +279,23 @@ void Abc_TruthNpnPerform( Abc_TtStore_t * p, int NpnType, int fVerbose )
                 Extra_PrintHex( stdout, (unsigned *)p->pFuncs[i], p->nVars ), Abc_TruthNpnPrint(pCanonPerm, uCanonPhase, p->nVars), printf( "\n" );
         }
     }
-    else if ( NpnType == 5 )
+    else if ( NpnType == 5 || NpnType == 12 )
     {
+        Abc_TtCanMan_t * pMan = Abc_TtCanManStart( p->nVars, NpnType == 12, nProcs );
+        unsigned * pPhases = ABC_ALLOC( unsigned, p->nFuncs );
+        char * pPerms = ABC_ALLOC( char, p->nFuncs * p->nVars );
+        Abc_TtCanonicizeBatch( pMan, p->pFuncs, p->nFuncs, pPhases, pPerms );
+        if ( fVerbose )
         for ( i = 0; i < p->nFuncs; i++ )
         {
-            if ( fVerbose )
-                printf( "%7d : ", i );
-            uCanonPhase = Abc_TtCanonicize( p->pFuncs[i], p->nVars, pCanonPerm );
-            if ( fVerbose )
-                Extra_PrintHex( stdout, (unsigned *)p->pFuncs[i], p->nVars ), Abc_TruthNpnPrint(pCanonPerm, uCanonPhase, p->nVars), printf( "\n" );
+            printf( "%7d : ", i );
+            Extra_PrintHex( stdout, (unsigned *)p->pFuncs[i], p->nVars ), Abc_TruthNpnPrint(pPerms + i * p->nVars, pPhases[i], p->nVars), printf( "\n" );
         }
+        if ( fVerbose )
+            Abc_TtCanManPrintStats( pMan );
+        Abc_TtCanManStop( pMan );
+        ABC_FREE( pPhases );
+        ABC_FREE( pPerms );
     }
     else if ( NpnType == 6 )
     {
@@ -358,17 +365,6 @@ void Abc_TruthNpnPerform( Abc_TtStore_t * p, int NpnType, int fVerbose )
         }
 		Abc_TtHieManStop(pMan);
     }
-    else if ( NpnType == 12 )
-    {
-        for ( i = 0; i < p->nFuncs; i++ )
-        {
-            if ( fVerbose )
-                printf( "%7d : ", i );
-            uCanonPhase = Abc_TtCanonicizePerm( p->pFuncs[i], p->nVars, pCanonPerm );
-            if ( fVerbose )
-                Extra_PrintHex( stdout, (unsigned *)p->pFuncs[i], p->nVars ), Abc_TruthNpnPrint(pCanonPerm, uCanonPhase, p->nVars), printf( "\n" );
-        }
-    }
     else assert( 0 );
     clk = Abc_Clock() - clk;
     printf( "Classes =%9d  ", Abc_TruthNpnCountUnique(p) );
@@ -386,7 +382,7 @@ void Abc_TruthNpnPerform( Abc_TtStore_t * p, int NpnType, int fVerbose )
   SeeAlso     []
 
 ***********************************************************************/
-void Abc_TruthNpnTest( char * pFileName, int NpnType, int nVarNum, int fDumpRes, int fBinary, int fVerbose )
+void Abc_TruthNpnTest( char * pFileName, int NpnType, int nVarNum, int nProcs, int fDumpRes, int fBinary, int fVerbose )
 {
     Abc_TtStore_t * p;
     char * pFileNameOut;
@@ -397,7 +393,7 @@ void Abc_TruthNpnTest( char * pFileName, int NpnType, int nVarNum, int fDumpRes,
         return;
 
     // consider functions from the file
-    Abc_TruthNpnPerform( p, NpnType, fVerbose );
+    Abc_TruthNpnPerform( p, NpnType, nProcs, fVerbose );
 
     // write the result
     if ( fDumpRes )
@@ -428,12 +424,12 @@ void Abc_TruthNpnTest( char * pFileName, int NpnType, int nVarNum, int fDumpRes,
   SeeAlso     []
 
 ***********************************************************************/
-int Abc_NpnTest( char * pFileName, int NpnType, int nVarNum, int fDumpRes, int fBinary, int fVerbose )
+int Abc_NpnTest( char * pFileName, int NpnType, int nVarNum, int nProcs, int fDumpRes, int fBinary, int fVerbose )
 {
     if ( fVerbose )
         printf( "Using truth tables from file \"%s\"...\n", pFileName );
     if ( NpnType >= 0 && NpnType <= 12 )
-        Abc_TruthNpnTest( pFileName, NpnType, nVarNum, fDumpRes, fBinary, fVerbose );
+        Abc_TruthNpnTest( pFileName, NpnType, nVarNum, nProcs, fDumpRes, fBinary, fVerbose );
     else
         printf( "Unknown canonical form value (%d).\n", NpnType );
     fflush( stdout );
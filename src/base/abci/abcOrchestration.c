@@ -35,10 +35,6 @@ static Cut_Man_t * Abc_NtkStartCutManForRewrite( Abc_Ntk_t * pNtk );
 extern void        Abc_NodePrintCuts( Abc_Obj_t * pNode );
 extern void        Abc_ManShowCutCone( Abc_Obj_t * pNode, Vec_Ptr_t * vLeaves );
 
-extern void  Abc_PlaceBegin( Abc_Ntk_t * pNtk );
-extern void  Abc_PlaceEnd( Abc_Ntk_t * pNtk );
-extern void  Abc_PlaceUpdate( Vec_Ptr_t * vAddedCells, Vec_Ptr_t * vUpdatedNets );
-
 extern int         Dec_GraphUpdateNetwork( Abc_Obj_t * pRoot, Dec_Graph_t * pGraph, int fUpdateLevel, int nGain );
 
 #define ABC_RS_DIV1_MAX    150   // the max number of divisors to consider
@@ -6,10 +6,10 @@
 
   PackageName [Network and node package.]
 
-  Synopsis    [Interface with a placer.]
+  Synopsis    [Incremental placement for placement-aware AIG rewriting.]
 
   Author      [Alan Mishchenko]
-  
+
   Affiliation [UC Berkeley]
 
   Date        [Ver. 1.0. Started - June 20, 2005.]
@@ -18,11 +18,9 @@
 
 ***********************************************************************/
 
+#include <math.h>
 #include "base/abc/abc.h"
 
-// placement includes
-#include "phys/place/place_base.h"
-
 ABC_NAMESPACE_IMPL_START
 
 
@@ -30,10 +28,44 @@ ABC_NAMESPACE_IMPL_START
 ///                        DECLARATIONS                              ///
 ////////////////////////////////////////////////////////////////////////
 
-AbstractCell *abstractCells = NULL;
-ConcreteCell *cells = NULL;
-ConcreteNet *nets = NULL;
-int nAllocSize = 0;
+// The placement is kept for the objects of a strashed network. Each CI
+// or AND node drives a net composed of the driver and its fanouts. The
+// cost of a net is its half-perimeter wire length (HPWL), which is cached
+// for each driver. The CIs and COs are placed as fixed pads on the left
+// and right sides of the die. The AND nodes are placed by levels in the
+// X-direction and by barycentric smoothing in the Y-direction. When the
+// network is updated, the new nodes are placed at the barycenters of
+// their fanins and fanouts, and only the nets around them are recomputed.
+
+typedef struct Abc_Plc_t_ Abc_Plc_t;
+struct Abc_Plc_t_
+{
+    Abc_Ntk_t *     pNtk;          // the network
+    Vec_Flt_t *     vX;            // X-coordinates of the objects
+    Vec_Flt_t *     vY;            // Y-coordinates of the objects
+    Vec_Flt_t *     vBoxes;        // cached bounding boxes of the nets driven by the objects
+    Vec_Int_t *     vStamps;       // the last update, in which the net was recomputed
+    Vec_Ptr_t *     vAddedCells;   // the added nodes (owned by the AIG manager)
+    Vec_Ptr_t *     vUpdatedNets;  // the nodes whose fanouts have changed (owned by the AIG manager)
+    Vec_Ptr_t *     vCone;         // temporary storage for the MFFC
+    float           Side;          // the side of the die
+    float           HpwlBeg;       // the HPWL after the initial placement
+    int             nEvals;        // the number of evaluated cuts
+    int             nUpdates;      // the number of incremental updates
+    int             nNetsUpdated;  // the number of recomputed nets
+    abctime         timeInit;      // the runtime of the initial placement
+    abctime         timeEval;      // the runtime of the cut evaluation
+    abctime         timeUpdate;    // the runtime of the incremental updates
+};
+
+#define ABC_PLACE_PASSES  4        // the number of smoothing passes
+#define ABC_PLACE_FANOUTS 16       // the fanout count, above which the cached box is extended
+
+static inline Abc_Plc_t * Abc_PlaceMan( Abc_Ntk_t * pNtk )     { return (Abc_Plc_t *)pNtk->pManPlace;            }
+static inline float       Abc_PlaceX( Abc_Plc_t * p, Abc_Obj_t * pObj )  { return Vec_FltEntry( p->vX, Abc_ObjId(pObj) ); }
+static inline float       Abc_PlaceY( Abc_Plc_t * p, Abc_Obj_t * pObj )  { return Vec_FltEntry( p->vY, Abc_ObjId(pObj) ); }
+static inline float *     Abc_PlaceBox( Abc_Plc_t * p, Abc_Obj_t * pObj ){ return Vec_FltEntryP( p->vBoxes, 4*Abc_ObjId(pObj) ); }
+static inline float       Abc_PlaceCost( Abc_Plc_t * p, Abc_Obj_t * pObj ) { float * pBox = Abc_PlaceBox(p, pObj); return (pBox[1] - pBox[0]) + (pBox[3] - pBox[2]); }
 
 ////////////////////////////////////////////////////////////////////////
 ///                     FUNCTION DEFINITIONS                         ///
@@ -41,214 +73,419 @@ int nAllocSize = 0;
 
 /**Function*************************************************************
 
-  Synopsis    [Creates a new cell.]
+  Synopsis    [Makes sure there is room for the new objects.]
 
   Description []
-               
+
   SideEffects []
 
   SeeAlso     []
 
 ***********************************************************************/
-static inline void Abc_PlaceCreateCell( Abc_Obj_t * pObj, int fAnd )
+static inline void Abc_PlaceResize( Abc_Plc_t * p )
 {
-    assert( cells[pObj->Id].m_id == 0 );
+    int nObjs = Abc_NtkObjNumMax( p->pNtk );
+    if ( Vec_FltSize(p->vX) >= nObjs )
+        return;
+    nObjs = Abc_MaxInt( nObjs, 2 * Vec_FltSize(p->vX) );
+    Vec_FltFillExtra( p->vX, nObjs, 0.0 );
+    Vec_FltFillExtra( p->vY, nObjs, 0.0 );
+    Vec_FltFillExtra( p->vBoxes, 4*nObjs, 0.0 );
+    Vec_IntFillExtra( p->vStamps, nObjs, -1 );
+}
+
+/**Function*************************************************************
+
+  Synopsis    [Places the object at the barycenter of its neighbors.]
+
+  Description [If fFanouts is 0, only the fanins are considered.]
 
-    cells[pObj->Id].m_id = pObj->Id;
-    cells[pObj->Id].m_label = "";
-    cells[pObj->Id].m_parent = &(abstractCells[fAnd]);
-    cells[pObj->Id].m_fixed = 0;
-    addConcreteCell(&(cells[pObj->Id]));
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+static inline void Abc_PlaceObjCenter( Abc_Plc_t * p, Abc_Obj_t * pObj, int fFanouts )
+{
+    Abc_Obj_t * pNext;
+    float X = 0.0, Y = 0.0;
+    int k, nNexts = 0;
+    Abc_ObjForEachFanin( pObj, pNext, k )
+    {
+        X += Abc_PlaceX( p, pNext );
+        Y += Abc_PlaceY( p, pNext );
+        nNexts++;
+    }
+    if ( fFanouts )
+    Abc_ObjForEachFanout( pObj, pNext, k )
+    {
+        X += Abc_PlaceX( p, pNext );
+        Y += Abc_PlaceY( p, pNext );
+        nNexts++;
+    }
+    if ( nNexts == 0 )
+        return;
+    Vec_FltWriteEntry( p->vX, Abc_ObjId(pObj), X / nNexts );
+    Vec_FltWriteEntry( p->vY, Abc_ObjId(pObj), Y / nNexts );
 }
 
 /**Function*************************************************************
 
-  Synopsis    [Updates the net.]
+  Synopsis    [Computes the bounding box of the net driven by the object.]
+
+  Description [The box is stored as Xmin, Xmax, Ymin, Ymax.]
 
-  Description []
-               
   SideEffects []
 
   SeeAlso     []
 
 ***********************************************************************/
-static inline void Abc_PlaceUpdateNet( Abc_Obj_t * pObj )
+static inline void Abc_PlaceBoxAdd( float * pBox, float X, float Y )
+{
+    pBox[0] = Abc_MinFloat( pBox[0], X );  pBox[1] = Abc_MaxFloat( pBox[1], X );
+    pBox[2] = Abc_MinFloat( pBox[2], Y );  pBox[3] = Abc_MaxFloat( pBox[3], Y );
+}
+static inline void Abc_PlaceNetBox( Abc_Plc_t * p, Abc_Obj_t * pObj, float * pBox )
 {
     Abc_Obj_t * pFanout;
     int k;
-    // free the old array of net terminals
-    if ( nets[pObj->Id].m_terms )
-        free( nets[pObj->Id].m_terms );
-    // fill in the net with the new information
-    nets[pObj->Id].m_id = pObj->Id;
-    nets[pObj->Id].m_weight = 1.0;
-    nets[pObj->Id].m_numTerms = Abc_ObjFanoutNum(pObj); //fanout
-    nets[pObj->Id].m_terms = ALLOC(ConcreteCell*, Abc_ObjFanoutNum(pObj));
+    pBox[0] = pBox[1] = Abc_PlaceX( p, pObj );
+    pBox[2] = pBox[3] = Abc_PlaceY( p, pObj );
     Abc_ObjForEachFanout( pObj, pFanout, k )
-        nets[pObj->Id].m_terms[k] = &(cells[pFanout->Id]);
-    addConcreteNet(&(nets[pObj->Id]));
+        Abc_PlaceBoxAdd( pBox, Abc_PlaceX(p, pFanout), Abc_PlaceY(p, pFanout) );
+}
+static inline void Abc_PlaceUpdateNet( Abc_Plc_t * p, Abc_Obj_t * pObj )
+{
+    if ( Abc_ObjType(pObj) == ABC_OBJ_NONE ) // dead node
+        return;
+    if ( !Abc_ObjIsCi(pObj) && !Abc_ObjIsNode(pObj) )
+        return;
+    if ( Vec_IntEntry(p->vStamps, Abc_ObjId(pObj)) == p->nUpdates )
+        return;
+    Vec_IntWriteEntry( p->vStamps, Abc_ObjId(pObj), p->nUpdates );
+    Abc_PlaceNetBox( p, pObj, Abc_PlaceBox(p, pObj) );
+    p->nNetsUpdated++;
+}
+static inline void Abc_PlaceUpdateNetTerm( Abc_Plc_t * p, Abc_Obj_t * pObj, Abc_Obj_t * pTerm )
+{
+    // large nets are extended by the new terminal rather than recomputed
+    if ( Abc_ObjFanoutNum(pObj) > ABC_PLACE_FANOUTS && Vec_IntEntry(p->vStamps, Abc_ObjId(pObj)) >= 0 )
+        Abc_PlaceBoxAdd( Abc_PlaceBox(p, pObj), Abc_PlaceX(p, pTerm), Abc_PlaceY(p, pTerm) );
+    else
+        Abc_PlaceUpdateNet( p, pObj );
 }
 
 /**Function*************************************************************
 
-  Synopsis    [Returns the placement cost of the cut.]
+  Synopsis    [Returns the total HPWL of the current placement.]
 
   Description []
-               
+
   SideEffects []
 
   SeeAlso     []
 
 ***********************************************************************/
-float Abc_PlaceEvaluateCut( Abc_Obj_t * pRoot, Vec_Ptr_t * vFanins )
+float Abc_PlaceReadHpwl( Abc_Ntk_t * pNtk )
 {
+    Abc_Plc_t * p = Abc_PlaceMan( pNtk );
     Abc_Obj_t * pObj;
-//    double x, y;
+    float Box[4], Hpwl = 0.0;
     int i;
+    if ( p == NULL )
+        return 0.0;
+    Abc_NtkForEachObj( pNtk, pObj, i )
+        if ( Abc_ObjIsCi(pObj) || Abc_ObjIsNode(pObj) )
+        {
+            Abc_PlaceNetBox( p, pObj, Box );
+            Hpwl += (Box[1] - Box[0]) + (Box[3] - Box[2]);
+        }
+    return Hpwl;
+}
+
+/**Function*************************************************************
+
+  Synopsis    [Computes the initial placement.]
+
+  Description []
+
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+void Abc_PlaceInitial( Abc_Plc_t * p )
+{
+    Abc_Ntk_t * pNtk = p->pNtk;
+    Abc_Obj_t * pObj;
+    Vec_Ptr_t * vNodes;
+    int i, k, LevelMax;
+    p->Side  = (float)Abc_MaxInt( 1, (int)sqrt((double)Abc_NtkObjNum(pNtk)) );
+    LevelMax = Abc_AigLevel( pNtk );
+    // the pads
+    Abc_NtkForEachCi( pNtk, pObj, i )
+    {
+        Vec_FltWriteEntry( p->vX, Abc_ObjId(pObj), 0.0 );
+        Vec_FltWriteEntry( p->vY, Abc_ObjId(pObj), p->Side * (i + 0.5) / Abc_NtkCiNum(pNtk) );
+    }
+    Abc_NtkForEachCo( pNtk, pObj, i )
+    {
+        Vec_FltWriteEntry( p->vX, Abc_ObjId(pObj), p->Side );
+        Vec_FltWriteEntry( p->vY, Abc_ObjId(pObj), p->Side * (i + 0.5) / Abc_NtkCoNum(pNtk) );
+    }
+    Vec_FltWriteEntry( p->vX, Abc_ObjId(Abc_AigConst1(pNtk)), 0.0 );
+    Vec_FltWriteEntry( p->vY, Abc_ObjId(Abc_AigConst1(pNtk)), 0.0 );
+    // the nodes are placed by levels and pulled towards their fanins
+    vNodes = Abc_NtkDfs( pNtk, 0 );
+    Vec_PtrForEachEntry( Abc_Obj_t *, vNodes, pObj, i )
+    {
+        Abc_PlaceObjCenter( p, pObj, 0 );
+        Vec_FltWriteEntry( p->vX, Abc_ObjId(pObj), p->Side * pObj->Level / (LevelMax + 1) );
+    }
+    // smooth the Y-coordinates using both fanins and fanouts
+    for ( k = 0; k < ABC_PLACE_PASSES; k++ )
+    {
+        Vec_PtrForEachEntry( Abc_Obj_t *, vNodes, pObj, i )
+            Abc_PlaceObjCenter( p, pObj, 1 );
+        Vec_PtrForEachEntry( Abc_Obj_t *, vNodes, pObj, i )
+            Vec_FltWriteEntry( p->vX, Abc_ObjId(pObj), p->Side * pObj->Level / (LevelMax + 1) );
+    }
+    Vec_PtrFree( vNodes );
+    // compute the nets
+    p->HpwlBeg = 0.0;
+    Abc_NtkForEachObj( pNtk, pObj, i )
+    {
+        Abc_PlaceUpdateNet( p, pObj );
+        if ( Abc_ObjIsCi(pObj) || Abc_ObjIsNode(pObj) )
+            p->HpwlBeg += Abc_PlaceCost( p, pObj );
+    }
+    p->nNetsUpdated = 0;
+}
+
+/**Function*************************************************************
+
+  Synopsis    [Collects the MFFC nodes between the root and the leaves.]
+
+  Description [Relies on the MFFC being labeled with the current
+  traversal ID, as done by Abc_NodeMffcLabelAig().]
+
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+static void Abc_PlaceCollectMffc_rec( Abc_Obj_t * pObj, Vec_Ptr_t * vCone )
+{
+    if ( !Abc_ObjIsNode(pObj) || !Abc_NodeIsTravIdCurrent(pObj) )
+        return;
+    if ( Vec_PtrPushUnique( vCone, pObj ) )
+        return;
+    Abc_PlaceCollectMffc_rec( Abc_ObjFanin0(pObj), vCone );
+    Abc_PlaceCollectMffc_rec( Abc_ObjFanin1(pObj), vCone );
+}
+
+/**Function*************************************************************
+
+  Synopsis    [Returns the placement cost of the cut.]
+
+  Description [Estimates the change of HPWL if the MFFC of the root
+  bounded by the leaves is replaced by new nodes over these leaves.
+  The new nodes are assumed to be placed at the barycenter of the leaves
+  and the root. Only the nets of the leaves, of the root, and of the
+  MFFC nodes are visited; the HPWL of the untouched nets is read from
+  the cache. Assumes that the MFFC is labeled with the current traversal
+  ID. Returns 0 if the placement is not started.]
+
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+float Abc_PlaceEvaluateCut( Abc_Obj_t * pRoot, Vec_Ptr_t * vFanins )
+{
+    Abc_Plc_t * p = Abc_PlaceMan( pRoot->pNtk );
+    Abc_Obj_t * pObj, * pFanout;
+    float Xc, Yc, Box[4], Delta = 0.0;
+    int i, k;
+    abctime clk;
+    if ( p == NULL )
+        return 0.0;
+    clk = Abc_Clock();
+    // the barycenter of the leaves and the root
+    Xc = Abc_PlaceX( p, pRoot );
+    Yc = Abc_PlaceY( p, pRoot );
     Vec_PtrForEachEntry( Abc_Obj_t *, vFanins, pObj, i )
     {
-//        pObj->Id
+        Xc += Abc_PlaceX( p, Abc_ObjRegular(pObj) );
+        Yc += Abc_PlaceY( p, Abc_ObjRegular(pObj) );
     }
-    return 0.0;
+    Xc /= Vec_PtrSize(vFanins) + 1;
+    Yc /= Vec_PtrSize(vFanins) + 1;
+    // the nets of the MFFC nodes disappear
+    Vec_PtrClear( p->vCone );
+    Abc_PlaceCollectMffc_rec( pRoot, p->vCone );
+    Vec_PtrForEachEntry( Abc_Obj_t *, p->vCone, pObj, i )
+        if ( pObj != pRoot )
+            Delta -= Abc_PlaceCost( p, pObj );
+    // the nets of the leaves lose the MFFC nodes and gain the new nodes
+    Vec_PtrForEachEntry( Abc_Obj_t *, vFanins, pObj, i )
+    {
+        pObj = Abc_ObjRegular(pObj);
+        if ( Abc_ObjFanoutNum(pObj) > ABC_PLACE_FANOUTS )
+        {
+            // for large nets, the removed terminals are unlikely to shrink the box
+            memcpy( Box, Abc_PlaceBox(p, pObj), sizeof(float) * 4 );
+            Abc_PlaceBoxAdd( Box, Xc, Yc );
+        }
+        else
+        {
+            Box[0] = Box[1] = Abc_PlaceX( p, pObj );
+            Box[2] = Box[3] = Abc_PlaceY( p, pObj );
+            Abc_PlaceBoxAdd( Box, Xc, Yc );
+            Abc_ObjForEachFanout( pObj, pFanout, k )
+                if ( !Abc_ObjIsNode(pFanout) || !Abc_NodeIsTravIdCurrent(pFanout) )
+                    Abc_PlaceBoxAdd( Box, Abc_PlaceX(p, pFanout), Abc_PlaceY(p, pFanout) );
+        }
+        Delta += (Box[1] - Box[0]) + (Box[3] - Box[2]) - Abc_PlaceCost( p, pObj );
+    }
+    // the net of the root is driven from the new location
+    Box[0] = Box[1] = Xc;
+    Box[2] = Box[3] = Yc;
+    Abc_ObjForEachFanout( pRoot, pFanout, k )
+        Abc_PlaceBoxAdd( Box, Abc_PlaceX(p, pFanout), Abc_PlaceY(p, pFanout) );
+    Delta += (Box[1] - Box[0]) + (Box[3] - Box[2]) - Abc_PlaceCost( p, pRoot );
+    p->nEvals++;
+    p->timeEval += Abc_Clock() - clk;
+    return Delta;
 }
 
 /**Function*************************************************************
 
   Synopsis    [Updates placement after one step of rewriting.]
 
-  Description []
-               
+  Description [Places the new nodes and recomputes the nets of the new
+  nodes, of their fanins, and of the nodes whose fanouts have changed,
+  together with the nets of their fanins. The boxes of large nets are
+  only extended, so that the cost of the update does not depend on 
+  the fanout counts.]
+
   SideEffects []
 
   SeeAlso     []
 
 ***********************************************************************/
-void Abc_PlaceUpdate( Vec_Ptr_t * vAddedCells, Vec_Ptr_t * vUpdatedNets )
+void Abc_PlaceUpdate( Abc_Ntk_t * pNtk, Vec_Ptr_t * vAddedCells, Vec_Ptr_t * vUpdatedNets )
 {
+    Abc_Plc_t * p = Abc_PlaceMan( pNtk );
     Abc_Obj_t * pObj, * pFanin;
     int i, k;
-    Vec_Ptr_t * vCells, * vNets;
-
-    // start the arrays of new cells and nets
-    vCells = Vec_PtrAlloc( 16 );
-    vNets = Vec_PtrAlloc( 32 );
-
-    // go through the new nodes
+    abctime clk = Abc_Clock();
+    assert( p != NULL );
+    Abc_PlaceResize( p );
+    p->nUpdates++;
+    // place the new nodes at the barycenters of their fanins (in the order of creation)
     Vec_PtrForEachEntry( Abc_Obj_t *, vAddedCells, pObj, i )
     {
         assert( !Abc_ObjIsComplement(pObj) );
-        Abc_PlaceCreateCell( pObj, 1 );
-        Abc_PlaceUpdateNet( pObj );
-
-        // add the new cell and its fanin nets to temporary storage
-        Vec_PtrPush( vCells, &(cells[pObj->Id]) );
+        if ( Abc_ObjType(pObj) == ABC_OBJ_NONE ) // dead node
+            continue;
+        Abc_PlaceObjCenter( p, pObj, 0 );
+    }
+    // pull the new nodes towards their fanouts
+    Vec_PtrForEachEntryReverse( Abc_Obj_t *, vAddedCells, pObj, i )
+    {
+        if ( Abc_ObjType(pObj) == ABC_OBJ_NONE ) // dead node
+            continue;
+        Abc_PlaceObjCenter( p, pObj, 1 );
+    }
+    // recompute the affected nets
+    Vec_PtrForEachEntry( Abc_Obj_t *, vAddedCells, pObj, i )
+    {
+        if ( Abc_ObjType(pObj) == ABC_OBJ_NONE ) // dead node
+            continue;
+        Abc_PlaceUpdateNet( p, pObj );
         Abc_ObjForEachFanin( pObj, pFanin, k )
-            Vec_PtrPushUnique( vNets, &(nets[pFanin->Id]) );
+            Abc_PlaceUpdateNetTerm( p, pFanin, pObj );
     }
-
-    // go through the modified nets
     Vec_PtrForEachEntry( Abc_Obj_t *, vUpdatedNets, pObj, i )
     {
         assert( !Abc_ObjIsComplement(pObj) );
         if ( Abc_ObjType(pObj) == ABC_OBJ_NONE ) // dead node
             continue;
-        Abc_PlaceUpdateNet( pObj );
+        if ( Abc_ObjFanoutNum(pObj) <= ABC_PLACE_FANOUTS )
+            Abc_PlaceUpdateNet( p, pObj );
+        Abc_ObjForEachFanin( pObj, pFanin, k )
+            Abc_PlaceUpdateNetTerm( p, pFanin, pObj );
     }
-
-    // update the placement
-//    fastPlace( Vec_PtrSize(vCells), (ConcreteCell **)Vec_PtrArray(vCells), 
-//               Vec_PtrSize(vNets), (ConcreteNet **)Vec_PtrArray(vNets) );
-
-    // clean up
-    Vec_PtrFree( vCells );
-    Vec_PtrFree( vNets );
+    p->timeUpdate += Abc_Clock() - clk;
 }
 
 /**Function*************************************************************
 
-  Synopsis    [This procedure is called before the writing start.]
+  Synopsis    [This procedure is called before the rewriting starts.]
+
+  Description [Computes the initial placement and starts recording the
+  changes in the AIG manager. Returns the arrays of added nodes and
+  updated nets to be passed to Abc_PlaceUpdate().]
 
-  Description []
-               
   SideEffects []
 
   SeeAlso     []
 
 ***********************************************************************/
-void Abc_PlaceBegin( Abc_Ntk_t * pNtk )
+Vec_Ptr_t * Abc_PlaceBegin( Abc_Ntk_t * pNtk, Vec_Ptr_t ** pvUpdatedNets )
 {
-    Abc_Obj_t * pObj;
-    int i;
-
-    // allocate and clean internal storage
-    nAllocSize = 5 * Abc_NtkObjNumMax(pNtk);
-    cells = REALLOC(ConcreteCell, cells, nAllocSize);
-    nets  = REALLOC(ConcreteNet, nets, nAllocSize);
-    memset( cells, 0, sizeof(ConcreteCell) * nAllocSize );
-    memset( nets, 0, sizeof(ConcreteNet) * nAllocSize );
-
-    // create AbstractCells
-    //   1: pad
-    //   2: and
-    if (!abstractCells)
-        abstractCells = ALLOC(AbstractCell,2);
-
-    abstractCells[0].m_height = 1.0;
-    abstractCells[0].m_width = 1.0;
-    abstractCells[0].m_label = "pio";
-    abstractCells[0].m_pad = 1;
-
-    abstractCells[1].m_height = 1.0;
-    abstractCells[1].m_width = 1.0;
-    abstractCells[1].m_label = "and";
-    abstractCells[1].m_pad = 0;
-
-    // input pads
-    Abc_NtkForEachCi( pNtk, pObj, i )
-        Abc_PlaceCreateCell( pObj, 0 );
-
-    // ouput pads
-    Abc_NtkForEachCo( pNtk, pObj, i )
-        Abc_PlaceCreateCell( pObj, 0 );
-
-    // AND nodes
-    Abc_AigForEachAnd( pNtk, pObj, i )
-        Abc_PlaceCreateCell( pObj, 1 );
-
-    // all nets
-    Abc_NtkForEachObj( pNtk, pObj, i )
-    {
-        if ( !Abc_ObjIsCi(pObj) && !Abc_ObjIsNode(pObj) )
-            continue;
-        Abc_PlaceUpdateNet( pObj );
-    }
-
-    globalPreplace((float)0.8);
-    globalPlace();
+    Abc_Plc_t * p;
+    abctime clk = Abc_Clock();
+    assert( Abc_NtkIsStrash(pNtk) );
+    assert( pNtk->pManPlace == NULL );
+    p = ABC_CALLOC( Abc_Plc_t, 1 );
+    p->pNtk   = pNtk;
+    p->vX     = Vec_FltStart( Abc_NtkObjNumMax(pNtk) );
+    p->vY     = Vec_FltStart( Abc_NtkObjNumMax(pNtk) );
+    p->vBoxes = Vec_FltStart( 4*Abc_NtkObjNumMax(pNtk) );
+    p->vStamps = Vec_IntStartFull( Abc_NtkObjNumMax(pNtk) );
+    p->vCone  = Vec_PtrAlloc( 100 );
+    pNtk->pManPlace = p;
+    Abc_PlaceInitial( p );
+    p->timeInit = Abc_Clock() - clk;
+    p->vAddedCells = Abc_AigUpdateStart( (Abc_Aig_t *)pNtk->pManFunc, &p->vUpdatedNets );
+    *pvUpdatedNets = p->vUpdatedNets;
+    return p->vAddedCells;
 }
 
 /**Function*************************************************************
 
-  Synopsis    [This procedure is called after the writing completes.]
+  Synopsis    [This procedure is called after the rewriting completes.]
 
   Description []
-               
+
   SideEffects []
 
   SeeAlso     []
 
 ***********************************************************************/
-void Abc_PlaceEnd( Abc_Ntk_t * pNtk )
+void Abc_PlaceEnd( Abc_Ntk_t * pNtk, int fVerbose )
 {
-    int i;
-
-
-    // clean up
-    for ( i = 0; i < nAllocSize; i++ )
-        FREE( nets[i].m_terms );
-    FREE( abstractCells );
-    FREE( cells );
-    FREE( nets );
+    Abc_Plc_t * p = Abc_PlaceMan( pNtk );
+    assert( p != NULL );
+    if ( fVerbose )
+    {
+        float HpwlEnd = Abc_PlaceReadHpwl( pNtk );
+        printf( "Placement: HPWL = %.0f -> %.0f (%+.2f %%).  Cuts = %d.  Updates = %d.  Nets = %d.\n",
+            p->HpwlBeg, HpwlEnd, p->HpwlBeg ? 100.0 * (HpwlEnd - p->HpwlBeg) / p->HpwlBeg : 0.0, p->nEvals, p->nUpdates, p->nNetsUpdated );
+        ABC_PRT( "Initial placement ", p->timeInit );
+        ABC_PRT( "Cut evaluation    ", p->timeEval );
+        ABC_PRT( "Incremental update", p->timeUpdate );
+    }
+    Abc_AigUpdateStop( (Abc_Aig_t *)pNtk->pManFunc );
+    pNtk->pManPlace = NULL;
+    Vec_FltFree( p->vX );
+    Vec_FltFree( p->vY );
+    Vec_FltFree( p->vBoxes );
+    Vec_IntFree( p->vStamps );
+    Vec_PtrFree( p->vCone );
+    ABC_FREE( p );
 }
 
 ////////////////////////////////////////////////////////////////////////
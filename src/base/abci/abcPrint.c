@@ -384,7 +384,7 @@ void Abc_NtkPrintStats( Abc_Ntk_t * pNtk, int fFactored, int fSaveBest, int fDum
     if ( fGlitch )
     {
         if ( Abc_NtkIsLogic(pNtk) && Abc_NtkGetFaninMax(pNtk) <= 6 )
-            Abc_Print( 1,"  glitch =%7.2f %%", Abc_NtkMfsTotalGlitching(pNtk, 4000, 8, 0) );
+            Abc_Print( 1,"  glitch =%7.2f %%", Abc_NtkMfsTotalGlitching(pNtk, 4000, 8, 1, 0, 0) );
         else
             printf( "\nCurrently computes glitching only for K-LUT networks with K <= 6." );
     }
@@ -1850,7 +1850,7 @@ extern int         Gli_ManCreateCi( Gli_Man_t * p, int nFanouts );
 extern int         Gli_ManCreateCo( Gli_Man_t * p, int iFanin );
 extern int         Gli_ManCreateNode( Gli_Man_t * p, Vec_Int_t * vFanins, int nFanouts, word * pGateTruth );
 
-extern void        Gli_ManSwitchesAndGlitches( Gli_Man_t * p, int nPatterns, float PiTransProb, int fVerbose );
+extern void        Gli_ManSwitchesAndGlitches2( Gli_Man_t * p, int nPatterns, float PiTransProb, int nProcs, int TimeLimit, int fVerbose );
 extern int         Gli_ObjNumSwitches( Gli_Man_t * p, int iNode );
 extern int         Gli_ObjNumGlitches( Gli_Man_t * p, int iNode );
 
@@ -1865,7 +1865,7 @@ extern int         Gli_ObjNumGlitches( Gli_Man_t * p, int iNode );
   SeeAlso     []
 
 ***********************************************************************/
-float Abc_NtkMfsTotalGlitchingLut( Abc_Ntk_t * pNtk, int nPats, int Prob, int fVerbose )
+float Abc_NtkMfsTotalGlitchingLut( Abc_Ntk_t * pNtk, int nPats, int Prob, int nProcs, int TimeLimit, int fVerbose )
 {
     int nSwitches, nGlitches;
     Gli_Man_t * p;
@@ -1909,7 +1909,7 @@ float Abc_NtkMfsTotalGlitchingLut( Abc_Ntk_t * pNtk, int nPats, int Prob, int fV
         Gli_ManCreateCo( p, Abc_ObjFanin0(pObj)->iTemp );
 
     // compute glitching
-    Gli_ManSwitchesAndGlitches( p, 4000, 1.0/8.0, 0 );
+    Gli_ManSwitchesAndGlitches2( p, 4000, 1.0/8.0, nProcs, TimeLimit, 0 );
 
     // compute the ratio
     nSwitches = nGlitches = 0;
@@ -1939,7 +1939,7 @@ float Abc_NtkMfsTotalGlitchingLut( Abc_Ntk_t * pNtk, int nPats, int Prob, int fV
   SeeAlso     []
 
 ***********************************************************************/
-float Abc_NtkMfsTotalGlitching( Abc_Ntk_t * pNtk, int nPats, int Prob, int fVerbose )
+float Abc_NtkMfsTotalGlitching( Abc_Ntk_t * pNtk, int nPats, int Prob, int nProcs, int TimeLimit, int fVerbose )
 {
     int nSwitches, nGlitches;
     Gli_Man_t * p;
@@ -1948,7 +1948,7 @@ float Abc_NtkMfsTotalGlitching( Abc_Ntk_t * pNtk, int nPats, int Prob, int fVerb
     Abc_Obj_t * pObj, * pFanin;
     int i, k, nFaninMax = Abc_NtkGetFaninMax(pNtk);
     if ( !Abc_NtkIsMappedLogic(pNtk) )
-        return Abc_NtkMfsTotalGlitchingLut( pNtk, nPats, Prob, fVerbose );
+        return Abc_NtkMfsTotalGlitchingLut( pNtk, nPats, Prob, nProcs, TimeLimit, fVerbose );
     assert( Abc_NtkIsMappedLogic(pNtk) );
     if ( nFaninMax > 16 )
     {
@@ -1976,7 +1976,7 @@ float Abc_NtkMfsTotalGlitching( Abc_Ntk_t * pNtk, int nPats, int Prob, int fVerb
         Gli_ManCreateCo( p, Abc_ObjFanin0(pObj)->iTemp );
 
     // compute glitching
-    Gli_ManSwitchesAndGlitches( p, nPats, 1.0/Prob, fVerbose );
+    Gli_ManSwitchesAndGlitches2( p, nPats, 1.0/Prob, nProcs, TimeLimit, fVerbose );
 
     // compute the ratio
     nSwitches = nGlitches = 0;
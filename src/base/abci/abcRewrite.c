@@ -39,10 +39,6 @@ static Cut_Man_t * Abc_NtkStartCutManForRewrite( Abc_Ntk_t * pNtk );
 static void        Abc_NodePrintCuts( Abc_Obj_t * pNode );
 static void        Abc_ManShowCutCone( Abc_Obj_t * pNode, Vec_Ptr_t * vLeaves );
 
-extern void  Abc_PlaceBegin( Abc_Ntk_t * pNtk );
-extern void  Abc_PlaceEnd( Abc_Ntk_t * pNtk );
-extern void  Abc_PlaceUpdate( Vec_Ptr_t * vAddedCells, Vec_Ptr_t * vUpdatedNets );
-
 ////////////////////////////////////////////////////////////////////////
 ///                     FUNCTION DEFINITIONS                         ///
 ////////////////////////////////////////////////////////////////////////
@@ -64,10 +60,10 @@ int Abc_NtkRewrite( Abc_Ntk_t * pNtk, int fUpdateLevel, int fUseZeros, int fVerb
     ProgressBar * pProgress;
     Cut_Man_t * pManCut;
     Rwr_Man_t * pManRwr;
-    Abc_Obj_t * pNode;
-//    Vec_Ptr_t * vAddedCells = NULL, * vUpdatedNets = NULL;
+    Abc_Obj_t * pNode, * pFanout;
+    Vec_Ptr_t * vAddedCells = NULL, * vUpdatedNets = NULL;
     Dec_Graph_t * pGraph;
-    int i, nNodes, nGain, fCompl, RetValue = 1;
+    int i, k, nNodes, nGain, fCompl, RetValue = 1;
     abctime clk, clkStart = Abc_Clock();
 
     assert( Abc_NtkIsStrash(pNtk) );
@@ -81,17 +77,13 @@ int Abc_NtkRewrite( Abc_Ntk_t * pNtk, int fUpdateLevel, int fUseZeros, int fVerb
     }
 */
 
-    // start placement package
-//    if ( fPlaceEnable )
-//    {
-//        Abc_PlaceBegin( pNtk );
-//        vAddedCells = Abc_AigUpdateStart( pNtk->pManFunc, &vUpdatedNets );
-//    }
-
     // start the rewriting manager
     pManRwr = Rwr_ManStart( 0 );
     if ( pManRwr == NULL )
         return 0;
+    // start placement package
+    if ( fPlaceEnable )
+        vAddedCells = Abc_PlaceBegin( pNtk, &vUpdatedNets );
     // compute the reverse levels if level update is requested
     if ( fUpdateLevel )
         Abc_NtkStartReverseLevels( pNtk, 0 );
@@ -133,7 +125,12 @@ Rwr_ManAddTimeCuts( pManRwr, Abc_Clock() - clk );
 
         // reset the array of the changed nodes
         if ( fPlaceEnable )
+        {
             Abc_AigUpdateReset( (Abc_Aig_t *)pNtk->pManFunc );
+            // the fanouts of the node will be connected to the new root
+            Abc_ObjForEachFanout( pNode, pFanout, k )
+                Vec_PtrPush( vUpdatedNets, pFanout );
+        }
 
         // complement the FF if needed
         if ( fCompl ) Dec_GraphComplement( pGraph );
@@ -147,8 +144,8 @@ Rwr_ManAddTimeUpdate( pManRwr, Abc_Clock() - clk );
         if ( fCompl ) Dec_GraphComplement( pGraph );
 
         // use the array of changed nodes to update placement
-//        if ( fPlaceEnable )
-//            Abc_PlaceUpdate( vAddedCells, vUpdatedNets );
+        if ( fPlaceEnable )
+            Abc_PlaceUpdate( pNtk, vAddedCells, vUpdatedNets );
     }
     Extra_ProgressBarStop( pProgress );
 Rwr_ManAddTimeTotal( pManRwr, Abc_Clock() - clkStart );
@@ -164,12 +161,9 @@ Rwr_ManAddTimeTotal( pManRwr, Abc_Clock() - clkStart );
     Cut_ManStop( pManCut );
     pNtk->pManCut = NULL;
 
-    // start placement package
-//    if ( fPlaceEnable )
-//    {
-//        Abc_PlaceEnd( pNtk );
-//        Abc_AigUpdateStop( pNtk->pManFunc );
-//    }
+    // stop placement package
+    if ( fPlaceEnable )
+        Abc_PlaceEnd( pNtk, fVerbose );
 
     // put the nodes into the DFS order and reassign their IDs
     {
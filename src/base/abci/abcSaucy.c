@@ -27,6 +27,18 @@
 #include "base/abc/abc.h"
 #include "opt/sim/sim.h"
 
+#ifdef ABC_USE_PTHREADS
+
+#ifdef _WIN32
+#include "../lib/pthread.h"
+#else
+#include <pthread.h>
+#include <sched.h>
+#include <unistd.h>
+#endif
+
+#endif
+
 ABC_NAMESPACE_IMPL_START
 
 /* on/off switches */
@@ -190,6 +202,8 @@ struct saucy {
     int fPrintTree;
     int fLookForSwaps;
     FILE * gFile;
+    FILE * pOut;     /* Stream for the progress messages */
+    unsigned Rand;   /* State of the random number generator */
     
     int (*refineBySim1)(struct saucy *, struct coloring *);
     int (*refineBySim2)(struct saucy *, struct coloring *);
@@ -205,13 +219,13 @@ static int *                generateProperInputVector(Abc_Ntk_t * pNtk, struct c
 static int                  ifInputVectorsAreConsistent(struct saucy * s, int * leftVec, int * rightVec);
 static int                  ifOutputVectorsAreConsistent(struct saucy * s, int * leftVec, int * rightVec);
 static Vec_Ptr_t **         findTopologicalOrder(Abc_Ntk_t * pNtk);
-static void                 getDependencies(Abc_Ntk_t *pNtk, Vec_Int_t** iDep, Vec_Int_t** oDep);
+static void                 getDependencies(Abc_Ntk_t *pNtk, Vec_Int_t** iDep, Vec_Int_t** oDep, FILE * pOut);
 static struct saucy_graph * buildDepGraph (Abc_Ntk_t *pNtk, Vec_Int_t ** iDep, Vec_Int_t ** oDep);
 static struct saucy_graph * buildSim1Graph(Abc_Ntk_t * pNtk, struct coloring *c, Vec_Int_t * randVec, Vec_Int_t ** iDep, Vec_Int_t ** oDep);
 static struct saucy_graph * buildSim2Graph(Abc_Ntk_t * pNtk, struct coloring *c, Vec_Int_t * randVec, Vec_Int_t ** iDep, Vec_Int_t ** oDep, Vec_Ptr_t ** topOrder, Vec_Int_t ** obs,  Vec_Int_t ** ctrl);
-static Vec_Int_t *          assignRandomBitsToCells(Abc_Ntk_t * pNtk, struct coloring *c);
+static Vec_Int_t *          assignRandomBitsToCells(struct saucy * s, struct coloring *c);
 static int                  Abc_NtkCecSat_saucy(Abc_Ntk_t * pNtk1, Abc_Ntk_t * pNtk2, int * pModel);
-static struct sim_result *  analyzeConflict(Abc_Ntk_t * pNtk, int * pModel, int fVerbose);
+static struct sim_result *  analyzeConflict(Abc_Ntk_t * pNtk, int * pModel, FILE * pOut, int fVerbose);
 static void                 bumpActivity (struct saucy * s, struct sim_result * cex);
 static void                 reduceDB(struct saucy * s);
 
@@ -560,10 +574,10 @@ is_undirected_automorphism(struct saucy *s)
     if( BACKTRACK_BY_SAT && !ret ) {
         struct sim_result * cex;
 
-        cex = analyzeConflict( s->pNtk, s->pModel, s->fPrintTree );
+        cex = analyzeConflict( s->pNtk, s->pModel, s->pOut, s->fPrintTree );
         add_conterexample(s, cex);
 
-        cex = analyzeConflict( s->pNtk_permuted, s->pModel, s->fPrintTree );
+        cex = analyzeConflict( s->pNtk_permuted, s->pModel, s->pOut, s->fPrintTree );
         add_conterexample(s, cex);      
         
         s->activityInc *= (1 / CLAUSE_DECAY);
@@ -1227,7 +1241,7 @@ refineBySim1_init(struct saucy *s, struct coloring *c)
         }
         if (allOutputsAreDistinguished) break;
 
-        randVec = assignRandomBitsToCells(s->pNtk, c);      
+        randVec = assignRandomBitsToCells(s, c);      
         g = buildSim1Graph(s->pNtk, c, randVec, s->iDep, s->oDep);
         assert(g != NULL);
 
@@ -1281,7 +1295,7 @@ refineBySim1_left(struct saucy *s, struct coloring *c)
         }
         if (allOutputsAreDistinguished) break;
 
-        randVec = assignRandomBitsToCells(s->pNtk, c);      
+        randVec = assignRandomBitsToCells(s, c);      
         g = buildSim1Graph(s->pNtk, c, randVec, s->iDep, s->oDep);
         assert(g != NULL);
 
@@ -1373,7 +1387,7 @@ refineBySim2_init(struct saucy *s, struct coloring *c)
     int nsplits;    
     
     for (i = 0; i < NUM_SIM2_ITERATION; i++) {
-        randVec = assignRandomBitsToCells(s->pNtk, c);      
+        randVec = assignRandomBitsToCells(s, c);      
         g = buildSim2Graph(s->pNtk, c, randVec, s->iDep, s->oDep, s->topOrder, s->obs,  s->ctrl);
         assert(g != NULL);
 
@@ -1413,7 +1427,7 @@ refineBySim2_left(struct saucy *s, struct coloring *c)
     int nsplits;    
     
     for (i = 0; i < NUM_SIM2_ITERATION; i++) {
-        randVec = assignRandomBitsToCells(s->pNtk, c);      
+        randVec = assignRandomBitsToCells(s, c);      
         g = buildSim2Graph(s->pNtk, c, randVec, s->iDep, s->oDep, s->topOrder, s->obs,  s->ctrl);
         assert(g != NULL);
 
@@ -1710,7 +1724,7 @@ descend_leftmost(struct saucy *s)
         else
             target = min = select_smallest_max_connected_cell(s, Abc_NtkPoNum(s->pNtk), s->n);
         if (s->fPrintTree) 
-            printf("%s->%s\n", getVertexName(s->pNtk, s->left.lab[min]), getVertexName(s->pNtk, s->left.lab[min]));     
+            fprintf(s->pOut, "%s->%s\n", getVertexName(s->pNtk, s->left.lab[min]), getVertexName(s->pNtk, s->left.lab[min]));     
         s->splitvar[s->lev] = s->left.lab[min];
         s->start[s->lev] = target;
         s->splitlev[s->lev] = s->nsplits;
@@ -1815,7 +1829,7 @@ descend_left(struct saucy *s)
 
         if (s->fPrintTree) {
             //printf("in level %d: %d->%d\n", s->lev, s->left.lab[lmin], s->right.lab[rmin]);
-            printf("in level %d: %s->%s\n", s->lev, getVertexName(s->pNtk, s->left.lab[lmin]), getVertexName(s->pNtk, s->right.lab[rmin]));
+            fprintf(s->pOut, "in level %d: %s->%s\n", s->lev, getVertexName(s->pNtk, s->left.lab[lmin]), getVertexName(s->pNtk, s->right.lab[rmin]));
         }
 
         /* Check if we need to refine on the left */
@@ -2133,13 +2147,13 @@ backtrack_bad(struct saucy *s)
             min = backtrack_loop(s);            
             if (!s->lev) {
                 if (s->fPrintTree)
-                    printf("Backtrack by SAT from level %d to %d\n", oldLev, 0);
+                    fprintf(s->pOut, "Backtrack by SAT from level %d to %d\n", oldLev, 0);
                 return -1;
             }
         }
         if (s->fPrintTree)          
             if (s->lev < oldLev) 
-                printf("Backtrack by SAT from level %d to %d\n", oldLev, s->lev);
+                fprintf(s->pOut, "Backtrack by SAT from level %d to %d\n", oldLev, s->lev);
     }
     tmp = s->nsplits;
     s->nsplits = s->splitlev[old];
@@ -2260,7 +2274,7 @@ do_search(struct saucy *s)
 
     if (s->fPrintTree && s->lev > 0) {
         //printf("in level %d: %d->%d\n", s->lev, s->left.lab[s->splitwho[s->nsplits]], s->right.lab[min]);
-        printf("in level %d: %s->%s\n", s->lev, getVertexName(s->pNtk, s->left.lab[s->splitwho[s->nsplits]]), getVertexName(s->pNtk, s->right.lab[min]));
+        fprintf(s->pOut, "in level %d: %s->%s\n", s->lev, getVertexName(s->pNtk, s->left.lab[s->splitwho[s->nsplits]]), getVertexName(s->pNtk, s->right.lab[min]));
     }   
 
     /* Keep going while there are tree nodes to expand */
@@ -2291,10 +2305,10 @@ do_search(struct saucy *s)
         ++s->stats->bads;
         min = backtrack_bad(s);
         if (s->fPrintTree) {
-            printf("BAD NODE\n");
+            fprintf(s->pOut, "BAD NODE\n");
             if (s->lev > 0) {
                 //printf("in level %d: %d->%d\n", s->lev, s->left.lab[s->splitwho[s->nsplits]], s->right.lab[min]);     
-                printf("in level %d: %s->%s\n", s->lev, getVertexName(s->pNtk, s->left.lab[s->splitwho[s->nsplits]]), getVertexName(s->pNtk, s->right.lab[min]));                               
+                fprintf(s->pOut, "in level %d: %s->%s\n", s->lev, getVertexName(s->pNtk, s->left.lab[s->splitwho[s->nsplits]]), getVertexName(s->pNtk, s->right.lab[min]));                               
             }
         }
     }
@@ -2444,17 +2458,17 @@ saucy_search(
     s->refineBySim2 = refineBySim2_init;    
 
     //print_partition(&s->left, NULL, s->n, s->pNtk, 1);
-    printf("Initial Refine by Dependency graph ... ");
+    fprintf(s->pOut, "Initial Refine by Dependency graph ... ");
     refineByDepGraph(s, &s->left);
     //print_partition(&s->left, NULL, s->n, s->pNtk, 1);
-    printf("done!\n");
+    fprintf(s->pOut, "done!\n");
     
-    printf("Initial Refine by Simulation ... ");
+    fprintf(s->pOut, "Initial Refine by Simulation ... ");
     if (REFINE_BY_SIM_1) s->refineBySim1(s, &s->left);
     //print_partition(&s->left, NULL, s->n, s->pNtk, 1);
     if (REFINE_BY_SIM_2) s->refineBySim2(s, &s->left);
     //print_partition(&s->left, NULL, s->n, s->pNtk, 1);
-    printf("done!\n\t--------------------\n");
+    fprintf(s->pOut, "done!\n\t--------------------\n");
 
     /* Descend along the leftmost branch and compute zeta */
     s->refineBySim1 = refineBySim1_left;
@@ -2652,8 +2666,7 @@ saucy_alloc(Abc_Ntk_t * pNtk)
     if (s->ninduce && s->sinduce && s->left.cfront && s->left.clen
         && s->right.cfront && s->right.clen
         && s->stuff && s->bucket && s->count && s->ccount
-        //&& s->clist && s->nextnon-1 && s->prevnon
-        && s->clist && s->nextnon[-1] && s->prevnon
+        && s->clist && s->prevnon
         && s->start && s->gamma && s->theta && s->left.unlab
         && s->right.lab && s->right.unlab
         && s->left.lab &&  s->splitvar && s->splitwho && s->junk
@@ -2733,12 +2746,12 @@ findTopologicalOrder( Abc_Ntk_t * pNtk )
 }
 
 static void 
-getDependencies(Abc_Ntk_t *pNtk, Vec_Int_t** iDep, Vec_Int_t** oDep)
+getDependencies(Abc_Ntk_t *pNtk, Vec_Int_t** iDep, Vec_Int_t** oDep, FILE * pOut)
 {   
     Vec_Ptr_t * vSuppFun;
     int i, j;   
     
-    vSuppFun = Sim_ComputeFunSupp(pNtk, 0);
+    vSuppFun = Sim_ComputeFunSuppOut(pNtk, 0, pOut);
     for(i = 0; i < Abc_NtkPoNum(pNtk); i++) {
         char * seg = (char *)vSuppFun->pArray[i];
         
@@ -2851,14 +2864,26 @@ buildDepGraph(Abc_Ntk_t *pNtk, Vec_Int_t ** iDep, Vec_Int_t ** oDep)
     return g;
 }
 
+/* Each solver has its own generator (xorshift), so the solvers of
+ * different outputs can run concurrently and reproducibly. */
+static int 
+randomBit(struct saucy * s)
+{
+    s->Rand ^= s->Rand << 13;
+    s->Rand ^= s->Rand >> 17;
+    s->Rand ^= s->Rand << 5;
+    return (int)(s->Rand >> 31);
+}
+
 static Vec_Int_t * 
-assignRandomBitsToCells(Abc_Ntk_t * pNtk, struct coloring *c)
+assignRandomBitsToCells(struct saucy * s, struct coloring *c)
 {
+    Abc_Ntk_t * pNtk = s->pNtk;
     Vec_Int_t * randVec = Vec_IntAlloc( 1 );
     int i, bit;
 
     for (i = 0; i < Abc_NtkPiNum(pNtk); i += (c->clen[i+Abc_NtkPoNum(pNtk)]+1)) {
-        bit = (int)(SIM_RANDOM_UNSIGNED % 2);
+        bit = randomBit(s);
         Vec_IntPush(randVec, bit);
     }
 
@@ -3139,7 +3164,7 @@ reduceDB( struct saucy * s )
 }
 
 static struct sim_result *
-analyzeConflict( Abc_Ntk_t * pNtk, int * pModel, int fVerbose )
+analyzeConflict( Abc_Ntk_t * pNtk, int * pModel, FILE * pOut, int fVerbose )
 {   
     Abc_Obj_t * pNode;
     int i, count = 0;
@@ -3167,8 +3192,8 @@ analyzeConflict( Abc_Ntk_t * pNtk, int * pModel, int fVerbose )
 
     if (fVerbose) {
         Abc_NtkForEachCi( pNtk, pNode, i )
-            printf(" %s=%d", Abc_ObjName(pNode), pModel[i]);
-        printf("\n");
+            fprintf(pOut, " %s=%d", Abc_ObjName(pNode), pModel[i]);
+        fprintf(pOut, "\n");
     }
 
     ABC_FREE( pValues );    
@@ -3246,36 +3271,46 @@ Abc_NtkCecSat_saucy( Abc_Ntk_t * pNtk1, Abc_Ntk_t * pNtk2, int * pModel )
 }
 
 
-void saucyGateWay( Abc_Ntk_t * pNtkOrig, Abc_Obj_t * pNodePo, FILE * gFile, int fBooleanMatching, 
-                   int fLookForSwaps, int fFixOutputs, int fFixInputs, int fQuiet, int fPrintTree )
+/* Allocates the solver and computes the functional dependencies. 
+ * The functional support computation reseeds the global random number 
+ * generator, so this part is always performed by the main thread. 
+ * The generator of the solver is seeded by the index of the output. */
+static struct saucy *
+saucyPrepare( Abc_Ntk_t * pNtk, FILE * pOut, int iOutput )
 {
-    Abc_Ntk_t * pNtk;
     struct saucy *s;
-    struct saucy_stats stats;
-    int *colors;
-    int i, clk = clock();   
-    
-    if (pNodePo == NULL)
-        pNtk = Abc_NtkDup( pNtkOrig );
-    else
-        pNtk = Abc_NtkCreateCone( pNtkOrig, Abc_ObjFanin0(pNodePo), Abc_ObjName(pNodePo), 0 );
-    
+
     if (Abc_NtkPiNum(pNtk) == 0) {
-        Abc_Print( 0, "This output is not dependent on any input\n" );
-        Abc_NtkDelete( pNtk );
-        return;
+        fprintf(pOut, "Warning: This output is not dependent on any input\n");
+        return NULL;
     }
 
-    s = saucy_alloc( pNtk );    
+    s = saucy_alloc( pNtk );
+    s->pOut = pOut;
+    s->Rand = (0xABC + 0x9E3779B9 * (unsigned)(iOutput + 1)) | 1;
 
     /******* Getting Dependencies *******/  
-    printf("Build functional dependency graph (dependency stats are below) ... ");      
-    getDependencies( pNtk, s->iDep, s->oDep );
-    printf("\t--------------------\n");
+    fprintf(pOut, "Build functional dependency graph (dependency stats are below) ... ");      
+    fflush(pOut);
+    getDependencies( pNtk, s->iDep, s->oDep, pOut );
+    fprintf(pOut, "\t--------------------\n");
     /************************************/
 
     /* Finding toplogical orde */
-    s->topOrder = findTopologicalOrder( pNtk );                 
+    s->topOrder = findTopologicalOrder( pNtk );
+    return s;
+}
+
+/* Searches for the symmetries and frees the solver. */
+static void
+saucyRun( Abc_Ntk_t * pNtk, struct saucy *s, FILE * pOut, FILE * gFile, int fBooleanMatching, 
+          int fLookForSwaps, int fFixOutputs, int fFixInputs, int fQuiet, int fPrintTree, abctime clk, struct saucy_stats * pStats )
+{
+    struct saucy_stats stats;
+    int *colors;
+    int i;
+
+    s->pOut = pOut;
 
     /* Setting graph colors: outputs = 0 and inputs = 1 */
     colors = ints(Abc_NtkPoNum(pNtk) + Abc_NtkPiNum(pNtk));
@@ -3298,13 +3333,6 @@ void saucyGateWay( Abc_Ntk_t * pNtkOrig, Abc_Obj_t * pNodePo, FILE * gFile, int
 
     /* Are we looking for Boolean matching? */
     s->fBooleanMatching = fBooleanMatching;
-    if (fBooleanMatching) {
-        NUM_SIM1_ITERATION = 50;
-        NUM_SIM2_ITERATION = 50;
-    } else {
-        NUM_SIM1_ITERATION = 200;
-        NUM_SIM2_ITERATION = 200;
-    }
 
     /* Set the print automorphism routine */
     if (!fQuiet)
@@ -3314,7 +3342,7 @@ void saucyGateWay( Abc_Ntk_t * pNtkOrig, Abc_Obj_t * pNodePo, FILE * gFile, int
 
     /* Set the output file for generators */
     if (gFile == NULL)
-        s->gFile = stdout;
+        s->gFile = pOut;
     else
         s->gFile = gFile;
 
@@ -3324,26 +3352,267 @@ void saucyGateWay( Abc_Ntk_t * pNtkOrig, Abc_Obj_t * pNodePo, FILE * gFile, int
     /* Set input permutations option */
     s->fLookForSwaps = fLookForSwaps;
 
-    saucy_search(pNtk, s, 0, colors, &stats);   
-    print_stats(stdout, stats);
+    saucy_search(pNtk, s, 0, colors, &stats);
+    print_stats(pOut, stats);
     if (fBooleanMatching) {
         if (stats.grpsize_base > 1 || stats.grpsize_exp > 0)
-            printf("*** Networks are equivalent ***\n");
+            fprintf(pOut, "*** Networks are equivalent ***\n");
         else
-            printf("*** Networks are NOT equivalent ***\n");
+            fprintf(pOut, "*** Networks are NOT equivalent ***\n");
     }
     saucy_free(s);
+    *pStats = stats;
+
+    fprintf(pOut, "%s =%9.2f sec\n", "Runtime", 1.0*((double)(Abc_Clock() - clk))/((double)CLOCKS_PER_SEC));
+}
+
+static void
+setSimIterations( int fBooleanMatching )
+{
+    if (fBooleanMatching) {
+        NUM_SIM1_ITERATION = 50;
+        NUM_SIM2_ITERATION = 50;
+    } else {
+        NUM_SIM1_ITERATION = 200;
+        NUM_SIM2_ITERATION = 200;
+    }
+}
+
+static void
+appendGroupSize( struct saucy_stats * pStats )
+{
+    FILE * hadi = fopen("hadi.txt", "a");
+    fprintf(hadi, "group size = %fe%d\n",
+    pStats->grpsize_base, pStats->grpsize_exp); 
+    fclose(hadi);
+}
+
+void saucyGateWay( Abc_Ntk_t * pNtkOrig, Abc_Obj_t * pNodePo, FILE * gFile, int fBooleanMatching, 
+                   int fLookForSwaps, int fFixOutputs, int fFixInputs, int fQuiet, int fPrintTree )
+{
+    Abc_Ntk_t * pNtk;
+    struct saucy *s;
+    struct saucy_stats stats;
+    abctime clk = Abc_Clock();
+    
+    if (pNodePo == NULL)
+        pNtk = Abc_NtkDup( pNtkOrig );
+    else
+        pNtk = Abc_NtkCreateCone( pNtkOrig, Abc_ObjFanin0(pNodePo), Abc_ObjName(pNodePo), 0 );
+
+    setSimIterations( fBooleanMatching );
+    s = saucyPrepare( pNtk, stdout, pNodePo ? Vec_PtrFind(pNtkOrig->vPos, pNodePo) : -1 );
+    if (s) {
+        saucyRun( pNtk, s, stdout, gFile, fBooleanMatching, fLookForSwaps, fFixOutputs, fFixInputs, fQuiet, fPrintTree, clk, &stats );
+        appendGroupSize( &stats );
+    }
     Abc_NtkDelete(pNtk);
+}
+
+/*
+ * Symmetries of each output (the mode "-O all") are computed
+ * independently, so the outputs are distributed among several threads.
+ * The search itself is not split: the orbit partition and the leftmost 
+ * path make the nodes of the search tree depend on each other.  Each 
+ * output prints into its own temporary stream and the streams are 
+ * copied in the order of outputs, so the result does not depend on 
+ * the number of threads.
+ */
+
+struct saucy_job {
+    Abc_Ntk_t * pNtk;        /* Cone of the output */
+    struct saucy * s;        /* Solver (NULL if the output has no inputs) */
+    int fDone;               /* The symmetries are computed */
+    FILE * pOut;             /* Buffered progress messages */
+    FILE * pGen;             /* Buffered generators (if printed to a file) */
+    struct saucy_stats stats;
+};
+
+struct saucy_jobs {
+    struct saucy_job * pJobs;
+    int fLookForSwaps;
+    int fFixOutputs;
+    int fFixInputs;
+    int fQuiet;
+    int fPrintTree;
+};
+
+static void
+saucy_run_job( struct saucy_jobs * p, int i )
+{
+    struct saucy_job * pJob = p->pJobs + i;
+    if (pJob->s == NULL)
+        return;
+    saucyRun( pJob->pNtk, pJob->s, pJob->pOut, pJob->pGen, 0, p->fLookForSwaps, p->fFixOutputs,
+              p->fFixInputs, p->fQuiet, p->fPrintTree, Abc_Clock(), &pJob->stats );
+    pJob->s = NULL;
+    pJob->fDone = 1;
+}
+
+static void
+copy_stream( FILE * pFrom, FILE * pTo )
+{
+    char Buffer[1<<12];
+    size_t nRead;
+    rewind( pFrom );
+    while ( (nRead = fread(Buffer, 1, sizeof(Buffer), pFrom)) > 0 )
+        fwrite( Buffer, 1, nRead, pTo );
+}
+
+#ifdef ABC_USE_PTHREADS
+
+#define SAUCY_THR_MAX 100
+
+struct saucy_thdata {
+    struct saucy_jobs * p;
+    int Index;
+    int fWorking;
+};
+
+static void *
+saucy_worker_thread( void * pArg )
+{
+    struct saucy_thdata * pThData = (struct saucy_thdata *)pArg;
+    volatile int * pPlace = &pThData->fWorking;
+    while ( 1 )
+    {
+        while ( *pPlace == 0 )
+            sched_yield();
+        assert( pThData->fWorking );
+        if ( pThData->Index == -1 )
+        {
+            pthread_exit( NULL );
+            assert( 0 );
+            return NULL;
+        }
+        saucy_run_job( pThData->p, pThData->Index );
+        pThData->fWorking = 0;
+    }
+    assert( 0 );
+    return NULL;
+}
+
+static void
+saucy_run_jobs( struct saucy_jobs * p, int nJobs, int nProcs )
+{
+    struct saucy_thdata ThData[SAUCY_THR_MAX];
+    pthread_t WorkerThread[SAUCY_THR_MAX];
+    int i, k, status;
+    nProcs = Abc_MinInt( nProcs, SAUCY_THR_MAX );
+    for ( i = 0; i < nProcs; i++ )
+    {
+        ThData[i].p        = p;
+        ThData[i].Index    = -1;
+        ThData[i].fWorking = 0;
+        status = pthread_create( WorkerThread + i, NULL, saucy_worker_thread, (void *)(ThData + i) );  assert( status == 0 );
+    }
+    for ( k = 0; k < nJobs; k++ )
+    {
+        for ( i = 0; i < nProcs; i++ )
+        {
+            if ( ThData[i].fWorking )
+                continue;
+            ThData[i].Index = k;
+            ThData[i].fWorking = 1;
+            break;
+        }
+        if ( i == nProcs )
+        {
+            sched_yield();
+            k--;
+        }
+    }
+    for ( i = 0; i < nProcs; i++ )
+        while ( ((volatile int *)&ThData[i].fWorking)[0] )
+            sched_yield();
+    for ( i = 0; i < nProcs; i++ )
+    {
+        ThData[i].Index = -1;
+        ThData[i].fWorking = 1;
+    }
+    for ( i = 0; i < nProcs; i++ )
+        pthread_join( WorkerThread[i], NULL );
+}
+
+#else
 
-    if (1) {
-        FILE * hadi = fopen("hadi.txt", "a");
-        fprintf(hadi, "group size = %fe%d\n",
-        stats.grpsize_base, stats.grpsize_exp); 
-        fclose(hadi);
+static void
+saucy_run_jobs( struct saucy_jobs * p, int nJobs, int nProcs )
+{
+    int i;
+    for ( i = 0; i < nJobs; i++ )
+        saucy_run_job( p, i );
+}
+
+#endif
+
+void saucyGateWayAll( Abc_Ntk_t * pNtk, FILE * gFile, int fLookForSwaps, int fFixOutputs, int fFixInputs, 
+                      int fQuiet, int fPrintTree, int nProcs )
+{
+    struct saucy_jobs Jobs, * p = &Jobs;
+    Abc_Obj_t * pNodePo;
+    int i;
+
+    if (nProcs <= 1) {
+        Abc_NtkForEachPo( pNtk, pNodePo, i ) {
+            printf("Output %s\n\n", Abc_ObjName(pNodePo));
+            saucyGateWay( pNtk, pNodePo, gFile, 0, fLookForSwaps, fFixOutputs, fFixInputs, fQuiet, fPrintTree );
+            printf("----------------------------------------\n");
+        }
+        return;
+    }
+
+    /* extract the cones (this updates the copy fields of the network) */
+    p->pJobs = ABC_CALLOC(struct saucy_job, Abc_NtkPoNum(pNtk));
+    p->fLookForSwaps = fLookForSwaps;
+    p->fFixOutputs   = fFixOutputs;
+    p->fFixInputs    = fFixInputs;
+    p->fQuiet        = fQuiet;
+    p->fPrintTree    = fPrintTree;
+    Abc_NtkForEachPo( pNtk, pNodePo, i ) {
+        p->pJobs[i].pNtk = Abc_NtkCreateCone( pNtk, Abc_ObjFanin0(pNodePo), Abc_ObjName(pNodePo), 0 );
+        p->pJobs[i].pOut = tmpfile();
+        p->pJobs[i].pGen = gFile ? tmpfile() : NULL;
+        if (p->pJobs[i].pOut == NULL || (gFile && p->pJobs[i].pGen == NULL)) {
+            Abc_Print( -1, "Cannot create temporary files for the threads; computing sequentially.\n" );
+            for ( ; i >= 0; i-- ) {
+                Abc_NtkDelete( p->pJobs[i].pNtk );
+                if (p->pJobs[i].pOut) fclose( p->pJobs[i].pOut );
+                if (p->pJobs[i].pGen) fclose( p->pJobs[i].pGen );
+            }
+            ABC_FREE( p->pJobs );
+            saucyGateWayAll( pNtk, gFile, fLookForSwaps, fFixOutputs, fFixInputs, fQuiet, fPrintTree, 1 );
+            return;
+        }
     }
 
-    ABC_PRT( "Runtime", clock() - clk );
+    /* compute the dependencies (the messages go into the streams of the outputs) */
+    Abc_NtkForEachPo( pNtk, pNodePo, i )
+        p->pJobs[i].s = saucyPrepare( p->pJobs[i].pNtk, p->pJobs[i].pOut, i );
+
+    /* search for the symmetries */
+    setSimIterations( 0 );
+    saucy_run_jobs( p, Abc_NtkPoNum(pNtk), nProcs );
+
+    /* print the results in the order of outputs */
+    Abc_NtkForEachPo( pNtk, pNodePo, i ) {
+        struct saucy_job * pJob = p->pJobs + i;
+        printf("Output %s\n\n", Abc_ObjName(pNodePo));
+        fflush( stdout );
+        copy_stream( pJob->pOut, stdout );
+        fflush( stdout );
+        if (pJob->pGen)
+            copy_stream( pJob->pGen, gFile );
+        printf("----------------------------------------\n");
+        if (pJob->fDone)
+            appendGroupSize( &pJob->stats );
+        fclose( pJob->pOut );
+        if (pJob->pGen) fclose( pJob->pGen );
+        Abc_NtkDelete( pJob->pNtk );
+    }
+    ABC_FREE( p->pJobs );
+}
 
-}ABC_NAMESPACE_IMPL_END
+ABC_NAMESPACE_IMPL_END
 
 
@@ -29,6 +29,18 @@
 #include "base/main/main.h"
 #include "base/cmd/cmd.h"
 
+#ifdef ABC_USE_PTHREADS
+
+#ifdef _WIN32
+#include "../lib/pthread.h"
+#else
+#include <pthread.h>
+#include <sched.h>
+#include <unistd.h>
+#endif
+
+#endif
+
 ABC_NAMESPACE_IMPL_START
 
 ////////////////////////////////////////////////////////////////////////
@@ -2860,6 +2872,472 @@ Vec_Ptr_t * Acb_TransformPatchFunctions( Vec_Ptr_t * vSops, Vec_Wec_t * vSupps,
     return vFuncs;
 }
 
+/**Function*************************************************************
+
+  Synopsis    [Splits the targets into independent groups.]
+
+  Description [Two targets belong to the same group if their TFOs reach 
+  a common primary output. Groups are found by propagating the target 
+  labels from the targets towards the roots and merging the labels that 
+  meet at a node (union-find). The patch of a target only depends on the 
+  other targets of its group, so the groups can be solved independently. 
+  Returns the target indexes of each group (in increasing order) and the 
+  roots of each group in the same order as in vRoots. The groups without 
+  roots are merged into the first group that has roots.]
+               
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+static inline int Acb_NtkEcoFindRepr( Vec_Int_t * vUnion, int i )
+{
+    while ( Vec_IntEntry(vUnion, i) != i )
+    {
+        Vec_IntWriteEntry( vUnion, i, Vec_IntEntry(vUnion, Vec_IntEntry(vUnion, i)) );
+        i = Vec_IntEntry( vUnion, i );
+    }
+    return i;
+}
+int Acb_NtkFindTargetGroups_rec( Acb_Ntk_t * p, int iObj, Vec_Int_t * vLabels, Vec_Int_t * vUnion )
+{
+    int * pFanin, iFanin, i, iTar, iRes = -1;
+    if ( Acb_ObjSetTravIdCur(p, iObj) )
+        return Vec_IntEntry(vLabels, iObj) == -1 ? -1 : Acb_NtkEcoFindRepr( vUnion, Vec_IntEntry(vLabels, iObj) );
+    if ( !Acb_ObjIsCi(p, iObj) )
+    Acb_ObjForEachFaninFast( p, iObj, pFanin, iFanin, i )
+    {
+        iTar = Acb_NtkFindTargetGroups_rec( p, iFanin, vLabels, vUnion );
+        if ( iTar == -1 )
+            continue;
+        if ( iRes != -1 )
+            iRes = Acb_NtkEcoFindRepr( vUnion, iRes );
+        if ( iRes == -1 || iRes == iTar )
+            iRes = iTar;
+        else 
+        {
+            Vec_IntWriteEntry( vUnion, Abc_MaxInt(iRes, iTar), Abc_MinInt(iRes, iTar) );
+            iRes = Abc_MinInt( iRes, iTar );
+        }
+    }
+    Vec_IntWriteEntry( vLabels, iObj, iRes );
+    return iRes;
+}
+Vec_Wec_t * Acb_NtkFindTargetGroups( Acb_Ntk_t * p, Vec_Int_t * vRoots, Vec_Wec_t ** pvGroupRoots )
+{
+    Vec_Wec_t * vGroups, * vGroupRoots;
+    Vec_Int_t * vLabels = Vec_IntStartFull( Acb_NtkObjNum(p) );
+    Vec_Int_t * vUnion  = Vec_IntStartNatural( Vec_IntSize(&p->vTargets) );
+    Vec_Int_t * vGroupId = Vec_IntStartFull( Vec_IntSize(&p->vTargets) );
+    int i, k, iObj, iTar, iGroup, iFirst = -1;
+    // label the targets
+    Acb_NtkIncTravId( p );
+    Vec_IntForEachEntry( &p->vTargets, iObj, i )
+    {
+        Acb_ObjSetTravIdCur( p, iObj );
+        Vec_IntWriteEntry( vLabels, iObj, i );
+    }
+    // merge the labels meeting in the TFI of the roots
+    Acb_NtkForEachCoDriverVec( vRoots, p, iObj, i )
+        Acb_NtkFindTargetGroups_rec( p, iObj, vLabels, vUnion );
+    // number the groups in the order of their smallest target 
+    vGroups = Vec_WecAlloc( 16 );
+    Vec_IntForEachEntry( &p->vTargets, iObj, i )
+    {
+        iTar = Acb_NtkEcoFindRepr( vUnion, i );
+        if ( Vec_IntEntry(vGroupId, iTar) == -1 )
+        {
+            Vec_IntWriteEntry( vGroupId, iTar, Vec_WecSize(vGroups) );
+            Vec_WecPushLevel( vGroups );
+        }
+        Vec_WecPush( vGroups, Vec_IntEntry(vGroupId, iTar), i );
+    }
+    // collect the roots of each group
+    vGroupRoots = Vec_WecStart( Vec_WecSize(vGroups) );
+    Acb_NtkIncTravId( p );
+    Vec_IntForEachEntry( &p->vTargets, iObj, i )
+        Acb_ObjSetTravIdCur( p, iObj );
+    Acb_NtkForEachCoDriverVec( vRoots, p, iObj, i )
+    {
+        iTar = Acb_NtkFindTargetGroups_rec( p, iObj, vLabels, vUnion );
+        assert( iTar >= 0 );
+        Vec_WecPush( vGroupRoots, Vec_IntEntry(vGroupId, Acb_NtkEcoFindRepr(vUnion, iTar)), Vec_IntEntry(vRoots, i) );
+    }
+    // merge the groups without roots into the first group with roots
+    for ( i = 0; i < Vec_WecSize(vGroups); i++ )
+        if ( Vec_IntSize(Vec_WecEntry(vGroupRoots, i)) > 0 )
+        {
+            iFirst = i;
+            break;
+        }
+    assert( iFirst >= 0 );
+    for ( i = 0; i < Vec_WecSize(vGroups); i++ )
+        if ( Vec_IntSize(Vec_WecEntry(vGroupRoots, i)) == 0 )
+        {
+            Vec_IntForEachEntry( Vec_WecEntry(vGroups, i), iTar, iGroup )
+                Vec_IntPush( Vec_WecEntry(vGroups, iFirst), iTar );
+            Vec_IntClear( Vec_WecEntry(vGroups, i) );
+        }
+    // compact the groups with roots
+    for ( i = k = 0; i < Vec_WecSize(vGroups); i++ )
+    {
+        if ( Vec_IntSize(Vec_WecEntry(vGroupRoots, i)) == 0 )
+            continue;
+        if ( i == k )
+        {
+            k++;
+            continue;
+        }
+        Vec_IntClear( Vec_WecEntry(vGroups, k) );
+        Vec_IntAppend( Vec_WecEntry(vGroups, k), Vec_WecEntry(vGroups, i) );
+        Vec_IntClear( Vec_WecEntry(vGroupRoots, k) );
+        Vec_IntAppend( Vec_WecEntry(vGroupRoots, k), Vec_WecEntry(vGroupRoots, i) );
+        k++;
+    }
+    Vec_WecShrink( vGroups, k );
+    Vec_WecShrink( vGroupRoots, k );
+    for ( i = 0; i < Vec_WecSize(vGroups); i++ )
+        Vec_IntSort( Vec_WecEntry(vGroups, i), 0 );
+    Vec_IntFree( vGroupId );
+    Vec_IntFree( vLabels );
+    Vec_IntFree( vUnion );
+    *pvGroupRoots = vGroupRoots;
+    return vGroups;
+}
+
+/**Function*************************************************************
+
+  Synopsis    [Computes the patches of one group of targets.]
+
+  Description [The targets of the group are the last CIs of the miter.
+  They are processed in the reverse order. For each target, the remaining
+  targets are quantified, the support is computed with SAT, the patch is 
+  derived by enumerating satisfying assignments, and the patch is 
+  substituted into the miter. When the group is solved by a worker thread, 
+  SOP synthesis is serialized because it goes through the global frame.]
+               
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+typedef struct Acb_EcoGroup_t_ Acb_EcoGroup_t;
+struct Acb_EcoGroup_t_
+{
+    Acb_Ntk_t *      pNtkF;         // implementation network (not modified)
+    Gia_Man_t *      pGiaM;         // miter of the group (updated with the patches)
+    Vec_Int_t *      vTars;         // targets of the group (indexes in pNtkF->vTargets)
+    Vec_Int_t *      vDivs;         // divisors (shared by the groups)
+    Vec_Ptr_t *      vSops;         // patch functions (in the reverse order of targets)
+    Vec_Wec_t *      vSupps;        // patch supports (in the reverse order of targets)
+    abctime          clkStart;      // the start of the computation
+    int              nTimeout;      // the timeout in seconds
+    int              fThreaded;     // the group is solved by a worker thread
+    int              fVerbose;      // verbose output
+    int              fVeryVerbose;  // verbose output
+    int              RetValue;      // 1 if the patches are found
+    int              fVerified;     // 1 if the resulting miter is UNSAT
+    abctime          clkVerify;     // the time to verify the result
+};
+
+#ifdef ABC_USE_PTHREADS
+static pthread_mutex_t s_AcbEcoMutex = PTHREAD_MUTEX_INITIALIZER;
+#endif
+
+int Acb_NtkEcoSolveGroup( Acb_EcoGroup_t * p )
+{
+    extern Gia_Man_t * Abc_SopSynthesizeOne( char * pSop, int fClp );
+    Gia_Man_t * pTemp, * pOne;
+    Cnf_Dat_t * pCnf;
+    Vec_Int_t * vSupp, * vSuppOld = Vec_IntAlloc( 100 );
+    int nTargets = Vec_IntSize(p->vTars);
+    int TimeOut  = 120;
+    char * pSop = NULL;
+    int i, Res;
+    abctime clk;
+    p->RetValue = 0;
+    for ( i = nTargets-1; i >= 0; i-- )
+    {
+        printf( "\nConsidering target %d (out of %d)...\n", Vec_IntEntry(p->vTars, i), Vec_IntSize(&p->pNtkF->vTargets) );
+        // compute support of this target
+        pCnf = Acb_NtkDeriveMiterCnf( p->pGiaM, i, nTargets, p->fVerbose );
+        vSupp = Acb_DerivePatchSupport( pCnf, i, nTargets, Vec_IntSize(p->vDivs), p->vDivs, p->pNtkF, vSuppOld, TimeOut );
+        if ( vSupp == NULL )
+        {
+            Cnf_DataFree( pCnf );
+            Vec_IntFree( vSuppOld );
+            return 0;
+        }
+        Vec_IntAppend( vSuppOld, vSupp );
+        Vec_IntClear( vSupp );
+        Vec_IntAppend( vSupp, vSuppOld );
+
+        // derive function of this target
+        pSop  = Acb_DeriveOnePatchFunction( pCnf, i, nTargets, Vec_IntSize(p->vDivs), vSupp, 0 );
+        Cnf_DataFree( pCnf );
+        if ( pSop == NULL )
+        {
+            Vec_IntFree( vSupp );
+            Vec_IntFree( vSuppOld );
+            return 0;
+        }
+        if ( p->nTimeout && (Abc_Clock() - p->clkStart)/CLOCKS_PER_SEC >= p->nTimeout ) 
+        {
+            Vec_IntFree( vSupp );
+            Vec_IntFree( vSuppOld );
+            ABC_FREE( pSop );
+            printf( "The target computation timed out after %d seconds.\n", p->nTimeout );
+            return 0;
+        }
+
+        // add new function to the miter
+#ifdef ABC_USE_PTHREADS
+        if ( p->fThreaded )
+            pthread_mutex_lock( &s_AcbEcoMutex );
+#endif
+        pOne  = Abc_SopSynthesizeOne( pSop, 1 );
+#ifdef ABC_USE_PTHREADS
+        if ( p->fThreaded )
+            pthread_mutex_unlock( &s_AcbEcoMutex );
+#endif
+        printf( "Tar%02d: ", Vec_IntEntry(p->vTars, i) );
+        Gia_ManPrintStats( pOne, NULL );
+
+        // update miter
+        p->pGiaM = Acb_UpdateMiter( pTemp = p->pGiaM, pOne, i, nTargets, vSupp, 0 );
+        Gia_ManStop( pTemp );
+        Gia_ManStop( pOne );
+
+        // add to functions
+        Vec_PtrPush( p->vSops, pSop );
+        if ( p->fVeryVerbose )
+            printf( "Function %d\n%s", Vec_IntEntry(p->vTars, i), pSop );
+        // add to supports
+        Vec_IntAppend( Vec_WecPushLevel(p->vSupps), vSupp );
+        Vec_IntFree( vSupp );
+    }
+    Vec_IntFree( vSuppOld );
+    p->RetValue = 1;
+    // make sure the function is UNSAT
+    clk  = Abc_Clock();
+    pCnf = (Cnf_Dat_t *)Mf_ManGenerateCnf( p->pGiaM, 8, 0, 0, 0, 0 );
+    Res  = Acb_CheckMiter( pCnf );
+    Cnf_DataFree( pCnf );
+    p->fVerified = (Res == 1);
+    p->clkVerify = Abc_Clock() - clk;
+    return 1;
+}
+
+/**Function*************************************************************
+
+  Synopsis    [Solves the groups of targets using several threads.]
+
+  Description []
+               
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+#ifndef ABC_USE_PTHREADS
+
+void Acb_NtkEcoSolveGroups( Acb_EcoGroup_t * pGroups, int nGroups, int nProcs )
+{
+    int i;
+    for ( i = 0; i < nGroups; i++ )
+        Acb_NtkEcoSolveGroup( pGroups + i );
+}
+
+#else // pthreads are used
+
+#define ACB_THR_MAX 100
+typedef struct Acb_EcoThData_t_
+{
+    Acb_EcoGroup_t * pGroups;
+    int              Index;
+    int              fWorking;
+} Acb_EcoThData_t;
+
+void * Acb_NtkEcoWorkerThread( void * pArg )
+{
+    Acb_EcoThData_t * pThData = (Acb_EcoThData_t *)pArg;
+    volatile int * pPlace = &pThData->fWorking;
+    while ( 1 )
+    {
+        while ( *pPlace == 0 )
+            sched_yield();
+        assert( pThData->fWorking );
+        if ( pThData->Index == -1 )
+        {
+            pthread_exit( NULL );
+            assert( 0 );
+            return NULL;
+        }
+        Acb_NtkEcoSolveGroup( pThData->pGroups + pThData->Index );
+        pThData->fWorking = 0;
+    }
+    assert( 0 );
+    return NULL;
+}
+void Acb_NtkEcoSolveGroups( Acb_EcoGroup_t * pGroups, int nGroups, int nProcs )
+{
+    Acb_EcoThData_t ThData[ACB_THR_MAX];
+    pthread_t WorkerThread[ACB_THR_MAX];
+    int i, k, status;
+    nProcs = Abc_MinInt( Abc_MinInt(nProcs, nGroups), ACB_THR_MAX );
+    if ( nProcs <= 1 )
+    {
+        for ( i = 0; i < nGroups; i++ )
+            Acb_NtkEcoSolveGroup( pGroups + i );
+        return;
+    }
+    for ( i = 0; i < nGroups; i++ )
+        pGroups[i].fThreaded = 1;
+    // start threads
+    for ( i = 0; i < nProcs; i++ )
+    {
+        ThData[i].pGroups  = pGroups;
+        ThData[i].Index    = -1;
+        ThData[i].fWorking = 0;
+        status = pthread_create( WorkerThread + i, NULL, Acb_NtkEcoWorkerThread, (void *)(ThData + i) );  assert( status == 0 );
+    }
+    // distribute the groups
+    for ( k = 0; k < nGroups; k++ )
+    {
+        for ( i = 0; i < nProcs; i++ )
+        {
+            if ( ThData[i].fWorking )
+                continue;
+            ThData[i].Index = k;
+            ThData[i].fWorking = 1;
+            break;
+        }
+        if ( i == nProcs )
+        {
+            sched_yield();
+            k--;
+        }
+    }
+    // wait till threads finish
+    for ( i = 0; i < nProcs; i++ )
+        while ( ((volatile int *)&ThData[i].fWorking)[0] )
+            sched_yield();
+    // stop threads
+    for ( i = 0; i < nProcs; i++ )
+    {
+        ThData[i].Index = -1;
+        ThData[i].fWorking = 1;
+    }
+    for ( i = 0; i < nProcs; i++ )
+        pthread_join( WorkerThread[i], NULL );
+}
+
+#endif // pthreads are used
+
+/**Function*************************************************************
+
+  Synopsis    [Computes the patches by solving groups of targets.]
+
+  Description [Each group gets its own miter built for the roots in the 
+  TFO of its targets. The groups are solved by nProcs threads. The patches 
+  are returned in the same order as in the monolithic computation.]
+               
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+int Acb_NtkEcoPerformGroups( Acb_Ntk_t * pNtkF, Acb_Ntk_t * pNtkG, Vec_Int_t * vRoots, Vec_Int_t * vSupp, Vec_Int_t * vDivs, 
+                             Vec_Ptr_t * vSops, Vec_Wec_t * vSupps, int nProcs, int nTimeout, abctime clkStart, int fVerbose, int fVeryVerbose )
+{
+    Vec_Wec_t * vGroupRoots, * vGroups = Acb_NtkFindTargetGroups( pNtkF, vRoots, &vGroupRoots );
+    int nGroups = Vec_WecSize(vGroups), nTargets = Vec_IntSize(&pNtkF->vTargets);
+    Acb_EcoGroup_t * pGroups = ABC_CALLOC( Acb_EcoGroup_t, nGroups );
+    Vec_Int_t * vTarObjs = Vec_IntAlloc( nTargets );
+    Vec_Int_t * vTars, * vGroup = Vec_IntStartFull( nTargets );
+    Vec_Int_t * vOrder = Vec_IntStartFull( nTargets );
+    int i, k, iTar, RetValue = 1, nVerified = 0;
+    abctime clkVerify = 0;
+    if ( fVerbose )
+        printf( "Solving %d independent groups of targets using %d threads.\n", nGroups, Abc_MinInt(nProcs, nGroups) );
+    // derive the miters of the groups
+    Vec_WecForEachLevel( vGroups, vTars, i )
+    {
+        Acb_EcoGroup_t * p = pGroups + i;
+        Vec_Int_t * vRootsG = Vec_WecEntry( vGroupRoots, i );
+        Vec_Int_t * vNodesF = Acb_NtkFindNodes( pNtkF, vRootsG, vDivs );
+        Vec_Int_t * vNodesG = Acb_NtkFindNodes( pNtkG, vRootsG, NULL );
+        Gia_Man_t * pGiaF, * pGiaG;
+        Vec_IntClear( vTarObjs );
+        Vec_IntForEachEntry( vTars, iTar, k )
+        {
+            Vec_IntPush( vTarObjs, Vec_IntEntry(&pNtkF->vTargets, iTar) );
+            Vec_IntWriteEntry( vGroup, iTar, i );
+            Vec_IntWriteEntry( vOrder, iTar, Vec_IntSize(vTars) - 1 - k );
+        }
+        pGiaF = Acb_NtkToGia( pNtkF, vSupp, vNodesF, vRootsG, vDivs, vTarObjs );
+        pGiaG = Acb_NtkToGia( pNtkG, vSupp, vNodesG, vRootsG, NULL, NULL );
+        p->pGiaM        = Acb_CreateMiter( pGiaF, pGiaG );
+        p->pNtkF        = pNtkF;
+        p->vTars        = vTars;
+        p->vDivs        = vDivs;
+        p->vSops        = Vec_PtrAlloc( Vec_IntSize(vTars) );
+        p->vSupps       = Vec_WecAlloc( Vec_IntSize(vTars) );
+        p->clkStart     = clkStart;
+        p->nTimeout     = nTimeout;
+        p->fVerbose     = fVerbose;
+        p->fVeryVerbose = fVeryVerbose;
+        if ( fVerbose )
+        {
+            printf( "Group %d: Targets = %d. Roots = %d. Miter: ", i, Vec_IntSize(vTars), Vec_IntSize(vRootsG) );
+            Gia_ManPrintStats( p->pGiaM, NULL );
+        }
+        Gia_ManStop( pGiaF );
+        Gia_ManStop( pGiaG );
+        Vec_IntFree( vNodesF );
+        Vec_IntFree( vNodesG );
+    }
+    // solve the groups
+    Acb_NtkEcoSolveGroups( pGroups, nGroups, nProcs );
+    for ( i = 0; i < nGroups; i++ )
+    {
+        RetValue &= pGroups[i].RetValue;
+        nVerified += pGroups[i].fVerified;
+        clkVerify += pGroups[i].clkVerify;
+    }
+    // collect the patches in the reverse order of targets
+    if ( RetValue )
+    {
+        for ( iTar = nTargets-1; iTar >= 0; iTar-- )
+        {
+            Acb_EcoGroup_t * p = pGroups + Vec_IntEntry(vGroup, iTar);
+            int iEntry = Vec_IntEntry( vOrder, iTar );
+            Vec_PtrPush( vSops, Vec_PtrEntry(p->vSops, iEntry) );
+            Vec_PtrWriteEntry( p->vSops, iEntry, NULL );
+            Vec_IntAppend( Vec_WecPushLevel(vSupps), Vec_WecEntry(p->vSupps, iEntry) );
+        }
+        printf( "\n" );
+        if ( nVerified == nGroups )
+            printf( "The ECO solution was verified successfully.  " );
+        else
+            printf( "The ECO solution verification FAILED in %d (out of %d) groups.  ", nGroups - nVerified, nGroups );
+        Abc_PrintTime( 1, "Time", clkVerify );
+    }
+    for ( i = 0; i < nGroups; i++ )
+    {
+        Vec_PtrFreeFree( pGroups[i].vSops );
+        Vec_WecFree( pGroups[i].vSupps );
+        Gia_ManStop( pGroups[i].pGiaM );
+    }
+    ABC_FREE( pGroups );
+    Vec_IntFree( vTarObjs );
+    Vec_IntFree( vGroup );
+    Vec_IntFree( vOrder );
+    Vec_WecFree( vGroupRoots );
+    Vec_WecFree( vGroups );
+    return RetValue;
+}
+
 /**Function*************************************************************
 
   Synopsis    [Performs ECO for two networks.]
@@ -2871,7 +3349,7 @@ Vec_Ptr_t * Acb_TransformPatchFunctions( Vec_Ptr_t * vSops, Vec_Wec_t * vSupps,
   SeeAlso     []
 
 ***********************************************************************/
-int Acb_NtkEcoPerform( Acb_Ntk_t * pNtkF, Acb_Ntk_t * pNtkG, char * pFileName[4], int nTimeout, int fCisOnly, int fInputs, int fCheck, int fUnitW, int fVerbose, int fVeryVerbose )
+int Acb_NtkEcoPerform( Acb_Ntk_t * pNtkF, Acb_Ntk_t * pNtkG, char * pFileName[4], int nTimeout, int nProcs, int fCisOnly, int fInputs, int fCheck, int fUnitW, int fVerbose, int fVeryVerbose )
 {
     extern Gia_Man_t * Abc_SopSynthesizeOne( char * pSop, int fClp );
 
@@ -2884,6 +3362,7 @@ int Acb_NtkEcoPerform( Acb_Ntk_t * pNtkF, Acb_Ntk_t * pNtkG, char * pFileName[4]
     // compute various sets of nodes
     Vec_Bit_t * vBlock;
     Vec_Int_t * vRoots  = Acb_NtkFindRoots( pNtkF, &pNtkF->vTargets, &vBlock );
+    int fGroups  = !fCisOnly && nProcs > 1 && Vec_IntSize(vRoots) > 0;
     Vec_Int_t * vSuppF  = Acb_NtkFindSupp( pNtkF, vRoots );
     Vec_Int_t * vSuppG  = Acb_NtkFindSupp( pNtkG, vRoots );
     Vec_Int_t * vSupp   = Vec_IntTwoMerge( vSuppF, vSuppG );
@@ -2948,6 +3427,16 @@ int Acb_NtkEcoPerform( Acb_Ntk_t * pNtkF, Acb_Ntk_t * pNtkG, char * pFileName[4]
         }
     }
 
+    // solve independent groups of targets in parallel
+    if ( fGroups )
+    {
+        if ( !Acb_NtkEcoPerformGroups( pNtkF, pNtkG, vRoots, vSupp, vDivs, vSops, vSupps, nProcs, nTimeout, clkStart, fVerbose, fVeryVerbose ) )
+        {
+            RetValue = 0;
+            goto cleanup;
+        }
+    }
+    else
     for ( i = nTargets-1; i >= 0; i-- )
     {
         Vec_Int_t * vSupp = NULL;
@@ -3024,7 +3513,7 @@ int Acb_NtkEcoPerform( Acb_Ntk_t * pNtkF, Acb_Ntk_t * pNtkG, char * pFileName[4]
 
     // make sure the function is UNSAT
     printf( "\n" );
-    if ( !fCisOnly )
+    if ( !fCisOnly && !fGroups )
     {
         int Res;
         abctime clk  = Abc_Clock();
@@ -3137,7 +3626,7 @@ void Acb_NtkTestRun2( char * pFileNames[3], int fVerbose )
   SeeAlso     []
 
 ***********************************************************************/
-void Acb_NtkRunEco( char * pFileNames[4], int nTimeout, int fCheck, int fRandom, int fInputs, int fUnitW, int fVerbose, int fVeryVerbose )
+void Acb_NtkRunEco( char * pFileNames[4], int nTimeout, int nProcs, int fCheck, int fRandom, int fInputs, int fUnitW, int fVerbose, int fVeryVerbose )
 {
     char Command[1000]; int Result = 1;
     Acb_Ntk_t * pNtkF = Acb_VerilogSimpleRead( pFileNames[0], pFileNames[2] );
@@ -3159,10 +3648,10 @@ void Acb_NtkRunEco( char * pFileNames[4], int nTimeout, int fCheck, int fRandom,
 
     Acb_IntallLibrary( Abc_FrameReadSignalNames() != NULL );
 
-    if ( !Acb_NtkEcoPerform( pNtkF, pNtkG, pFileNames, nTimeout, 0, fInputs, fCheck, fUnitW, fVerbose, fVeryVerbose ) )
+    if ( !Acb_NtkEcoPerform( pNtkF, pNtkG, pFileNames, nTimeout, nProcs, 0, fInputs, fCheck, fUnitW, fVerbose, fVeryVerbose ) )
     {
 //        printf( "General computation timed out. Trying inputs only.\n\n" );
-//        if ( !Acb_NtkEcoPerform( pNtkF, pNtkG, pFileNames, nTimeout, 1, fInputs, fCheck, fUnitW, fVerbose, fVeryVerbose ) )
+//        if ( !Acb_NtkEcoPerform( pNtkF, pNtkG, pFileNames, nTimeout, nProcs, 1, fInputs, fCheck, fUnitW, fVerbose, fVeryVerbose ) )
 //            printf( "Input-only computation also timed out.\n\n" );
         printf( "Computation did not succeed.\n" );
         Result = 0;
@@ -1004,6 +1004,7 @@ extern Cba_Man_t *   Cba_ManReadBlif( char * pFileName );
 extern Cba_Man_t *   Prs_ManBuildCbaVerilog( char * pFileName, Vec_Ptr_t * vDes );
 extern void          Prs_ManReadVerilogTest( char * pFileName );
 extern Cba_Man_t *   Cba_ManReadVerilog( char * pFileName );
+extern Cba_Man_t *   Cba_ManReadVerilogPar( char * pFileName, int nProcs, int fVerbose );
 /*=== cbaWriteBlif.c =========================================================*/
 extern void          Prs_ManWriteBlif( char * pFileName, Vec_Ptr_t * p );
 extern void          Cba_ManWriteBlif( char * pFileName, Cba_Man_t * p );
@@ -103,12 +103,23 @@ int Cba_CommandRead( Abc_Frame_t * pAbc, int argc, char ** argv )
     FILE * pFile;
     Cba_Man_t * p = NULL;
     char * pFileName = NULL;
-    int c, fTest = 0, fDfs = 0, fVerbose = 0;
+    int c, nProcs = 1, fTest = 0, fDfs = 0, fVerbose = 0;
     Extra_UtilGetoptReset();
-    while ( ( c = Extra_UtilGetopt( argc, argv, "tdvh" ) ) != EOF )
+    while ( ( c = Extra_UtilGetopt( argc, argv, "Ptdvh" ) ) != EOF )
     {
         switch ( c )
         {
+        case 'P':
+            if ( globalUtilOptind >= argc )
+            {
+                Abc_Print( -1, "Command line switch \"-P\" should be followed by an integer.\n" );
+                goto usage;
+            }
+            nProcs = atoi(argv[globalUtilOptind]);
+            globalUtilOptind++;
+            if ( nProcs <= 0 )
+                goto usage;
+            break;
         case 't':
             fTest ^= 1;
             break;
@@ -156,7 +167,7 @@ int Cba_CommandRead( Abc_Frame_t * pAbc, int argc, char ** argv )
     if ( !strcmp( Extra_FileNameExtension(pFileName), "blif" )  )
         p = Cba_ManReadBlif( pFileName );
     else if ( !strcmp( Extra_FileNameExtension(pFileName), "v" )  )
-        p = Cba_ManReadVerilog( pFileName );
+        p = Cba_ManReadVerilogPar( pFileName, nProcs, fVerbose );
     else if ( !strcmp( Extra_FileNameExtension(pFileName), "cba" )  )
         p = Cba_ManReadCba( pFileName );
     else 
@@ -173,8 +184,9 @@ int Cba_CommandRead( Abc_Frame_t * pAbc, int argc, char ** argv )
     Cba_AbcUpdateMan( pAbc, p );
     return 0;
 usage:
-    Abc_Print( -2, "usage: :read [-tdvh] <file_name>\n" );
+    Abc_Print( -2, "usage: :read [-P num] [-tdvh] <file_name>\n" );
     Abc_Print( -2, "\t         reads hierarchical design\n" );
+    Abc_Print( -2, "\t-P num : the number of threads for parsing Verilog modules [default = %d]\n", nProcs );
     Abc_Print( -2, "\t-t     : toggle testing the parser [default = %s]\n", fTest? "yes": "no" );
     Abc_Print( -2, "\t-d     : toggle computing DFS ordering [default = %s]\n", fDfs? "yes": "no" );
     Abc_Print( -2, "\t-v     : toggle printing verbose information [default = %s]\n", fVerbose? "yes": "no" );
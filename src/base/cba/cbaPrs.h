@@ -112,6 +112,7 @@ struct Prs_Man_t_
     char *          pBuffer;     // file contents
     char *          pLimit;      // end of file
     char *          pCur;        // current position
+    int             iLineStart;  // line number of the buffer start in the file
     Abc_Nam_t *     pStrs;       // string manager
     Abc_Nam_t *     pFuns;       // cover manager
     Hash_IntMan_t * vHash;       // variable ranges
@@ -201,7 +202,7 @@ static inline void Prs_ManErrorClear( Prs_Man_t * p )
 // print error message
 static inline int Prs_ManErrorPrint( Prs_Man_t * p )
 {
-    char * pThis; int iLine = 0;
+    char * pThis; int iLine = p->iLineStart;
     if ( !p->ErrorStr[0] ) return 1;
     for ( pThis = p->pBuffer; pThis < p->pCur; pThis++ )
         iLine += (int)(*pThis == '\n');
@@ -508,6 +509,7 @@ static inline char * Ptr_TypeToSop( Cba_ObjType_t Type )
 
 /*=== cbaReadVer.c ========================================================*/
 extern void Prs_NtkAddVerilogDirectives( Prs_Man_t * p );
+extern Vec_Ptr_t * Prs_ManReadVerilogPar( char * pFileName, int nProcs, int fVerbose );
 
 
 ABC_NAMESPACE_HEADER_END
@@ -21,6 +21,16 @@
 #include "cba.h"
 #include "cbaPrs.h"
 
+#ifdef ABC_USE_PTHREADS
+
+#ifdef _WIN32
+#include "../lib/pthread.h"
+#else
+#include <pthread.h>
+#endif
+
+#endif
+
 ABC_NAMESPACE_IMPL_START
 
 ////////////////////////////////////////////////////////////////////////
@@ -1405,6 +1415,412 @@ void Prs_ManReadVerilogTest( char * pFileName )
     Prs_ManVecFree( vPrs );
 }
 
+/**Function*************************************************************
+
+  Synopsis    [Splits the file buffer into chunks of complete modules.]
+
+  Description [Returns the array of triples (start offset, stop offset, 
+  first line number) in the buffer. Module boundaries are detected by
+  locating keyword "endmodule" outside of comments and escaped names.
+  The modules are grouped into chunks of about nChunkSize bytes.]
+               
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+Vec_Int_t * Prs_ManSplitModules( char * pBuffer, char * pLimit, int nChunkSize )
+{
+    Vec_Int_t * vChunks = Vec_IntAlloc( 100 );
+    char * pCur, * pStart = pBuffer, * pStop = pLimit - 1;
+    int iLine = 0, iLineStart = -1; // each chunk buffer begins with an extra new-line
+    assert( *pStop == '\0' );
+    for ( pCur = pBuffer; pCur < pStop; pCur++ )
+    {
+        if ( *pCur == '\n' )
+            iLine++;
+        else if ( pCur[0] == '/' && pCur[1] == '/' )
+        {
+            while ( pCur < pStop && *pCur != '\n' )
+                pCur++;
+            iLine++;
+        }
+        else if ( pCur[0] == '/' && pCur[1] == '*' )
+        {
+            for ( pCur += 2; pCur < pStop && !(pCur[0] == '*' && pCur[1] == '/'); pCur++ )
+                iLine += (int)(*pCur == '\n');
+            pCur++;
+        }
+        else if ( *pCur == '\\' )
+        {
+            while ( pCur < pStop && *pCur != ' ' && *pCur != '\n' )
+                pCur++;
+            iLine += (int)(*pCur == '\n');
+        }
+        else if ( *pCur == 'e' && !Prs_CharIsSymb2(pCur[-1]) && !strncmp(pCur, "endmodule", 9) && !Prs_CharIsSymb2(pCur[9]) )
+        {
+            pCur += 8;
+            if ( pCur + 1 - pStart < nChunkSize )
+                continue;
+            Vec_IntPushThree( vChunks, pStart - pBuffer, pCur + 1 - pBuffer, iLineStart );
+            pStart = pCur + 1;
+            iLineStart = iLine - 1;
+        }
+    }
+    // the remainder goes into the last chunk
+    if ( Vec_IntSize(vChunks) == 0 )
+        Vec_IntPushThree( vChunks, 0, pStop - pBuffer, iLineStart );
+    else
+        Vec_IntWriteEntry( vChunks, Vec_IntSize(vChunks)-2, pStop - pBuffer );
+    return vChunks;
+}
+
+/**Function*************************************************************
+
+  Synopsis    [Parses one chunk of the file into an independent manager.]
+
+  Description [The resulting manager has its own name/function/range
+  tables and can be created concurrently with managers of other chunks.]
+               
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+Prs_Man_t * Prs_ManReadVerilogChunk( char * pFileName, char * pStart, char * pStop, int iLineStart )
+{
+    Prs_Man_t * p = Prs_ManAlloc( NULL );
+    int nSize = pStop - pStart;
+    p->pName   = pFileName;
+    p->pBuffer = ABC_ALLOC( char, nSize + 16 );
+    p->pBuffer[0] = '\n';
+    memcpy( p->pBuffer + 1, pStart, (size_t)nSize );
+    p->pBuffer[nSize + 1] = '\n';
+    p->pBuffer[nSize + 2] = '\0';
+    p->pLimit  = p->pBuffer + nSize + 3;
+    p->pCur    = p->pBuffer;
+    p->iLineStart = iLineStart;
+    Abc_NamStrFindOrAdd( p->pFuns, "1\'b0", NULL );
+    Abc_NamStrFindOrAdd( p->pFuns, "1\'b1", NULL );
+    Abc_NamStrFindOrAdd( p->pFuns, "1\'bx", NULL );
+    Abc_NamStrFindOrAdd( p->pFuns, "1\'bz", NULL );
+    Prs_NtkAddVerilogDirectives( p );
+    Prs_ManReadDesign( p );
+    return p;
+}
+
+/**Function*************************************************************
+
+  Synopsis    [Moves networks parsed in a chunk into the common manager.]
+
+  Description [Translates name, constant and range IDs of the chunk
+  into the IDs of the common manager. Chunks are merged in the file
+  order, so the IDs are the same as those assigned by the sequential
+  parser.]
+               
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+static inline int Prs_ManRemapSig( int Sig, Vec_Int_t * vMapStr, Vec_Int_t * vMapFun )
+{
+    int Type = Abc_Lit2Att2( Sig ), Value = Abc_Lit2Var2( Sig );
+    if ( Type == CBA_PRS_NAME )
+        return Abc_Var2Lit2( Vec_IntEntry(vMapStr, Value), Type );
+    if ( Type == CBA_PRS_CONST )
+        return Abc_Var2Lit2( Vec_IntEntry(vMapFun, Value), Type );
+    return Sig; // slices and concatenations are local to the network
+}
+static inline void Prs_ManRemapVec( Vec_Int_t * vVec, Vec_Int_t * vMap )
+{
+    int i, Entry;
+    Vec_IntForEachEntry( vVec, Entry, i )
+        Vec_IntWriteEntry( vVec, i, Vec_IntEntry(vMap, Entry) );
+}
+static inline void Prs_ManRemapRanges( Vec_Int_t * vVec, Vec_Int_t * vMapRan )
+{
+    int i, Entry;
+    Vec_IntForEachEntry( vVec, Entry, i )
+        Vec_IntWriteEntry( vVec, i, Abc_Var2Lit(Vec_IntEntry(vMapRan, Abc_Lit2Var(Entry)), Abc_LitIsCompl(Entry)) );
+}
+void Prs_NtkRemap( Prs_Ntk_t * p, Vec_Int_t * vMapStr, Vec_Int_t * vMapFun, Vec_Int_t * vMapRan )
+{
+    int i, k, Entry, nSize;
+    p->iModuleName = Vec_IntEntry( vMapStr, p->iModuleName );
+    Vec_IntForEachEntry( &p->vOrder, Entry, i )
+        Vec_IntWriteEntry( &p->vOrder, i, Abc_Var2Lit2(Vec_IntEntry(vMapStr, Abc_Lit2Var2(Entry)), Abc_Lit2Att2(Entry)) );
+    Prs_ManRemapVec( &p->vInouts,  vMapStr );
+    Prs_ManRemapVec( &p->vInputs,  vMapStr );
+    Prs_ManRemapVec( &p->vOutputs, vMapStr );
+    Prs_ManRemapVec( &p->vWires,   vMapStr );
+    Prs_ManRemapRanges( &p->vInoutsR,  vMapRan );
+    Prs_ManRemapRanges( &p->vInputsR,  vMapRan );
+    Prs_ManRemapRanges( &p->vOutputsR, vMapRan );
+    Prs_ManRemapRanges( &p->vWiresR,   vMapRan );
+    // slices are pairs {NameId, RangeId}
+    for ( i = 0; i < Vec_IntSize(&p->vSlices); i += 2 )
+    {
+        Vec_IntWriteEntry( &p->vSlices, i,   Vec_IntEntry(vMapStr, Vec_IntEntry(&p->vSlices, i)) );
+        Vec_IntWriteEntry( &p->vSlices, i+1, Vec_IntEntry(vMapRan, Vec_IntEntry(&p->vSlices, i+1)) );
+    }
+    // concatenations are {Size, Sig1, Sig2, ...} starting at odd positions
+    for ( i = 0; i < Vec_IntSize(&p->vConcats); i += nSize + 1 )
+    {
+        if ( (nSize = Vec_IntEntry(&p->vConcats, i)) == -1 )
+        {
+            nSize = 0;
+            continue;
+        }
+        for ( k = i + 1; k <= i + nSize; k++ )
+            Vec_IntWriteEntry( &p->vConcats, k, Prs_ManRemapSig(Vec_IntEntry(&p->vConcats, k), vMapStr, vMapFun) );
+    }
+    // boxes are {Size+2, ModName, InstName, Form1, Act1, Form2, Act2, ...} starting at odd positions
+    for ( i = 0; i < Vec_IntSize(&p->vBoxes); i += nSize + 1 )
+    {
+        if ( (nSize = Vec_IntEntry(&p->vBoxes, i)) == -1 )
+        {
+            nSize = 0;
+            continue;
+        }
+        if ( Vec_IntEntry(&p->vBoxes, i+3) ) // module instance (nodes have operator types instead of names)
+            Vec_IntWriteEntry( &p->vBoxes, i+1, Vec_IntEntry(vMapStr, Vec_IntEntry(&p->vBoxes, i+1)) );
+        Vec_IntWriteEntry( &p->vBoxes, i+2, Vec_IntEntry(vMapStr, Vec_IntEntry(&p->vBoxes, i+2)) );
+        for ( k = i + 3; k <= i + nSize; k += 2 )
+        {
+            Vec_IntWriteEntry( &p->vBoxes, k,   Vec_IntEntry(vMapStr, Vec_IntEntry(&p->vBoxes, k)) );
+            Vec_IntWriteEntry( &p->vBoxes, k+1, Prs_ManRemapSig(Vec_IntEntry(&p->vBoxes, k+1), vMapStr, vMapFun) );
+        }
+    }
+}
+void Prs_ManMergeChunk( Prs_Man_t * p, Prs_Man_t * pChunk )
+{
+    Vec_Int_t * vMapStr = Vec_IntAlloc( Abc_NamObjNumMax(pChunk->pStrs) );
+    Vec_Int_t * vMapFun = Vec_IntAlloc( Abc_NamObjNumMax(pChunk->pFuns) );
+    Vec_Int_t * vMapRan = Vec_IntAlloc( Hash_IntManEntryNum(pChunk->vHash) + 1 );
+    Prs_Ntk_t * pNtk; int i;
+    // translate IDs in the order of their appearance in the chunk
+    Vec_IntPush( vMapStr, 0 );
+    for ( i = 1; i < Abc_NamObjNumMax(pChunk->pStrs); i++ )
+        Vec_IntPush( vMapStr, Abc_NamStrFindOrAdd(p->pStrs, Abc_NamStr(pChunk->pStrs, i), NULL) );
+    Vec_IntPush( vMapFun, 0 );
+    for ( i = 1; i < Abc_NamObjNumMax(pChunk->pFuns); i++ )
+        Vec_IntPush( vMapFun, Abc_NamStrFindOrAdd(p->pFuns, Abc_NamStr(pChunk->pFuns, i), NULL) );
+    Vec_IntPush( vMapRan, 0 );
+    for ( i = 1; i <= Hash_IntManEntryNum(pChunk->vHash); i++ )
+        Vec_IntPush( vMapRan, Hash_Int2ManInsert(p->vHash, Hash_IntObjData0(pChunk->vHash, i), Hash_IntObjData1(pChunk->vHash, i), 0) );
+    // move the networks
+    Vec_PtrForEachEntry( Prs_Ntk_t *, pChunk->vNtks, pNtk, i )
+    {
+        Prs_NtkRemap( pNtk, vMapStr, vMapFun, vMapRan );
+        Abc_NamDeref( pNtk->pStrs );  pNtk->pStrs = Abc_NamRef( p->pStrs );
+        Abc_NamDeref( pNtk->pFuns );  pNtk->pFuns = Abc_NamRef( p->pFuns );
+        Hash_IntManDeref( pNtk->vHash );  pNtk->vHash = Hash_IntManRef( p->vHash );
+        Vec_PtrPush( p->vNtks, pNtk );
+    }
+    Vec_PtrClear( pChunk->vNtks );
+    // collect statistics
+    Prs_ManRemapVec( &pChunk->vSucceeded, vMapStr );
+    Prs_ManRemapVec( &pChunk->vKnown,     vMapStr );
+    Prs_ManRemapVec( &pChunk->vFailed,    vMapStr );
+    Vec_IntAppend( &p->vSucceeded, &pChunk->vSucceeded );
+    Vec_IntAppend( &p->vKnown,     &pChunk->vKnown );
+    Vec_IntAppend( &p->vFailed,    &pChunk->vFailed );
+    Vec_IntFree( vMapStr );
+    Vec_IntFree( vMapFun );
+    Vec_IntFree( vMapRan );
+}
+
+/**Function*************************************************************
+
+  Synopsis    [Parses the chunks on several threads.]
+
+  Description []
+               
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+#ifndef ABC_USE_PTHREADS
+
+void Prs_ManReadChunks( char * pFileName, char * pBuffer, Vec_Int_t * vChunks, Prs_Man_t ** ppChunks, int nProcs )
+{
+    int i;
+    for ( i = 0; i < Vec_IntSize(vChunks)/3; i++ )
+        ppChunks[i] = Prs_ManReadVerilogChunk( pFileName, pBuffer + Vec_IntEntry(vChunks, 3*i), pBuffer + Vec_IntEntry(vChunks, 3*i+1), Vec_IntEntry(vChunks, 3*i+2) );
+}
+
+#else // pthreads are used
+
+#define PAR_THR_MAX 100
+typedef struct Prs_ThData_t_
+{
+    char *        pFileName;
+    char *        pBuffer;
+    Vec_Int_t *   vChunks;
+    Prs_Man_t **  ppChunks;
+    int           Index;
+    int           fWorking;
+} Prs_ThData_t;
+
+void * Prs_ManWorkerThread( void * pArg )
+{
+    Prs_ThData_t * pThData = (Prs_ThData_t *)pArg;
+    volatile int * pPlace = &pThData->fWorking;
+    int i;
+    while ( 1 )
+    {
+        while ( *pPlace == 0 );
+        assert( pThData->fWorking );
+        if ( pThData->Index == -1 )
+        {
+            pthread_exit( NULL );
+            assert( 0 );
+            return NULL;
+        }
+        i = pThData->Index;
+        pThData->ppChunks[i] = Prs_ManReadVerilogChunk( pThData->pFileName, pThData->pBuffer + Vec_IntEntry(pThData->vChunks, 3*i), 
+            pThData->pBuffer + Vec_IntEntry(pThData->vChunks, 3*i+1), Vec_IntEntry(pThData->vChunks, 3*i+2) );
+        pThData->fWorking = 0;
+    }
+    assert( 0 );
+    return NULL;
+}
+
+void Prs_ManReadChunks( char * pFileName, char * pBuffer, Vec_Int_t * vChunks, Prs_Man_t ** ppChunks, int nProcs )
+{
+    Prs_ThData_t ThData[PAR_THR_MAX];
+    pthread_t WorkerThread[PAR_THR_MAX];
+    int i, k, status, nChunks = Vec_IntSize(vChunks)/3;
+    if ( nProcs < 2 || nChunks < 2 )
+    {
+        for ( k = 0; k < nChunks; k++ )
+            ppChunks[k] = Prs_ManReadVerilogChunk( pFileName, pBuffer + Vec_IntEntry(vChunks, 3*k), pBuffer + Vec_IntEntry(vChunks, 3*k+1), Vec_IntEntry(vChunks, 3*k+2) );
+        return;
+    }
+    // subtract manager thread
+    nProcs = Abc_MinInt( nProcs - 1, nChunks );
+    assert( nProcs >= 1 && nProcs <= PAR_THR_MAX );
+    // start threads
+    for ( i = 0; i < nProcs; i++ )
+    {
+        ThData[i].pFileName = pFileName;
+        ThData[i].pBuffer   = pBuffer;
+        ThData[i].vChunks   = vChunks;
+        ThData[i].ppChunks  = ppChunks;
+        ThData[i].Index     = -1;
+        ThData[i].fWorking  = 0;
+        status = pthread_create( WorkerThread + i, NULL, Prs_ManWorkerThread, (void *)(ThData + i) );  assert( status == 0 );
+    }
+    // distribute the chunks
+    for ( k = 0; k < nChunks; k++ )
+    {
+        for ( i = 0; i < nProcs; i++ )
+        {
+            if ( ThData[i].fWorking )
+                continue;
+            ThData[i].Index = k;
+            ThData[i].fWorking = 1;
+            break;
+        }
+        if ( i == nProcs )
+            k--;
+    }
+    // wait till threads finish
+    for ( i = 0; i < nProcs; i++ )
+        if ( ThData[i].fWorking )
+            i = -1;
+    // stop threads
+    for ( i = 0; i < nProcs; i++ )
+    {
+        assert( !ThData[i].fWorking );
+        ThData[i].Index = -1;
+        ThData[i].fWorking = 1;
+    }
+    for ( i = 0; i < nProcs; i++ )
+        pthread_join( WorkerThread[i], NULL );
+}
+
+#endif // pthreads are used
+
+/**Function*************************************************************
+
+  Synopsis    [Parses the Verilog file using several threads.]
+
+  Description [The file is divided into chunks of complete modules, which
+  are parsed concurrently into independent managers. The results are merged
+  into one manager deterministically, in the order of the chunks in the file.]
+               
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+Vec_Ptr_t * Prs_ManReadVerilogPar( char * pFileName, int nProcs, int fVerbose )
+{
+    abctime clk = Abc_Clock();
+    Vec_Ptr_t * vPrs = NULL;
+    Vec_Int_t * vChunks;
+    Prs_Man_t ** ppChunks, * p, * pError = NULL;
+    char * pBuffer, * pLimit;
+    int i, nChunks;
+    if ( nProcs < 2 )
+        return Prs_ManReadVerilog( pFileName );
+    pBuffer = Prs_ManLoadFile( pFileName, &pLimit );
+    if ( pBuffer == NULL )
+        return NULL;
+    // have several chunks per thread to balance the load
+    vChunks  = Prs_ManSplitModules( pBuffer, pLimit, (int)((pLimit - pBuffer) / (4 * nProcs)) + 1 );
+    nChunks  = Vec_IntSize(vChunks) / 3;
+    ppChunks = ABC_CALLOC( Prs_Man_t *, nChunks );
+    Prs_ManReadChunks( pFileName, pBuffer, vChunks, ppChunks, nProcs );
+    if ( fVerbose )
+    {
+        printf( "Parsed %d chunks using %d threads.  ", nChunks, nProcs );
+        Abc_PrintTime( 1, "Time", Abc_Clock() - clk );
+    }
+    // merge the results
+    p = Prs_ManAlloc( NULL );
+    p->pName = pFileName;
+    Abc_NamStrFindOrAdd( p->pFuns, "1\'b0", NULL );
+    Abc_NamStrFindOrAdd( p->pFuns, "1\'b1", NULL );
+    Abc_NamStrFindOrAdd( p->pFuns, "1\'bx", NULL );
+    Abc_NamStrFindOrAdd( p->pFuns, "1\'bz", NULL );
+    Prs_NtkAddVerilogDirectives( p );
+    for ( i = 0; i < nChunks; i++ )
+    {
+        // the chunk with the first error is merged and reported like in the sequential parser
+        if ( pError == NULL )
+        {
+            Prs_ManMergeChunk( p, ppChunks[i] );
+            if ( ppChunks[i]->ErrorStr[0] )
+            {
+                pError = ppChunks[i];
+                continue;
+            }
+        }
+        Prs_ManFree( ppChunks[i] );
+    }
+    Prs_ManPrintModules( p );
+    if ( pError == NULL )
+    {
+        ABC_SWAP( Vec_Ptr_t *, vPrs, p->vNtks );
+    }
+    else
+    {
+        Prs_ManErrorPrint( pError );
+        Prs_ManFree( pError );
+    }
+    ABC_FREE( ppChunks );
+    Vec_IntFree( vChunks );
+    ABC_FREE( pBuffer );
+    Prs_ManFree( p );
+    if ( fVerbose )
+        Abc_PrintTime( 1, "Parsing time", Abc_Clock() - clk );
+    return vPrs;
+}
+
 /**Function*************************************************************
 
   Synopsis    []
@@ -2163,9 +2579,13 @@ Cba_Man_t * Prs_ManBuildCbaVerilog( char * pFileName, Vec_Ptr_t * vDes )
 
 ***********************************************************************/
 Cba_Man_t * Cba_ManReadVerilog( char * pFileName )
+{
+    return Cba_ManReadVerilogPar( pFileName, 1, 0 );
+}
+Cba_Man_t * Cba_ManReadVerilogPar( char * pFileName, int nProcs, int fVerbose )
 {
     Cba_Man_t * p = NULL;
-    Vec_Ptr_t * vDes = Prs_ManReadVerilog( pFileName );
+    Vec_Ptr_t * vDes = Prs_ManReadVerilogPar( pFileName, nProcs, fVerbose );
     if ( vDes && Vec_PtrSize(vDes) )
         p = Prs_ManBuildCbaVerilog( pFileName, vDes );
     if ( vDes )
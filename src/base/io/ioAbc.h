@@ -51,6 +51,7 @@ typedef enum {
     IO_FILE_BBLIF,      
     IO_FILE_BLIF,      
     IO_FILE_BLIFMV,      
+    IO_FILE_BNL,      
     IO_FILE_BENCH,      
     IO_FILE_BOOK,
     IO_FILE_CNF,      
@@ -73,6 +74,11 @@ typedef enum {
 
 #define  IO_WRITE_LINE_LENGTH    78    // the output line length
 
+#define  IO_BNL_MAGIC    0x314C4E42    // the BNL magic number ("BNL1")
+#define  IO_BNL_HEAD     12            // the number of integers in the BNL header
+#define  IO_BNL_VAR_MAX  15            // the largest node support written as a truth table
+#define  IO_BNL_NAMES    1             // the BNL header flag: the node names are written
+
 ////////////////////////////////////////////////////////////////////////
 ///                    FUNCTION DECLARATIONS                         ///
 ////////////////////////////////////////////////////////////////////////
@@ -87,6 +93,8 @@ extern Abc_Ntk_t *        Io_ReadBblif( char * pFileName, int fCheck );
 extern Abc_Ntk_t *        Io_ReadBlif( char * pFileName, int fCheck );
 /*=== abcReadBlifMv.c =========================================================*/
 extern Abc_Ntk_t *        Io_ReadBlifMv( char * pFileName, int fBlifMv, int fCheck );
+/*=== abcReadBnl.c ============================================================*/
+extern Abc_Ntk_t *        Io_ReadBnl( char * pFileName, int fCheck );
 /*=== abcReadBench.c ==========================================================*/
 extern Abc_Ntk_t *        Io_ReadBench( char * pFileName, int fCheck );
 extern void               Io_ReadBenchInit( Abc_Ntk_t * pNtk, char * pFileName );
@@ -112,6 +120,8 @@ extern void               Io_WriteTimingInfo( FILE * pFile, Abc_Ntk_t * pNtk );
 extern void               Io_WriteBlifSpecial( Abc_Ntk_t * pNtk, char * FileName, char * pLutStruct, int fUseHie );
 /*=== abcWriteBlifMv.c ==========================================================*/ 
 extern void               Io_WriteBlifMv( Abc_Ntk_t * pNtk, char * FileName );
+/*=== abcWriteBnl.c ===========================================================*/
+extern void               Io_WriteBnl( Abc_Ntk_t * pNtk, char * pFileName );
 /*=== abcWriteBench.c =========================================================*/
 extern int                Io_WriteBench( Abc_Ntk_t * pNtk, const char * FileName );
 extern int                Io_WriteBenchLut( Abc_Ntk_t * pNtk, char * FileName );
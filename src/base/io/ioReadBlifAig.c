@@ -19,6 +19,7 @@
 ***********************************************************************/
 
 #include "base/abc/abc.h"
+#include "aig/gia/gia.h"
 #include "misc/vec/vecPtr.h"
 
 ABC_NAMESPACE_IMPL_START
@@ -98,6 +99,8 @@ static int               Io_BlifParseOutputs( Io_BlifMan_t * p, char * pLine );
 static int               Io_BlifParseLatch( Io_BlifMan_t * p, char * pLine );
 static int               Io_BlifParseNames( Io_BlifMan_t * p, char * pLine );
 static int               Io_BlifParseConstruct( Io_BlifMan_t * p );
+static int               Io_BlifParseLines( Io_BlifMan_t * p );
+static Gia_Man_t *       Io_BlifParseConstructGia( Io_BlifMan_t * p, int fVerbose );
 static int               Io_BlifCharIsSpace( char s ) { return s == ' ' || s == '\t' || s == '\r' || s == '\n';  }
 
 ////////////////////////////////////////////////////////////////////////
@@ -233,13 +236,9 @@ static void Io_BlifFree( Io_BlifMan_t * p )
 ***********************************************************************/
 static unsigned Io_BlifHashString( char * pName, int TableSize ) 
 {
-    static int s_Primes[10] = { 
-        1291, 1699, 2357, 4177, 5147, 
-        5647, 6343, 7103, 7873, 8147
-    };
-    unsigned i, Key = 0;
-    for ( i = 0; pName[i] != '\0'; i++ )
-        Key ^= s_Primes[i%10]*pName[i]*pName[i];
+    unsigned Key = 0;
+    for ( ; *pName; pName++ )
+        Key = Key * 16777619 ^ (unsigned char)*pName;
     return Key % TableSize;
 }
 
@@ -546,8 +545,8 @@ static void Io_BlifReadPreparse( Io_BlifMan_t * p )
     p->pObjects = ABC_ALLOC( Io_BlifObj_t, p->nObjects );
     memset( p->pObjects, 0, p->nObjects * sizeof(Io_BlifObj_t) );
 
-    // allocate memory for the hash table
-    p->nTableSize = p->nObjects/2 + 1;
+    // allocate memory for the hash table (one bin per object)
+    p->nTableSize = Abc_PrimeCudd( p->nObjects );
     p->pTable = ABC_ALLOC( Io_BlifObj_t *, p->nTableSize );
     memset( p->pTable, 0, p->nTableSize * sizeof(Io_BlifObj_t *) );
 }
@@ -564,30 +563,42 @@ static void Io_BlifReadPreparse( Io_BlifMan_t * p )
   SeeAlso     []
 
 ***********************************************************************/
-static Abc_Ntk_t * Io_BlifParse( Io_BlifMan_t * p )
+static int Io_BlifParseLines( Io_BlifMan_t * p )
 {
-    Abc_Ntk_t * pAig;
     char * pLine;
     int i;
+    if ( p->pModel == NULL )
+    {
+        sprintf( p->sError, "The file does not have the .model line." );
+        return 0;
+    }
     // parse the model
     if ( !Io_BlifParseModel( p, p->pModel ) )
-        return NULL;
+        return 0;
     // parse the inputs
     Vec_PtrForEachEntry( char *, p->vInputs, pLine, i )
         if ( !Io_BlifParseInputs( p, pLine ) )
-            return NULL;
+            return 0;
     // parse the outputs
     Vec_PtrForEachEntry( char *, p->vOutputs, pLine, i )
         if ( !Io_BlifParseOutputs( p, pLine ) )
-            return NULL;
+            return 0;
     // parse the latches
     Vec_PtrForEachEntry( char *, p->vLatches, pLine, i )
         if ( !Io_BlifParseLatch( p, pLine ) )
-            return NULL;
+            return 0;
     // parse the nodes
     Vec_PtrForEachEntry( char *, p->vNames, pLine, i )
         if ( !Io_BlifParseNames( p, pLine ) )
-            return NULL;
+            return 0;
+    return 1;
+}
+static Abc_Ntk_t * Io_BlifParse( Io_BlifMan_t * p )
+{
+    Abc_Ntk_t * pAig;
+    // parse the lines
+    if ( !Io_BlifParseLines( p ) )
+        return NULL;
     // reconstruct the network from the parsed data
     if ( !Io_BlifParseConstruct( p ) )
         return NULL;
@@ -1010,6 +1021,307 @@ static int Io_BlifParseConstruct( Io_BlifMan_t * p )
     return 1;
 }
 
+/**Function*************************************************************
+
+  Synopsis    [Reads the network from the BLIF file directly into GIA.]
+
+  Description [This reader does not create the logic network with SOPs.
+  The file is loaded into one buffer, which is tokenized in place, and
+  the names are hashed into one table sized by the number of objects.
+  Latches with initial value 1 are converted to have initial value 0.]
+               
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+Gia_Man_t * Io_ReadBlifAsGia( char * pFileName, int fVerbose )
+{
+    Io_BlifMan_t * p;
+    Gia_Man_t * pGia = NULL;
+    abctime clk = Abc_Clock();
+    // start the file reader
+    p = Io_BlifAlloc();
+    p->pFileName = pFileName;
+    p->pBuffer   = Io_BlifLoadFile( pFileName );
+    if ( p->pBuffer == NULL )
+    {
+        Io_BlifFree( p );
+        return NULL;
+    }
+    // prepare the file for parsing
+    Io_BlifReadPreparse( p );
+    if ( fVerbose )
+    {
+        printf( "Lines = %d.  Objects = %d.  ", Vec_PtrSize(p->vLines), p->nObjects );
+        Abc_PrintTime( 1, "Preparsing time", Abc_Clock() - clk );
+    }
+    // construct the AIG
+    if ( Io_BlifParseLines( p ) )
+        pGia = Io_BlifParseConstructGia( p, fVerbose );
+    if ( p->sError[0] )
+        fprintf( stdout, "%s\n", p->sError );
+    Io_BlifFree( p );
+    if ( fVerbose )
+        Abc_PrintTime( 1, "Total reading time", Abc_Clock() - clk );
+    return pGia;
+}
+
+/**Function*************************************************************
+
+  Synopsis    [Constructs the AIG literal for one table.]
+
+  Description [Returns -1 if the table cannot be parsed.]
+  
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+static inline int  Io_BlifObjLit( Io_BlifObj_t * pObj )               { return (int)(ABC_PTRINT_T)pObj->pEquiv - 1;        }
+static inline void Io_BlifObjSetLit( Io_BlifObj_t * pObj, int iLit )  { pObj->pEquiv = (void *)(ABC_PTRINT_T)(iLit + 1);  }
+
+static int Io_BlifParseTableGia( Io_BlifMan_t * p, Gia_Man_t * pGia, char * pTable, Vec_Int_t * vFanins )
+{
+    char * pProduct, * pOutput;
+    int i, k, iRes, iCube, Polarity = -1;
+    p->nTablesRead++;
+    // get the tokens
+    Io_BlifSplitIntoTokens( p->vTokens, pTable, '.' );
+    if ( Vec_PtrSize(p->vTokens) == 0 )
+        return 0;
+    if ( Vec_PtrSize(p->vTokens) == 1 )
+    {
+        pOutput = (char *)Vec_PtrEntry( p->vTokens, 0 );
+        if ( ((pOutput[0] - '0') & 0x8E) || pOutput[1] )
+        {
+            sprintf( p->sError, "Line %d: Constant table has wrong output value (%s).", Io_BlifGetLine(p, pOutput), pOutput );
+            return -1;
+        }
+        return pOutput[0] == '1';
+    }
+    pProduct = (char *)Vec_PtrEntry( p->vTokens, 0 );
+    if ( Vec_PtrSize(p->vTokens) % 2 == 1 )
+    {
+        sprintf( p->sError, "Line %d: Table has odd number of tokens (%d).", Io_BlifGetLine(p, pProduct), Vec_PtrSize(p->vTokens) );
+        return -1;
+    }
+    // parse the table
+    iRes = 0;
+    for ( i = 0; i < Vec_PtrSize(p->vTokens)/2; i++ )
+    {
+        pProduct = (char *)Vec_PtrEntry( p->vTokens, 2*i + 0 );
+        pOutput  = (char *)Vec_PtrEntry( p->vTokens, 2*i + 1 );
+        if ( strlen(pProduct) != (unsigned)Vec_IntSize(vFanins) )
+        {
+            sprintf( p->sError, "Line %d: Cube (%s) has size different from the fanin count (%d).", Io_BlifGetLine(p, pProduct), pProduct, Vec_IntSize(vFanins) );
+            return -1;
+        }
+        if ( ((pOutput[0] - '0') & 0x8E) || pOutput[1] )
+        {
+            sprintf( p->sError, "Line %d: Output value (%s) is incorrect.", Io_BlifGetLine(p, pProduct), pOutput );
+            return -1;
+        }
+        if ( Polarity == -1 )
+            Polarity = pOutput[0] - '0';
+        else if ( Polarity != pOutput[0] - '0' )
+        {
+            sprintf( p->sError, "Line %d: Output value (%s) differs from the value in the first line of the table (%d).", Io_BlifGetLine(p, pProduct), pOutput, Polarity );
+            return -1;
+        }
+        // parse one product
+        iCube = 1;
+        for ( k = 0; pProduct[k]; k++ )
+        {
+            if ( pProduct[k] == '0' )
+                iCube = Gia_ManHashAnd( pGia, iCube, Abc_LitNot(Vec_IntEntry(vFanins, k)) );
+            else if ( pProduct[k] == '1' )
+                iCube = Gia_ManHashAnd( pGia, iCube, Vec_IntEntry(vFanins, k) );
+            else if ( pProduct[k] != '-' )
+            {
+                sprintf( p->sError, "Line %d: Product term (%s) contains character (%c).", Io_BlifGetLine(p, pProduct), pProduct, pProduct[k] );
+                return -1;
+            }
+        }
+        iRes = Gia_ManHashOr( pGia, iRes, iCube );
+    }
+    return Abc_LitNotCond( iRes, Polarity == 0 );
+}
+
+/**Function*************************************************************
+
+  Synopsis    [Constructs the AIG literal of the signal.]
+
+  Description [Uses an explicit stack instead of recursion, to handle
+  deep networks. The nodes are marked with fLoop while their fanins are
+  constructed, so a marked fanin indicates a combinational loop.
+  Returns -1 if the construction failed.]
+  
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+static int Io_BlifParseConstructGia_iter( Io_BlifMan_t * p, Gia_Man_t * pGia, char * pName, Vec_Ptr_t * vStack, Vec_Ptr_t * vNames, Vec_Int_t * vFanins )
+{
+    Io_BlifObj_t * pObjIo, * pFanin, * pRoot;
+    char * pNameFanin;
+    int i, iLit;
+    pRoot = *Io_BlifHashLookup( p, pName );
+    if ( pRoot == NULL )
+    {
+        sprintf( p->sError, "Line %d: Signal (%s) is not defined as a table.", Io_BlifGetLine(p, pName), pName );
+        return -1;
+    }
+    Vec_PtrClear( vStack );
+    Vec_PtrPush( vStack, pRoot );
+    while ( Vec_PtrSize(vStack) > 0 )
+    {
+        pObjIo = (Io_BlifObj_t *)Vec_PtrEntryLast( vStack );
+        if ( pObjIo->pEquiv )
+        {
+            Vec_PtrPop( vStack );
+            continue;
+        }
+        if ( !pObjIo->fDef )
+        {
+            sprintf( p->sError, "Line %d: Signal (%s) is not defined as a table.", Io_BlifGetLine(p, pObjIo->pName), pObjIo->pName );
+            return -1;
+        }
+        Io_BlifCollectTokens( vNames, pObjIo->pName - pObjIo->Offset, pObjIo->pName );
+        if ( !pObjIo->fLoop )
+        {
+            // first visit - schedule the fanins
+            pObjIo->fLoop = 1;
+            Vec_PtrForEachEntry( char *, vNames, pNameFanin, i )
+            {
+                pFanin = *Io_BlifHashLookup( p, pNameFanin );
+                if ( pFanin == NULL )
+                {
+                    sprintf( p->sError, "Line %d: Signal (%s) is not defined as a table.", Io_BlifGetLine(p, pNameFanin), pNameFanin );
+                    return -1;
+                }
+                if ( pFanin->pEquiv )
+                    continue;
+                if ( pFanin->fLoop )
+                {
+                    sprintf( p->sError, "Line %d: Signal (%s) appears twice on a combinational path.", Io_BlifGetLine(p, pNameFanin), pNameFanin );
+                    return -1;
+                }
+                Vec_PtrPush( vStack, pFanin );
+            }
+            continue;
+        }
+        // second visit - the fanins are constructed
+        Vec_IntClear( vFanins );
+        Vec_PtrForEachEntry( char *, vNames, pNameFanin, i )
+            Vec_IntPush( vFanins, Io_BlifObjLit(*Io_BlifHashLookup(p, pNameFanin)) );
+        iLit = Io_BlifParseTableGia( p, pGia, pObjIo->pName + strlen(pObjIo->pName), vFanins );
+        if ( iLit == -1 )
+            return -1;
+        Io_BlifObjSetLit( pObjIo, iLit );
+        pObjIo->fLoop = 0;
+        Vec_PtrPop( vStack );
+    }
+    return Io_BlifObjLit( pRoot );
+}
+
+/**Function*************************************************************
+
+  Synopsis    [Constructs the GIA from the file parsing info.]
+
+  Description []
+  
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+static Gia_Man_t * Io_BlifParseConstructGia( Io_BlifMan_t * p, int fVerbose )
+{
+    Gia_Man_t * pGia, * pTemp;
+    Io_BlifObj_t * pObjIo;
+    Vec_Ptr_t * vStack  = Vec_PtrAlloc( 1000 );
+    Vec_Ptr_t * vNames  = Vec_PtrAlloc( 100 );
+    Vec_Int_t * vFanins = Vec_IntAlloc( 100 );
+    Vec_Int_t * vCos    = Vec_IntAlloc( Vec_PtrSize(p->vPos) + Vec_PtrSize(p->vLis) );
+    int i, iLit, fError = 0, nInitDc = 0, nAndsEst = Io_BlifEstimateAndNum( p );
+    // allocate the empty AIG
+    pGia = Gia_ManStart( 1 + Vec_PtrSize(p->vPis) + 2 * Vec_PtrSize(p->vLos) + Vec_PtrSize(p->vPos) + nAndsEst );
+    pGia->pName = Abc_UtilStrsav( p->pModel );
+    pGia->pSpec = Abc_UtilStrsav( p->pFileName );
+    pGia->vNamesIn  = Vec_PtrAlloc( Vec_PtrSize(p->vPis) + Vec_PtrSize(p->vLos) );
+    pGia->vNamesOut = Vec_PtrAlloc( Vec_PtrSize(p->vPos) + Vec_PtrSize(p->vLis) );
+    Gia_ManHashAlloc( pGia );
+    // create PIs
+    Vec_PtrForEachEntry( Io_BlifObj_t *, p->vPis, pObjIo, i )
+    {
+        Io_BlifObjSetLit( pObjIo, Gia_ManAppendCi(pGia) );
+        Vec_PtrPush( pGia->vNamesIn, Abc_UtilStrsav(pObjIo->pName) );
+    }
+    // create flop outputs
+    Vec_PtrForEachEntry( Io_BlifObj_t *, p->vLos, pObjIo, i )
+    {
+        Io_BlifObjSetLit( pObjIo, Abc_LitNotCond(Gia_ManAppendCi(pGia), pObjIo->Init == IO_BLIF_INIT_ONE) );
+        Vec_PtrPush( pGia->vNamesIn, Abc_UtilStrsav(pObjIo->pName) );
+        nInitDc += (int)(pObjIo->Init == IO_BLIF_INIT_DC);
+    }
+    // construct the logic of POs and flop inputs
+    Vec_PtrForEachEntry( Io_BlifObj_t *, p->vPos, pObjIo, i )
+    {
+        if ( (iLit = Io_BlifParseConstructGia_iter( p, pGia, pObjIo->pName, vStack, vNames, vFanins )) == -1 )
+        {
+            fError = 1;
+            break;
+        }
+        Vec_IntPush( vCos, iLit );
+        Vec_PtrPush( pGia->vNamesOut, Abc_UtilStrsav(pObjIo->pName) );
+    }
+    Vec_PtrForEachEntry( Io_BlifObj_t *, p->vLis, pObjIo, i )
+    {
+        if ( fError )
+            break;
+        if ( (iLit = Io_BlifParseConstructGia_iter( p, pGia, pObjIo->pName, vStack, vNames, vFanins )) == -1 )
+        {
+            fError = 1;
+            break;
+        }
+        Vec_IntPush( vCos, Abc_LitNotCond(iLit, ((Io_BlifObj_t *)Vec_PtrEntry(p->vLos, i))->Init == IO_BLIF_INIT_ONE) );
+        Vec_PtrPush( pGia->vNamesOut, Abc_UtilStrsav(pObjIo->pName) );
+    }
+    Vec_PtrFree( vStack );
+    Vec_PtrFree( vNames );
+    Vec_IntFree( vFanins );
+    if ( fError )
+    {
+        Vec_IntFree( vCos );
+        Gia_ManStop( pGia );
+        return NULL;
+    }
+    // create COs
+    Vec_IntForEachEntry( vCos, iLit, i )
+        Gia_ManAppendCo( pGia, iLit );
+    Vec_IntFree( vCos );
+    Gia_ManHashStop( pGia );
+    Gia_ManSetRegNum( pGia, Vec_PtrSize(p->vLos) );
+    p->nTablesLeft = Vec_PtrSize(p->vNames) - p->nTablesRead; 
+    if ( p->nTablesLeft ) 
+        printf( "The number of dangling tables = %d.\n", p->nTablesLeft );
+    if ( nInitDc )
+        printf( "Warning: %d flops with don't-care initial values are assumed to be initialized to 0.\n", nInitDc );
+    if ( fVerbose )
+        printf( "AND nodes = %d.  Estimate = %d.\n", Gia_ManAndNum(pGia), nAndsEst );
+    // remove dangling nodes left after structural hashing
+    if ( Gia_ManHasDangling(pGia) )
+    {
+        pGia = Gia_ManCleanup( pTemp = pGia );
+        ABC_SWAP( Vec_Ptr_t *, pGia->vNamesIn,  pTemp->vNamesIn );
+        ABC_SWAP( Vec_Ptr_t *, pGia->vNamesOut, pTemp->vNamesOut );
+        Gia_ManStop( pTemp );
+    }
+    return pGia;
+}
+
 ////////////////////////////////////////////////////////////////////////
 ///                       END OF FILE                                ///
 ////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,425 @@
+/**CFile****************************************************************
+
+  FileName    [ioReadBnl.c]
+
+  SystemName  [ABC: Logic synthesis and verification system.]
+
+  PackageName [Command processing package.]
+
+  Synopsis    [Procedures to read mapped networks in the binary format.]
+
+  Author      [ABC contributors]
+
+  Affiliation [UC Berkeley]
+
+  Date        [Ver. 1.0. Started - October 18, 2026.]
+
+  Revision    [$Id: ioReadBnl.c,v 1.00 2026/10/18 00:00:00 agent Exp $]
+
+***********************************************************************/
+
+#include "ioAbc.h"
+#include "base/main/main.h"
+#include "map/mio/mio.h"
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
+
+ABC_NAMESPACE_IMPL_START
+
+
+////////////////////////////////////////////////////////////////////////
+///                        DECLARATIONS                              ///
+////////////////////////////////////////////////////////////////////////
+
+#ifdef _WIN32
+#define Io_BnlFseek _fseeki64
+#define Io_BnlFtell _ftelli64
+#else
+#define Io_BnlFseek fseeko
+#define Io_BnlFtell ftello
+#endif
+
+// the largest chunk read from the file by one call to fread()
+#define IO_BNL_CHUNK (1 << 28)
+
+// the names of the counts in the header
+static char * s_BnlCounts[IO_BNL_HEAD] = {
+    "magic", "type", "primary inputs", "primary outputs", "latches", "nodes", "cells",
+    "fanins", "truth table words", "timing floats", "string pool bytes", "flags" };
+
+// the number of bytes in the body for each unit of the count in the header
+static int s_BnlBytes[IO_BNL_HEAD] = {
+    0, 0, 0, sizeof(int), 2 * sizeof(int), 2 * sizeof(int), 0,
+    sizeof(int), sizeof(word), sizeof(float), 1, 0 };
+
+////////////////////////////////////////////////////////////////////////
+///                     FUNCTION DEFINITIONS                         ///
+////////////////////////////////////////////////////////////////////////
+
+/**Function*************************************************************
+
+  Synopsis    [Loads the file into memory.]
+
+  Description [Maps the file into memory when possible; otherwise, reads
+  it into the allocated buffer in chunks. Sets *pfMapped accordingly.
+  The file size is 64-bit, so that files over 2 GB can be read.]
+
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+static char * Io_ReadBnlLoad( char * pFileName, size_t * pnFileSize, int * pfMapped )
+{
+    FILE * pFile;
+    char * pContents;
+    ABC_INT64_T nFileSize;
+    size_t nRead, nChunk;
+    *pfMapped = 0;
+#ifndef _WIN32
+    {
+        struct stat Stat;
+        int fd = open( pFileName, O_RDONLY );
+        if ( fd >= 0 && fstat( fd, &Stat ) == 0 && Stat.st_size > 0 )
+        {
+            pContents = (char *)mmap( NULL, (size_t)Stat.st_size, PROT_READ, MAP_PRIVATE, fd, 0 );
+            close( fd );
+            if ( pContents != (char *)MAP_FAILED )
+            {
+                *pnFileSize = (size_t)Stat.st_size;
+                *pfMapped = 1;
+                return pContents;
+            }
+        }
+        else if ( fd >= 0 )
+            close( fd );
+    }
+#endif
+    pFile = fopen( pFileName, "rb" );
+    if ( pFile == NULL )
+        return NULL;
+    Io_BnlFseek( pFile, 0, SEEK_END );
+    nFileSize = (ABC_INT64_T)Io_BnlFtell( pFile );
+    Io_BnlFseek( pFile, 0, SEEK_SET );
+    if ( nFileSize <= 0 || (ABC_UINT64_T)nFileSize > (ABC_UINT64_T)(~(size_t)0) )
+    {
+        fclose( pFile );
+        return NULL;
+    }
+    pContents = ABC_ALLOC( char, (size_t)nFileSize );
+    if ( pContents == NULL )
+    {
+        fclose( pFile );
+        return NULL;
+    }
+    for ( nRead = 0; nRead < (size_t)nFileSize; nRead += nChunk )
+    {
+        nChunk = Abc_MinWord( IO_BNL_CHUNK, (size_t)nFileSize - nRead );
+        if ( fread( pContents + nRead, 1, nChunk, pFile ) != nChunk )
+        {
+            ABC_FREE( pContents );
+            fclose( pFile );
+            return NULL;
+        }
+    }
+    fclose( pFile );
+    *pnFileSize = (size_t)nFileSize;
+    return pContents;
+}
+
+/**Function*************************************************************
+
+  Synopsis    [Releases the file contents.]
+
+  Description []
+
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+static void Io_ReadBnlUnload( char * pContents, size_t nFileSize, int fMapped )
+{
+#ifndef _WIN32
+    if ( fMapped )
+    {
+        munmap( pContents, nFileSize );
+        return;
+    }
+#endif
+    ABC_FREE( pContents );
+}
+
+/**Function*************************************************************
+
+  Synopsis    [Reads the mapped network in the binary format.]
+
+  Description [Standard cells are looked up by name in the current
+  library. Truth tables are converted into SOPs.]
+
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+Abc_Ntk_t * Io_ReadBnl( char * pFileName, int fCheck )
+{
+    Abc_Ntk_t * pNtkNew;
+    Abc_Obj_t * pObj, * pNode0, * pNode1;
+    Mio_Library_t * pLib = NULL;
+    Mio_Gate_t * pGate;
+    Vec_Ptr_t * vObjs, * vCells = NULL;
+    Vec_Int_t * vCover = NULL;
+    char * pContents, * pCur, * pNtkName, * pName, * pOutName;
+    int * pHead, * pFanNums, * pFuncs, * pFanins, * pCos, * pInits;
+    word * pTruths, pTruth[1 << (IO_BNL_VAR_MAX - 6)];
+    float * pTimes;
+    ABC_INT64_T nRest, nSize, nStrs;
+    size_t nFileSize;
+    int fMapped, nCis, i, k, iFanin = 0, fError = 0;
+
+    // load the file
+    pContents = Io_ReadBnlLoad( pFileName, &nFileSize, &fMapped );
+    if ( pContents == NULL )
+    {
+        printf( "Io_ReadBnl(): Cannot open the input file \"%s\".\n", pFileName );
+        return NULL;
+    }
+
+    // skip the comments (comment lines begin with '#' and end with '\n')
+    for ( pCur = pContents; pCur < pContents + nFileSize && *pCur == '#'; )
+        while ( pCur < pContents + nFileSize && *pCur++ != '\n' );
+    // skip the padding
+    while ( (pCur - pContents) % 8 && pCur < pContents + nFileSize && *pCur == 0 )
+        pCur++;
+
+    // check the header
+    pHead = (int *)pCur;
+    if ( (pCur - pContents) % 8 || pContents + nFileSize < pCur + sizeof(int) * IO_BNL_HEAD || pHead[0] != IO_BNL_MAGIC )
+    {
+        printf( "Io_ReadBnl(): The file \"%s\" is not in the BNL format or has a different byte order.\n", pFileName );
+        Io_ReadBnlUnload( pContents, nFileSize, fMapped );
+        return NULL;
+    }
+    if ( pHead[1] != 0 && pHead[1] != 1 )
+    {
+        printf( "Io_ReadBnl(): The file \"%s\" has unknown function type %d.\n", pFileName, pHead[1] );
+        Io_ReadBnlUnload( pContents, nFileSize, fMapped );
+        return NULL;
+    }
+    if ( pHead[11] & ~IO_BNL_NAMES )
+    {
+        printf( "Io_ReadBnl(): The file \"%s\" has unknown flags %d.\n", pFileName, pHead[11] );
+        Io_ReadBnlUnload( pContents, nFileSize, fMapped );
+        return NULL;
+    }
+    // check each count against the remaining part of the file (in 64 bits to avoid overflow)
+    nRest = (ABC_INT64_T)(pContents + nFileSize - pCur) - sizeof(int) * IO_BNL_HEAD;
+    for ( i = 2; i <= 10; i++ )
+    {
+        nSize = (ABC_INT64_T)pHead[i] * s_BnlBytes[i];
+        if ( pHead[i] < 0 || nSize > nRest )
+        {
+            printf( "Io_ReadBnl(): The number of %s (%d) in the header of file \"%s\" is negative or exceeds the file size.\n", s_BnlCounts[i], pHead[i], pFileName );
+            Io_ReadBnlUnload( pContents, nFileSize, fMapped );
+            return NULL;
+        }
+        nRest -= nSize;
+    }
+    if ( nRest != 0 || (pHead[9] && (ABC_INT64_T)pHead[9] != 5 + 2 * (ABC_INT64_T)pHead[2] + 2 * (ABC_INT64_T)pHead[3]) )
+    {
+        printf( "Io_ReadBnl(): The file \"%s\" is corrupted (%.0f extra bytes).\n", pFileName, (double)nRest );
+        Io_ReadBnlUnload( pContents, nFileSize, fMapped );
+        return NULL;
+    }
+
+    // get the sections
+    pTruths  = (word *)(pHead + IO_BNL_HEAD);
+    pFanNums = (int *)(pTruths + pHead[8]);
+    pFuncs   = pFanNums + pHead[5];
+    pFanins  = pFuncs + pHead[5];
+    pCos     = pFanins + pHead[7];
+    pInits   = pCos + pHead[3] + pHead[4];
+    pTimes   = (float *)(pInits + pHead[4]);
+    pCur     = (char *)(pTimes + pHead[9]);
+    nStrs = 2 + 2 * (ABC_INT64_T)pHead[6] + pHead[2] + pHead[3] + 3 * (ABC_INT64_T)pHead[4];
+    if ( pHead[11] & IO_BNL_NAMES )
+        nStrs += pHead[5];
+    for ( nSize = i = 0; i < pHead[10]; i++ )
+        nSize += (pCur[i] == 0);
+    if ( pHead[10] == 0 || pCur[pHead[10]-1] != 0 || nSize != nStrs )
+    {
+        printf( "Io_ReadBnl(): The string pool of file \"%s\" is corrupted.\n", pFileName );
+        Io_ReadBnlUnload( pContents, nFileSize, fMapped );
+        return NULL;
+    }
+
+    // read the name
+    pNtkName = pCur;  while ( *pCur++ );
+
+    // find the cells
+    if ( pHead[1] == 0 )
+    {
+        pLib = (Mio_Library_t *)Abc_FrameReadLibGen();
+        if ( pLib == NULL )
+        {
+            printf( "Io_ReadBnl(): The network is mapped but the library is not available.\n" );
+            Io_ReadBnlUnload( pContents, nFileSize, fMapped );
+            return NULL;
+        }
+        if ( strcmp( Mio_LibraryReadName(pLib), pCur ) )
+            printf( "Warning: The network was mapped using library \"%s\" while the current library is \"%s\".\n", pCur, Mio_LibraryReadName(pLib) );
+        while ( *pCur++ );
+        vCells = Vec_PtrAlloc( pHead[6] );
+        for ( i = 0; i < pHead[6]; i++ )
+        {
+            pName = pCur;     while ( *pCur++ );
+            pOutName = pCur;  while ( *pCur++ );
+            pGate = Mio_LibraryReadGateByName( pLib, pName, pOutName );
+            if ( pGate == NULL )
+            {
+                printf( "Io_ReadBnl(): Cannot find gate \"%s\" with output \"%s\" in the current library.\n", pName, pOutName );
+                Vec_PtrFree( vCells );
+                Io_ReadBnlUnload( pContents, nFileSize, fMapped );
+                return NULL;
+            }
+            Vec_PtrPush( vCells, pGate );
+        }
+    }
+    else
+        while ( *pCur++ );
+
+    // allocate the empty network
+    pNtkNew = Abc_NtkAlloc( ABC_NTK_LOGIC, pLib ? ABC_FUNC_MAP : ABC_FUNC_SOP, 1 );
+    pNtkNew->pName = Extra_UtilStrsav( pNtkName );
+    pNtkNew->pSpec = Extra_UtilStrsav( pFileName );
+
+    // create the PIs, POs, and latches
+    nCis = pHead[2] + pHead[4];
+    vObjs = Vec_PtrAlloc( nCis + pHead[5] );
+    for ( i = 0; i < pHead[2]; i++ )
+    {
+        pObj = Abc_NtkCreatePi(pNtkNew);
+        Abc_ObjAssignName( pObj, pCur, NULL );  while ( *pCur++ );
+        Vec_PtrPush( vObjs, pObj );
+    }
+    for ( i = 0; i < pHead[3]; i++ )
+    {
+        pObj = Abc_NtkCreatePo(pNtkNew);
+        Abc_ObjAssignName( pObj, pCur, NULL );  while ( *pCur++ );
+    }
+    for ( i = 0; i < pHead[4]; i++ )
+    {
+        pObj = Abc_NtkCreateLatch(pNtkNew);
+        Abc_ObjAssignName( pObj, pCur, NULL );  while ( *pCur++ );
+
+        pNode0 = Abc_NtkCreateBi(pNtkNew);
+        Abc_ObjAssignName( pNode0, pCur, NULL );  while ( *pCur++ );
+
+        pNode1 = Abc_NtkCreateBo(pNtkNew);
+        Abc_ObjAssignName( pNode1, pCur, NULL );  while ( *pCur++ );
+        Vec_PtrPush( vObjs, pNode1 );
+
+        Abc_ObjAddFanin( pObj, pNode0 );
+        Abc_ObjAddFanin( pNode1, pObj );
+        Abc_ObjSetData( pObj, (void *)(ABC_PTRINT_T)pInits[i] );
+    }
+
+    // create the nodes
+    for ( i = 0; i < pHead[5]; i++ )
+    {
+        pObj = Abc_NtkCreateNode(pNtkNew);
+        if ( (pHead[11] & IO_BNL_NAMES) && *pCur )
+            Abc_ObjAssignName( pObj, pCur, NULL );
+        if ( pHead[11] & IO_BNL_NAMES )
+            while ( *pCur++ );
+        Vec_PtrPush( vObjs, pObj );
+    }
+    if ( pLib == NULL )
+        vCover = Vec_IntAlloc( 1 << 10 );
+    for ( i = 0; !fError && i < pHead[5]; i++ )
+    {
+        pObj = (Abc_Obj_t *)Vec_PtrEntry( vObjs, nCis + i );
+        fError = pFanNums[i] < 0 || (ABC_INT64_T)iFanin + pFanNums[i] > pHead[7];
+        for ( k = 0; !fError && k < pFanNums[i]; k++, iFanin++ )
+            if ( !(fError = (pFanins[iFanin] < 0 || pFanins[iFanin] >= Vec_PtrSize(vObjs))) )
+                Abc_ObjAddFanin( pObj, (Abc_Obj_t *)Vec_PtrEntry(vObjs, pFanins[iFanin]) );
+        if ( fError )
+            break;
+        if ( pLib )
+        {
+            fError = pFuncs[i] < 0 || pFuncs[i] >= pHead[6] || Mio_GateReadPinNum((Mio_Gate_t *)Vec_PtrEntry(vCells, pFuncs[i])) != pFanNums[i];
+            if ( !fError )
+                pObj->pData = Vec_PtrEntry( vCells, pFuncs[i] );
+        }
+        else
+        {
+            fError = pFanNums[i] > IO_BNL_VAR_MAX || pFuncs[i] < 0 || (ABC_INT64_T)pFuncs[i] + Abc_Truth6WordNum(pFanNums[i]) > pHead[8];
+            if ( fError )
+                break;
+            // the ISOP computation modifies the truth table, which may be mapped read-only
+            memcpy( pTruth, pTruths + pFuncs[i], sizeof(word) * Abc_Truth6WordNum(pFanNums[i]) );
+            pObj->pData = Abc_SopCreateFromTruthIsop( (Mem_Flex_t *)pNtkNew->pManFunc, pFanNums[i], pTruth, vCover );
+        }
+    }
+    if ( vCover )
+        Vec_IntFree( vCover );
+    if ( vCells )
+        Vec_PtrFree( vCells );
+
+    // connect the COs
+    for ( i = 0; !fError && i < pHead[3] + pHead[4]; i++ )
+    {
+        if ( (fError = (pCos[i] < 0 || pCos[i] >= Vec_PtrSize(vObjs))) )
+            break;
+        pObj = i < pHead[3] ? Abc_NtkPo(pNtkNew, i) : Abc_ObjFanin0(Abc_NtkBox(pNtkNew, i - pHead[3]));
+        Abc_ObjAddFanin( pObj, (Abc_Obj_t *)Vec_PtrEntry(vObjs, pCos[i]) );
+    }
+    if ( fError )
+    {
+        printf( "Io_ReadBnl(): The body of file \"%s\" is corrupted.\n", pFileName );
+        Vec_PtrFree( vObjs );
+        Abc_NtkDelete( pNtkNew );
+        Io_ReadBnlUnload( pContents, nFileSize, fMapped );
+        return NULL;
+    }
+    Vec_PtrFree( vObjs );
+
+    // set the timing information
+    if ( pHead[9] )
+    {
+        pNtkNew->AndGateDelay = pTimes[0];
+        Abc_NtkTimeSetDefaultArrival( pNtkNew, pTimes[1], pTimes[2] );
+        Abc_NtkTimeSetDefaultRequired( pNtkNew, pTimes[3], pTimes[4] );
+        pTimes += 5;
+        Abc_NtkForEachPi( pNtkNew, pObj, i )
+            Abc_NtkTimeSetArrival( pNtkNew, Abc_ObjId(pObj), pTimes[2*i], pTimes[2*i+1] );
+        pTimes += 2 * Abc_NtkPiNum(pNtkNew);
+        Abc_NtkForEachPo( pNtkNew, pObj, i )
+            Abc_NtkTimeSetRequired( pNtkNew, Abc_ObjId(pObj), pTimes[2*i], pTimes[2*i+1] );
+    }
+    Io_ReadBnlUnload( pContents, nFileSize, fMapped );
+
+    // check the result
+    if ( fCheck && !Abc_NtkCheckRead( pNtkNew ) )
+    {
+        printf( "Io_ReadBnl: The network check has failed.\n" );
+        Abc_NtkDelete( pNtkNew );
+        return NULL;
+    }
+    return pNtkNew;
+}
+
+
+////////////////////////////////////////////////////////////////////////
+///                       END OF FILE                                ///
+////////////////////////////////////////////////////////////////////////
+
+
+ABC_NAMESPACE_IMPL_END
+
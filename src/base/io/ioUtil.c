@@ -59,6 +59,8 @@ Io_FileType_t Io_ReadFileType( char * pFileName )
         return IO_FILE_BBLIF;
     if ( !strcmp( pExt, "blif" ) )
         return IO_FILE_BLIF;
+    if ( !strcmp( pExt, "bnl" ) )
+        return IO_FILE_BNL;
     if ( !strcmp( pExt, "bench" ) )
         return IO_FILE_BENCH;
     if ( !strcmp( pExt, "cnf" ) )
@@ -131,6 +133,14 @@ Abc_Ntk_t * Io_ReadNetlist( char * pFileName, Io_FileType_t FileType, int fCheck
         }
         return pNtk;
     }
+    // read the mapped network
+    if ( FileType == IO_FILE_BNL )
+    {
+        pNtk = Io_ReadBnl( pFileName, fCheck );
+        if ( pNtk == NULL )
+            fprintf( stdout, "Reading network from file has failed.\n" );
+        return pNtk;
+    }
     // read the new netlist
     if ( FileType == IO_FILE_BLIF )
 //        pNtk = Io_ReadBlif( pFileName, fCheck );
@@ -373,6 +383,31 @@ void Io_Write( Abc_Ntk_t * pNtk, char * pFileName, Io_FileType_t FileType )
         Io_WriteBblif( pNtk, pFileName );
         return;
     }
+    if ( FileType == IO_FILE_BNL )
+    {
+        if ( !Abc_NtkIsLogic(pNtk) )
+        {
+            fprintf( stdout, "Writing Binary Netlist is only possible for logic networks.\n" );
+            return;
+        }
+        if ( !Abc_NtkHasSop(pNtk) && !Abc_NtkHasMapping(pNtk) )
+        {
+            // convert a copy to keep the user's network unchanged
+            Abc_Obj_t * pObj; char * pName; int i;
+            pNtkCopy = Abc_NtkDup( pNtk );
+            Abc_NtkForEachNode( pNtk, pObj, i )
+                if ( (pName = Nm_ManFindNameById(pNtk->pManName, pObj->Id)) )
+                    Abc_ObjAssignName( pObj->pCopy, pName, NULL );
+            if ( Abc_NtkToSop( pNtkCopy, -1, ABC_INFINITY ) )
+                Io_WriteBnl( pNtkCopy, pFileName );
+            else
+                fprintf( stdout, "Converting the network into SOPs has failed.\n" );
+            Abc_NtkDelete( pNtkCopy );
+        }
+        else
+            Io_WriteBnl( pNtk, pFileName );
+        return;
+    }
 /*
     if ( FileType == IO_FILE_BLIFMV )
     {
@@ -0,0 +1,352 @@
+/**CFile****************************************************************
+
+  FileName    [ioWriteBnl.c]
+
+  SystemName  [ABC: Logic synthesis and verification system.]
+
+  PackageName [Command processing package.]
+
+  Synopsis    [Procedures to write mapped networks in the binary format.]
+
+  Author      [ABC contributors]
+
+  Affiliation [UC Berkeley]
+
+  Date        [Ver. 1.0. Started - October 18, 2026.]
+
+  Revision    [$Id: ioWriteBnl.c,v 1.00 2026/10/18 00:00:00 agent Exp $]
+
+***********************************************************************/
+
+#include "ioAbc.h"
+#include "map/mio/mio.h"
+#include "misc/util/utilTruth.h"
+
+ABC_NAMESPACE_IMPL_START
+
+
+////////////////////////////////////////////////////////////////////////
+///                        DECLARATIONS                              ///
+////////////////////////////////////////////////////////////////////////
+
+/*
+    Binary Netlist Format (BNL)
+
+    The motivation for this format is to have
+    - compact binary representation of mapped logic networks
+      (standard-cell networks and LUT networks with truth tables)
+    - fast reading/writing, suitable for handing the network over
+      between the stages of a flow without re-parsing BLIF or Verilog
+    - the sections laid out so that the file can be memory-mapped and
+      used in place (all arrays are naturally aligned)
+
+    The header:
+    (1) May contain several lines of human-readable comments.
+        Each comment line begins with symbol '#' and ends with symbol '\n'.
+        The comments are followed by 0-bytes up to the offset divisible by 8.
+    (2) Always contains IO_BNL_HEAD 4-byte integers:
+        - magic number (also used to detect the wrong byte order)
+        - function type (0 = standard cells, 1 = truth tables)
+        - number of primary inputs
+        - number of primary outputs
+        - number of latches
+        - number of internal nodes (including constant nodes)
+        - number of different cells used by the nodes
+        - total number of node fanins
+        - number of 64-bit words in the truth table section
+        - number of floats in the timing section
+        - number of bytes in the string pool
+        - flags (bit 0 = the string pool contains the node names)
+
+    The body (in this order):
+    (1) Truth tables of the nodes (64-bit words). Each node with K fanins
+        takes Abc_Truth6WordNum(K) words. Empty for standard cells.
+    (2) Fanin counts of the nodes (4-byte integers).
+    (3) Functions of the nodes (4-byte integers): the index of the cell in
+        the cell list or the offset of the truth table in section (1).
+    (4) Fanins of the nodes (4-byte integers) in the order of nodes.
+        The objects are numbered as follows: PIs, latch outputs, nodes.
+    (5) Drivers of the POs followed by the drivers of the latch inputs.
+    (6) Initial values of the latches (ABC_INIT_ZERO/ONE/DC).
+    (7) Timing (floats), if present: AND-gate delay, default input arrival
+        (rise, fall), default output required (rise, fall), arrival times
+        of the PIs (rise, fall), required times of the POs (rise, fall).
+    (8) String pool. Each string is followed by 0-byte (character '\0').
+        - network name
+        - library name (empty for truth tables)
+        - cell names and cell output pin names
+        - names of the PIs, POs, and latches (latch, input, output)
+        - names of the nodes, if flag bit 0 is set (empty string if
+          the node has no name)
+
+    All counts are non-negative and the file size is exactly the size
+    of the header plus the sizes of the sections derived from the counts.
+*/
+
+////////////////////////////////////////////////////////////////////////
+///                     FUNCTION DEFINITIONS                         ///
+////////////////////////////////////////////////////////////////////////
+
+/**Function*************************************************************
+
+  Synopsis    [Adds the string to the string pool.]
+
+  Description []
+
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+static inline void Io_WriteBnlStr( Vec_Str_t * vStrs, char * pStr )
+{
+    Vec_StrPrintStr( vStrs, pStr ? pStr : "" );
+    Vec_StrPush( vStrs, '\0' );
+}
+
+/**Function*************************************************************
+
+  Synopsis    [Computes the truth table of the SOP node.]
+
+  Description [Elementary truth tables for more than 6 variables are
+  allocated on demand and kept in ppStore.]
+
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+static void Io_WriteBnlTruth( Abc_Obj_t * pNode, word ** ppStore, Vec_Wrd_t * vTruths )
+{
+    int nFanins = Abc_ObjFaninNum(pNode);
+    int i, k, nWords = Abc_Truth6WordNum( nFanins );
+    word * pVars[IO_BNL_VAR_MAX], * pCube, * pRes;
+    if ( nFanins <= 6 )
+    {
+        Vec_WrdPush( vTruths, Abc_SopToTruth( (char *)pNode->pData, nFanins ) );
+        return;
+    }
+    if ( *ppStore == NULL )
+    {
+        // elementary truth tables followed by the cube
+        int nWordsMax = Abc_Truth6WordNum( IO_BNL_VAR_MAX );
+        *ppStore = ABC_ALLOC( word, nWordsMax * (IO_BNL_VAR_MAX + 1) );
+        for ( i = 0; i < IO_BNL_VAR_MAX; i++ )
+            for ( k = 0; k < nWordsMax; k++ )
+                (*ppStore)[i * nWordsMax + k] = i < 6 ? s_Truths6[i] : (((k >> (i-6)) & 1) ? ~(word)0 : 0);
+    }
+    for ( i = 0; i < IO_BNL_VAR_MAX; i++ )
+        pVars[i] = *ppStore + i * Abc_Truth6WordNum( IO_BNL_VAR_MAX );
+    pCube = *ppStore + IO_BNL_VAR_MAX * Abc_Truth6WordNum( IO_BNL_VAR_MAX );
+    for ( k = 0; k < nWords; k++ )
+        Vec_WrdPush( vTruths, 0 );
+    pRes = Vec_WrdEntryP( vTruths, Vec_WrdSize(vTruths) - nWords );
+    Abc_SopToTruthBig( (char *)pNode->pData, nFanins, pVars, pCube, pRes );
+}
+
+/**Function*************************************************************
+
+  Synopsis    [Writes the mapped network in the binary format.]
+
+  Description [The network should be a logic network with standard cells
+  or with SOPs (the latter are written as truth tables).]
+
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+void Io_WriteBnl( Abc_Ntk_t * pNtk, char * pFileName )
+{
+    FILE * pFile;
+    Abc_Obj_t * pObj, * pFanin;
+    Abc_Time_t * pTime;
+    Mio_Library_t * pLib = NULL;
+    Mio_Gate_t * pGate;
+    Vec_Int_t * vFanNums, * vFuncs, * vFanins, * vCos, * vInits, * vCellIds = NULL;
+    Vec_Ptr_t * vCells;
+    Vec_Wrd_t * vTruths;
+    Vec_Flt_t * vTimes;
+    Vec_Str_t * vStrs;
+    word * pStore = NULL;
+    int pHead[IO_BNL_HEAD] = {0};
+    int i, k, nObjs = 0;
+    assert( Abc_NtkIsLogic(pNtk) );
+    assert( Abc_NtkHasMapping(pNtk) || Abc_NtkHasSop(pNtk) );
+    if ( Abc_NtkBlackboxNum(pNtk) > 0 || Abc_NtkWhiteboxNum(pNtk) > 0 )
+    {
+        fprintf( stdout, "Io_WriteBnl(): Networks with black/white boxes are not supported.\n" );
+        return;
+    }
+    if ( Abc_NtkHasSop(pNtk) )
+    {
+        Abc_NtkForEachNode( pNtk, pObj, i )
+            if ( Abc_ObjFaninNum(pObj) > IO_BNL_VAR_MAX )
+            {
+                fprintf( stdout, "Io_WriteBnl(): Node \"%s\" has more than %d fanins.\n", Abc_ObjName(pObj), IO_BNL_VAR_MAX );
+                return;
+            }
+    }
+    else
+    {
+        pLib = (Mio_Library_t *)pNtk->pManFunc;
+        // maps the gate (by its index in the library) into the cell index in the file
+        vCellIds = Vec_IntStartFull( Mio_LibraryReadGateNum(pLib) );
+    }
+    // start the output stream
+    pFile = fopen( pFileName, "wb" );
+    if ( pFile == NULL )
+    {
+        fprintf( stdout, "Io_WriteBnl(): Cannot open the output file \"%s\".\n", pFileName );
+        Vec_IntFreeP( &vCellIds );
+        return;
+    }
+
+    // number the objects: PIs, latch outputs, nodes
+    Abc_NtkForEachPi( pNtk, pObj, i )
+        pObj->iTemp = nObjs++;
+    Abc_NtkForEachLatch( pNtk, pObj, i )
+        Abc_ObjFanout0(pObj)->iTemp = nObjs++;
+    Abc_NtkForEachNode( pNtk, pObj, i )
+        pObj->iTemp = nObjs++;
+
+    // collect the nodes
+    vFanNums = Vec_IntAlloc( Abc_NtkNodeNum(pNtk) );
+    vFuncs   = Vec_IntAlloc( Abc_NtkNodeNum(pNtk) );
+    vFanins  = Vec_IntAlloc( Abc_NtkGetTotalFanins(pNtk) );
+    vTruths  = Vec_WrdAlloc( pLib ? 0 : Abc_NtkNodeNum(pNtk) );
+    vCells   = Vec_PtrAlloc( 100 );
+    Abc_NtkForEachNode( pNtk, pObj, i )
+    {
+        Vec_IntPush( vFanNums, Abc_ObjFaninNum(pObj) );
+        if ( pLib )
+        {
+            pGate = (Mio_Gate_t *)pObj->pData;
+            assert( Mio_GateReadCell(pGate) >= 0 && Mio_GateReadCell(pGate) < Vec_IntSize(vCellIds) );
+            if ( Vec_IntEntry(vCellIds, Mio_GateReadCell(pGate)) == -1 )
+            {
+                Vec_IntWriteEntry( vCellIds, Mio_GateReadCell(pGate), Vec_PtrSize(vCells) );
+                Vec_PtrPush( vCells, pGate );
+            }
+            Vec_IntPush( vFuncs, Vec_IntEntry(vCellIds, Mio_GateReadCell(pGate)) );
+        }
+        else
+        {
+            Vec_IntPush( vFuncs, Vec_WrdSize(vTruths) );
+            Io_WriteBnlTruth( pObj, &pStore, vTruths );
+        }
+        Abc_ObjForEachFanin( pObj, pFanin, k )
+            Vec_IntPush( vFanins, pFanin->iTemp );
+    }
+    ABC_FREE( pStore );
+
+    // collect the COs and the initial values
+    vCos   = Vec_IntAlloc( Abc_NtkCoNum(pNtk) );
+    vInits = Vec_IntAlloc( Abc_NtkLatchNum(pNtk) );
+    Abc_NtkForEachPo( pNtk, pObj, i )
+        Vec_IntPush( vCos, Abc_ObjFanin0(pObj)->iTemp );
+    Abc_NtkForEachLatch( pNtk, pObj, i )
+    {
+        Vec_IntPush( vCos, Abc_ObjFanin0(Abc_ObjFanin0(pObj))->iTemp );
+        Vec_IntPush( vInits, (int)(ABC_PTRINT_T)pObj->pData );
+    }
+
+    // collect the timing information
+    vTimes = Vec_FltAlloc( 0 );
+    if ( pNtk->pManTime )
+    {
+        Vec_FltGrow( vTimes, 5 + 2 * Abc_NtkPiNum(pNtk) + 2 * Abc_NtkPoNum(pNtk) );
+        Vec_FltPush( vTimes, pNtk->AndGateDelay );
+        pTime = Abc_NtkReadDefaultArrival( pNtk );
+        Vec_FltPush( vTimes, pTime->Rise );
+        Vec_FltPush( vTimes, pTime->Fall );
+        pTime = Abc_NtkReadDefaultRequired( pNtk );
+        Vec_FltPush( vTimes, pTime->Rise );
+        Vec_FltPush( vTimes, pTime->Fall );
+        Abc_NtkForEachPi( pNtk, pObj, i )
+        {
+            pTime = Abc_NodeReadArrival( pObj );
+            Vec_FltPush( vTimes, pTime->Rise );
+            Vec_FltPush( vTimes, pTime->Fall );
+        }
+        Abc_NtkForEachPo( pNtk, pObj, i )
+        {
+            pTime = Abc_NodeReadRequired( pObj );
+            Vec_FltPush( vTimes, pTime->Rise );
+            Vec_FltPush( vTimes, pTime->Fall );
+        }
+    }
+
+    // collect the strings
+    vStrs = Vec_StrAlloc( 16 * Abc_NtkObjNumMax(pNtk) );
+    Io_WriteBnlStr( vStrs, pNtk->pName );
+    Io_WriteBnlStr( vStrs, pLib ? Mio_LibraryReadName(pLib) : NULL );
+    Vec_PtrForEachEntry( Mio_Gate_t *, vCells, pGate, i )
+    {
+        Io_WriteBnlStr( vStrs, Mio_GateReadName(pGate) );
+        Io_WriteBnlStr( vStrs, Mio_GateReadOutName(pGate) );
+    }
+    Abc_NtkForEachPi( pNtk, pObj, i )
+        Io_WriteBnlStr( vStrs, Abc_ObjName(pObj) );
+    Abc_NtkForEachPo( pNtk, pObj, i )
+        Io_WriteBnlStr( vStrs, Abc_ObjName(pObj) );
+    Abc_NtkForEachLatch( pNtk, pObj, i )
+    {
+        Io_WriteBnlStr( vStrs, Abc_ObjName(pObj) );
+        Io_WriteBnlStr( vStrs, Abc_ObjName(Abc_ObjFanin0(pObj)) );
+        Io_WriteBnlStr( vStrs, Abc_ObjName(Abc_ObjFanout0(pObj)) );
+    }
+    Abc_NtkForEachNode( pNtk, pObj, i )
+        Io_WriteBnlStr( vStrs, Nm_ManFindNameById(pNtk->pManName, pObj->Id) );
+
+    // write the comment and align the binary part
+    fprintf( pFile, "# BNL (Binary Netlist) for \"%s\" written by ABC on %s\n", pNtk->pName, Extra_TimeStamp() );
+    while ( ftell(pFile) % 8 )
+        fputc( 0, pFile );
+
+    // write the header
+    pHead[0]  = IO_BNL_MAGIC;
+    pHead[1]  = pLib == NULL;
+    pHead[2]  = Abc_NtkPiNum(pNtk);
+    pHead[3]  = Abc_NtkPoNum(pNtk);
+    pHead[4]  = Abc_NtkLatchNum(pNtk);
+    pHead[5]  = Vec_IntSize(vFanNums);
+    pHead[6]  = Vec_PtrSize(vCells);
+    pHead[7]  = Vec_IntSize(vFanins);
+    pHead[8]  = Vec_WrdSize(vTruths);
+    pHead[9]  = Vec_FltSize(vTimes);
+    pHead[10] = Vec_StrSize(vStrs);
+    pHead[11] = IO_BNL_NAMES;
+    fwrite( pHead, sizeof(int), IO_BNL_HEAD, pFile );
+
+    // write the body
+    fwrite( Vec_WrdArray(vTruths), sizeof(word), Vec_WrdSize(vTruths), pFile );
+    fwrite( Vec_IntArray(vFanNums), sizeof(int), Vec_IntSize(vFanNums), pFile );
+    fwrite( Vec_IntArray(vFuncs), sizeof(int), Vec_IntSize(vFuncs), pFile );
+    fwrite( Vec_IntArray(vFanins), sizeof(int), Vec_IntSize(vFanins), pFile );
+    fwrite( Vec_IntArray(vCos), sizeof(int), Vec_IntSize(vCos), pFile );
+    fwrite( Vec_IntArray(vInits), sizeof(int), Vec_IntSize(vInits), pFile );
+    fwrite( Vec_FltArray(vTimes), sizeof(float), Vec_FltSize(vTimes), pFile );
+    fwrite( Vec_StrArray(vStrs), 1, Vec_StrSize(vStrs), pFile );
+    fclose( pFile );
+
+    Vec_IntFree( vFanNums );
+    Vec_IntFree( vFuncs );
+    Vec_IntFree( vFanins );
+    Vec_IntFree( vCos );
+    Vec_IntFree( vInits );
+    Vec_IntFreeP( &vCellIds );
+    Vec_PtrFree( vCells );
+    Vec_WrdFree( vTruths );
+    Vec_FltFree( vTimes );
+    Vec_StrFree( vStrs );
+}
+
+
+////////////////////////////////////////////////////////////////////////
+///                       END OF FILE                                ///
+////////////////////////////////////////////////////////////////////////
+
+
+ABC_NAMESPACE_IMPL_END
+
@@ -145,7 +145,7 @@ Abc_Cex_t * Llb_CoreDeriveCex( Llb_Img_t * p )
             continue;
         // compute the next states
         bImage = Llb_ImgComputeImage( p->pAig, p->vDdMans, p->dd, bState, 
-            vQuant0, vQuant1, p->vDriRefs, p->pPars->TimeTarget, 1, 0, 0 );
+            vQuant0, vQuant1, p->vDriRefs, p->pPars->TimeTarget, 1, 0, 1, 0 );
         assert( bImage != NULL );
         Cudd_Ref( bImage );
         Cudd_RecursiveDeref( p->dd, bState );
@@ -210,7 +210,7 @@ int Llb_CoreReachability_int( Llb_Img_t * p, Vec_Ptr_t * vQuant0, Vec_Ptr_t * vQ
     int * pLoc2GloR = p->pPars->fBackward? Vec_IntArray( p->vNs2Glo ) : Vec_IntArray( p->vCs2Glo );
     int * pGlo2Loc  = p->pPars->fBackward? Vec_IntArray( p->vGlo2Ns ) : Vec_IntArray( p->vGlo2Cs );
     DdNode * bCurrent, * bReached, * bNext, * bTemp;
-    abctime clk2, clk = Abc_Clock();
+    abctime clk2, clk = Abc_WallClock();
     int nIters, nBddSize;//, iOutFail = -1;
 /*
     // compute time to stop
@@ -286,7 +286,7 @@ int Llb_CoreReachability_int( Llb_Img_t * p, Vec_Ptr_t * vQuant0, Vec_Ptr_t * vQ
     // compute onion rings
     for ( nIters = 0; nIters < p->pPars->nIterMax; nIters++ )
     { 
-        clk2 = Abc_Clock();
+        clk2 = Abc_WallClock();
         // check the runtime limit
         if ( p->pPars->TimeLimit && Abc_Clock() > p->pPars->TimeTarget )
         {
@@ -326,7 +326,7 @@ int Llb_CoreReachability_int( Llb_Img_t * p, Vec_Ptr_t * vQuant0, Vec_Ptr_t * vQ
                     Abc_Print( 1, "Output %d of miter \"%s\" was asserted in frame %d.  ", p->pInit->pSeqModel->iPo, p->pInit->pName, nIters );
                 else
                     Abc_Print( 1, "Output ??? was asserted in frame %d (counter-example is not produced).  ", nIters );
-                Abc_PrintTime( 1, "Time", Abc_Clock() - clk );
+                Abc_PrintTime( 1, "Time", Abc_WallClock() - clk );
             }
             p->pPars->iFrame = nIters - 1;
             return 0;
@@ -335,7 +335,7 @@ int Llb_CoreReachability_int( Llb_Img_t * p, Vec_Ptr_t * vQuant0, Vec_Ptr_t * vQ
         // compute the next states
         bNext = Llb_ImgComputeImage( p->pAig, p->vDdMans, p->dd, bCurrent, 
             vQuant0, vQuant1, p->vDriRefs, p->pPars->TimeTarget, 
-            p->pPars->fBackward, p->pPars->fReorder, p->pPars->fVeryVerbose );
+            p->pPars->fBackward, p->pPars->fReorder, p->pPars->nProcs, p->pPars->fVeryVerbose );
         if ( bNext == NULL )
         {
             if ( !p->pPars->fSilent )
@@ -428,7 +428,7 @@ int Llb_CoreReachability_int( Llb_Img_t * p, Vec_Ptr_t * vQuant0, Vec_Ptr_t * vQ
             fprintf( stdout, "Reach =%6d  ", Cudd_DagSize(bReached) );
             fprintf( stdout, "(%4d%4d)  ", 
                 Cudd_ReadReorderings(p->ddG), Cudd_ReadGarbageCollections(p->ddG) );
-            Abc_PrintTime( 1, "Time", Abc_Clock() - clk2 );
+            Abc_PrintTime( 1, "Time", Abc_WallClock() - clk2 );
         }
 
         // check timeframe limit
@@ -471,7 +471,7 @@ int Llb_CoreReachability_int( Llb_Img_t * p, Vec_Ptr_t * vQuant0, Vec_Ptr_t * vQ
         if ( !p->pPars->fSilent )
         {
             printf( "Verified only for states reachable in %d frames.  ", nIters );
-            Abc_PrintTime( 1, "Time", Abc_Clock() - clk );
+            Abc_PrintTime( 1, "Time", Abc_WallClock() - clk );
         }
         p->pPars->iFrame = p->pPars->nIterMax;
         return -1; // undecided
@@ -479,7 +479,7 @@ int Llb_CoreReachability_int( Llb_Img_t * p, Vec_Ptr_t * vQuant0, Vec_Ptr_t * vQ
     if ( !p->pPars->fSilent )
     {
         printf( "The miter is proved unreachable after %d iterations.  ", nIters );
-        Abc_PrintTime( 1, "Time", Abc_Clock() - clk );
+        Abc_PrintTime( 1, "Time", Abc_WallClock() - clk );
     }
     p->pPars->iFrame = nIters - 1;
     return 1; // unreachable
@@ -511,7 +511,7 @@ int Llb_CoreReachability( Llb_Img_t * p )
     Llb_ImgSchedule( vSupps, &vQuant0, &vQuant1, p->pPars->fVeryVerbose );
     Vec_VecFree( (Vec_Vec_t *)vSupps );
     // remove variables
-    Llb_ImgQuantifyFirst( p->pAig, p->vDdMans, vQuant0, p->pPars->fVeryVerbose );
+    Llb_ImgQuantifyFirst( p->pAig, p->vDdMans, vQuant0, p->pPars->nProcs, p->pPars->fVeryVerbose );
     // perform reachability
     RetValue = Llb_CoreReachability_int( p, vQuant0, vQuant1 );
     Vec_VecFree( (Vec_Vec_t *)vQuant0 );
@@ -531,13 +531,32 @@ int Llb_CoreReachability( Llb_Img_t * p )
   SeeAlso     []
 
 ***********************************************************************/
-Vec_Ptr_t * Llb_CoreConstructAll( Aig_Man_t * p, Vec_Ptr_t * vResult, Vec_Int_t * vVarsNs, abctime TimeTarget )
+Vec_Ptr_t * Llb_CoreConstructAll( Aig_Man_t * p, Vec_Ptr_t * vResult, Vec_Int_t * vVarsNs, abctime TimeTarget, int nProcs )
 {
     DdManager * dd;
     Vec_Ptr_t * vDdMans;
     Vec_Ptr_t * vLower, * vUpper = NULL;
     int i;
     vDdMans = Vec_PtrStart( Vec_PtrSize(vResult) );
+    if ( nProcs > 1 )
+    {
+        dd = Llb_DriverLastPartition( p, vVarsNs, TimeTarget );
+        Vec_PtrWriteEntry( vDdMans, Vec_PtrSize(vResult) - 1, dd );
+        if ( dd == NULL || !Llb_ImgPartitionPar( p, vResult, vDdMans, TimeTarget, nProcs ) )
+        {
+            Vec_PtrForEachEntry( DdManager *, vDdMans, dd, i )
+            {
+                if ( dd == NULL )
+                    continue;
+                if ( dd->bFunc )
+                    Cudd_RecursiveDeref( dd, dd->bFunc );
+                Extra_StopManager( dd );
+            }
+            Vec_PtrFree( vDdMans );
+            return NULL;
+        }
+        return vDdMans;
+    }
     Vec_PtrForEachEntryReverse( Vec_Ptr_t *, vResult, vLower, i )
     {
         if ( i < Vec_PtrSize(vResult) - 1 )
@@ -698,7 +717,7 @@ int Llb_CoreExperiment( Aig_Man_t * pInit, Aig_Man_t * pAig, Gia_ParLlb_t * pPar
 //    printf( "\n" );
 //    pPars->fVerbose = 1;
     p = Llb_CoreStart( pInit, pAig, pPars );
-    p->vDdMans = Llb_CoreConstructAll( pAig, vResult, p->vVarsNs, TimeTarget );
+    p->vDdMans = Llb_CoreConstructAll( pAig, vResult, p->vVarsNs, TimeTarget, pPars->nProcs );
     if ( p->vDdMans == NULL )
     {
         if ( !pPars->fSilent )
@@ -728,7 +747,7 @@ int Llb_ManReachMinCut( Aig_Man_t * pAig, Gia_ParLlb_t * pPars )
     Vec_Ptr_t * vResult;
     Aig_Man_t * p;
     int RetValue = -1;
-    abctime clk = Abc_Clock();
+    abctime clk = Abc_WallClock();
 
     // compute time to stop
     pPars->TimeTarget = pPars->TimeLimit ? pPars->TimeLimit * CLOCKS_PER_SEC + Abc_Clock(): 0;
@@ -764,7 +783,7 @@ int Llb_ManReachMinCut( Aig_Man_t * pAig, Gia_ParLlb_t * pPars )
     Aig_ManStop( p );
 
     if ( RetValue == -1 )
-        Abc_PrintTime( 1, "Total runtime of the min-cut-based reachability engine", Abc_Clock() - clk );
+        Abc_PrintTime( 1, "Total runtime of the min-cut-based reachability engine", Abc_WallClock() - clk );
     return RetValue;
 }
 
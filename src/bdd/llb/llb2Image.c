@@ -20,6 +20,17 @@
 
 #include "llbInt.h"
 
+#ifdef ABC_USE_PTHREADS
+
+#ifdef _WIN32
+#include "../lib/pthread.h"
+#else
+#include <pthread.h>
+#include <unistd.h>
+#endif
+
+#endif
+
 ABC_NAMESPACE_IMPL_START
 
 
@@ -173,18 +184,21 @@ void Llb_ImgSchedule( Vec_Ptr_t * vSupps, Vec_Ptr_t ** pvQuant0, Vec_Ptr_t ** pv
 
   Synopsis    [Computes one partition in a separate BDD manager.]
 
-  Description []
+  Description [Takes the internal nodes and the range of the cut computed
+  beforehand. The BDDs of the nodes are kept in a local array rather than
+  in the pData fields of the AIG objects, so that several partitions can
+  be constructed concurrently.]
                
   SideEffects []
 
   SeeAlso     []
 
 ***********************************************************************/
-DdManager * Llb_ImgPartition( Aig_Man_t * p, Vec_Ptr_t * vLower, Vec_Ptr_t * vUpper, abctime TimeTarget )
+DdManager * Llb_ImgPartitionCut( Aig_Man_t * p, Vec_Ptr_t * vLower, Vec_Ptr_t * vNodes, Vec_Ptr_t * vRange, abctime TimeTarget )
 {
-    Vec_Ptr_t * vNodes, * vRange;
     Aig_Obj_t * pObj;
     DdManager * dd;
+    DdNode ** pBdds;
     DdNode * bBdd0, * bBdd1, * bProd, * bRes, * bTemp;
     int i;
 
@@ -192,40 +206,39 @@ DdManager * Llb_ImgPartition( Aig_Man_t * p, Vec_Ptr_t * vLower, Vec_Ptr_t * vUp
     Cudd_AutodynEnable( dd,  CUDD_REORDER_SYMM_SIFT );
     dd->TimeStop = TimeTarget;
 
+    pBdds = ABC_CALLOC( DdNode *, Aig_ManObjNumMax(p) );
+    pBdds[Aig_ObjId(Aig_ManConst1(p))] = Cudd_ReadOne( dd );
     Vec_PtrForEachEntry( Aig_Obj_t *, vLower, pObj, i )
-        pObj->pData = Cudd_bddIthVar( dd, Aig_ObjId(pObj) );
+        pBdds[Aig_ObjId(pObj)] = Cudd_bddIthVar( dd, Aig_ObjId(pObj) );
 
-    vNodes = Llb_ManCutNodes( p, vLower, vUpper );
     Vec_PtrForEachEntry( Aig_Obj_t *, vNodes, pObj, i )
     {
-        bBdd0 = Cudd_NotCond( (DdNode *)Aig_ObjFanin0(pObj)->pData, Aig_ObjFaninC0(pObj) );
-        bBdd1 = Cudd_NotCond( (DdNode *)Aig_ObjFanin1(pObj)->pData, Aig_ObjFaninC1(pObj) );
+        bBdd0 = Cudd_NotCond( pBdds[Aig_ObjFaninId0(pObj)], Aig_ObjFaninC0(pObj) );
+        bBdd1 = Cudd_NotCond( pBdds[Aig_ObjFaninId1(pObj)], Aig_ObjFaninC1(pObj) );
 //        pObj->pData = Cudd_bddAnd( dd, bBdd0, bBdd1 );   Cudd_Ref( (DdNode *)pObj->pData );
 //        pObj->pData = Extra_bddAndTime( dd, bBdd0, bBdd1, TimeTarget );  
-        pObj->pData = Cudd_bddAnd( dd, bBdd0, bBdd1 );  
-        if ( pObj->pData == NULL )
+        pBdds[Aig_ObjId(pObj)] = Cudd_bddAnd( dd, bBdd0, bBdd1 );  
+        if ( pBdds[Aig_ObjId(pObj)] == NULL )
         {
             Cudd_Quit( dd );
-            Vec_PtrFree( vNodes );
+            ABC_FREE( pBdds );
             return NULL;
         }
-        Cudd_Ref( (DdNode *)pObj->pData );
+        Cudd_Ref( pBdds[Aig_ObjId(pObj)] );
     }
 
-    vRange = Llb_ManCutRange( p, vLower, vUpper );
     bRes   = Cudd_ReadOne(dd);   Cudd_Ref( bRes );
     Vec_PtrForEachEntry( Aig_Obj_t *, vRange, pObj, i )
     {
         assert( Aig_ObjIsNode(pObj) );
-        bProd = Cudd_bddXnor( dd, Cudd_bddIthVar(dd, Aig_ObjId(pObj)), (DdNode *)pObj->pData );   Cudd_Ref( bProd );
+        bProd = Cudd_bddXnor( dd, Cudd_bddIthVar(dd, Aig_ObjId(pObj)), pBdds[Aig_ObjId(pObj)] );   Cudd_Ref( bProd );
 //        bRes  = Cudd_bddAnd( dd, bTemp = bRes, bProd ); Cudd_Ref( bRes );
 //        bRes  = Extra_bddAndTime( dd, bTemp = bRes, bProd, TimeTarget );  
         bRes  = Cudd_bddAnd( dd, bTemp = bRes, bProd );  
         if ( bRes == NULL )
         {
             Cudd_Quit( dd );
-            Vec_PtrFree( vRange );
-            Vec_PtrFree( vNodes );
+            ABC_FREE( pBdds );
             return NULL;
         }        
         Cudd_Ref( bRes );
@@ -233,10 +246,9 @@ DdManager * Llb_ImgPartition( Aig_Man_t * p, Vec_Ptr_t * vLower, Vec_Ptr_t * vUp
         Cudd_RecursiveDeref( dd, bProd );
     }
     Vec_PtrForEachEntry( Aig_Obj_t *, vNodes, pObj, i )
-        Cudd_RecursiveDeref( dd, (DdNode *)pObj->pData );
+        Cudd_RecursiveDeref( dd, pBdds[Aig_ObjId(pObj)] );
+    ABC_FREE( pBdds );
 
-    Vec_PtrFree( vRange );
-    Vec_PtrFree( vNodes );
     Cudd_AutodynDisable( dd );
 //    Cudd_RecursiveDeref( dd, bRes );
 //    Extra_StopManager( dd );
@@ -245,6 +257,29 @@ DdManager * Llb_ImgPartition( Aig_Man_t * p, Vec_Ptr_t * vLower, Vec_Ptr_t * vUp
     return dd;
 }
 
+/**Function*************************************************************
+
+  Synopsis    [Computes one partition in a separate BDD manager.]
+
+  Description []
+               
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+DdManager * Llb_ImgPartition( Aig_Man_t * p, Vec_Ptr_t * vLower, Vec_Ptr_t * vUpper, abctime TimeTarget )
+{
+    Vec_Ptr_t * vNodes, * vRange;
+    DdManager * dd;
+    vNodes = Llb_ManCutNodes( p, vLower, vUpper );
+    vRange = Llb_ManCutRange( p, vLower, vUpper );
+    dd = Llb_ImgPartitionCut( p, vLower, vNodes, vRange, TimeTarget );
+    Vec_PtrFree( vRange );
+    Vec_PtrFree( vNodes );
+    return dd;
+}
+
 /**Function*************************************************************
 
   Synopsis    [Derives positive cube composed of nodes IDs.]
@@ -276,54 +311,313 @@ DdNode * Llb_ImgComputeCube( Aig_Man_t * pAig, Vec_Int_t * vNodeIds, DdManager *
 
 /**Function*************************************************************
 
-  Synopsis    []
+  Synopsis    [Quantifies the local variables of one partition.]
 
-  Description []
+  Description [Records the BDD sizes after each step in pSizes.]
                
   SideEffects []
 
   SeeAlso     []
 
 ***********************************************************************/
-void Llb_ImgQuantifyFirst( Aig_Man_t * pAig, Vec_Ptr_t * vDdMans, Vec_Ptr_t * vQuant0, int fVerbose )
+void Llb_ImgQuantifyOne( Aig_Man_t * pAig, DdManager * dd, Vec_Int_t * vQuant, int * pSizes )
 {
-    DdManager * dd;
     DdNode * bProd, * bRes, * bTemp;
+    // remember unquantified ones
+    assert( dd->bFunc2 == NULL );
+    dd->bFunc2 = dd->bFunc;   Cudd_Ref( dd->bFunc2 );
+
+    Cudd_AutodynEnable( dd, CUDD_REORDER_SYMM_SIFT );
+
+    bRes = dd->bFunc;
+    pSizes[0] = Cudd_DagSize(bRes);
+    bProd = Llb_ImgComputeCube( pAig, vQuant, dd );                Cudd_Ref( bProd );
+    bRes  = Cudd_bddExistAbstract( dd, bTemp = bRes, bProd );      Cudd_Ref( bRes );
+    Cudd_RecursiveDeref( dd, bTemp );
+    Cudd_RecursiveDeref( dd, bProd );
+    dd->bFunc = bRes;
+
+    Cudd_AutodynDisable( dd );
+
+    pSizes[1] = Cudd_DagSize(bRes);
+    Cudd_ReduceHeap( dd, CUDD_REORDER_SYMM_SIFT, 100 );
+    pSizes[2] = Cudd_DagSize(bRes);
+    Cudd_ReduceHeap( dd, CUDD_REORDER_SYMM_SIFT, 100 );
+    pSizes[3] = Cudd_DagSize(bRes);
+    pSizes[4] = Cudd_SupportSize(dd, bRes);
+}
+
+/**Function*************************************************************
+
+  Synopsis    [Simplifies one partition using the current frontier.]
+
+  Description [Transfers the frontier from the main manager into the 
+  partition manager and restricts the partition to it. The main manager
+  is only read, so partitions can be simplified concurrently. Returns
+  the referenced simplified partition, or the original partition if
+  simplification did not reduce its size.]
+               
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+DdNode * Llb_ImgSimplifyOne( DdManager * dd, DdNode * bFront, DdManager * ddPart )
+{
+    DdNode * bCare, * bRes;
+    bCare = Cudd_bddTransfer( dd, ddPart, bFront );
+    if ( bCare == NULL )
+    {
+        Cudd_Ref( ddPart->bFunc );
+        return ddPart->bFunc;
+    }
+    Cudd_Ref( bCare );
+    bRes = Cudd_bddRestrict( ddPart, ddPart->bFunc, bCare );
+    if ( bRes == NULL || Cudd_DagSize(bRes) >= Cudd_DagSize(ddPart->bFunc) )
+        bRes = ddPart->bFunc;
+    Cudd_Ref( bRes );
+    Cudd_RecursiveDeref( ddPart, bCare );
+    return bRes;
+}
+
+/**Function*************************************************************
+
+  Synopsis    [Performs one job on the partitions.]
+
+  Description [Each job works with its own partition manager and only
+  reads the AIG and the main manager.]
+               
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+typedef struct Llb_ImgJob_t_ Llb_ImgJob_t;
+struct Llb_ImgJob_t_
+{
+    int           Type;       // job type
+    Aig_Man_t *   pAig;       // AIG manager
+    Vec_Ptr_t *   vDdMans;    // partition managers
+    // constructing partitions
+    Vec_Ptr_t *   vLowers;    // lower cuts
+    Vec_Ptr_t *   vNodes;     // internal nodes of the cuts
+    Vec_Ptr_t *   vRanges;    // upper cuts
+    abctime       TimeTarget; // the time to stop
+    // quantifying local variables
+    Vec_Ptr_t *   vQuant0;    // variables to quantify
+    Vec_Int_t *   vSizes;     // BDD sizes (5 per partition)
+    // simplifying with the frontier
+    DdManager *   dd;         // main manager
+    DdNode *      bFront;     // frontier in the main manager
+    Vec_Ptr_t *   vSimps;     // simplified partitions
+};
+
+#define LLB_IMG_BUILD     0
+#define LLB_IMG_QUANT     1
+#define LLB_IMG_SIMPLIFY  2
+
+void Llb_ImgRunJob( Llb_ImgJob_t * p, int i )
+{
+    if ( p->Type == LLB_IMG_BUILD )
+        Vec_PtrWriteEntry( p->vDdMans, i, Llb_ImgPartitionCut( p->pAig, (Vec_Ptr_t *)Vec_PtrEntry(p->vLowers, i), 
+            (Vec_Ptr_t *)Vec_PtrEntry(p->vNodes, i), (Vec_Ptr_t *)Vec_PtrEntry(p->vRanges, i), p->TimeTarget ) );
+    else if ( p->Type == LLB_IMG_QUANT )
+        Llb_ImgQuantifyOne( p->pAig, (DdManager *)Vec_PtrEntry(p->vDdMans, i), 
+            (Vec_Int_t *)Vec_PtrEntry(p->vQuant0, i+1), Vec_IntEntryP(p->vSizes, 5*i) );
+    else if ( p->Type == LLB_IMG_SIMPLIFY )
+        Vec_PtrWriteEntry( p->vSimps, i, Llb_ImgSimplifyOne( p->dd, p->bFront, (DdManager *)Vec_PtrEntry(p->vDdMans, i) ) );
+    else assert( 0 );
+}
+
+/**Function*************************************************************
+
+  Synopsis    [Performs the jobs using several threads.]
+
+  Description []
+               
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+#ifndef ABC_USE_PTHREADS
+
+void Llb_ImgRunJobs( Llb_ImgJob_t * p, int nJobs, int nProcs )
+{
     int i;
-    abctime clk = Abc_Clock();
-    Vec_PtrForEachEntry( DdManager *, vDdMans, dd, i )
+    for ( i = 0; i < nJobs; i++ )
+        Llb_ImgRunJob( p, i );
+}
+
+#else // pthreads are used
+
+#define PAR_THR_MAX 100
+typedef struct Llb_ImgThData_t_
+{
+    Llb_ImgJob_t * p;
+    int            Index;
+    int            fWorking;
+} Llb_ImgThData_t;
+
+void * Llb_ImgWorkerThread( void * pArg )
+{
+    Llb_ImgThData_t * pThData = (Llb_ImgThData_t *)pArg;
+    volatile int * pPlace = &pThData->fWorking;
+    while ( 1 )
     {
-        // remember unquantified ones
-        assert( dd->bFunc2 == NULL );
-        dd->bFunc2 = dd->bFunc;   Cudd_Ref( dd->bFunc2 );
+        while ( *pPlace == 0 );
+        assert( pThData->fWorking );
+        if ( pThData->Index == -1 )
+        {
+            pthread_exit( NULL );
+            assert( 0 );
+            return NULL;
+        }
+        Llb_ImgRunJob( pThData->p, pThData->Index );
+        pThData->fWorking = 0;
+    }
+    assert( 0 );
+    return NULL;
+}
 
-        Cudd_AutodynEnable( dd, CUDD_REORDER_SYMM_SIFT );
+void Llb_ImgRunJobs( Llb_ImgJob_t * p, int nJobs, int nProcs )
+{
+    Llb_ImgThData_t ThData[PAR_THR_MAX];
+    pthread_t WorkerThread[PAR_THR_MAX];
+    int i, k, status;
+    if ( nProcs < 2 || nJobs < 2 )
+    {
+        for ( k = 0; k < nJobs; k++ )
+            Llb_ImgRunJob( p, k );
+        return;
+    }
+    // subtract manager thread
+    nProcs = Abc_MinInt( nProcs - 1, nJobs );
+    assert( nProcs >= 1 && nProcs <= PAR_THR_MAX );
+    // start threads
+    for ( i = 0; i < nProcs; i++ )
+    {
+        ThData[i].p        = p;
+        ThData[i].Index    = -1;
+        ThData[i].fWorking = 0;
+        status = pthread_create( WorkerThread + i, NULL, Llb_ImgWorkerThread, (void *)(ThData + i) );  assert( status == 0 );
+    }
+    // distribute the jobs
+    for ( k = 0; k < nJobs; k++ )
+    {
+        for ( i = 0; i < nProcs; i++ )
+        {
+            if ( ThData[i].fWorking )
+                continue;
+            ThData[i].Index = k;
+            ThData[i].fWorking = 1;
+            break;
+        }
+        if ( i == nProcs )
+            k--;
+    }
+    // wait till threads finish
+    for ( i = 0; i < nProcs; i++ )
+        if ( ThData[i].fWorking )
+            i = -1;
+    // stop threads
+    for ( i = 0; i < nProcs; i++ )
+    {
+        assert( !ThData[i].fWorking );
+        ThData[i].Index = -1;
+        ThData[i].fWorking = 1;
+    }
+    for ( i = 0; i < nProcs; i++ )
+        pthread_join( WorkerThread[i], NULL );
+}
 
-        bRes = dd->bFunc;
-        if ( fVerbose )
-            Abc_Print( 1, "Part %2d : Init =%5d. ", i, Cudd_DagSize(bRes) );
-        bProd = Llb_ImgComputeCube( pAig, (Vec_Int_t *)Vec_PtrEntry(vQuant0, i+1), dd );   Cudd_Ref( bProd );
-        bRes  = Cudd_bddExistAbstract( dd, bTemp = bRes, bProd );                          Cudd_Ref( bRes );
-        Cudd_RecursiveDeref( dd, bTemp );
-        Cudd_RecursiveDeref( dd, bProd );
-        dd->bFunc = bRes;
-
-        Cudd_AutodynDisable( dd );
-
-        if ( fVerbose )
-            Abc_Print( 1, "Quant =%5d. ", Cudd_DagSize(bRes) );
-        Cudd_ReduceHeap( dd, CUDD_REORDER_SYMM_SIFT, 100 );
-        if ( fVerbose ) 
-            Abc_Print( 1, "Reo = %5d. ", Cudd_DagSize(bRes) );
-        Cudd_ReduceHeap( dd, CUDD_REORDER_SYMM_SIFT, 100 );
-        if ( fVerbose ) 
-            Abc_Print( 1, "Reo = %5d.  ", Cudd_DagSize(bRes) );
-        if ( fVerbose ) 
-            Abc_Print( 1, "Supp = %3d.  ", Cudd_SupportSize(dd, bRes) );
-        if ( fVerbose ) 
-            Abc_PrintTime( 1, "Time", Abc_Clock() - clk );
+#endif // pthreads are used
+
+/**Function*************************************************************
+
+  Synopsis    [Computes the partitions in separate BDD managers.]
+
+  Description [Constructs the partitions between the consecutive cuts in
+  vResult (except the last one) using several threads. The cuts are 
+  computed upfront because they rely on the traversal IDs of the AIG.
+  Returns 0 if some partition could not be built.]
+               
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+int Llb_ImgPartitionPar( Aig_Man_t * p, Vec_Ptr_t * vResult, Vec_Ptr_t * vDdMans, abctime TimeTarget, int nProcs )
+{
+    Llb_ImgJob_t Job, * pJob = &Job;
+    Vec_Ptr_t * vLower, * vUpper;
+    int i, nParts = Vec_PtrSize(vResult) - 1;
+    assert( Vec_PtrSize(vDdMans) == Vec_PtrSize(vResult) );
+    memset( pJob, 0, sizeof(Llb_ImgJob_t) );
+    pJob->Type       = LLB_IMG_BUILD;
+    pJob->pAig       = p;
+    pJob->vDdMans    = vDdMans;
+    pJob->vLowers    = Vec_PtrAlloc( nParts );
+    pJob->vNodes     = Vec_PtrAlloc( nParts );
+    pJob->vRanges    = Vec_PtrAlloc( nParts );
+    pJob->TimeTarget = TimeTarget;
+    for ( i = 0; i < nParts; i++ )
+    {
+        vLower = (Vec_Ptr_t *)Vec_PtrEntry( vResult, i );
+        vUpper = (Vec_Ptr_t *)Vec_PtrEntry( vResult, i+1 );
+        Vec_PtrPush( pJob->vLowers, vLower );
+        Vec_PtrPush( pJob->vNodes,  Llb_ManCutNodes( p, vLower, vUpper ) );
+        Vec_PtrPush( pJob->vRanges, Llb_ManCutRange( p, vLower, vUpper ) );
+    }
+    Llb_ImgRunJobs( pJob, nParts, nProcs );
+    Vec_PtrFree( pJob->vLowers );
+    Vec_VecFree( (Vec_Vec_t *)pJob->vNodes );
+    Vec_VecFree( (Vec_Vec_t *)pJob->vRanges );
+    for ( i = 0; i < nParts; i++ )
+        if ( Vec_PtrEntry(vDdMans, i) == NULL )
+            return 0;
+    return 1;
+}
+
+/**Function*************************************************************
+
+  Synopsis    [Quantifies the local variables of the partitions.]
+
+  Description []
+               
+  SideEffects []
 
+  SeeAlso     []
+
+***********************************************************************/
+void Llb_ImgQuantifyFirst( Aig_Man_t * pAig, Vec_Ptr_t * vDdMans, Vec_Ptr_t * vQuant0, int nProcs, int fVerbose )
+{
+    Llb_ImgJob_t Job, * pJob = &Job;
+    int i, * pSizes;
+    abctime clk = Abc_WallClock();
+    memset( pJob, 0, sizeof(Llb_ImgJob_t) );
+    pJob->Type    = LLB_IMG_QUANT;
+    pJob->pAig    = pAig;
+    pJob->vDdMans = vDdMans;
+    pJob->vQuant0 = vQuant0;
+    pJob->vSizes  = Vec_IntStart( 5 * Vec_PtrSize(vDdMans) );
+    for ( i = 0; i < Vec_PtrSize(vDdMans); i++ )
+    {
+        if ( nProcs > 1 && i == 0 )
+            Llb_ImgRunJobs( pJob, Vec_PtrSize(vDdMans), nProcs );
+        else if ( nProcs <= 1 )
+            Llb_ImgRunJob( pJob, i );
+        if ( !fVerbose )
+            continue;
+        pSizes = Vec_IntEntryP( pJob->vSizes, 5*i );
+        Abc_Print( 1, "Part %2d : Init =%5d. ", i, pSizes[0] );
+        Abc_Print( 1, "Quant =%5d. ", pSizes[1] );
+        Abc_Print( 1, "Reo = %5d. ", pSizes[2] );
+        Abc_Print( 1, "Reo = %5d.  ", pSizes[3] );
+        Abc_Print( 1, "Supp = %3d.  ", pSizes[4] );
+        Abc_PrintTime( 1, "Time", Abc_WallClock() - clk );
     }
+    Vec_IntFree( pJob->vSizes );
 }
 
 /**Function*************************************************************
@@ -352,7 +646,7 @@ void Llb_ImgQuantifyReset( Vec_Ptr_t * vDdMans )
 
 /**Function*************************************************************
 
-  Synopsis    [Computes image of the initial set of states.]
+  Synopsis    [Dereferences the simplified partitions.]
 
   Description []
                
@@ -360,16 +654,40 @@ void Llb_ImgQuantifyReset( Vec_Ptr_t * vDdMans )
 
   SeeAlso     []
 
+***********************************************************************/
+void Llb_ImgSimpsFree( Vec_Ptr_t * vDdMans, Vec_Ptr_t * vSimps )
+{
+    DdManager * ddPart;
+    int i;
+    if ( vSimps == NULL )
+        return;
+    Vec_PtrForEachEntry( DdManager *, vDdMans, ddPart, i )
+        Cudd_RecursiveDeref( ddPart, (DdNode *)Vec_PtrEntry(vSimps, i) );
+    Vec_PtrFree( vSimps );
+}
+
+/**Function*************************************************************
+
+  Synopsis    [Computes image of the initial set of states.]
+
+  Description [If nProcs > 1, the partitions are first restricted to the
+  frontier in their own managers using several threads.]
+               
+  SideEffects []
+
+  SeeAlso     []
+
 ***********************************************************************/
 DdNode * Llb_ImgComputeImage( Aig_Man_t * pAig, Vec_Ptr_t * vDdMans, DdManager * dd, DdNode * bInit, 
     Vec_Ptr_t * vQuant0, Vec_Ptr_t * vQuant1, Vec_Int_t * vDriRefs, 
-    abctime TimeTarget, int fBackward, int fReorder, int fVerbose )
+    abctime TimeTarget, int fBackward, int fReorder, int nProcs, int fVerbose )
 {
 //    int fCheckSupport = 0;
+    Llb_ImgJob_t Job, * pJob = &Job;
     DdManager * ddPart;
-    DdNode * bImage, * bGroup, * bCube, * bTemp;
+    DdNode * bImage, * bGroup, * bCube, * bTemp, * bPart;
     int i;
-    abctime clk, clk0 = Abc_Clock();
+    abctime clk, clk0 = Abc_WallClock();
 
     bImage = bInit;  Cudd_Ref( bImage );
     if ( fBackward )
@@ -395,19 +713,35 @@ DdNode * Llb_ImgComputeImage( Aig_Man_t * pAig, Vec_Ptr_t * vDdMans, DdManager *
         Cudd_RecursiveDeref( dd, bTemp );
         Cudd_RecursiveDeref( dd, bCube );
     }
+    // simplify the partitions using the frontier in their own managers
+    memset( pJob, 0, sizeof(Llb_ImgJob_t) );
+    if ( nProcs > 1 )
+    {
+        pJob->Type    = LLB_IMG_SIMPLIFY;
+        pJob->vDdMans = vDdMans;
+        pJob->dd      = dd;
+        pJob->bFront  = bImage;
+        pJob->vSimps  = Vec_PtrStart( Vec_PtrSize(vDdMans) );
+        Llb_ImgRunJobs( pJob, Vec_PtrSize(vDdMans), nProcs );
+    }
     // perform image computation
     Vec_PtrForEachEntry( DdManager *, vDdMans, ddPart, i )
     {
-        clk = Abc_Clock();
+        clk = Abc_WallClock();
 if ( fVerbose )
 printf( "   %2d : ", i );
         // transfer the BDD from the group manager to the main manager
-        bGroup = Cudd_bddTransfer( ddPart, dd, ddPart->bFunc );                           
+        bPart  = pJob->vSimps ? (DdNode *)Vec_PtrEntry(pJob->vSimps, i) : ddPart->bFunc;
+        bGroup = Cudd_bddTransfer( ddPart, dd, bPart );                           
         if ( bGroup == NULL )
+        {
+            Cudd_RecursiveDeref( dd, bImage );
+            Llb_ImgSimpsFree( vDdMans, pJob->vSimps );
             return NULL;
+        }
         Cudd_Ref( bGroup );
 if ( fVerbose )
-printf( "Pt0 =%6d. Pt1 =%6d. ", Cudd_DagSize(ddPart->bFunc), Cudd_DagSize(bGroup) );
+printf( "Pt0 =%6d. Pt1 =%6d. ", Cudd_DagSize(bPart), Cudd_DagSize(bGroup) );
         // perform partial product
         bCube  = Llb_ImgComputeCube( pAig, (Vec_Int_t *)Vec_PtrEntry(vQuant1, i+1), dd ); Cudd_Ref( bCube );
 //        bImage = Cudd_bddAndAbstract( dd, bTemp = bImage, bGroup, bCube );                
@@ -418,6 +752,7 @@ printf( "Pt0 =%6d. Pt1 =%6d. ", Cudd_DagSize(ddPart->bFunc), Cudd_DagSize(bGroup
             Cudd_RecursiveDeref( dd, bTemp );
             Cudd_RecursiveDeref( dd, bCube );
             Cudd_RecursiveDeref( dd, bGroup );
+            Llb_ImgSimpsFree( vDdMans, pJob->vSimps );
             return NULL;
         }
         Cudd_Ref( bImage );
@@ -435,8 +770,9 @@ printf( "Im0 =%6d. Im1 =%6d. ", Cudd_DagSize(bTemp), Cudd_DagSize(bImage) );
 if ( fVerbose )
 printf( "Supp =%3d. ", Cudd_SupportSize(dd, bImage) );
 if ( fVerbose )
-Abc_PrintTime( 1, "T", Abc_Clock() - clk );
+Abc_PrintTime( 1, "T", Abc_WallClock() - clk );
     }
+    Llb_ImgSimpsFree( vDdMans, pJob->vSimps );
 
     if ( !fBackward )
     {
@@ -465,7 +801,7 @@ Abc_PrintTime( 1, "T", Abc_Clock() - clk );
 //    Cudd_ReduceHeap( dd, CUDD_REORDER_SYMM_SIFT, 100 );
 //    Abc_Print( 1, "After =%5d.  ", Cudd_DagSize(bImage) );
     if ( fVerbose )
-    Abc_PrintTime( 1, "Time", Abc_Clock() - clk0 );
+    Abc_PrintTime( 1, "Time", Abc_WallClock() - clk0 );
 //    Abc_Print( 1, "\n" );
     }
 
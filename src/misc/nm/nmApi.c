@@ -48,15 +48,11 @@ Nm_Man_t * Nm_ManCreate( int nSize )
     // allocate the table
     p = ABC_ALLOC( Nm_Man_t, 1 );
     memset( p, 0, sizeof(Nm_Man_t) );
-    // set the parameters
-    p->nSizeFactor   = 2; // determined the limit on the grow of data before the table resizes
-    p->nGrowthFactor = 3; // determined how much the table grows after resizing
     // allocate and clean the bins
-    p->nBins = Abc_PrimeCudd(nSize);
-    p->pBinsI2N = ABC_ALLOC( Nm_Entry_t *, p->nBins );
-    p->pBinsN2I = ABC_ALLOC( Nm_Entry_t *, p->nBins );
-    memset( p->pBinsI2N, 0, sizeof(Nm_Entry_t *) * p->nBins );
-    memset( p->pBinsN2I, 0, sizeof(Nm_Entry_t *) * p->nBins );
+    p->nBins = 16;
+    p->pBins = ABC_CALLOC( Nm_Entry_t *, p->nBins );
+    Nm_ManTableReserve( p, nSize );
+    p->vId2Entry = Vec_PtrAlloc( 2 * nSize );
     // start the memory manager
     p->pMem = Extra_MmFlexStart();
     return p;
@@ -76,8 +72,8 @@ Nm_Man_t * Nm_ManCreate( int nSize )
 void Nm_ManFree( Nm_Man_t * p )
 {
     Extra_MmFlexStop( p->pMem );
-    ABC_FREE( p->pBinsI2N );
-    ABC_FREE( p->pBinsN2I );
+    Vec_PtrFree( p->vId2Entry );
+    ABC_FREE( p->pBins );
     ABC_FREE( p );
 }
 
@@ -124,7 +120,7 @@ char * Nm_ManStoreIdName( Nm_Man_t * p, int ObjId, int Type, char * pName, char
 //    nEntrySize = (nEntrySize / 4 + ((nEntrySize % 4) > 0)) * 4;
     nEntrySize = (nEntrySize / sizeof(char*) + ((nEntrySize % sizeof(char*)) > 0)) * sizeof(char*); // added by Saurabh on Sep 3, 2009
     pEntry = (Nm_Entry_t *)Extra_MmFlexEntryFetch( p->pMem, nEntrySize );
-    pEntry->pNextI2N = pEntry->pNextN2I = pEntry->pNameSake = NULL;
+    pEntry->pNameSake = NULL;
     pEntry->ObjId = ObjId;
     pEntry->Type = Type;
     sprintf( pEntry->Name, "%s%s", pName, pSuffix? pSuffix : "" );
@@ -261,14 +257,32 @@ int Nm_ManFindIdByNameTwoTypes( Nm_Man_t * p, char * pName, int Type1, int Type2
 Vec_Int_t * Nm_ManReturnNameIds( Nm_Man_t * p )
 {
     Vec_Int_t * vNameIds;
+    Nm_Entry_t * pEntry;
     int i;
     vNameIds = Vec_IntAlloc( p->nEntries );
-    for ( i = 0; i < p->nBins; i++ )
-        if ( p->pBinsI2N[i] )
-            Vec_IntPush( vNameIds, p->pBinsI2N[i]->ObjId );
+    Vec_PtrForEachEntry( Nm_Entry_t *, p->vId2Entry, pEntry, i )
+        if ( pEntry )
+            Vec_IntPush( vNameIds, pEntry->ObjId );
     return vNameIds;
 }
 
+/**Function*************************************************************
+
+  Synopsis    [Prepares the manager for adding the given number of names.]
+
+  Description [Resizes the tables once, instead of resizing them several 
+  times while the names are added one by one.]
+               
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+void Nm_ManReserve( Nm_Man_t * p, int nEntries )
+{
+    Nm_ManTableReserve( p, nEntries );
+}
+
 ////////////////////////////////////////////////////////////////////////
 ///                       END OF FILE                                ///
 ////////////////////////////////////////////////////////////////////////
@@ -48,20 +48,18 @@ struct Nm_Entry_t_
 {
     unsigned         Type;          // object type
     unsigned         ObjId;         // object ID
-    Nm_Entry_t *     pNextI2N;      // the next entry in the ID hash table
-    Nm_Entry_t *     pNextN2I;      // the next entry in the name hash table
+    unsigned         Key;           // hash key of the name
     Nm_Entry_t *     pNameSake;     // the next entry with the same name
     char             Name[0];       // name of the object
 };
 
 struct Nm_Man_t_
 {
-    Nm_Entry_t **    pBinsI2N;      // mapping IDs into names
-    Nm_Entry_t **    pBinsN2I;      // mapping names into IDs 
-    int              nBins;         // the number of bins in tables
+    Nm_Entry_t **    pBins;         // open-addressing table mapping names into entries
+    int              nBins;         // the number of bins (a power of 2)
+    int              nNames;        // the number of different names
     int              nEntries;      // the number of entries
-    int              nSizeFactor;   // determined how much larger the table should be
-    int              nGrowthFactor; // determined how much the table grows after resizing
+    Vec_Ptr_t *      vId2Entry;     // mapping IDs into entries
     Extra_MmFlex_t * pMem;          // memory manager for entries (and names)
 };
 
@@ -78,6 +76,7 @@ extern int              Nm_ManTableAdd( Nm_Man_t * p, Nm_Entry_t * pEntry );
 extern int              Nm_ManTableDelete( Nm_Man_t * p, int ObjId );
 extern Nm_Entry_t *     Nm_ManTableLookupId( Nm_Man_t * p, int ObjId );
 extern Nm_Entry_t *     Nm_ManTableLookupName( Nm_Man_t * p, char * pName, int Type );
+extern void             Nm_ManTableReserve( Nm_Man_t * p, int nNames );
 
 
 
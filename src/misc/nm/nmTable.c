@@ -17,7 +17,6 @@
   Revision    [$Id: nmTable.c,v 1.00 2005/06/20 00:00:00 alanmi Exp $]
 
 ***********************************************************************/
-
 #include "nmInt.h"
 
 ABC_NAMESPACE_IMPL_START
@@ -27,31 +26,26 @@ ABC_NAMESPACE_IMPL_START
 ///                        DECLARATIONS                              ///
 ////////////////////////////////////////////////////////////////////////
 
-// hashing for integers
-static unsigned Nm_HashNumber( int Num, int TableSize ) 
+// hashing for strings
+static unsigned Nm_HashString( char * pName ) 
 {
-    unsigned Key = 0;
-    Key ^= ( Num        & 0xFF) * 7937;
-    Key ^= ((Num >>  8) & 0xFF) * 2971;
-    Key ^= ((Num >> 16) & 0xFF) * 911;
-    Key ^= ((Num >> 24) & 0xFF) * 353;
-    return Key % TableSize;
+    unsigned Key = 2166136261u;
+    for ( ; *pName; pName++ )
+        Key = (Key ^ (unsigned char)*pName) * 16777619u;
+    return Key ^ (Key >> 15);
 }
 
-// hashing for strings
-static unsigned Nm_HashString( char * pName, int TableSize ) 
+// returns the bin where the entry with this name is, or the empty bin where it should be
+static inline int Nm_ManTableFindBin( Nm_Man_t * p, char * pName, unsigned Key )
 {
-    static int s_Primes[10] = { 
-        1291, 1699, 2357, 4177, 5147, 
-        5647, 6343, 7103, 7873, 8147
-    };
-    unsigned i, Key = 0;
-    for ( i = 0; pName[i] != '\0'; i++ )
-        Key ^= s_Primes[i%10]*pName[i]*pName[i];
-    return Key % TableSize;
+    int Mask = p->nBins - 1, i = (int)(Key & Mask);
+    for ( ; p->pBins[i]; i = (i + 1) & Mask )
+        if ( p->pBins[i]->Key == Key && !strcmp(p->pBins[i]->Name, pName) )
+            break;
+    return i;
 }
 
-static void Nm_ManResize( Nm_Man_t * p );
+static void Nm_ManResize( Nm_Man_t * p, int nBinsNew );
 
 ////////////////////////////////////////////////////////////////////////
 ///                     FUNCTION DEFINITIONS                         ///
@@ -59,9 +53,10 @@ static void Nm_ManResize( Nm_Man_t * p );
 
 /**Function*************************************************************
 
-  Synopsis    [Adds an entry to two hash tables.]
+  Synopsis    [Adds an entry to the tables.]
 
-  Description []
+  Description [The name table contains one entry for each name. Other 
+  entries with the same name are linked into the ring of namesakes.]
                
   SideEffects []
 
@@ -70,17 +65,19 @@ static void Nm_ManResize( Nm_Man_t * p );
 ***********************************************************************/
 int Nm_ManTableAdd( Nm_Man_t * p, Nm_Entry_t * pEntry )
 {
-    Nm_Entry_t ** ppSpot, * pOther;
-    // resize the tables if needed
-    if ( p->nEntries > p->nBins * p->nSizeFactor )
-        Nm_ManResize( p );
+    Nm_Entry_t * pOther;
+    int iBin;
+    // resize the table if needed
+    if ( 2 * (p->nNames + 1) > p->nBins )
+        Nm_ManResize( p, 2 * p->nBins );
     // add the entry to the table Id->Name
     assert( Nm_ManTableLookupId(p, pEntry->ObjId) == NULL );
-    ppSpot = p->pBinsI2N + Nm_HashNumber(pEntry->ObjId, p->nBins);
-    pEntry->pNextI2N = *ppSpot;
-    *ppSpot = pEntry;
+    Vec_PtrFillExtra( p->vId2Entry, pEntry->ObjId + 1, NULL );
+    Vec_PtrWriteEntry( p->vId2Entry, pEntry->ObjId, pEntry );
     // check if an entry with the same name already exists
-    if ( (pOther = Nm_ManTableLookupName(p, pEntry->Name, -1)) )
+    pEntry->Key = Nm_HashString( pEntry->Name );
+    iBin = Nm_ManTableFindBin( p, pEntry->Name, pEntry->Key );
+    if ( (pOther = p->pBins[iBin]) )
     {
         // entry with the same name already exists - add it to the ring
         pEntry->pNameSake = pOther->pNameSake? pOther->pNameSake : pOther;
@@ -89,9 +86,8 @@ int Nm_ManTableAdd( Nm_Man_t * p, Nm_Entry_t * pEntry )
     else
     {
         // entry with the same name does not exist - add it to the table
-        ppSpot = p->pBinsN2I + Nm_HashString(pEntry->Name, p->nBins);
-        pEntry->pNextN2I = *ppSpot;
-        *ppSpot = pEntry;
+        p->pBins[iBin] = pEntry;
+        p->nNames++;
     }
     // report successfully added entry
     p->nEntries++;
@@ -100,9 +96,11 @@ int Nm_ManTableAdd( Nm_Man_t * p, Nm_Entry_t * pEntry )
 
 /**Function*************************************************************
 
-  Synopsis    [Deletes the entry from two hash tables.]
+  Synopsis    [Deletes the entry from the tables.]
 
-  Description []
+  Description [When the last entry with the given name is removed, 
+  the following entries of the probing sequence are shifted back, 
+  so that the lookup does not need tombstones.]
                
   SideEffects []
 
@@ -111,49 +109,45 @@ int Nm_ManTableAdd( Nm_Man_t * p, Nm_Entry_t * pEntry )
 ***********************************************************************/
 int Nm_ManTableDelete( Nm_Man_t * p, int ObjId )
 {
-    Nm_Entry_t ** ppSpot, * pEntry, * pPrev;
-    int fRemoved;
+    Nm_Entry_t * pEntry, * pPrev;
+    int Mask = p->nBins - 1, i, k, iBin;
     p->nEntries--;
     // remove the entry from the table Id->Name
     assert( Nm_ManTableLookupId(p, ObjId) != NULL );
-    ppSpot = p->pBinsI2N + Nm_HashNumber(ObjId, p->nBins);
-    while ( (*ppSpot)->ObjId != (unsigned)ObjId )
-        ppSpot = &(*ppSpot)->pNextI2N;
-    pEntry = *ppSpot; 
-    *ppSpot = (*ppSpot)->pNextI2N;
-    // remove the entry from the table Name->Id
-    ppSpot = p->pBinsN2I + Nm_HashString(pEntry->Name, p->nBins);
-    while ( *ppSpot && *ppSpot != pEntry )
-        ppSpot = &(*ppSpot)->pNextN2I;
-    // remember if we found this one in the list
-    fRemoved = (*ppSpot != NULL);
-    if ( *ppSpot )
+    pEntry = (Nm_Entry_t *)Vec_PtrEntry( p->vId2Entry, ObjId );
+    Vec_PtrWriteEntry( p->vId2Entry, ObjId, NULL );
+    // find the bin of this name
+    iBin = Nm_ManTableFindBin( p, pEntry->Name, pEntry->Key );
+    assert( p->pBins[iBin] != NULL );
+    // if this entry has namesakes, remove it from the ring
+    if ( pEntry->pNameSake )
     {
-        assert( *ppSpot == pEntry );
-        *ppSpot = (*ppSpot)->pNextN2I;
-    }
-    // quit if this entry has no namesakes
-    if ( pEntry->pNameSake == NULL )
-    {
-        assert( fRemoved );
+        assert( pEntry->pNameSake != pEntry );
+        for ( pPrev = pEntry; pPrev->pNameSake != pEntry; pPrev = pPrev->pNameSake );
+        assert( !strcmp(pPrev->Name, pEntry->Name) );
+        if ( pEntry->pNameSake == pPrev ) // two entries in the ring
+            pPrev->pNameSake = NULL;
+        else
+            pPrev->pNameSake = pEntry->pNameSake;
+        // let the namesake represent the name in the table
+        if ( p->pBins[iBin] == pEntry )
+            p->pBins[iBin] = pPrev;
+        pEntry->pNameSake = NULL;
         return 1;
     }
-    // remove entry from the ring of namesakes
-    assert( pEntry->pNameSake != pEntry );
-    for ( pPrev = pEntry; pPrev->pNameSake != pEntry; pPrev = pPrev->pNameSake );
-    assert( !strcmp(pPrev->Name, pEntry->Name) );
-    assert( pPrev->pNameSake == pEntry );
-    if ( pEntry->pNameSake == pPrev ) // two entries in the ring
-        pPrev->pNameSake = NULL;
-    else
-        pPrev->pNameSake = pEntry->pNameSake;
-    // reinsert the ring back if we removed its connection with the list in the table
-    if ( fRemoved )
+    // remove the last entry with this name from the table
+    assert( p->pBins[iBin] == pEntry );
+    for ( i = iBin, k = (iBin + 1) & Mask; p->pBins[k]; k = (k + 1) & Mask )
     {
-        assert( pPrev->pNextN2I == NULL );
-        pPrev->pNextN2I = *ppSpot;
-        *ppSpot = pPrev;
+        // move the entry back if its home bin is not in the range (i, k]
+        if ( ((k - (int)p->pBins[k]->Key) & Mask) >= ((k - i) & Mask) )
+        {
+            p->pBins[i] = p->pBins[k];
+            i = k;
+        }
     }
+    p->pBins[i] = NULL;
+    p->nNames--;
     return 1;
 }
 
@@ -161,7 +155,9 @@ int Nm_ManTableDelete( Nm_Man_t * p, int ObjId )
 
   Synopsis    [Looks up the entry by ID.]
 
-  Description []
+  Description [The lookups do not modify the manager. They can be called 
+  by several threads at the same time, as long as no thread is adding 
+  or deleting names.]
                
   SideEffects []
 
@@ -170,11 +166,9 @@ int Nm_ManTableDelete( Nm_Man_t * p, int ObjId )
 ***********************************************************************/
 Nm_Entry_t * Nm_ManTableLookupId( Nm_Man_t * p, int ObjId )
 {
-    Nm_Entry_t * pEntry;
-    for ( pEntry = p->pBinsI2N[ Nm_HashNumber(ObjId, p->nBins) ]; pEntry; pEntry = pEntry->pNextI2N )
-        if ( pEntry->ObjId == (unsigned)ObjId )
-            return pEntry;
-    return NULL;
+    if ( ObjId < 0 || ObjId >= Vec_PtrSize(p->vId2Entry) )
+        return NULL;
+    return (Nm_Entry_t *)Vec_PtrEntry( p->vId2Entry, ObjId );
 }
 
 /**Function*************************************************************
@@ -191,22 +185,43 @@ Nm_Entry_t * Nm_ManTableLookupId( Nm_Man_t * p, int ObjId )
 Nm_Entry_t * Nm_ManTableLookupName( Nm_Man_t * p, char * pName, int Type )
 {
     Nm_Entry_t * pEntry, * pTemp;
-    for ( pEntry = p->pBinsN2I[ Nm_HashString(pName, p->nBins) ]; pEntry; pEntry = pEntry->pNextN2I )
-    {
-        // check the entry itself
-        if ( !strcmp(pEntry->Name, pName) && (Type == -1 || pEntry->Type == (unsigned)Type) )
-            return pEntry;
-        // if there is no namesakes, continue
-        if ( pEntry->pNameSake == NULL )
-            continue;
-        // check the list of namesakes
-        for ( pTemp = pEntry->pNameSake; pTemp != pEntry; pTemp = pTemp->pNameSake )
-            if ( !strcmp(pTemp->Name, pName) && (Type == -1 || pTemp->Type == (unsigned)Type) )
-                return pTemp;
-    }
+    pEntry = p->pBins[ Nm_ManTableFindBin(p, pName, Nm_HashString(pName)) ];
+    if ( pEntry == NULL )
+        return NULL;
+    // check the entry itself
+    if ( Type == -1 || pEntry->Type == (unsigned)Type )
+        return pEntry;
+    // if there is no namesakes, quit
+    if ( pEntry->pNameSake == NULL )
+        return NULL;
+    // check the list of namesakes
+    for ( pTemp = pEntry->pNameSake; pTemp != pEntry; pTemp = pTemp->pNameSake )
+        if ( pTemp->Type == (unsigned)Type )
+            return pTemp;
     return NULL;
 }
 
+/**Function*************************************************************
+
+  Synopsis    [Makes sure the tables can hold this many names.]
+
+  Description [Used before adding many names at once, so that the table 
+  is not resized several times in the process.]
+               
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+void Nm_ManTableReserve( Nm_Man_t * p, int nNames )
+{
+    int nBinsNew = p->nBins;
+    while ( 2 * (nNames + 1) > nBinsNew )
+        nBinsNew *= 2;
+    if ( nBinsNew > p->nBins )
+        Nm_ManResize( p, nBinsNew );
+}
+
 /**Function*************************************************************
 
   Synopsis    [Profiles hash tables.]
@@ -220,26 +235,17 @@ Nm_Entry_t * Nm_ManTableLookupName( Nm_Man_t * p, char * pName, int Type )
 ***********************************************************************/
 void Nm_ManProfile( Nm_Man_t * p )
 {
-    Nm_Entry_t * pEntry;
-    int Counter, e;
-    printf( "I2N table: " );
-    for ( e = 0; e < p->nBins; e++ )
-    {
-        Counter = 0;
-        for ( pEntry = p->pBinsI2N[e]; pEntry; pEntry = pEntry->pNextI2N )
-            Counter++;
-        printf( "%d ", Counter );
-    }
-    printf( "\n" );
-    printf( "N2I table: " );
+    int Mask = p->nBins - 1, e, Dist, DistMax = 0, DistTotal = 0;
     for ( e = 0; e < p->nBins; e++ )
     {
-        Counter = 0;
-        for ( pEntry = p->pBinsN2I[e]; pEntry; pEntry = pEntry->pNextN2I )
-            Counter++;
-        printf( "%d ", Counter );
+        if ( p->pBins[e] == NULL )
+            continue;
+        Dist = (e - (int)p->pBins[e]->Key) & Mask;
+        DistMax = Abc_MaxInt( DistMax, Dist );
+        DistTotal += Dist;
     }
-    printf( "\n" );
+    printf( "Names = %d. Entries = %d. Bins = %d. ", p->nNames, p->nEntries, p->nBins );
+    printf( "Probe distance: Ave = %.2f. Max = %d.\n", 1.0 * DistTotal / Abc_MaxInt(1, p->nNames), DistMax );
 }
 
 /**Function*************************************************************
@@ -253,48 +259,27 @@ void Nm_ManProfile( Nm_Man_t * p )
   SeeAlso     []
 
 ***********************************************************************/
-void Nm_ManResize( Nm_Man_t * p )
+void Nm_ManResize( Nm_Man_t * p, int nBinsNew )
 {
-    Nm_Entry_t ** pBinsNewI2N, ** pBinsNewN2I, * pEntry, * pEntry2, ** ppSpot;
-    int nBinsNew, Counter, e;
-    abctime clk;
-
-clk = Abc_Clock();
-    // get the new table size
-    nBinsNew = Abc_PrimeCudd( p->nGrowthFactor * p->nBins ); 
+    Nm_Entry_t ** pBinsNew;
+    int Mask = nBinsNew - 1, Counter = 0, e, i;
+    assert( (nBinsNew & Mask) == 0 );
     // allocate a new array
-    pBinsNewI2N = ABC_ALLOC( Nm_Entry_t *, nBinsNew );
-    pBinsNewN2I = ABC_ALLOC( Nm_Entry_t *, nBinsNew );
-    memset( pBinsNewI2N, 0, sizeof(Nm_Entry_t *) * nBinsNew );
-    memset( pBinsNewN2I, 0, sizeof(Nm_Entry_t *) * nBinsNew );
-    // rehash entries in Id->Name table
-    Counter = 0;
-    for ( e = 0; e < p->nBins; e++ )
-        for ( pEntry = p->pBinsI2N[e], pEntry2 = pEntry? pEntry->pNextI2N : NULL; 
-              pEntry; pEntry = pEntry2, pEntry2 = pEntry? pEntry->pNextI2N : NULL )
-            {
-                ppSpot = pBinsNewI2N + Nm_HashNumber(pEntry->ObjId, nBinsNew);
-                pEntry->pNextI2N = *ppSpot;
-                *ppSpot = pEntry;
-                Counter++;
-            }
-    // rehash entries in Name->Id table
+    pBinsNew = ABC_CALLOC( Nm_Entry_t *, nBinsNew );
+    // rehash entries using the stored keys
     for ( e = 0; e < p->nBins; e++ )
-        for ( pEntry = p->pBinsN2I[e], pEntry2 = pEntry? pEntry->pNextN2I : NULL; 
-              pEntry; pEntry = pEntry2, pEntry2 = pEntry? pEntry->pNextN2I : NULL )
-            {
-                ppSpot = pBinsNewN2I + Nm_HashString(pEntry->Name, nBinsNew);
-                pEntry->pNextN2I = *ppSpot;
-                *ppSpot = pEntry;
-            }
-    assert( Counter == p->nEntries );
-//    printf( "Increasing the structural table size from %6d to %6d. ", p->nBins, nBinsNew );
-//    ABC_PRT( "Time", Abc_Clock() - clk );
+    {
+        if ( p->pBins[e] == NULL )
+            continue;
+        for ( i = (int)(p->pBins[e]->Key & Mask); pBinsNew[i]; i = (i + 1) & Mask );
+        pBinsNew[i] = p->pBins[e];
+        Counter++;
+    }
+    assert( Counter == p->nNames );
+//    printf( "Increasing the name table size from %6d to %6d.\n", p->nBins, nBinsNew );
     // replace the table and the parameters
-    ABC_FREE( p->pBinsI2N );
-    ABC_FREE( p->pBinsN2I );
-    p->pBinsI2N = pBinsNewI2N;
-    p->pBinsN2I = pBinsNewN2I;
+    ABC_FREE( p->pBins );
+    p->pBins = pBinsNew;
     p->nBins = nBinsNew;
 //    Nm_ManProfile( p );
 }
@@ -307,4 +292,3 @@ clk = Abc_Clock();
 
 
 ABC_NAMESPACE_IMPL_END
-
@@ -55,6 +55,8 @@ void Tim_ManCreateBox( Tim_Man_t * p, int firstIn, int nIns, int firstOut, int n
     pBox->nInputs  = nIns;
     pBox->nOutputs = nOuts;
     pBox->fBlack = fBlack;
+    pBox->fDirtyArr = 1;
+    pBox->fDirtyReq = 1;
     for ( i = 0; i < nIns; i++ )
     {
         assert( firstIn+i < p->nCos );
@@ -72,6 +72,8 @@ struct Tim_Box_t_
     int              iDelayTable;    // index of the delay table
     int              iCopy;          // copy of this box
     int              fBlack;         // this is black box
+    int              fDirtyArr;      // input arrival times changed since the last update
+    int              fDirtyReq;      // output required times changed since the last update
     int              Inouts[0];      // the int numbers of PIs and POs
 };
 
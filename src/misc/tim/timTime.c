@@ -44,6 +44,8 @@ ABC_NAMESPACE_IMPL_START
 void Tim_ManInitPiArrival( Tim_Man_t * p, int iPi, float Delay )
 {
     assert( iPi < p->nCis );
+    if ( Tim_ManCiBox(p, iPi) )
+        Tim_ManCiBox(p, iPi)->fDirtyArr = 1;
     p->pCis[iPi].timeArr = Delay;
 }
 
@@ -61,6 +63,8 @@ void Tim_ManInitPiArrival( Tim_Man_t * p, int iPi, float Delay )
 void Tim_ManInitPoRequired( Tim_Man_t * p, int iPo, float Delay )
 {
     assert( iPo < p->nCos );
+    if ( Tim_ManCoBox(p, iPo) )
+        Tim_ManCoBox(p, iPo)->fDirtyReq = 1;
     p->pCos[iPo].timeReq = Delay;
 }
 
@@ -117,6 +121,8 @@ void Tim_ManSetCoArrival( Tim_Man_t * p, int iCo, float Delay )
 {
     assert( iCo < p->nCos );
     assert( !p->fUseTravId || p->pCos[iCo].TravId != p->nTravIds );
+    if ( p->pCos[iCo].timeArr != Delay && Tim_ManCoBox(p, iCo) )
+        Tim_ManCoBox(p, iCo)->fDirtyArr = 1;
     p->pCos[iCo].timeArr = Delay;
     p->pCos[iCo].TravId = p->nTravIds;
 }
@@ -136,6 +142,8 @@ void Tim_ManSetCiRequired( Tim_Man_t * p, int iCi, float Delay )
 {
     assert( iCi < p->nCis );
     assert( !p->fUseTravId || p->pCis[iCi].TravId != p->nTravIds );
+    if ( p->pCis[iCi].timeReq != Delay && Tim_ManCiBox(p, iCi) )
+        Tim_ManCiBox(p, iCi)->fDirtyReq = 1;
     p->pCis[iCi].timeReq = Delay;
     p->pCis[iCi].TravId = p->nTravIds;
 }
@@ -155,6 +163,9 @@ void Tim_ManSetCoRequired( Tim_Man_t * p, int iCo, float Delay )
 {
     assert( iCo < p->nCos );
     assert( !p->fUseTravId || !p->nTravIds || p->pCos[iCo].TravId != p->nTravIds );
+    // the box input is overwritten, so the box has to be recomputed
+    if ( Tim_ManCoBox(p, iCo) )
+        Tim_ManCoBox(p, iCo)->fDirtyReq = 1;
     p->pCos[iCo].timeReq = Delay;
     p->pCos[iCo].TravId = p->nTravIds;
 }
@@ -164,7 +175,9 @@ void Tim_ManSetCoRequired( Tim_Man_t * p, int iCo, float Delay )
 
   Synopsis    [Returns CO arrival time.]
 
-  Description []
+  Description [If the arrival times of the box inputs did not change 
+  since the box was last updated, the arrival times of the box outputs 
+  are reused without recomputing them.]
                
   SideEffects []
 
@@ -193,6 +206,14 @@ float Tim_ManGetCiArrival( Tim_Man_t * p, int iCi )
     Tim_ManBoxForEachInput( p, pBox, pObj, i )
         if ( pObj->TravId != p->nTravIds )
             printf( "Tim_ManGetCiArrival(): Input arrival times of the box are not up to date!\n" );
+    // reuse the arrival times of the outputs if the inputs did not change
+    if ( !pBox->fDirtyArr )
+    {
+        Tim_ManBoxForEachOutput( p, pBox, pObjRes, i )
+            pObjRes->TravId = p->nTravIds;
+        return pObjThis->timeArr;
+    }
+    pBox->fDirtyArr = 0;
     // compute the arrival times for each output of the box (PIs)
     pTable = Tim_ManBoxDelayTable( p, pBox->iBox );
     Tim_ManBoxForEachOutput( p, pBox, pObjRes, i )
@@ -212,7 +233,9 @@ float Tim_ManGetCiArrival( Tim_Man_t * p, int iCi )
 
   Synopsis    [Returns CO required time.]
 
-  Description []
+  Description [If the required times of the box outputs did not change 
+  since the box was last updated, the required times of the box inputs 
+  are reused without recomputing them.]
                
   SideEffects []
 
@@ -241,6 +264,14 @@ float Tim_ManGetCoRequired( Tim_Man_t * p, int iCo )
     Tim_ManBoxForEachOutput( p, pBox, pObj, i )
         if ( pObj->TravId != p->nTravIds )
             printf( "Tim_ManGetCoRequired(): Output required times of output %d the box %d are not up to date!\n", i, pBox->iBox );
+    // reuse the required times of the inputs if the outputs did not change
+    if ( !pBox->fDirtyReq )
+    {
+        Tim_ManBoxForEachInput( p, pBox, pObjRes, i )
+            pObjRes->TravId = p->nTravIds;
+        return pObjThis->timeReq;
+    }
+    pBox->fDirtyReq = 0;
     // compute the required times for each input of the box (POs)
     pTable = Tim_ManBoxDelayTable( p, pBox->iBox );
     Tim_ManBoxForEachInput( p, pBox, pObjRes, i )
@@ -364,6 +364,20 @@ static inline abctime Abc_ThreadClock()
     return (abctime) clock();
 #endif
 }
+// counting wall time (clock() is the wall time on Windows)
+static inline abctime Abc_WallClock()
+{
+#if defined(_WIN32)
+    return (abctime) clock();
+#else
+    struct timespec ts;
+    if ( clock_gettime(CLOCK_MONOTONIC, &ts) < 0 ) 
+        return (abctime)-1;
+    abctime res = ((abctime) ts.tv_sec) * CLOCKS_PER_SEC;
+    res += (((abctime) ts.tv_nsec) * CLOCKS_PER_SEC) / 1000000000;
+    return res;
+#endif
+}
 
 // misc printing procedures
 enum Abc_VerbLevel
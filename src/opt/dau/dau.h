@@ -60,6 +60,7 @@ typedef enum {
 
 typedef struct Dss_Man_t_ Dss_Man_t;
 typedef struct Abc_TtHieMan_t_ Abc_TtHieMan_t;
+typedef struct Abc_TtCanMan_t_ Abc_TtCanMan_t;
 typedef unsigned(*TtCanonicizeFunc)(Abc_TtHieMan_t * p, word * pTruth, int nVars, char * pCanonPerm, int flag);
 
 ////////////////////////////////////////////////////////////////////////
@@ -87,6 +88,10 @@ extern void          Abc_TtHieManStop(Abc_TtHieMan_t * p );
 extern unsigned      Abc_TtCanonicizeWrap(TtCanonicizeFunc func, Abc_TtHieMan_t * p, word * pTruth, int nVars, char * pCanonPerm, int flag);
 extern unsigned      Abc_TtCanonicizeAda(Abc_TtHieMan_t * p, word * pTruth, int nVars, char * pCanonPerm, int iThres);
 extern unsigned      Abc_TtCanonicizeHie(Abc_TtHieMan_t * p, word * pTruthInit, int nVars, char * pCanonPerm, int fExact);
+extern Abc_TtCanMan_t * Abc_TtCanManStart( int nVars, int fPerm, int nProcs );
+extern void          Abc_TtCanManStop( Abc_TtCanMan_t * p );
+extern void          Abc_TtCanManPrintStats( Abc_TtCanMan_t * p );
+extern int           Abc_TtCanonicizeBatch( Abc_TtCanMan_t * p, word ** pFuncs, int nFuncs, unsigned * pPhases, char * pPerms );
 /*=== dauCount.c ==========================================================*/
 extern int           Abc_TtCountOnesInCofsQuick( word * pTruth, int nVars, int * pStore );
 /*=== dauDsd.c  ==========================================================*/
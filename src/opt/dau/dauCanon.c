@@ -24,12 +24,44 @@
 #include "bool/lucky/lucky.h"
 #include <math.h>
 
+#ifdef ABC_USE_PTHREADS
+
+#ifdef _WIN32
+#include "../lib/pthread.h"
+#else
+#include <pthread.h>
+#include <sched.h>
+#include <unistd.h>
+#endif
+
+#endif
+
 ABC_NAMESPACE_IMPL_START
 
 ////////////////////////////////////////////////////////////////////////
 ///                        DECLARATIONS                              ///
 ////////////////////////////////////////////////////////////////////////
 
+#define ABC_TT_CAN_THR_MAX   100   // the max number of threads
+#define ABC_TT_CAN_PAR_MIN  1000   // the min number of new functions to use threads
+
+// batch canonization manager
+struct Abc_TtCanMan_t_
+{
+    int                nVars;      // the number of variables
+    int                nWords;     // the number of words in the truth table
+    int                fPerm;      // uses permutation-only canonization
+    int                nProcs;     // the number of threads
+    Vec_Mem_t *        vTtMem;     // the functions canonicized so far
+    Vec_Wrd_t *        vCanons;    // their canonical forms (nWords entries each)
+    Vec_Int_t *        vPhases;    // their phases
+    Vec_Str_t *        vPerms;     // their permutations (nVars entries each)
+    Vec_Int_t *        vNew;       // the functions to be canonicized in this batch
+    // statistics
+    int                nFuncs;     // the number of functions in all batches
+    int                nCanons;    // the number of functions canonicized
+};
+
 static word s_CMasks6[5] = {
     ABC_CONST(0x1111111111111111),
     ABC_CONST(0x0303030303030303),
@@ -796,7 +828,7 @@ int Abc_TtCofactorPermNaive( word * pTruth, int i, int nWords, int fSwapOnly )
 {
     if ( fSwapOnly )
     {
-        static word pCopy[1024];
+        word pCopy[1024];
         Abc_TtCopy( pCopy, pTruth, nWords, 0 );
         Abc_TtSwapAdjacent( pCopy, nWords, i );
         if ( Abc_TtCompareRev(pTruth, pCopy, nWords) == 1 )
@@ -807,8 +839,8 @@ int Abc_TtCofactorPermNaive( word * pTruth, int i, int nWords, int fSwapOnly )
         return 0;
     }
     {
-        static word pCopy[1024];
-        static word pBest[1024];
+        word pCopy[1024];
+        word pBest[1024];
         int Config = 0;
         // save two copies
         Abc_TtCopy( pCopy, pTruth, nWords, 0 );
@@ -987,7 +1019,7 @@ int Abc_TtCofactorPerm( word * pTruth, int i, int nWords, int fSwapOnly, char *
         return Config;
     }
     {
-        static word pCopy1[1024];
+        word pCopy1[1024];
         int Config;
         Abc_TtCopy( pCopy1, pTruth, nWords, 0 );
         Config = Abc_TtCofactorPermConfig( pTruth, i, nWords, 0, fNaive );
@@ -2688,6 +2720,192 @@ unsigned Abc_TtCanonicizeCA(Abc_TtHieMan_t * p, word * pTruth, int nVars, char *
 }
 
 
+/**Function*************************************************************
+
+  Synopsis    [Batch canonization with a cache of canonical forms.]
+
+  Description [The manager remembers the functions canonicized so far
+  together with their canonical forms, phases and permutations. Each batch 
+  is deduplicated against this cache, so a function is canonicized only 
+  the first time it is seen. The new functions of a batch are independent 
+  and are split among several threads.]
+               
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+Abc_TtCanMan_t * Abc_TtCanManStart( int nVars, int fPerm, int nProcs )
+{
+    Abc_TtCanMan_t * p = ABC_CALLOC( Abc_TtCanMan_t, 1 );
+    assert( nVars <= 16 );
+    p->nVars   = nVars;
+    p->nWords  = Abc_TtWordNum( nVars );
+    p->fPerm   = fPerm;
+    p->nProcs  = nProcs;
+    p->vTtMem  = Vec_MemAlloc( p->nWords, 12 );
+    Vec_MemHashAlloc( p->vTtMem, 10000 );
+    p->vCanons = Vec_WrdAlloc( 1000 );
+    p->vPhases = Vec_IntAlloc( 1000 );
+    p->vPerms  = Vec_StrAlloc( 1000 );
+    p->vNew    = Vec_IntAlloc( 1000 );
+    return p;
+}
+void Abc_TtCanManStop( Abc_TtCanMan_t * p )
+{
+    Vec_MemHashFree( p->vTtMem );
+    Vec_MemFree( p->vTtMem );
+    Vec_WrdFree( p->vCanons );
+    Vec_IntFree( p->vPhases );
+    Vec_StrFree( p->vPerms );
+    Vec_IntFree( p->vNew );
+    ABC_FREE( p );
+}
+void Abc_TtCanManPrintStats( Abc_TtCanMan_t * p )
+{
+    printf( "Batch canonization: Functions = %d.  Unique = %d (%.2f %%).  Cached = %d.\n", 
+        p->nFuncs, p->nCanons, 100.0 * p->nCanons / Abc_MaxInt(p->nFuncs, 1), Vec_MemEntryNum(p->vTtMem) );
+}
+static void Abc_TtCanManCompute( Abc_TtCanMan_t * p, int iBeg, int iEnd )
+{
+    int i, iFunc;
+    for ( i = iBeg; i < iEnd; i++ )
+    {
+        iFunc = Vec_IntEntry( p->vNew, i );
+        if ( p->fPerm )
+            Vec_IntWriteEntry( p->vPhases, iFunc, Abc_TtCanonicizePerm(Vec_WrdEntryP(p->vCanons, iFunc * p->nWords), p->nVars, Vec_StrEntryP(p->vPerms, iFunc * p->nVars)) );
+        else
+            Vec_IntWriteEntry( p->vPhases, iFunc, Abc_TtCanonicize(Vec_WrdEntryP(p->vCanons, iFunc * p->nWords), p->nVars, Vec_StrEntryP(p->vPerms, iFunc * p->nVars)) );
+    }
+}
+
+#ifndef ABC_USE_PTHREADS
+
+static void Abc_TtCanManComputeAll( Abc_TtCanMan_t * p )
+{
+    Abc_TtCanManCompute( p, 0, Vec_IntSize(p->vNew) );
+}
+
+#else // pthreads are used
+
+typedef struct Abc_TtCanThData_t_
+{
+    Abc_TtCanMan_t * p;
+    int              iBeg;
+    int              iEnd;
+    int              fWorking;
+} Abc_TtCanThData_t;
+
+static void * Abc_TtCanWorkerThread( void * pArg )
+{
+    Abc_TtCanThData_t * pThData = (Abc_TtCanThData_t *)pArg;
+    volatile int * pPlace = &pThData->fWorking;
+    while ( 1 )
+    {
+        while ( *pPlace == 0 )
+            sched_yield();
+        assert( pThData->fWorking );
+        if ( pThData->p == NULL )
+        {
+            pthread_exit( NULL );
+            assert( 0 );
+            return NULL;
+        }
+        Abc_TtCanManCompute( pThData->p, pThData->iBeg, pThData->iEnd );
+        pThData->fWorking = 0;
+    }
+    assert( 0 );
+    return NULL;
+}
+static void Abc_TtCanManComputeAll( Abc_TtCanMan_t * p )
+{
+    Abc_TtCanThData_t ThData[ABC_TT_CAN_THR_MAX];
+    pthread_t WorkerThread[ABC_TT_CAN_THR_MAX];
+    int i, status, nNew = Vec_IntSize(p->vNew);
+    int nProcs = Abc_MinInt( p->nProcs, ABC_TT_CAN_THR_MAX );
+    if ( nProcs <= 1 || nNew < ABC_TT_CAN_PAR_MIN )
+    {
+        Abc_TtCanManCompute( p, 0, nNew );
+        return;
+    }
+    // each thread takes a contiguous range of new functions
+    for ( i = 0; i < nProcs; i++ )
+    {
+        ThData[i].p        = p;
+        ThData[i].iBeg     = (int)((long)nNew * i / nProcs);
+        ThData[i].iEnd     = (int)((long)nNew * (i+1) / nProcs);
+        ThData[i].fWorking = 1;
+        status = pthread_create( WorkerThread + i, NULL, Abc_TtCanWorkerThread, (void *)(ThData + i) );  assert( status == 0 );
+    }
+    // wait till threads finish
+    for ( i = 0; i < nProcs; i++ )
+        while ( ((volatile int *)&ThData[i].fWorking)[0] )
+            sched_yield();
+    // stop threads
+    for ( i = 0; i < nProcs; i++ )
+    {
+        ThData[i].p = NULL;
+        ThData[i].fWorking = 1;
+    }
+    for ( i = 0; i < nProcs; i++ )
+        pthread_join( WorkerThread[i], NULL );
+}
+
+#endif // pthreads are used
+
+/**Function*************************************************************
+
+  Synopsis    [Canonicizes a batch of functions in place.]
+
+  Description [If pPhases/pPerms are not NULL, returns the phase of each
+  function and its permutation (nVars entries per function). Returns the 
+  number of functions that were actually canonicized (the other ones were 
+  found in the cache). The result is the same as calling Abc_TtCanonicize 
+  (or Abc_TtCanonicizePerm) for each function.]
+               
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+int Abc_TtCanonicizeBatch( Abc_TtCanMan_t * p, word ** pFuncs, int nFuncs, unsigned * pPhases, char * pPerms )
+{
+    int i, iFunc, nOld = Vec_MemEntryNum( p->vTtMem );
+    // deduplicate the batch against the cache
+    Vec_IntClear( p->vNew );
+    for ( i = 0; i < nFuncs; i++ )
+    {
+        iFunc = Vec_MemHashInsert( p->vTtMem, pFuncs[i] );
+        if ( iFunc < nOld + Vec_IntSize(p->vNew) )
+            continue;
+        assert( iFunc == nOld + Vec_IntSize(p->vNew) );
+        Vec_IntPush( p->vNew, iFunc );
+    }
+    // allocate space for the new entries and copy the functions
+    Vec_WrdFillExtra( p->vCanons, p->nWords * Vec_MemEntryNum(p->vTtMem), 0 );
+    Vec_IntFillExtra( p->vPhases, Vec_MemEntryNum(p->vTtMem), 0 );
+    Vec_StrFillExtra( p->vPerms, p->nVars * Vec_MemEntryNum(p->vTtMem), 0 );
+    Vec_IntForEachEntry( p->vNew, iFunc, i )
+        Abc_TtCopy( Vec_WrdEntryP(p->vCanons, iFunc * p->nWords), Vec_MemReadEntry(p->vTtMem, iFunc), p->nWords, 0 );
+    // canonicize the new functions
+    Abc_TtCanManComputeAll( p );
+    // write the results
+    for ( i = 0; i < nFuncs; i++ )
+    {
+        iFunc = *Vec_MemHashLookup( p->vTtMem, pFuncs[i] );
+        assert( iFunc >= 0 );
+        if ( pPhases )
+            pPhases[i] = (unsigned)Vec_IntEntry( p->vPhases, iFunc );
+        if ( pPerms )
+            memcpy( pPerms + i * p->nVars, Vec_StrEntryP(p->vPerms, iFunc * p->nVars), sizeof(char) * p->nVars );
+        Abc_TtCopy( pFuncs[i], Vec_WrdEntryP(p->vCanons, iFunc * p->nWords), p->nWords, 0 );
+    }
+    p->nFuncs  += nFuncs;
+    p->nCanons += Vec_IntSize(p->vNew);
+    return Vec_IntSize(p->vNew);
+}
+
+
 ////////////////////////////////////////////////////////////////////////
 ///                       END OF FILE                                ///
 ////////////////////////////////////////////////////////////////////////
@@ -27,7 +27,7 @@ ABC_NAMESPACE_IMPL_START
 ///                        DECLARATIONS                              ///
 ////////////////////////////////////////////////////////////////////////
 
-static Abc_Ntk_t * Abc_NtkRetimeMinAreaOne( Abc_Ntk_t * pNtk, int fForward, int fUseOldNames, int fVerbose );
+static Abc_Ntk_t * Abc_NtkRetimeMinAreaOne( Abc_Ntk_t * pNtk, int fForward, int fUseOldNames, int fUsePush, int fVerbose );
 static void        Abc_NtkRetimeMinAreaPrepare( Abc_Ntk_t * pNtk, int fForward );
 static void        Abc_NtkRetimeMinAreaInitValues( Abc_Ntk_t * pNtk, Vec_Ptr_t * vMinCut );
 static Abc_Ntk_t * Abc_NtkRetimeMinAreaConstructNtk( Abc_Ntk_t * pNtk, Vec_Ptr_t * vMinCut );
@@ -50,7 +50,7 @@ extern Abc_Ntk_t * Abc_NtkAttachBottom( Abc_Ntk_t * pNtkTop, Abc_Ntk_t * pNtkBot
   SeeAlso     []
 
 ***********************************************************************/
-int Abc_NtkRetimeMinArea( Abc_Ntk_t * pNtk, int fForwardOnly, int fBackwardOnly, int fUseOldNames, int fVerbose )
+int Abc_NtkRetimeMinArea( Abc_Ntk_t * pNtk, int fForwardOnly, int fBackwardOnly, int fUseOldNames, int fUsePush, int fVerbose )
 {
     Abc_Ntk_t * pNtkTotal = NULL, * pNtkBottom;
     Vec_Int_t * vValuesNew = NULL, * vValues;
@@ -66,9 +66,9 @@ int Abc_NtkRetimeMinArea( Abc_Ntk_t * pNtk, int fForwardOnly, int fBackwardOnly,
     if ( !fBackwardOnly )
     {
         if ( fOneFrame )
-            Abc_NtkRetimeMinAreaOne( pNtk, 1, fUseOldNames, fVerbose );
+            Abc_NtkRetimeMinAreaOne( pNtk, 1, fUseOldNames, fUsePush, fVerbose );
         else
-            while ( Abc_NtkRetimeMinAreaOne( pNtk, 1, fUseOldNames, fVerbose ) );
+            while ( Abc_NtkRetimeMinAreaOne( pNtk, 1, fUseOldNames, fUsePush, fVerbose ) );
     }
     // remember initial values
     vValues = Abc_NtkCollectLatchValues( pNtk );
@@ -76,9 +76,9 @@ int Abc_NtkRetimeMinArea( Abc_Ntk_t * pNtk, int fForwardOnly, int fBackwardOnly,
     if ( !fForwardOnly )
     {
         if ( fOneFrame )
-            pNtkTotal = Abc_NtkRetimeMinAreaOne( pNtk, 0, fUseOldNames, fVerbose );
+            pNtkTotal = Abc_NtkRetimeMinAreaOne( pNtk, 0, fUseOldNames, fUsePush, fVerbose );
         else
-            while ( (pNtkBottom = Abc_NtkRetimeMinAreaOne( pNtk, 0, fUseOldNames, fVerbose )) )
+            while ( (pNtkBottom = Abc_NtkRetimeMinAreaOne( pNtk, 0, fUseOldNames, fUsePush, fVerbose )) )
                 pNtkTotal = Abc_NtkAttachBottom( pNtkTotal, pNtkBottom );  
     }
     // compute initial values
@@ -108,14 +108,14 @@ int Abc_NtkRetimeMinArea( Abc_Ntk_t * pNtk, int fForwardOnly, int fBackwardOnly,
   SeeAlso     []
 
 ***********************************************************************/
-Abc_Ntk_t * Abc_NtkRetimeMinAreaOne( Abc_Ntk_t * pNtk, int fForward, int fUseOldNames, int fVerbose )
+Abc_Ntk_t * Abc_NtkRetimeMinAreaOne( Abc_Ntk_t * pNtk, int fForward, int fUseOldNames, int fUsePush, int fVerbose )
 { 
     Abc_Ntk_t * pNtkNew = NULL;
     Vec_Ptr_t * vMinCut;
     // mark current latches and TFI(POs)
     Abc_NtkRetimeMinAreaPrepare( pNtk, fForward );
     // run the maximum forward flow
-    vMinCut = Abc_NtkMaxFlow( pNtk, fForward, fVerbose );
+    vMinCut = Abc_NtkMaxFlow( pNtk, fForward, fUsePush, fVerbose );
 //    assert( Vec_PtrSize(vMinCut) <= Abc_NtkLatchNum(pNtk) );
     // create new latch boundary if there is improvement
     if ( Vec_PtrSize(vMinCut) < Abc_NtkLatchNum(pNtk) )
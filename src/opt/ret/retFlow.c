@@ -113,7 +113,7 @@ void Abc_NtkMaxFlowTest( Abc_Ntk_t * pNtk )
     Abc_NtkForEachLatch( pNtk, pObj, i )
         pObj->fMarkA = Abc_ObjFanin0(pObj)->fMarkA = 1;
 //        Abc_ObjFanin0(pObj)->fMarkA = 1;
-    vMinCut = Abc_NtkMaxFlow( pNtk, 1, 1 );
+    vMinCut = Abc_NtkMaxFlow( pNtk, 1, 0, 1 );
     Vec_PtrFree( vMinCut );
     Abc_NtkCleanMarkA( pNtk );
 
@@ -123,7 +123,7 @@ void Abc_NtkMaxFlowTest( Abc_Ntk_t * pNtk )
     Abc_NtkForEachLatch( pNtk, pObj, i )
         pObj->fMarkA = Abc_ObjFanout0(pObj)->fMarkA = 1;
 //        Abc_ObjFanout0(pObj)->fMarkA = 1;
-    vMinCut = Abc_NtkMaxFlow( pNtk, 0, 1 );
+    vMinCut = Abc_NtkMaxFlow( pNtk, 0, 0, 1 );
     Vec_PtrFree( vMinCut );
     Abc_NtkCleanMarkA( pNtk );
 
@@ -133,14 +133,15 @@ void Abc_NtkMaxFlowTest( Abc_Ntk_t * pNtk )
 
   Synopsis    [Implementation of max-flow/min-cut computation.]
 
-  Description []
+  Description [If fUsePush is set, uses push-relabel (retPush.c) 
+  instead of augmenting paths.]
                
   SideEffects []
 
   SeeAlso     []
 
 ***********************************************************************/
-Vec_Ptr_t * Abc_NtkMaxFlow( Abc_Ntk_t * pNtk, int fForward, int fVerbose )
+Vec_Ptr_t * Abc_NtkMaxFlow( Abc_Ntk_t * pNtk, int fForward, int fUsePush, int fVerbose )
 {
     Vec_Ptr_t * vMinCut;
     Abc_Obj_t * pLatch;
@@ -148,6 +149,12 @@ Vec_Ptr_t * Abc_NtkMaxFlow( Abc_Ntk_t * pNtk, int fForward, int fVerbose )
     abctime clk = Abc_Clock();
     int fUseDirectedFlow = 1;
 
+    if ( fUsePush )
+    {
+        vMinCut = Abc_NtkMaxFlowPush( pNtk, fForward, &Flow );
+        goto finish;
+    }
+
     // find the max-flow
     Abc_NtkCleanCopy( pNtk );
     Flow = 0;
@@ -220,6 +227,7 @@ Vec_Ptr_t * Abc_NtkMaxFlow( Abc_Ntk_t * pNtk, int fForward, int fVerbose )
 
     // find the min-cut with the smallest volume
     vMinCut = Abc_NtkMaxFlowMinCut( pNtk, fForward );
+finish:
     // verify the cut
     if ( !Abc_NtkMaxFlowVerifyCut(pNtk, vMinCut, fForward) )
         printf( "Abc_NtkMaxFlow() error! The computed min-cut is not a cut!\n" );
@@ -0,0 +1,375 @@
+/**CFile****************************************************************
+
+  FileName    [retPush.c]
+
+  SystemName  [ABC: Logic synthesis and verification system.]
+
+  PackageName [Retiming package.]
+
+  Synopsis    [Push-relabel maximum flow (min-area retiming).]
+
+  Author      [ABC contributors]
+
+  Affiliation [UC Berkeley]
+
+  Date        [Ver. 1.0. Started - October 18, 2026.]
+
+  Revision    [$Id: retPush.c,v 1.00 2026/10/18 00:00:00 agent Exp $]
+
+***********************************************************************/
+
+#include "retInt.h"
+
+ABC_NAMESPACE_IMPL_START
+
+
+////////////////////////////////////////////////////////////////////////
+///                        DECLARATIONS                              ///
+////////////////////////////////////////////////////////////////////////
+
+// flow network in the compressed sparse row format
+typedef struct Ret_Flow_t_ Ret_Flow_t;
+struct Ret_Flow_t_
+{
+    int             nNodes;    // the number of vertices
+    int             iSource;   // the source vertex
+    int             iSink;     // the sink vertex
+    int *           pBeg;      // the first arc of each vertex (nNodes + 1)
+    int *           pHead;     // the head of each arc
+    int *           pRev;      // the reverse arc of each arc
+    int *           pCap;      // the residual capacity of each arc
+    int *           pExcess;   // the excess of each vertex
+    int *           pLabel;    // the distance label of each vertex
+    int *           pCur;      // the current arc of each vertex
+    Vec_Int_t *     vQueue;    // the queue of active vertices
+    char *          pActive;   // the vertices in the queue
+    int             nRelabels; // relabels since the last global relabeling
+    int             nGlobals;  // the number of global relabelings
+};
+
+// each object is split into the input vertex and the output vertex
+static inline int Ret_FlowIn( int Id )  { return 2 * Id;     }
+static inline int Ret_FlowOut( int Id ) { return 2 * Id + 1; }
+
+////////////////////////////////////////////////////////////////////////
+///                     FUNCTION DEFINITIONS                         ///
+////////////////////////////////////////////////////////////////////////
+
+/**Function*************************************************************
+
+  Synopsis    [Adds one edge to the edge list.]
+
+  Description []
+
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+static inline void Ret_FlowAddEdge( Vec_Int_t * vEdges, int iFrom, int iTo, int Cap )
+{
+    Vec_IntPush( vEdges, iFrom );
+    Vec_IntPush( vEdges, iTo );
+    Vec_IntPush( vEdges, Cap );
+}
+
+/**Function*************************************************************
+
+  Synopsis    [Derives the flow network for min-area retiming.]
+
+  Description [Each object with ID i is represented by the input vertex
+  2*i and the output vertex 2*i+1 connected by an arc with unit capacity.
+  The other arcs have capacity larger than the number of latches, so they
+  never belong to a min-cut. The network is constructed reversed: the flow
+  goes from the terminals (marked with fMarkA) to the latches. This way
+  the min-cut closest to the latches can be read from the vertices that
+  can reach the sink after the first phase of push-relabel.]
+
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+static Ret_Flow_t * Ret_FlowStart( Abc_Ntk_t * pNtk, int fForward )
+{
+    Ret_Flow_t * p;
+    Vec_Int_t * vEdges;
+    Abc_Obj_t * pObj, * pNext;
+    int i, k, iFrom, iTo, Cap, nArcs, Inf = Abc_NtkLatchNum(pNtk) + 1;
+    int iSource = 2 * Abc_NtkObjNumMax(pNtk);
+    int iSink   = iSource + 1;
+    // collect the edges of the original network
+    vEdges = Vec_IntAlloc( 6 * Abc_NtkObjNumMax(pNtk) );
+    Abc_NtkForEachObj( pNtk, pObj, i )
+    {
+        Ret_FlowAddEdge( vEdges, Ret_FlowIn(i), Ret_FlowOut(i), 1 );
+        if ( pObj->fMarkA )
+            Ret_FlowAddEdge( vEdges, Ret_FlowOut(i), iSink, Inf );
+        else if ( fForward )
+        {
+            Abc_ObjForEachFanout( pObj, pNext, k )
+                Ret_FlowAddEdge( vEdges, Ret_FlowOut(i), Ret_FlowIn(pNext->Id), Inf );
+        }
+        else
+        {
+            Abc_ObjForEachFanin( pObj, pNext, k )
+                Ret_FlowAddEdge( vEdges, Ret_FlowOut(i), Ret_FlowIn(pNext->Id), Inf );
+        }
+    }
+    Abc_NtkForEachLatch( pNtk, pObj, i )
+    {
+        pNext = fForward ? Abc_ObjFanout0(pObj) : Abc_ObjFanin0(pObj);
+        Ret_FlowAddEdge( vEdges, iSource, Ret_FlowIn(pNext->Id), Inf );
+    }
+    // create the reversed network in the CSR format
+    p = ABC_CALLOC( Ret_Flow_t, 1 );
+    p->nNodes  = iSink + 1;
+    p->iSource = iSink;
+    p->iSink   = iSource;
+    nArcs      = 2 * Vec_IntSize(vEdges) / 3;
+    p->pBeg    = ABC_CALLOC( int, p->nNodes + 1 );
+    p->pHead   = ABC_ALLOC( int, nArcs );
+    p->pRev    = ABC_ALLOC( int, nArcs );
+    p->pCap    = ABC_ALLOC( int, nArcs );
+    p->pExcess = ABC_CALLOC( int, p->nNodes );
+    p->pLabel  = ABC_CALLOC( int, p->nNodes );
+    p->pCur    = ABC_ALLOC( int, p->nNodes );
+    p->pActive = ABC_CALLOC( char, p->nNodes );
+    p->vQueue  = Vec_IntAlloc( 1000 );
+    for ( i = 0; i < Vec_IntSize(vEdges); i += 3 )
+    {
+        p->pBeg[Vec_IntEntry(vEdges, i)+1]++;
+        p->pBeg[Vec_IntEntry(vEdges, i+1)+1]++;
+    }
+    for ( i = 0; i < p->nNodes; i++ )
+        p->pBeg[i+1] += p->pBeg[i];
+    assert( p->pBeg[p->nNodes] == nArcs );
+    memcpy( p->pCur, p->pBeg, sizeof(int) * p->nNodes );
+    for ( i = 0; i < Vec_IntSize(vEdges); i += 3 )
+    {
+        iTo   = Vec_IntEntry( vEdges, i );    // reversed
+        iFrom = Vec_IntEntry( vEdges, i+1 );  // reversed
+        Cap   = Vec_IntEntry( vEdges, i+2 );
+        p->pHead[p->pCur[iFrom]] = iTo;
+        p->pCap[p->pCur[iFrom]]  = Cap;
+        p->pRev[p->pCur[iFrom]]  = p->pCur[iTo];
+        p->pHead[p->pCur[iTo]]   = iFrom;
+        p->pCap[p->pCur[iTo]]    = 0;
+        p->pRev[p->pCur[iTo]]    = p->pCur[iFrom];
+        p->pCur[iFrom]++;
+        p->pCur[iTo]++;
+    }
+    Vec_IntFree( vEdges );
+    return p;
+}
+static void Ret_FlowStop( Ret_Flow_t * p )
+{
+    Vec_IntFree( p->vQueue );
+    ABC_FREE( p->pBeg );
+    ABC_FREE( p->pHead );
+    ABC_FREE( p->pRev );
+    ABC_FREE( p->pCap );
+    ABC_FREE( p->pExcess );
+    ABC_FREE( p->pLabel );
+    ABC_FREE( p->pCur );
+    ABC_FREE( p->pActive );
+    ABC_FREE( p );
+}
+
+/**Function*************************************************************
+
+  Synopsis    [Makes the vertex active.]
+
+  Description []
+
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+static inline void Ret_FlowActivate( Ret_Flow_t * p, int v )
+{
+    if ( p->pActive[v] || v == p->iSource || v == p->iSink || p->pLabel[v] >= p->nNodes )
+        return;
+    p->pActive[v] = 1;
+    Vec_IntPush( p->vQueue, v );
+}
+
+/**Function*************************************************************
+
+  Synopsis    [Computes exact distance labels by BFS from the sink.]
+
+  Description [Vertices that cannot reach the sink get label nNodes.
+  Returns the number of vertices that can reach the sink.]
+
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+static int Ret_FlowGlobalRelabel( Ret_Flow_t * p, Vec_Int_t * vBfs )
+{
+    int i, a, v, w;
+    for ( v = 0; v < p->nNodes; v++ )
+        p->pLabel[v] = p->nNodes;
+    p->pLabel[p->iSink] = 0;
+    Vec_IntFill( vBfs, 1, p->iSink );
+    Vec_IntForEachEntry( vBfs, v, i )
+        for ( a = p->pBeg[v]; a < p->pBeg[v+1]; a++ )
+        {
+            w = p->pHead[a];
+            if ( p->pLabel[w] < p->nNodes || p->pCap[p->pRev[a]] == 0 || w == p->iSource )
+                continue;
+            p->pLabel[w] = p->pLabel[v] + 1;
+            Vec_IntPush( vBfs, w );
+        }
+    p->pLabel[p->iSource] = p->nNodes;
+    memcpy( p->pCur, p->pBeg, sizeof(int) * p->nNodes );
+    // restart the queue
+    Vec_IntForEachEntry( p->vQueue, v, i )
+        p->pActive[v] = 0;
+    Vec_IntClear( p->vQueue );
+    for ( v = 0; v < p->nNodes; v++ )
+        if ( p->pExcess[v] > 0 )
+            Ret_FlowActivate( p, v );
+    p->nRelabels = 0;
+    p->nGlobals++;
+    return Vec_IntSize(vBfs);
+}
+
+/**Function*************************************************************
+
+  Synopsis    [Discharges the active vertex.]
+
+  Description []
+
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+static void Ret_FlowDischarge( Ret_Flow_t * p, int v )
+{
+    int a, w, Delta, LabelMin;
+    while ( p->pExcess[v] > 0 )
+    {
+        if ( p->pCur[v] == p->pBeg[v+1] )
+        {
+            // relabel
+            LabelMin = p->nNodes;
+            for ( a = p->pBeg[v]; a < p->pBeg[v+1]; a++ )
+                if ( p->pCap[a] > 0 )
+                    LabelMin = Abc_MinInt( LabelMin, p->pLabel[p->pHead[a]] + 1 );
+            p->pLabel[v] = Abc_MinInt( LabelMin, p->nNodes );
+            p->pCur[v] = p->pBeg[v];
+            p->nRelabels++;
+            if ( p->pLabel[v] >= p->nNodes )
+                return;
+            continue;
+        }
+        a = p->pCur[v];
+        w = p->pHead[a];
+        if ( p->pCap[a] > 0 && p->pLabel[v] == p->pLabel[w] + 1 )
+        {
+            // push
+            Delta = Abc_MinInt( p->pExcess[v], p->pCap[a] );
+            p->pCap[a]          -= Delta;
+            p->pCap[p->pRev[a]] += Delta;
+            p->pExcess[v]       -= Delta;
+            p->pExcess[w]       += Delta;
+            Ret_FlowActivate( p, w );
+            if ( p->pCap[a] > 0 )
+                continue;
+        }
+        p->pCur[v]++;
+    }
+}
+
+/**Function*************************************************************
+
+  Synopsis    [Computes the maximum preflow.]
+
+  Description [This is the first phase of the push-relabel algorithm
+  with FIFO selection and periodic global relabeling. Returns the value
+  of the max-flow. Vector vBfs contains the vertices that can reach
+  the sink.]
+
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+static int Ret_FlowMaxPreflow( Ret_Flow_t * p, Vec_Int_t * vBfs )
+{
+    int a, v, iHead = 0;
+    // saturate the arcs leaving the source
+    for ( a = p->pBeg[p->iSource]; a < p->pBeg[p->iSource+1]; a++ )
+    {
+        p->pExcess[p->pHead[a]] += p->pCap[a];
+        p->pCap[p->pRev[a]]     += p->pCap[a];
+        p->pCap[a]               = 0;
+    }
+    Ret_FlowGlobalRelabel( p, vBfs );
+    while ( iHead < Vec_IntSize(p->vQueue) )
+    {
+        v = Vec_IntEntry( p->vQueue, iHead++ );
+        p->pActive[v] = 0;
+        Ret_FlowDischarge( p, v );
+        if ( p->nRelabels > p->nNodes )
+        {
+            Ret_FlowGlobalRelabel( p, vBfs );
+            iHead = 0;
+        }
+        else if ( iHead > 1000000 && 2 * iHead > Vec_IntSize(p->vQueue) )
+        {
+            // compact the queue
+            memmove( Vec_IntArray(p->vQueue), Vec_IntArray(p->vQueue) + iHead, sizeof(int) * (Vec_IntSize(p->vQueue) - iHead) );
+            Vec_IntShrink( p->vQueue, Vec_IntSize(p->vQueue) - iHead );
+            iHead = 0;
+        }
+    }
+    // the remaining excess cannot reach the sink
+    Ret_FlowGlobalRelabel( p, vBfs );
+    return p->pExcess[p->iSink];
+}
+
+/**Function*************************************************************
+
+  Synopsis    [Implementation of max-flow/min-cut computation.]
+
+  Description [Computes the same min-cut as Abc_NtkMaxFlow() (the one
+  closest to the latches) using push-relabel on a CSR graph, without
+  recursion. Returns the cut nodes ordered by object ID.]
+
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+Vec_Ptr_t * Abc_NtkMaxFlowPush( Abc_Ntk_t * pNtk, int fForward, int * pFlow )
+{
+    Ret_Flow_t * p;
+    Vec_Ptr_t * vMinCut;
+    Vec_Int_t * vBfs;
+    Abc_Obj_t * pObj;
+    int i;
+    p = Ret_FlowStart( pNtk, fForward );
+    vBfs = Vec_IntAlloc( p->nNodes );
+    *pFlow = Ret_FlowMaxPreflow( p, vBfs );
+    // the cut nodes have the input vertex on the latch side of the cut
+    vMinCut = Vec_PtrAlloc( Abc_NtkLatchNum(pNtk) );
+    Abc_NtkForEachObj( pNtk, pObj, i )
+        if ( p->pLabel[Ret_FlowIn(i)] < p->nNodes && p->pLabel[Ret_FlowOut(i)] == p->nNodes )
+            Vec_PtrPush( vMinCut, pObj );
+    assert( Vec_PtrSize(vMinCut) == *pFlow );
+    Vec_IntFree( vBfs );
+    Ret_FlowStop( p );
+    return vMinCut;
+}
+
+////////////////////////////////////////////////////////////////////////
+///                       END OF FILE                                ///
+////////////////////////////////////////////////////////////////////////
+
+
+ABC_NAMESPACE_IMPL_END
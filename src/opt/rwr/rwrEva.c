@@ -69,6 +69,7 @@ int Rwr_NodeRewrite( Rwr_Man_t * p, Cut_Man_t * pManCut, Abc_Obj_t * pNode, int
     int Required, nNodesSaved;
     int nNodesSaveCur = -1; // Suppress "might be used uninitialized"
     int i, GainCur = -1, GainBest = -1;
+    float PlaceCur, PlaceBest = 0.0;
     abctime clk, clk2;//, Counter;
 
     p->nNodesConsidered++;
@@ -152,12 +153,18 @@ clk2 = Abc_Clock();
         pGraph = Rwr_CutEvaluate( p, pNode, pCut, p->vFaninsCur, nNodesSaved, Required, &GainCur, fPlaceEnable );
 p->timeEval += Abc_Clock() - clk2;
 
+        // in placement-aware mode, ties are broken by the change of wire length
+        PlaceCur = 0.0;
+        if ( fPlaceEnable && pGraph != NULL && GainBest <= GainCur && (GainCur > 0 || fUseZeros) )
+            PlaceCur = Abc_PlaceEvaluateCut( pNode, p->vFaninsCur );
+
         // check if the cut is better than the current best one
-        if ( pGraph != NULL && GainBest < GainCur )
+        if ( pGraph != NULL && (GainBest < GainCur || (fPlaceEnable && GainBest == GainCur && PlaceBest > PlaceCur)) )
         {
             // save this form
             nNodesSaveCur = nNodesSaved;
             GainBest  = GainCur;
+            PlaceBest = PlaceCur;
             p->pGraph  = pGraph;
             p->fCompl = ((uPhase & (1<<4)) > 0);
             uTruthBest = 0xFFFF & *Cut_CutReadTruth(pCut);
@@ -171,6 +178,9 @@ p->timeRes += Abc_Clock() - clk;
 
     if ( GainBest == -1 )
         return -1;
+    // do not accept zero-cost replacements that increase wire length
+    if ( fPlaceEnable && GainBest == 0 && PlaceBest > 0.0 )
+        return -1;
 /*
     if ( GainBest > 0 )
     {
@@ -279,43 +289,6 @@ Dec_Graph_t * Rwr_CutEvaluate( Rwr_Man_t * p, Abc_Obj_t * pRoot, Cut_Cut_t * pCu
         if ( nNodesAdded == -1 )
             continue;
         assert( nNodesSaved >= nNodesAdded );
-/*
-        // evaluate the cut
-        if ( fPlaceEnable )
-        {
-            extern float Abc_PlaceEvaluateCut( Abc_Obj_t * pRoot, Vec_Ptr_t * vFanins );
-
-            float Alpha = 0.5; // ???
-            float PlaceCost;
-
-            // get the placement cost of the cut
-            PlaceCost = Abc_PlaceEvaluateCut( pRoot, vFaninsCur );
-
-            // get the weigted cost of the cut
-            CostCur = nNodesSaved - nNodesAdded + Alpha * PlaceCost;
-
-            // do not allow uphill moves
-            if ( nNodesSaved - nNodesAdded < 0 )
-                continue;
-
-            // decide what cut to use
-            if ( CostBest > CostCur )
-            {
-                GainBest   = nNodesSaved - nNodesAdded; // pure node cost
-                CostBest   = CostCur;                   // cost with placement
-                pGraphBest = pGraphCur;                 // subgraph to be used for rewriting
-
-                // score the graph
-                if ( nNodesSaved - nNodesAdded > 0 )
-                {
-                    pNode->nScore++;
-                    pNode->nGain += GainBest;
-                    pNode->nAdded += nNodesAdded;
-                }
-            }
-        }
-        else
-*/
         {
             // count the gain at this node
             if ( GainBest < nNodesSaved - nNodesAdded )
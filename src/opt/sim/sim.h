@@ -125,6 +125,7 @@ struct Sim_Man_t_
     int               nSatRuns;
     int               nSatRunsSat;
     int               nSatRunsUnsat;
+    FILE *            pOut;          // the stream for the statistics
     // runtime statistics
     abctime           timeSim;
     abctime           timeTrav;
@@ -190,6 +191,7 @@ extern Vec_Ptr_t *     Sim_SimulateSeqModel( Abc_Ntk_t * pNtk, int nFrames, int
 /*=== simSupp.c ==========================================================*/
 extern Vec_Ptr_t *     Sim_ComputeStrSupp( Abc_Ntk_t * pNtk );
 extern Vec_Ptr_t *     Sim_ComputeFunSupp( Abc_Ntk_t * pNtk, int fVerbose );
+extern Vec_Ptr_t *     Sim_ComputeFunSuppOut( Abc_Ntk_t * pNtk, int fVerbose, FILE * pOut );
 /*=== simSym.c ==========================================================*/
 extern int             Sim_ComputeTwoVarSymms( Abc_Ntk_t * pNtk, int fVerbose );
 /*=== simSymSat.c ==========================================================*/
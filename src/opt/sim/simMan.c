@@ -170,6 +170,7 @@ Sim_Man_t * Sim_ManStart( Abc_Ntk_t * pNtk, int fLightweight )
     p = ABC_ALLOC( Sim_Man_t, 1 );
     memset( p, 0, sizeof(Sim_Man_t) );
     p->pNtk = pNtk;
+    p->pOut = stdout;
     p->nInputs    = Abc_NtkCiNum(p->pNtk);
     p->nOutputs   = Abc_NtkCoNum(p->pNtk);
     // internal simulation information
@@ -234,15 +235,15 @@ void Sim_ManPrintStats( Sim_Man_t * p )
 {
 //    printf( "Inputs = %5d. Outputs = %5d. Sim words = %5d.\n", 
 //        Abc_NtkCiNum(p->pNtk), Abc_NtkCoNum(p->pNtk), p->nSimWords );
-    printf( "Total func supps   = %8d.\n", Sim_UtilCountSuppSizes(p, 0) );
-    printf( "Total struct supps = %8d.\n", Sim_UtilCountSuppSizes(p, 1) );
-    printf( "Sat runs SAT       = %8d.\n", p->nSatRunsSat );
-    printf( "Sat runs UNSAT     = %8d.\n", p->nSatRunsUnsat );
-    ABC_PRT( "Simulation  ", p->timeSim );
-    ABC_PRT( "Traversal   ", p->timeTrav );
-    ABC_PRT( "Fraiging    ", p->timeFraig );
-    ABC_PRT( "SAT         ", p->timeSat );
-    ABC_PRT( "TOTAL       ", p->timeTotal );
+    fprintf( p->pOut, "Total func supps   = %8d.\n", Sim_UtilCountSuppSizes(p, 0) );
+    fprintf( p->pOut, "Total struct supps = %8d.\n", Sim_UtilCountSuppSizes(p, 1) );
+    fprintf( p->pOut, "Sat runs SAT       = %8d.\n", p->nSatRunsSat );
+    fprintf( p->pOut, "Sat runs UNSAT     = %8d.\n", p->nSatRunsUnsat );
+    fprintf( p->pOut, "%s =%9.2f sec\n", "Simulation  ", 1.0*((double)(p->timeSim))/((double)CLOCKS_PER_SEC) );
+    fprintf( p->pOut, "%s =%9.2f sec\n", "Traversal   ", 1.0*((double)(p->timeTrav))/((double)CLOCKS_PER_SEC) );
+    fprintf( p->pOut, "%s =%9.2f sec\n", "Fraiging    ", 1.0*((double)(p->timeFraig))/((double)CLOCKS_PER_SEC) );
+    fprintf( p->pOut, "%s =%9.2f sec\n", "SAT         ", 1.0*((double)(p->timeSat))/((double)CLOCKS_PER_SEC) );
+    fprintf( p->pOut, "%s =%9.2f sec\n", "TOTAL       ", 1.0*((double)(p->timeTotal))/((double)CLOCKS_PER_SEC) );
 }
 
 
@@ -93,7 +93,7 @@ Vec_Ptr_t * Sim_ComputeStrSupp( Abc_Ntk_t * pNtk )
   Synopsis    [Compute functional supports.]
 
   Description [Supports are returned as an array of bit strings, one
-  for each CO.]
+  for each CO. The statistics are printed into pOut.]
                
   SideEffects []
 
@@ -101,6 +101,10 @@ Vec_Ptr_t * Sim_ComputeStrSupp( Abc_Ntk_t * pNtk )
 
 ***********************************************************************/
 Vec_Ptr_t * Sim_ComputeFunSupp( Abc_Ntk_t * pNtk, int fVerbose )
+{
+    return Sim_ComputeFunSuppOut( pNtk, fVerbose, stdout );
+}
+Vec_Ptr_t * Sim_ComputeFunSuppOut( Abc_Ntk_t * pNtk, int fVerbose, FILE * pOut )
 {
     Sim_Man_t * p;
     Vec_Ptr_t * vResult;
@@ -111,6 +115,7 @@ Vec_Ptr_t * Sim_ComputeFunSupp( Abc_Ntk_t * pNtk, int fVerbose )
 
     // start the simulation manager
     p = Sim_ManStart( pNtk, 0 );
+    p->pOut = pOut;
 
     // compute functional support using one round of random simulation
     Sim_UtilAssignRandom( p );
@@ -119,7 +124,7 @@ Vec_Ptr_t * Sim_ComputeFunSupp( Abc_Ntk_t * pNtk, int fVerbose )
     // set the support targets 
     Sim_ComputeSuppSetTargets( p );
     if ( fVerbose )
-        printf( "Number of support targets after simulation = %5d.\n", Vec_VecSizeSize(p->vSuppTargs) );
+        fprintf( pOut, "Number of support targets after simulation = %5d.\n", Vec_VecSizeSize(p->vSuppTargs) );
     if ( Vec_VecSizeSize(p->vSuppTargs) == 0 )
         goto exit;
 
@@ -132,7 +137,7 @@ Vec_Ptr_t * Sim_ComputeFunSupp( Abc_Ntk_t * pNtk, int fVerbose )
             goto exit;
 
         if ( fVerbose )
-            printf( "Targets = %5d.   Solved = %5d.  Fifo = %5d.\n",
+            fprintf( pOut, "Targets = %5d.   Solved = %5d.  Fifo = %5d.\n",
                 Vec_VecSizeSize(p->vSuppTargs), nSolved, Vec_PtrSize(p->vFifo) );
     }
 
@@ -146,7 +151,7 @@ Vec_Ptr_t * Sim_ComputeFunSupp( Abc_Ntk_t * pNtk, int fVerbose )
         nSolved = Sim_ComputeSuppRound( p, 1 );
 
 if ( fVerbose )
-    printf( "Targets = %5d.   Solved = %5d.  Fifo = %5d.  SAT runs = %3d.\n", 
+    fprintf( pOut, "Targets = %5d.   Solved = %5d.  Fifo = %5d.  SAT runs = %3d.\n", 
             Vec_VecSizeSize(p->vSuppTargs), nSolved, Vec_PtrSize(p->vFifo), p->nSatRuns );
     }
 
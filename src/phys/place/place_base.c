@@ -12,6 +12,14 @@
 #include <assert.h>
 #include <string.h>
 
+#if defined(ABC_USE_PTHREADS)
+#ifdef _WIN32
+#include "../lib/pthread.h"
+#else
+#include <pthread.h>
+#endif
+#endif
+
 #include "place_base.h"
 #include "place_gordian.h"
 
@@ -19,21 +27,57 @@ ABC_NAMESPACE_IMPL_START
 
 
 // --------------------------------------------------------------------
-// Global variables
+// placeContextAlloc()
+//
+/// \brief Allocates an empty placement context.
 //
 // --------------------------------------------------------------------
+PlaceContext *placeContextAlloc() {
+  PlaceContext *ctx = calloc(1, sizeof(PlaceContext));
+  assert(ctx);
+  ctx->m_rowHeight = 1.0;
+  ctx->m_numThreads = 1;
+#if defined(ABC_USE_PTHREADS)
+  ctx->m_lock = malloc(sizeof(pthread_mutex_t));
+  pthread_mutex_init((pthread_mutex_t *)ctx->m_lock, NULL);
+#endif
+  return ctx;
+}
 
-int   g_place_numCells = 0;
-int   g_place_numNets = 0;
-float g_place_rowHeight = 1.0;
-
-Rect  g_place_coreBounds;
-Rect  g_place_padBounds;
 
-ConcreteCell **g_place_concreteCells = NULL;
-int            g_place_concreteCellsSize = 0;
-ConcreteNet  **g_place_concreteNets = NULL;
-int            g_place_concreteNetsSize = 0;
+// --------------------------------------------------------------------
+// placeContextFree()
+//
+/// \brief Deallocates a placement context.
+///
+/// The cells and nets belong to the caller and are not deallocated.
+//
+// --------------------------------------------------------------------
+void placeContextFree(PlaceContext *ctx) {
+  qps_problem_t *qp = ctx->m_qpProb;
+
+  if (ctx->m_rootPartition) freePartition(ctx->m_rootPartition);
+  if (qp) {
+    free(qp->area);
+    free(qp->x);
+    free(qp->y);
+    free(qp->fixed);
+    free(qp->connect);
+    free(qp->edge_weight);
+    free(qp);
+  }
+#if defined(ABC_USE_PTHREADS)
+  pthread_mutex_destroy((pthread_mutex_t *)ctx->m_lock);
+  free(ctx->m_lock);
+#endif
+  free(ctx->m_allNetsL2);
+  free(ctx->m_allNetsR2);
+  free(ctx->m_allNetsB2);
+  free(ctx->m_allNetsT2);
+  free(ctx->m_concreteCells);
+  free(ctx->m_concreteNets);
+  free(ctx);
+}
 
 
 // --------------------------------------------------------------------
@@ -83,11 +127,11 @@ float getNetWirelength(const ConcreteNet *net) {
 /// \brief Returns the total HPWL of all nets.
 //
 // --------------------------------------------------------------------
-float getTotalWirelength() {
+float getTotalWirelength(PlaceContext *ctx) {
   float r = 0;
   int n;
-  for(n=0; n<g_place_numNets; n++) if (g_place_concreteNets[n])
-    r += getNetWirelength(g_place_concreteNets[n]);
+  for(n=0; n<ctx->m_numNets; n++) if (ctx->m_concreteNets[n])
+    r += getNetWirelength(ctx->m_concreteNets[n]);
   return r;
 }
 
@@ -111,25 +155,25 @@ float getCellArea(const ConcreteCell *cell) {
 /// appropriately.
 //
 // --------------------------------------------------------------------
-void   addConcreteNet(ConcreteNet *net) {
+void   addConcreteNet(PlaceContext *ctx, ConcreteNet *net) {
   assert(net);
   assert(net->m_id >= 0);
-  if (net->m_id >= g_place_concreteNetsSize) {
-    g_place_concreteNetsSize = (net->m_id > g_place_concreteNetsSize ? 
-                               net->m_id : g_place_concreteNetsSize);
-    g_place_concreteNetsSize *= 1.5;
-    g_place_concreteNetsSize += 20;
-    g_place_concreteNets = (ConcreteNet**)realloc(g_place_concreteNets, 
-             sizeof(ConcreteNet*)*g_place_concreteNetsSize);
-    assert(g_place_concreteNets);
+  if (net->m_id >= ctx->m_concreteNetsSize) {
+    ctx->m_concreteNetsSize = (net->m_id > ctx->m_concreteNetsSize ? 
+                               net->m_id : ctx->m_concreteNetsSize);
+    ctx->m_concreteNetsSize *= 1.5;
+    ctx->m_concreteNetsSize += 20;
+    ctx->m_concreteNets = (ConcreteNet**)realloc(ctx->m_concreteNets, 
+             sizeof(ConcreteNet*)*ctx->m_concreteNetsSize);
+    assert(ctx->m_concreteNets);
   }
-  if (net->m_id >= g_place_numNets) {
-    memset(&(g_place_concreteNets[g_place_numNets]), 0,
-            sizeof(ConcreteNet*)*(net->m_id+1-g_place_numNets));
-    g_place_numNets = net->m_id+1;
-    assert(g_place_numNets <= g_place_concreteNetsSize);
+  if (net->m_id >= ctx->m_numNets) {
+    memset(&(ctx->m_concreteNets[ctx->m_numNets]), 0,
+            sizeof(ConcreteNet*)*(net->m_id+1-ctx->m_numNets));
+    ctx->m_numNets = net->m_id+1;
+    assert(ctx->m_numNets <= ctx->m_concreteNetsSize);
   }
-  g_place_concreteNets[net->m_id] = net;
+  ctx->m_concreteNets[net->m_id] = net;
 }
 
 
@@ -138,10 +182,10 @@ void   addConcreteNet(ConcreteNet *net) {
 //
 /// Does not deallocate memory.
 // --------------------------------------------------------------------
-void   delConcreteNet(ConcreteNet *net) {
+void   delConcreteNet(PlaceContext *ctx, ConcreteNet *net) {
   assert(net);
-  g_place_concreteNets[net->m_id] = 0;
-  while(!g_place_concreteNets[g_place_numNets-1]) g_place_numNets--;
+  ctx->m_concreteNets[net->m_id] = 0;
+  while(!ctx->m_concreteNets[ctx->m_numNets-1]) ctx->m_numNets--;
 }
 
 
@@ -152,24 +196,24 @@ void   delConcreteNet(ConcreteNet *net) {
 /// appropriately.
 //
 // --------------------------------------------------------------------
-void   addConcreteCell(ConcreteCell *cell) {
+void   addConcreteCell(PlaceContext *ctx, ConcreteCell *cell) {
   assert(cell);
   assert(cell->m_id >= 0);
-  if (cell->m_id >= g_place_concreteCellsSize) {
-    g_place_concreteCellsSize = (cell->m_id > g_place_concreteCellsSize ? 
-                                 cell->m_id : g_place_concreteCellsSize);
-    g_place_concreteCellsSize *= 1.5;
-    g_place_concreteCellsSize += 20;
-    g_place_concreteCells = (ConcreteCell**)realloc(g_place_concreteCells, 
-          sizeof(ConcreteCell*)*g_place_concreteCellsSize);
-    assert(g_place_concreteCells);
+  if (cell->m_id >= ctx->m_concreteCellsSize) {
+    ctx->m_concreteCellsSize = (cell->m_id > ctx->m_concreteCellsSize ? 
+                                 cell->m_id : ctx->m_concreteCellsSize);
+    ctx->m_concreteCellsSize *= 1.5;
+    ctx->m_concreteCellsSize += 20;
+    ctx->m_concreteCells = (ConcreteCell**)realloc(ctx->m_concreteCells, 
+          sizeof(ConcreteCell*)*ctx->m_concreteCellsSize);
+    assert(ctx->m_concreteCells);
   }
-  if (cell->m_id >= g_place_numCells) {
-    memset(&(g_place_concreteCells[g_place_numCells]), 0,
-          sizeof(ConcreteCell*)*(cell->m_id+1-g_place_numCells));
-    g_place_numCells = cell->m_id+1;
+  if (cell->m_id >= ctx->m_numCells) {
+    memset(&(ctx->m_concreteCells[ctx->m_numCells]), 0,
+          sizeof(ConcreteCell*)*(cell->m_id+1-ctx->m_numCells));
+    ctx->m_numCells = cell->m_id+1;
   }
-  g_place_concreteCells[cell->m_id] = cell;
+  ctx->m_concreteCells[cell->m_id] = cell;
 }
 
 
@@ -213,12 +257,12 @@ void delCellFromPartition(ConcreteCell *cell, Partition *p) {
 /// and other nasty errors will occur.
 //
 // --------------------------------------------------------------------
-void   delConcreteCell(ConcreteCell *cell) {
+void   delConcreteCell(PlaceContext *ctx, ConcreteCell *cell) {
   assert(cell);
-  g_place_concreteCells[cell->m_id] = 0;
-  while(!g_place_concreteCells[g_place_numCells-1]) g_place_numCells--;
+  ctx->m_concreteCells[cell->m_id] = 0;
+  while(!ctx->m_concreteCells[ctx->m_numCells-1]) ctx->m_numCells--;
 
-  if (g_place_rootPartition) delCellFromPartition(cell, g_place_rootPartition);
+  if (ctx->m_rootPartition) delCellFromPartition(cell, ctx->m_rootPartition);
 }
 
 
@@ -7,9 +7,11 @@
 //
 /*===================================================================*/
 
-#if !defined(PLACE_BASE_H_)
+#ifndef ABC__phys__place__place_base_h
 #define ABC__phys__place__place_base_h
 
+#include "misc/util/abc_global.h"
+
 
 ABC_NAMESPACE_HEADER_START
 
@@ -21,7 +23,7 @@ ABC_NAMESPACE_HEADER_START
 
 // --- a C++ bool-like type
 //typedef char bool;
-#ifndef ABC__phys__place__place_base_h
+#ifndef bool
 #define bool int
 #endif
 
@@ -82,23 +84,38 @@ typedef struct ConcreteNet {
 // in a non-sparse array.
 // Cells and nets have separate ID spaces.
 
-// --------------------------------------------------------------------
-// Global variable prototypes
+// --- PlaceContext - the state of one placement run
 //
-// --------------------------------------------------------------------
-
-// NOTE: None of these need to be managed externally.
-
-extern int   g_place_numCells;   // number of cells
-extern int   g_place_numNets;    // number of nets
-extern float g_place_rowHeight;  // height of placement row
-extern Rect  g_place_coreBounds; // border of placeable area
-                                 // (x,y) = corner
-extern Rect  g_place_padBounds;  // border of total die area
-                                 // (x,y) = corner
-
-extern ConcreteCell **g_place_concreteCells; // all concrete cells
-extern ConcreteNet  **g_place_concreteNets;  // all concrete nets
+// All of the state of a placement run lives here, so that several
+// placements can proceed concurrently in the same process.  The
+// members need not be managed externally.
+
+struct Partition;
+struct qps_problem;
+
+typedef struct PlaceContext {
+  int            m_numCells;   // number of cells
+  int            m_numNets;    // number of nets
+  float          m_rowHeight;  // height of placement row
+  Rect           m_coreBounds; // border of placeable area
+                               // (x,y) = corner
+  Rect           m_padBounds;  // border of total die area
+                               // (x,y) = corner
+
+  ConcreteCell **m_concreteCells; // all concrete cells
+  int            m_concreteCellsSize;
+  ConcreteNet  **m_concreteNets;  // all concrete nets
+  int            m_concreteNetsSize;
+
+  int                 m_numPartitions; // number of leaf partitions
+  struct Partition   *m_rootPartition; // partition tree
+  struct qps_problem *m_qpProb;        // quadratic problem
+  ConcreteNet  **m_allNetsL2, **m_allNetsR2, // nets sorted by the corners
+               **m_allNetsB2, **m_allNetsT2; // of their bounding boxes
+
+  int            m_numThreads; // threads used by the solver and partitioner
+  void          *m_lock;       // guards the partition counter
+} PlaceContext;
 
 
 // --------------------------------------------------------------------
@@ -106,15 +123,18 @@ extern ConcreteNet  **g_place_concreteNets;  // all concrete nets
 //
 // --------------------------------------------------------------------
 
-void   addConcreteNet(ConcreteNet *net);
-void   addConcreteCell(ConcreteCell *cell);
-void   delConcreteNet(ConcreteNet *net);
-void   delConcreteCell(ConcreteCell *cell);
+PlaceContext *placeContextAlloc();
+void   placeContextFree(PlaceContext *ctx);
+
+void   addConcreteNet(PlaceContext *ctx, ConcreteNet *net);
+void   addConcreteCell(PlaceContext *ctx, ConcreteCell *cell);
+void   delConcreteNet(PlaceContext *ctx, ConcreteNet *net);
+void   delConcreteCell(PlaceContext *ctx, ConcreteCell *cell);
 
-void   globalPreplace(float utilization);
-void   globalPlace();
-void   globalIncremental();
-void   globalFixDensity(int numBins, float maxMovement);
+void   globalPreplace(PlaceContext *ctx, float utilization);
+void   globalPlace(PlaceContext *ctx);
+void   globalIncremental(PlaceContext *ctx);
+void   globalFixDensity(PlaceContext *ctx, int numBins, float maxMovement);
 
 float fastEstimate(ConcreteCell *cell,
                    int numNets, ConcreteNet *nets[]);
@@ -123,10 +143,10 @@ float fastTopoPlace(int numCells, ConcreteCell *cells[],
 
 Rect   getNetBBox(const ConcreteNet *net);
 float  getNetWirelength(const ConcreteNet *net);
-float  getTotalWirelength();
+float  getTotalWirelength(PlaceContext *ctx);
 float  getCellArea(const ConcreteCell *cell);
 
-void   writeBookshelf(const char *filename);
+void   writeBookshelf(PlaceContext *ctx, const char *filename);
 
 // comparative qsort-style functions
 int    netSortByL(const void *a, const void *b);
@@ -31,8 +31,8 @@ ABC_NAMESPACE_IMPL_START
 //
 // --------------------------------------------------------------------
 
-void spreadDensityX(int numBins, float maxMovement);
-void spreadDensityY(int numBins, float maxMovement);
+void spreadDensityX(PlaceContext *ctx, int numBins, float maxMovement);
+void spreadDensityY(PlaceContext *ctx, int numBins, float maxMovement);
 
 
 // --------------------------------------------------------------------
@@ -40,12 +40,12 @@ void spreadDensityY(int numBins, float maxMovement);
 //
 /// Doesn't deal well with fixed cells in the core area.
 // --------------------------------------------------------------------
-void globalFixDensity(int numBins, float maxMovement) {
+void globalFixDensity(PlaceContext *ctx, int numBins, float maxMovement) {
   
   printf("QCLN-10 : \tbin-based density correction\n");
     
-  spreadDensityX(numBins, maxMovement);
-  // spreadDensityY(numBins, maxMovement);
+  spreadDensityX(ctx, numBins, maxMovement);
+  // spreadDensityY(ctx, numBins, maxMovement);
 }
 
 
@@ -53,7 +53,7 @@ void globalFixDensity(int numBins, float maxMovement) {
 // spreadDensityX()
 //
 // --------------------------------------------------------------------
-void spreadDensityX(int numBins, float maxMovement) {
+void spreadDensityX(PlaceContext *ctx, int numBins, float maxMovement) {
 
   int c, c2, c3, x, y;
   float totalArea = 0;
@@ -70,11 +70,11 @@ void spreadDensityX(int numBins, float maxMovement) {
   ConcreteCell **binCells;
   ConcreteCell **allCells;
 
-  binCells = (ConcreteCell **)malloc(sizeof(ConcreteCell*)*g_place_numCells);
-  allCells = (ConcreteCell **)malloc(sizeof(ConcreteCell*)*g_place_numCells);
+  binCells = (ConcreteCell **)malloc(sizeof(ConcreteCell*)*ctx->m_numCells);
+  allCells = (ConcreteCell **)malloc(sizeof(ConcreteCell*)*ctx->m_numCells);
 
-  for(c=0; c<g_place_numCells; c++) if (g_place_concreteCells[c]) {
-    ConcreteCell *cell =  g_place_concreteCells[c];
+  for(c=0; c<ctx->m_numCells; c++) if (ctx->m_concreteCells[c]) {
+    ConcreteCell *cell =  ctx->m_concreteCells[c];
     if (!cell->m_fixed && !cell->m_parent->m_pad) {
       allCells[moveableCells++] = cell;
       totalArea += getCellArea(cell);
@@ -105,8 +105,8 @@ void spreadDensityX(int numBins, float maxMovement) {
       x = 0;
       xBinCount = 0, xBinStart =  0;
       xBinArea = 0, xCumArea = 0;
-      lastOldEdge = g_place_coreBounds.x;
-      lastNewEdge = g_place_coreBounds.x;
+      lastOldEdge = ctx->m_coreBounds.x;
+      lastNewEdge = ctx->m_coreBounds.x;
 
       // for each x-bin...
       for(c2=0; c2<yBinCount; c2++) {
@@ -120,10 +120,10 @@ void spreadDensityX(int numBins, float maxMovement) {
 
         // have we filled up an x-bin?
         if (xCumArea >= yBinArea*(x+1)/numBins && xBinArea > 0) {
-          curNewEdge = lastNewEdge + g_place_coreBounds.w*xBinArea/yBinArea;
+          curNewEdge = lastNewEdge + ctx->m_coreBounds.w*xBinArea/yBinArea;
 
-          if (curNewEdge > g_place_coreBounds.x+g_place_coreBounds.w) 
-            curNewEdge = g_place_coreBounds.x+g_place_coreBounds.w;
+          if (curNewEdge > ctx->m_coreBounds.x+ctx->m_coreBounds.w) 
+            curNewEdge = ctx->m_coreBounds.x+ctx->m_coreBounds.w;
           if ((curNewEdge-curOldEdge)>maxMovement) curNewEdge = curOldEdge + maxMovement;
           if ((curOldEdge-curNewEdge)>maxMovement) curNewEdge = curOldEdge - maxMovement;
 
@@ -143,10 +143,10 @@ void spreadDensityX(int numBins, float maxMovement) {
             
               // force within core
             w = binCells[c3]->m_parent->m_width*0.5;
-            if (binCells[c3]->m_x-w < g_place_coreBounds.x)
-              binCells[c3]->m_x = g_place_coreBounds.x+w;
-            if (binCells[c3]->m_x+w > g_place_coreBounds.x+g_place_coreBounds.w)
-              binCells[c3]->m_x = g_place_coreBounds.x+g_place_coreBounds.w-w;
+            if (binCells[c3]->m_x-w < ctx->m_coreBounds.x)
+              binCells[c3]->m_x = ctx->m_coreBounds.x+w;
+            if (binCells[c3]->m_x+w > ctx->m_coreBounds.x+ctx->m_coreBounds.w)
+              binCells[c3]->m_x = ctx->m_coreBounds.x+ctx->m_coreBounds.w-w;
           }
           
           lastOldEdge = curOldEdge;
@@ -174,7 +174,7 @@ void spreadDensityX(int numBins, float maxMovement) {
 // spreadDensityY()
 //
 // --------------------------------------------------------------------
-void spreadDensityY(int numBins, float maxMovement) {
+void spreadDensityY(PlaceContext *ctx, int numBins, float maxMovement) {
 
   int c, c2, c3, x, y;
   float totalArea = 0;
@@ -191,11 +191,11 @@ void spreadDensityY(int numBins, float maxMovement) {
   ConcreteCell **binCells;
   ConcreteCell **allCells;
 
-  binCells = (ConcreteCell **)malloc(sizeof(ConcreteCell*)*g_place_numCells);
-  allCells = (ConcreteCell **)malloc(sizeof(ConcreteCell*)*g_place_numCells);
+  binCells = (ConcreteCell **)malloc(sizeof(ConcreteCell*)*ctx->m_numCells);
+  allCells = (ConcreteCell **)malloc(sizeof(ConcreteCell*)*ctx->m_numCells);
 
-  for(c=0; c<g_place_numCells; c++) if (g_place_concreteCells[c]) {
-    ConcreteCell *cell =  g_place_concreteCells[c];
+  for(c=0; c<ctx->m_numCells; c++) if (ctx->m_concreteCells[c]) {
+    ConcreteCell *cell =  ctx->m_concreteCells[c];
     if (!cell->m_fixed && !cell->m_parent->m_pad) {
       allCells[moveableCells++] = cell;
       totalArea += getCellArea(cell);
@@ -224,8 +224,8 @@ void spreadDensityY(int numBins, float maxMovement) {
       y = 0;
       yBinCount = 0, yBinStart =  0;
       yBinArea = 0, yCumArea = 0;
-      lastOldEdge = g_place_coreBounds.y;
-      lastNewEdge = g_place_coreBounds.y;
+      lastOldEdge = ctx->m_coreBounds.y;
+      lastNewEdge = ctx->m_coreBounds.y;
       
       // for each y-bin...
       for(c2=0; c2<xBinCount; c2++) {
@@ -237,10 +237,10 @@ void spreadDensityY(int numBins, float maxMovement) {
         
         // have we filled up an x-bin?
         if (yCumArea >= xBinArea*(y+1)/numBins && yBinArea > 0) {
-          curNewEdge = lastNewEdge + g_place_coreBounds.h*yBinArea/xBinArea;
+          curNewEdge = lastNewEdge + ctx->m_coreBounds.h*yBinArea/xBinArea;
 
-          if (curNewEdge > g_place_coreBounds.y+g_place_coreBounds.h) 
-            curNewEdge = g_place_coreBounds.y+g_place_coreBounds.h;
+          if (curNewEdge > ctx->m_coreBounds.y+ctx->m_coreBounds.h) 
+            curNewEdge = ctx->m_coreBounds.y+ctx->m_coreBounds.h;
           if ((curNewEdge-curOldEdge)>maxMovement) curNewEdge = curOldEdge + maxMovement;
           if ((curOldEdge-curNewEdge)>maxMovement) curNewEdge = curOldEdge - maxMovement;
 
@@ -253,10 +253,10 @@ void spreadDensityY(int numBins, float maxMovement) {
 
             // force within core
             h = binCells[c3]->m_parent->m_height;
-            if (binCells[c3]->m_y-h < g_place_coreBounds.y)
-              binCells[c3]->m_y = g_place_coreBounds.y+h;
-            if (binCells[c3]->m_y+h > g_place_coreBounds.y+g_place_coreBounds.h)
-              binCells[c3]->m_y = g_place_coreBounds.y+g_place_coreBounds.h-h;
+            if (binCells[c3]->m_y-h < ctx->m_coreBounds.y)
+              binCells[c3]->m_y = ctx->m_coreBounds.y+h;
+            if (binCells[c3]->m_y+h > ctx->m_coreBounds.y+ctx->m_coreBounds.h)
+              binCells[c3]->m_y = ctx->m_coreBounds.y+ctx->m_coreBounds.h-h;
           }
 
           lastOldEdge = curOldEdge;
@@ -20,14 +20,6 @@
 ABC_NAMESPACE_IMPL_START
 
 
-// --------------------------------------------------------------------
-// Global variables
-//
-// --------------------------------------------------------------------
-
-qps_problem_t *g_place_qpProb = NULL;
-
-
 // --------------------------------------------------------------------
 // splitPenalty()
 //
@@ -50,34 +42,34 @@ float splitPenalty(int pins) {
 /// \brief Constructs the matrices necessary to do analytical placement.
 //
 // --------------------------------------------------------------------
-void constructQuadraticProblem() {
+void constructQuadraticProblem(PlaceContext *ctx) {
   int maxConnections = 1;
   int ignoreNum = 0;
   int n,t,c,c2,p;
   ConcreteCell  *cell;
   ConcreteNet   *net;
-  int           *cell_numTerms = calloc(g_place_numCells, sizeof(int));
-  ConcreteNet ***cell_terms = calloc(g_place_numCells, sizeof(ConcreteNet**));
+  int           *cell_numTerms = calloc(ctx->m_numCells, sizeof(int));
+  ConcreteNet ***cell_terms = calloc(ctx->m_numCells, sizeof(ConcreteNet**));
   bool incremental = false;
   int nextIndex = 1;
-  int *seen = calloc(g_place_numCells, sizeof(int));
+  int *seen = calloc(ctx->m_numCells, sizeof(int));
   float weight;
   int last_index;
 
   // create problem object
-  if (!g_place_qpProb) {
-    g_place_qpProb = malloc(sizeof(qps_problem_t));
-    g_place_qpProb->area = NULL;
-    g_place_qpProb->x = NULL;
-    g_place_qpProb->y = NULL;
-    g_place_qpProb->fixed = NULL;
-    g_place_qpProb->connect = NULL;
-    g_place_qpProb->edge_weight = NULL;
+  if (!ctx->m_qpProb) {
+    ctx->m_qpProb = malloc(sizeof(qps_problem_t));
+    ctx->m_qpProb->area = NULL;
+    ctx->m_qpProb->x = NULL;
+    ctx->m_qpProb->y = NULL;
+    ctx->m_qpProb->fixed = NULL;
+    ctx->m_qpProb->connect = NULL;
+    ctx->m_qpProb->edge_weight = NULL;
   }
 
   // count the maximum possible number of non-sparse entries
-  for(n=0; n<g_place_numNets; n++) if (g_place_concreteNets[n]) {
-    ConcreteNet *net = g_place_concreteNets[n];
+  for(n=0; n<ctx->m_numNets; n++) if (ctx->m_concreteNets[n]) {
+    ConcreteNet *net = ctx->m_concreteNets[n];
     if (net->m_numTerms > IGNORE_NETSIZE) {
       ignoreNum++;
     }
@@ -96,43 +88,44 @@ void constructQuadraticProblem() {
   }
 
   // initialize the data structures
-  g_place_qpProb->num_cells = g_place_numCells;
-  maxConnections += g_place_numCells + 1;
+  ctx->m_qpProb->num_cells = ctx->m_numCells;
+  ctx->m_qpProb->num_threads = ctx->m_numThreads;
+  maxConnections += ctx->m_numCells + 1;
 
-  g_place_qpProb->area        = realloc(g_place_qpProb->area,
-                                       sizeof(float)*g_place_numCells);// "area" matrix
-  g_place_qpProb->edge_weight = realloc(g_place_qpProb->edge_weight,
+  ctx->m_qpProb->area        = realloc(ctx->m_qpProb->area,
+                                       sizeof(float)*ctx->m_numCells);// "area" matrix
+  ctx->m_qpProb->edge_weight = realloc(ctx->m_qpProb->edge_weight,
                                        sizeof(float)*maxConnections);  // "weight" matrix
-  g_place_qpProb->connect     = realloc(g_place_qpProb->connect,
+  ctx->m_qpProb->connect     = realloc(ctx->m_qpProb->connect,
                                        sizeof(int)*maxConnections);    // "connectivity" matrix
-  g_place_qpProb->fixed       = realloc(g_place_qpProb->fixed,
-                                       sizeof(int)*g_place_numCells);  // "fixed" matrix
+  ctx->m_qpProb->fixed       = realloc(ctx->m_qpProb->fixed,
+                                       sizeof(int)*ctx->m_numCells);  // "fixed" matrix
 
   // initialize or keep preexisting locations
-  if (g_place_qpProb->x != NULL && g_place_qpProb->y != NULL) {
+  if (ctx->m_qpProb->x != NULL && ctx->m_qpProb->y != NULL) {
     printf("QMAN-10 :\tperforming incremental placement\n");
     incremental = true;
   }
-  g_place_qpProb->x = (float*)realloc(g_place_qpProb->x, sizeof(float)*g_place_numCells);
-  g_place_qpProb->y = (float*)realloc(g_place_qpProb->y, sizeof(float)*g_place_numCells);
+  ctx->m_qpProb->x = (float*)realloc(ctx->m_qpProb->x, sizeof(float)*ctx->m_numCells);
+  ctx->m_qpProb->y = (float*)realloc(ctx->m_qpProb->y, sizeof(float)*ctx->m_numCells);
 
   // form a row for each cell
   // build data
-  for(c = 0; c < g_place_numCells; c++) if (g_place_concreteCells[c]) {
-    cell = g_place_concreteCells[c];
+  for(c = 0; c < ctx->m_numCells; c++) if (ctx->m_concreteCells[c]) {
+    cell = ctx->m_concreteCells[c];
     
     // fill in the characteristics for this cell
-    g_place_qpProb->area[c] = getCellArea(cell);
+    ctx->m_qpProb->area[c] = getCellArea(cell);
     if (cell->m_fixed || cell->m_parent->m_pad) {
-      g_place_qpProb->x[c] = cell->m_x;
-      g_place_qpProb->y[c] = cell->m_y;
-      g_place_qpProb->fixed[c] = 1;
+      ctx->m_qpProb->x[c] = cell->m_x;
+      ctx->m_qpProb->y[c] = cell->m_y;
+      ctx->m_qpProb->fixed[c] = 1;
     } else {
       if (!incremental) {
-        g_place_qpProb->x[c] = g_place_coreBounds.x+g_place_coreBounds.w*0.5;
-        g_place_qpProb->y[c] = g_place_coreBounds.y+g_place_coreBounds.h*0.5;
+        ctx->m_qpProb->x[c] = ctx->m_coreBounds.x+ctx->m_coreBounds.w*0.5;
+        ctx->m_qpProb->y[c] = ctx->m_coreBounds.y+ctx->m_coreBounds.h*0.5;
       }
-      g_place_qpProb->fixed[c] = 0;
+      ctx->m_qpProb->fixed[c] = 0;
     }
 
     // update connectivity matrices
@@ -145,23 +138,23 @@ void constructQuadraticProblem() {
         if (c2 == c) continue;
         if (seen[c2] < last_index) {
           // not seen
-          g_place_qpProb->connect[nextIndex-1] = c2;
-          g_place_qpProb->edge_weight[nextIndex-1] = weight;
+          ctx->m_qpProb->connect[nextIndex-1] = c2;
+          ctx->m_qpProb->edge_weight[nextIndex-1] = weight;
           seen[c2] = nextIndex;
           nextIndex++;
         } else {
           // seen
-          g_place_qpProb->edge_weight[seen[c2]-1] += weight;
+          ctx->m_qpProb->edge_weight[seen[c2]-1] += weight;
         }
       }
     }
-    g_place_qpProb->connect[nextIndex-1] = -1;
-    g_place_qpProb->edge_weight[nextIndex-1] = -1.0;    
+    ctx->m_qpProb->connect[nextIndex-1] = -1;
+    ctx->m_qpProb->edge_weight[nextIndex-1] = -1.0;    
     nextIndex++;
   } else {
     // fill in dummy values for connectivity matrices
-    g_place_qpProb->connect[nextIndex-1] = -1;
-    g_place_qpProb->edge_weight[nextIndex-1] = -1.0;    
+    ctx->m_qpProb->connect[nextIndex-1] = -1;
+    ctx->m_qpProb->edge_weight[nextIndex-1] = -1.0;    
     nextIndex++;    
   }
 
@@ -183,10 +176,10 @@ typedef struct reverseCOG {
 /// \brief Generates center of gravity constraints.
 //
 // --------------------------------------------------------------------
-int generateCoGConstraints(reverseCOG COG_rev[]) {
+int generateCoGConstraints(PlaceContext *ctx, reverseCOG COG_rev[]) {
   int numConstraints = 0; // actual num constraints
   int cogRevNum = 0;
-  Partition **stack = malloc(sizeof(Partition*)*g_place_numPartitions*2);
+  Partition **stack = malloc(sizeof(Partition*)*ctx->m_numPartitions*2);
   int stackPtr = 0;
   Partition *p;
   float cgx, cgy;
@@ -197,7 +190,7 @@ int generateCoGConstraints(reverseCOG COG_rev[]) {
   ConcreteCell *cell;
 
   // each partition may give rise to a center-of-gravity constraint
-  stack[stackPtr] = g_place_rootPartition;
+  stack[stackPtr] = ctx->m_rootPartition;
   while(stackPtr >= 0) {
     p = stack[stackPtr--];
     assert(p);
@@ -226,13 +219,13 @@ int generateCoGConstraints(reverseCOG COG_rev[]) {
     }
   }
 
-  assert(cogRevNum == g_place_numPartitions);
+  assert(cogRevNum == ctx->m_numPartitions);
   
-  for (i = 0; i < g_place_numPartitions; i++) {
+  for (i = 0; i < ctx->m_numPartitions; i++) {
     p = COG_rev[i].part;
     assert(p);
-    g_place_qpProb->cog_x[numConstraints] = COG_rev[i].x;
-    g_place_qpProb->cog_y[numConstraints] = COG_rev[i].y;
+    ctx->m_qpProb->cog_x[numConstraints] = COG_rev[i].x;
+    ctx->m_qpProb->cog_y[numConstraints] = COG_rev[i].y;
     totarea = 0.0;
     for(m=0; m<p->m_numMembers; m++) if (p->m_members[m]) {
       cell = p->m_members[m];
@@ -244,7 +237,7 @@ int generateCoGConstraints(reverseCOG COG_rev[]) {
       else {
     continue;
       }
-      g_place_qpProb->cog_list[next_index++] = cell->m_id;
+      ctx->m_qpProb->cog_list[next_index++] = cell->m_id;
       totarea += getCellArea(cell);
     }
     if (totarea == 0.0) {
@@ -252,7 +245,7 @@ int generateCoGConstraints(reverseCOG COG_rev[]) {
     }
     if (isTrueConstraint) {
       numConstraints++;
-      g_place_qpProb->cog_list[next_index++] = -1;
+      ctx->m_qpProb->cog_list[next_index++] = -1;
       last_constraint = next_index;
     }
     else {
@@ -272,41 +265,41 @@ int generateCoGConstraints(reverseCOG COG_rev[]) {
 /// \brief Calls quadratic solver.
 //
 // --------------------------------------------------------------------
-void solveQuadraticProblem(bool useCOG) {
+void solveQuadraticProblem(PlaceContext *ctx, bool useCOG) {
   int c;
 
-  reverseCOG *COG_rev = malloc(sizeof(reverseCOG)*g_place_numPartitions);
+  reverseCOG *COG_rev = malloc(sizeof(reverseCOG)*ctx->m_numPartitions);
 
-  g_place_qpProb->cog_list = malloc(sizeof(int)*(g_place_numPartitions+g_place_numCells));
-  g_place_qpProb->cog_x = malloc(sizeof(float)*g_place_numPartitions);
-  g_place_qpProb->cog_y = malloc(sizeof(float)*g_place_numPartitions);
+  ctx->m_qpProb->cog_list = malloc(sizeof(int)*(ctx->m_numPartitions+ctx->m_numCells));
+  ctx->m_qpProb->cog_x = malloc(sizeof(float)*ctx->m_numPartitions);
+  ctx->m_qpProb->cog_y = malloc(sizeof(float)*ctx->m_numPartitions);
 
-  // memset(g_place_qpProb->x, 0, sizeof(float)*g_place_numCells);
-  // memset(g_place_qpProb->y, 0, sizeof(float)*g_place_numCells);
+  // memset(ctx->m_qpProb->x, 0, sizeof(float)*ctx->m_numCells);
+  // memset(ctx->m_qpProb->y, 0, sizeof(float)*ctx->m_numCells);
 
-  qps_init(g_place_qpProb);
+  qps_init(ctx->m_qpProb);
 
   if (useCOG)
-      g_place_qpProb->cog_num = generateCoGConstraints(COG_rev);
+      ctx->m_qpProb->cog_num = generateCoGConstraints(ctx, COG_rev);
   else
-      g_place_qpProb->cog_num = 0;
+      ctx->m_qpProb->cog_num = 0;
 
-  g_place_qpProb->loop_num = 0;
+  ctx->m_qpProb->loop_num = 0;
 
-  qps_solve(g_place_qpProb);
+  qps_solve(ctx->m_qpProb);
 
-  qps_clean(g_place_qpProb);
+  qps_clean(ctx->m_qpProb);
 
   // set the positions
-  for(c = 0; c < g_place_numCells; c++) if (g_place_concreteCells[c]) {
-    g_place_concreteCells[c]->m_x = g_place_qpProb->x[c];
-    g_place_concreteCells[c]->m_y = g_place_qpProb->y[c];
+  for(c = 0; c < ctx->m_numCells; c++) if (ctx->m_concreteCells[c]) {
+    ctx->m_concreteCells[c]->m_x = ctx->m_qpProb->x[c];
+    ctx->m_concreteCells[c]->m_y = ctx->m_qpProb->y[c];
   }
   
   // clean up
-  free(g_place_qpProb->cog_list);
-  free(g_place_qpProb->cog_x);
-  free(g_place_qpProb->cog_y);
+  free(ctx->m_qpProb->cog_list);
+  free(ctx->m_qpProb->cog_x);
+  free(ctx->m_qpProb->cog_y);
 
   free(COG_rev);
 }
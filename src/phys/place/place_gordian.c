@@ -20,14 +20,6 @@ ABC_NAMESPACE_IMPL_START
 
 
 
-// --------------------------------------------------------------------
-// Global variables
-//
-// --------------------------------------------------------------------
-
-int g_place_numPartitions;
-
-
 // --------------------------------------------------------------------
 // globalPlace()
 //
@@ -36,49 +28,49 @@ int g_place_numPartitions;
 /// Updates the positions of all non-fixed non-pad cells.
 ///
 // --------------------------------------------------------------------
-void globalPlace() {
+void globalPlace(PlaceContext *ctx) {
   bool completionFlag = false;
   int iteration = 0;  
 
   printf("PLAC-10 : Global placement (wirelength-driven Gordian)\n");
 
-  initPartitioning();
+  initPartitioning(ctx);
 
   // build matrices representing interconnections
   printf("QMAN-00 : \tconstructing initial quadratic problem...\n");
-  constructQuadraticProblem();
+  constructQuadraticProblem(ctx);
 
   // iterate placement until termination condition is met
   while(!completionFlag) {
-    printf("QMAN-01 : \titeration %d numPartitions = %d\n",iteration,g_place_numPartitions);
+    printf("QMAN-01 : \titeration %d numPartitions = %d\n",iteration,ctx->m_numPartitions);
     
     // do the global optimization in each direction
     printf("QMAN-01 : \t\tglobal optimization\n");
-    solveQuadraticProblem(!IGNORE_COG);
+    solveQuadraticProblem(ctx, !IGNORE_COG);
       
     // -------- PARTITIONING BASED CELL SPREADING ------
 
     // bisection
     printf("QMAN-01 : \t\tpartition refinement\n");
-    if (REALLOCATE_PARTITIONS) reallocPartitions();
-    completionFlag |= refinePartitions();
+    if (REALLOCATE_PARTITIONS) reallocPartitions(ctx);
+    completionFlag |= refinePartitions(ctx);
       
-    printf("QMAN-01 : \t\twirelength = %e\n", getTotalWirelength());
+    printf("QMAN-01 : \t\twirelength = %e\n", getTotalWirelength(ctx));
       
     iteration++;
   }
   
   // final global optimization
   printf("QMAN-02 : \t\tfinal pass\n");
-  if (FINAL_REALLOCATE_PARTITIONS) reallocPartitions();
-  solveQuadraticProblem(!IGNORE_COG);
-  printf("QMAN-01 : \t\twirelength = %e\n", getTotalWirelength());
+  if (FINAL_REALLOCATE_PARTITIONS) reallocPartitions(ctx);
+  solveQuadraticProblem(ctx, !IGNORE_COG);
+  printf("QMAN-01 : \t\twirelength = %e\n", getTotalWirelength(ctx));
 
   // clean up
-  sanitizePlacement();
-  printf("QMAN-01 : \t\twirelength = %e\n", getTotalWirelength());
-  globalFixDensity(25, g_place_rowHeight*5);
-  printf("QMAN-01 : \t\twirelength = %e\n", getTotalWirelength());
+  sanitizePlacement(ctx);
+  printf("QMAN-01 : \t\twirelength = %e\n", getTotalWirelength(ctx));
+  globalFixDensity(ctx, 25, ctx->m_rowHeight*5);
+  printf("QMAN-01 : \t\twirelength = %e\n", getTotalWirelength(ctx));
 }
 
 
@@ -91,28 +83,28 @@ void globalPlace() {
 ///
 // --------------------------------------------------------------------
 
-void   globalIncremental() {
-  if (!g_place_rootPartition) {
+void   globalIncremental(PlaceContext *ctx) {
+  if (!ctx->m_rootPartition) {
     printf("WARNING: Can not perform incremental placement\n");
-    globalPlace();
+    globalPlace(ctx);
     return;
   }
 
   printf("PLAC-10 : Incremental global placement\n");
 
-  incrementalPartition();
+  incrementalPartition(ctx);
 
   printf("QMAN-00 : \tconstructing initial quadratic problem...\n");
-  constructQuadraticProblem();
+  constructQuadraticProblem(ctx);
 
-  solveQuadraticProblem(!IGNORE_COG);
-  printf("QMAN-01 : \t\twirelength = %e\n", getTotalWirelength());
+  solveQuadraticProblem(ctx, !IGNORE_COG);
+  printf("QMAN-01 : \t\twirelength = %e\n", getTotalWirelength(ctx));
   
   // clean up
-  sanitizePlacement();
-  printf("QMAN-01 : \t\twirelength = %e\n", getTotalWirelength());
-  globalFixDensity(25, g_place_rowHeight*5);
-  printf("QMAN-01 : \t\twirelength = %e\n", getTotalWirelength());
+  sanitizePlacement(ctx);
+  printf("QMAN-01 : \t\twirelength = %e\n", getTotalWirelength(ctx));
+  globalFixDensity(ctx, 25, ctx->m_rowHeight*5);
+  printf("QMAN-01 : \t\twirelength = %e\n", getTotalWirelength(ctx));
 }
 
 
@@ -122,40 +114,40 @@ void   globalIncremental() {
 /// \brief Moves any cells that are outside of the core bounds to the nearest location within.
 //
 // --------------------------------------------------------------------
-void sanitizePlacement() { 
+void sanitizePlacement(PlaceContext *ctx) { 
   int c;
-  float order_width = g_place_rowHeight;
+  float order_width = ctx->m_rowHeight;
   float x, y, edge, w, h;
   
   printf("QCLN-10 : \tsanitizing placement\n");
 
-  for(c=0; c<g_place_numCells; c++) if (g_place_concreteCells[c]) {
-    ConcreteCell *cell = g_place_concreteCells[c];
+  for(c=0; c<ctx->m_numCells; c++) if (ctx->m_concreteCells[c]) {
+    ConcreteCell *cell = ctx->m_concreteCells[c];
     if (cell->m_fixed || cell->m_parent->m_pad) {
       continue;
     }
     // the new locations of the cells will be distributed within
     // a small margin inside the border so that ordering is preserved
-    order_width = g_place_rowHeight;
+    order_width = ctx->m_rowHeight;
 
     x = cell->m_x, y = cell->m_y,
       w = cell->m_parent->m_width, h = cell->m_parent->m_height;
 
-    if ((edge=x-w*0.5) < g_place_coreBounds.x) {
-      x = g_place_coreBounds.x+w*0.5 +
-        order_width/(1.0+g_place_coreBounds.x-edge);
+    if ((edge=x-w*0.5) < ctx->m_coreBounds.x) {
+      x = ctx->m_coreBounds.x+w*0.5 +
+        order_width/(1.0+ctx->m_coreBounds.x-edge);
     }
-    else if ((edge=x+w*0.5) > g_place_coreBounds.x+g_place_coreBounds.w) {
-      x = g_place_coreBounds.x+g_place_coreBounds.w-w*0.5 -
-        order_width/(1.0+edge-g_place_coreBounds.x-g_place_coreBounds.w);
+    else if ((edge=x+w*0.5) > ctx->m_coreBounds.x+ctx->m_coreBounds.w) {
+      x = ctx->m_coreBounds.x+ctx->m_coreBounds.w-w*0.5 -
+        order_width/(1.0+edge-ctx->m_coreBounds.x-ctx->m_coreBounds.w);
     }
-    if ((edge=y-h*0.5) < g_place_coreBounds.y) {
-      y = g_place_coreBounds.y+h*0.5 +
-        order_width/(1.0+g_place_coreBounds.y-edge);
+    if ((edge=y-h*0.5) < ctx->m_coreBounds.y) {
+      y = ctx->m_coreBounds.y+h*0.5 +
+        order_width/(1.0+ctx->m_coreBounds.y-edge);
     }
-    else if ((edge=y+h*0.5) > g_place_coreBounds.y+g_place_coreBounds.h) {
-      y = g_place_coreBounds.y+g_place_coreBounds.h-h*0.5 -
-        order_width/(1.0+edge-g_place_coreBounds.x-g_place_coreBounds.w);
+    else if ((edge=y+h*0.5) > ctx->m_coreBounds.y+ctx->m_coreBounds.h) {
+      y = ctx->m_coreBounds.y+ctx->m_coreBounds.h-h*0.5 -
+        order_width/(1.0+edge-ctx->m_coreBounds.x-ctx->m_coreBounds.w);
     }
     cell->m_x = x;
     cell->m_y = y;
@@ -7,7 +7,7 @@
 //
 /*===================================================================*/
 
-#if !defined(PLACE_GORDIAN_H_)
+#ifndef ABC__phys__place__place_gordian_h
 #define ABC__phys__place__place_gordian_h
 
 
@@ -39,10 +39,6 @@ ABC_NAMESPACE_HEADER_START
 #define FM_MAX_BIN 10
 #define FM_MAX_PASSES 10
 
-extern int g_place_numPartitions;
-
-extern qps_problem_t *g_place_qpProb;
-
 typedef struct Partition {
 
   int               m_numMembers;
@@ -56,28 +52,28 @@ typedef struct Partition {
   struct Partition *m_sub1, *m_sub2;
 } Partition;
 
-extern Partition *g_place_rootPartition;
-
-void initPartitioning();
+void initPartitioning(PlaceContext *ctx);
+void freePartition(Partition *p);
 
-void incrementalPartition();
+void incrementalPartition(PlaceContext *ctx);
 
-bool refinePartitions();
-void reallocPartitions();
-bool refinePartition(Partition *p);
+bool refinePartitions(PlaceContext *ctx);
+void reallocPartitions(PlaceContext *ctx);
+bool refinePartition(PlaceContext *ctx, Partition *p);
+bool refinePartitionThreads(PlaceContext *ctx, Partition *p, int numThreads);
 void resizePartition(Partition *p);
-void reallocPartition(Partition *p);
+void reallocPartition(PlaceContext *ctx, Partition *p);
 
-void repartitionHMetis(Partition *parent);
+void repartitionHMetis(PlaceContext *ctx, Partition *parent);
 void repartitionFM(Partition *parent);
 
 void partitionScanlineMincut(Partition *parent);
 void partitionEqualArea(Partition *parent);
 
-void sanitizePlacement();
+void sanitizePlacement(PlaceContext *ctx);
 
-void constructQuadraticProblem();
-void solveQuadraticProblem(bool useCOG);
+void constructQuadraticProblem(PlaceContext *ctx);
+void solveQuadraticProblem(PlaceContext *ctx, bool useCOG);
 
 
 
@@ -23,7 +23,7 @@ ABC_NAMESPACE_IMPL_START
 // writeBookshelfNodes()
 //
 // --------------------------------------------------------------------
-void writeBookshelfNodes(const char *filename) {
+void writeBookshelfNodes(PlaceContext *ctx, const char *filename) {
   
   int c = 0;
   int numNodes, numTerms;
@@ -35,9 +35,9 @@ void writeBookshelfNodes(const char *filename) {
   }
 
   numNodes = numTerms = 0;
-  for(c=0; c<g_place_numCells; c++) if (g_place_concreteCells[c]) {
+  for(c=0; c<ctx->m_numCells; c++) if (ctx->m_concreteCells[c]) {
       numNodes++;
-      if (g_place_concreteCells[c]->m_parent->m_pad)
+      if (ctx->m_concreteCells[c]->m_parent->m_pad)
         numTerms++;
     }
 
@@ -47,12 +47,12 @@ void writeBookshelfNodes(const char *filename) {
   fprintf(nodesFile, "NumNodes : %d\n", numNodes);
   fprintf(nodesFile, "NumTerminals : %d\n", numTerms);
 
-  for(c=0; c<g_place_numCells; c++) if (g_place_concreteCells[c]) {
+  for(c=0; c<ctx->m_numCells; c++) if (ctx->m_concreteCells[c]) {
     fprintf(nodesFile, "CELL%d %f %f %s\n", 
-            g_place_concreteCells[c]->m_id,
-            g_place_concreteCells[c]->m_parent->m_width,
-            g_place_concreteCells[c]->m_parent->m_height,
-            (g_place_concreteCells[c]->m_parent->m_pad ? " terminal" : ""));
+            ctx->m_concreteCells[c]->m_id,
+            ctx->m_concreteCells[c]->m_parent->m_width,
+            ctx->m_concreteCells[c]->m_parent->m_height,
+            (ctx->m_concreteCells[c]->m_parent->m_pad ? " terminal" : ""));
   }
 
   fclose(nodesFile);  
@@ -63,7 +63,7 @@ void writeBookshelfNodes(const char *filename) {
 // writeBookshelfPl()
 //
 // --------------------------------------------------------------------
-void writeBookshelfPl(const char *filename) {
+void writeBookshelfPl(PlaceContext *ctx, const char *filename) {
   
   int c = 0;
 
@@ -74,12 +74,12 @@ void writeBookshelfPl(const char *filename) {
   }
 
   fprintf(plFile, "UCLA pl 1.0\n");
-  for(c=0; c<g_place_numCells; c++)  if (g_place_concreteCells[c]) {
+  for(c=0; c<ctx->m_numCells; c++)  if (ctx->m_concreteCells[c]) {
     fprintf(plFile, "CELL%d %f %f : N %s\n", 
-            g_place_concreteCells[c]->m_id,
-            g_place_concreteCells[c]->m_x,
-            g_place_concreteCells[c]->m_y,
-            (g_place_concreteCells[c]->m_fixed ? "\\FIXED" : ""));
+            ctx->m_concreteCells[c]->m_id,
+            ctx->m_concreteCells[c]->m_x,
+            ctx->m_concreteCells[c]->m_y,
+            (ctx->m_concreteCells[c]->m_fixed ? "\\FIXED" : ""));
   }
 
   fclose(plFile);  
@@ -91,9 +91,9 @@ void writeBookshelfPl(const char *filename) {
 // writeBookshelf()
 //
 // --------------------------------------------------------------------
-void writeBookshelf(const char *filename) {
-  writeBookshelfNodes("out.nodes");
-  writeBookshelfPl("out.pl");
+void writeBookshelf(PlaceContext *ctx, const char *filename) {
+  writeBookshelfNodes(ctx, "out.nodes");
+  writeBookshelfPl(ctx, "out.pl");
 }
 ABC_NAMESPACE_IMPL_END
 
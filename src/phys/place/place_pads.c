@@ -24,11 +24,11 @@ ABC_NAMESPACE_IMPL_START
 //
 /// Sets the position of pads that aren't already fixed.
 ///
-/// Computes g_place_coreBounds and g_place_padBounds.  Determines
-/// g_place_rowHeight.
+/// Computes ctx->m_coreBounds and ctx->m_padBounds.  Determines
+/// ctx->m_rowHeight.
 //
 // --------------------------------------------------------------------
-void globalPreplace(float utilization) {
+void globalPreplace(PlaceContext *ctx, float utilization) {
   int i, c, h, numRows;
   float coreArea = 0, totalArea = 0;
   int padCount = 0;
@@ -42,24 +42,24 @@ void globalPreplace(float utilization) {
   printf("PLAC-00 : Placing IO pads\n");;
 
   // identify the pads and compute the total core area
-  g_place_coreBounds.x = g_place_coreBounds.y = 0;
-  g_place_coreBounds.w = g_place_coreBounds.h = -INT_MAX;
+  ctx->m_coreBounds.x = ctx->m_coreBounds.y = 0;
+  ctx->m_coreBounds.w = ctx->m_coreBounds.h = -INT_MAX;
 
-  for(c=0; c<g_place_numCells; c++) if (g_place_concreteCells[c]) {
-    cell = g_place_concreteCells[c];
+  for(c=0; c<ctx->m_numCells; c++) if (ctx->m_concreteCells[c]) {
+    cell = ctx->m_concreteCells[c];
     area = getCellArea(cell);
     if (cell->m_parent->m_pad) {
       padType = cell->m_parent;
     } else {
       coreArea += area;
-      g_place_rowHeight = cell->m_parent->m_height;
+      ctx->m_rowHeight = cell->m_parent->m_height;
     }
 
     if (cell->m_fixed) {
-      g_place_coreBounds.x = g_place_coreBounds.x < cell->m_x ? g_place_coreBounds.x : cell->m_x;
-      g_place_coreBounds.y = g_place_coreBounds.y < cell->m_y ? g_place_coreBounds.y : cell->m_y;
-      g_place_coreBounds.w = g_place_coreBounds.w > cell->m_x ? g_place_coreBounds.w : cell->m_x;
-      g_place_coreBounds.h = g_place_coreBounds.h > cell->m_y ? g_place_coreBounds.h : cell->m_y;
+      ctx->m_coreBounds.x = ctx->m_coreBounds.x < cell->m_x ? ctx->m_coreBounds.x : cell->m_x;
+      ctx->m_coreBounds.y = ctx->m_coreBounds.y < cell->m_y ? ctx->m_coreBounds.y : cell->m_y;
+      ctx->m_coreBounds.w = ctx->m_coreBounds.w > cell->m_x ? ctx->m_coreBounds.w : cell->m_x;
+      ctx->m_coreBounds.h = ctx->m_coreBounds.h > cell->m_y ? ctx->m_coreBounds.h : cell->m_y;
     } else if (cell->m_parent->m_pad) {
       padCells = realloc(padCells, sizeof(ConcreteCell **)*(padCount+1));
       padCells[padCount++] = cell;
@@ -70,32 +70,32 @@ void globalPreplace(float utilization) {
     printf("ERROR: No pad cells\n");
     exit(1);
   }
-  g_place_padBounds.w -= g_place_padBounds.x;
-  g_place_padBounds.h -= g_place_padBounds.y;
+  ctx->m_padBounds.w -= ctx->m_padBounds.x;
+  ctx->m_padBounds.h -= ctx->m_padBounds.y;
 
   coreArea /= utilization;
 
   // create the design boundaries
-  numRows = sqrt(coreArea)/g_place_rowHeight+1;
-  h = numRows * g_place_rowHeight;
-  g_place_coreBounds.h = g_place_coreBounds.h > h ? g_place_coreBounds.h : h;
-  g_place_coreBounds.w = g_place_coreBounds.w > coreArea/g_place_coreBounds.h ? 
-    g_place_coreBounds.w : coreArea/g_place_coreBounds.h;
+  numRows = sqrt(coreArea)/ctx->m_rowHeight+1;
+  h = numRows * ctx->m_rowHeight;
+  ctx->m_coreBounds.h = ctx->m_coreBounds.h > h ? ctx->m_coreBounds.h : h;
+  ctx->m_coreBounds.w = ctx->m_coreBounds.w > coreArea/ctx->m_coreBounds.h ? 
+    ctx->m_coreBounds.w : coreArea/ctx->m_coreBounds.h;
   // increase the dimensions by the width of the padring
-  g_place_padBounds = g_place_coreBounds;
+  ctx->m_padBounds = ctx->m_coreBounds;
   if (padCount) {
     printf("PLAC-05 : \tpreplacing %d pad cells\n", padCount);
-    g_place_padBounds.x -= padType->m_width;
-    g_place_padBounds.y -= padType->m_height;
-    g_place_padBounds.w = g_place_coreBounds.w+2*padType->m_width;
-    g_place_padBounds.h = g_place_coreBounds.h+2*padType->m_height;
+    ctx->m_padBounds.x -= padType->m_width;
+    ctx->m_padBounds.y -= padType->m_height;
+    ctx->m_padBounds.w = ctx->m_coreBounds.w+2*padType->m_width;
+    ctx->m_padBounds.h = ctx->m_coreBounds.h+2*padType->m_height;
   }
 
   printf("PLAC-05 : \tplaceable rows  : %d\n", numRows);
   printf("PLAC-05 : \tcore dimensions : %.0fx%.0f\n",
-         g_place_coreBounds.w, g_place_coreBounds.h);
+         ctx->m_coreBounds.w, ctx->m_coreBounds.h);
   printf("PLAC-05 : \tchip dimensions : %.0fx%.0f\n",
-         g_place_padBounds.w, g_place_padBounds.h);
+         ctx->m_padBounds.w, ctx->m_padBounds.h);
   
   remainingPads = padCount;
   c = 0;
@@ -105,9 +105,9 @@ void globalPreplace(float utilization) {
   nextPos = 0;
   for(i=0; i<northPads; i++) {
     cell = padCells[c++];
-    cell->m_x = g_place_padBounds.x+cell->m_parent->m_width*0.5 + nextPos;
-    cell->m_y = g_place_padBounds.y+cell->m_parent->m_height*0.5;
-    nextPos += (g_place_padBounds.w-padType->m_width) / northPads;
+    cell->m_x = ctx->m_padBounds.x+cell->m_parent->m_width*0.5 + nextPos;
+    cell->m_y = ctx->m_padBounds.y+cell->m_parent->m_height*0.5;
+    nextPos += (ctx->m_padBounds.w-padType->m_width) / northPads;
   }
   
   // south pads
@@ -115,9 +115,9 @@ void globalPreplace(float utilization) {
   nextPos = 0;
   for(i=0; i<southPads; i++) {
     cell = padCells[c++];
-    cell->m_x = g_place_padBounds.w+g_place_padBounds.x-cell->m_parent->m_width*0.5 - nextPos;
-    cell->m_y = g_place_padBounds.h+g_place_padBounds.y-cell->m_parent->m_height*0.5;
-    nextPos += (g_place_padBounds.w-2*padType->m_width) / southPads;
+    cell->m_x = ctx->m_padBounds.w+ctx->m_padBounds.x-cell->m_parent->m_width*0.5 - nextPos;
+    cell->m_y = ctx->m_padBounds.h+ctx->m_padBounds.y-cell->m_parent->m_height*0.5;
+    nextPos += (ctx->m_padBounds.w-2*padType->m_width) / southPads;
   }
 
   // east pads
@@ -125,9 +125,9 @@ void globalPreplace(float utilization) {
   nextPos = 0;
   for(i=0; i<eastPads; i++) {
     cell = padCells[c++];
-    cell->m_x = g_place_padBounds.w+g_place_padBounds.x-cell->m_parent->m_width*0.5;
-    cell->m_y = g_place_padBounds.y+cell->m_parent->m_height*0.5 + nextPos;
-    nextPos += (g_place_padBounds.h-padType->m_height) / eastPads;
+    cell->m_x = ctx->m_padBounds.w+ctx->m_padBounds.x-cell->m_parent->m_width*0.5;
+    cell->m_y = ctx->m_padBounds.y+cell->m_parent->m_height*0.5 + nextPos;
+    nextPos += (ctx->m_padBounds.h-padType->m_height) / eastPads;
   }
 
   // west pads
@@ -135,9 +135,9 @@ void globalPreplace(float utilization) {
   nextPos = 0;
   for(i=0; i<westPads; i++) {
     cell = padCells[c++];
-    cell->m_x = g_place_padBounds.x+cell->m_parent->m_width*0.5;
-    cell->m_y = g_place_padBounds.h+g_place_padBounds.y-cell->m_parent->m_height*0.5 - nextPos;
-    nextPos += (g_place_padBounds.h-padType->m_height) / westPads;
+    cell->m_x = ctx->m_padBounds.x+cell->m_parent->m_width*0.5;
+    cell->m_y = ctx->m_padBounds.h+ctx->m_padBounds.y-cell->m_parent->m_height*0.5 - nextPos;
+    nextPos += (ctx->m_padBounds.h-padType->m_height) / westPads;
   }
 
 }
@@ -19,23 +19,19 @@
 #include "place_base.h"
 #include "place_gordian.h"
 
+#if defined(ABC_USE_PTHREADS)
+#ifdef _WIN32
+#include "../lib/pthread.h"
+#else
+#include <pthread.h>
+#endif
+#endif
+
 #if !defined(NO_HMETIS)
 #include "libhmetis.h"
-
-ABC_NAMESPACE_IMPL_START
-
 #endif
 
-// --------------------------------------------------------------------
-// Global variables
-//
-// --------------------------------------------------------------------
-
-Partition *g_place_rootPartition = NULL;
-ConcreteNet **allNetsR2 = NULL, 
-  **allNetsL2 = NULL, 
-  **allNetsB2 = NULL, 
-  **allNetsT2 = NULL;
+ABC_NAMESPACE_IMPL_START
 
 
 // --------------------------------------------------------------------
@@ -55,45 +51,66 @@ void FM_updateGains(ConcreteNet *net, int partition, int inc,
                     FM_cell target [], FM_cell *bin [], 
                     int count_1 [], int count_2 []);
 
+#if defined(ABC_USE_PTHREADS) && !defined(NO_HMETIS)
+// hMetis keeps global state, so all contexts share one lock
+static pthread_mutex_t s_hmetisLock = PTHREAD_MUTEX_INITIALIZER;
+#endif
+
 
 // --------------------------------------------------------------------
 // initPartitioning()
 //
 /// \brief Initializes data structures necessary for partitioning.
 //
-/// Creates a valid g_place_rootPartition.
+/// Creates a valid ctx->m_rootPartition.
 ///
 // --------------------------------------------------------------------
-void initPartitioning() {
+void initPartitioning(PlaceContext *ctx) {
   int i;
   float area;
 
   // create root partition
-  g_place_numPartitions = 1;
-  if (g_place_rootPartition) free(g_place_rootPartition);
-  g_place_rootPartition = malloc(sizeof(Partition));
-  g_place_rootPartition->m_level = 0;
-  g_place_rootPartition->m_area = 0;
-  g_place_rootPartition->m_bounds = g_place_coreBounds;
-  g_place_rootPartition->m_vertical = false;
-  g_place_rootPartition->m_done = false;
-  g_place_rootPartition->m_leaf = true;
+  ctx->m_numPartitions = 1;
+  if (ctx->m_rootPartition) freePartition(ctx->m_rootPartition);
+  ctx->m_rootPartition = malloc(sizeof(Partition));
+  ctx->m_rootPartition->m_level = 0;
+  ctx->m_rootPartition->m_area = 0;
+  ctx->m_rootPartition->m_bounds = ctx->m_coreBounds;
+  ctx->m_rootPartition->m_vertical = false;
+  ctx->m_rootPartition->m_done = false;
+  ctx->m_rootPartition->m_leaf = true;
       
   // add all of the cells to this partition
-  g_place_rootPartition->m_members = malloc(sizeof(ConcreteCell*)*g_place_numCells);
-  g_place_rootPartition->m_numMembers = 0;
-  for (i=0; i<g_place_numCells; i++) 
-    if (g_place_concreteCells[i]) {
-      if (!g_place_concreteCells[i]->m_fixed) {
-        area = getCellArea(g_place_concreteCells[i]);
-        g_place_rootPartition->m_members[g_place_rootPartition->m_numMembers++] =
-          g_place_concreteCells[i];
-        g_place_rootPartition->m_area += area;
+  ctx->m_rootPartition->m_members = malloc(sizeof(ConcreteCell*)*ctx->m_numCells);
+  ctx->m_rootPartition->m_numMembers = 0;
+  for (i=0; i<ctx->m_numCells; i++) 
+    if (ctx->m_concreteCells[i]) {
+      if (!ctx->m_concreteCells[i]->m_fixed) {
+        area = getCellArea(ctx->m_concreteCells[i]);
+        ctx->m_rootPartition->m_members[ctx->m_rootPartition->m_numMembers++] =
+          ctx->m_concreteCells[i];
+        ctx->m_rootPartition->m_area += area;
       }
     }
 }
 
 
+// --------------------------------------------------------------------
+// freePartition()
+//
+/// \brief Deallocates a partition and all of its children.
+//
+// --------------------------------------------------------------------
+void freePartition(Partition *p) {
+  if (!p->m_leaf) {
+    freePartition(p->m_sub1);
+    freePartition(p->m_sub2);
+  }
+  free(p->m_members);
+  free(p);
+}
+
+
 // --------------------------------------------------------------------
 // presortNets()
 //
@@ -102,19 +119,19 @@ void initPartitioning() {
 /// Allocates allNetsX2 structures.
 ///
 // --------------------------------------------------------------------
-void presortNets() {
-  allNetsL2 = (ConcreteNet**)realloc(allNetsL2, sizeof(ConcreteNet*)*g_place_numNets);
-  allNetsR2 = (ConcreteNet**)realloc(allNetsR2, sizeof(ConcreteNet*)*g_place_numNets);
-  allNetsB2 = (ConcreteNet**)realloc(allNetsB2, sizeof(ConcreteNet*)*g_place_numNets);
-  allNetsT2 = (ConcreteNet**)realloc(allNetsT2, sizeof(ConcreteNet*)*g_place_numNets);
-  memcpy(allNetsL2, (size_t)g_place_concreteNets, sizeof(ConcreteNet*)*g_place_numNets);
-  memcpy(allNetsR2, (size_t)g_place_concreteNets, sizeof(ConcreteNet*)*g_place_numNets);
-  memcpy(allNetsB2, (size_t)g_place_concreteNets, sizeof(ConcreteNet*)*g_place_numNets);
-  memcpy(allNetsT2, (size_t)g_place_concreteNets, sizeof(ConcreteNet*)*g_place_numNets);
-  qsort(allNetsL2, (size_t)g_place_numNets, sizeof(ConcreteNet*), netSortByL);
-  qsort(allNetsR2, (size_t)g_place_numNets, sizeof(ConcreteNet*), netSortByR);
-  qsort(allNetsB2, (size_t)g_place_numNets, sizeof(ConcreteNet*), netSortByB);
-  qsort(allNetsT2, (size_t)g_place_numNets, sizeof(ConcreteNet*), netSortByT);
+void presortNets(PlaceContext *ctx) {
+  ctx->m_allNetsL2 = (ConcreteNet**)realloc(ctx->m_allNetsL2, sizeof(ConcreteNet*)*ctx->m_numNets);
+  ctx->m_allNetsR2 = (ConcreteNet**)realloc(ctx->m_allNetsR2, sizeof(ConcreteNet*)*ctx->m_numNets);
+  ctx->m_allNetsB2 = (ConcreteNet**)realloc(ctx->m_allNetsB2, sizeof(ConcreteNet*)*ctx->m_numNets);
+  ctx->m_allNetsT2 = (ConcreteNet**)realloc(ctx->m_allNetsT2, sizeof(ConcreteNet*)*ctx->m_numNets);
+  memcpy(ctx->m_allNetsL2, ctx->m_concreteNets, sizeof(ConcreteNet*)*ctx->m_numNets);
+  memcpy(ctx->m_allNetsR2, ctx->m_concreteNets, sizeof(ConcreteNet*)*ctx->m_numNets);
+  memcpy(ctx->m_allNetsB2, ctx->m_concreteNets, sizeof(ConcreteNet*)*ctx->m_numNets);
+  memcpy(ctx->m_allNetsT2, ctx->m_concreteNets, sizeof(ConcreteNet*)*ctx->m_numNets);
+  qsort(ctx->m_allNetsL2, (size_t)ctx->m_numNets, sizeof(ConcreteNet*), netSortByL);
+  qsort(ctx->m_allNetsR2, (size_t)ctx->m_numNets, sizeof(ConcreteNet*), netSortByR);
+  qsort(ctx->m_allNetsB2, (size_t)ctx->m_numNets, sizeof(ConcreteNet*), netSortByB);
+  qsort(ctx->m_allNetsT2, (size_t)ctx->m_numNets, sizeof(ConcreteNet*), netSortByT);
 }
 
 // --------------------------------------------------------------------
@@ -123,9 +140,9 @@ void presortNets() {
 /// \brief Splits large leaf partitions.
 //
 // --------------------------------------------------------------------
-bool refinePartitions() {
+bool refinePartitions(PlaceContext *ctx) {
 
-  return refinePartition(g_place_rootPartition);
+  return refinePartitionThreads(ctx, ctx->m_rootPartition, ctx->m_numThreads);
 }
 
 
@@ -135,9 +152,60 @@ bool refinePartitions() {
 /// \brief Reallocates the partitions based on placement information.
 //
 // --------------------------------------------------------------------
-void reallocPartitions() {
+void reallocPartitions(PlaceContext *ctx) {
+
+  reallocPartition(ctx, ctx->m_rootPartition);
+}
+
+
+// --------------------------------------------------------------------
+// refinePartitionThreads()
+//
+/// \brief Splits any large leaves within a partition using several threads.
+///
+/// The two children of a non-leaf partition are refined concurrently, 
+/// each with half of the threads, so the leaves at the bottom are split 
+/// in parallel.  The results are the same as those of refinePartition().
+//
+// --------------------------------------------------------------------
+#if defined(ABC_USE_PTHREADS)
+
+typedef struct RefineJob {
+  PlaceContext *ctx;
+  Partition    *part;
+  int           numThreads;
+  bool          done;
+} RefineJob;
+
+static void *refinePartitionWorker(void *arg) {
+  RefineJob *job = (RefineJob *)arg;
+  job->done = refinePartitionThreads(job->ctx, job->part, job->numThreads);
+  return NULL;
+}
 
-  reallocPartition(g_place_rootPartition);
+#endif
+
+bool refinePartitionThreads(PlaceContext *ctx, Partition *p, int numThreads) {
+#if defined(ABC_USE_PTHREADS)
+  RefineJob job;
+  pthread_t thread;
+  bool done2;
+
+  assert(p);
+  if (numThreads > 1 && !p->m_done && !p->m_leaf) {
+    job.ctx = ctx;
+    job.part = p->m_sub1;
+    job.numThreads = numThreads / 2;
+    job.done = false;
+    if (pthread_create(&thread, NULL, refinePartitionWorker, &job) == 0) {
+      done2 = refinePartitionThreads(ctx, p->m_sub2, numThreads - numThreads / 2);
+      pthread_join(thread, NULL);
+      p->m_done = job.done && done2;
+      return p->m_done;
+    }
+  }
+#endif
+  return refinePartition(ctx, p);
 }
 
 
@@ -147,7 +215,7 @@ void reallocPartitions() {
 /// \brief Splits any large leaves within a partition.
 //
 // --------------------------------------------------------------------
-bool refinePartition(Partition *p) {
+bool refinePartition(PlaceContext *ctx, Partition *p) {
   bool degenerate = false;
   int nonzeroCount = 0;
   int i;
@@ -159,14 +227,20 @@ bool refinePartition(Partition *p) {
 
   // is this partition a non-leaf node?
   if (!p->m_leaf) {
-    p->m_done = refinePartition(p->m_sub1);
-    p->m_done &= refinePartition(p->m_sub2);
+    p->m_done = refinePartition(ctx, p->m_sub1);
+    p->m_done &= refinePartition(ctx, p->m_sub2);
     return p->m_done;
   }
   
   // leaf...
   // create two new subpartitions
-  g_place_numPartitions++;
+#if defined(ABC_USE_PTHREADS)
+  pthread_mutex_lock((pthread_mutex_t *)ctx->m_lock);
+  ctx->m_numPartitions++;
+  pthread_mutex_unlock((pthread_mutex_t *)ctx->m_lock);
+#else
+  ctx->m_numPartitions++;
+#endif
   p->m_sub1 = malloc(sizeof(Partition));
   p->m_sub1->m_level = p->m_level+1;
   p->m_sub1->m_leaf = true;
@@ -200,7 +274,7 @@ bool refinePartition(Partition *p) {
     if (REPARTITION_FM)
       repartitionFM(p);
     else if (REPARTITION_HMETIS)
-      repartitionHMetis(p);
+      repartitionHMetis(ctx, p);
   }
     
   resizePartition(p);
@@ -255,7 +329,7 @@ bool refinePartition(Partition *p) {
 /// The number of cut nets between the two partitions will be minimized.
 //
 // --------------------------------------------------------------------
-void repartitionHMetis(Partition *parent) {
+void repartitionHMetis(PlaceContext *ctx, Partition *parent) {
 #if defined(NO_HMETIS)
   printf("QPAR_02 : \t\tERROR: hMetis not available.  Ignoring.\n");
 #else
@@ -263,9 +337,9 @@ void repartitionHMetis(Partition *parent) {
   int n,c,t, i;
   float area;
   int *edgeConnections = NULL;
-  int *partitionAssignment = (int *)calloc(g_place_numCells, sizeof(int));
-  int *vertexWeights = (int *)calloc(g_place_numCells, sizeof(int));
-  int *edgeDegree = (int *)malloc(sizeof(int)*(g_place_numNets+1));
+  int *partitionAssignment = (int *)calloc(ctx->m_numCells, sizeof(int));
+  int *vertexWeights = (int *)calloc(ctx->m_numCells, sizeof(int));
+  int *edgeDegree = (int *)malloc(sizeof(int)*(ctx->m_numNets+1));
   int numConnections = 0;
   int numEdges = 0;
   float initial_cut;
@@ -282,9 +356,9 @@ void repartitionHMetis(Partition *parent) {
 
   // count edges
   edgeDegree[0] = 0;
-  for(n=0; n<g_place_numNets; n++) if (g_place_concreteNets[n])
-    if (g_place_concreteNets[n]->m_numTerms > 1) {
-      numConnections += g_place_concreteNets[n]->m_numTerms;
+  for(n=0; n<ctx->m_numNets; n++) if (ctx->m_concreteNets[n])
+    if (ctx->m_concreteNets[n]->m_numTerms > 1) {
+      numConnections += ctx->m_concreteNets[n]->m_numTerms;
       edgeDegree[++numEdges] = numConnections;
     }
   
@@ -293,8 +367,8 @@ void repartitionHMetis(Partition *parent) {
     initial_cut = parent->m_sub2->m_bounds.x;
     
     // initialize all cells
-    for(c=0; c<g_place_numCells; c++) if (g_place_concreteCells[c]) {
-      if (g_place_concreteCells[c]->m_x < initial_cut)
+    for(c=0; c<ctx->m_numCells; c++) if (ctx->m_concreteCells[c]) {
+      if (ctx->m_concreteCells[c]->m_x < initial_cut)
         partitionAssignment[c] = 0;
       else
         partitionAssignment[c] = 1;
@@ -327,8 +401,8 @@ void repartitionHMetis(Partition *parent) {
     initial_cut = parent->m_sub2->m_bounds.y;
     
     // initialize all cells
-    for(c=0; c<g_place_numCells; c++) if (g_place_concreteCells[c]) {
-      if (g_place_concreteCells[c]->m_y < initial_cut)
+    for(c=0; c<ctx->m_numCells; c++) if (ctx->m_concreteCells[c]) {
+      if (ctx->m_concreteCells[c]->m_y < initial_cut)
         partitionAssignment[c] = 0;
       else
         partitionAssignment[c] = 1;
@@ -370,16 +444,23 @@ void repartitionHMetis(Partition *parent) {
   edgeConnections = (int *)malloc(sizeof(int)*numConnections);
 
   i = 0;
-  for(n=0; n<g_place_numNets; n++) if (g_place_concreteNets[n]) {
-    if (g_place_concreteNets[n]->m_numTerms > 1)
-      for(t=0; t<g_place_concreteNets[n]->m_numTerms; t++)
-        edgeConnections[i++] = g_place_concreteNets[n]->m_terms[t]->m_id;
+  for(n=0; n<ctx->m_numNets; n++) if (ctx->m_concreteNets[n]) {
+    if (ctx->m_concreteNets[n]->m_numTerms > 1)
+      for(t=0; t<ctx->m_concreteNets[n]->m_numTerms; t++)
+        edgeConnections[i++] = ctx->m_concreteNets[n]->m_terms[t]->m_id;
   }
 
-  HMETIS_PartRecursive(g_place_numCells, numEdges, vertexWeights,
+  // hMetis is not reentrant
+#if defined(ABC_USE_PTHREADS)
+  pthread_mutex_lock(&s_hmetisLock);
+#endif
+  HMETIS_PartRecursive(ctx->m_numCells, numEdges, vertexWeights,
                edgeDegree, edgeConnections, NULL,
                2, (int)(100*MAX_PARTITION_NONSYMMETRY),
                options, partitionAssignment, &afterCuts);
+#if defined(ABC_USE_PTHREADS)
+  pthread_mutex_unlock(&s_hmetisLock);
+#endif
     
   /*
   printf("HMET-20 : \t\t\tbalance before %d / %d ... ", parent->m_sub1->m_numMembers,
@@ -910,14 +991,14 @@ void partitionScanlineMincut(Partition *parent) {
       if (currentArea > halfArea+areaFlexibility)
     break;
       newLine = (*local)->temp_x;
-      while(all1 < g_place_numNets && allNetsL2[all1]->getBoundingBox().left() <= newLine) {
-    if(allNetsL2[all1]->m_mark) {
+      while(all1 < ctx->m_numNets && ctx->m_allNetsL2[all1]->getBoundingBox().left() <= newLine) {
+    if(ctx->m_allNetsL2[all1]->m_mark) {
       current_cuts++;
     }
     all1++;
       }
-      while(all2 < g_place_numNets && allNetsR2[all2]->getBoundingBox().right() <= newLine) {
-    if(allNetsR2[all2]->m_mark) {
+      while(all2 < ctx->m_numNets && ctx->m_allNetsR2[all2]->getBoundingBox().right() <= newLine) {
+    if(ctx->m_allNetsR2[all2]->m_mark) {
       current_cuts--;
     }
     all2++;
@@ -940,14 +1021,14 @@ void partitionScanlineMincut(Partition *parent) {
       if (currentArea > halfArea+areaFlexibility)
     break;
       newLine = (*local)->temp_y;
-      while(all1 < g_place_numNets && allNetsB2[all1]->getBoundingBox().top() <= newLine) {
-    if(allNetsB2[all1]->m_mark) {
+      while(all1 < ctx->m_numNets && ctx->m_allNetsB2[all1]->getBoundingBox().top() <= newLine) {
+    if(ctx->m_allNetsB2[all1]->m_mark) {
       current_cuts++;
     }
     all1++;
       }
-      while(all2 < g_place_numNets && allNetsT2[all2]->getBoundingBox().bottom() <= newLine) {
-    if(allNetsT2[all2]->m_mark) {
+      while(all2 < ctx->m_numNets && ctx->m_allNetsT2[all2]->getBoundingBox().bottom() <= newLine) {
+    if(ctx->m_allNetsT2[all2]->m_mark) {
       current_cuts--;
     }
     all2++;
@@ -985,7 +1066,7 @@ void partitionScanlineMincut(Partition *parent) {
 /// \brief Reallocates a partition and all of its children.
 //
 // --------------------------------------------------------------------
-void reallocPartition(Partition *p) {
+void reallocPartition(PlaceContext *ctx, Partition *p) {
 
   if (p->m_leaf) {
     return;
@@ -1003,13 +1084,13 @@ void reallocPartition(Partition *p) {
   // --- PARTITION IMPROVEMENT
   if (p->m_level < REPARTITION_LEVEL_DEPTH) {
     if (REPARTITION_HMETIS)
-      repartitionHMetis(p);
+      repartitionHMetis(ctx, p);
     
     resizePartition(p);
   }
 
-  reallocPartition(p->m_sub1);
-  reallocPartition(p->m_sub2);
+  reallocPartition(ctx, p->m_sub1);
+  reallocPartition(ctx, p->m_sub2);
 }
 
 
@@ -1100,30 +1181,30 @@ void incrementalSubpartition(Partition *p, ConcreteCell *newCells [], const int
 /// The function recurses, adding new cells to appropriate subpartitions.
 //
 // --------------------------------------------------------------------
-void incrementalPartition() {
+void incrementalPartition(PlaceContext *ctx) {
   int c = 0, c2 = 0;
   int numNewCells = 0;
-  ConcreteCell **allCells = (ConcreteCell **)malloc(sizeof(ConcreteCell*)*g_place_numCells),
-    **newCells = (ConcreteCell **)malloc(sizeof(ConcreteCell*)*g_place_numCells);
+  ConcreteCell **allCells = (ConcreteCell **)malloc(sizeof(ConcreteCell*)*ctx->m_numCells),
+    **newCells = (ConcreteCell **)malloc(sizeof(ConcreteCell*)*ctx->m_numCells);
 
-  assert(g_place_rootPartition);
+  assert(ctx->m_rootPartition);
 
   // update cell list of root partition
-  memcpy(allCells, (size_t)g_place_concreteCells, sizeof(ConcreteCell*)*g_place_numCells);
-  qsort(allCells, (size_t)g_place_numCells, sizeof(ConcreteCell*), cellSortByID);
-  qsort(g_place_rootPartition->m_members, (size_t)g_place_rootPartition->m_numMembers,
+  memcpy(allCells, ctx->m_concreteCells, sizeof(ConcreteCell*)*ctx->m_numCells);
+  qsort(allCells, (size_t)ctx->m_numCells, sizeof(ConcreteCell*), cellSortByID);
+  qsort(ctx->m_rootPartition->m_members, (size_t)ctx->m_rootPartition->m_numMembers,
         sizeof(ConcreteCell*), cellSortByID);
 
   // scan sorted lists and collect cells not in partitions
   while(!allCells[c++]);
-  while(!g_place_rootPartition->m_members[c2++]);
-
-  for(; c<g_place_numCells; c++, c2++) {
-    while(c2 < g_place_rootPartition->m_numMembers &&
-          allCells[c]->m_id > g_place_rootPartition->m_members[c2]->m_id) c2++;
-    while(c < g_place_numCells && 
-          (c2 >= g_place_rootPartition->m_numMembers ||
-           allCells[c]->m_id < g_place_rootPartition->m_members[c2]->m_id)) {
+  while(!ctx->m_rootPartition->m_members[c2++]);
+
+  for(; c<ctx->m_numCells; c++, c2++) {
+    while(c2 < ctx->m_rootPartition->m_numMembers &&
+          allCells[c]->m_id > ctx->m_rootPartition->m_members[c2]->m_id) c2++;
+    while(c < ctx->m_numCells && 
+          (c2 >= ctx->m_rootPartition->m_numMembers ||
+           allCells[c]->m_id < ctx->m_rootPartition->m_members[c2]->m_id)) {
       // a new cell!
       newCells[numNewCells++] = allCells[c];
       c++;
@@ -1131,7 +1212,7 @@ void incrementalPartition() {
   }
   
   printf("QPRT-50 : \tincremental partitioning with %d new cells\n", numNewCells);
-  if (numNewCells>0) incrementalSubpartition(g_place_rootPartition, newCells, numNewCells);
+  if (numNewCells>0) incrementalSubpartition(ctx->m_rootPartition, newCells, numNewCells);
 
   free(allCells);
   free(newCells);
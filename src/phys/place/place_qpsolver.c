@@ -12,6 +12,16 @@
 #include <stdio.h>
 #include <stdlib.h>
 
+#if defined(ABC_USE_PTHREADS)
+#ifdef _WIN32
+#include "../lib/pthread.h"
+#else
+#include <pthread.h>
+#include <sched.h>
+#include <unistd.h>
+#endif
+#endif
+
 #include "place_qpsolver.h"
 
 ABC_NAMESPACE_IMPL_START
@@ -34,7 +44,9 @@ ABC_NAMESPACE_IMPL_START
 #define QPS_PRECON
 #define QPS_PRECON_EPS 1.0e-9
 
-#undef QPS_HOIST
+#define QPS_THREADS_MAX 100
+#define QPS_THREAD_ROWS 1000    /* min rows per thread */
+
 
 #if defined(QPS_DEBUG)
 #define QPS_DEBUG_FILE "/tmp/qps_debug.log"
@@ -65,6 +77,185 @@ qps_float_t f;            /* value of cost function at p */
 
 /**********************************************************************/
 
+static double
+qps_spmv_rows(const qps_problem_t * p, const qps_float_t * v, qps_float_t * r,
+          int beg, int end)
+{
+  /* Sets r[j] = sum_k w_jk (v[j] - v[k]) for rows beg..end-1 of the
+     connectivity matrix, separately for both coordinates, and returns the
+     contribution of these rows to v^T C v. */
+
+  int j, k, pr;
+  qps_float_t jx, jy, tx, ty, rx, ry, w;
+  double f = 0.0;
+
+  const int *crow = p->priv_crow;
+  const int *ccol = p->priv_ccol;
+  const qps_float_t *cval = p->priv_cval;
+
+  for (j = beg; j < end; j++) {
+    jx = v[j * 2];
+    jy = v[j * 2 + 1];
+    rx = ry = 0.0;
+    for (pr = crow[j]; pr < crow[j + 1]; pr++) {
+      k = ccol[pr];
+      w = cval[pr];
+      tx = jx - v[k * 2];
+      ty = jy - v[k * 2 + 1];
+      rx += w * tx;
+      ry += w * ty;
+      f += w * (tx * tx + ty * ty);
+    }
+    r[j * 2] = rx;
+    r[j * 2 + 1] = ry;
+  }
+  /* each edge is seen from both of its ends */
+  return f / 2.0;
+}
+
+#if defined(ABC_USE_PTHREADS)
+
+typedef struct qps_thread {
+  const qps_problem_t *p;
+  const qps_float_t *v;
+  qps_float_t *r;
+  int beg, end;
+  double f;
+  int working;            /* 1 while a product is pending */
+  int stop;            /* set to make the thread exit */
+  pthread_t thread;
+} qps_thread_t;
+
+static void *
+qps_worker(void *arg)
+{
+  qps_thread_t *t = (qps_thread_t *) arg;
+  volatile int *place = &t->working;
+
+  /* products are short, so waiting threads give up the processor
+     instead of spinning through their time slices */
+  while (1) {
+    while (*place == 0) {
+      sched_yield();
+    }
+    if (t->stop) {
+      pthread_exit(NULL);
+      return NULL;
+    }
+    t->f = qps_spmv_rows(t->p, t->v, t->r, t->beg, t->end);
+    *place = 0;
+  }
+  return NULL;
+}
+
+static void
+qps_start_threads(qps_problem_t * p)
+{
+  /* Starts the worker threads; the calling thread computes the first
+     range of rows itself. */
+
+  int i, status;
+  qps_thread_t *th;
+  int nthreads = p->num_threads;
+
+  p->priv_pool = NULL;
+  if (nthreads > QPS_THREADS_MAX) {
+    nthreads = QPS_THREADS_MAX;
+  }
+  if (nthreads > p->num_cells / QPS_THREAD_ROWS) {
+    nthreads = p->num_cells / QPS_THREAD_ROWS;
+  }
+  if (nthreads <= 1) {
+    return;
+  }
+
+  /* split the rows into ranges with similar numbers of entries */
+  p->priv_cblk = (int *)malloc((nthreads + 1) * sizeof(int));
+  assert(p->priv_cblk);
+  p->priv_cblk[0] = 0;
+  for (i = 1, status = 0; i < nthreads; i++) {
+    while (status < p->num_cells &&
+       (double)(p->priv_crow[status] + status) * nthreads <
+       (double)(p->priv_cm + p->num_cells) * i) {
+      status++;
+    }
+    p->priv_cblk[i] = status;
+  }
+  p->priv_cblk[nthreads] = p->num_cells;
+
+  th = (qps_thread_t *) calloc(nthreads, sizeof(qps_thread_t));
+  assert(th);
+  for (i = 1; i < nthreads; i++) {
+    th[i].p = p;
+    th[i].beg = p->priv_cblk[i];
+    th[i].end = p->priv_cblk[i + 1];
+    status = pthread_create(&th[i].thread, NULL, qps_worker, (void *)(th + i));
+    assert(status == 0);
+  }
+  th[0].beg = nthreads;        /* the number of threads */
+  p->priv_pool = th;
+}
+
+static void
+qps_stop_threads(qps_problem_t * p)
+{
+  int i;
+  qps_thread_t *th = (qps_thread_t *) p->priv_pool;
+
+  if (!th) {
+    return;
+  }
+  for (i = 1; i < th[0].beg; i++) {
+    th[i].stop = 1;
+    th[i].working = 1;
+  }
+  for (i = 1; i < th[0].beg; i++) {
+    pthread_join(th[i].thread, NULL);
+  }
+  free(th);
+  free(p->priv_cblk);
+  p->priv_pool = NULL;
+}
+
+#endif /* ABC_USE_PTHREADS */
+
+/**********************************************************************/
+
+static qps_float_t
+qps_spmv(qps_problem_t * p, const qps_float_t * v, qps_float_t * r)
+{
+  /* Sets r = C v over all cells (both coordinates interleaved) and returns 
+     v^T C v, the sum of squared wirelengths of the placement v.  C is the 
+     Laplacian of the connectivity, so r is half the gradient of v^T C v. */
+
+#if defined(ABC_USE_PTHREADS)
+  int i;
+  double f;
+  volatile int *place;
+  qps_thread_t *th = (qps_thread_t *) p->priv_pool;
+
+  if (th) {
+    for (i = 1; i < th[0].beg; i++) {
+      th[i].v = v;
+      th[i].r = r;
+      th[i].working = 1;
+    }
+    f = qps_spmv_rows(p, v, r, 0, p->priv_cblk[1]);
+    for (i = 1; i < th[0].beg; i++) {
+      place = &th[i].working;
+      while (*place) {
+    sched_yield();
+      }
+      f += th[i].f;
+    }
+    return f;
+  }
+#endif
+  return qps_spmv_rows(p, v, r, 0, p->num_cells);
+}
+
+/**********************************************************************/
+
 static void
 qps_settp(qps_problem_t * p)
 {
@@ -129,40 +320,23 @@ static qps_float_t
 qps_func(qps_problem_t * p)
 {
   /* Return f(p).  qps_settp() should have already been called before
-     entering here */
+     entering here.  Leaves C tp in p->priv_tp2 for qps_dfunc(). */
 
   int j, k;
   int pr;
   qps_float_t jx, jy, tx, ty;
   qps_float_t f;
-  qps_float_t w;
 
-#if !defined(QPS_HOIST)
   int i;
   int st;
   qps_float_t kx, ky, sx, sy;
   qps_float_t t;
-#endif
 
   qps_float_t *tp = p->priv_tp;
 
-  f = 0.0;
-  pr = 0;
-  for (j = 0; j < p->num_cells; j++) {
-    jx = tp[j * 2];
-    jy = tp[j * 2 + 1];
-    while ((k = p->priv_cc[pr]) >= 0) {
-      w = p->priv_cw[pr];
-      tx = tp[k * 2] - jx;
-      ty = tp[k * 2 + 1] - jy;
-      f += w * (tx * tx + ty * ty);
-      pr++;
-    }
-    pr++;
-  }
+  f = qps_spmv(p, tp, p->priv_tp2);
   p->f = f;
 
-#if !defined(QPS_HOIST)
   /* loop penalties */
   pr = 0;
   for (i = 0; i < p->loop_num; i++) {
@@ -193,7 +367,6 @@ qps_func(qps_problem_t * p)
     f += p->loop_penalty[i] * t;
     pr++;
   }
-#endif /* QPS_HOIST */
 
   if (p->max_enable) {
     for (j = p->num_cells; j--;) {
@@ -216,8 +389,8 @@ static void
 qps_dfunc(qps_problem_t * p, qps_float_t * d)
 {
   /* Set d to grad f(p).  First computes partial derivatives wrt all cells
-     then finds gradient wrt only the independent cells.  qps_settp() should
-     have already been called before entering here */
+     then finds gradient wrt only the independent cells.  qps_settp() and 
+     qps_func() should have already been called before entering here */
 
   int i, j, k;
   int pr = 0;
@@ -225,38 +398,17 @@ qps_dfunc(qps_problem_t * p, qps_float_t * d)
   int ji, ki;
   qps_float_t w;
 
-#if !defined(QPS_HOIST)
   qps_float_t sx, sy;
   int st;
-#endif
 
   qps_float_t *tp = p->priv_tp;
   qps_float_t *tp2 = p->priv_tp2;
 
-  /* compute partials and store in tp2 */
-  for (i = p->num_cells; i--;) {
-    tp2[i * 2] = 0.0;
-    tp2[i * 2 + 1] = 0.0;
-  }
-  for (j = 0; j < p->num_cells; j++) {
-    jx = tp[j * 2];
-    jy = tp[j * 2 + 1];
-    while ((k = p->priv_cc[pr]) >= 0) {
-      w = 2.0 * p->priv_cw[pr];
-      kx = tp[k * 2];
-      ky = tp[k * 2 + 1];
-      tx = w * (jx - kx);
-      ty = w * (jy - ky);
-      tp2[j * 2] += tx;
-      tp2[k * 2] -= tx;
-      tp2[j * 2 + 1] += ty;
-      tp2[k * 2 + 1] -= ty;
-      pr++;
-    }
-    pr++;
+  /* compute partials and store in tp2; qps_func() left C tp there */
+  for (i = 2 * p->num_cells; i--;) {
+    tp2[i] *= 2.0;
   }
 
-#if !defined(QPS_HOIST)
   /* loop penalties */
   pr = 0;
   for (i = 0; i < p->loop_num; i++) {
@@ -286,7 +438,6 @@ qps_dfunc(qps_problem_t * p, qps_float_t * d)
     tp2[st * 2 + 1] -= ty;
     pr++;
   }
-#endif /* QPS_HOIST */
 
   if (p->max_enable) {
     for (j = p->num_cells; j--;) {
@@ -357,11 +508,9 @@ qps_linmin(qps_problem_t * p, qps_float_t dgg, qps_float_t * h)
   qps_float_t f = 0.0;
   qps_float_t w;
 
-#if !defined(QPS_HOIST)
   int st;
   qps_float_t sx, sy, tx, ty;
   qps_float_t t;
-#endif
 
   qps_float_t *tp = p->priv_tp;
 
@@ -394,22 +543,9 @@ qps_linmin(qps_problem_t * p, qps_float_t dgg, qps_float_t * h)
     }
   }
 
-  /* take product x^T Z^T C Z x */
-  pr = 0;
-  for (j = 0; j < p->num_cells; j++) {
-    jx = tp[j * 2];
-    jy = tp[j * 2 + 1];
-    while ((k = p->priv_cc[pr]) >= 0) {
-      w = p->priv_cw[pr];
-      kx = tp[k * 2] - jx;
-      ky = tp[k * 2 + 1] - jy;
-      f += w * (kx * kx + ky * ky);
-      pr++;
-    }
-    pr++;
-  }
+  /* take product x^T Z^T C Z x; tp2 is only used as scratch here */
+  f = qps_spmv(p, tp, p->priv_tp2);
 
-#if !defined(QPS_HOIST)
   /* add loop penalties */
   pr = 0;
   for (i = 0; i < p->loop_num; i++) {
@@ -434,7 +570,6 @@ qps_linmin(qps_problem_t * p, qps_float_t dgg, qps_float_t * h)
     f += p->loop_penalty[i] * t;
     pr++;
   }
-#endif /* QPS_HOIST */
 
 #if (QPS_DEBUG > 0)
   assert(f);
@@ -543,6 +678,8 @@ qps_init(qps_problem_t * p)
 {
   int i, j;
   int pr, pw;
+  int *pos;
+  qps_float_t w;
 
 #if defined(QPS_DEBUG)
   p->priv_fp = fopen(QPS_DEBUG_FILE, "a");
@@ -600,44 +737,60 @@ qps_init(qps_problem_t * p)
 
   p->priv_fopt = 0.0;
 
-  /* canonify c and w */
-  pr = pw = 0;
+  /* convert c and w into a CSR matrix holding each edge in the rows of
+     both of its cells; the edges are taken from the lists of the cells
+     with the smaller index */
+  p->priv_crow = (int *)calloc(p->num_cells + 1, sizeof(int));
+  assert(p->priv_crow);
+  pr = 0;
   for (i = 0; i < p->num_cells; i++) {
     while ((j = p->connect[pr]) >= 0) {
       if (j > i) {
-    pw++;
+    p->priv_crow[i + 1]++;
+    p->priv_crow[j + 1]++;
       }
       pr++;
     }
-    pw++;
     pr++;
   }
-  p->priv_cc = (int *)malloc(pw * sizeof(int));
-  assert(p->priv_cc);
-  p->priv_cr = (int *)malloc(p->num_cells * sizeof(int));
-  assert(p->priv_cr);
-  p->priv_cw = (qps_float_t*)malloc(pw * sizeof(qps_float_t));
-  assert(p->priv_cw);
-  p->priv_ct = (qps_float_t*)malloc(pw * sizeof(qps_float_t));
-  assert(p->priv_ct);
-  p->priv_cm = pw;
-  pr = pw = 0;
   for (i = 0; i < p->num_cells; i++) {
-    p->priv_cr[i] = pw;
+    p->priv_crow[i + 1] += p->priv_crow[i];
+  }
+  p->priv_cm = p->priv_crow[p->num_cells];
+  p->priv_ccol = (int *)malloc((p->priv_cm + 1) * sizeof(int));
+  assert(p->priv_ccol);
+  p->priv_cval = (qps_float_t*)malloc((p->priv_cm + 1) * sizeof(qps_float_t));
+  assert(p->priv_cval);
+  p->priv_cdeg = (qps_float_t*)calloc(p->num_cells, sizeof(qps_float_t));
+  assert(p->priv_cdeg);
+  /* the rows are filled from their ends backwards */
+  pos = (int *)malloc(p->num_cells * sizeof(int));
+  assert(pos);
+  for (i = 0; i < p->num_cells; i++) {
+    pos[i] = p->priv_crow[i + 1];
+  }
+  pr = 0;
+  for (i = 0; i < p->num_cells; i++) {
     while ((j = p->connect[pr]) >= 0) {
       if (j > i) {
-    p->priv_cc[pw] = p->connect[pr];
-    p->priv_ct[pw] = p->edge_weight[pr];
-    pw++;
+    w = p->edge_weight[pr];
+    pw = --pos[i];
+    p->priv_ccol[pw] = j;
+    p->priv_cval[pw] = w;
+    pw = --pos[j];
+    p->priv_ccol[pw] = i;
+    p->priv_cval[pw] = w;
+    p->priv_cdeg[i] += w;
+    p->priv_cdeg[j] += w;
       }
       pr++;
     }
-    p->priv_cc[pw] = -1;
-    p->priv_ct[pw] = -1.0;
-    pw++;
     pr++;
   }
-  assert(pw == p->priv_cm);
+  free(pos);
+
+  p->priv_pool = NULL;
+  p->priv_cblk = NULL;
 
   /* temp arrays for function eval */
   p->priv_tp = (qps_float_t *) malloc(4 * p->num_cells * sizeof(qps_float_t));
@@ -705,36 +858,6 @@ qps_solve_inner(qps_problem_t * p)
   qps_float_t t;
   qps_float_t z;
   qps_float_t pm1, pm2, tp;
-  qps_float_t *tw;
-#if defined(QPS_HOIST)
-  int j, k;
-  qps_float_t jx, jy, kx, ky, sx, sy, tx, ty;
-  int pr, st;
-#endif
-
-  tw = p->priv_cw;
-#if defined(QPS_HOIST)
-  if (!p->loop_num) {
-    p->priv_cw = p->priv_ct;
-  }
-  else {
-    for(i=p->priv_cm; i--;) {
-      p->priv_cw[i] = p->priv_ct[i];
-    }
-    /* augment with loop penalties */
-    pr = 0;
-    for (i = 0; i < p->loop_num; i++) {
-      while ((j = p->priv_la[pr++]) != -1) {
-    if (j >= 0) {
-      p->priv_cw[j] += p->loop_penalty[i];
-    }
-      }
-      pr++;
-    }
-  }
-#else /* !QPS_HOIST */
-  p->priv_cw = p->priv_ct;
-#endif /* QPS_HOIST */
 
   qps_cgmin(p);
 
@@ -782,32 +905,6 @@ qps_solve_inner(qps_problem_t * p)
 #endif
     p->loop_k++;
 
-#if defined(QPS_HOIST)
-    /* calc loop penalties */
-    pr = 0;
-    for (i = 0; i < p->loop_num; i++) {
-      t = 0.0;
-      j = st = p->loop_list[pr++];
-      jx = sx = p->priv_tp[j * 2];
-      jy = sy = p->priv_tp[j * 2 + 1];
-      while ((k = p->loop_list[pr]) >= 0) {
-    kx = p->priv_tp[k * 2];
-    ky = p->priv_tp[k * 2 + 1];
-    tx = jx - kx;
-    ty = jy - ky;
-    t += tx * tx + ty * ty;
-    j = k;
-    jx = kx;
-    jy = ky;
-    pr++;
-      }
-      tx = jx - sx;
-      ty = jy - sy;
-      t += tx * tx + ty * ty;
-      p->priv_lt[i] = t - p->loop_max[i];
-      pr++;
-    }
-#endif /* QPS_HOIST */
 
     /* check KKT conditions */
 #if (QPS_DEBUG > 1)
@@ -971,8 +1068,6 @@ qps_solve_inner(qps_problem_t * p)
   if (p->loop_fail) {
     p->loop_done = 1;
   }
-
-  p->priv_cw = tw;
 }
 
 /**********************************************************************/
@@ -990,11 +1085,6 @@ qps_solve(qps_problem_t * p)
   qps_float_t t;
 #endif
 
-#if defined(QPS_HOIST)
-  int k;
-  int st;
-  int m1, m2;
-#endif
 
   if (p->max_enable) {
     p->priv_mxl = (qps_float_t *)
@@ -1073,17 +1163,7 @@ qps_solve(qps_problem_t * p)
   p->priv_pcgt = (qps_float_t *) malloc(p->priv_n * sizeof(qps_float_t));
   assert(p->priv_pcgt);
   for (i = p->num_cells; i--;) {
-    p->priv_pcg[i] = 0.0;
-  }
-  pr = 0;
-  for (i = 0; i < p->num_cells; i++) {
-    while ((c = p->priv_cc[pr]) >= 0) {
-      t = p->priv_ct[pr];
-      p->priv_pcg[i] += t;
-      p->priv_pcg[c] += t;
-      pr++;
-    }
-    pr++;
+    p->priv_pcg[i] = p->priv_cdeg[i];
   }
   pr = 0;
   for (i = 0; i < p->loop_num; i++) {
@@ -1154,70 +1234,17 @@ qps_solve(qps_problem_t * p)
   if (p->loop_num) {
     p->priv_lt = (qps_float_t *) malloc(p->loop_num * sizeof(qps_float_t));
     assert(p->priv_lt);
-#if defined(QPS_HOIST)
-    pr = 0;
-    for (i=p->loop_num; i--;) {
-      while (p->loop_list[pr++] >= 0) {
-      }
-      pr++;
-    }
-    p->priv_lm = pr;
-    p->priv_la = (int *) malloc(pr * sizeof(int));
-    assert(p->priv_la);
-    pr = 0;
-    for (i = 0; i < p->loop_num; i++) {
-      j = st = p->loop_list[pr++];
-      while ((k = p->loop_list[pr]) >= 0) {
-    if (j > k) {
-      m1 = k;
-      m2 = j;
-    }
-    else {
-      assert(k > j);
-      m1 = j;
-      m2 = k;
-    }
-    pw = p->priv_cr[m1];
-    while (p->priv_cc[pw] != m2) {
-/*      assert(p->priv_cc[pw] >= 0); */
-      if (p->priv_cc[pw] < 0) {
-        pw = -2;
-        break;
-      }
-      pw++;
-    }
-    p->priv_la[pr-1] = pw;
-    j = k;
-    pr++;
-      }
-      if (j > st) {
-    m1 = st;
-    m2 = j;
-      }
-      else {
-    assert(st > j);
-    m1 = j;
-    m2 = st;
-      }
-      pw = p->priv_cr[m1];
-      while (p->priv_cc[pw] != m2) {
-/*    assert(p->priv_cc[pw] >= 0); */
-    if (p->priv_cc[pw] < 0) {
-      pw = -2;
-      break;
-    }
-    pw++;
-      }
-      p->priv_la[pr-1] = pw;
-      p->priv_la[pr] = -1;
-      pr++;
-    }
-#endif /* QPS_HOIST */
   }
 
+#if defined(ABC_USE_PTHREADS)
+  qps_start_threads(p);
+#endif
   do {
     qps_solve_inner(p);
   } while (!p->loop_done || !p->max_done);
+#if defined(ABC_USE_PTHREADS)
+  qps_stop_threads(p);
+#endif
 
   /* retrieve values */
   /* qps_settp() should have already been called at this point */
@@ -1242,9 +1269,6 @@ qps_solve(qps_problem_t * p)
   }
   if(p->loop_num) {
     free(p->priv_lt);
-#if defined(QPS_HOIST)
-    free(p->priv_la);
-#endif
   }
 
 #if defined(QPS_PRECON)
@@ -1260,10 +1284,10 @@ qps_clean(qps_problem_t * p)
 {
   free(p->priv_tp);
   free(p->priv_ii);
-  free(p->priv_cc);
-  free(p->priv_cr);
-  free(p->priv_cw);
-  free(p->priv_ct);
+  free(p->priv_crow);
+  free(p->priv_ccol);
+  free(p->priv_cval);
+  free(p->priv_cdeg);
 
 #if defined(QPS_DEBUG)
   fclose(p->priv_fp);
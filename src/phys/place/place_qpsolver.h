@@ -7,9 +7,11 @@
 //
 /*===================================================================*/
 
-#if !defined(_QPS_H)
+#ifndef ABC__phys__place__place_qpsolver_h
 #define ABC__phys__place__place_qpsolver_h
 
+#include "misc/util/abc_global.h"
+
 
 #include <stdio.h>
 
@@ -18,6 +20,11 @@ ABC_NAMESPACE_HEADER_START
 
   typedef float qps_float_t;
 
+  /* The connectivity is stored as a sparse matrix in compressed sparse
+     row (CSR) form.  The products with this matrix dominate the run
+     time of the conjugate gradient solver and are split among
+     num_threads threads by ranges of rows of roughly equal size. */
+
   typedef struct qps_problem {
 
     /* Basic stuff */
@@ -96,14 +103,21 @@ ABC_NAMESPACE_HEADER_START
                    max_x/max_y. */
     int max_done;        /* Done flag for max optimization. */
 
+    /* Threading */
+    int num_threads;        /* Number of threads used by qps_solve() for
+                   the sparse matrix-vector products; 0 or 1
+                   solves on the calling thread only. */
+
     /* Private stuff */
     int *priv_ii;
-    int *priv_cc, *priv_cr;
-    qps_float_t *priv_cw, *priv_ct;
+    int *priv_crow, *priv_ccol;    /* connectivity in CSR form: row offsets */
+    qps_float_t *priv_cval;    /* and column indices/weights of both the
+                   upper and the lower triangles */
+    qps_float_t *priv_cdeg;    /* total edge weight of each cell */
     int priv_cm;
+    int *priv_cblk;        /* row ranges of the threads in the CSR */
+    void *priv_pool;        /* worker threads */
     int *priv_gt;
-    int *priv_la;
-    int priv_lm;
     qps_float_t *priv_gm, *priv_gw;
     qps_float_t *priv_g, *priv_h, *priv_xi;
     qps_float_t *priv_tp, *priv_tp2;
@@ -76,7 +76,7 @@ ConcreteNet  *concreteNets;
 //
 // --------------------------------------------------------------------
 
-void readBookshelfNets(char *filename) {
+void readBookshelfNets(PlaceContext *ctx, char *filename) {
   char *tok;
   char buf[1024];
   const char *DELIMITERS = " \n\t:";
@@ -146,7 +146,7 @@ void readBookshelfNets(char *filename) {
     }
 
     // add!
-    addConcreteNet(&(concreteNets[id]));
+    addConcreteNet(ctx, &(concreteNets[id]));
 
     id++;
   }
@@ -154,7 +154,7 @@ void readBookshelfNets(char *filename) {
   fclose(netsFile);
 }
 
-void readBookshelfNodes(char *filename) {
+void readBookshelfNodes(PlaceContext *ctx, char *filename) {
   char *tok;
   char buf[1024];
   const char *DELIMITERS = " \n\t:";
@@ -207,7 +207,7 @@ void readBookshelfNodes(char *filename) {
     abstractCells[id].m_pad = tok && !strcmp(tok, "terminal");
 
     // add!
-    addConcreteCell(&(concreteCells[id]));
+    addConcreteCell(ctx, &(concreteCells[id]));
 
     // DEBUG
     /*
@@ -291,12 +291,12 @@ void writeBookshelfPlacement(char *filename) {
 }
 
 // deletes all connections to a cell
-void delNetConnections(ConcreteCell *cell) {
+void delNetConnections(PlaceContext *ctx, ConcreteCell *cell) {
   int n, t, t2, count = 0;
-  ConcreteCell **old = malloc(sizeof(ConcreteCell*)*g_place_numCells);
+  ConcreteCell **old = malloc(sizeof(ConcreteCell*)*ctx->m_numCells);
 
-  for(n=0; n<g_place_numNets; n++) if (g_place_concreteNets[n]) {
-    ConcreteNet *net = g_place_concreteNets[n];
+  for(n=0; n<ctx->m_numNets; n++) if (ctx->m_concreteNets[n]) {
+    ConcreteNet *net = ctx->m_concreteNets[n];
     count = 0;
     for(t=0; t<net->m_numTerms; t++)
       if (net->m_terms[t] == cell) count++;
@@ -314,50 +314,55 @@ void delNetConnections(ConcreteCell *cell) {
 }
 
 int main(int argc, char **argv) {
+  PlaceContext *ctx;
 
-  if (argc != 4) {
-    printf("Usage: %s [nodes] [nets] [pl]\n", argv[0]);
+  if (argc != 4 && argc != 5) {
+    printf("Usage: %s [nodes] [nets] [pl] <threads>\n", argv[0]);
     exit(1);
   }
 
-  readBookshelfNodes(argv[1]);
-  readBookshelfNets(argv[2]);
+  ctx = placeContextAlloc();
+  if (argc == 5) ctx->m_numThreads = atoi(argv[4]);
+
+  readBookshelfNodes(ctx, argv[1]);
+  readBookshelfNets(ctx, argv[2]);
   readBookshelfPlacement(argv[3]);
 
-  globalPreplace(0.8);
-  globalPlace();
+  globalPreplace(ctx, 0.8);
+  globalPlace(ctx);
 
   // DEBUG net/cell removal/addition
   /*
   int i;
   for(i=1000; i<2000; i++) {
-    delConcreteNet(g_place_concreteNets[i]);
-    delNetConnections(g_place_concreteCells[i]);
-    delConcreteCell(g_place_concreteCells[i]);
+    delConcreteNet(ctx, ctx->m_concreteNets[i]);
+    delNetConnections(ctx, ctx->m_concreteCells[i]);
+    delConcreteCell(ctx, ctx->m_concreteCells[i]);
   }
   
   ConcreteCell newCell[2];
-  newCell[0].m_id = g_place_numCells+1;
+  newCell[0].m_id = ctx->m_numCells+1;
   newCell[0].m_x = 1000;
   newCell[0].m_y = 1000;
   newCell[0].m_fixed = false;
   newCell[0].m_parent = &(abstractCells[1000]);
   newCell[0].m_label = " ";
-  addConcreteCell(&newCell[0]);
-  newCell[1].m_id = g_place_numCells+3;
+  addConcreteCell(ctx, &newCell[0]);
+  newCell[1].m_id = ctx->m_numCells+3;
   newCell[1].m_x = 1000;
   newCell[1].m_y = 1000;
   newCell[1].m_fixed = false;
   newCell[1].m_parent = &(abstractCells[1000]);
   newCell[1].m_label = " ";
-  addConcreteCell(&newCell[1]);
+  addConcreteCell(ctx, &newCell[1]);
   */
 
-  globalIncremental();
+  globalIncremental(ctx);
 
   writeBookshelfPlacement(argv[3]);
 
   free(hash_cellname);
+  placeContextFree(ctx);
 
   return 0;
 }
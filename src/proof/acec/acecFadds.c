@@ -22,6 +22,18 @@
 #include "misc/vec/vecWec.h"
 #include "misc/tim/tim.h"
 
+#ifdef ABC_USE_PTHREADS
+
+#ifdef _WIN32
+#include "../lib/pthread.h"
+#else
+#include <pthread.h>
+#include <sched.h>
+#include <unistd.h>
+#endif
+
+#endif
+
 ABC_NAMESPACE_IMPL_START
 
 
@@ -32,6 +44,23 @@ ABC_NAMESPACE_IMPL_START
 #define Dtc_ForEachCut( pList, pCut, i ) for ( i = 0, pCut = pList + 1; i < pList[0]; i++, pCut += pCut[0] + 1 )
 #define Dtc_ForEachFadd( vFadds, i )     for ( i = 0; i < Vec_IntSize(vFadds)/5; i++ )
 
+#define DTC_BATCH_SIZE  (1 << 16)   // the number of candidate cuts classified at a time
+#define DTC_THR_MAX     100         // the largest number of threads
+
+// candidate cuts are stored as 4-tuples (node, leaf0, leaf1, leaf2), leaf2 = -1 for 2-input cuts
+typedef struct Dtc_ThData_t_ Dtc_ThData_t;
+struct Dtc_ThData_t_
+{
+    Gia_Man_t *      p;             // the AIG (not modified)
+    Vec_Int_t *      vCands;        // candidate cuts of the current batch
+    Vec_Int_t *      vTypes;        // types of the candidate cuts
+    int *            pValues;       // truth tables of the nodes (one array per thread)
+    int              iBeg;          // the first candidate to classify
+    int              iEnd;          // the last candidate to classify
+    int              fWorking;      // the thread is busy
+    int              fStop;         // the thread should exit
+};
+
 ////////////////////////////////////////////////////////////////////////
 ///                     FUNCTION DEFINITIONS                         ///
 ////////////////////////////////////////////////////////////////////////
@@ -269,11 +298,52 @@ int Dtc_ObjComputeTruth( Gia_Man_t * p, int iObj, int * pCut, int * pTruth )
         return 2;
     return 0;
 }
-void Dtc_ManCutMerge( Gia_Man_t * p, int iObj, int * pList0, int * pList1, Vec_Int_t * vCuts, Vec_Int_t * vCutsXor2, Vec_Int_t * vCutsXor, Vec_Int_t * vCutsMaj )
+int Dtc_ObjComputeTruthArray_rec( Gia_Man_t * p, int * pValues, int iObj )
+{
+    Gia_Obj_t * pObj = Gia_ManObj( p, iObj );
+    int Truth0, Truth1;
+    if ( pValues[iObj] )
+        return pValues[iObj];
+    assert( Gia_ObjIsAnd(pObj) );
+    Truth0 = Dtc_ObjComputeTruthArray_rec( p, pValues, Gia_ObjFaninId0(pObj, iObj) );
+    Truth1 = Dtc_ObjComputeTruthArray_rec( p, pValues, Gia_ObjFaninId1(pObj, iObj) );
+    if ( Gia_ObjIsXor(pObj) )
+        return (pValues[iObj] = (Gia_ObjFaninC0(pObj) ? ~Truth0 : Truth0) ^ (Gia_ObjFaninC1(pObj) ? ~Truth1 : Truth1));
+    else
+        return (pValues[iObj] = (Gia_ObjFaninC0(pObj) ? ~Truth0 : Truth0) & (Gia_ObjFaninC1(pObj) ? ~Truth1 : Truth1));
+}
+void Dtc_ObjCleanTruthArray_rec( Gia_Man_t * p, int * pValues, int iObj )
+{
+    Gia_Obj_t * pObj = Gia_ManObj( p, iObj );
+    if ( !pValues[iObj] )
+        return;
+    pValues[iObj] = 0;
+    if ( !Gia_ObjIsAnd(pObj) )
+        return;
+    Dtc_ObjCleanTruthArray_rec( p, pValues, Gia_ObjFaninId0(pObj, iObj) );
+    Dtc_ObjCleanTruthArray_rec( p, pValues, Gia_ObjFaninId1(pObj, iObj) );
+}
+// same as Dtc_ObjComputeTruth() but keeps the truth tables in the given array instead of pObj->Value
+int Dtc_ObjComputeTruthArray( Gia_Man_t * p, int * pValues, int iObj, int * pCut )
+{
+    unsigned Truth, Truths[3] = { 0xAA, 0xCC, 0xF0 }; int i;
+    for ( i = 1; i <= pCut[0]; i++ )
+        pValues[pCut[i]] = Truths[i-1];
+    Truth = 0xFF & Dtc_ObjComputeTruthArray_rec( p, pValues, iObj );
+    Dtc_ObjCleanTruthArray_rec( p, pValues, iObj );
+    if ( Truth == 0x66 || Truth == 0x99 )
+        return 3;
+    if ( Truth == 0x96 || Truth == 0x69 )
+        return 1;
+    if ( Truth == 0xE8 || Truth == 0xD4 || Truth == 0xB2 || Truth == 0x71 ||
+         Truth == 0x17 || Truth == 0x2B || Truth == 0x4D || Truth == 0x8E )
+        return 2;
+    return 0;
+}
+void Dtc_ManCutMerge( Gia_Man_t * p, int iObj, int * pList0, int * pList1, Vec_Int_t * vCuts, Vec_Int_t * vCands )
 {
     int fVerbose = 0;
-    Vec_Int_t * vTemp;
-    int i, k, c, Type, * pCut0, * pCut1, pCut[4];
+    int i, k, c, * pCut0, * pCut1, pCut[4];
     if ( fVerbose )
         printf( "Object %d = :\n", iObj );
     Vec_IntFill( vCuts, 2, 1 );
@@ -296,53 +366,156 @@ void Dtc_ManCutMerge( Gia_Man_t * p, int iObj, int * pList0, int * pList1, Vec_I
         }
         if ( fVerbose )
             printf( "\n" );
-        if ( pCut[0] == 2 )
+        // the function of the cut is classified later, possibly by another thread
+        Vec_IntPushTwo( vCands, iObj, pCut[1] );
+        Vec_IntPushTwo( vCands, pCut[2], pCut[0] == 3 ? pCut[3] : -1 );
+    }
+}
+
+/**Function*************************************************************
+
+  Synopsis    [Classifies the candidate cuts.]
+
+  Description [Candidate cuts are classified in batches. The truth tables 
+  are computed in the per-thread arrays, so the threads only read the AIG.
+  The classified cuts are collected in the order of the candidates, which 
+  makes the result independent of the number of threads.]
+               
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+void Dtc_ManClassifyRange( Dtc_ThData_t * pThData )
+{
+    int i, * pCand, pCut[4];
+    for ( i = pThData->iBeg; i < pThData->iEnd; i++ )
+    {
+        pCand = Vec_IntEntryP( pThData->vCands, 4*i );
+        pCut[0] = pCand[3] == -1 ? 2 : 3;
+        pCut[1] = pCand[1];
+        pCut[2] = pCand[2];
+        pCut[3] = pCand[3];
+        Vec_IntWriteEntry( pThData->vTypes, i, Dtc_ObjComputeTruthArray(pThData->p, pThData->pValues, pCand[0], pCut) );
+    }
+}
+void Dtc_ManCollectCands( Vec_Int_t * vCands, Vec_Int_t * vTypes, Vec_Int_t * vCutsXor2, Vec_Int_t * vCutsXor, Vec_Int_t * vCutsMaj )
+{
+    Vec_Int_t * vTemp;
+    int i, Type, * pCand;
+    Vec_IntForEachEntry( vTypes, Type, i )
+    {
+        pCand = Vec_IntEntryP( vCands, 4*i );
+        if ( pCand[3] == -1 )
         {
-            int Value = Dtc_ObjComputeTruth( p, iObj, pCut, NULL );
-            assert( Value == 3 || Value == 0 );
-            if ( Value == 3 )
-            {
-                Vec_IntPush( vCutsXor2, pCut[1] );
-                Vec_IntPush( vCutsXor2, pCut[2] );
-                Vec_IntPush( vCutsXor2, iObj );
-            }
+            assert( Type == 3 || Type == 0 );
+            if ( Type == 3 )
+                Vec_IntPushThree( vCutsXor2, pCand[1], pCand[2], pCand[0] );
             continue;
         }
-        if ( pCut[0] != 3 )
-            continue;
-        Type = Dtc_ObjComputeTruth( p, iObj, pCut, NULL );
         if ( Type == 0 )
             continue;
         vTemp = Type == 1 ? vCutsXor : vCutsMaj;
-        if ( 0 && Type == 2 )
+        Vec_IntPushThree( vTemp, pCand[1], pCand[2], pCand[3] );
+        Vec_IntPush( vTemp, pCand[0] );
+    }
+}
+
+#ifdef ABC_USE_PTHREADS
+void * Dtc_ManWorkerThread( void * pArg )
+{
+    Dtc_ThData_t * pThData = (Dtc_ThData_t *)pArg;
+    volatile int * pPlace = &pThData->fWorking;
+    while ( 1 )
+    {
+        while ( *pPlace == 0 )
+            sched_yield();
+        assert( pThData->fWorking );
+        if ( pThData->fStop )
         {
-            fVerbose = 1;
-            if ( fVerbose )
-                printf( "%d = %s(", iObj, Type == 1 ? "XOR" : "MAJ" );
-            for ( c = 1; c <= pCut[0]; c++ )
-            {
-                if ( fVerbose )
-                    printf( " %d", pCut[c] );
-                Vec_IntPush( vTemp, pCut[c] );
-            }
-            if ( fVerbose )
-                printf( " )\n" );
-            fVerbose = 0;
+            pthread_exit( NULL );
+            assert( 0 );
+            return NULL;
         }
-        Vec_IntPush( vTemp, iObj );
+        Dtc_ManClassifyRange( pThData );
+        pThData->fWorking = 0;
     }
+    assert( 0 );
+    return NULL;
 }
-void Dtc_ManComputeCuts( Gia_Man_t * p, Vec_Int_t ** pvCutsXor2, Vec_Int_t ** pvCutsXor, Vec_Int_t ** pvCutsMaj, int fVerbose )
+#endif // pthreads are used
+
+void Dtc_ManClassifyCands( Dtc_ThData_t * ThData, int nProcs, Vec_Int_t * vCands, Vec_Int_t * vTypes )
 {
+    int i, nCands = Vec_IntSize(vCands) / 4;
+    int nPerThread = (nCands + nProcs - 1) / nProcs;
+    Vec_IntFill( vTypes, nCands, 0 );
+    // the last range is handled by the calling thread
+    for ( i = 0; i < nProcs; i++ )
+    {
+        ThData[i].vCands = vCands;
+        ThData[i].vTypes = vTypes;
+        ThData[i].iBeg   = Abc_MinInt( i * nPerThread, nCands );
+        ThData[i].iEnd   = Abc_MinInt( (i + 1) * nPerThread, nCands );
+    }
+#ifdef ABC_USE_PTHREADS
+    for ( i = 0; i < nProcs - 1; i++ )
+        ThData[i].fWorking = 1;
+#endif
+    Dtc_ManClassifyRange( ThData + nProcs - 1 );
+#ifdef ABC_USE_PTHREADS
+    for ( i = 0; i < nProcs - 1; i++ )
+        while ( ((volatile int *)&ThData[i].fWorking)[0] )
+            sched_yield();
+#endif
+}
+
+/**Function*************************************************************
+
+  Synopsis    [Computes 3-input cuts and detects XOR/MAJ functions.]
+
+  Description [The cuts are enumerated in topological order by the calling
+  thread. The functions of the 2- and 3-input cuts are classified using 
+  nProcs threads.]
+               
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+void Dtc_ManComputeCuts( Gia_Man_t * p, int nProcs, Vec_Int_t ** pvCutsXor2, Vec_Int_t ** pvCutsXor, Vec_Int_t ** pvCutsMaj, int fVerbose )
+{
+    Dtc_ThData_t ThData[DTC_THR_MAX];
+#ifdef ABC_USE_PTHREADS
+    pthread_t WorkerThread[DTC_THR_MAX];
+    int status;
+#endif
     Gia_Obj_t * pObj; 
     int * pList0, * pList1, i, nCuts = 0;
     Vec_Int_t * vTemp = Vec_IntAlloc( 1000 );
+    Vec_Int_t * vCands = Vec_IntAlloc( 4 * DTC_BATCH_SIZE + 1000 );
+    Vec_Int_t * vTypes = Vec_IntAlloc( DTC_BATCH_SIZE + 250 );
     Vec_Int_t * vCutsXor2 = Vec_IntAlloc( Gia_ManAndNum(p) );
     Vec_Int_t * vCutsXor = Vec_IntAlloc( Gia_ManAndNum(p) );
     Vec_Int_t * vCutsMaj = Vec_IntAlloc( Gia_ManAndNum(p) );
     Vec_Int_t * vCuts = Vec_IntAlloc( 30 * Gia_ManAndNum(p) );
+#ifndef ABC_USE_PTHREADS
+    nProcs = 1;
+#endif
+    nProcs = Abc_MaxInt( 1, Abc_MinInt(nProcs, DTC_THR_MAX) );
+    for ( i = 0; i < nProcs; i++ )
+    {
+        memset( ThData + i, 0, sizeof(Dtc_ThData_t) );
+        ThData[i].p       = p;
+        ThData[i].pValues = ABC_CALLOC( int, Gia_ManObjNum(p) );
+    }
+#ifdef ABC_USE_PTHREADS
+    for ( i = 0; i < nProcs - 1; i++ )
+    {
+        status = pthread_create( WorkerThread + i, NULL, Dtc_ManWorkerThread, (void *)(ThData + i) );  assert( status == 0 );
+    }
+#endif
     Vec_IntFill( vCuts, Gia_ManObjNum(p), 0 );
-    Gia_ManCleanValue( p );
     Gia_ManForEachCi( p, pObj, i )
     {
         Vec_IntWriteEntry( vCuts, Gia_ObjId(p, pObj), Vec_IntSize(vCuts) );
@@ -354,15 +527,35 @@ void Dtc_ManComputeCuts( Gia_Man_t * p, Vec_Int_t ** pvCutsXor2, Vec_Int_t ** pv
     {
         pList0 = Vec_IntEntryP( vCuts, Vec_IntEntry(vCuts, Gia_ObjFaninId0(pObj, i)) );
         pList1 = Vec_IntEntryP( vCuts, Vec_IntEntry(vCuts, Gia_ObjFaninId1(pObj, i)) );
-        Dtc_ManCutMerge( p, i, pList0, pList1, vTemp, vCutsXor2, vCutsXor, vCutsMaj );
+        Dtc_ManCutMerge( p, i, pList0, pList1, vTemp, vCands );
         Vec_IntWriteEntry( vCuts, i, Vec_IntSize(vCuts) );
         Vec_IntAppend( vCuts, vTemp );
         nCuts += Vec_IntEntry( vTemp, 0 );
+        if ( Vec_IntSize(vCands) < 4 * DTC_BATCH_SIZE )
+            continue;
+        Dtc_ManClassifyCands( ThData, nProcs, vCands, vTypes );
+        Dtc_ManCollectCands( vCands, vTypes, vCutsXor2, vCutsXor, vCutsMaj );
+        Vec_IntClear( vCands );
+    }
+    Dtc_ManClassifyCands( ThData, nProcs, vCands, vTypes );
+    Dtc_ManCollectCands( vCands, vTypes, vCutsXor2, vCutsXor, vCutsMaj );
+#ifdef ABC_USE_PTHREADS
+    for ( i = 0; i < nProcs - 1; i++ )
+    {
+        ThData[i].fStop = 1;
+        ThData[i].fWorking = 1;
     }
+    for ( i = 0; i < nProcs - 1; i++ )
+        pthread_join( WorkerThread[i], NULL );
+#endif
+    for ( i = 0; i < nProcs; i++ )
+        ABC_FREE( ThData[i].pValues );
     if ( fVerbose )
-        printf( "Nodes = %d.  Cuts = %d.  Cuts/Node = %.2f.  Ints/Node = %.2f.\n", 
-            Gia_ManAndNum(p), nCuts, 1.0*nCuts/Gia_ManAndNum(p), 1.0*Vec_IntSize(vCuts)/Gia_ManAndNum(p) );
+        printf( "Nodes = %d.  Cuts = %d.  Cuts/Node = %.2f.  Ints/Node = %.2f.  Threads = %d.\n", 
+            Gia_ManAndNum(p), nCuts, 1.0*nCuts/Gia_ManAndNum(p), 1.0*Vec_IntSize(vCuts)/Gia_ManAndNum(p), nProcs );
     Vec_IntFree( vTemp );
+    Vec_IntFree( vCands );
+    Vec_IntFree( vTypes );
     Vec_IntFree( vCuts );
     if ( pvCutsXor2 )
         *pvCutsXor2 = vCutsXor2;
@@ -439,10 +632,10 @@ int Dtc_ManCompare2( int * pCut0, int * pCut1 )
     return 0;
 }
 // returns array of 5-tuples containing inputs/sum/cout of each full adder
-Vec_Int_t * Gia_ManDetectFullAdders( Gia_Man_t * p, int fVerbose, Vec_Int_t ** pvCutsXor2 )
+Vec_Int_t * Gia_ManDetectFullAddersPar( Gia_Man_t * p, int nProcs, int fVerbose, Vec_Int_t ** pvCutsXor2 )
 {
     Vec_Int_t * vCutsXor, * vCutsMaj, * vFadds;
-    Dtc_ManComputeCuts( p, pvCutsXor2, &vCutsXor, &vCutsMaj, fVerbose );
+    Dtc_ManComputeCuts( p, nProcs, pvCutsXor2, &vCutsXor, &vCutsMaj, fVerbose );
     qsort( Vec_IntArray(vCutsXor), (size_t)(Vec_IntSize(vCutsXor)/4), 16, (int (*)(const void *, const void *))Dtc_ManCompare );
     qsort( Vec_IntArray(vCutsMaj), (size_t)(Vec_IntSize(vCutsMaj)/4), 16, (int (*)(const void *, const void *))Dtc_ManCompare );
     vFadds = Dtc_ManFindCommonCuts( p, vCutsXor, vCutsMaj );
@@ -455,10 +648,14 @@ Vec_Int_t * Gia_ManDetectFullAdders( Gia_Man_t * p, int fVerbose, Vec_Int_t ** p
     Vec_IntFree( vCutsMaj );
     return vFadds;
 }
+Vec_Int_t * Gia_ManDetectFullAdders( Gia_Man_t * p, int fVerbose, Vec_Int_t ** pvCutsXor2 )
+{
+    return Gia_ManDetectFullAddersPar( p, 1, fVerbose, pvCutsXor2 );
+}
 void Gia_ManDetectFullAdders2( Gia_Man_t * p, int fVerbose )
 {
     Vec_Int_t * vCutsXor2, * vCutsXor, * vCutsMaj;
-    Dtc_ManComputeCuts( p, &vCutsXor2, &vCutsXor, &vCutsMaj, fVerbose );
+    Dtc_ManComputeCuts( p, 1, &vCutsXor2, &vCutsXor, &vCutsMaj, fVerbose );
     if ( fVerbose )
         printf( "XOR3 cuts = %d.  MAJ cuts = %d.\n", Vec_IntSize(vCutsXor)/4, Vec_IntSize(vCutsMaj)/4 );
     Vec_IntFree( vCutsXor2 );
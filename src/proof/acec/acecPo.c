@@ -28,6 +28,8 @@ ABC_NAMESPACE_IMPL_START
 ///                        DECLARATIONS                              ///
 ////////////////////////////////////////////////////////////////////////
 
+#define ACEC_POLYN_COMPACT_MIN  (1 << 16)  // the smallest store of monomials to be compacted
+
 ////////////////////////////////////////////////////////////////////////
 ///                     FUNCTION DEFINITIONS                         ///
 ////////////////////////////////////////////////////////////////////////
@@ -636,6 +638,77 @@ static inline void Gia_PolynPrepare4( Vec_Int_t * vTempC[4], Vec_Int_t * vTempM[
     Vec_IntPushUniqueOrder( vTempM[3], iFan1 );
 }
 
+/**Function*************************************************************
+
+  Synopsis    [Compacts the store of monomials.]
+
+  Description [Monomials whose coefficient became zero are never looked up
+  again by the backward substitution, but they stay in the hash tables. 
+  This procedure rebuilds the hash tables of monomials and constants using
+  only the live monomials (and the 1-monomial, which keeps index 0), remaps
+  the coefficients, and recreates the literal-to-monomial lists. The lists
+  of the objects that are already substituted are empty at this point.
+  Returns the number of live monomials.]
+               
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+int Gia_PolynCompact( Hsh_VecMan_t ** ppHashC, Hsh_VecMan_t ** ppHashM, Vec_Int_t * vCoefs, Vec_Wec_t * vLit2Mono )
+{
+    Hsh_VecMan_t * pHashC = Hsh_VecManStart( Hsh_VecSize(*ppHashC) );
+    Hsh_VecMan_t * pHashM = NULL;
+    Vec_Int_t * vMapC  = Vec_IntStartFull( Hsh_VecSize(*ppHashC) );
+    Vec_Int_t * vLive  = Vec_IntAlloc( 1000 );
+    Vec_Int_t * vTemp  = Vec_IntAlloc( 0 );
+    Vec_Int_t * vLevel, * vArray;
+    int i, k, iLit, iMono, iConst, iMonoNew;
+    // collect live monomials
+    Vec_IntPush( vLive, 0 );
+    Vec_IntForEachEntryStart( vCoefs, iConst, iMono, 1 )
+        if ( iConst )
+            Vec_IntPush( vLive, iMono );
+    pHashM = Hsh_VecManStart( Vec_IntSize(vLive) );
+    // add 0-constant 
+    Hsh_VecManAdd( pHashC, vTemp );
+    Vec_IntWriteEntry( vMapC, 0, 0 );
+    // remap the constants of live monomials
+    Vec_IntForEachEntry( vLive, iMono, i )
+    {
+        iConst = Vec_IntEntry( vCoefs, iMono );
+        if ( Vec_IntEntry(vMapC, iConst) == -1 )
+            Vec_IntWriteEntry( vMapC, iConst, Hsh_VecManAdd(pHashC, Hsh_VecReadEntry(*ppHashC, iConst)) );
+        Vec_IntWriteEntry( vLive, i, Vec_IntEntry(vMapC, iConst) );
+        Vec_IntWriteEntry( vCoefs, i, iMono );
+    }
+    // rebuild the monomials (vCoefs temporarily holds the old monomial IDs)
+    Vec_WecForEachLevel( vLit2Mono, vLevel, i )
+        Vec_IntClear( vLevel );
+    Vec_IntForEachEntry( vLive, iConst, i )
+    {
+        vArray = Hsh_VecReadEntry( *ppHashM, Vec_IntEntry(vCoefs, i) );
+        iMonoNew = Hsh_VecManAdd( pHashM, vArray );
+        assert( iMonoNew == i );
+        Vec_IntForEachEntry( vArray, iLit, k )
+            Vec_WecPush( vLit2Mono, iLit, iMonoNew );
+    }
+    Vec_IntClear( vCoefs );
+    Vec_IntAppend( vCoefs, vLive );
+    Hsh_VecManStop( *ppHashC );
+    Hsh_VecManStop( *ppHashM );
+    *ppHashC = pHashC;
+    *ppHashM = pHashM;
+    Vec_IntFree( vMapC );
+    Vec_IntFree( vLive );
+    Vec_IntFree( vTemp );
+    return Vec_IntSize(vCoefs) - (int)(Vec_IntEntry(vCoefs, 0) == 0);
+}
+static inline double Gia_PolynMemory( Hsh_VecMan_t * pHashC, Hsh_VecMan_t * pHashM, Vec_Int_t * vCoefs, Vec_Wec_t * vLit2Mono )
+{
+    return Hsh_VecManMemory(pHashC) + Hsh_VecManMemory(pHashM) + Vec_IntMemory(vCoefs) + Vec_WecMemory(vLit2Mono);
+}
+
 Vec_Wec_t * Gia_PolynBuildNew( Gia_Man_t * pGia, Vec_Wec_t * vSign, Vec_Int_t * vRootLits, int nExtra, Vec_Int_t * vLeaves, Vec_Int_t * vNodes, int fSigned, int fVerbose, int fVeryVerbose )
 {
     abctime clk = Abc_Clock();
@@ -646,6 +719,8 @@ Vec_Wec_t * Gia_PolynBuildNew( Gia_Man_t * pGia, Vec_Wec_t * vSign, Vec_Int_t *
     Vec_Int_t * vCoefs    = Vec_IntAlloc( 1000 );       // monomial coefficients
     Vec_Int_t * vTempC[4],  * vTempM[4];                // temporary array
     int i, k, iObj, iLit, iMono, iConst, nMonos = 0, nBuilds = 0;
+    int nCompacts = 0, nLimit = ACEC_POLYN_COMPACT_MIN;    // compaction of the monomial store
+    double MemPeak = 0;
     for ( i = 0; i < 4; i++ )
         vTempC[i] = Vec_IntAlloc( 10 );
     for ( i = 0; i < 4; i++ )
@@ -770,7 +845,17 @@ Vec_Wec_t * Gia_PolynBuildNew( Gia_Man_t * pGia, Vec_Wec_t * vSign, Vec_Int_t *
                 nBuilds++;
             }
         //printf( "Obj %5d : nMonos = %6d  nUsed = %6d\n", iObj, nBuilds, nMonos );
+        // the object does not appear in the remaining monomials
+        Vec_IntErase( vArray );
+        if ( Hsh_VecSize(pHashM) < nLimit )
+            continue;
+        // most of the monomials are dead - compact the store
+        MemPeak = Abc_MaxDouble( MemPeak, Gia_PolynMemory(pHashC, pHashM, vCoefs, vLit2Mono) );
+        nMonos = Gia_PolynCompact( &pHashC, &pHashM, vCoefs, vLit2Mono );
+        nLimit = Abc_MaxInt( ACEC_POLYN_COMPACT_MIN, 2 * Hsh_VecSize(pHashM) );
+        nCompacts++;
     }
+    MemPeak = Abc_MaxDouble( MemPeak, Gia_PolynMemory(pHashC, pHashM, vCoefs, vLit2Mono) );
 
     // get the results
     vPolyn = Gia_PolynGetResult( pHashC, pHashM, vCoefs );
@@ -778,6 +863,8 @@ Vec_Wec_t * Gia_PolynBuildNew( Gia_Man_t * pGia, Vec_Wec_t * vSign, Vec_Int_t *
     printf( "HashC = %d. HashM = %d.  Total = %d. Left = %d.  Used = %d.  ", 
         Hsh_VecSize(pHashC), Hsh_VecSize(pHashM), nBuilds, nMonos, Vec_WecSize(vPolyn)/2 );
     Abc_PrintTime( 1, "Time", Abc_Clock() - clk );
+    if ( fVerbose )
+        printf( "Compacted the monomial store %d times.  Peak memory = %.2f MB.\n", nCompacts, MemPeak / (1 << 20) );
 
     for ( i = 0; i < 4; i++ )
         Vec_IntFree( vTempC[i] );
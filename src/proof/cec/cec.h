@@ -53,6 +53,7 @@ struct Cec_ParSat_t_
 //    int              fFirstStop;    // stop on the first sat output
     int              fLearnCls;     // perform clause learning
     int              fSaveCexes;    // saves counter-examples
+    int              nProcs;        // the number of threads of the batched circuit-based solver
     int              fVerbose;      // verbose stats
 };
 
@@ -115,6 +116,7 @@ struct Cec_ParFra_t_
     int              fColorDiff;    // miter with separate outputs
     int              fSatSweeping;  // enable SAT sweeping
     int              fRunCSat;      // enable another solver
+    int              nProcs;        // the number of threads of the batched circuit-based solver
     int              fUseCones;     // use cones
     int              fUseOrigIds;   // enable recording of original IDs
     int              fVeryVerbose;  // verbose stats
@@ -810,9 +810,13 @@ void Cec_ManSatSolveCSat( Cec_ManPat_t * pPat, Gia_Man_t * pAig, Cec_ParSat_t *
 {
     Vec_Str_t * vStatus;
     Vec_Int_t * vPat = Vec_IntAlloc( 1000 );
-    Vec_Int_t * vCexStore = Cbs_ManSolveMiterNc( pAig, pPars->nBTLimit, &vStatus, 0, 0 );
+    Vec_Int_t * vCexStore;
     Gia_Obj_t * pObj;
     int i, status, iStart = 0;
+    if ( pPars->nProcs > 0 )
+        vCexStore = Cbs3_ManSolveMiterPar( pAig, pPars->nBTLimit, 1, pPars->nProcs, &vStatus, 0 );
+    else
+        vCexStore = Cbs_ManSolveMiterNc( pAig, pPars->nBTLimit, &vStatus, 0, 0 );
     assert( Vec_StrSize(vStatus) == Gia_ManCoNum(pAig) );
     // reset the manager
     if ( pPat )
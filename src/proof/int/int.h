@@ -64,9 +64,13 @@ struct Inter_ManParams_t_
     int  fUseTwoFrames; // create the OR of two last timeframes
     int  fDropSatOuts;  // replace by 1 the solved outputs
     int  fDropInvar;    // dump inductive invariant into file
+    int  nProcs;        // the number of engines running concurrently
+    int  fSilent;       // suppress all messages
     int  fVerbose;      // print verbose statistics
     int  iFrameMax;     // the time frame reached
     char * pFileName;   // file name to dump interpolant
+    int  RunId;         // the engine ID in this run
+    int(*pFuncStop)(int); // callback to terminate
 };
 
 ////////////////////////////////////////////////////////////////////////
@@ -80,6 +84,8 @@ struct Inter_ManParams_t_
 /*=== intCore.c ==========================================================*/
 extern void       Inter_ManSetDefaultParams( Inter_ManParams_t * p );
 extern int        Inter_ManPerformInterpolation( Aig_Man_t * pAig, Inter_ManParams_t * pPars, int * piFrame );
+/*=== intPar.c ==========================================================*/
+extern int        Inter_ManPerformPortfolio( Aig_Man_t * pAig, Inter_ManParams_t * pPars, int * piFrame );
 
 
 
@@ -54,7 +54,9 @@ int Inter_ManCheckContainment( Aig_Man_t * pNew, Aig_Man_t * pOld )
     RetValue = Fra_FraigMiterStatus( pMiter );
     if ( RetValue == -1 )
     {
+        Inter_ManLock();
         pAigTemp = Fra_FraigEquivence( pMiter, 1000000, 1 );
+        Inter_ManUnlock();
         RetValue = Fra_FraigMiterStatus( pAigTemp );
         Aig_ManStop( pAigTemp );
 //        RetValue = Fra_FraigSat( pMiter, 1000000, 0, 0, 0, 0, 0, 0 );
@@ -85,7 +87,9 @@ int Inter_ManCheckEquivalence( Aig_Man_t * pNew, Aig_Man_t * pOld )
     RetValue = Fra_FraigMiterStatus( pMiter );
     if ( RetValue == -1 )
     {
+        Inter_ManLock();
         pAigTemp = Fra_FraigEquivence( pMiter, 1000000, 1 );
+        Inter_ManUnlock();
         RetValue = Fra_FraigMiterStatus( pAigTemp );
         Aig_ManStop( pAigTemp );
 //        RetValue = Fra_FraigSat( pMiter, 1000000, 0, 0, 0, 0, 0, 0 );
@@ -220,7 +224,7 @@ int Inter_ManCheckInductiveContainment( Aig_Man_t * pTrans, Aig_Man_t * pInter,
     Aig_ManCleanup( pFrames );
 
     // convert to CNF
-    pCnf = Cnf_Derive( pFrames, 0 ); 
+    pCnf = Inter_ManCnfDerive( pFrames, 0 ); 
     pSat = (sat_solver *)Cnf_DataWriteIntoSolver( pCnf, 1, 0 );
 //    Cnf_DataFree( pCnf );
 //    Aig_ManStop( pFrames );
@@ -70,6 +70,8 @@ struct Inter_Man_t_
     int              nConfLimit;   // the limit on the number of conflicts
     int              fVerbose;     // the verbosiness flag
     char *           pFileName;
+    int              RunId;        // the engine ID in this run
+    int(*pFuncStop)(int);          // callback to terminate
     // runtime
     abctime          timeRwr;
     abctime          timeCnf;
@@ -125,6 +127,12 @@ extern int             Inter_ManPerformOneStep( Inter_Man_t * p, int fUseBias, i
 extern int             Inter_ManPerformOneStepM114p( Inter_Man_t * p, int fUsePudlak, int fUseOther );
 #endif
 
+/*=== intPar.c ============================================================*/
+extern void            Inter_ManLock();
+extern void            Inter_ManUnlock();
+extern Cnf_Dat_t *     Inter_ManCnfDerive( Aig_Man_t * pAig, int nOutputs );
+extern Aig_Man_t *     Inter_ManRwsat( Aig_Man_t * pAig );
+
 /*=== intUtil.c ============================================================*/
 extern int             Inter_ManCheckInitialState( Aig_Man_t * p );
 extern int             Inter_ManCheckAllStates( Aig_Man_t * p );
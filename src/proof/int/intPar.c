@@ -0,0 +1,295 @@
+/**CFile****************************************************************
+
+  FileName    [intPar.c]
+
+  SystemName  [ABC: Logic synthesis and verification system.]
+
+  PackageName [Interpolation engine.]
+
+  Synopsis    [Portfolio of interpolation engines running on threads.]
+
+  Author      [ABC contributors]
+
+  Affiliation [UC Berkeley]
+
+  Date        [Ver. 1.0. Started - October 18, 2026.]
+
+  Revision    [$Id: intPar.c,v 1.00 2026/10/18 00:00:00 agent Exp $]
+
+***********************************************************************/
+
+#include "intInt.h"
+#include "opt/dar/dar.h"
+
+#ifdef ABC_USE_PTHREADS
+
+#ifdef _WIN32
+#include "../lib/pthread.h"
+#else
+#include <pthread.h>
+#include <sched.h>
+#include <unistd.h>
+#endif
+
+#endif
+
+ABC_NAMESPACE_IMPL_START
+
+
+////////////////////////////////////////////////////////////////////////
+///                        DECLARATIONS                              ///
+////////////////////////////////////////////////////////////////////////
+
+#define INTER_PAR_MAX 8   // the number of different engines
+
+#ifdef ABC_USE_PTHREADS
+// serializes the procedures using global data (CNF manager, rewriting library)
+static pthread_mutex_t s_InterMutex = PTHREAD_MUTEX_INITIALIZER;
+#endif
+
+// set when one of the engines solved the problem
+static volatile int s_fInterParStop = 0;
+
+////////////////////////////////////////////////////////////////////////
+///                     FUNCTION DEFINITIONS                         ///
+////////////////////////////////////////////////////////////////////////
+
+/**Function*************************************************************
+
+  Synopsis    [Serializes the calls that are not reentrant.]
+
+  Description [Cnf_Derive() uses the global CNF manager and Dar_ManRwsat()
+  uses the global AIG rewriting library. These are called through the
+  wrappers below, so that several engines can run concurrently.]
+
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+void Inter_ManLock()
+{
+#ifdef ABC_USE_PTHREADS
+    pthread_mutex_lock( &s_InterMutex );
+#endif
+}
+void Inter_ManUnlock()
+{
+#ifdef ABC_USE_PTHREADS
+    pthread_mutex_unlock( &s_InterMutex );
+#endif
+}
+Cnf_Dat_t * Inter_ManCnfDerive( Aig_Man_t * pAig, int nOutputs )
+{
+    Cnf_Dat_t * pCnf;
+    Inter_ManLock();
+    pCnf = Cnf_Derive( pAig, nOutputs );
+    Inter_ManUnlock();
+    return pCnf;
+}
+Aig_Man_t * Inter_ManRwsat( Aig_Man_t * pAig )
+{
+    Aig_Man_t * pNew;
+    Inter_ManLock();
+    pNew = Dar_ManRwsat( pAig, 1, 0 );
+    Inter_ManUnlock();
+    return pNew;
+}
+
+/**Function*************************************************************
+
+  Synopsis    [Sets the parameters of one engine of the portfolio.]
+
+  Description [Engine 0 uses the user's parameters. The other engines
+  change the unrolling depth, the direction, or the containment check.]
+
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+static void Inter_ManParSetEngine( Inter_ManParams_t * p, Inter_ManParams_t * pPars, int iEngine )
+{
+    *p = *pPars;
+    p->fVerbose   = 0;
+    p->fSilent    = 1;
+    p->fDropInvar = pPars->fDropInvar && iEngine == 0;
+    if ( iEngine == 1 )
+        p->fUseBias ^= 1;
+    else if ( iEngine == 2 )
+        p->nFramesK = 2 * pPars->nFramesK;
+    else if ( iEngine == 3 )
+    {
+        p->fUseBackward ^= 1;
+        p->fTransLoop = p->fUseBackward;
+    }
+    else if ( iEngine == 4 )
+        p->fUseTwoFrames ^= 1;
+    else if ( iEngine == 5 )
+        p->fRewrite ^= 1;
+    else if ( iEngine == 6 )
+        p->nFramesK = 4 * pPars->nFramesK;
+    else if ( iEngine == 7 )
+        p->fCheckKstep ^= 1;
+    // backward interpolation works with K = 1 only
+    if ( p->nFramesK > 1 || p->fUseMiniSat )
+        p->fUseBackward = 0;
+    else if ( p->fUseBackward )
+        p->fTransLoop = 1;
+}
+static char * Inter_ManParEngineName( int iEngine )
+{
+    static char * pNames[INTER_PAR_MAX] = { "default", "bias", "K*2", "backward", "two-frames", "rewrite", "K*4", "other-check" };
+    return pNames[iEngine];
+}
+static int Inter_ManParStop( int RunId )
+{
+    return s_fInterParStop;
+}
+
+/**Function*************************************************************
+
+  Synopsis    [Runs one engine of the portfolio.]
+
+  Description []
+
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+typedef struct Inter_ParThData_t_
+{
+    Aig_Man_t *       pAig;     // the copy of the AIG
+    Inter_ManParams_t Pars;     // the parameters of this engine
+    int               iEngine;  // the engine number
+    int               iFrame;   // the frame of the counter-example
+    int               Result;   // the result of this engine
+    int               fWorking; // the engine is running
+} Inter_ParThData_t;
+
+static void Inter_ManParRunOne( Inter_ParThData_t * pThData )
+{
+    pThData->Pars.RunId     = pThData->iEngine;
+    pThData->Pars.pFuncStop = Inter_ManParStop;
+    pThData->Result = Inter_ManPerformInterpolation( pThData->pAig, &pThData->Pars, &pThData->iFrame );
+    if ( pThData->Result != -1 )
+        s_fInterParStop = 1;
+}
+
+#ifdef ABC_USE_PTHREADS
+
+static void * Inter_ManParWorkerThread( void * pArg )
+{
+    Inter_ParThData_t * pThData = (Inter_ParThData_t *)pArg;
+    Inter_ManParRunOne( pThData );
+    pThData->fWorking = 0;
+    pthread_exit( NULL );
+    assert( 0 );
+    return NULL;
+}
+
+#endif // pthreads are used
+
+/**Function*************************************************************
+
+  Synopsis    [Runs several interpolation engines concurrently.]
+
+  Description [Each engine works on its own copy of the AIG. The first
+  engine that proves or disproves the property stops the other ones.
+  Returns 1 if proven, 0 if failed, -1 if undecided. If the property
+  fails, the counter-example is transferred to pAig->pSeqModel.]
+
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+int Inter_ManPerformPortfolio( Aig_Man_t * pAig, Inter_ManParams_t * pPars, int * piFrame )
+{
+    Inter_ParThData_t ThData[INTER_PAR_MAX];
+#ifdef ABC_USE_PTHREADS
+    pthread_t WorkerThread[INTER_PAR_MAX];
+    int status;
+#endif
+    abctime clk = Abc_Clock();
+    int i, iWinner = -1, RetValue = -1;
+    int nProcs = Abc_MinInt( pPars->nProcs, INTER_PAR_MAX );
+    if ( nProcs <= 1 )
+        return Inter_ManPerformInterpolation( pAig, pPars, piFrame );
+    if ( Inter_ManCheckInitialState(pAig) )
+    {
+        *piFrame = -1;
+        printf( "Property trivially fails in the initial state.\n" );
+        return 0;
+    }
+    if ( pPars->fVerbose )
+        printf( "Running %d interpolation engines concurrently.\n", nProcs );
+    s_fInterParStop = 0;
+    for ( i = 0; i < nProcs; i++ )
+    {
+        ThData[i].pAig     = Aig_ManDupSimple( pAig );
+        ThData[i].iEngine  = i;
+        ThData[i].iFrame   = -1;
+        ThData[i].Result   = -1;
+        ThData[i].fWorking = 1;
+        Inter_ManParSetEngine( &ThData[i].Pars, pPars, i );
+    }
+#ifdef ABC_USE_PTHREADS
+    for ( i = 0; i < nProcs; i++ )
+    {
+        status = pthread_create( WorkerThread + i, NULL, Inter_ManParWorkerThread, (void *)(ThData + i) );  assert( status == 0 );
+    }
+    // wait till all engines finish (the first one to solve the problem stops the others)
+    for ( i = 0; i < nProcs; i++ )
+        while ( ((volatile int *)&ThData[i].fWorking)[0] )
+            sched_yield();
+    for ( i = 0; i < nProcs; i++ )
+        pthread_join( WorkerThread[i], NULL );
+#else
+    // run the engines one after another
+    for ( i = 0; i < nProcs && !s_fInterParStop; i++ )
+    {
+        Inter_ManParRunOne( ThData + i );
+        ThData[i].fWorking = 0;
+    }
+#endif
+    // collect the results
+    for ( i = 0; i < nProcs; i++ )
+    {
+        if ( iWinner == -1 && ThData[i].Result != -1 )
+            iWinner = i;
+        pPars->iFrameMax = Abc_MaxInt( pPars->iFrameMax, ThData[i].Pars.iFrameMax );
+    }
+    if ( iWinner >= 0 )
+    {
+        RetValue = ThData[iWinner].Result;
+        *piFrame = ThData[iWinner].iFrame;
+        if ( RetValue == 0 )
+        {
+            Abc_CexFreeP( &pAig->pSeqModel );
+            pAig->pSeqModel = ThData[iWinner].pAig->pSeqModel;
+            ThData[iWinner].pAig->pSeqModel = NULL;
+        }
+    }
+    for ( i = 0; i < nProcs; i++ )
+        Aig_ManStop( ThData[i].pAig );
+    s_fInterParStop = 0;
+    if ( pPars->fVerbose )
+    {
+        if ( iWinner >= 0 )
+            printf( "The problem was solved by engine %d (%s).  ", iWinner, Inter_ManParEngineName(iWinner) );
+        else
+            printf( "None of the engines solved the problem.  " );
+        ABC_PRT( "Time", Abc_Clock() - clk );
+    }
+    return RetValue;
+}
+
+
+////////////////////////////////////////////////////////////////////////
+///                       END OF FILE                                ///
+////////////////////////////////////////////////////////////////////////
+
+
+ABC_NAMESPACE_IMPL_END
@@ -50,7 +50,7 @@ int Inter_ManCheckInitialState( Aig_Man_t * p )
     sat_solver * pSat;
     int i, status;
     //abctime clk = Abc_Clock();
-    pCnf = Cnf_Derive( p, Saig_ManRegNum(p) ); 
+    pCnf = Inter_ManCnfDerive( p, Saig_ManRegNum(p) ); 
     pSat = (sat_solver *)Cnf_DataWriteIntoSolver( pCnf, 1, 1 );
     if ( pSat == NULL )
     {
@@ -88,7 +88,7 @@ int Inter_ManCheckAllStates( Aig_Man_t * p )
     sat_solver * pSat;
     int status;
     abctime clk = Abc_Clock();
-    pCnf = Cnf_Derive( p, Saig_ManRegNum(p) ); 
+    pCnf = Inter_ManCnfDerive( p, Saig_ManRegNum(p) ); 
     pSat = (sat_solver *)Cnf_DataWriteIntoSolver( pCnf, 1, 0 );
     Cnf_DataFree( pCnf );
     if ( pSat == NULL )
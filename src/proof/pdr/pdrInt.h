@@ -126,6 +126,7 @@ struct Pdr_Man_t_
     int         nCexesTotal;
     // terminary simulation
     Txs3_Man_t * pTxs3;      
+    Gia_Tsi_t * pTsi;      // bit-sliced ternary simulator
     // internal use
     Vec_Int_t * vPrio;     // priority flops
     Vec_Int_t * vLits;     // array of literals
@@ -134,8 +135,7 @@ struct Pdr_Man_t_
     Vec_Int_t * vCiVals;   // cone leaf values
     Vec_Int_t * vCoVals;   // cone root values
     Vec_Int_t * vNodes;    // cone nodes
-    Vec_Int_t * vUndo;     // cone undos
-    Vec_Int_t * vVisits;   // intermediate
+    Vec_Int_t * vObj2Tsi;  // mapping of cone objects into simulator literals
     Vec_Int_t * vCi2Rem;   // CIs to be removed
     Vec_Int_t * vRes;      // final result
     abctime *   pTime4Outs;// timeout per output
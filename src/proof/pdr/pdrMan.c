@@ -275,18 +275,16 @@ Pdr_Man_t * Pdr_ManStart( Aig_Man_t * pAig, Pdr_Par_t * pPars, Vec_Int_t * vPrio
     p->vCiVals  = Vec_IntAlloc( 100 );  // cone leaf values
     p->vCoVals  = Vec_IntAlloc( 100 );  // cone root values
     p->vNodes   = Vec_IntAlloc( 100 );  // cone nodes
-    p->vUndo    = Vec_IntAlloc( 100 );  // cone undos
-    p->vVisits  = Vec_IntAlloc( 100 );  // intermediate
+    p->vObj2Tsi = Vec_IntStartFull( Aig_ManObjNumMax(pAig) );  // cone objects
     p->vCi2Rem  = Vec_IntAlloc( 100 );  // CIs to be removed
     p->vRes     = Vec_IntAlloc( 100 );  // final result
     p->pCnfMan  = Cnf_ManStart();
     // ternary simulation
     p->pTxs3    = pPars->fNewXSim ? Txs3_ManStart( p, pAig, p->vPrio ) : NULL;
+    p->pTsi     = pPars->fNewXSim ? NULL : Gia_TsiAlloc( 1 );
     // additional AIG data-members
     if ( pAig->pFanData == NULL )
         Aig_ManFanoutStart( pAig );
-    if ( pAig->pTerSimData == NULL )
-        pAig->pTerSimData = ABC_CALLOC( unsigned, 1 + (Aig_ManObjNumMax(pAig) / 16) );
     // time spent on each outputs
     if ( pPars->nTimeOutOne )
     {
@@ -370,6 +368,8 @@ void Pdr_ManStop( Pdr_Man_t * p )
     // terminary simulation
     if ( p->pPars->fNewXSim )
         Txs3_ManStop( p->pTxs3 );
+    if ( p->pTsi )
+        Gia_TsiFree( p->pTsi );
     // internal use
     Vec_IntFreeP( &p->vPrio   );  // priority flops
     Vec_IntFree( p->vLits     );  // array of literals
@@ -378,8 +378,7 @@ void Pdr_ManStop( Pdr_Man_t * p )
     Vec_IntFree( p->vCiVals   );  // cone leaf values
     Vec_IntFree( p->vCoVals   );  // cone root values
     Vec_IntFree( p->vNodes    );  // cone nodes
-    Vec_IntFree( p->vUndo     );  // cone undos
-    Vec_IntFree( p->vVisits   );  // intermediate
+    Vec_IntFree( p->vObj2Tsi  );  // cone objects
     Vec_IntFree( p->vCi2Rem   );  // CIs to be removed
     Vec_IntFree( p->vRes      );  // final result
     Vec_PtrFreeP( &p->vInfCubes );
@@ -19,6 +19,7 @@
 ***********************************************************************/
 
 #include "pdrInt.h"
+#include "misc/util/utilTruth.h"
 
 ABC_NAMESPACE_IMPL_START
 
@@ -26,38 +27,9 @@ ABC_NAMESPACE_IMPL_START
 ///                        DECLARATIONS                              ///
 ////////////////////////////////////////////////////////////////////////
 
-#define PDR_ZER 1
-#define PDR_ONE 2
-#define PDR_UND 3
-
-static inline int Pdr_ManSimInfoNot( int Value )
-{
-    if ( Value == PDR_ZER )
-        return PDR_ONE;
-    if ( Value == PDR_ONE )
-        return PDR_ZER;
-    return PDR_UND;
-}
-
-static inline int Pdr_ManSimInfoAnd( int Value0, int Value1 )
+static inline int Pdr_ManTsiLit( Vec_Int_t * vObj2Tsi, Aig_Obj_t * pChild )
 {
-    if ( Value0 == PDR_ZER || Value1 == PDR_ZER )
-        return PDR_ZER;
-    if ( Value0 == PDR_ONE && Value1 == PDR_ONE )
-        return PDR_ONE;
-    return PDR_UND;
-}
-
-static inline int Pdr_ManSimInfoGet( Aig_Man_t * p, Aig_Obj_t * pObj )
-{
-    return 3 & (p->pTerSimData[Aig_ObjId(pObj) >> 4] >> ((Aig_ObjId(pObj) & 15) << 1));
-}
-
-static inline void Pdr_ManSimInfoSet( Aig_Man_t * p, Aig_Obj_t * pObj, int Value )
-{
-    assert( Value >= PDR_ZER && Value <= PDR_UND );
-    Value ^= Pdr_ManSimInfoGet( p, pObj );
-    p->pTerSimData[Aig_ObjId(pObj) >> 4] ^= (Value << ((Aig_ObjId(pObj) & 15) << 1));
+    return Abc_LitNotCond( Vec_IntEntry(vObj2Tsi, Aig_ObjId(Aig_Regular(pChild))), Aig_IsComplement(pChild) );
 }
 
 ////////////////////////////////////////////////////////////////////////
@@ -118,146 +90,106 @@ void Pdr_ManCollectCone( Aig_Man_t * pAig, Vec_Int_t * vCoObjs, Vec_Int_t * vCiO
 
 /**Function*************************************************************
 
-  Synopsis    [Performs ternary simulation for one node.]
+  Synopsis    [Loads the cone into the ternary simulator.]
+
+  Description [The CIs of the simulator are the cone leaves in the same
+  order. The COs are the cone roots. All patterns are set to the values
+  of the leaves.]
 
-  Description []
-               
   SideEffects []
 
   SeeAlso     []
 
 ***********************************************************************/
-int Pdr_ManExtendOneEval( Aig_Man_t * pAig, Aig_Obj_t * pObj )
+void Pdr_ManTsiLoad( Pdr_Man_t * p, Vec_Int_t * vCiObjs, Vec_Int_t * vCiVals, Vec_Int_t * vNodes, Vec_Int_t * vCoObjs )
 {
-    int Value0, Value1, Value;
-    Value0 = Pdr_ManSimInfoGet( pAig, Aig_ObjFanin0(pObj) );
-    if ( Aig_ObjFaninC0(pObj) )
-        Value0 = Pdr_ManSimInfoNot( Value0 );
-    if ( Aig_ObjIsCo(pObj) )
+    Aig_Obj_t * pObj;
+    int i, iLit;
+    Gia_TsiClear( p->pTsi );
+    Vec_IntWriteEntry( p->vObj2Tsi, Aig_ObjId(Aig_ManConst1(p->pAig)), 1 );
+    Aig_ManForEachObjVec( vCiObjs, p->pAig, pObj, i )
     {
-        Pdr_ManSimInfoSet( pAig, pObj, Value0 );
-        return Value0;
+        Vec_IntWriteEntry( p->vObj2Tsi, Aig_ObjId(pObj), Gia_TsiAddCi(p->pTsi) );
+        Gia_TsiSetCiAll( p->pTsi, i, Vec_IntEntry(vCiVals, i) ? GIA_ONE : GIA_ZER );
     }
-    assert( Aig_ObjIsNode(pObj) );
-    Value1 = Pdr_ManSimInfoGet( pAig, Aig_ObjFanin1(pObj) );
-    if ( Aig_ObjFaninC1(pObj) )
-        Value1 = Pdr_ManSimInfoNot( Value1 );
-    Value = Pdr_ManSimInfoAnd( Value0, Value1 );
-    Pdr_ManSimInfoSet( pAig, pObj, Value );
-    return Value;
+    Aig_ManForEachObjVec( vNodes, p->pAig, pObj, i )
+    {
+        iLit = Gia_TsiAddAnd( p->pTsi, Pdr_ManTsiLit(p->vObj2Tsi, Aig_ObjChild0(pObj)), Pdr_ManTsiLit(p->vObj2Tsi, Aig_ObjChild1(pObj)) );
+        Vec_IntWriteEntry( p->vObj2Tsi, Aig_ObjId(pObj), iLit );
+    }
+    Aig_ManForEachObjVec( vCoObjs, p->pAig, pObj, i )
+        Gia_TsiAddCo( p->pTsi, Pdr_ManTsiLit(p->vObj2Tsi, Aig_ObjChild0(pObj)) );
+    Gia_TsiSimulate( p->pTsi );
 }
 
 /**Function*************************************************************
 
-  Synopsis    [Performs ternary simulation for one design.]
+  Synopsis    [Returns the first pattern in which the roots are not justified.]
 
-  Description []
+  Description [Returns -1 if the roots have the required values in the 
+  first nPats patterns.]
 
   SideEffects []
 
   SeeAlso     []
 
 ***********************************************************************/
-int Pdr_ManSimDataInit( Aig_Man_t * pAig,
-    Vec_Int_t * vCiObjs, Vec_Int_t * vCiVals, Vec_Int_t * vNodes,
-    Vec_Int_t * vCoObjs, Vec_Int_t * vCoVals, Vec_Int_t * vCi2Rem )
+int Pdr_ManTsiCheck( Pdr_Man_t * p, Vec_Int_t * vCoVals, int nPats )
 {
-    Aig_Obj_t * pObj;
+    word Diff = 0;
     int i;
-    // set the CI values
-    Pdr_ManSimInfoSet( pAig, Aig_ManConst1(pAig), PDR_ONE );
-    Aig_ManForEachObjVec( vCiObjs, pAig, pObj, i )
-        Pdr_ManSimInfoSet( pAig, pObj, (Vec_IntEntry(vCiVals, i)?PDR_ONE:PDR_ZER) );
-    // set the FOs to remove
-    if ( vCi2Rem != NULL )
-    Aig_ManForEachObjVec( vCi2Rem, pAig, pObj, i )
-        Pdr_ManSimInfoSet( pAig, pObj, PDR_UND );
-    // perform ternary simulation
-    Aig_ManForEachObjVec( vNodes, pAig, pObj, i )
-        Pdr_ManExtendOneEval( pAig, pObj );
-    // transfer results to the output
-    Aig_ManForEachObjVec( vCoObjs, pAig, pObj, i )
-        Pdr_ManExtendOneEval( pAig, pObj );
-    // check the results
-    Aig_ManForEachObjVec( vCoObjs, pAig, pObj, i )
-        if ( Pdr_ManSimInfoGet( pAig, pObj ) != (Vec_IntEntry(vCoVals, i)?PDR_ONE:PDR_ZER) )
-            return 0;
-    return 1;
+    assert( nPats > 0 && nPats <= 64 );
+    for ( i = 0; i < Vec_IntSize(vCoVals); i++ )
+        Diff |= Gia_TsiCoDiffer( p->pTsi, i, Vec_IntEntry(vCoVals, i) ? GIA_ONE : GIA_ZER, 0 );
+    if ( nPats < 64 )
+        Diff &= (((word)1) << nPats) - 1;
+    return Diff ? Abc_Tt6FirstBit( Diff ) : -1;
 }
 
 /**Function*************************************************************
 
-  Synopsis    [Tries to assign ternary value to one of the CIs.]
+  Synopsis    [Tries to make the leaves undefined.]
 
-  Description []
+  Description [The candidates (leaf indexes) are tried in the given order.
+  A candidate is removed if the roots remain justified when it, together 
+  with the candidates removed before, is undefined. Up to 64 candidates 
+  are evaluated in one simulation pass: pattern k makes undefined the 
+  first k+1 candidates of the batch. Since undefined values are monotone, 
+  the first failing pattern gives the first candidate to keep, and the 
+  result is the same as when the candidates are tried one at a time.]
 
   SideEffects []
 
   SeeAlso     []
 
 ***********************************************************************/
-int Pdr_ManExtendOne( Aig_Man_t * pAig, Aig_Obj_t * pObj, Vec_Int_t * vUndo, Vec_Int_t * vVis )
+void Pdr_ManTsiExtend( Pdr_Man_t * p, Vec_Int_t * vCands, Vec_Int_t * vCiObjs, Vec_Int_t * vCiVals, Vec_Int_t * vCoVals, Vec_Int_t * vCi2Rem )
 {
-    Aig_Obj_t * pFanout;
-    int i, k, iFanout = -1, Value, Value2;
-    assert( Saig_ObjIsLo(pAig, pObj) );
-    assert( Aig_ObjIsTravIdCurrent(pAig, pObj) );
-    // save original value
-    Value = Pdr_ManSimInfoGet( pAig, pObj );
-    assert( Value == PDR_ZER || Value == PDR_ONE );
-    Vec_IntPush( vUndo, Aig_ObjId(pObj) );
-    Vec_IntPush( vUndo, Value );
-    // update original value
-    Pdr_ManSimInfoSet( pAig, pObj, PDR_UND );
-    // traverse
-    Vec_IntClear( vVis );
-    Vec_IntPush( vVis, Aig_ObjId(pObj) );
-    Aig_ManForEachObjVec( vVis, pAig, pObj, i )
+    int k, iCi, Value, nPats, iFail, nRemoved, iStart = 0;
+    while ( iStart < Vec_IntSize(vCands) )
     {
-        Aig_ObjForEachFanout( pAig, pObj, pFanout, iFanout, k )
+        nPats = Abc_MinInt( 64, Vec_IntSize(vCands) - iStart );
+        for ( k = 0; k < nPats; k++ )
         {
-            if ( !Aig_ObjIsTravIdCurrent(pAig, pFanout) )
-                continue;
-            assert( Aig_ObjId(pObj) < Aig_ObjId(pFanout) );
-            Value = Pdr_ManSimInfoGet( pAig, pFanout );
-            if ( Value == PDR_UND )
-                continue;
-            Value2 = Pdr_ManExtendOneEval( pAig, pFanout );
-            if ( Value2 == Value )
-                continue;
-            assert( Value2 == PDR_UND );
-            Vec_IntPush( vUndo, Aig_ObjId(pFanout) );
-            Vec_IntPush( vUndo, Value );
-            if ( Aig_ObjIsCo(pFanout) )
-                return 0;
-            assert( Aig_ObjIsNode(pFanout) );
-            Vec_IntPushOrder( vVis, Aig_ObjId(pFanout) );
+            word Und = ~((((word)1) << k) - 1);
+            iCi   = Vec_IntEntry( vCands, iStart + k );
+            Value = Vec_IntEntry( vCiVals, iCi );
+            Gia_TsiSetCiWord( p->pTsi, iCi, 0, Value ? 0 : ~Und, Value ? ~Und : 0 );
         }
+        Gia_TsiSimulateInc( p->pTsi );
+        iFail = Pdr_ManTsiCheck( p, vCoVals, nPats );
+        nRemoved = iFail == -1 ? nPats : iFail;
+        for ( k = 0; k < nPats; k++ )
+        {
+            iCi   = Vec_IntEntry( vCands, iStart + k );
+            Value = Vec_IntEntry( vCiVals, iCi );
+            if ( k < nRemoved )
+                Vec_IntPush( vCi2Rem, Vec_IntEntry(vCiObjs, iCi) );
+            Gia_TsiSetCiAll( p->pTsi, iCi, k < nRemoved ? GIA_UND : (Value ? GIA_ONE : GIA_ZER) );
+        }
+        iStart += iFail == -1 ? nPats : iFail + 1;
     }
-    return 1;
-}
-
-/**Function*************************************************************
-
-  Synopsis    [Undoes the partial results of ternary simulation.]
-
-  Description []
-               
-  SideEffects []
-
-  SeeAlso     []
-
-***********************************************************************/
-void Pdr_ManExtendUndo( Aig_Man_t * pAig, Vec_Int_t * vUndo )
-{
-    Aig_Obj_t * pObj;
-    int i, Value;
-    Aig_ManForEachObjVec( vUndo, pAig, pObj, i )
-    {
-        Value  = Vec_IntEntry(vUndo, ++i);
-        assert( Pdr_ManSimInfoGet(pAig, pObj) == PDR_UND );
-        Pdr_ManSimInfoSet( pAig, pObj, Value );
-    }
+    Gia_TsiSimulateInc( p->pTsi );
 }
 
 /**Function*************************************************************
@@ -358,12 +290,10 @@ Pdr_Set_t * Pdr_ManTernarySim( Pdr_Man_t * p, int k, Pdr_Set_t * pCube )
     Vec_Int_t * vCiVals = p->vCiVals;  // cone leaf values (0/1 CI values)
     Vec_Int_t * vCoVals = p->vCoVals;  // cone root values (0/1 CO values)
     Vec_Int_t * vNodes  = p->vNodes;   // cone nodes (node obj IDs)
-    Vec_Int_t * vUndo   = p->vUndo;    // cone undos (node obj IDs)
-    Vec_Int_t * vVisits = p->vVisits;  // intermediate (obj IDs)
     Vec_Int_t * vCi2Rem = p->vCi2Rem;  // CIs to be removed (CI obj IDs)
     Vec_Int_t * vRes    = p->vRes;     // final result (flop literals)
     Aig_Obj_t * pObj;
-    int i, Entry, RetValue;
+    int i, j, Entry, RetValue;
     //abctime clk = Abc_Clock();
 
     // collect CO objects
@@ -401,14 +331,15 @@ Abc_Print( 1, " in frame %d.\n", k );
     // simulate for the first time
 if ( p->pPars->fVeryVerbose )
 Pdr_ManPrintCex( p->pAig, vCiObjs, vCiVals, NULL );
-    RetValue = Pdr_ManSimDataInit( p->pAig, vCiObjs, vCiVals, vNodes, vCoObjs, vCoVals, NULL );
-    assert( RetValue );
+    Pdr_ManTsiLoad( p, vCiObjs, vCiVals, vNodes, vCoObjs );
+    RetValue = Pdr_ManTsiCheck( p, vCoVals, 1 );
+    assert( RetValue == -1 );
 
-    // iteratively remove flops
+    // collect the flops (as leaf indexes) in the order of trying to remove them
+    Vec_IntClear( vRes );
     if ( p->pPars->fFlopPrio )
     {
         // collect flops and sort them by priority
-        Vec_IntClear( vRes );
         Aig_ManForEachObjVec( vCiObjs, p->pAig, pObj, i )
         {
             if ( !Saig_ObjIsLo( p->pAig, pObj ) )
@@ -417,57 +348,34 @@ Pdr_ManPrintCex( p->pAig, vCiObjs, vCiVals, NULL );
             Vec_IntPush( vRes, Entry );
         }
         Vec_IntSelectSortCost( Vec_IntArray(vRes), Vec_IntSize(vRes), vPrio );
-
         // try removing flops starting from low-priority to high-priority
-        Vec_IntClear( vCi2Rem );
         Vec_IntForEachEntry( vRes, Entry, i )
         {
             pObj = Aig_ManCi( p->pAig, Saig_ManPiNum(p->pAig) + Entry );
             assert( Saig_ObjIsLo( p->pAig, pObj ) );
-            Vec_IntClear( vUndo );
-            if ( Pdr_ManExtendOne( p->pAig, pObj, vUndo, vVisits ) )
-                Vec_IntPush( vCi2Rem, Aig_ObjId(pObj) );
-            else
-                Pdr_ManExtendUndo( p->pAig, vUndo );
+            Vec_IntWriteEntry( vRes, i, Abc_Lit2Var(Vec_IntEntry(p->vObj2Tsi, Aig_ObjId(pObj))) - 1 );
         }
     }
     else
     {
-        // try removing low-priority flops first
-        Vec_IntClear( vCi2Rem );
-        Aig_ManForEachObjVec( vCiObjs, p->pAig, pObj, i )
-        {
-            if ( !Saig_ObjIsLo( p->pAig, pObj ) )
-                continue;
-            Entry = Aig_ObjCioId(pObj) - Saig_ManPiNum(p->pAig);
-            if ( Vec_IntEntry(vPrio, Entry) )
-                continue;
-            Vec_IntClear( vUndo );
-            if ( Pdr_ManExtendOne( p->pAig, pObj, vUndo, vVisits ) )
-                Vec_IntPush( vCi2Rem, Aig_ObjId(pObj) );
-            else
-                Pdr_ManExtendUndo( p->pAig, vUndo );
-        }
-        // try removing high-priority flops next
+        // try removing low-priority flops first and high-priority flops next
+        for ( j = 0; j < 2; j++ )
         Aig_ManForEachObjVec( vCiObjs, p->pAig, pObj, i )
         {
             if ( !Saig_ObjIsLo( p->pAig, pObj ) )
                 continue;
             Entry = Aig_ObjCioId(pObj) - Saig_ManPiNum(p->pAig);
-            if ( !Vec_IntEntry(vPrio, Entry) )
-                continue;
-            Vec_IntClear( vUndo );
-            if ( Pdr_ManExtendOne( p->pAig, pObj, vUndo, vVisits ) )
-                Vec_IntPush( vCi2Rem, Aig_ObjId(pObj) );
-            else
-                Pdr_ManExtendUndo( p->pAig, vUndo );
+            if ( (Vec_IntEntry(vPrio, Entry) != 0) == j )
+                Vec_IntPush( vRes, i );
         }
     }
+    Vec_IntClear( vCi2Rem );
+    Pdr_ManTsiExtend( p, vRes, vCiObjs, vCiVals, vCoVals, vCi2Rem );
 
 if ( p->pPars->fVeryVerbose )
 Pdr_ManPrintCex( p->pAig, vCiObjs, vCiVals, vCi2Rem );
-    RetValue = Pdr_ManSimDataInit( p->pAig, vCiObjs, vCiVals, vNodes, vCoObjs, vCoVals, vCi2Rem );
-    assert( RetValue );
+    RetValue = Pdr_ManTsiCheck( p, vCoVals, 64 );
+    assert( RetValue == -1 );
 
     // derive the set of resulting registers
     Pdr_ManDeriveResult( p->pAig, vCiObjs, vCiVals, vCi2Rem, vRes, vPiLits );